@@ -144,16 +144,24 @@ void LinearResampleReader::read(int& length, bool& eos, sample_t* buffer)
 	if(length == 0)
 		return;
 
-	for(int channel = 0; channel < m_channels; channel++)
+	// interleaved samples are interpolated frame by frame, so the source position is only
+	// computed once for all channels and both buffers are accessed sequentially
+	for(int i = 0; i < length; i++)
 	{
-		for(int i = 0; i < length; i++)
-		{
-			spos = (i + 1) / factor + m_cache_pos;
+		spos = (i + 1) / factor + m_cache_pos;
+
+		const float fpos = std::floor(spos);
+		const float frac = spos - fpos;
+		const sample_t* low_frame = buf + (int)fpos * m_channels;
+		const sample_t* high_frame = buf + (int)std::ceil(spos) * m_channels;
+		sample_t* out_frame = buffer + i * m_channels;
 
-			low = buf[(int)std::floor(spos) * m_channels + channel];
-			high = buf[(int)std::ceil(spos) * m_channels + channel];
+		for(int channel = 0; channel < m_channels; channel++)
+		{
+			low = low_frame[channel];
+			high = high_frame[channel];
 
-			buffer[i * m_channels + channel] = low + (spos - std::floor(spos)) * (high - low);
+			out_frame[channel] = low + frac * (high - low);
 		}
 	}
 
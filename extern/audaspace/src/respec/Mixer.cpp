@@ -86,16 +86,21 @@ void Mixer::mix(sample_t* buffer, int start, int length, float volume)
 
 void Mixer::mix(sample_t* buffer, int start, int length, float volume_to, float volume_from)
 {
-	sample_t* out = m_buffer.getBuffer();
+	const int channels = m_specs.channels;
+	sample_t* out = m_buffer.getBuffer() + start * channels;
 
 	length = (std::min(m_length, length + start) - start);
 
 	for(int i = 0; i < length; i++)
 	{
-		float volume = volume_from * (1.0f - i / float(length)) + volume_to * (i / float(length));
+		const float t = i / float(length);
+		const float volume = volume_from * (1.0f - t) + volume_to * t;
+
+		sample_t* out_frame = out + i * channels;
+		const sample_t* in_frame = buffer + i * channels;
 
-		for(int c = 0; c < m_specs.channels; c++)
-			out[(i + start) * m_specs.channels + c] += buffer[i * m_specs.channels + c] * volume;
+		for(int c = 0; c < channels; c++)
+			out_frame[c] += in_frame[c] * volume;
 	}
 }
 
@@ -103,8 +108,14 @@ void Mixer::read(data_t* buffer, float volume)
 {
 	sample_t* out = m_buffer.getBuffer();
 
-	for(int i = 0; i < m_length * m_specs.channels; i++)
-		out[i] *= volume;
+	// the device volume is usually left at 1, skip the extra pass over the buffer then
+	if(volume != 1.0f)
+	{
+		const int length = m_length * m_specs.channels;
+
+		for(int i = 0; i < length; i++)
+			out[i] *= volume;
+	}
 
 	m_convert(buffer, (data_t*) out, m_length * m_specs.channels);
 }
@@ -70,6 +70,9 @@ def _configure_argument_parser():
     parser.add_argument("--cycles-print-stats",
                         help="Print rendering statistics to stderr",
                         action='store_true')
+    parser.add_argument("--cycles-print-stats-json",
+                        help="Print rendering statistics as one JSON object per render",
+                        action='store_true')
     return parser
 
 
@@ -98,7 +101,10 @@ def _parse_command_line():
                 int(args.cycles_resumable_start_chunk),
                 int(args.cycles_resumable_end_chunk),
             )
-    if args.cycles_print_stats:
+    if args.cycles_print_stats_json:
+        import _cycles
+        _cycles.enable_print_stats_json()
+    elif args.cycles_print_stats:
         import _cycles
         _cycles.enable_print_stats()
 
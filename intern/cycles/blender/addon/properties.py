@@ -717,6 +717,29 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_texture_limit
     )
 
+    texture_memory_limit: IntProperty(
+        name="Viewport Texture Memory Limit",
+        default=0,
+        description="Limit the memory used by image textures in viewport rendering, in megabytes. "
+        "The resolution of the largest images is lowered first (0 for no limit)",
+        min=0, soft_max=65536,
+    )
+
+    texture_memory_limit_render: IntProperty(
+        name="Render Texture Memory Limit",
+        default=0,
+        description="Limit the memory used by image textures in final rendering, in megabytes. "
+        "The resolution of the largest images is lowered first (0 for no limit)",
+        min=0, soft_max=65536,
+    )
+
+    use_half_float_textures: BoolProperty(
+        name="Half Float Textures",
+        default=False,
+        description="Store float color images and volume grids at half precision to use half "
+        "the memory, non-color data images keep full precision",
+    )
+
     ao_bounces: IntProperty(
         name="AO Bounces",
         default=0,
@@ -738,6 +761,7 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         scene = context.scene.as_pointer()
         return _cycles.debug_flags_update(scene)
 
+    debug_use_cpu_avx512: BoolProperty(name="AVX512", default=True)
     debug_use_cpu_avx2: BoolProperty(name="AVX2", default=True)
     debug_use_cpu_avx: BoolProperty(name="AVX", default=True)
     debug_use_cpu_sse41: BoolProperty(name="SSE41", default=True)
@@ -71,6 +71,7 @@ bool debug_flags_sync_from_scene(BL::Scene b_scene)
   /* Synchronize shared flags. */
   flags.viewport_static_bvh = get_enum(cscene, "debug_bvh_type");
   /* Synchronize CPU flags. */
+  flags.cpu.avx512 = get_boolean(cscene, "debug_use_cpu_avx512");
   flags.cpu.avx2 = get_boolean(cscene, "debug_use_cpu_avx2");
   flags.cpu.avx = get_boolean(cscene, "debug_use_cpu_avx");
   flags.cpu.sse41 = get_boolean(cscene, "debug_use_cpu_sse41");
@@ -959,6 +960,13 @@ static PyObject *enable_print_stats_func(PyObject * /*self*/, PyObject * /*args*
   Py_RETURN_NONE;
 }
 
+static PyObject *enable_print_stats_json_func(PyObject * /*self*/, PyObject * /*args*/)
+{
+  BlenderSession::print_render_stats = true;
+  BlenderSession::print_render_stats_json = true;
+  Py_RETURN_NONE;
+}
+
 static PyObject *get_device_types_func(PyObject * /*self*/, PyObject * /*args*/)
 {
   vector<DeviceType> device_types = Device::available_types();
@@ -1006,6 +1014,7 @@ static PyMethodDef methods[] = {
 
     /* Statistics. */
     {"enable_print_stats", enable_print_stats_func, METH_NOARGS, ""},
+    {"enable_print_stats_json", enable_print_stats_json_func, METH_NOARGS, ""},
 
     /* Resumable render */
     {"set_resumable_chunk", set_resumable_chunk_func, METH_VARARGS, ""},
@@ -53,6 +53,7 @@ int BlenderSession::current_resumable_chunk = 0;
 int BlenderSession::start_resumable_chunk = 0;
 int BlenderSession::end_resumable_chunk = 0;
 bool BlenderSession::print_render_stats = false;
+bool BlenderSession::print_render_stats_json = false;
 
 BlenderSession::BlenderSession(BL::RenderEngine &b_engine,
                                BL::Preferences &b_userpref,
@@ -176,6 +177,10 @@ void BlenderSession::create_session()
 
 void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsgraph)
 {
+  /* With persistent data Blender keeps the dependency graph between renders, which tells what
+   * changed since the previous render. */
+  const bool is_same_depsgraph = (this->b_depsgraph.ptr.data == b_depsgraph.ptr.data);
+
   this->b_data = b_data;
   this->b_depsgraph = b_depsgraph;
   this->b_scene = b_depsgraph.scene_eval();
@@ -226,7 +231,6 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
   }
 
   session->progress.reset();
-  scene->reset();
 
   session->tile_manager.set_tile_order(session_params.tile_order);
 
@@ -235,14 +239,25 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
    */
   session->stats.mem_peak = session->stats.mem_used;
 
-  /* There is no single depsgraph to use for the entire render.
-   * See note on create_session().
-   */
-  /* sync object should be re-created */
-  sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
-
   BL::SpaceView3D b_null_space_view3d(PointerRNA_NULL);
   BL::RegionView3D b_null_region_view3d(PointerRNA_NULL);
+
+  if (is_same_depsgraph) {
+    /* Keep the synced data, and only update what changed since the previous render. The
+     * geometry, shaders and images of everything else stay on the device. */
+    sync->reset(b_data, b_scene);
+    sync->sync_recalc(b_depsgraph, b_null_space_view3d);
+  }
+  else {
+    /* There is no single depsgraph to use for the entire render.
+     * See note on create_session().
+     */
+    /* sync object should be re-created */
+    scene->reset();
+    delete sync;
+    sync = new BlenderSync(b_engine, b_data, b_scene, scene, !background, session->progress);
+  }
+
   BufferParams buffer_params = BlenderSync::get_buffer_params(
       b_render, b_null_space_view3d, b_null_region_view3d, scene->camera, width, height);
   session->reset(buffer_params, session_params.samples);
@@ -496,6 +511,8 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
   session->params.denoising.relative_pca = get_boolean(crl, "denoising_relative_pca");
   session->params.denoising.optix_input_passes = get_enum(crl, "denoising_optix_input_passes");
   session->tile_manager.schedule_denoising = session->params.run_denoising;
+  /* Tiles written to the render result have to match its parts when saving buffers. */
+  session->tile_manager.split_tail_tiles = !b_engine.use_save_buffers();
 
   scene->film->denoising_data_pass = buffer_params.denoising_data_pass;
   scene->film->denoising_clean_pass = buffer_params.denoising_clean_pass;
@@ -569,7 +586,12 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
     if (!b_engine.is_preview() && background && print_render_stats) {
       RenderStats stats;
       session->collect_statistics(&stats);
-      printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      if (print_render_stats_json) {
+        printf("%s\n", stats.json_report().c_str());
+      }
+      else {
+        printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      }
     }
 
     if (session->progress.get_cancel())
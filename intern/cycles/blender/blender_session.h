@@ -144,6 +144,8 @@ class BlenderSession {
   static int end_resumable_chunk;
 
   static bool print_render_stats;
+  /* Print the statistics as JSON instead of a human-readable report. */
+  static bool print_render_stats_json;
 
  protected:
   void stamp_view_layer_metadata(Scene *scene, const string &view_layer_name);
@@ -78,6 +78,12 @@ BlenderSync::~BlenderSync()
 {
 }
 
+void BlenderSync::reset(BL::BlendData &b_data, BL::Scene &b_scene)
+{
+  this->b_data = b_data;
+  this->b_scene = b_scene;
+}
+
 /* Sync */
 
 void BlenderSync::sync_recalc(BL::Depsgraph &b_depsgraph, BL::SpaceView3D &b_v3d)
@@ -136,15 +142,19 @@ void BlenderSync::sync_recalc(BL::Depsgraph &b_depsgraph, BL::SpaceView3D &b_v3d
     else if (b_id.is_a(&RNA_Object)) {
       BL::Object b_ob(b_id);
       const bool updated_geometry = b_update->is_updated_geometry();
+      const bool updated_transform = b_update->is_updated_transform();
 
-      if (b_update->is_updated_transform()) {
+      if (updated_transform) {
         object_map.set_recalc(b_ob);
         light_map.set_recalc(b_ob);
       }
 
       if (object_is_mesh(b_ob)) {
+        /* Adaptive subdivision is diced based on the object transform, but other updates like
+         * shading or selection changes can keep the existing tessellation. */
         if (updated_geometry ||
-            (object_subdivision_type(b_ob, preview, experimental) != Mesh::SUBDIVISION_NONE)) {
+            (updated_transform &&
+             object_subdivision_type(b_ob, preview, experimental) != Mesh::SUBDIVISION_NONE)) {
           BL::ID key = BKE_object_is_modified(b_ob) ? b_ob : b_ob.data();
           mesh_map.set_recalc(key);
         }
@@ -721,6 +731,17 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene, bool background)
     params.texture_limit = 0;
   }
 
+  const int texture_memory_limit = RNA_int_get(
+      &cscene, (background) ? "texture_memory_limit_render" : "texture_memory_limit");
+  if (texture_memory_limit > 0 && b_scene.render().use_simplify()) {
+    params.texture_memory_limit = (size_t)texture_memory_limit * 1024 * 1024;
+  }
+  else {
+    params.texture_memory_limit = 0;
+  }
+
+  params.texture_use_half_float = RNA_boolean_get(&cscene, "use_half_float_textures");
+
   /* TODO(sergey): Once OSL supports per-microarchitecture optimization get
    * rid of this.
    */
@@ -840,10 +861,9 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   params.text_timeout = (double)get_float(cscene, "debug_text_timeout");
 
   /* progressive refine */
-  BL::RenderSettings b_r = b_scene.render();
   params.progressive_refine = (b_engine.is_preview() ||
                                get_boolean(cscene, "use_progressive_refine")) &&
-                              !b_r.use_save_buffers();
+                              !b_engine.use_save_buffers();
 
   if (params.progressive_refine) {
     BL::Scene::view_layers_iterator b_view_layer;
@@ -60,6 +60,9 @@ class BlenderSync {
               Progress &progress);
   ~BlenderSync();
 
+  /* Use new data-blocks for the next sync, keeping the synced data. */
+  void reset(BL::BlendData &b_data, BL::Scene &b_scene);
+
   /* sync */
   void sync_recalc(BL::Depsgraph &b_depsgraph, BL::SpaceView3D &b_v3d);
   void sync_data(BL::RenderSettings &b_render,
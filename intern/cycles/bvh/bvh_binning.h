@@ -27,7 +27,7 @@ CCL_NAMESPACE_BEGIN
 
 class BVHBuild;
 
-/* Single threaded object binner. Finds the split with the best SAH heuristic
+/* Object binner. Finds the split with the best SAH heuristic
  * by testing for each dimension multiple partitionings for regular spaced
  * partition locations. A partitioning for a partition location is computed,
  * by putting primitives whose centroid is on the left and right of the split
@@ -70,6 +70,21 @@ class BVHObjectBinning : public BVHRange {
 
   enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
+  /* Minimum number of primitives binned by one thread. */
+  enum { PARALLEL_BINNING_TASK_SIZE = 32768 };
+
+  /* Bins filled by one binning task. */
+  struct BVHObjectBins {
+    BoundBox bounds[MAX_BINS][4];
+    int4 count[MAX_BINS];
+  };
+
+  /* Map primitives in the given range to bins. */
+  void bin_primitives(const BVHReference *prims,
+                      int begin,
+                      int end,
+                      BoundBox (*bin_bounds)[4],
+                      int4 *bin_count) const;
 
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
@@ -49,7 +49,7 @@ class BVHParams {
   bool use_spatial_split;
   float spatial_split_alpha;
 
-  /* Unaligned nodes creation threshold */
+  /* Unaligned nodes are tried when the aligned split SAH is above this fraction of the leaf SAH. */
   float unaligned_split_threshold;
 
   /* SAH costs */
@@ -103,7 +103,9 @@ class BVHParams {
     use_spatial_split = true;
     spatial_split_alpha = 1e-5f;
 
-    unaligned_split_threshold = 0.7f;
+    /* Unaligned splits are only chosen when their SAH is lower, so trying them more often only
+     * costs build time, and gives tighter nodes for hair which isn't aligned to the axes. */
+    unaligned_split_threshold = 0.5f;
 
     /* todo: see if splitting up primitive cost to be separate for triangles
      * and curves can help. so far in tests it doesn't help, but why? */
@@ -68,8 +68,13 @@ template<typename F> class KernelFunctions {
     kernel = (F)NULL;
   }
 
-  KernelFunctions(
-      F kernel_default, F kernel_sse2, F kernel_sse3, F kernel_sse41, F kernel_avx, F kernel_avx2)
+  KernelFunctions(F kernel_default,
+                  F kernel_sse2,
+                  F kernel_sse3,
+                  F kernel_sse41,
+                  F kernel_avx,
+                  F kernel_avx2,
+                  F kernel_avx512)
   {
     const char *architecture_name = "default";
     kernel = kernel_default;
@@ -81,8 +86,16 @@ template<typename F> class KernelFunctions {
     (void)kernel_sse41;
     (void)kernel_avx;
     (void)kernel_avx2;
+    (void)kernel_avx512;
+#ifdef WITH_CYCLES_OPTIMIZED_KERNEL_AVX512
+    if (DebugFlags().cpu.has_avx512() && system_cpu_support_avx512()) {
+      architecture_name = "AVX512";
+      kernel = kernel_avx512;
+    }
+    else
+#endif
 #ifdef WITH_CYCLES_OPTIMIZED_KERNEL_AVX2
-    if (DebugFlags().cpu.has_avx2() && system_cpu_support_avx2()) {
+        if (DebugFlags().cpu.has_avx2() && system_cpu_support_avx2()) {
       architecture_name = "AVX2";
       kernel = kernel_avx2;
     }
@@ -257,7 +270,8 @@ class CPUDevice : public Device {
 #define KERNEL_FUNCTIONS(name) \
   KERNEL_NAME_EVAL(cpu, name), KERNEL_NAME_EVAL(cpu_sse2, name), \
       KERNEL_NAME_EVAL(cpu_sse3, name), KERNEL_NAME_EVAL(cpu_sse41, name), \
-      KERNEL_NAME_EVAL(cpu_avx, name), KERNEL_NAME_EVAL(cpu_avx2, name)
+      KERNEL_NAME_EVAL(cpu_avx, name), KERNEL_NAME_EVAL(cpu_avx2, name), \
+      KERNEL_NAME_EVAL(cpu_avx512, name)
 
   CPUDevice(DeviceInfo &info_, Stats &stats_, Profiler &profiler_, bool background_)
       : Device(info_, stats_, profiler_, background_),
@@ -1238,7 +1252,8 @@ string device_cpu_capabilities()
   capabilities += system_cpu_support_sse3() ? "SSE3 " : "";
   capabilities += system_cpu_support_sse41() ? "SSE41 " : "";
   capabilities += system_cpu_support_avx() ? "AVX " : "";
-  capabilities += system_cpu_support_avx2() ? "AVX2" : "";
+  capabilities += system_cpu_support_avx2() ? "AVX2 " : "";
+  capabilities += system_cpu_support_avx512() ? "AVX512" : "";
   if (capabilities[capabilities.size() - 1] == ' ')
     capabilities.resize(capabilities.size() - 1);
   return capabilities;
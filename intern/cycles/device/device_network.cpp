@@ -28,6 +28,18 @@ CCL_NAMESPACE_BEGIN
 typedef map<device_ptr, device_ptr> PtrMap;
 typedef vector<uint8_t> DataVector;
 typedef map<device_ptr, DataVector> DataMap;
+typedef map<device_ptr, uint64_t> HashMap;
+
+/* FNV-1a hash of a memory buffer, used to detect uploads of unchanged data. */
+static uint64_t data_hash(const void *data, size_t size)
+{
+  const uint8_t *bytes = (const uint8_t *)data;
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
 
 /* tile list */
 typedef vector<RenderTile> TileList;
@@ -48,6 +60,9 @@ class NetworkDevice : public Device {
   device_ptr mem_counter;
   DeviceTask the_task; /* todo: handle multiple tasks */
 
+  /* Hash of the data last uploaded to each read-only allocation. */
+  HashMap mem_hashes;
+
   thread_mutex rpc_lock;
 
   virtual bool show_samples() const
@@ -111,6 +126,17 @@ class NetworkDevice : public Device {
   {
     thread_scoped_lock lock(rpc_lock);
 
+    /* Scene updates copy a lot of data which did not change again. Kernels don't write to
+     * read-only memory and textures, so the server still has it and it doesn't need to be sent. */
+    if (mem.device_pointer && (mem.type == MEM_READ_ONLY || mem.type == MEM_TEXTURE)) {
+      const uint64_t hash = data_hash(mem.host_pointer, mem.memory_size());
+      HashMap::iterator it = mem_hashes.find(mem.device_pointer);
+      if (it != mem_hashes.end() && it->second == hash) {
+        return;
+      }
+      mem_hashes[mem.device_pointer] = hash;
+    }
+
     RPCSend snd(socket, &error_func, "mem_copy_to");
 
     snd.add(mem);
@@ -122,6 +148,8 @@ class NetworkDevice : public Device {
   {
     thread_scoped_lock lock(rpc_lock);
 
+    mem_hashes.erase(mem.device_pointer);
+
     size_t data_size = mem.memory_size();
 
     RPCSend snd(socket, &error_func, "mem_copy_from");
@@ -141,6 +169,8 @@ class NetworkDevice : public Device {
   {
     thread_scoped_lock lock(rpc_lock);
 
+    mem_hashes.erase(mem.device_pointer);
+
     RPCSend snd(socket, &error_func, "mem_zero");
 
     snd.add(mem);
@@ -152,6 +182,8 @@ class NetworkDevice : public Device {
     if (mem.device_pointer) {
       thread_scoped_lock lock(rpc_lock);
 
+      mem_hashes.erase(mem.device_pointer);
+
       RPCSend snd(socket, &error_func, "mem_free");
 
       snd.add(mem);
@@ -152,7 +152,8 @@ ccl_device void kernel_branched_path_volume_connect_light(KernelGlobals *kg,
   for (int i = 0; i < num_lights; ++i) {
     /* sample one light at random */
     int num_samples = 1;
-    int num_all_lights = 1;
+    /* Lamps are sampled in turn, this undoes their selection probability in the light pdf. */
+    float num_all_lights = 1.0f;
     uint lamp_rng_hash = state->rng_hash;
     bool double_pdf = false;
     bool is_mesh_light = false;
@@ -166,9 +167,9 @@ ccl_device void kernel_branched_path_volume_connect_light(KernelGlobals *kg,
           continue;
         }
         num_samples = light_select_num_samples(kg, i);
-        num_all_lights = kernel_data.integrator.num_all_lights;
         lamp_rng_hash = cmj_hash(state->rng_hash, i);
         double_pdf = kernel_data.integrator.pdf_triangles != 0.0f;
+        num_all_lights = 1.0f / (light_select_pdf(kg, i) * (double_pdf ? 2.0f : 1.0f));
       }
       /* mesh light sampling */
       else {
@@ -1298,7 +1298,7 @@ typedef struct KernelIntegrator {
   int num_distribution;
   int num_all_lights;
   float pdf_triangles;
-  float pdf_lights;
+  float pdf_background_light;
   int pdf_background_res_x;
   int pdf_background_res_y;
   float light_inv_rr_threshold;
@@ -1507,7 +1507,8 @@ typedef struct KernelLight {
   float max_bounces;
   float random;
   float strength[3];
-  float pad1;
+  /* Probability of selecting the lamp from the light distribution. */
+  float pdf;
   Transform tfm;
   Transform itfm;
   union {
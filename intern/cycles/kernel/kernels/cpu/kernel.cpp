@@ -49,6 +49,10 @@
 #    define __KERNEL_SSE__
 #    define __KERNEL_AVX2__
 #  endif
+#  ifdef __AVX512F__
+#    define __KERNEL_SSE__
+#    define __KERNEL_AVX512__
+#  endif
 #endif
 
 /* quiet unused define warnings */
@@ -54,7 +54,6 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
   }
   ccl_barrier(CCL_LOCAL_MEM_FENCE);
 
-  /* skip sorting for cpu split kernel */
 #  ifdef __KERNEL_OPENCL__
 
   /* bitonic sort */
@@ -77,6 +76,26 @@ ccl_device void kernel_shader_sort(KernelGlobals *kg, ccl_local_param ShaderSort
       }
     }
   }
+#  else
+  /* Same bitonic sort done serially, on the CPU a single work item handles the whole block.
+   * Every pair is only visited once, so it is not swapped back. */
+  for (uint length = 1; length < SHADER_SORT_BLOCK_SIZE; length <<= 1) {
+    for (uint inc = length; inc > 0; inc >>= 1) {
+      for (uint i = 0; i < SHADER_SORT_BLOCK_SIZE; i++) {
+        uint j = i ^ inc;
+        if (j < i) {
+          continue;
+        }
+        bool direction = ((i & (length << 1)) != 0);
+        ushort ioff = local_index[i];
+        ushort joff = local_index[j];
+        if ((local_value[joff] < local_value[ioff]) ^ direction) {
+          local_index[i] = joff;
+          local_index[j] = ioff;
+        }
+      }
+    }
+  }
 #  endif /* __KERNEL_OPENCL__ */
 
   /* copy to destination */
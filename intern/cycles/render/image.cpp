@@ -92,6 +92,49 @@ const char *name_from_type(ImageDataType type)
   return "";
 }
 
+size_t pixel_size_from_type(ImageDataType type)
+{
+  switch (type) {
+    case IMAGE_DATA_TYPE_FLOAT4:
+      return sizeof(float4);
+    case IMAGE_DATA_TYPE_BYTE4:
+      return sizeof(uchar4);
+    case IMAGE_DATA_TYPE_HALF4:
+      return sizeof(half4);
+    case IMAGE_DATA_TYPE_FLOAT:
+      return sizeof(float);
+    case IMAGE_DATA_TYPE_BYTE:
+      return sizeof(uchar);
+    case IMAGE_DATA_TYPE_HALF:
+      return sizeof(half);
+    case IMAGE_DATA_TYPE_USHORT4:
+      return sizeof(ushort4);
+    case IMAGE_DATA_TYPE_USHORT:
+      return sizeof(uint16_t);
+    case IMAGE_DATA_NUM_TYPES:
+      assert(!"System enumerator type, should never be used");
+      return 0;
+  }
+  assert(!"Unhandled image data type");
+  return 0;
+}
+
+/* Scale factor applied to the image when loading it with the given texture limit,
+ * matches the one computed in ImageManager::file_load_image(). */
+float texture_limit_scale_factor(size_t max_size, int texture_limit)
+{
+  float scale_factor = 1.0f;
+  if (texture_limit > 0) {
+    while (max_size * scale_factor > texture_limit) {
+      scale_factor *= 0.5f;
+    }
+  }
+  return scale_factor;
+}
+
+/* Don't reduce the resolution of images below this size to fit in the memory limit. */
+const size_t TEXTURE_MEMORY_LIMIT_MIN_SIZE = 128;
+
 }  // namespace
 
 ImageManager::ImageManager(const DeviceInfo &info)
@@ -103,6 +146,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
   /* Set image limits */
   max_num_images = TEX_NUM_MAX;
   has_half_images = info.has_half_images;
+  use_half_float = false;
 
   for (size_t type = 0; type < IMAGE_DATA_NUM_TYPES; type++) {
     tex_num_images[type] = 0;
@@ -122,6 +166,11 @@ void ImageManager::set_osl_texture_system(void *texture_system)
   osl_texture_system = texture_system;
 }
 
+void ImageManager::set_use_half_float(bool use_half_float_)
+{
+  use_half_float = use_half_float_;
+}
+
 bool ImageManager::set_animation_frame_update(int frame)
 {
   if (frame != animation_frame) {
@@ -168,6 +217,8 @@ bool ImageManager::get_image_metadata(int flat_slot, ImageMetaData &metadata)
 
 void ImageManager::metadata_detect_colorspace(ImageMetaData &metadata, const char *file_format)
 {
+  const bool is_data = ColorSpaceManager::colorspace_is_data(metadata.colorspace);
+
   /* Convert used specified color spaces to one we know how to handle. */
   metadata.colorspace = ColorSpaceManager::detect_known_colorspace(
       metadata.colorspace, file_format, metadata.is_float || metadata.is_half);
@@ -196,6 +247,20 @@ void ImageManager::metadata_detect_colorspace(ImageMetaData &metadata, const cha
       metadata.type = IMAGE_DATA_TYPE_HALF4;
     }
   }
+
+  /* Color images rarely need more precision than half float gives, unlike non-color data
+   * such as displacement where the error would be visible. Volume grids are data too, but
+   * as they are integrated along rays the error stays invisible while their dense storage
+   * is often what uses most memory. */
+  const bool is_volume = metadata.depth > 1;
+  if (use_half_float && (!is_data || is_volume)) {
+    if (metadata.type == IMAGE_DATA_TYPE_FLOAT) {
+      metadata.type = IMAGE_DATA_TYPE_HALF;
+    }
+    else if (metadata.type == IMAGE_DATA_TYPE_FLOAT4) {
+      metadata.type = IMAGE_DATA_TYPE_HALF4;
+    }
+  }
 }
 
 bool ImageManager::get_image_metadata(const string &filename,
@@ -402,6 +467,7 @@ int ImageManager::add_image(const string &filename,
   img->users = 1;
   img->alpha_type = alpha_type;
   img->colorspace = colorspace;
+  img->texture_limit = 0;
   img->mem = NULL;
 
   images[type][slot] = img;
@@ -645,8 +711,19 @@ bool ImageManager::file_load_image(Image *img,
                               image_associate_alpha(img),
                               img->metadata.builtin_free_cache);
     }
-    else {
-      /* TODO(dingto): Support half for ImBuf. */
+    else if (FileFormat == TypeDesc::HALF) {
+      /* ImBuf has no half float buffers, convert from full float. */
+      vector<float> float_pixels(num_pixels * components);
+      builtin_image_float_pixels_cb(img->filename,
+                                    img->builtin_data,
+                                    0, /* TODO(lukas): Support tiles here? */
+                                    &float_pixels[0],
+                                    num_pixels * components,
+                                    image_associate_alpha(img),
+                                    img->metadata.builtin_free_cache);
+      for (size_t i = 0; i < num_pixels * components; i++) {
+        pixels[i] = util_image_cast_from_float<StorageType>(float_pixels[i]);
+      }
     }
   }
 
@@ -788,7 +865,8 @@ void ImageManager::device_load_image(
   string filename = path_filename(images[type][slot]->filename);
   progress->set_status("Updating Images", "Loading " + filename);
 
-  const int texture_limit = scene->params.texture_limit;
+  const int texture_limit = (img->texture_limit > 0) ? img->texture_limit :
+                                                       scene->params.texture_limit;
 
   /* Slot assignment */
   int flat_slot = type_index_to_flattened_slot(slot, type);
@@ -998,6 +1076,8 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
     return;
   }
 
+  device_update_texture_limits(scene);
+
   TaskPool pool;
   for (int type = 0; type < IMAGE_DATA_NUM_TYPES; type++) {
     for (size_t slot = 0; slot < images[type].size(); slot++) {
@@ -1025,6 +1105,84 @@ void ImageManager::device_update(Device *device, Scene *scene, Progress &progres
   need_update = false;
 }
 
+/* Lower the resolution of the images to be loaded until all images fit in the texture memory
+ * limit. The largest images are halved first, similar to how a texture cache would pick
+ * lower mip-map levels under memory pressure. Images which are already loaded are kept. */
+void ImageManager::device_update_texture_limits(Scene *scene)
+{
+  struct ImageSize {
+    Image *img;
+    size_t max_size;
+    size_t full_size;
+    float scale_factor;
+
+    size_t size() const
+    {
+      const float area_scale = scale_factor * scale_factor;
+      return (size_t)(full_size *
+                      ((img->metadata.depth > 1) ? area_scale * scale_factor : area_scale));
+    }
+  };
+
+  const size_t memory_limit = scene->params.texture_memory_limit;
+  vector<ImageSize> sizes;
+  size_t total_size = 0;
+
+  for (int type = 0; type < IMAGE_DATA_NUM_TYPES; type++) {
+    foreach (Image *img, images[type]) {
+      if (!img || img->users == 0 || (osl_texture_system && !img->builtin_data)) {
+        continue;
+      }
+      if (!img->need_load) {
+        total_size += (img->mem) ? img->mem->memory_size() : 0;
+        continue;
+      }
+
+      img->texture_limit = 0;
+      const ImageMetaData &metadata = img->metadata;
+      ImageSize size;
+      size.img = img;
+      size.max_size = max(max(metadata.width, metadata.height), metadata.depth);
+      size.full_size = metadata.width * metadata.height * max(metadata.depth, (size_t)1) *
+                       pixel_size_from_type((ImageDataType)type);
+      size.scale_factor = texture_limit_scale_factor(size.max_size, scene->params.texture_limit);
+      total_size += size.size();
+      sizes.push_back(size);
+    }
+  }
+
+  if (memory_limit == 0 || total_size <= memory_limit) {
+    return;
+  }
+
+  while (total_size > memory_limit) {
+    ImageSize *largest = NULL;
+    foreach (ImageSize &size, sizes) {
+      if (size.max_size * size.scale_factor * 0.5f < TEXTURE_MEMORY_LIMIT_MIN_SIZE) {
+        continue;
+      }
+      if (largest == NULL || size.size() > largest->size()) {
+        largest = &size;
+      }
+    }
+    if (largest == NULL) {
+      /* All images are as small as allowed. */
+      break;
+    }
+    total_size -= largest->size();
+    largest->scale_factor *= 0.5f;
+    total_size += largest->size();
+  }
+
+  foreach (ImageSize &size, sizes) {
+    if (size.scale_factor < 1.0f) {
+      size.img->texture_limit = (int)ceilf(size.max_size * size.scale_factor);
+      VLOG(1) << "Limiting image " << size.img->filename << " to " << size.img->texture_limit
+              << " pixels to fit in the texture memory limit.";
+    }
+  }
+}
+
 void ImageManager::device_update_slot(Device *device,
                                       Scene *scene,
                                       int flat_slot,
@@ -115,6 +115,7 @@ class ImageManager {
 
   void set_osl_texture_system(void *texture_system);
   bool set_animation_frame_update(int frame);
+  void set_use_half_float(bool use_half_float);
 
   device_memory *image_memory(int flat_slot);
 
@@ -157,6 +158,9 @@ class ImageManager {
     float frame;
     InterpolationType interpolation;
     ExtensionType extension;
+    /* Resolution the image is loaded at to fit in the texture memory limit, zero to only use
+     * the limit from the scene parameters. */
+    int texture_limit;
 
     string mem_name;
     device_memory *mem;
@@ -168,6 +172,7 @@ class ImageManager {
   int tex_num_images[IMAGE_DATA_NUM_TYPES];
   int max_num_images;
   bool has_half_images;
+  bool use_half_float;
 
   thread_mutex device_mutex;
   int animation_frame;
@@ -188,6 +193,7 @@ class ImageManager {
   void device_load_image(
       Device *device, Scene *scene, ImageDataType type, int slot, Progress *progress);
   void device_free_image(Device *device, ImageDataType type, int slot);
+  void device_update_texture_limits(Scene *scene);
 };
 
 CCL_NAMESPACE_END
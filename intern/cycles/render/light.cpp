@@ -254,6 +254,12 @@ bool LightManager::object_usable_as_light(Object *object)
   return false;
 }
 
+/* Power of a lamp, used for its probability of being selected for light sampling. */
+static float light_power(const Light *light)
+{
+  return average(fabs(light->strength));
+}
+
 void LightManager::device_update_distribution(Device *,
                                               DeviceScene *dscene,
                                               Scene *scene,
@@ -380,20 +386,44 @@ void LightManager::device_update_distribution(Device *,
 
   float trianglearea = totarea;
 
+  /* Lamps are selected proportional to their power, mixed with a uniform selection so lamps
+   * whose emission mostly comes from their shader are still sampled. Distant and background
+   * lights have no finite power, they are given the average power of the other lamps. */
+  float local_power = 0.0f;
+  size_t num_local_lights = 0;
+  foreach (Light *light, scene->lights) {
+    if (light->is_enabled && light->type != LIGHT_DISTANT && light->type != LIGHT_BACKGROUND) {
+      local_power += light_power(light);
+      num_local_lights++;
+    }
+  }
+  const float infinite_power = (local_power > 0.0f) ? local_power / num_local_lights : 1.0f;
+  const float total_power = local_power + (num_lights - num_local_lights) * infinite_power;
+
   /* point lights */
-  float lightarea = (totarea > 0.0f) ? totarea / num_lights : 1.0f;
+  const float lightarea = (totarea > 0.0f) ? totarea : 1.0f;
+  const float lamp_pdf_scale = (totarea > 0.0f) ? 0.5f : 1.0f;
+  float background_pdf = 0.0f;
   bool use_lamp_mis = false;
 
+  KernelLight *klights = dscene->lights.data();
+
   int light_index = 0;
   foreach (Light *light, scene->lights) {
     if (!light->is_enabled)
       continue;
 
+    const bool is_infinite = (light->type == LIGHT_DISTANT || light->type == LIGHT_BACKGROUND);
+    const float power = is_infinite ? infinite_power : light_power(light);
+    const float pdf = (total_power > 0.0f) ? 0.5f / num_lights + 0.5f * power / total_power :
+                                             1.0f / num_lights;
+    klights[light_index].pdf = pdf * lamp_pdf_scale;
+
     distribution[offset].totarea = totarea;
     distribution[offset].prim = ~light_index;
     distribution[offset].lamp.pad = 1.0f;
     distribution[offset].lamp.size = light->size;
-    totarea += lightarea;
+    totarea += lightarea * pdf;
 
     if (light->type == LIGHT_DISTANT) {
       use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
@@ -407,6 +437,7 @@ void LightManager::device_update_distribution(Device *,
     else if (light->type == LIGHT_BACKGROUND) {
       num_background_lights++;
       background_mis |= light->use_mis;
+      background_pdf = pdf;
     }
 
     light_index++;
@@ -439,7 +470,7 @@ void LightManager::device_update_distribution(Device *,
 
     /* precompute pdfs */
     kintegrator->pdf_triangles = 0.0f;
-    kintegrator->pdf_lights = 0.0f;
+    kintegrator->pdf_background_light = 0.0f;
 
     /* sample one, with 0.5 probability of light or triangle */
     kintegrator->num_all_lights = num_lights;
@@ -450,10 +481,10 @@ void LightManager::device_update_distribution(Device *,
         kintegrator->pdf_triangles *= 0.5f;
     }
 
-    if (num_lights) {
-      kintegrator->pdf_lights = 1.0f / num_lights;
+    if (num_background_lights) {
+      kintegrator->pdf_background_light = background_pdf;
       if (trianglearea > 0.0f)
-        kintegrator->pdf_lights *= 0.5f;
+        kintegrator->pdf_background_light *= 0.5f;
     }
 
     kintegrator->use_lamp_mis = use_lamp_mis;
@@ -466,7 +497,7 @@ void LightManager::device_update_distribution(Device *,
       kfilm->pass_shadow_scale *= 0.5f;
 
     if (num_background_lights < num_lights)
-      kfilm->pass_shadow_scale *= (float)(num_lights - num_background_lights) / (float)num_lights;
+      kfilm->pass_shadow_scale *= 1.0f - background_pdf * num_background_lights;
 
     /* CDF */
     dscene->light_distribution.copy_to_device();
@@ -489,7 +520,7 @@ void LightManager::device_update_distribution(Device *,
     kintegrator->num_distribution = 0;
     kintegrator->num_all_lights = 0;
     kintegrator->pdf_triangles = 0.0f;
-    kintegrator->pdf_lights = 0.0f;
+    kintegrator->pdf_background_light = 0.0f;
     kintegrator->use_lamp_mis = false;
     kintegrator->num_portals = 0;
     kintegrator->portal_offset = 0;
@@ -883,8 +914,6 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
   VLOG(1) << "Number of lights sent to the device: " << light_index;
 
   VLOG(1) << "Number of lights without contribution: " << num_scene_lights - light_index;
-
-  dscene->lights.copy_to_device();
 }
 
 void LightManager::device_update(Device *device,
@@ -911,6 +940,9 @@ void LightManager::device_update(Device *device,
   if (progress.get_cancel())
     return;
 
+  /* Copied after the distribution, which sets the selection probability of the lights. */
+  dscene->lights.copy_to_device();
+
   device_update_background(device, dscene, scene, progress);
   if (progress.get_cancel())
     return;
@@ -414,6 +414,7 @@ Mesh::Mesh() : Node(node_type)
 {
   need_update = true;
   need_update_rebuild = false;
+  need_update_pack = true;
   transform_applied = false;
   transform_negative_scaled = false;
   transform_normal = transform_identity();
@@ -1790,6 +1791,14 @@ void MeshManager::mesh_calc_offset(Scene *scene)
   size_t prim_size = 0;
 
   foreach (Mesh *mesh, scene->meshes) {
+    /* Data packed at the previous offsets is not at the right place anymore. */
+    if (mesh->vert_offset != vert_size || mesh->tri_offset != tri_size ||
+        mesh->curvekey_offset != curve_key_size || mesh->curve_offset != curve_size ||
+        mesh->patch_offset != patch_size || mesh->face_offset != face_size ||
+        mesh->corner_offset != corner_size) {
+      mesh->need_update_pack = true;
+    }
+
     mesh->vert_offset = vert_size;
     mesh->tri_offset = tri_size;
 
@@ -1877,11 +1886,20 @@ void MeshManager::device_update_mesh(
     }
   }
 
+  /* Arrays are kept from the previous update (see #device_free), only meshes which changed or
+   * moved in the arrays need to be packed again. All meshes are packed when the arrays were
+   * reallocated or shader IDs changed. */
+  const bool pack_all = (scene->shaders != packed_shaders);
+
   /* Fill in all the arrays. */
   if (tri_size != 0) {
     /* normals */
     progress.set_status("Updating Mesh", "Computing normals");
 
+    const bool pack_all_tris = pack_all || dscene->tri_shader.size() != tri_size ||
+                               dscene->tri_vnormal.size() != vert_size;
+    bool tris_packed = pack_all_tris;
+
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
     float4 *vnormal = dscene->tri_vnormal.alloc(vert_size);
     uint4 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
@@ -1889,8 +1907,12 @@ void MeshManager::device_update_mesh(
     float2 *tri_patch_uv = dscene->tri_patch_uv.alloc(vert_size);
 
     foreach (Mesh *mesh, scene->meshes) {
-      mesh->pack_shaders(scene, &tri_shader[mesh->tri_offset]);
-      mesh->pack_normals(&vnormal[mesh->vert_offset]);
+      if (pack_all_tris || mesh->need_update_pack) {
+        mesh->pack_shaders(scene, &tri_shader[mesh->tri_offset]);
+        mesh->pack_normals(&vnormal[mesh->vert_offset]);
+        tris_packed = true;
+      }
+      /* Always packed, primitive indices change with the scene BVH. */
       mesh->pack_verts(tri_prim_index,
                        &tri_vindex[mesh->tri_offset],
                        &tri_patch[mesh->tri_offset],
@@ -1904,8 +1926,10 @@ void MeshManager::device_update_mesh(
     /* vertex coordinates */
     progress.set_status("Updating Mesh", "Copying Mesh to device");
 
-    dscene->tri_shader.copy_to_device();
-    dscene->tri_vnormal.copy_to_device();
+    if (tris_packed) {
+      dscene->tri_shader.copy_to_device();
+      dscene->tri_vnormal.copy_to_device();
+    }
     dscene->tri_vindex.copy_to_device();
     dscene->tri_patch.copy_to_device();
     dscene->tri_patch_uv.copy_to_device();
@@ -1914,28 +1938,44 @@ void MeshManager::device_update_mesh(
   if (curve_size != 0) {
     progress.set_status("Updating Mesh", "Copying Strands to device");
 
+    const bool pack_all_curves = pack_all || dscene->curve_keys.size() != curve_key_size ||
+                                 dscene->curves.size() != curve_size;
+    bool curves_packed = pack_all_curves;
+
     float4 *curve_keys = dscene->curve_keys.alloc(curve_key_size);
     float4 *curves = dscene->curves.alloc(curve_size);
 
     foreach (Mesh *mesh, scene->meshes) {
-      mesh->pack_curves(scene,
-                        &curve_keys[mesh->curvekey_offset],
-                        &curves[mesh->curve_offset],
-                        mesh->curvekey_offset);
+      if (pack_all_curves || mesh->need_update_pack) {
+        mesh->pack_curves(scene,
+                          &curve_keys[mesh->curvekey_offset],
+                          &curves[mesh->curve_offset],
+                          mesh->curvekey_offset);
+        curves_packed = true;
+      }
       if (progress.get_cancel())
         return;
     }
 
-    dscene->curve_keys.copy_to_device();
-    dscene->curves.copy_to_device();
+    if (curves_packed) {
+      dscene->curve_keys.copy_to_device();
+      dscene->curves.copy_to_device();
+    }
   }
 
   if (patch_size != 0) {
     progress.set_status("Updating Mesh", "Copying Patches to device");
 
+    const bool pack_all_patches = pack_all || dscene->patches.size() != patch_size;
+    bool patches_packed = pack_all_patches;
+
     uint *patch_data = dscene->patches.alloc(patch_size);
 
     foreach (Mesh *mesh, scene->meshes) {
+      if (!pack_all_patches && !mesh->need_update_pack) {
+        continue;
+      }
+
       mesh->pack_patches(&patch_data[mesh->patch_offset],
                          mesh->vert_offset,
                          mesh->face_offset,
@@ -1945,12 +1985,15 @@ void MeshManager::device_update_mesh(
         mesh->patch_table->copy_adjusting_offsets(&patch_data[mesh->patch_table_offset],
                                                   mesh->patch_table_offset);
       }
+      patches_packed = true;
 
       if (progress.get_cancel())
         return;
     }
 
-    dscene->patches.copy_to_device();
+    if (patches_packed) {
+      dscene->patches.copy_to_device();
+    }
   }
 
   if (for_displacement) {
@@ -1966,6 +2009,13 @@ void MeshManager::device_update_mesh(
     }
     dscene->prim_tri_verts.copy_to_device();
   }
+  else {
+    /* Only cleared for the final data, displaced meshes are packed again after displacement. */
+    foreach (Mesh *mesh, scene->meshes) {
+      mesh->need_update_pack = false;
+    }
+    packed_shaders = scene->shaders;
+  }
 }
 
 void MeshManager::device_update_bvh(Device *device,
@@ -2197,6 +2247,8 @@ void MeshManager::device_update(Device *device,
     }
 
     if (mesh->need_update) {
+      mesh->need_update_pack = true;
+
       /* Update normals. */
       mesh->add_face_normals();
       mesh->add_vertex_normals();
@@ -2261,7 +2313,7 @@ void MeshManager::device_update(Device *device,
   }
 
   /* Device update. */
-  device_free(device, dscene);
+  device_free(device, dscene, false);
 
   mesh_calc_offset(scene);
   if (true_displacement_used) {
@@ -2297,7 +2349,7 @@ void MeshManager::device_update(Device *device,
 
   /* Device re-update after displacement. */
   if (displacement_done) {
-    device_free(device, dscene);
+    device_free(device, dscene, false);
 
     device_update_attributes(device, dscene, scene, progress);
     if (progress.get_cancel())
@@ -2358,7 +2410,7 @@ void MeshManager::device_update(Device *device,
   }
 }
 
-void MeshManager::device_free(Device *device, DeviceScene *dscene)
+void MeshManager::device_free(Device *device, DeviceScene *dscene, bool force_free)
 {
   dscene->bvh_nodes.free();
   dscene->bvh_leaf_nodes.free();
@@ -2370,14 +2422,16 @@ void MeshManager::device_free(Device *device, DeviceScene *dscene)
   dscene->prim_index.free();
   dscene->prim_object.free();
   dscene->prim_time.free();
-  dscene->tri_shader.free();
-  dscene->tri_vnormal.free();
-  dscene->tri_vindex.free();
-  dscene->tri_patch.free();
-  dscene->tri_patch_uv.free();
-  dscene->curves.free();
-  dscene->curve_keys.free();
-  dscene->patches.free();
+  if (force_free) {
+    dscene->tri_shader.free();
+    dscene->tri_vnormal.free();
+    dscene->tri_vindex.free();
+    dscene->tri_patch.free();
+    dscene->tri_patch_uv.free();
+    dscene->curves.free();
+    dscene->curve_keys.free();
+    dscene->patches.free();
+  }
   dscene->attributes_map.free();
   dscene->attributes_float.free();
   dscene->attributes_float2.free();
@@ -264,6 +264,8 @@ class Mesh : public Node {
   /* Update Flags */
   bool need_update;
   bool need_update_rebuild;
+  /* Data packed in the global device arrays is outdated, see #MeshManager::device_update_mesh. */
+  bool need_update_pack;
 
   /* BVH */
   BVH *bvh;
@@ -390,7 +392,9 @@ class MeshManager {
   void device_update_preprocess(Device *device, Scene *scene, Progress &progress);
   void device_update(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
 
-  void device_free(Device *device, DeviceScene *dscene);
+  /* Without force_free the packed mesh arrays are kept, so meshes which didn't change don't have
+   * to be packed again. */
+  void device_free(Device *device, DeviceScene *dscene, bool force_free);
 
   void tag_update(Scene *scene);
 
@@ -399,6 +403,9 @@ class MeshManager {
   void collect_statistics(const Scene *scene, RenderStats *stats);
 
  protected:
+  /* Shaders at the time the meshes were last packed, shader IDs are indices into this. */
+  vector<Shader *> packed_shaders;
+
   /* Calculate verts/triangles/curves offsets in global arrays. */
   void mesh_calc_offset(Scene *scene);
 
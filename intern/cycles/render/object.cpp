@@ -656,7 +656,11 @@ void ObjectManager::device_update(Device *device,
 
   /* prepare for static BVH building */
   /* todo: do before to support getting object level coords? */
-  if (scene->params.bvh_type == SceneParams::BVH_STATIC) {
+  /* With persistent data meshes are kept in object space and get their own BVH, so only the
+   * top level BVH is rebuilt for the next frame while the BVHs of unchanged meshes are reused.
+   * Applying the transform would flatten them into the top level BVH and require a resync and
+   * full rebuild whenever the object moves. */
+  if (scene->params.bvh_type == SceneParams::BVH_STATIC && !scene->params.persistent_data) {
     progress.set_status("Updating Objects", "Applying Static Transformations");
     apply_static_transforms(dscene, scene, progress);
   }
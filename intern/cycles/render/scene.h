@@ -169,6 +169,10 @@ class SceneParams {
   int num_bvh_time_steps;
   bool persistent_data;
   int texture_limit;
+  /* Total memory used by image textures in bytes, zero for no limit. */
+  size_t texture_memory_limit;
+  /* Store float images which are not non-color data at half precision. */
+  bool texture_use_half_float;
 
   bool background;
 
@@ -182,6 +186,8 @@ class SceneParams {
     num_bvh_time_steps = 0;
     persistent_data = false;
     texture_limit = 0;
+    texture_memory_limit = 0;
+    texture_use_half_float = false;
     background = true;
   }
 
@@ -192,7 +198,9 @@ class SceneParams {
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
-             persistent_data == params.persistent_data && texture_limit == params.texture_limit);
+             persistent_data == params.persistent_data && texture_limit == params.texture_limit &&
+             texture_memory_limit == params.texture_memory_limit &&
+             texture_use_half_float == params.texture_use_half_float);
   }
 };
 
@@ -387,8 +387,17 @@ bool Session::acquire_tile(Device *tile_device, RenderTile &rtile)
   Tile *tile;
   int device_num = device->device_number(tile_device);
 
-  if (!tile_manager.next_tile(tile, device_num))
-    return false;
+  /* Denoising tiles become available as their neighbors finish rendering, so keep the thread
+   * around for them rather than leaving the remaining denoising to the last rendering threads. */
+  while (!tile_manager.next_tile(tile, device_num)) {
+    if (!tile_manager.has_pending_denoising()) {
+      return false;
+    }
+    tile_cond.wait(tile_lock);
+    if (progress.get_cancel() && params.progressive_refine == false) {
+      return false;
+    }
+  }
 
   /* fill render tile */
   rtile.x = tile_manager.state.buffer.full_x + tile->x;
@@ -484,6 +493,8 @@ void Session::release_tile(RenderTile &rtile)
   }
 
   update_status_time();
+
+  tile_cond.notify_all();
 }
 
 void Session::map_neighbor_tiles(RenderTile *tiles, Device *tile_device)
@@ -1126,6 +1137,9 @@ void Session::device_free()
 void Session::collect_statistics(RenderStats *render_stats)
 {
   scene->collect_statistics(render_stats);
+  render_stats->mem_used = stats.mem_used;
+  render_stats->mem_peak = stats.mem_peak;
+  progress.get_time(render_stats->total_time, render_stats->render_time);
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
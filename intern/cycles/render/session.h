@@ -211,6 +211,7 @@ class Session {
   thread_condition_variable pause_cond;
   thread_mutex pause_mutex;
   thread_mutex tile_mutex;
+  thread_condition_variable tile_cond;
   thread_mutex buffers_mutex;
   thread_mutex display_mutex;
 
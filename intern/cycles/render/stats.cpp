@@ -45,6 +45,24 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+string json_string(const string &str)
+{
+  string result = "\"";
+  foreach (char c, str) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    }
+    else if ((unsigned char)c < 0x20) {
+      result += string_printf("\\u%04x", c);
+    }
+    else {
+      result += c;
+    }
+  }
+  return result + "\"";
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : name(""), size(0)
@@ -87,6 +105,19 @@ string NamedSizeStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSizeStats::json_report()
+{
+  sort(entries.begin(), entries.end(), namedSizeEntryComparator);
+  string result = string_printf("{\"total_size\": %zu, \"entries\": [", total_size);
+  for (size_t i = 0; i < entries.size(); i++) {
+    result += string_printf("%s{\"name\": %s, \"size\": %zu}",
+                            (i == 0) ? "" : ", ",
+                            json_string(entries[i].name).c_str(),
+                            entries[i].size);
+  }
+  return result + "]}";
+}
+
 /* Named time sample statistics. */
 
 NamedNestedSampleStats::NamedNestedSampleStats() : name(""), self_samples(0), sum_samples(0)
@@ -142,6 +173,25 @@ string NamedNestedSampleStats::full_report(int indent_level, uint64_t total_samp
   return result;
 }
 
+string NamedNestedSampleStats::json_report()
+{
+  update_sum();
+
+  string result = string_printf("{\"name\": %s, \"total_seconds\": %.3f, \"self_seconds\": %.3f",
+                                json_string(name).c_str(),
+                                sum_samples * 0.001,
+                                self_samples * 0.001);
+  if (!entries.empty()) {
+    sort(entries.begin(), entries.end(), namedTimeSampleEntryComparator);
+    result += ", \"entries\": [";
+    for (size_t i = 0; i < entries.size(); i++) {
+      result += ((i == 0) ? "" : ", ") + entries[i].json_report();
+    }
+    result += "]";
+  }
+  return result + "}";
+}
+
 /* Named sample count pairs. */
 
 NamedSampleCountPair::NamedSampleCountPair(const ustring &name, uint64_t samples, uint64_t hits)
@@ -196,6 +246,27 @@ string NamedSampleCountStats::full_report(int indent_level)
   return result;
 }
 
+string NamedSampleCountStats::json_report()
+{
+  vector<NamedSampleCountPair> sorted_entries;
+  sorted_entries.reserve(entries.size());
+  foreach (entry_map::const_reference entry, entries) {
+    sorted_entries.push_back(entry.second);
+  }
+  sort(sorted_entries.begin(), sorted_entries.end(), namedSampleCountPairComparator);
+
+  string result = "[";
+  for (size_t i = 0; i < sorted_entries.size(); i++) {
+    const NamedSampleCountPair &entry = sorted_entries[i];
+    result += string_printf("%s{\"name\": %s, \"seconds\": %.3f, \"hits\": %llu}",
+                            (i == 0) ? "" : ", ",
+                            json_string(entry.name.string()).c_str(),
+                            entry.samples * 0.001,
+                            (unsigned long long)entry.hits);
+  }
+  return result + "]";
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats()
@@ -229,6 +300,10 @@ string ImageStats::full_report(int indent_level)
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  mem_used = 0;
+  mem_peak = 0;
+  render_time = 0.0;
+  total_time = 0.0;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -317,4 +392,21 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  string result = "{";
+  result += string_printf(
+      "\"total_time\": %.3f, \"render_time\": %.3f, ", total_time, render_time);
+  result += string_printf(
+      "\"device_memory\": {\"used\": %zu, \"peak\": %zu}, ", mem_used, mem_peak);
+  result += "\"geometry\": " + mesh.geometry.json_report() + ", ";
+  result += "\"textures\": " + image.textures.json_report();
+  if (has_profiling) {
+    result += ", \"kernel\": " + kernel.json_report();
+    result += ", \"shaders\": " + shaders.json_report();
+    result += ", \"objects\": " + objects.json_report();
+  }
+  return result + "}";
+}
+
 CCL_NAMESPACE_END
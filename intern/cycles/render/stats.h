@@ -55,6 +55,9 @@ class NamedSizeStats {
   /* Generate full human-readable report. */
   string full_report(int indent_level = 0);
 
+  /* Generate report as a JSON object. */
+  string json_report();
+
   /* Total size of all entries. */
   size_t total_size;
 
@@ -75,6 +78,7 @@ class NamedNestedSampleStats {
   void update_sum();
 
   string full_report(int indent_level = 0, uint64_t total_samples = 0);
+  string json_report();
 
   string name;
 
@@ -103,6 +107,7 @@ class NamedSampleCountStats {
   NamedSampleCountStats();
 
   string full_report(int indent_level = 0);
+  string json_report();
   void add(const ustring &name, uint64_t samples, uint64_t hits);
 
   typedef unordered_map<ustring, NamedSampleCountPair, ustringHash> entry_map;
@@ -143,11 +148,20 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return full report as a single line JSON object, for parsing by other tools. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
   bool has_profiling;
 
+  /* Device memory and time of the render. */
+  size_t mem_used;
+  size_t mem_peak;
+  double render_time;
+  double total_time;
+
   MeshStats mesh;
   ImageStats image;
   NamedNestedSampleStats kernel;
@@ -27,6 +27,8 @@
 
 #include "util/util_logging.h"
 #include "util/util_foreach.h"
+#include "util/util_map.h"
+#include "util/util_murmurhash.h"
 #include "util/util_progress.h"
 #include "util/util_task.h"
 
@@ -106,16 +108,45 @@ void SVMShaderManager::device_update(Device *device,
     return;
   }
 
+  /* Shaders which compiled to the same nodes, like duplicated materials, share them. Nodes only
+   * use offsets relative to their own position, so they don't depend on where they are stored. */
+  vector<int> shader_source(num_shaders);
+  unordered_multimap<uint32_t, int> shader_hashes;
+  int num_shared_shaders = 0;
+  for (int i = 0; i < num_shaders; i++) {
+    const array<int4> &nodes = shader_svm_nodes[i];
+    const uint32_t hash = util_murmur_hash3(nodes.data(), nodes.size() * sizeof(int4), 0);
+    shader_source[i] = i;
+
+    typedef unordered_multimap<uint32_t, int>::const_iterator HashIterator;
+    pair<HashIterator, HashIterator> range = shader_hashes.equal_range(hash);
+    for (HashIterator it = range.first; it != range.second; ++it) {
+      if (shader_svm_nodes[it->second] == nodes) {
+        shader_source[i] = it->second;
+        num_shared_shaders++;
+        break;
+      }
+    }
+    if (shader_source[i] == i) {
+      shader_hashes.insert(std::make_pair(hash, i));
+    }
+  }
+
+  VLOG(1) << "Shaders sharing nodes with another shader: " << num_shared_shaders;
+
   /* The global node list contains a jump table (one node per shader)
    * followed by the nodes of all shaders. */
   int svm_nodes_size = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
     /* Since we're not copying the local jump node, the size ends up being one node lower. */
-    svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    if (shader_source[i] == i) {
+      svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    }
   }
 
   int4 *svm_nodes = dscene->svm_nodes.alloc(svm_nodes_size);
 
+  vector<int> shader_node_offset(num_shaders);
   int node_offset = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
     Shader *shader = scene->shaders[i];
@@ -125,23 +156,31 @@ void SVMShaderManager::device_update(Device *device,
       scene->light_manager->need_update = true;
     }
 
+    const int source = shader_source[i];
+    if (source == i) {
+      shader_node_offset[i] = node_offset;
+      node_offset += shader_svm_nodes[i].size() - 1;
+    }
+
     /* Update the global jump table.
      * Each compiled shader starts with a jump node that has offsets local
      * to the shader, so copy those and add the offset into the global node list. */
     int4 &global_jump_node = svm_nodes[shader->id];
-    int4 &local_jump_node = shader_svm_nodes[i][0];
+    int4 &local_jump_node = shader_svm_nodes[source][0];
 
     global_jump_node.x = NODE_SHADER_JUMP;
-    global_jump_node.y = local_jump_node.y - 1 + node_offset;
-    global_jump_node.z = local_jump_node.z - 1 + node_offset;
-    global_jump_node.w = local_jump_node.w - 1 + node_offset;
-
-    node_offset += shader_svm_nodes[i].size() - 1;
+    global_jump_node.y = local_jump_node.y - 1 + shader_node_offset[source];
+    global_jump_node.z = local_jump_node.z - 1 + shader_node_offset[source];
+    global_jump_node.w = local_jump_node.w - 1 + shader_node_offset[source];
   }
 
   /* Copy the nodes of each shader into the correct location. */
   svm_nodes += num_shaders;
   for (int i = 0; i < num_shaders; i++) {
+    if (shader_source[i] != i) {
+      continue;
+    }
+
     int shader_size = shader_svm_nodes[i].size() - 1;
 
     memcpy(svm_nodes, &shader_svm_nodes[i][1], sizeof(int4) * shader_size);
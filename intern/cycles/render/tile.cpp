@@ -18,6 +18,7 @@
 
 #include "util/util_algorithm.h"
 #include "util/util_foreach.h"
+#include "util/util_task.h"
 #include "util/util_types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -106,6 +107,7 @@ TileManager::TileManager(bool progressive_,
   preserve_tile_device = preserve_tile_device_;
   background = background_;
   schedule_denoising = false;
+  split_tail_tiles = false;
 
   range_start_sample = 0;
   range_num_samples = -1;
@@ -120,6 +122,8 @@ TileManager::~TileManager()
 
 void TileManager::device_free()
 {
+  update_device_weights();
+
   if (schedule_denoising || progressive) {
     for (int i = 0; i < state.tiles.size(); i++) {
       delete state.tiles[i].buffers;
@@ -130,6 +134,38 @@ void TileManager::device_free()
   state.tiles.clear();
 }
 
+void TileManager::update_device_weights()
+{
+  if (!preserve_tile_device || num_devices < 2 || state.tiles.empty()) {
+    return;
+  }
+
+  vector<double> area(num_devices, 0.0), time(num_devices, 0.0);
+  foreach (Tile &tile, state.tiles) {
+    if (tile.buffers && tile.device < num_devices) {
+      area[tile.device] += (double)tile.w * tile.h;
+      time[tile.device] += tile.buffers->render_time;
+    }
+  }
+
+  /* All devices render the same number of samples, so pixels per second compare their speed. */
+  vector<float> weights(num_devices);
+  float total_weight = 0.0f;
+  for (int i = 0; i < num_devices; i++) {
+    /* Keep the previous weights until every device rendered something. */
+    if (time[i] <= 0.0 || area[i] <= 0.0) {
+      return;
+    }
+    weights[i] = (float)(area[i] / time[i]);
+    total_weight += weights[i];
+  }
+
+  for (int i = 0; i < num_devices; i++) {
+    weights[i] /= total_weight;
+  }
+  device_weights = weights;
+}
+
 static int get_divider(int w, int h, int start_resolution)
 {
   int divider = 1;
@@ -313,11 +349,28 @@ int TileManager::gen_tiles(bool sliced)
     return tile_w * tile_h;
   }
 
+  /* Size the slices by the speed of the devices rendering them, keeping at least one row each. */
+  const bool use_device_weights = (slice_num > 1 && (int)device_weights.size() == slice_num);
+  vector<int> slice_offsets(slice_num + 1, image_h);
+  float weight_offset = 0.0f;
+  for (int slice = 0; slice < slice_num; slice++) {
+    if (use_device_weights) {
+      int offset = (int)(weight_offset * image_h);
+      if (slice > 0) {
+        offset = max(offset, slice_offsets[slice - 1] + 1);
+      }
+      slice_offsets[slice] = min(offset, image_h - (slice_num - slice));
+      weight_offset += device_weights[slice];
+    }
+    else {
+      slice_offsets[slice] = (image_h / slice_num) * slice;
+    }
+  }
+
   int idx = 0;
   for (int slice = 0; slice < slice_num; slice++) {
-    int slice_y = (image_h / slice_num) * slice;
-    int slice_h = (slice == slice_num - 1) ? image_h - slice * (image_h / slice_num) :
-                                             image_h / slice_num;
+    int slice_y = slice_offsets[slice];
+    int slice_h = slice_offsets[slice + 1] - slice_y;
 
     int tile_h = (tile_size.y >= slice_h) ? 1 : divide_up(slice_h, tile_size.y);
 
@@ -367,6 +420,51 @@ void TileManager::gen_render_tiles()
   }
 }
 
+int TileManager::gen_tail_tiles()
+{
+  /* Tiles smaller than this are not split any further. */
+  const int min_tile_size = 8;
+  const int num_threads = max(TaskScheduler::num_threads(), 1);
+  int num_added = 0;
+
+  foreach (list<int> &tile_list, state.render_tiles) {
+    /* Only the last tiles are rendered while threads are running out of work, cut them off and
+     * add their quarters in the same order instead. */
+    list<int>::iterator tail_begin = tile_list.end();
+    for (int i = 0; i < num_threads && tail_begin != tile_list.begin(); i++) {
+      --tail_begin;
+    }
+    list<int> tail;
+    tail.splice(tail.begin(), tile_list, tail_begin, tile_list.end());
+
+    foreach (int index, tail) {
+      /* Copy, the tiles vector can be reallocated below. */
+      const Tile tile = state.tiles[index];
+      if (tile.w < 2 * min_tile_size || tile.h < 2 * min_tile_size) {
+        tile_list.push_back(index);
+        continue;
+      }
+
+      /* The original tile is never handed out. */
+      state.tiles[index].state = Tile::DONE;
+
+      const int half_w = tile.w / 2, half_h = tile.h / 2;
+      for (int i = 0; i < 4; i++) {
+        const int x = (i & 1) ? tile.x + half_w : tile.x;
+        const int y = (i & 2) ? tile.y + half_h : tile.y;
+        const int w = (i & 1) ? tile.w - half_w : half_w;
+        const int h = (i & 2) ? tile.h - half_h : half_h;
+        const int idx = state.tiles.size();
+        state.tiles.push_back(Tile(idx, x, y, w, h, tile.device, Tile::RENDER));
+        tile_list.push_back(idx);
+      }
+      num_added += 3;
+    }
+  }
+
+  return num_added;
+}
+
 void TileManager::set_tiles()
 {
   int resolution = state.resolution_divider;
@@ -374,6 +472,11 @@ void TileManager::set_tiles()
   int image_h = max(1, params.height / resolution);
 
   state.num_tiles = gen_tiles(!background);
+  /* Denoising relies on the regular tile grid to find neighbors, and progressive rendering
+   * regenerates the lists from all tiles. */
+  if (split_tail_tiles && background && !progressive && !schedule_denoising) {
+    state.num_tiles += gen_tail_tiles();
+  }
 
   state.buffer.width = image_w;
   state.buffer.height = image_h;
@@ -500,6 +603,23 @@ bool TileManager::next_tile(Tile *&tile, int device)
   return true;
 }
 
+/* Returns whether tiles which are still being rendered or denoised can make more tiles ready
+ * for denoising, in which case threads out of tiles should wait for them instead of exiting. */
+bool TileManager::has_pending_denoising()
+{
+  if (!schedule_denoising || progressive) {
+    return false;
+  }
+
+  foreach (Tile &tile, state.tiles) {
+    if (tile.state == Tile::RENDER || tile.state == Tile::DENOISE) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 bool TileManager::done()
 {
   int end_sample = (range_num_samples == -1) ? num_samples :
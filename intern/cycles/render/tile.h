@@ -107,6 +107,7 @@ class TileManager {
   bool next();
   bool next_tile(Tile *&tile, int device = 0);
   bool finish_tile(int index, bool &delete_tile);
+  bool has_pending_denoising();
   bool done();
 
   void set_tile_order(TileOrder tile_order_)
@@ -128,6 +129,11 @@ class TileManager {
   /* Schedule tiles for denoising after they've been rendered. */
   bool schedule_denoising;
 
+  /* Split the tiles rendered last into smaller ones, so that threads finishing early still have
+   * work while the remaining tiles are being rendered. Requires tiles to not need to match the
+   * render parts of the host application. */
+  bool split_tail_tiles;
+
  protected:
   void set_tiles();
 
@@ -157,9 +163,17 @@ class TileManager {
    */
   bool background;
 
+  /* Relative rendering speed of every device, measured on the slices they rendered. Used to size
+   * the slices so that all devices finish at the same time. */
+  vector<float> device_weights;
+
   /* Generate tile list, return number of tiles. */
   int gen_tiles(bool sliced);
   void gen_render_tiles();
+  /* Split the tail of the render tile lists, return number of added tiles. */
+  int gen_tail_tiles();
+
+  void update_device_weights();
 
   int get_neighbor_index(int index, int neighbor);
   bool check_neighbor_state(int index, Tile::State state);
@@ -212,6 +212,11 @@ struct CPUCapabilities {
   bool fma4;
   bool bmi1;
   bool bmi2;
+  bool avx512f;
+  bool avx512cd;
+  bool avx512dq;
+  bool avx512bw;
+  bool avx512vl;
 };
 
 static CPUCapabilities &system_cpu_capabilities()
@@ -240,6 +245,7 @@ static CPUCapabilities &system_cpu_capabilities()
 
       caps.fma3 = (result[2] & ((int)1 << 12)) != 0;
       caps.avx = false;
+      bool os_avx512_support = false;
       bool os_uses_xsave_xrestore = (result[2] & ((int)1 << 27)) != 0;
       bool cpu_avx_support = (result[2] & ((int)1 << 28)) != 0;
 
@@ -257,6 +263,8 @@ static CPUCapabilities &system_cpu_capabilities()
         xcr_feature_mask = 0;
 #  endif
         caps.avx = (xcr_feature_mask & 0x6) == 0x6;
+        /* The OS also has to save the opmask and upper ZMM registers. */
+        os_avx512_support = (xcr_feature_mask & 0xe6) == 0xe6;
       }
 
       caps.f16c = (result[2] & ((int)1 << 29)) != 0;
@@ -265,6 +273,14 @@ static CPUCapabilities &system_cpu_capabilities()
       caps.bmi1 = (result[1] & ((int)1 << 3)) != 0;
       caps.bmi2 = (result[1] & ((int)1 << 8)) != 0;
       caps.avx2 = (result[1] & ((int)1 << 5)) != 0;
+
+      if (os_avx512_support) {
+        caps.avx512f = (result[1] & ((int)1 << 16)) != 0;
+        caps.avx512dq = (result[1] & ((int)1 << 17)) != 0;
+        caps.avx512cd = (result[1] & ((int)1 << 28)) != 0;
+        caps.avx512bw = (result[1] & ((int)1 << 30)) != 0;
+        caps.avx512vl = (result[1] & ((int)1 << 31)) != 0;
+      }
     }
 
     caps_init = true;
@@ -303,6 +319,13 @@ bool system_cpu_support_avx2()
   return caps.sse && caps.sse2 && caps.sse3 && caps.ssse3 && caps.sse41 && caps.avx && caps.f16c &&
          caps.avx2 && caps.fma3 && caps.bmi1 && caps.bmi2;
 }
+
+bool system_cpu_support_avx512()
+{
+  CPUCapabilities &caps = system_cpu_capabilities();
+  return system_cpu_support_avx2() && caps.avx512f && caps.avx512cd && caps.avx512dq &&
+         caps.avx512bw && caps.avx512vl;
+}
 #else
 
 bool system_cpu_support_sse2()
@@ -329,6 +352,11 @@ bool system_cpu_support_avx2()
   return false;
 }
 
+bool system_cpu_support_avx512()
+{
+  return false;
+}
+
 #endif
 
 bool system_call_self(const vector<string> &args)
@@ -199,6 +199,43 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including mmap allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Categories memory usage is broken down into, see #MEM_category_begin.
+ * Memory which is not allocated in any category is in #MEM_CATEGORY_OTHER.
+ */
+typedef enum eMEMCategory {
+  MEM_CATEGORY_OTHER = 0,
+  /** Layers of mesh data. */
+  MEM_CATEGORY_MESH,
+  /** Undo steps. */
+  MEM_CATEGORY_UNDO,
+  /** Data of the draw manager, like the batch caches of meshes. */
+  MEM_CATEGORY_DRAW_CACHE,
+  /** Pixels of image buffers. */
+  MEM_CATEGORY_IMAGE,
+  /** Copies of data-blocks evaluated by the dependency graph, with the data they create. */
+  MEM_CATEGORY_EVALUATED,
+
+  MEM_CATEGORY_NUM,
+} eMEMCategory;
+
+/**
+ * Count the memory allocated by the calling thread until #MEM_category_end in the category.
+ * When the thread already allocates in a category, that outer category is kept: evaluated mesh
+ * data is counted as evaluated, not as mesh data.
+ * Blocks allocated by #MEM_dupallocN and #MEM_reallocN are in the category of the calling thread
+ * too, whatever the category of the original block.
+ *
+ * \return The category of the thread before, to pass to #MEM_category_end.
+ */
+eMEMCategory MEM_category_begin(eMEMCategory category);
+void MEM_category_end(eMEMCategory category_prev);
+
+/** Get the memory in use of a category, in bytes. This is cheap enough to call at any time. */
+size_t MEM_get_memory_in_use_category(eMEMCategory category) ATTR_WARN_UNUSED_RESULT;
+/** Name of a category, to display in reports. */
+const char *MEM_category_name(eMEMCategory category) ATTR_WARN_UNUSED_RESULT;
+
 #ifdef __GNUC__
 #  define MEM_SAFE_FREE(v) \
     do { \
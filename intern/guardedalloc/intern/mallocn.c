@@ -26,6 +26,7 @@
 #include "../../source/blender/blenlib/BLI_strict_flags.h"
 
 #include <assert.h>
+#include <stdio.h>
 
 #include "mallocn_intern.h"
 
@@ -68,6 +69,66 @@ size_t (*MEM_get_peak_memory)(void) = MEM_lockfree_get_peak_memory;
 const char *(*MEM_name_ptr)(void *vmemh) = MEM_lockfree_name_ptr;
 #endif
 
+MEM_THREAD_LOCAL eMEMCategory mem_category_current = MEM_CATEGORY_OTHER;
+size_t mem_category_in_use[MEM_CATEGORY_NUM] = {0};
+
+static const char *mem_category_names[MEM_CATEGORY_NUM] = {
+    "Other",
+    "Mesh",
+    "Undo",
+    "Draw Cache",
+    "Image",
+    "Evaluated",
+};
+
+eMEMCategory MEM_category_begin(eMEMCategory category)
+{
+  const eMEMCategory category_prev = mem_category_current;
+  if (category_prev == MEM_CATEGORY_OTHER) {
+    mem_category_current = category;
+  }
+  return category_prev;
+}
+
+void MEM_category_end(eMEMCategory category_prev)
+{
+  mem_category_current = category_prev;
+}
+
+size_t MEM_get_memory_in_use_category(eMEMCategory category)
+{
+  assert(category < MEM_CATEGORY_NUM);
+  if (category != MEM_CATEGORY_OTHER) {
+    return mem_category_in_use[category];
+  }
+  size_t len = MEM_get_memory_in_use();
+  for (int i = MEM_CATEGORY_OTHER + 1; i < MEM_CATEGORY_NUM; i++) {
+    len -= mem_category_in_use[i];
+  }
+  return len;
+}
+
+const char *MEM_category_name(eMEMCategory category)
+{
+  assert(category < MEM_CATEGORY_NUM);
+  return mem_category_names[category];
+}
+
+void mem_category_print_stats(size_t mem_in_use)
+{
+  printf("\nmemory per category:\n");
+  size_t len_other = mem_in_use;
+  for (int i = MEM_CATEGORY_OTHER + 1; i < MEM_CATEGORY_NUM; i++) {
+    printf("  %s: %.3f MB\n",
+           mem_category_names[i],
+           (double)mem_category_in_use[i] / (double)(1024 * 1024));
+    len_other -= mem_category_in_use[i];
+  }
+  printf("  %s: %.3f MB\n",
+         mem_category_names[MEM_CATEGORY_OTHER],
+         (double)len_other / (double)(1024 * 1024));
+}
+
 void *aligned_malloc(size_t size, size_t alignment)
 {
   /* posix_memalign requires alignment to be a multiple of sizeof(void *). */
@@ -108,6 +108,7 @@ typedef struct MemHead {
   short alignment; /* if non-zero aligned alloc was used
                     * and alignment is stored here.
                     */
+  short category;  /* eMEMCategory */
 #ifdef DEBUG_MEMCOUNTER
   int _count;
 #endif
@@ -480,6 +481,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
   memh->len = len;
   memh->mmap = 0;
   memh->alignment = 0;
+  memh->category = (short)mem_category_current;
   memh->tag2 = MEMTAG2;
 
 #ifdef DEBUG_MEMDUPLINAME
@@ -495,6 +497,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
 
   atomic_add_and_fetch_u(&totblock, 1);
   atomic_add_and_fetch_z(&mem_in_use, len);
+  mem_category_add((eMEMCategory)memh->category, len);
 
   mem_lock_thread();
   addtail(membase, &memh->next);
@@ -805,6 +808,8 @@ void MEM_guarded_printmemlist_stats(void)
   printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
   printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
   printf("slop memory len: %.3f MB\n", (double)mem_in_use_slop / (double)(1024 * 1024));
+  mem_category_print_stats(mem_in_use);
+  printf("\n");
   printf(" ITEMS TOTAL-MiB AVERAGE-KiB TYPE\n");
   for (a = 0, pb = printblock; a < totpb; a++, pb++) {
     printf("%6d (%8.3f  %8.3f) %s\n",
@@ -1092,6 +1097,7 @@ static void rem_memblock(MemHead *memh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, memh->len);
+  mem_category_sub((eMEMCategory)memh->category, memh->len);
 
 #ifdef DEBUG_MEMDUPLINAME
   if (memh->need_free_name)
@@ -24,6 +24,8 @@
 #ifndef __MALLOCN_INTERN_H__
 #define __MALLOCN_INTERN_H__
 
+#include "atomic_ops.h"
+
 /* mmap exception */
 #if defined(WIN32)
 #  include "mmap_win.h"
@@ -98,6 +100,33 @@ size_t malloc_usable_size(void *ptr);
 
 #define IS_POW2(a) (((a) & ((a)-1)) == 0)
 
+#ifdef _MSC_VER
+#  define MEM_THREAD_LOCAL __declspec(thread)
+#else
+#  define MEM_THREAD_LOCAL __thread
+#endif
+
+/* Category of the allocations of the thread, see #MEM_category_begin. */
+extern MEM_THREAD_LOCAL eMEMCategory mem_category_current;
+/* Memory in use per category, #MEM_CATEGORY_OTHER isn't counted since it's all the rest. */
+extern size_t mem_category_in_use[MEM_CATEGORY_NUM];
+
+MEM_INLINE void mem_category_add(eMEMCategory category, size_t len)
+{
+  if (category != MEM_CATEGORY_OTHER) {
+    atomic_add_and_fetch_z(&mem_category_in_use[category], len);
+  }
+}
+
+MEM_INLINE void mem_category_sub(eMEMCategory category, size_t len)
+{
+  if (category != MEM_CATEGORY_OTHER) {
+    atomic_sub_and_fetch_z(&mem_category_in_use[category], len);
+  }
+}
+
+void mem_category_print_stats(size_t mem_in_use);
+
 /* Extra padding which needs to be applied on MemHead to make it aligned. */
 #define MEMHEAD_ALIGN_PADDING(alignment) \
   ((size_t)alignment - (sizeof(MemHeadAligned) % (size_t)alignment))
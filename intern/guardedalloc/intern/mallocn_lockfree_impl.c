@@ -25,6 +25,10 @@
 #include <stdarg.h>
 #include <sys/types.h>
 
+#ifdef WITH_MEM_SMALL_BLOCK_CACHE
+#  include <pthread.h>
+#endif
+
 #include "MEM_guardedalloc.h"
 
 /* to ensure strict conversions */
@@ -62,6 +66,14 @@ enum {
 #define MEMHEAD_IS_MMAP(memhead) ((memhead)->len & (size_t)MEMHEAD_MMAP_FLAG)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
 
+/* On 64 bit the category is stored in the highest byte of the length, no block is that large. */
+#define MEMHEAD_HAS_CATEGORY (sizeof(size_t) >= 8)
+#define MEMHEAD_CATEGORY_SHIFT (sizeof(size_t) * 8 - 8)
+#define MEMHEAD_CATEGORY_MASK (MEMHEAD_HAS_CATEGORY ? (size_t)0xff << MEMHEAD_CATEGORY_SHIFT : 0)
+#define MEMHEAD_CATEGORY(memhead) \
+  (MEMHEAD_HAS_CATEGORY ? (eMEMCategory)((memhead)->len >> MEMHEAD_CATEGORY_SHIFT) : \
+                          MEM_CATEGORY_OTHER)
+
 /* Uncomment this to have proper peak counter. */
 #define USE_ATOMIC_MAX
 
@@ -74,6 +86,145 @@ MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
 #endif
 }
 
+/* Length to store in the MemHead of a new block, counting it in the category of the thread. */
+MEM_INLINE size_t memhead_len_init(size_t len, size_t flags)
+{
+  const eMEMCategory category = mem_category_current;
+  mem_category_add(category, len);
+  if (MEMHEAD_HAS_CATEGORY) {
+    flags |= (size_t)category << MEMHEAD_CATEGORY_SHIFT;
+  }
+  return len | flags;
+}
+
+#ifdef WITH_MEM_SMALL_BLOCK_CACHE
+/* Per-thread cache of small memory blocks.
+ *
+ * Small allocations are rounded up to a size class, and freed blocks are kept in a per-thread
+ * free list of their class instead of being given back to the system allocator right away. The
+ * next allocation of the same class from that thread re-uses the block without any locking.
+ *
+ * Blocks freed from another thread than the one which allocated them simply end up in the cache
+ * of the freeing thread. The amount of blocks cached per class is limited, blocks above that
+ * limit are freed. The cache of a thread is emptied when the thread exits.
+ *
+ * Only regular allocations go through the cache, aligned and mmap ones are never cached. The
+ * length stored in the MemHead is still the requested one, the size class is derived from it. */
+
+#  define SMALL_BLOCK_CLASS_STEP 16
+#  define SMALL_BLOCK_NUM_CLASSES 16
+#  define SMALL_BLOCK_MAX_SIZE (SMALL_BLOCK_CLASS_STEP * SMALL_BLOCK_NUM_CLASSES)
+/* Maximum number of cached blocks per size class and thread. */
+#  define SMALL_BLOCK_MAX_CACHED 256
+
+typedef struct SmallBlockFree {
+  MemHead head;
+  struct SmallBlockFree *next;
+} SmallBlockFree;
+
+typedef struct SmallBlockCache {
+  SmallBlockFree *free_blocks[SMALL_BLOCK_NUM_CLASSES];
+  unsigned int num_free_blocks[SMALL_BLOCK_NUM_CLASSES];
+} SmallBlockCache;
+
+static pthread_key_t small_block_cache_key;
+static pthread_once_t small_block_cache_key_once = PTHREAD_ONCE_INIT;
+
+/* Statistics, printed by #MEM_lockfree_printmemlist_stats. */
+static size_t small_block_num_reused = 0, small_block_num_allocated = 0;
+static size_t small_block_num_cached = 0, small_block_mem_cached = 0;
+
+MEM_INLINE unsigned int small_block_class_index(size_t len)
+{
+  return (len == 0) ? 0 : (unsigned int)((len - 1) / SMALL_BLOCK_CLASS_STEP);
+}
+
+MEM_INLINE size_t small_block_class_size(unsigned int class_index)
+{
+  return (size_t)(class_index + 1) * SMALL_BLOCK_CLASS_STEP;
+}
+
+static void small_block_cache_free(void *cache_v)
+{
+  SmallBlockCache *cache = (SmallBlockCache *)cache_v;
+  for (unsigned int i = 0; i < SMALL_BLOCK_NUM_CLASSES; i++) {
+    SmallBlockFree *block = cache->free_blocks[i];
+    while (block != NULL) {
+      SmallBlockFree *block_next = block->next;
+      free(block);
+      block = block_next;
+    }
+    atomic_sub_and_fetch_z(&small_block_num_cached, cache->num_free_blocks[i]);
+    atomic_sub_and_fetch_z(&small_block_mem_cached,
+                           cache->num_free_blocks[i] * small_block_class_size(i));
+  }
+  free(cache);
+}
+
+static void small_block_cache_key_create(void)
+{
+  pthread_key_create(&small_block_cache_key, small_block_cache_free);
+}
+
+static SmallBlockCache *small_block_cache_get(void)
+{
+  pthread_once(&small_block_cache_key_once, small_block_cache_key_create);
+  SmallBlockCache *cache = (SmallBlockCache *)pthread_getspecific(small_block_cache_key);
+  if (UNLIKELY(cache == NULL)) {
+    cache = (SmallBlockCache *)calloc(1, sizeof(SmallBlockCache));
+    if (cache != NULL) {
+      pthread_setspecific(small_block_cache_key, cache);
+    }
+  }
+  return cache;
+}
+
+/* Allocate memory for a block of the given (small) length, MemHead is not filled in. */
+static MemHead *small_block_alloc(size_t len, bool do_clear)
+{
+  const unsigned int class_index = small_block_class_index(len);
+  const size_t class_size = small_block_class_size(class_index);
+  SmallBlockCache *cache = small_block_cache_get();
+
+  if (LIKELY(cache != NULL) && cache->free_blocks[class_index] != NULL) {
+    SmallBlockFree *block = cache->free_blocks[class_index];
+    cache->free_blocks[class_index] = block->next;
+    cache->num_free_blocks[class_index]--;
+    atomic_sub_and_fetch_z(&small_block_num_cached, 1);
+    atomic_sub_and_fetch_z(&small_block_mem_cached, class_size);
+    atomic_add_and_fetch_z(&small_block_num_reused, 1);
+    if (do_clear) {
+      memset(&block->head + 1, 0, len);
+    }
+    return &block->head;
+  }
+
+  atomic_add_and_fetch_z(&small_block_num_allocated, 1);
+  if (do_clear) {
+    return (MemHead *)calloc(1, class_size + sizeof(MemHead));
+  }
+  return (MemHead *)malloc(class_size + sizeof(MemHead));
+}
+
+static void small_block_free(MemHead *memh, size_t len)
+{
+  const unsigned int class_index = small_block_class_index(len);
+  SmallBlockCache *cache = small_block_cache_get();
+
+  if (UNLIKELY(cache == NULL) || cache->num_free_blocks[class_index] >= SMALL_BLOCK_MAX_CACHED) {
+    free(memh);
+    return;
+  }
+
+  SmallBlockFree *block = (SmallBlockFree *)memh;
+  block->next = cache->free_blocks[class_index];
+  cache->free_blocks[class_index] = block;
+  cache->num_free_blocks[class_index]++;
+  atomic_add_and_fetch_z(&small_block_num_cached, 1);
+  atomic_add_and_fetch_z(&small_block_mem_cached, small_block_class_size(class_index));
+}
+#endif /* WITH_MEM_SMALL_BLOCK_CACHE */
+
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
 #endif
@@ -110,7 +261,8 @@ static void mem_unlock_thread(void)
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
-    return MEMHEAD_FROM_PTR(vmemh)->len & ~((size_t)(MEMHEAD_MMAP_FLAG | MEMHEAD_ALIGN_FLAG));
+    return MEMHEAD_FROM_PTR(vmemh)->len &
+           ~((size_t)(MEMHEAD_MMAP_FLAG | MEMHEAD_ALIGN_FLAG) | MEMHEAD_CATEGORY_MASK);
   }
   else {
     return 0;
@@ -132,6 +284,7 @@ void MEM_lockfree_freeN(void *vmemh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, len);
+  mem_category_sub(MEMHEAD_CATEGORY(memh), len);
 
   if (MEMHEAD_IS_MMAP(memh)) {
     atomic_sub_and_fetch_z(&mmap_in_use, len);
@@ -153,6 +306,11 @@ void MEM_lockfree_freeN(void *vmemh)
       MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
       aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
     }
+#ifdef WITH_MEM_SMALL_BLOCK_CACHE
+    else if (len <= SMALL_BLOCK_MAX_SIZE) {
+      small_block_free(memh, len);
+    }
+#endif
     else {
       free(memh);
     }
@@ -264,10 +422,18 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+#ifdef WITH_MEM_SMALL_BLOCK_CACHE
+  if (len <= SMALL_BLOCK_MAX_SIZE) {
+    memh = small_block_alloc(len, true);
+  }
+  else
+#endif
+  {
+    memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  }
 
   if (LIKELY(memh)) {
-    memh->len = len;
+    memh->len = memhead_len_init(len, 0);
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
@@ -305,14 +471,22 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+#ifdef WITH_MEM_SMALL_BLOCK_CACHE
+  if (len <= SMALL_BLOCK_MAX_SIZE) {
+    memh = small_block_alloc(len, false);
+  }
+  else
+#endif
+  {
+    memh = (MemHead *)malloc(len + sizeof(MemHead));
+  }
 
   if (LIKELY(memh)) {
     if (UNLIKELY(malloc_debug_memset && len)) {
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
+    memh->len = memhead_len_init(len, 0);
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
@@ -382,7 +556,7 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    memh->len = memhead_len_init(len, (size_t)MEMHEAD_ALIGN_FLAG);
     memh->alignment = (short)alignment;
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
@@ -419,7 +593,7 @@ void *MEM_lockfree_mapallocN(size_t len, const char *str)
 #endif
 
   if (memh != (MemHead *)-1) {
-    memh->len = len | (size_t)MEMHEAD_MMAP_FLAG;
+    memh->len = memhead_len_init(len, (size_t)MEMHEAD_MMAP_FLAG);
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     atomic_add_and_fetch_z(&mmap_in_use, len);
@@ -456,6 +630,16 @@ void MEM_lockfree_printmemlist_stats(void)
 {
   printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
   printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+  mem_category_print_stats(mem_in_use);
+#ifdef WITH_MEM_SMALL_BLOCK_CACHE
+  printf("\nsmall block cache:\n");
+  printf("  blocks re-used from cache: " SIZET_FORMAT "\n", SIZET_ARG(small_block_num_reused));
+  printf("  blocks allocated from system: " SIZET_FORMAT "\n",
+         SIZET_ARG(small_block_num_allocated));
+  printf("  blocks currently cached: " SIZET_FORMAT " (%.3f MB)\n",
+         SIZET_ARG(small_block_num_cached),
+         (double)small_block_mem_cached / (double)(1024 * 1024));
+#endif
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
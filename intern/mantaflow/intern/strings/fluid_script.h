@@ -34,6 +34,7 @@ import os.path, shutil, math, sys, gc, multiprocessing, platform, time\n\
 \n\
 withMPBake = False # Bake files asynchronously\n\
 withMPSave = True # Save files asynchronously\n\
+withMPSaveLimit = 4 # Maximum number of save processes running at the same time\n\
 isWindows = platform.system() != 'Darwin' and platform.system() != 'Linux'\n\
 # TODO (sebbas): Use this to simulate Windows multiprocessing (has default mode spawn)\n\
 #try:\n\
@@ -374,6 +375,8 @@ def fluid_post_step_$ID$():\n\
 const std::string fluid_delete_all =
     "\n\
 mantaMsg('Deleting fluid')\n\
+# Finish writing the cache files before the grids are freed\n\
+if 'fluid_cache_multiprocessing_wait_$ID$' in globals(): fluid_cache_multiprocessing_wait_$ID$()\n\
 # Clear all helper dictionaries first\n\
 mantaMsg('Clear helper dictionaries')\n\
 if 'liquid_data_dict_final_s$ID$' in globals(): liquid_data_dict_final_s$ID$.clear()\n\
@@ -468,10 +471,32 @@ def fluid_cache_multiprocessing_start_$ID$(function, framenr, format_data=None,
         if dict:\n\
             args += (dict,)\n\
         args += (resumable,)\n\
+        if not do_join:\n\
+            fluid_cache_multiprocessing_limit_$ID$()\n\
         p$ID$ = multiprocessing.Process(target=function, args=args)\n\
         p$ID$.start()\n\
         if do_join:\n\
-            p$ID$.join()\n";
+            p$ID$.join()\n\
+        else:\n\
+            mpJobs_s$ID$.append((framenr, p$ID$))\n\
+\n\
+# Processes started without joining them, oldest first\n\
+mpJobs_s$ID$ = []\n\
+\n\
+# Bound the number of pending processes so that a slow disk blocks the solver instead of piling up copies of the grids\n\
+def fluid_cache_multiprocessing_limit_$ID$():\n\
+    global mpJobs_s$ID$\n\
+    mpJobs_s$ID$ = [job for job in mpJobs_s$ID$ if job[1].is_alive()]\n\
+    while len(mpJobs_s$ID$) >= withMPSaveLimit:\n\
+        mpJobs_s$ID$.pop(0)[1].join()\n\
+\n\
+# Wait for the processes of a frame (or all of them when framenr is None) so that its files are complete\n\
+def fluid_cache_multiprocessing_wait_$ID$(framenr=None):\n\
+    global mpJobs_s$ID$\n\
+    for job in mpJobs_s$ID$:\n\
+        if framenr is None or job[0] == framenr:\n\
+            job[1].join()\n\
+    mpJobs_s$ID$ = [job for job in mpJobs_s$ID$ if job[1].is_alive()]\n";
 
 const std::string fluid_bake_data =
     "\n\
@@ -597,6 +622,8 @@ def bake_guiding_$ID$(path_guiding, framenr, format_guiding):\n\
 const std::string fluid_file_import =
     "\n\
 def fluid_file_import_s$ID$(dict, path, framenr, file_format):\n\
+    if 'fluid_cache_multiprocessing_wait_$ID$' in globals():\n\
+        fluid_cache_multiprocessing_wait_$ID$(framenr)\n\
     try:\n\
         framenr = fluid_cache_get_framenr_formatted_$ID$(framenr)\n\
         for name, object in dict.items():\n\
@@ -294,6 +294,11 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
     import sys
     from bpy_restrict_state import RestrictBlend
 
+    use_time = _bpy.app.debug_python
+    if use_time:
+        import time
+        t_start = time.time()
+
     if handle_error is None:
         def handle_error(_ex):
             import traceback
@@ -362,6 +367,9 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
                 _addon_remove(module_name)
             return None
 
+        if use_time:
+            t_import = time.time()
+
         # 1.1) Fail when add-on is too old.
         # This is a temporary 2.8x migration check, so we can manage addons that are supported.
 
@@ -397,8 +405,12 @@ def enable(module_name, *, default_set=False, persistent=False, handle_error=Non
     mod.__addon_enabled__ = True
     mod.__addon_persistent__ = persistent
 
-    if _bpy.app.debug_python:
-        print("\taddon_utils.enable", mod.__name__)
+    if use_time:
+        t_end = time.time()
+        print(
+            "\taddon_utils.enable %s, import %.4f, register %.4f" %
+            (mod.__name__, t_import - t_start, t_end - t_import)
+        )
 
     return mod
 
@@ -42,6 +42,7 @@ __all__ = (
     "register_tool",
     "make_rna_paths",
     "manual_map",
+    "memory_usage",
     "previews",
     "resource_path",
     "script_path_user",
@@ -60,6 +61,7 @@ from _bpy import (
     _utils_units as units,
     blend_paths,
     escape_identifier,
+    memory_usage,
     register_class,
     resource_path,
     script_paths as _bpy_script_paths,
@@ -272,6 +274,9 @@ def load_scripts(reload_scripts=False, refresh_scripts=False):
         bl_app_template_utils.reset(reload_scripts=reload_scripts)
         del bl_app_template_utils
 
+    if use_time:
+        t_addons = time.time()
+
     # deal with addons separately
     _initialize = getattr(_addon_utils, "_initialize", None)
     if _initialize is not None:
@@ -282,6 +287,9 @@ def load_scripts(reload_scripts=False, refresh_scripts=False):
         _addon_utils.reset_all(reload_scripts=reload_scripts)
     del _initialize
 
+    if use_time:
+        print("Python Add-on Load Time %.4f" % (time.time() - t_addons))
+
     if reload_scripts:
         import gc
         print("gc.collect() -> %d" % gc.collect())
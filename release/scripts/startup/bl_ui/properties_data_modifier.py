@@ -132,6 +132,10 @@ class DATA_PT_modifiers(ModifierButtonsPanel, Panel):
         layout.prop(md, "start_cap")
         layout.prop(md, "end_cap")
 
+        layout.separator()
+
+        layout.prop(md, "use_instances")
+
     def BEVEL(self, layout, ob, md):
         offset_type = md.offset_type
         if offset_type == 'PERCENT':
@@ -1805,6 +1805,9 @@ class SEQUENCER_PT_cache_settings(SequencerButtonsPanel, Panel):
         col.prop(ed, "use_cache_preprocessed")
         col.prop(ed, "use_cache_composite")
         col.prop(ed, "use_cache_final")
+        sub = col.column()
+        sub.active = ed.use_cache_final
+        sub.prop(ed, "use_cache_final_compress")
         col.separator()
         col.prop(ed, "recycle_max_cost")
 
@@ -596,6 +596,7 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         flow.prop(edit, "undo_steps", text="Undo Steps")
         flow.prop(edit, "undo_memory_limit", text="Undo Memory Limit")
         flow.prop(edit, "use_global_undo")
+        flow.prop(edit, "use_global_undo_disk")
 
         layout.separator()
 
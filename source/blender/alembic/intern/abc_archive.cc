@@ -28,6 +28,7 @@ extern "C" {
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 
 #include "DNA_scene_types.h"
 }
@@ -36,6 +37,7 @@ extern "C" {
 #  include "utfconv.h"
 #endif
 
+#include <algorithm>
 #include <fstream>
 
 using Alembic::Abc::ErrorHandler;
@@ -44,6 +46,8 @@ using Alembic::Abc::IArchive;
 using Alembic::Abc::kWrapExisting;
 using Alembic::Abc::OArchive;
 
+#define ABC_ARCHIVE_MAX_STREAMS 8
+
 static IArchive open_archive(const std::string &filename,
                              const std::vector<std::istream *> &input_streams,
                              bool &is_hdf5)
@@ -110,21 +114,45 @@ ArchiveReader::ArchiveReader(struct Main *bmain, const char *filename)
 #ifdef WIN32
   UTF16_ENCODE(abs_filename);
   std::wstring wstr(abs_filename_16);
-  m_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
   UTF16_UN_ENCODE(abs_filename);
-#else
-  m_infile.open(abs_filename, std::ios::in | std::ios::binary);
 #endif
 
-  m_streams.push_back(&m_infile);
+  /* Ogawa locks a stream while reading from it, with a stream per thread the objects
+   * evaluated in parallel by the depsgraph can read their samples at the same time.
+   * Limited since every stream keeps the file open. */
+  const int num_streams = std::min(BLI_system_thread_count(), ABC_ARCHIVE_MAX_STREAMS);
+  for (int i = 0; i < num_streams; i++) {
+#ifdef WIN32
+    std::ifstream *infile = new std::ifstream(wstr.c_str(), std::ios::in | std::ios::binary);
+#else
+    std::ifstream *infile = new std::ifstream(abs_filename, std::ios::in | std::ios::binary);
+#endif
+    m_infiles.push_back(infile);
+    m_streams.push_back(infile);
+  }
 
   m_archive = open_archive(abs_filename, m_streams, m_is_hdf5);
 
   /* We can't open an HDF5 file from a stream, so close it. */
   if (m_is_hdf5) {
-    m_infile.close();
-    m_streams.clear();
+    free_streams();
+  }
+}
+
+ArchiveReader::~ArchiveReader()
+{
+  /* The archive reads from the streams, release it first. */
+  m_archive.reset();
+  free_streams();
+}
+
+void ArchiveReader::free_streams()
+{
+  for (std::ifstream *infile : m_infiles) {
+    delete infile;
   }
+  m_infiles.clear();
+  m_streams.clear();
 }
 
 bool ArchiveReader::is_hdf5() const
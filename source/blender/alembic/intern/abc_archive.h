@@ -44,12 +44,15 @@ struct Scene;
 
 class ArchiveReader {
   Alembic::Abc::IArchive m_archive;
-  std::ifstream m_infile;
+  std::vector<std::ifstream *> m_infiles;
   std::vector<std::istream *> m_streams;
   bool m_is_hdf5;
 
+  void free_streams();
+
  public:
   ArchiveReader(struct Main *bmain, const char *filename);
+  ~ArchiveReader();
 
   bool valid() const;
 
@@ -365,6 +365,21 @@ void AbcGenericMeshWriter::freeEvaluatedMesh(struct Mesh *mesh)
   BKE_id_free(NULL, mesh);
 }
 
+/* Compare the topology with the one of the previous sample, and keep it when it changed. Alembic
+ * reuses the previous value of properties which are not set, which avoids hashing and storing
+ * the face arrays of deforming meshes on every frame. */
+bool AbcGenericMeshWriter::topologyIsUnchanged(std::vector<int32_t> &poly_verts,
+                                               std::vector<int32_t> &loop_counts)
+{
+  if (!m_first_frame && poly_verts == m_prev_poly_verts && loop_counts == m_prev_loop_counts) {
+    return true;
+  }
+
+  m_prev_poly_verts.swap(poly_verts);
+  m_prev_loop_counts.swap(loop_counts);
+  return false;
+}
+
 void AbcGenericMeshWriter::writeMesh(struct Mesh *mesh)
 {
   std::vector<Imath::V3f> points, normals;
@@ -379,8 +394,15 @@ void AbcGenericMeshWriter::writeMesh(struct Mesh *mesh)
     writeFaceSets(mesh, m_mesh_schema);
   }
 
-  m_mesh_sample = OPolyMeshSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
+  if (topologyIsUnchanged(poly_verts, loop_counts)) {
+    m_mesh_sample = OPolyMeshSchema::Sample(
+        V3fArraySample(points), Int32ArraySample(), Int32ArraySample());
+  }
+  else {
+    m_mesh_sample = OPolyMeshSchema::Sample(V3fArraySample(points),
+                                            Int32ArraySample(m_prev_poly_verts),
+                                            Int32ArraySample(m_prev_loop_counts));
+  }
 
   UVSample sample;
   if (m_first_frame && m_settings.export_uvs) {
@@ -440,8 +462,15 @@ void AbcGenericMeshWriter::writeSubD(struct Mesh *mesh)
     writeFaceSets(mesh, m_subdiv_schema);
   }
 
-  m_subdiv_sample = OSubDSchema::Sample(
-      V3fArraySample(points), Int32ArraySample(poly_verts), Int32ArraySample(loop_counts));
+  if (topologyIsUnchanged(poly_verts, loop_counts)) {
+    m_subdiv_sample = OSubDSchema::Sample(
+        V3fArraySample(points), Int32ArraySample(), Int32ArraySample());
+  }
+  else {
+    m_subdiv_sample = OSubDSchema::Sample(V3fArraySample(points),
+                                          Int32ArraySample(m_prev_poly_verts),
+                                          Int32ArraySample(m_prev_loop_counts));
+  }
 
   UVSample sample;
   if (m_first_frame && m_settings.export_uvs) {
@@ -823,6 +852,44 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   BKE_mesh_calc_edges(config.mesh, false, false);
 }
 
+/* Only the UVs of read_mpolys(), for meshes which already have the topology of the sample. */
+static void read_loop_uvs(CDStreamConfig &config, const AbcMeshData &mesh_data)
+{
+  MLoopUV *mloopuvs = config.mloopuv;
+
+  const Int32ArraySamplePtr &face_indices = mesh_data.face_indices;
+  const Int32ArraySamplePtr &face_counts = mesh_data.face_counts;
+  const V2fArraySamplePtr &uvs = mesh_data.uvs;
+  const UInt32ArraySamplePtr &uvs_indices = mesh_data.uvs_indices;
+
+  if (!(mloopuvs && uvs && uvs_indices) || (uvs_indices->size() != face_indices->size())) {
+    return;
+  }
+
+  const size_t uvs_size = uvs->size();
+  unsigned int loop_index = 0;
+
+  for (int i = 0; i < face_counts->size(); i++) {
+    const int face_size = (*face_counts)[i];
+
+    /* NOTE: Alembic data is stored in the reverse order. */
+    unsigned int rev_loop_index = loop_index + (face_size - 1);
+
+    for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
+      const unsigned int uv_index = (*uvs_indices)[loop_index];
+
+      /* Some Alembic files are broken (or at least export UVs in a way we don't expect). */
+      if (uv_index >= uvs_size) {
+        continue;
+      }
+
+      MLoopUV &loopuv = mloopuvs[rev_loop_index];
+      loopuv.uv[0] = (*uvs)[uv_index][0];
+      loopuv.uv[1] = (*uvs)[uv_index][1];
+    }
+  }
+}
+
 static void process_no_normals(CDStreamConfig &config)
 {
   /* Absense of normals in the Alembic mesh is interpreted as 'smooth'. */
@@ -976,14 +1043,16 @@ static void get_weight_and_index(CDStreamConfig &config,
   config.ceil_index = i1;
 }
 
+/* When use_existing_topology is set, the polygons and loops of the mesh already match the
+ * sample, only its positions, normals and UVs are read. */
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
+                             const IPolyMeshSchema::Sample &sample,
                              const ISampleSelector &selector,
-                             CDStreamConfig &config)
+                             CDStreamConfig &config,
+                             const bool use_existing_topology)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -1006,7 +1075,12 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   }
 
   if ((settings->read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
-    read_mpolys(config, abc_mesh_data);
+    if (use_existing_topology) {
+      read_loop_uvs(config, abc_mesh_data);
+    }
+    else {
+      read_mpolys(config, abc_mesh_data);
+    }
     process_normals(config, schema.getNormalsParam(), selector);
   }
 
@@ -1149,12 +1223,16 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
 
   Mesh *new_mesh = NULL;
+  bool use_existing_topology = false;
 
   /* Only read point data when streaming meshes, unless we need to create new ones. */
   ImportSettings settings;
   settings.read_flag |= read_flag;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  /* Same test as topology_changed(), without reading the sample again. */
+  if (positions->size() != existing_mesh->totvert ||
+      face_counts->size() != existing_mesh->totpoly ||
+      face_indices->size() != existing_mesh->totloop) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
 
@@ -1174,12 +1252,24 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
             " mesh. Only vertices will be read!";
       }
     }
+    else if (m_schema.getTopologyVariance() != Alembic::AbcGeom::kHeterogenousTopology &&
+             existing_mesh->totedge != 0) {
+      /* The face indices are the same for all samples, the mesh was created from them when
+       * importing so rebuilding its polygons and edges every frame can be skipped. */
+      use_existing_topology = true;
+    }
   }
 
   CDStreamConfig config = get_config(new_mesh ? new_mesh : existing_mesh);
   config.time = sample_sel.getRequestedTime();
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(m_iobject.getFullName(),
+                   &settings,
+                   m_schema,
+                   sample,
+                   sample_sel,
+                   config,
+                   use_existing_topology);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -48,6 +48,10 @@ class AbcGenericMeshWriter : public AbcObjectWriter {
   bool m_is_liquid;
   bool m_is_subd;
 
+  /* Topology of the previous sample, see #topologyIsUnchanged. */
+  std::vector<int32_t> m_prev_poly_verts;
+  std::vector<int32_t> m_prev_loop_counts;
+
  public:
   AbcGenericMeshWriter(Object *ob,
                        AbcTransformWriter *parent,
@@ -68,6 +72,8 @@ class AbcGenericMeshWriter : public AbcObjectWriter {
   void writeMesh(struct Mesh *mesh);
   void writeSubD(struct Mesh *mesh);
 
+  bool topologyIsUnchanged(std::vector<int32_t> &poly_verts, std::vector<int32_t> &loop_counts);
+
   void writeArbGeoParams(struct Mesh *mesh);
   void getGeoGroups(struct Mesh *mesh, std::map<std::string, std::vector<int32_t>> &geoGroups);
 
@@ -68,6 +68,7 @@ struct ListBase *object_duplilist(struct Depsgraph *depsgraph,
                                   struct Scene *sce,
                                   struct Object *ob);
 void free_object_duplilist(struct ListBase *lb);
+bool BKE_object_has_mesh_instances(const struct Object *ob);
 
 typedef struct DupliObject {
   struct DupliObject *next, *prev;
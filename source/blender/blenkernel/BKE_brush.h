@@ -71,6 +71,11 @@ void BKE_brush_randomize_texture_coords(struct UnifiedPaintSettings *ups, bool m
 void BKE_brush_curve_preset(struct Brush *b, enum eCurveMappingPreset preset);
 float BKE_brush_curve_strength_clamped(struct Brush *br, float p, const float len);
 float BKE_brush_curve_strength(const struct Brush *br, float p, const float len);
+void BKE_brush_curve_strength_array(const struct Brush *br,
+                                    const float *dist,
+                                    float *r_strength,
+                                    const int tot,
+                                    const float len);
 
 /* sampling */
 float BKE_brush_sample_tex_3d(const struct Scene *scene,
@@ -240,8 +240,11 @@ enum {
 };
 
 bool bvhcache_find(const BVHCache *cache, int type, BVHTree **r_tree);
+bool bvhcache_needs_refit(const BVHCache *cache, int type);
+void bvhcache_tag_refitted(BVHCache *cache, int type);
 bool bvhcache_has_tree(const BVHCache *cache, const BVHTree *tree);
 void bvhcache_insert(BVHCache **cache_p, BVHTree *tree, int type);
 void bvhcache_free(BVHCache **cache_p);
+void bvhcache_tag_coords_changed(BVHCache **cache_p);
 
 #endif
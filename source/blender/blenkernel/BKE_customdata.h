@@ -73,6 +73,9 @@ typedef enum eCDAllocType {
   CD_REFERENCE = 3,
   /** Do a full copy of all layers, only allowed if source has same number of elements. */
   CD_DUPLICATE = 4,
+  /** Share the data of layers, set layer flags SHARED and NOFREE on both source and destination.
+   * The data is freed by the last layer using it, layers which can't be shared are duplicated. */
+  CD_SHARE = 5,
 } eCDAllocType;
 
 #define CD_TYPE_AS_MASK(_type) (CustomDataMask)((CustomDataMask)1 << (CustomDataMask)(_type))
@@ -296,6 +299,13 @@ void CustomData_interp(const struct CustomData *source,
                        const float *sub_weights,
                        int count,
                        int dest_index);
+void CustomData_interp_range(const struct CustomData *source,
+                             struct CustomData *dest,
+                             const int *src_indices,
+                             const float *weights,
+                             int count,
+                             int dest_index,
+                             int dest_count);
 void CustomData_bmesh_interp_n(struct CustomData *data,
                                const void **src_blocks,
                                const float *weights,
@@ -421,6 +431,7 @@ void CustomData_file_write_prepare(struct CustomData *data,
 /* query info over types */
 void CustomData_file_write_info(int type, const char **r_struct_name, int *r_struct_num);
 int CustomData_sizeof(int type);
+size_t CustomData_memory_usage(const struct CustomData *data, int totelem);
 
 /* get the name of a layer type */
 const char *CustomData_layertype_name(int type);
@@ -80,6 +80,13 @@ typedef struct BMEditMesh {
    */
   char needs_flush_to_id;
 
+  /**
+   * Only vertex coordinates changed since the last evaluation (set by transform),
+   * the draw cache keeps the buffers which only depend on topology.
+   * Cleared by #EDBM_update_generic and once the draw cache is tagged.
+   */
+  char is_deform_only_update;
+
 } BMEditMesh;
 
 /* editmesh.c */
@@ -128,6 +128,7 @@ void BKE_effectors_apply(struct ListBase *effectors,
                          float *force,
                          float *impulse);
 void BKE_effectors_free(struct ListBase *lb);
+void BKE_effectors_random_reset(struct Depsgraph *depsgraph, struct ListBase *effectors);
 
 void pd_point_from_particle(struct ParticleSimulationData *sim,
                             struct ParticleData *pa,
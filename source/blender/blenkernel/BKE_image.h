@@ -285,6 +285,8 @@ void BKE_image_packfiles_from_mem(struct ReportList *reports,
 
 /* prints memory statistics for images */
 void BKE_image_print_memlist(struct Main *bmain);
+/* memory used by the cached buffers of the image, in bytes */
+size_t BKE_image_memory_usage(struct Image *ima);
 
 /* empty image block, of similar type and filename */
 void BKE_image_copy_data(struct Main *bmain,
@@ -125,6 +125,9 @@ typedef enum ModifierApplyFlag {
   /** Ignore scene simplification flag and use subdivisions
    * level set in multires modifier. */
   MOD_APPLY_IGNORE_SIMPLIFY = 1 << 3,
+  /** The result is the evaluated mesh of the object, so modifiers may output instances
+   * instead of copies of the geometry (see #Mesh_Runtime.instance_mats). */
+  MOD_APPLY_INSTANCES = 1 << 4,
 } ModifierApplyFlag;
 
 typedef struct ModifierUpdateDepsgraphContext {
@@ -104,6 +104,9 @@ typedef struct PTCacheData {
 
 typedef struct PTCacheFile {
   FILE *fp;
+  /** Files opened for reading are read at once, fp is NULL then. */
+  unsigned char *mem;
+  size_t mem_size, mem_offset;
 
   int frame, old_format;
   unsigned int totpoint, type;
@@ -159,6 +159,17 @@ typedef struct Subdiv {
   /* Statistics for debugging. */
   SubdivStats stats;
 
+  /* Mesh topology the topology refiner was created for, allows to re-use the refiner without
+   * comparing the whole topology. See BKE_subdiv_update_from_mesh(). */
+  struct {
+    bool is_valid;
+    int num_vertices;
+    int num_edges;
+    int num_loops;
+    int num_polys;
+    uint32_t hash;
+  } mesh_topology_;
+
   /* Cached values, are not supposed to be accessed directly. */
   struct {
     /* Indexed by base face index, element indicates total number of ptex
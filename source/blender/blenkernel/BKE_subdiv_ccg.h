@@ -177,6 +177,11 @@ typedef struct SubdivCCG {
   SubdivCCGFace *faces;
   /* Indexed by grid index, points to corresponding face from `faces`. */
   SubdivCCGFace **grid_faces;
+  /* Indexed by grid index, index of the coarse vertex at the corner of the face the grid
+   * corresponds to, and index of the coarse edge which goes from this corner to the next one.
+   * Cached adjacency of the topology refiner, used to find boundaries to be stitched. */
+  int *grid_adjacent_vertices;
+  int *grid_adjacent_edges;
 
   /* Edges which are adjacent to faces.
    * Used for faster grid stitching, in the cost of extra memory.
@@ -116,6 +116,12 @@ typedef struct UndoType {
    * free from the last since #MemFileUndoType will merge with the next undo type in the list. */
   void (*step_free)(UndoStep *us);
 
+  /**
+   * Optional, move the data of a step which isn't used anymore to disk,
+   * reducing #UndoStep.data_size. The data must be read back when decoding the step.
+   */
+  void (*step_spill)(UndoStep *us);
+
   void (*step_foreach_ID_ref)(UndoStep *us,
                               UndoTypeForEachIDRefFn foreach_ID_ref_fn,
                               void *user_data);
@@ -145,6 +151,7 @@ void BKE_undosys_stack_init_from_context(UndoStack *ustack, struct bContext *C);
 UndoStep *BKE_undosys_stack_active_with_type(UndoStack *ustack, const UndoType *ut);
 UndoStep *BKE_undosys_stack_init_or_active_with_type(UndoStack *ustack, const UndoType *ut);
 void BKE_undosys_stack_limit_steps_and_memory(UndoStack *ustack, int steps, size_t memory_limit);
+void BKE_undosys_stack_spill_steps(UndoStack *ustack, size_t memory_limit);
 
 /* Only some UndoType's require init. */
 UndoStep *BKE_undosys_step_push_init_with_type(UndoStack *ustack,
@@ -918,8 +918,12 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* Modifier evaluation contexts for different types of modifiers. */
   ModifierApplyFlag app_render = use_render ? MOD_APPLY_RENDER : 0;
   ModifierApplyFlag app_cache = use_cache ? MOD_APPLY_USECACHE : 0;
-  const ModifierEvalContext mectx = {depsgraph, ob, app_render | app_cache};
-  const ModifierEvalContext mectx_orco = {depsgraph, ob, app_render | MOD_APPLY_ORCO};
+  /* Only the cached result is drawn and rendered, which is where instances are supported.
+   * Orco meshes must match the topology of the final mesh, so are instanced the same way. */
+  ModifierApplyFlag app_instances = use_cache ? MOD_APPLY_INSTANCES : 0;
+  const ModifierEvalContext mectx = {depsgraph, ob, app_render | app_cache | app_instances};
+  const ModifierEvalContext mectx_orco = {
+      depsgraph, ob, app_render | app_instances | MOD_APPLY_ORCO};
 
   /* Get effective list of modifiers to execute. Some effects like shape keys
    * are added as virtual modifiers before the user created modifiers. */
@@ -1776,6 +1780,50 @@ static void mesh_runtime_check_normals_valid(const Mesh *mesh)
   BLI_assert(!(mesh->runtime.cd_dirty_poly & CD_MASK_NORMAL));
 }
 
+/* The draw cache of the previous evaluated mesh can be taken over by the new one when it only
+ * differs in vertex positions (armature or shape-key playback for example), so the topology
+ * dependent GPU buffers don't have to be extracted and uploaded again on every frame.
+ * Returns the previous mesh when that may be the case. */
+static Mesh *mesh_batch_cache_reuse_source_get(const Object *ob)
+{
+  const Mesh *mesh = ob->runtime.mesh_orig;
+  Mesh *mesh_eval = ob->runtime.mesh_eval;
+  if (mesh == NULL || mesh_eval == NULL || !ob->runtime.is_mesh_eval_owned) {
+    return NULL;
+  }
+  if (mesh_eval->runtime.batch_cache == NULL || !mesh_eval->runtime.deformed_only ||
+      mesh_eval->edit_mesh != NULL || mesh_eval->runtime.subdiv_ccg != NULL) {
+    return NULL;
+  }
+  if (ob->mode & OB_MODE_ALL_SCULPT) {
+    return NULL;
+  }
+  /* The mesh data-block itself changed, topology or custom data may differ. */
+  if (mesh->id.recalc & (ID_RECALC_GEOMETRY | ID_RECALC_COPY_ON_WRITE)) {
+    return NULL;
+  }
+  return mesh_eval;
+}
+
+static void mesh_batch_cache_reuse(Object *ob, Mesh *mesh_eval_prev)
+{
+  Mesh *mesh_eval = ob->runtime.mesh_eval;
+  if (!ob->runtime.is_mesh_eval_owned || !mesh_eval->runtime.deformed_only ||
+      mesh_eval->edit_mesh != NULL) {
+    return;
+  }
+  if (mesh_eval->totvert != mesh_eval_prev->totvert ||
+      mesh_eval->totedge != mesh_eval_prev->totedge ||
+      mesh_eval->totloop != mesh_eval_prev->totloop ||
+      mesh_eval->totpoly != mesh_eval_prev->totpoly) {
+    return;
+  }
+  BLI_assert(mesh_eval->runtime.batch_cache == NULL);
+  mesh_eval->runtime.batch_cache = mesh_eval_prev->runtime.batch_cache;
+  mesh_eval->runtime.is_batch_cache_deform_reused = true;
+  mesh_eval_prev->runtime.batch_cache = NULL;
+}
+
 static void mesh_build_data(struct Depsgraph *depsgraph,
                             Scene *scene,
                             Object *ob,
@@ -1788,6 +1836,12 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g T58150. */
   BLI_assert(ob->id.tag & LIB_TAG_COPIED_ON_WRITE);
 
+  /* Keep the previous result until the new one is calculated, it's freed afterwards. */
+  Mesh *mesh_eval_prev = mesh_batch_cache_reuse_source_get(ob);
+  if (mesh_eval_prev != NULL) {
+    ob->runtime.mesh_eval = NULL;
+  }
+
   BKE_object_free_derived_caches(ob);
   if (DEG_is_active(depsgraph)) {
     BKE_sculpt_update_object_before_eval(ob);
@@ -1818,6 +1872,11 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
 
   assign_object_mesh_eval(ob);
 
+  if (mesh_eval_prev != NULL) {
+    mesh_batch_cache_reuse(ob, mesh_eval_prev);
+    BKE_mesh_eval_delete(mesh_eval_prev);
+  }
+
   ob->runtime.last_data_mask = *dataMask;
   ob->runtime.last_need_mapping = need_mapping;
 
@@ -1885,6 +1885,45 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/* The property resolved for the previous F-Curve. Consecutive F-Curves usually animate the items
+ * of the same array property (location, rotation, color...), which doesn't need to be resolved
+ * from the RNA path again. */
+typedef struct AnimsysPathCache {
+  /* NULL when there is no resolved property. */
+  const char *rna_path;
+  PointerRNA ptr;
+  PropertyRNA *prop;
+  int array_len;
+} AnimsysPathCache;
+
+/* Same as #BKE_animsys_store_rna_setting, using the cache for the same path as last time. */
+static bool animsys_store_rna_setting_cached(PointerRNA *ptr,
+                                             AnimsysPathCache *cache,
+                                             const char *rna_path,
+                                             const int array_index,
+                                             PathResolvedRNA *r_result)
+{
+  if (rna_path != NULL && cache->rna_path != NULL && STREQ(rna_path, cache->rna_path)) {
+    /* Invalid indices are left to the regular code, which reports them. */
+    if (cache->array_len == 0 || array_index < cache->array_len) {
+      r_result->ptr = cache->ptr;
+      r_result->prop = cache->prop;
+      r_result->prop_index = cache->array_len ? array_index : -1;
+      return true;
+    }
+  }
+
+  cache->rna_path = NULL;
+  if (!BKE_animsys_store_rna_setting(ptr, rna_path, array_index, r_result)) {
+    return false;
+  }
+  cache->rna_path = rna_path;
+  cache->ptr = r_result->ptr;
+  cache->prop = r_result->prop;
+  cache->array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+  return true;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -1895,6 +1934,13 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      float ctime,
                                      bool flush_to_original)
 {
+  AnimsysPathCache path_cache = {NULL};
+  AnimsysPathCache orig_path_cache = {NULL};
+  PointerRNA ptr_orig;
+  if (flush_to_original && !animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
+    flush_to_original = false;
+  }
+
   /* Calculate then execute each curve. */
   for (FCurve *fcu = list->first; fcu; fcu = fcu->next) {
     /* Check if this F-Curve doesn't belong to a muted group. */
@@ -1910,11 +1956,16 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
       continue;
     }
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_store_rna_setting(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_store_rna_setting_cached(
+            ptr, &path_cache, fcu->rna_path, fcu->array_index, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, ctime);
       BKE_animsys_write_rna_setting(&anim_rna, curval);
       if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+        PathResolvedRNA orig_anim_rna;
+        if (animsys_store_rna_setting_cached(
+                &ptr_orig, &orig_path_cache, fcu->rna_path, fcu->array_index, &orig_anim_rna)) {
+          BKE_animsys_write_rna_setting(&orig_anim_rna, curval);
+        }
       }
     }
   }
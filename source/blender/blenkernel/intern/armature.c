@@ -1424,26 +1424,49 @@ static float dist_bone_deform(
   return contrib;
 }
 
-static void pchan_bone_deform(bPoseChannel *pchan,
-                              float weight,
-                              float vec[3],
-                              DualQuat *dq,
-                              float mat[3][3],
-                              const float co[3],
-                              float *contrib)
+/**
+ * Deform data of the bone of each vertex group, gathered before deforming the vertices.
+ * The matrices are copied into one compact array, so the vertex loop doesn't have to
+ * look them up in the (large and scattered) pose channels for every vertex weight.
+ */
+typedef struct ArmatureDeformGroup {
+  float chan_mat[4][4];
+  DualQuat deform_dual_quat;
+  /* Pose channel deforming the vertices of this group, NULL when there is none. */
+  bPoseChannel *pchan;
+  /* Deform with the B-Bone segments of #ArmatureDeformGroup.pchan. */
+  bool use_bbone;
+  /* Multiply the vertex group weights with the bone envelope (#BONE_MULT_VG_ENV). */
+  bool use_envelope_multiply;
+} ArmatureDeformGroup;
+
+static void armature_deform_group_init(ArmatureDeformGroup *group, bPoseChannel *pchan)
 {
   Bone *bone = pchan->bone;
+  group->pchan = pchan;
+  group->use_bbone = (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments);
+  group->use_envelope_multiply = (bone->flag & BONE_MULT_VG_ENV) != 0;
+  copy_m4_m4(group->chan_mat, pchan->chan_mat);
+  group->deform_dual_quat = pchan->runtime.deform_dual_quat;
+}
 
+static void armature_deform_group_deform(const ArmatureDeformGroup *group,
+                                         float weight,
+                                         float vec[3],
+                                         DualQuat *dq,
+                                         float mat[3][3],
+                                         const float co[3],
+                                         float *contrib)
+{
   if (!weight) {
     return;
   }
 
-  if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
-    b_bone_deform(pchan, co, weight, vec, dq, mat);
+  if (group->use_bbone) {
+    b_bone_deform(group->pchan, co, weight, vec, dq, mat);
   }
   else {
-    pchan_deform_accumulate(
-        &pchan->runtime.deform_dual_quat, pchan->chan_mat, co, weight, vec, dq, mat);
+    pchan_deform_accumulate(&group->deform_dual_quat, group->chan_mat, co, weight, vec, dq, mat);
   }
 
   (*contrib) += weight;
@@ -1468,7 +1491,7 @@ typedef struct ArmatureUserdata {
   MDeformVert *dverts;
 
   int defbase_tot;
-  bPoseChannel **defnrToPC;
+  const ArmatureDeformGroup *defgroups;
 
   float premat[4][4];
   float postmat[4][4];
@@ -1563,18 +1586,19 @@ static void armature_vert_task(void *__restrict userdata,
     unsigned int j;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const int index = dw->def_nr;
-      if (index >= 0 && index < data->defbase_tot && (pchan = data->defnrToPC[index])) {
+      if (index >= 0 && index < data->defbase_tot && data->defgroups[index].pchan) {
+        const ArmatureDeformGroup *group = &data->defgroups[index];
         float weight = dw->weight;
-        Bone *bone = pchan->bone;
 
         deformed = 1;
 
-        if (bone && bone->flag & BONE_MULT_VG_ENV) {
+        if (group->use_envelope_multiply) {
+          Bone *bone = group->pchan->bone;
           weight *= distfactor_to_bone(
               co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
         }
 
-        pchan_bone_deform(pchan, weight, vec, dq, smat, co, &contrib);
+        armature_deform_group_deform(group, weight, vec, dq, smat, co, &contrib);
       }
     }
     /* if there are vertexgroups but not groups with bones
@@ -1657,7 +1681,7 @@ void armature_deform_verts(Object *armOb,
                            bGPDstroke *gps)
 {
   bArmature *arm = armOb->data;
-  bPoseChannel **defnrToPC = NULL;
+  ArmatureDeformGroup *defgroups = NULL;
   MDeformVert *dverts = NULL;
   bDeformGroup *dg;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -1720,18 +1744,16 @@ void armature_deform_verts(Object *armOb,
       }
 
       if (use_dverts) {
-        defnrToPC = MEM_callocN(sizeof(*defnrToPC) * defbase_tot, "defnrToBone");
+        defgroups = MEM_callocN(sizeof(*defgroups) * defbase_tot, "armature deform groups");
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
          */
         for (i = 0, dg = target->defbase.first; dg; i++, dg = dg->next) {
-          defnrToPC[i] = BKE_pose_channel_find_name(armOb->pose, dg->name);
+          bPoseChannel *pchan = BKE_pose_channel_find_name(armOb->pose, dg->name);
           /* exclude non-deforming bones */
-          if (defnrToPC[i]) {
-            if (defnrToPC[i]->bone->flag & BONE_NO_DEFORM) {
-              defnrToPC[i] = NULL;
-            }
+          if (pchan && !(pchan->bone->flag & BONE_NO_DEFORM)) {
+            armature_deform_group_init(&defgroups[i], pchan);
           }
         }
       }
@@ -1752,7 +1774,7 @@ void armature_deform_verts(Object *armOb,
                            .target_totvert = target_totvert,
                            .dverts = dverts,
                            .defbase_tot = defbase_tot,
-                           .defnrToPC = defnrToPC};
+                           .defgroups = defgroups};
 
   float obinv[4][4];
   invert_m4_m4(obinv, target->obmat);
@@ -1765,8 +1787,8 @@ void armature_deform_verts(Object *armOb,
   settings.min_iter_per_thread = 32;
   BLI_task_parallel_range(0, numVerts, &data, armature_vert_task, &settings);
 
-  if (defnrToPC) {
-    MEM_freeN(defnrToPC);
+  if (defgroups) {
+    MEM_freeN(defgroups);
   }
 }
 
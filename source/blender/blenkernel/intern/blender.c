@@ -31,6 +31,7 @@
 
 #include "BLI_string.h"
 #include "BLI_listbase.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "IMB_imbuf.h"
@@ -90,6 +91,7 @@ void BKE_blender_free(void)
   IMB_exit();
   BKE_cachefiles_exit();
   BKE_images_exit();
+  BLI_trace_end();
   DEG_free_node_types();
 
   BKE_brush_system_exit();
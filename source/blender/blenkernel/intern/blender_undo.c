@@ -61,7 +61,13 @@
 
 #define UNDO_DISK 0
 
-bool BKE_memfile_undo_decode(MemFileUndoData *mfu, bContext *C)
+/**
+ * \param mfu_current: The undo data matching the current state (may be NULL),
+ * data-blocks that didn't change since it was written are kept instead of being read again.
+ */
+bool BKE_memfile_undo_decode(MemFileUndoData *mfu,
+                             const MemFileUndoData *mfu_current,
+                             bContext *C)
 {
   Main *bmain = CTX_data_main(C);
   char mainstr[sizeof(bmain->name)];
@@ -76,8 +82,11 @@ bool BKE_memfile_undo_decode(MemFileUndoData *mfu, bContext *C)
     success = BKE_blendfile_read(C, mfu->filename, &(const struct BlendFileReadParams){0}, NULL);
   }
   else {
-    success = BKE_blendfile_read_from_memfile(
-        C, &mfu->memfile, &(const struct BlendFileReadParams){0}, NULL);
+    success = BKE_blendfile_read_from_memfile(C,
+                                              &mfu->memfile,
+                                              mfu_current ? &mfu_current->memfile : NULL,
+                                              &(const struct BlendFileReadParams){0},
+                                              NULL);
   }
 
   /* Restore, bmain has been re-allocated. */
@@ -251,6 +251,11 @@ static void setup_app_data(bContext *C,
     }
   }
 
+  if (mode == LOAD_UNDO && bfd->is_undo_partial) {
+    /* Keep the evaluated copies of the reused data-blocks, while the old ones are still valid. */
+    BKE_scene_undo_depsgraphs_transfer(bfd->main, bmain);
+  }
+
   /* free G_MAIN Main database */
   //  CTX_wm_manager_set(C, NULL);
   BKE_blender_globals_clear();
@@ -371,8 +376,14 @@ static void setup_app_data(bContext *C,
      * means that we do not reset their user count, however we do increase that one when doing
      * lib_link on local IDs using linked ones.
      * There is no real way to predict amount of changes here, so we have to fully redo
-     * refcounting . */
-    BKE_main_id_refcount_recompute(bmain, true);
+     * refcounting .
+     * Local data-blocks reused from the old Main also keep their user count. */
+    BKE_main_id_refcount_recompute(bmain, !bfd->is_undo_partial);
+
+    if (bfd->is_undo_partial) {
+      BKE_scene_undo_depsgraphs_relations_update(bmain);
+      BKE_main_id_tag_all(bmain, LIB_TAG_UNDO_OLD_ID_REUSED, false);
+    }
   }
 }
 
@@ -467,14 +478,19 @@ bool BKE_blendfile_read_from_memory(bContext *C,
 /* memfile is the undo buffer */
 bool BKE_blendfile_read_from_memfile(bContext *C,
                                      struct MemFile *memfile,
+                                     const struct MemFile *memfile_current,
                                      const struct BlendFileReadParams *params,
                                      ReportList *reports)
 {
   Main *bmain = CTX_data_main(C);
   BlendFileData *bfd;
 
-  bfd = BLO_read_from_memfile(
-      bmain, BKE_main_blendfile_path(bmain), memfile, params->skip_flags, reports);
+  bfd = BLO_read_from_memfile(bmain,
+                              BKE_main_blendfile_path(bmain),
+                              memfile,
+                              memfile_current,
+                              params->skip_flags,
+                              reports);
   if (bfd) {
     /* remove the unused screens and wm */
     while (bfd->main->wm.first) {
@@ -1607,6 +1607,71 @@ float BKE_brush_curve_strength(const Brush *br, float p, const float len)
   return strength;
 }
 
+/* Same as #BKE_brush_curve_strength for an array of distances, the preset is only checked once
+ * so the loops over the distances can be vectorized. */
+void BKE_brush_curve_strength_array(
+    const Brush *br, const float *dist, float *r_strength, const int tot, const float len)
+{
+  const float len_inv = 1.0f / len;
+  int i;
+
+#define CURVE_STRENGTH_LOOP(expr) \
+  for (i = 0; i < tot; i++) { \
+    const float p = max_ff(1.0f - dist[i] * len_inv, 0.0f); \
+    r_strength[i] = (expr); \
+  } \
+  ((void)0)
+
+  switch (br->curve_preset) {
+    case BRUSH_CURVE_CUSTOM:
+      for (i = 0; i < tot; i++) {
+        r_strength[i] = (dist[i] < len) ?
+                            BKE_curvemapping_evaluateF(br->curve, 0, dist[i] * len_inv) :
+                            0.0f;
+      }
+      return;
+    case BRUSH_CURVE_SHARP:
+      CURVE_STRENGTH_LOOP(p * p);
+      break;
+    case BRUSH_CURVE_SMOOTH:
+      CURVE_STRENGTH_LOOP(3.0f * p * p - 2.0f * p * p * p);
+      break;
+    case BRUSH_CURVE_SMOOTHER:
+      CURVE_STRENGTH_LOOP(pow3f(p) * (p * (p * 6.0f - 15.0f) + 10.0f));
+      break;
+    case BRUSH_CURVE_ROOT:
+      CURVE_STRENGTH_LOOP(sqrtf(p));
+      break;
+    case BRUSH_CURVE_LIN:
+      CURVE_STRENGTH_LOOP(p);
+      break;
+    case BRUSH_CURVE_CONSTANT:
+      CURVE_STRENGTH_LOOP(1.0f);
+      break;
+    case BRUSH_CURVE_SPHERE:
+      CURVE_STRENGTH_LOOP(sqrtf(2 * p - p * p));
+      break;
+    case BRUSH_CURVE_POW4:
+      CURVE_STRENGTH_LOOP(p * p * p * p);
+      break;
+    case BRUSH_CURVE_INVSQUARE:
+      CURVE_STRENGTH_LOOP(p * (2.0f - p));
+      break;
+    default:
+      CURVE_STRENGTH_LOOP(1.0f);
+      break;
+  }
+
+#undef CURVE_STRENGTH_LOOP
+
+  /* Only the constant curve is not zero at the radius. */
+  for (i = 0; i < tot; i++) {
+    if (dist[i] >= len) {
+      r_strength[i] = 0.0f;
+    }
+  }
+}
+
 /* Uses the brush curve control to find a strength value between 0 and 1 */
 float BKE_brush_curve_strength_clamped(Brush *br, float p, const float len)
 {
@@ -32,6 +32,7 @@
 #include "BLI_utildefines.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_bvhutils.h"
@@ -1306,6 +1307,118 @@ static BLI_bitmap *looptri_no_hidden_map_get(const MPoly *mpoly,
   return looptri_mask;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Refit Cached Trees
+ *
+ * Trees cached by a mesh whose vertex positions changed (see #bvhcache_tag_coords_changed)
+ * keep their structure, only the bounds of their leaves and branches are updated,
+ * which is much cheaper than balancing a new tree.
+ * \{ */
+
+typedef struct BVHTreeRefitData {
+  BVHTree *tree;
+  int bvh_cache_type;
+  const MVert *vert;
+  const MEdge *edge;
+  const MFace *face;
+  const MLoop *loop;
+  const MLoopTri *looptri;
+} BVHTreeRefitData;
+
+static void bvhtree_refit_leaf_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHTreeRefitData *data = userdata;
+  const MVert *vert = data->vert;
+  float co[4][3];
+  int co_len;
+
+  switch (data->bvh_cache_type) {
+    case BVHTREE_FROM_VERTS:
+      copy_v3_v3(co[0], vert[i].co);
+      co_len = 1;
+      break;
+    case BVHTREE_FROM_EDGES:
+      copy_v3_v3(co[0], vert[data->edge[i].v1].co);
+      copy_v3_v3(co[1], vert[data->edge[i].v2].co);
+      co_len = 2;
+      break;
+    case BVHTREE_FROM_FACES: {
+      const MFace *face = &data->face[i];
+      copy_v3_v3(co[0], vert[face->v1].co);
+      copy_v3_v3(co[1], vert[face->v2].co);
+      copy_v3_v3(co[2], vert[face->v3].co);
+      if (face->v4) {
+        copy_v3_v3(co[3], vert[face->v4].co);
+      }
+      co_len = face->v4 ? 4 : 3;
+      break;
+    }
+    case BVHTREE_FROM_LOOPTRI: {
+      const MLoopTri *lt = &data->looptri[i];
+      copy_v3_v3(co[0], vert[data->loop[lt->tri[0]].v].co);
+      copy_v3_v3(co[1], vert[data->loop[lt->tri[1]].v].co);
+      copy_v3_v3(co[2], vert[data->loop[lt->tri[2]].v].co);
+      co_len = 3;
+      break;
+    }
+    default:
+      BLI_assert(0);
+      return;
+  }
+
+  BLI_bvhtree_update_node(data->tree, i, co[0], NULL, co_len);
+}
+
+/**
+ * Update the bounds of a tree built from all elements of the given type,
+ * the leaves being the elements in their order in \a mesh.
+ */
+static void bvhtree_from_mesh_refit(BVHTree *tree, Mesh *mesh, const int bvh_cache_type)
+{
+  BVHTreeRefitData data = {
+      .tree = tree,
+      .bvh_cache_type = bvh_cache_type,
+      .vert = mesh->mvert,
+      .edge = mesh->medge,
+      .face = mesh->mface,
+      .loop = mesh->mloop,
+  };
+  int leaf_len;
+
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_VERTS:
+      leaf_len = mesh->totvert;
+      break;
+    case BVHTREE_FROM_EDGES:
+      leaf_len = mesh->totedge;
+      break;
+    case BVHTREE_FROM_FACES:
+      leaf_len = mesh->totface;
+      break;
+    case BVHTREE_FROM_LOOPTRI:
+      data.looptri = BKE_mesh_runtime_looptri_ensure(mesh);
+      leaf_len = BKE_mesh_runtime_looptri_len(mesh);
+      break;
+    default:
+      BLI_assert(0);
+      return;
+  }
+
+  /* The topology must not have changed since the tree was built. */
+  BLI_assert(BLI_bvhtree_get_len(tree) == leaf_len);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, leaf_len, &data, bvhtree_refit_leaf_cb, &settings);
+
+  BLI_bvhtree_update_tree(tree);
+}
+
+/** \} */
+
 /**
  * Builds or queries a bvhcache for the cache bvhtree of the request type.
  */
@@ -1326,6 +1439,22 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
     return tree;
   }
 
+  if (is_cached) {
+    BLI_rw_mutex_lock(&cache_rwlock, THREAD_LOCK_READ);
+    bool needs_refit = bvhcache_needs_refit(*bvh_cache, bvh_cache_type);
+    BLI_rw_mutex_unlock(&cache_rwlock);
+
+    if (needs_refit) {
+      BLI_rw_mutex_lock(&cache_rwlock, THREAD_LOCK_WRITE);
+      /* Another thread may have refitted the tree in the meantime. */
+      if (bvhcache_needs_refit(*bvh_cache, bvh_cache_type)) {
+        bvhtree_from_mesh_refit(tree, mesh, bvh_cache_type);
+        bvhcache_tag_refitted(*bvh_cache, bvh_cache_type);
+      }
+      BLI_rw_mutex_unlock(&cache_rwlock);
+    }
+  }
+
   switch (bvh_cache_type) {
     case BVHTREE_FROM_VERTS:
     case BVHTREE_FROM_LOOSEVERTS:
@@ -1624,6 +1753,8 @@ typedef struct BVHCacheItem {
   int type;
   BVHTree *tree;
 
+  /* The positions the tree was built from changed, see #bvhcache_tag_coords_changed. */
+  bool needs_refit;
 } BVHCacheItem;
 
 /**
@@ -1642,6 +1773,30 @@ bool bvhcache_find(const BVHCache *cache, int type, BVHTree **r_tree)
   return false;
 }
 
+bool bvhcache_needs_refit(const BVHCache *cache, int type)
+{
+  while (cache) {
+    const BVHCacheItem *item = cache->link;
+    if (item->type == type) {
+      return item->needs_refit;
+    }
+    cache = cache->next;
+  }
+  return false;
+}
+
+void bvhcache_tag_refitted(BVHCache *cache, int type)
+{
+  while (cache) {
+    BVHCacheItem *item = cache->link;
+    if (item->type == type) {
+      item->needs_refit = false;
+      return;
+    }
+    cache = cache->next;
+  }
+}
+
 bool bvhcache_has_tree(const BVHCache *cache, const BVHTree *tree)
 {
   while (cache) {
@@ -1672,6 +1827,7 @@ void bvhcache_insert(BVHCache **cache_p, BVHTree *tree, int type)
 
   item->type = type;
   item->tree = tree;
+  item->needs_refit = false;
 
   BLI_linklist_prepend(cache_p, item);
 }
@@ -1693,4 +1849,35 @@ void bvhcache_free(BVHCache **cache_p)
   *cache_p = NULL;
 }
 
+/**
+ * Call when the vertex positions the trees of the cache were built from changed,
+ * while the topology stayed the same.
+ *
+ * Trees built from all vertices, edges or triangles of a mesh are refitted the next time they are
+ * requested with #BKE_bvhtree_from_mesh_get. Other trees only contain a sub-set of the elements
+ * (loose or visible ones), or are built from an edit-mesh, they are freed to be built again.
+ */
+void bvhcache_tag_coords_changed(BVHCache **cache_p)
+{
+  LinkNode **link_p = cache_p;
+  while (*link_p) {
+    LinkNode *link = *link_p;
+    BVHCacheItem *item = link->link;
+    switch (item->type) {
+      case BVHTREE_FROM_VERTS:
+      case BVHTREE_FROM_EDGES:
+      case BVHTREE_FROM_FACES:
+      case BVHTREE_FROM_LOOPTRI:
+        item->needs_refit = true;
+        link_p = &link->next;
+        break;
+      default:
+        *link_p = link->next;
+        bvhcacheitem_free(item);
+        MEM_freeN(link);
+        break;
+    }
+  }
+}
+
 /** \} */
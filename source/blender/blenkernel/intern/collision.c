@@ -1448,6 +1448,59 @@ static bool cloth_bvh_selfcollisions_nearcheck(ClothModifierData *clmd,
   return data.collided;
 }
 
+typedef struct ClothImpulseApplyData {
+  ClothVertex *verts;
+  int applied;
+} ClothImpulseApplyData;
+
+static void cloth_collision_impulse_apply_cb(void *__restrict userdata,
+                                             const int i,
+                                             const TaskParallelTLS *__restrict tls)
+{
+  ClothImpulseApplyData *data = (ClothImpulseApplyData *)userdata;
+  int *applied = (int *)tls->userdata_chunk;
+  ClothVertex *vert = &data->verts[i];
+
+  // calculate "velocities" (just xnew = xold + v; no dt in v)
+  if (vert->impulse_count) {
+    add_v3_v3(vert->tv, vert->impulse);
+    add_v3_v3(vert->dcvel, vert->impulse);
+    zero_v3(vert->impulse);
+    vert->impulse_count = 0;
+
+    (*applied)++;
+  }
+}
+
+static void cloth_collision_impulse_apply_finalize(void *__restrict userdata,
+                                                   void *__restrict userdata_chunk)
+{
+  ClothImpulseApplyData *data = (ClothImpulseApplyData *)userdata;
+  data->applied += *(int *)userdata_chunk;
+}
+
+/* Apply the impulses accumulated by the collision responses, returns the number of vertices
+ * which received an impulse. */
+static int cloth_collision_impulse_apply(Cloth *cloth)
+{
+  ClothImpulseApplyData data = {
+      .verts = cloth->verts,
+      .applied = 0,
+  };
+  int applied_chunk = 0;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (cloth->mvert_num > 10000);
+  settings.userdata_chunk = &applied_chunk;
+  settings.userdata_chunk_size = sizeof(applied_chunk);
+  settings.func_finalize = cloth_collision_impulse_apply_finalize;
+  BLI_task_parallel_range(
+      0, cloth->mvert_num, &data, cloth_collision_impulse_apply_cb, &settings);
+
+  return data.applied;
+}
+
 static int cloth_bvh_objcollisions_resolve(ClothModifierData *clmd,
                                            Object **collobjs,
                                            CollPair **collisions,
@@ -1456,14 +1509,10 @@ static int cloth_bvh_objcollisions_resolve(ClothModifierData *clmd,
                                            const float dt)
 {
   Cloth *cloth = clmd->clothObject;
-  int i = 0, j = 0, mvert_num = 0;
-  ClothVertex *verts = NULL;
+  int i = 0, j = 0;
   int ret = 0;
   int result = 0;
 
-  mvert_num = clmd->clothObject->mvert_num;
-  verts = cloth->verts;
-
   result = 1;
 
   for (j = 0; j < 2; j++) {
@@ -1482,17 +1531,7 @@ static int cloth_bvh_objcollisions_resolve(ClothModifierData *clmd,
 
     /* Apply impulses in parallel. */
     if (result) {
-      for (i = 0; i < mvert_num; i++) {
-        // calculate "velocities" (just xnew = xold + v; no dt in v)
-        if (verts[i].impulse_count) {
-          add_v3_v3(verts[i].tv, verts[i].impulse);
-          add_v3_v3(verts[i].dcvel, verts[i].impulse);
-          zero_v3(verts[i].impulse);
-          verts[i].impulse_count = 0;
-
-          ret++;
-        }
-      }
+      ret += cloth_collision_impulse_apply(cloth);
     }
     else {
       break;
@@ -1507,14 +1546,10 @@ static int cloth_bvh_selfcollisions_resolve(ClothModifierData *clmd,
                                             const float dt)
 {
   Cloth *cloth = clmd->clothObject;
-  int i = 0, j = 0, mvert_num = 0;
-  ClothVertex *verts = NULL;
+  int j = 0;
   int ret = 0;
   int result = 0;
 
-  mvert_num = clmd->clothObject->mvert_num;
-  verts = cloth->verts;
-
   for (j = 0; j < 2; j++) {
     result = 0;
 
@@ -1522,17 +1557,7 @@ static int cloth_bvh_selfcollisions_resolve(ClothModifierData *clmd,
 
     /* Apply impulses in parallel. */
     if (result) {
-      for (i = 0; i < mvert_num; i++) {
-        if (verts[i].impulse_count) {
-          // VECADDMUL ( verts[i].tv, verts[i].impulse, 1.0f / verts[i].impulse_count );
-          add_v3_v3(verts[i].tv, verts[i].impulse);
-          add_v3_v3(verts[i].dcvel, verts[i].impulse);
-          zero_v3(verts[i].impulse);
-          verts[i].impulse_count = 0;
-
-          ret++;
-        }
-      }
+      ret += cloth_collision_impulse_apply(cloth);
     }
 
     if (!result) {
@@ -39,7 +39,10 @@
 #include "BLI_string_utils.h"
 #include "BLI_math.h"
 #include "BLI_math_color_blend.h"
+#include "BLI_ghash.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "BLT_translation.h"
 
@@ -1848,6 +1851,96 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 }
 #endif
 
+/* -------------------------------------------------------------------- */
+/** \name Shared Layer Data
+ *
+ * Layers copied with #CD_SHARE use the data array of the layer they're copied from instead of
+ * duplicating it, which makes copy-on-write copies of unchanged geometry almost free.
+ * All layers using the array are tagged with `CD_FLAG_SHARED | CD_FLAG_NOFREE`, so they're
+ * treated as referenced layers which have to be duplicated before they're modified.
+ * The number of layers using each array is stored here, the last one frees the array.
+ * \{ */
+
+static GHash *shared_data_users = NULL;
+static ThreadMutex shared_data_mutex = BLI_MUTEX_INITIALIZER;
+
+static void customData_free_layer_data(int type, void *data, int totelem);
+
+static bool customData_layer_can_share(const CustomDataLayer *layer)
+{
+  if (layer->data == NULL || (layer->flag & CD_FLAG_EXTERNAL)) {
+    return false;
+  }
+  /* Data of referenced layers is owned by someone else, it can't be shared. */
+  return (layer->flag & CD_FLAG_SHARED) || !(layer->flag & CD_FLAG_NOFREE);
+}
+
+static void customData_shared_data_add_user(CustomDataLayer *layer)
+{
+  BLI_mutex_lock(&shared_data_mutex);
+  if (shared_data_users == NULL) {
+    shared_data_users = BLI_ghash_ptr_new(__func__);
+  }
+  void **users_p;
+  if (!BLI_ghash_ensure_p(shared_data_users, layer->data, &users_p)) {
+    /* Sharing the data for the first time, the layer owning it becomes one of its users. */
+    BLI_assert(!(layer->flag & CD_FLAG_SHARED));
+    layer->flag |= CD_FLAG_SHARED | CD_FLAG_NOFREE;
+    *users_p = POINTER_FROM_INT(1);
+  }
+  *users_p = POINTER_FROM_INT(POINTER_AS_INT(*users_p) + 1);
+  BLI_mutex_unlock(&shared_data_mutex);
+}
+
+/* Stop using the shared data, freeing it when this was its last user. */
+static void customData_shared_data_remove_user(int type, void *data, int totelem)
+{
+  BLI_mutex_lock(&shared_data_mutex);
+  void **users_p = BLI_ghash_lookup_p(shared_data_users, data);
+  BLI_assert(users_p != NULL);
+  const int users = POINTER_AS_INT(*users_p) - 1;
+  if (users == 0) {
+    BLI_ghash_remove(shared_data_users, data, NULL, NULL);
+    if (BLI_ghash_len(shared_data_users) == 0) {
+      BLI_ghash_free(shared_data_users, NULL, NULL);
+      shared_data_users = NULL;
+    }
+  }
+  else {
+    *users_p = POINTER_FROM_INT(users);
+  }
+  BLI_mutex_unlock(&shared_data_mutex);
+
+  if (users == 0) {
+    customData_free_layer_data(type, data, totelem);
+  }
+}
+
+/* Make the layer the owner of the shared data when it's the only user left,
+ * returns false when the data is still used by other layers. */
+static bool customData_shared_data_take_ownership(CustomDataLayer *layer)
+{
+  bool is_single_user;
+
+  BLI_mutex_lock(&shared_data_mutex);
+  void **users_p = BLI_ghash_lookup_p(shared_data_users, layer->data);
+  BLI_assert(users_p != NULL);
+  is_single_user = (POINTER_AS_INT(*users_p) == 1);
+  if (is_single_user) {
+    BLI_ghash_remove(shared_data_users, layer->data, NULL, NULL);
+    if (BLI_ghash_len(shared_data_users) == 0) {
+      BLI_ghash_free(shared_data_users, NULL, NULL);
+      shared_data_users = NULL;
+    }
+    layer->flag &= ~(CD_FLAG_SHARED | CD_FLAG_NOFREE);
+  }
+  BLI_mutex_unlock(&shared_data_mutex);
+
+  return is_single_user;
+}
+
+/** \} */
+
 bool CustomData_merge(const struct CustomData *source,
                       struct CustomData *dest,
                       CustomDataMask mask,
@@ -1899,6 +1992,7 @@ bool CustomData_merge(const struct CustomData *source,
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
         data = layer->data;
         break;
       default:
@@ -1910,6 +2004,20 @@ bool CustomData_merge(const struct CustomData *source,
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
+    else if (alloctype == CD_SHARE) {
+      if (customData_layer_can_share(layer)) {
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_REFERENCE, data, totelem, layer->name);
+        if (newlayer && newlayer->data == data) {
+          customData_shared_data_add_user(layer);
+          newlayer->flag |= CD_FLAG_SHARED;
+        }
+      }
+      else {
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_DUPLICATE, data, totelem, layer->name);
+      }
+    }
     else {
       newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
     }
@@ -1922,6 +2030,10 @@ bool CustomData_merge(const struct CustomData *source,
       newlayer->active_clone = lastclone;
       newlayer->active_mask = lastmask;
       newlayer->flag |= flag & (CD_FLAG_EXTERNAL | CD_FLAG_IN_MEMORY);
+      if (alloctype == CD_ASSIGN) {
+        /* The new layer takes over the source layer's use of the shared data. */
+        newlayer->flag |= flag & CD_FLAG_SHARED;
+      }
       changed = true;
     }
   }
@@ -1941,7 +2053,9 @@ void CustomData_realloc(CustomData *data, int totelem)
       continue;
     }
     typeInfo = layerType_getInfo(layer->type);
+    const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_MESH);
     layer->data = MEM_reallocN(layer->data, (size_t)totelem * typeInfo->size);
+    MEM_category_end(category_prev);
   }
 }
 
@@ -1960,20 +2074,24 @@ void CustomData_copy(const struct CustomData *source,
   CustomData_merge(source, dest, mask, alloctype, totelem);
 }
 
-static void customData_free_layer__internal(CustomDataLayer *layer, int totelem)
+static void customData_free_layer_data(int type, void *data, int totelem)
 {
-  const LayerTypeInfo *typeInfo;
+  const LayerTypeInfo *typeInfo = layerType_getInfo(type);
 
-  if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
-    typeInfo = layerType_getInfo(layer->type);
+  if (typeInfo->free) {
+    typeInfo->free(data, totelem, typeInfo->size);
+  }
 
-    if (typeInfo->free) {
-      typeInfo->free(layer->data, totelem, typeInfo->size);
-    }
+  MEM_freeN(data);
+}
 
-    if (layer->data) {
-      MEM_freeN(layer->data);
-    }
+static void customData_free_layer__internal(CustomDataLayer *layer, int totelem)
+{
+  if (layer->flag & CD_FLAG_SHARED) {
+    customData_shared_data_remove_user(layer->type, layer->data, totelem);
+  }
+  else if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
+    customData_free_layer_data(layer->type, layer->data, totelem);
   }
 }
 
@@ -2310,6 +2428,9 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
     return &data->layers[CustomData_get_layer_index(data, type)];
   }
 
+  /* Data allocated by the copy and default callbacks is part of the layer too. */
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_MESH);
+
   if ((alloctype == CD_ASSIGN) || (alloctype == CD_REFERENCE)) {
     newlayerdata = layerdata;
   }
@@ -2322,6 +2443,7 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
     }
 
     if (!newlayerdata) {
+      MEM_category_end(category_prev);
       return NULL;
     }
   }
@@ -2343,6 +2465,8 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
     flag |= CD_FLAG_NOFREE;
   }
 
+  MEM_category_end(category_prev);
+
   if (index >= data->maxlayer) {
     if (!customData_resize(data, CUSTOMDATA_GROW)) {
       if (newlayerdata != layerdata) {
@@ -2547,13 +2671,20 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
 
   layer = &data->layers[layer_index];
 
+  if ((layer->flag & CD_FLAG_SHARED) && customData_shared_data_take_ownership(layer)) {
+    /* No other layer uses the data anymore, nothing to duplicate. */
+    return layer->data;
+  }
+
   if (layer->flag & CD_FLAG_NOFREE) {
     /* MEM_dupallocN won't work in case of complex layers, like e.g.
      * CD_MDEFORMVERT, which has pointers to allocated data...
      * So in case a custom copy function is defined, use it!
      */
     const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+    void *src_data = layer->data;
 
+    const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_MESH);
     if (typeInfo->copy) {
       void *dst_data = MEM_malloc_arrayN(
           (size_t)totelem, typeInfo->size, "CD duplicate ref layer");
@@ -2563,7 +2694,12 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
     else {
       layer->data = MEM_dupallocN(layer->data);
     }
+    MEM_category_end(category_prev);
 
+    if (layer->flag & CD_FLAG_SHARED) {
+      customData_shared_data_remove_user(layer->type, src_data, totelem);
+      layer->flag &= ~CD_FLAG_SHARED;
+    }
     layer->flag &= ~CD_FLAG_NOFREE;
   }
 
@@ -2719,32 +2855,48 @@ static void CustomData_copy_data_layer(const CustomData *source,
   }
 }
 
-void CustomData_copy_data_named(
-    const CustomData *source, CustomData *dest, int source_index, int dest_index, int count)
-{
-  int src_i, dest_i;
+/* Below this number of elements layers are copied and interpolated on a single thread. */
+#define CUSTOMDATA_PARALLEL_MIN 1024
 
-  /* copies a layer at a time */
-  for (src_i = 0; src_i < source->totlayer; src_i++) {
+#define LAYER_PAIRS_BUF_SIZE 64
 
-    dest_i = CustomData_get_named_layer_index(
-        dest, source->layers[src_i].type, source->layers[src_i].name);
+/* Pairs of source and destination layer indices, handled a layer at a time. */
+typedef struct CustomDataLayerPairs {
+  const CustomData *source;
+  CustomData *dest;
+  int (*layers)[2];
+  int layers_len;
+  /* Avoids allocating for the common case, these are used for single elements too. */
+  int layers_buf[LAYER_PAIRS_BUF_SIZE][2];
+} CustomDataLayerPairs;
 
-    /* if we found a matching layer, copy the data */
-    if (dest_i != -1) {
-      CustomData_copy_data_layer(source, dest, src_i, dest_i, source_index, dest_index, count);
-    }
-  }
+static void customdata_layer_pairs_alloc(CustomDataLayerPairs *pairs,
+                                         const CustomData *source,
+                                         CustomData *dest)
+{
+  pairs->source = source;
+  pairs->dest = dest;
+  pairs->layers = (source->totlayer > LAYER_PAIRS_BUF_SIZE) ?
+                      MEM_malloc_arrayN(
+                          (size_t)source->totlayer, sizeof(*pairs->layers), __func__) :
+                      pairs->layers_buf;
+  pairs->layers_len = 0;
 }
 
-void CustomData_copy_data(
-    const CustomData *source, CustomData *dest, int source_index, int dest_index, int count)
+static void customdata_layer_pairs_init(CustomDataLayerPairs *pairs,
+                                        const CustomData *source,
+                                        CustomData *dest,
+                                        const bool use_interp)
 {
   int src_i, dest_i;
 
-  /* copies a layer at a time */
+  customdata_layer_pairs_alloc(pairs, source, dest);
+
   dest_i = 0;
   for (src_i = 0; src_i < source->totlayer; src_i++) {
+    if (use_interp && !layerType_getInfo(source->layers[src_i].type)->interp) {
+      continue;
+    }
 
     /* find the first dest layer with type >= the source type
      * (this should work because layers are ordered by type)
@@ -2755,12 +2907,14 @@ void CustomData_copy_data(
 
     /* if there are no more dest layers, we're done */
     if (dest_i >= dest->totlayer) {
-      return;
+      break;
     }
 
     /* if we found a matching layer, copy the data */
     if (dest->layers[dest_i].type == source->layers[src_i].type) {
-      CustomData_copy_data_layer(source, dest, src_i, dest_i, source_index, dest_index, count);
+      pairs->layers[pairs->layers_len][0] = src_i;
+      pairs->layers[pairs->layers_len][1] = dest_i;
+      pairs->layers_len++;
 
       /* if there are multiple source & dest layers of the same type,
        * we don't want to copy all source layers to the same dest, so
@@ -2771,6 +2925,95 @@ void CustomData_copy_data(
   }
 }
 
+static void customdata_layer_pairs_free(CustomDataLayerPairs *pairs)
+{
+  if (pairs->layers != pairs->layers_buf) {
+    MEM_freeN(pairs->layers);
+  }
+}
+
+typedef struct CustomDataCopyData {
+  CustomDataLayerPairs pairs;
+  int source_index;
+  int dest_index;
+  int count;
+} CustomDataCopyData;
+
+static void customdata_copy_data_layer_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CustomDataCopyData *data = userdata;
+  CustomData_copy_data_layer(data->pairs.source,
+                             data->pairs.dest,
+                             data->pairs.layers[i][0],
+                             data->pairs.layers[i][1],
+                             data->source_index,
+                             data->dest_index,
+                             data->count);
+}
+
+/* Large copies are split over layers, which are independent of each other. */
+static void customdata_copy_data_pairs(CustomDataCopyData *data)
+{
+  if ((data->count >= CUSTOMDATA_PARALLEL_MIN) && (data->pairs.layers_len > 1)) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(
+        0, data->pairs.layers_len, data, customdata_copy_data_layer_cb, &settings);
+  }
+  else {
+    for (int i = 0; i < data->pairs.layers_len; i++) {
+      customdata_copy_data_layer_cb(data, i, NULL);
+    }
+  }
+}
+
+void CustomData_copy_data_named(
+    const CustomData *source, CustomData *dest, int source_index, int dest_index, int count)
+{
+  /* Not using an initializer, which would clear the layer buffer for every call. */
+  CustomDataCopyData data;
+  data.source_index = source_index;
+  data.dest_index = dest_index;
+  data.count = count;
+  int src_i, dest_i;
+
+  customdata_layer_pairs_alloc(&data.pairs, source, dest);
+
+  /* copies a layer at a time */
+  for (src_i = 0; src_i < source->totlayer; src_i++) {
+
+    dest_i = CustomData_get_named_layer_index(
+        dest, source->layers[src_i].type, source->layers[src_i].name);
+
+    /* if we found a matching layer, copy the data */
+    if (dest_i != -1) {
+      data.pairs.layers[data.pairs.layers_len][0] = src_i;
+      data.pairs.layers[data.pairs.layers_len][1] = dest_i;
+      data.pairs.layers_len++;
+    }
+  }
+
+  customdata_copy_data_pairs(&data);
+  customdata_layer_pairs_free(&data.pairs);
+}
+
+void CustomData_copy_data(
+    const CustomData *source, CustomData *dest, int source_index, int dest_index, int count)
+{
+  /* Not using an initializer, which would clear the layer buffer for every call. */
+  CustomDataCopyData data;
+  data.source_index = source_index;
+  data.dest_index = dest_index;
+  data.count = count;
+
+  /* copies a layer at a time */
+  customdata_layer_pairs_init(&data.pairs, source, dest, false);
+  customdata_copy_data_pairs(&data);
+  customdata_layer_pairs_free(&data.pairs);
+}
+
 void CustomData_copy_layer_type_data(const CustomData *source,
                                      CustomData *destination,
                                      int type,
@@ -2881,6 +3124,88 @@ void CustomData_interp(const CustomData *source,
   }
 }
 
+typedef struct CustomDataInterpData {
+  CustomDataLayerPairs pairs;
+  const int *src_indices;
+  const float *weights;
+  int count;
+  int dest_index;
+  int dest_count;
+} CustomDataInterpData;
+
+static void customdata_interp_range_layer_cb(void *__restrict userdata,
+                                             const int i,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CustomDataInterpData *data = userdata;
+  const CustomDataLayer *src_layer = &data->pairs.source->layers[data->pairs.layers[i][0]];
+  const CustomDataLayer *dest_layer = &data->pairs.dest->layers[data->pairs.layers[i][1]];
+  const LayerTypeInfo *typeInfo = layerType_getInfo(src_layer->type);
+  const int count = data->count;
+  const void *source_buf[SOURCE_BUF_SIZE];
+  const void **sources = source_buf;
+
+  if (count > SOURCE_BUF_SIZE) {
+    sources = MEM_malloc_arrayN((size_t)count, sizeof(*sources), __func__);
+  }
+
+  /* All elements share the sources, only the weights differ. */
+  for (int j = 0; j < count; j++) {
+    sources[j] = POINTER_OFFSET(src_layer->data, (size_t)data->src_indices[j] * typeInfo->size);
+  }
+
+  void *dest_data = POINTER_OFFSET(dest_layer->data, (size_t)data->dest_index * typeInfo->size);
+  for (int k = 0; k < data->dest_count; k++) {
+    const float *weights = data->weights ? &data->weights[k * count] : NULL;
+    typeInfo->interp(sources, weights, NULL, count, dest_data);
+    dest_data = POINTER_OFFSET(dest_data, typeInfo->size);
+  }
+
+  if (count > SOURCE_BUF_SIZE) {
+    MEM_freeN((void *)sources);
+  }
+}
+
+/**
+ * Interpolate \a dest_count consecutive elements starting at \a dest_index, all of them
+ * from the same \a count source elements. \a weights holds \a count weights for every
+ * destination element (or is NULL).
+ *
+ * Gives the same result as calling #CustomData_interp for every element, but the layers
+ * are looked up once and interpolated on multiple threads for large ranges.
+ */
+void CustomData_interp_range(const CustomData *source,
+                             CustomData *dest,
+                             const int *src_indices,
+                             const float *weights,
+                             int count,
+                             int dest_index,
+                             int dest_count)
+{
+  CustomDataInterpData data;
+  data.src_indices = src_indices;
+  data.weights = weights;
+  data.count = count;
+  data.dest_index = dest_index;
+  data.dest_count = dest_count;
+
+  customdata_layer_pairs_init(&data.pairs, source, dest, true);
+
+  if ((dest_count * count >= CUSTOMDATA_PARALLEL_MIN) && (data.pairs.layers_len > 1)) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(
+        0, data.pairs.layers_len, &data, customdata_interp_range_layer_cb, &settings);
+  }
+  else {
+    for (int i = 0; i < data.pairs.layers_len; i++) {
+      customdata_interp_range_layer_cb(&data, i, NULL);
+    }
+  }
+
+  customdata_layer_pairs_free(&data.pairs);
+}
+
 /**
  * Swap data inside each item, for all layers.
  * This only applies to item types that may store several sub-item data
@@ -4069,6 +4394,30 @@ int CustomData_sizeof(int type)
   return typeInfo->size;
 }
 
+/**
+ * Memory used by the layers, in bytes. Layers referencing the data of another owner are skipped,
+ * shared layers are counted by each of their users.
+ */
+size_t CustomData_memory_usage(const CustomData *data, int totelem)
+{
+  size_t size = MEM_allocN_len(data->layers);
+  for (int i = 0; i < data->totlayer; i++) {
+    const CustomDataLayer *layer = &data->layers[i];
+    if ((layer->flag & CD_FLAG_NOFREE) && !(layer->flag & CD_FLAG_SHARED)) {
+      continue;
+    }
+    /* BMesh layers are stored in blocks, layer data is NULL then. */
+    size += MEM_allocN_len(layer->data);
+    if (layer->type == CD_MDEFORMVERT && layer->data) {
+      const MDeformVert *dvert = layer->data;
+      for (int j = 0; j < totelem; j++) {
+        size += MEM_allocN_len(dvert[j].dw);
+      }
+    }
+  }
+  return size;
+}
+
 const char *CustomData_layertype_name(int type)
 {
   return layerType_getName(type);
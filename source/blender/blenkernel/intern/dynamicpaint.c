@@ -4882,14 +4882,11 @@ static void dynamicPaint_prepareAdjacencyData(DynamicPaintSurface *surface, cons
 
   /* calculate average values (single thread).
    * Note: tried to put this in threaded callback (using _finalize feature),
-   * but gave ~30% slower result! */
+   * but gave ~30% slower result!
+   * The neighbors of all points are stored consecutively, sum them in memory order. */
   bData->average_dist = 0.0;
-  for (index = 0; index < sData->total_points; index++) {
-    int numOfNeighs = adj_data->n_num[index];
-
-    for (int i = 0; i < numOfNeighs; i++) {
-      bData->average_dist += (double)bNeighs[adj_data->n_index[index] + i].dist;
-    }
+  for (index = 0; index < adj_data->total_targets; index++) {
+    bData->average_dist += (double)bNeighs[index].dist;
   }
   bData->average_dist /= adj_data->total_targets;
 }
@@ -5726,15 +5723,12 @@ static void dynamic_paint_wave_step_cb(void *__restrict userdata,
 static void dynamicPaint_doWaveStep(DynamicPaintSurface *surface, float timescale)
 {
   PaintSurfaceData *sData = surface->data;
-  BakeAdjPoint *bNeighs = sData->bData->bNeighs;
-  int index;
   int steps, ss;
   float dt, min_dist, damp_factor;
   const float wave_speed = surface->wave_speed;
   const float wave_max_slope = (surface->wave_smoothness >= 0.01f) ?
                                    (0.5f / surface->wave_smoothness) :
                                    0.0f;
-  double average_dist = 0.0f;
   const float canvas_size = getSurfaceDimension(sData);
   const float wave_scale = CANVAS_REL_SIZE / canvas_size;
 
@@ -5744,16 +5738,8 @@ static void dynamicPaint_doWaveStep(DynamicPaintSurface *surface, float timescal
     return;
   }
 
-  /* calculate average neigh distance (single thread) */
-  for (index = 0; index < sData->total_points; index++) {
-    int i;
-    int numOfNeighs = sData->adj_data->n_num[index];
-
-    for (i = 0; i < numOfNeighs; i++) {
-      average_dist += (double)bNeighs[sData->adj_data->n_index[index] + i].dist;
-    }
-  }
-  average_dist *= (double)wave_scale / sData->adj_data->total_targets;
+  /* average neigh distance, calculated along with the adjacency data of this frame */
+  const double average_dist = sData->bData->average_dist * (double)wave_scale;
 
   /* determine number of required steps */
   steps = (int)ceil((double)(WAVE_TIME_FAC * timescale * surface->wave_timescale) /
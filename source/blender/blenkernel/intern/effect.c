@@ -149,7 +149,7 @@ void BKE_partdeflect_free(PartDeflect *pd)
 
 /******************** EFFECTOR RELATIONS ***********************/
 
-static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *eff)
+static void effector_random_reset(struct Depsgraph *depsgraph, EffectorCache *eff)
 {
   float ctime = DEG_get_ctime(depsgraph);
   uint cfra = (uint)(ctime >= 0 ? ctime : -ctime);
@@ -159,6 +159,13 @@ static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *ef
   else {
     BLI_rng_srandom(eff->pd->rng, eff->pd->seed + cfra);
   }
+}
+
+static void precalculate_effector(struct Depsgraph *depsgraph, EffectorCache *eff)
+{
+  float ctime = DEG_get_ctime(depsgraph);
+
+  effector_random_reset(depsgraph, eff);
 
   if (eff->pd->forcefield == PFIELD_GUIDE && eff->ob->type == OB_CURVE) {
     Curve *cu = eff->ob->data;
@@ -340,6 +347,17 @@ void BKE_effectors_free(ListBase *lb)
   }
 }
 
+/* Restart the random numbers of the effectors, so a list of effectors used for several objects
+ * gives every object the same results as a list created for it. */
+void BKE_effectors_random_reset(Depsgraph *depsgraph, ListBase *effectors)
+{
+  if (effectors) {
+    for (EffectorCache *eff = effectors->first; eff; eff = eff->next) {
+      effector_random_reset(depsgraph, eff);
+    }
+  }
+}
+
 void pd_point_from_particle(ParticleSimulationData *sim,
                             ParticleData *pa,
                             ParticleKey *state,
@@ -2657,6 +2657,47 @@ static void berekeny(float f1, float f2, float f3, float f4, float *o, int b)
 /* -------------------------- */
 
 /* Calculate F-Curve value for 'evaltime' using BezTriple keyframes */
+/* Threshold for keyframes to count as being on the evaluation time.
+ *
+ * The threshold here has the following constraints:
+ * - 0.001 is too coarse:
+ *   We get artifacts with 2cm driver movements at 1BU = 1m (see T40332)
+ *
+ * - 0.00001 is too fine:
+ *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
+ *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
+ */
+#define FCURVE_EVAL_BINARYSEARCH_THRESH 0.0001f
+
+/* Same result as #binarysearch_bezt_index_ex for 'evaltime' between the first and last keyframe,
+ * the keyframe segment used by the previous evaluation and the one after it are checked first,
+ * so playback doesn't need to search all keyframes of every curve on every frame. */
+static int fcurve_eval_keyframes_index_find(FCurve *fcu,
+                                            BezTriple *bezts,
+                                            const float evaltime,
+                                            bool *r_exact)
+{
+  const float threshold = FCURVE_EVAL_BINARYSEARCH_THRESH;
+  const int totvert = (int)fcu->totvert;
+  /* Read once, another thread may evaluate the same curve. */
+  const int hint = fcu->eval_segment_hint;
+
+  for (int i = max_ii(hint, 0); i < hint + 2 && i + 1 < totvert; i++) {
+    /* With sorted keyframes, no other keyframe can be within the threshold, when 'evaltime' is
+     * strictly inside the segment, so the binary search would return the segment end too. */
+    if ((evaltime - bezts[i].vec[1][0] > threshold) &&
+        (bezts[i + 1].vec[1][0] - evaltime > threshold)) {
+      fcu->eval_segment_hint = i;
+      *r_exact = false;
+      return i + 1;
+    }
+  }
+
+  const int a = binarysearch_bezt_index_ex(bezts, evaltime, totvert, threshold, r_exact);
+  fcu->eval_segment_hint = *r_exact ? a : a - 1;
+  return a;
+}
+
 static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime)
 {
   const float eps = 1.e-8f;
@@ -2779,17 +2820,9 @@ static float fcurve_eval_keyframes(FCurve *fcu, BezTriple *bezts, float evaltime
     /* evaltime occurs somewhere in the middle of the curve */
     bool exact = false;
 
-    /* Use binary search to find appropriate keyframes...
-     *
-     * The threshold here has the following constraints:
-     * - 0.001 is too coarse:
-     *   We get artifacts with 2cm driver movements at 1BU = 1m (see T40332)
-     *
-     * - 0.00001 is too fine:
-     *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
-     *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
-     */
-    a = binarysearch_bezt_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+    /* Use binary search to find appropriate keyframes
+     * (unless they're the same as for the previous evaluation). */
+    a = fcurve_eval_keyframes_index_find(fcu, bezts, evaltime, &exact);
 
     if (exact) {
       /* index returned must be interpreted differently when it sits on top of an existing keyframe
@@ -30,6 +30,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_math_geom.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -850,6 +851,75 @@ static void gpencil_evaluated_frame_ensure(int idx,
   gpencil_frame_copy_noalloc(ob, gpf, *gpf_eval);
 }
 
+typedef struct GpencilStrokeModifiersData {
+  Depsgraph *depsgraph;
+  Object *ob;
+  bGPDlayer *gpl;
+  bGPDframe *gpf;
+  bGPDstroke **strokes;
+  bool is_render;
+} GpencilStrokeModifiersData;
+
+static void gpencil_stroke_modifiers_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GpencilStrokeModifiersData *data = userdata;
+  BKE_gpencil_stroke_modifiers(
+      data->depsgraph, data->ob, data->gpl, data->gpf, data->strokes[i], data->is_render);
+}
+
+/* Deform modifiers only change the stroke they are applied on, except for merging points which
+ * can remove the stroke from the frame. */
+static bool gpencil_stroke_modifiers_use_threading(Object *ob)
+{
+  for (GpencilModifierData *md = ob->greasepencil_modifiers.first; md; md = md->next) {
+    if (md->type == eGpencilModifierType_Simplify) {
+      SimplifyGpencilModifierData *mmd = (SimplifyGpencilModifierData *)md;
+      if (mmd->mode == GP_SIMPLIFY_MERGE) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/* Apply modifiers that only deform geometry to all strokes of the frame. */
+static void gpencil_frame_stroke_modifiers(
+    Depsgraph *depsgraph, Object *ob, bGPDlayer *gpl, bGPDframe *gpf, const bool is_render)
+{
+  const int strokes_num = BLI_listbase_count(&gpf->strokes);
+
+  if ((strokes_num < 64) || !gpencil_stroke_modifiers_use_threading(ob)) {
+    for (bGPDstroke *gps = gpf->strokes.first; gps; gps = gps->next) {
+      BKE_gpencil_stroke_modifiers(depsgraph, ob, gpl, gpf, gps, is_render);
+    }
+    return;
+  }
+
+  bGPDstroke **strokes = MEM_mallocN(sizeof(*strokes) * strokes_num, __func__);
+  int i = 0;
+  for (bGPDstroke *gps = gpf->strokes.first; gps; gps = gps->next) {
+    strokes[i++] = gps;
+  }
+
+  GpencilStrokeModifiersData data = {
+      .depsgraph = depsgraph,
+      .ob = ob,
+      .gpl = gpl,
+      .gpf = gpf,
+      .strokes = strokes,
+      .is_render = is_render,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, strokes_num, &data, gpencil_stroke_modifiers_cb, &settings);
+
+  MEM_freeN(strokes);
+}
+
 /* Calculate gpencil modifiers */
 void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
@@ -922,10 +992,7 @@ void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
     }
 
     /* Loop all strokes and deform them. */
-    for (bGPDstroke *gps = gpf_eval->strokes.first; gps; gps = gps->next) {
-      /* Apply modifiers that only deform geometry */
-      BKE_gpencil_stroke_modifiers(depsgraph, ob, gpl, gpf_eval, gps, is_render);
-    }
+    gpencil_frame_stroke_modifiers(depsgraph, ob, gpl, gpf_eval, is_render);
 
     idx++;
   }
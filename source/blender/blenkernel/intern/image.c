@@ -1050,6 +1050,11 @@ static uintptr_t image_mem_size(Image *image)
   return size;
 }
 
+size_t BKE_image_memory_usage(Image *ima)
+{
+  return (size_t)image_mem_size(ima);
+}
+
 void BKE_image_print_memlist(Main *bmain)
 {
   Image *ima;
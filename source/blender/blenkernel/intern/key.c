@@ -30,6 +30,7 @@
 #include "BLI_blenlib.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -773,6 +774,129 @@ static void cp_cu_key(Curve *cu,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Relative Coordinate Keys
+ *
+ * Fast path of #key_evaluate_relative for keys storing plain coordinates (meshes and lattices).
+ * The key blocks contributing to the result are gathered once, then all of them are accumulated
+ * for a range of elements at a time, so the result stays in the cache while adding many keys.
+ * \{ */
+
+/* Number of elements all key blocks are accumulated for at once. */
+#define KEY_RELATIVE_COORDS_CHUNK_SIZE 1024
+
+typedef struct KeyRelativeCoordsBlock {
+  const float (*from)[3];
+  const float (*reffrom)[3];
+  /* Optional per element weights (from the vertex group). */
+  const float *weights;
+  float weight;
+} KeyRelativeCoordsBlock;
+
+typedef struct KeyRelativeCoordsData {
+  float (*out)[3];
+  const KeyRelativeCoordsBlock *blocks;
+  int blocks_len;
+  int start, end;
+} KeyRelativeCoordsData;
+
+static void key_evaluate_relative_coords_cb(void *__restrict userdata,
+                                            const int chunk_index,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KeyRelativeCoordsData *data = userdata;
+  const int start = data->start + chunk_index * KEY_RELATIVE_COORDS_CHUNK_SIZE;
+  const int end = min_ii(start + KEY_RELATIVE_COORDS_CHUNK_SIZE, data->end);
+  float(*out)[3] = data->out;
+
+  for (int i = 0; i < data->blocks_len; i++) {
+    const KeyRelativeCoordsBlock *block = &data->blocks[i];
+    const float(*from)[3] = block->from;
+    const float(*reffrom)[3] = block->reffrom;
+
+    /* Same operation as #rel_flerp, so the result matches the generic code exactly. */
+    if (block->weights) {
+      for (int b = start; b < end; b++) {
+        const float weight = block->weights[b] * block->weight;
+        out[b][0] -= weight * (reffrom[b][0] - from[b][0]);
+        out[b][1] -= weight * (reffrom[b][1] - from[b][1]);
+        out[b][2] -= weight * (reffrom[b][2] - from[b][2]);
+      }
+    }
+    else {
+      const float weight = block->weight;
+      for (int b = start; b < end; b++) {
+        out[b][0] -= weight * (reffrom[b][0] - from[b][0]);
+        out[b][1] -= weight * (reffrom[b][1] - from[b][1]);
+        out[b][2] -= weight * (reffrom[b][2] - from[b][2]);
+      }
+    }
+  }
+}
+
+static void key_evaluate_relative_coords(const int start,
+                                         const int end,
+                                         const int tot,
+                                         float (*out)[3],
+                                         Key *key,
+                                         KeyBlock *actkb,
+                                         float **per_keyblock_weights)
+{
+  const int totblock = BLI_listbase_count(&key->block);
+  KeyRelativeCoordsBlock *blocks = MEM_mallocN(sizeof(*blocks) * (size_t)totblock, __func__);
+  /* Two temporary copies at most per key block, see #key_block_get_data. */
+  char **freedata = MEM_mallocN(sizeof(*freedata) * (size_t)totblock * 2, __func__);
+  int blocks_len = 0, freedata_len = 0;
+
+  KeyBlock *kb;
+  int keyblock_index;
+  for (kb = key->block.first, keyblock_index = 0; kb; kb = kb->next, keyblock_index++) {
+    /* Only with value, and no difference allowed. */
+    if (kb == key->refkey || (kb->flag & KEYBLOCK_MUTE) || kb->curval == 0.0f ||
+        kb->totelem != tot) {
+      continue;
+    }
+    /* Reference now can be any block. */
+    KeyBlock *refb = BLI_findlink(&key->block, kb->relative);
+    if (refb == NULL) {
+      continue;
+    }
+    KeyRelativeCoordsBlock *block = &blocks[blocks_len++];
+    block->from = (const float(*)[3])key_block_get_data(key, actkb, kb, &freedata[freedata_len]);
+    freedata_len += (freedata[freedata_len] != NULL);
+    block->reffrom = (const float(*)[3])key_block_get_data(
+        key, actkb, refb, &freedata[freedata_len]);
+    freedata_len += (freedata[freedata_len] != NULL);
+    block->weights = per_keyblock_weights ? per_keyblock_weights[keyblock_index] : NULL;
+    block->weight = kb->curval;
+  }
+
+  if (blocks_len != 0 && end > start) {
+    KeyRelativeCoordsData data = {
+        .out = out,
+        .blocks = blocks,
+        .blocks_len = blocks_len,
+        .start = start,
+        .end = end,
+    };
+    const int chunks_len = (end - start + KEY_RELATIVE_COORDS_CHUNK_SIZE - 1) /
+                           KEY_RELATIVE_COORDS_CHUNK_SIZE;
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = chunks_len > 1;
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, chunks_len, &data, key_evaluate_relative_coords_cb, &settings);
+  }
+
+  for (int i = 0; i < freedata_len; i++) {
+    MEM_freeN(freedata[i]);
+  }
+  MEM_freeN(freedata);
+  MEM_freeN(blocks);
+}
+
+/** \} */
+
 static void key_evaluate_relative(const int start,
                                   int end,
                                   const int tot,
@@ -811,6 +935,13 @@ static void key_evaluate_relative(const int start,
 
   /* step 2: do it */
 
+  if (mode != KEY_MODE_BEZTRIPLE && key->elemstr[1] == IPO_FLOAT && key->elemstr[2] == 0 &&
+      elemsize == sizeof(float[KEYELEM_FLOAT_LEN_COORD]) && poinsize == elemsize) {
+    key_evaluate_relative_coords(
+        start, end, tot, (float(*)[3])basispoin, key, actkb, per_keyblock_weights);
+    return;
+  }
+
   for (kb = key->block.first, keyblock_index = 0; kb; kb = kb->next, keyblock_index++) {
     if (kb != key->refkey) {
       float icuval = kb->curval;
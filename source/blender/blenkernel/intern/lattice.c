@@ -334,7 +334,12 @@ void BKE_lattice_make_local(Main *bmain, Lattice *lt, const bool lib_local)
 }
 
 typedef struct LatticeDeformData {
-  Object *object;
+  /* Resolved from the lattice object once, see #calc_latt_deform. */
+  const Lattice *lt;
+  /* Vertex group of the lattice points, NULL when not used. */
+  const MDeformVert *dvert;
+  int defgrp_index;
+
   float *latticedata;
   float latmat[4][4];
 } LatticeDeformData;
@@ -401,36 +406,42 @@ LatticeDeformData *init_latt_deform(Object *oblatt, Object *ob)
 
   lattice_deform_data = MEM_mallocN(sizeof(LatticeDeformData), "Lattice Deform Data");
   lattice_deform_data->latticedata = latticedata;
-  lattice_deform_data->object = oblatt;
+  lattice_deform_data->lt = lt;
+  lattice_deform_data->dvert = NULL;
+  lattice_deform_data->defgrp_index = -1;
   copy_m4_m4(lattice_deform_data->latmat, latmat);
 
+  /* Looked up once here instead of for every deformed point. */
+  MDeformVert *dvert = BKE_lattice_deform_verts_get(oblatt);
+  if (lt->vgroup[0] && dvert) {
+    lattice_deform_data->defgrp_index = defgroup_name_index(oblatt, lt->vgroup);
+    if (lattice_deform_data->defgrp_index != -1) {
+      lattice_deform_data->dvert = dvert;
+    }
+  }
+
   return lattice_deform_data;
 }
 
 void calc_latt_deform(LatticeDeformData *lattice_deform_data, float co[3], float weight)
 {
-  Object *ob = lattice_deform_data->object;
-  Lattice *lt = ob->data;
+  const Lattice *lt = lattice_deform_data->lt;
   float u, v, w, tu[4], tv[4], tw[4];
   float vec[3];
   int idx_w, idx_v, idx_u;
   int ui, vi, wi, uu, vv, ww;
 
   /* vgroup influence */
-  int defgrp_index = -1;
+  const MDeformVert *dvert = lattice_deform_data->dvert;
+  const int defgrp_index = lattice_deform_data->defgrp_index;
   float co_prev[3], weight_blend = 0.0f;
-  MDeformVert *dvert = BKE_lattice_deform_verts_get(ob);
   float *__restrict latticedata = lattice_deform_data->latticedata;
 
-  if (lt->editlatt) {
-    lt = lt->editlatt->latt;
-  }
   if (latticedata == NULL) {
     return;
   }
 
-  if (lt->vgroup[0] && dvert) {
-    defgrp_index = defgroup_name_index(ob, lt->vgroup);
+  if (dvert) {
     copy_v3_v3(co_prev, co);
   }
 
@@ -525,7 +536,7 @@ void calc_latt_deform(LatticeDeformData *lattice_deform_data, float co[3], float
 
               madd_v3_v3fl(co, &latticedata[idx_u * 3], u);
 
-              if (defgrp_index != -1) {
+              if (dvert) {
                 weight_blend += (u * defvert_find_weight(dvert + idx_u, defgrp_index));
               }
             }
@@ -535,7 +546,7 @@ void calc_latt_deform(LatticeDeformData *lattice_deform_data, float co[3], float
     }
   }
 
-  if (defgrp_index != -1) {
+  if (dvert) {
     interp_v3_v3v3(co, co_prev, co, weight_blend);
   }
 }
@@ -743,6 +754,43 @@ static bool calc_curve_deform(
   return false;
 }
 
+typedef struct CurveDeformUserdata {
+  Object *cuOb;
+  CurveDeform *cd;
+  float (*vert_coords)[3];
+  const MDeformVert *dvert;
+  int defgrp_index;
+  short defaxis;
+  /* Weighted coordinates are still in object space (with bounds off). */
+  bool use_curvespace_transform;
+} CurveDeformUserdata;
+
+static void curve_deform_vert_task(void *__restrict userdata,
+                                   const int index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CurveDeformUserdata *data = userdata;
+  float *co = data->vert_coords[index];
+
+  if (data->dvert != NULL) {
+    const float weight = defvert_find_weight(data->dvert + index, data->defgrp_index);
+
+    if (weight > 0.0f) {
+      float vec[3];
+      if (data->use_curvespace_transform) {
+        mul_m4_v3(data->cd->curvespace, co);
+      }
+      copy_v3_v3(vec, co);
+      calc_curve_deform(data->cuOb, vec, data->defaxis, data->cd, NULL);
+      interp_v3_v3v3(co, co, vec, weight);
+      mul_m4_v3(data->cd->objectspace, co);
+    }
+  }
+  else {
+    calc_curve_deform(data->cuOb, co, data->defaxis, data->cd, NULL);
+  }
+}
+
 void curve_deform_verts(Object *cuOb,
                         Object *target,
                         float (*vert_coords)[3],
@@ -775,22 +823,25 @@ void curve_deform_verts(Object *cuOb,
     cd.dmax[0] = cd.dmax[1] = cd.dmax[2] = 0.0f;
   }
 
+  CurveDeformUserdata data = {
+      .cuOb = cuOb,
+      .cd = &cd,
+      .vert_coords = vert_coords,
+      .dvert = dvert,
+      .defgrp_index = defgrp_index,
+      .defaxis = defaxis,
+      .use_curvespace_transform = false,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 32;
+
   if (dvert) {
     MDeformVert *dvert_iter;
-    float vec[3];
 
     if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0, dvert_iter = dvert; a < numVerts; a++, dvert_iter++) {
-        const float weight = defvert_find_weight(dvert_iter, defgrp_index);
-
-        if (weight > 0.0f) {
-          mul_m4_v3(cd.curvespace, vert_coords[a]);
-          copy_v3_v3(vec, vert_coords[a]);
-          calc_curve_deform(cuOb, vec, defaxis, &cd, NULL);
-          interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight);
-          mul_m4_v3(cd.objectspace, vert_coords[a]);
-        }
-      }
+      data.use_curvespace_transform = true;
     }
     else {
       /* set mesh min/max bounds */
@@ -802,43 +853,27 @@ void curve_deform_verts(Object *cuOb,
           minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
         }
       }
-
-      for (a = 0, dvert_iter = dvert; a < numVerts; a++, dvert_iter++) {
-        const float weight = defvert_find_weight(dvert_iter, defgrp_index);
-
-        if (weight > 0.0f) {
-          /* already in 'cd.curvespace', prev for loop */
-          copy_v3_v3(vec, vert_coords[a]);
-          calc_curve_deform(cuOb, vec, defaxis, &cd, NULL);
-          interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight);
-          mul_m4_v3(cd.objectspace, vert_coords[a]);
-        }
-      }
+      /* Weighted coordinates are now in 'cd.curvespace'. */
     }
+
+    BLI_task_parallel_range(0, numVerts, &data, curve_deform_vert_task, &settings);
   }
   else {
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0; a < numVerts; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
-        calc_curve_deform(cuOb, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
-    }
-    else {
+    mul_m4_v3_array(cd.curvespace, vert_coords, numVerts);
+
+    if ((cu->flag & CU_DEFORM_BOUNDS_OFF) == 0) {
       /* set mesh min max bounds */
       INIT_MINMAX(cd.dmin, cd.dmax);
 
       for (a = 0; a < numVerts; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
         minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
       }
-
-      for (a = 0; a < numVerts; a++) {
-        /* already in 'cd.curvespace', prev for loop */
-        calc_curve_deform(cuOb, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
     }
+
+    /* already in 'cd.curvespace', prev for loop */
+    BLI_task_parallel_range(0, numVerts, &data, curve_deform_vert_task, &settings);
+
+    mul_m4_v3_array(cd.objectspace, vert_coords, numVerts);
   }
 }
 
@@ -2550,6 +2550,26 @@ bool BKE_id_is_in_global_main(ID *id)
   return (id == NULL || BLI_findindex(which_libbase(G_MAIN, GS(id->name)), id) != -1);
 }
 
+/**
+ * Memory used by the data-block, in bytes: the ID struct and the data it owns which can be large
+ * (geometry of meshes, buffers of images). Meant for reports, smaller allocations are ignored.
+ */
+size_t BKE_id_memory_usage(ID *id)
+{
+  size_t size = MEM_allocN_len(id);
+  switch (GS(id->name)) {
+    case ID_ME:
+      size += BKE_mesh_memory_usage((Mesh *)id);
+      break;
+    case ID_IM:
+      size += BKE_image_memory_usage((Image *)id);
+      break;
+    default:
+      break;
+  }
+  return size;
+}
+
 /************************* Datablock order in UI **************************/
 
 static int *id_order_get(ID *id)
@@ -41,6 +41,7 @@
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "RNA_access.h"
 #include "RNA_types.h"
@@ -743,19 +744,54 @@ bool BKE_override_library_operations_create(Main *bmain, ID *local, const bool f
   return ret;
 }
 
-/** Check all overrides from given \a bmain and create/update overriding operations as needed. */
+typedef struct OverrideOperationsCreateData {
+  Main *bmain;
+  bool force_auto;
+} OverrideOperationsCreateData;
+
+static void override_library_operations_create_cb(TaskPool *__restrict pool,
+                                                  void *taskdata,
+                                                  int UNUSED(threadid))
+{
+  OverrideOperationsCreateData *data = BLI_task_pool_userdata(pool);
+  ID *id = taskdata;
+
+  BKE_override_library_operations_create(data->bmain, id, data->force_auto);
+}
+
+/** Check all overrides from given \a bmain and create/update overriding operations as needed.
+ *
+ * Each override is only compared with its own reference, so they are diffed in parallel. */
 void BKE_main_override_library_operations_create(Main *bmain, const bool force_auto)
 {
   ID *id;
+  OverrideOperationsCreateData data = {
+      .bmain = bmain,
+      .force_auto = force_auto,
+  };
+  TaskPool *task_pool = BLI_task_pool_create(BLI_task_scheduler_get(), &data);
 
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     if ((ID_IS_OVERRIDE_LIBRARY(id) && force_auto) ||
         (ID_IS_OVERRIDE_LIBRARY_AUTO(id) && (id->tag & LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH))) {
-      BKE_override_library_operations_create(bmain, id, force_auto);
+      /* Rebuilding poses touches the armature and Main, do it here rather than in the tasks. */
+      if (GS(id->name) == ID_OB) {
+        Object *ob = (Object *)id;
+        if (ob->data != NULL && ob->type == OB_ARMATURE && ob->pose != NULL &&
+            ob->pose->flag & POSE_RECALC) {
+          BKE_pose_rebuild(bmain, ob, ob->data, true);
+        }
+      }
+
+      BLI_task_pool_push(
+          task_pool, override_library_operations_create_cb, id, false, TASK_PRIORITY_HIGH);
       id->tag &= ~LIB_TAG_OVERRIDE_LIBRARY_AUTOREFRESH;
     }
   }
   FOREACH_MAIN_ID_END;
+
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
 }
 
 /** Update given override from its reference (re-applying overridden properties). */
@@ -39,6 +39,7 @@
 #include "BLI_string_utils.h"
 #include "BLI_utildefines.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -405,25 +406,26 @@ static float densfunc(const MetaElem *ball, float x, float y, float z)
 
 /**
  * Computes density at given position form all metaballs which contain this point in their box.
- * Traverses BVH using a queue.
+ * Traverses BVH using a queue, which can hold #PROCESS.bvh_queue_size nodes.
  */
-static float metaball(PROCESS *process, float x, float y, float z)
+static float metaball_ex(
+    PROCESS *process, MetaballBVHNode **bvh_queue, float x, float y, float z)
 {
   int i;
   float dens = 0.0f;
   unsigned int front = 0, back = 0;
   MetaballBVHNode *node;
 
-  process->bvh_queue[front++] = &process->metaball_bvh;
+  bvh_queue[front++] = &process->metaball_bvh;
 
   while (front != back) {
-    node = process->bvh_queue[back++];
+    node = bvh_queue[back++];
 
     for (i = 0; i < 2; i++) {
       if ((node->bb[i].min[0] <= x) && (node->bb[i].max[0] >= x) && (node->bb[i].min[1] <= y) &&
           (node->bb[i].max[1] >= y) && (node->bb[i].min[2] <= z) && (node->bb[i].max[2] >= z)) {
         if (node->child[i]) {
-          process->bvh_queue[front++] = node->child[i];
+          bvh_queue[front++] = node->child[i];
         }
         else {
           dens += densfunc(node->bb[i].ml, x, y, z);
@@ -435,6 +437,11 @@ static float metaball(PROCESS *process, float x, float y, float z)
   return process->thresh - dens;
 }
 
+static float metaball(PROCESS *process, float x, float y, float z)
+{
+  return metaball_ex(process, process->bvh_queue, x, y, z);
+}
+
 /**
  * Adds face to indices, expands memory if needed.
  */
@@ -967,14 +974,62 @@ static void addtovertices(PROCESS *process, const float v[3], const float no[3])
  *
  * \note Doesn't do normalization!
  */
-static void vnormal(PROCESS *process, const float point[3], float r_no[3])
+static void vnormal(PROCESS *process,
+                    MetaballBVHNode **bvh_queue,
+                    const float point[3],
+                    float r_no[3])
 {
   const float delta = process->delta;
-  const float f = metaball(process, point[0], point[1], point[2]);
+  const float f = metaball_ex(process, bvh_queue, point[0], point[1], point[2]);
+
+  r_no[0] = metaball_ex(process, bvh_queue, point[0] + delta, point[1], point[2]) - f;
+  r_no[1] = metaball_ex(process, bvh_queue, point[0], point[1] + delta, point[2]) - f;
+  r_no[2] = metaball_ex(process, bvh_queue, point[0], point[1], point[2] + delta) - f;
+}
+
+typedef struct VertexNormalsTLS {
+  MetaballBVHNode **bvh_queue;
+} VertexNormalsTLS;
+
+static void vertex_normals_cb(void *__restrict userdata,
+                              const int index,
+                              const TaskParallelTLS *__restrict tls)
+{
+  PROCESS *process = userdata;
+  VertexNormalsTLS *tls_data = tls->userdata_chunk;
+
+  /* Every thread traverses the BVH with its own queue. */
+  if (tls_data->bvh_queue == NULL) {
+    tls_data->bvh_queue = MEM_mallocN(sizeof(MetaballBVHNode *) * process->bvh_queue_size,
+                                      __func__);
+  }
+
+  vnormal(process, tls_data->bvh_queue, process->co[index], process->no[index]);
+  normalize_v3(process->no[index]);
+}
 
-  r_no[0] = metaball(process, point[0] + delta, point[1], point[2]) - f;
-  r_no[1] = metaball(process, point[0], point[1] + delta, point[2]) - f;
-  r_no[2] = metaball(process, point[0], point[1], point[2] + delta) - f;
+static void vertex_normals_finalize(void *__restrict UNUSED(userdata),
+                                    void *__restrict userdata_chunk)
+{
+  VertexNormalsTLS *tls_data = userdata_chunk;
+  MEM_SAFE_FREE(tls_data->bvh_queue);
+}
+
+/**
+ * Computes the normals of all vertices once the surface is polygonized,
+ * they only depend on the density field so they are computed in parallel.
+ */
+static void vertex_normals_calc(PROCESS *process)
+{
+  VertexNormalsTLS tls_data = {NULL};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (process->curvertex > 1000);
+  settings.userdata_chunk = &tls_data;
+  settings.userdata_chunk_size = sizeof(tls_data);
+  settings.func_finalize = vertex_normals_finalize;
+  BLI_task_parallel_range(0, (int)process->curvertex, process, vertex_normals_cb, &settings);
 }
 #endif /* USE_ACCUM_NORMAL */
 
@@ -994,11 +1049,8 @@ static int vertid(PROCESS *process, const CORNER *c1, const CORNER *c2)
 
   converge(process, c1, c2, v); /* position */
 
-#ifdef USE_ACCUM_NORMAL
+  /* Normals are computed once all vertices are known, see #vertex_normals_calc. */
   zero_v3(no);
-#else
-  vnormal(process, v, no);
-#endif
 
   addtovertices(process, v, no); /* save vertex */
   vid = (int)process->curvertex - 1;
@@ -1384,7 +1436,9 @@ void BKE_mball_polygonize(Depsgraph *depsgraph, Scene *scene, Object *ob, ListBa
 {
   MetaBall *mb;
   DispList *dl;
+#ifdef USE_ACCUM_NORMAL
   unsigned int a;
+#endif
   PROCESS process = {0};
   bool is_render = DEG_get_mode(depsgraph) == DAG_EVAL_RENDER;
 
@@ -1450,9 +1504,13 @@ void BKE_mball_polygonize(Depsgraph *depsgraph, Scene *scene, Object *ob, ListBa
 
         dl->index = (int *)process.indices;
 
+#ifdef USE_ACCUM_NORMAL
         for (a = 0; a < process.curvertex; a++) {
           normalize_v3(process.no[a]);
         }
+#else
+        vertex_normals_calc(&process);
+#endif
 
         dl->verts = (float *)process.co;
         dl->nors = (float *)process.no;
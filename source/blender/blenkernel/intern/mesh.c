@@ -36,6 +36,7 @@
 #include "BLI_memarena.h"
 #include "BLI_edgehash.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BKE_animsys.h"
 #include "BKE_idcode.h"
@@ -514,6 +515,20 @@ void BKE_mesh_clear_geometry(Mesh *mesh)
   BKE_mesh_update_customdata_pointers(mesh, false);
 }
 
+/* Memory used by the geometry of the mesh and its runtime caches, in bytes. */
+size_t BKE_mesh_memory_usage(const Mesh *me)
+{
+  size_t size = 0;
+  size += CustomData_memory_usage(&me->vdata, me->totvert);
+  size += CustomData_memory_usage(&me->edata, me->totedge);
+  size += CustomData_memory_usage(&me->fdata, me->totface);
+  size += CustomData_memory_usage(&me->ldata, me->totloop);
+  size += CustomData_memory_usage(&me->pdata, me->totpoly);
+  size += MEM_allocN_len(me->mselect);
+  size += MEM_allocN_len(me->runtime.looptris.array);
+  return size;
+}
+
 static void mesh_tessface_clear_intern(Mesh *mesh, int free_customdata)
 {
   if (free_customdata) {
@@ -587,7 +602,13 @@ void BKE_mesh_copy_data(Main *bmain, Mesh *me_dst, const Mesh *me_src, const int
 
   me_dst->mat = MEM_dupallocN(me_src->mat);
 
-  const eCDAllocType alloc_type = (flag & LIB_ID_COPY_CD_REFERENCE) ? CD_REFERENCE : CD_DUPLICATE;
+  eCDAllocType alloc_type = CD_DUPLICATE;
+  if (flag & LIB_ID_COPY_CD_REFERENCE) {
+    alloc_type = CD_REFERENCE;
+  }
+  else if (flag & LIB_ID_COPY_CD_SHARE) {
+    alloc_type = CD_SHARE;
+  }
   CustomData_copy(&me_src->vdata, &me_dst->vdata, mask.vmask, alloc_type, me_dst->totvert);
   CustomData_copy(&me_src->edata, &me_dst->edata, mask.emask, alloc_type, me_dst->totedge);
   CustomData_copy(&me_src->ldata, &me_dst->ldata, mask.lmask, alloc_type, me_dst->totloop);
@@ -1541,12 +1562,57 @@ void BKE_mesh_count_selected_items(const Mesh *mesh, int r_count[3])
   /* We could support faces in paint modes. */
 }
 
-void BKE_mesh_vert_coords_get(const Mesh *mesh, float (*vert_coords)[3])
+/* Number of vertices each thread copies the coordinates of at least, these copies are only
+ * limited by memory bandwidth, so threading only pays off for large meshes. */
+#define MESH_VERT_COORDS_CHUNK_SIZE 16384
+
+typedef struct MeshVertCoordsData {
+  MVert *mvert;
+  float (*vert_coords)[3];
+  /* Optional transform applied to the coordinates written to the vertices. */
+  const float (*mat)[4];
+} MeshVertCoordsData;
+
+static void mesh_vert_coords_get_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  const MVert *mv = mesh->mvert;
-  for (int i = 0; i < mesh->totvert; i++, mv++) {
-    copy_v3_v3(vert_coords[i], mv->co);
+  const MeshVertCoordsData *data = userdata;
+  copy_v3_v3(data->vert_coords[i], data->mvert[i].co);
+}
+
+static void mesh_vert_coords_apply_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MeshVertCoordsData *data = userdata;
+  if (data->mat) {
+    mul_v3_m4v3(data->mvert[i].co, data->mat, data->vert_coords[i]);
   }
+  else {
+    copy_v3_v3(data->mvert[i].co, data->vert_coords[i]);
+  }
+}
+
+static void mesh_vert_coords_parallel(const Mesh *mesh,
+                                      MeshVertCoordsData *data,
+                                      TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (mesh->totvert >= MESH_VERT_COORDS_CHUNK_SIZE * 2);
+  settings.min_iter_per_thread = MESH_VERT_COORDS_CHUNK_SIZE;
+  BLI_task_parallel_range(0, mesh->totvert, data, func, &settings);
+}
+
+void BKE_mesh_vert_coords_get(const Mesh *mesh, float (*vert_coords)[3])
+{
+  MeshVertCoordsData data = {
+      .mvert = mesh->mvert,
+      .vert_coords = vert_coords,
+      .mat = NULL,
+  };
+  mesh_vert_coords_parallel(mesh, &data, mesh_vert_coords_get_cb);
 }
 
 float (*BKE_mesh_vert_coords_alloc(const Mesh *mesh, int *r_vert_len))[3]
@@ -1559,28 +1625,33 @@ float (*BKE_mesh_vert_coords_alloc(const Mesh *mesh, int *r_vert_len))[3]
   return vert_coords;
 }
 
-void BKE_mesh_vert_coords_apply(Mesh *mesh, const float (*vert_coords)[3])
+static void mesh_vert_coords_apply_ex(Mesh *mesh,
+                                      const float (*vert_coords)[3],
+                                      const float (*mat)[4])
 {
   /* This will just return the pointer if it wasn't a referenced layer. */
   MVert *mv = CustomData_duplicate_referenced_layer(&mesh->vdata, CD_MVERT, mesh->totvert);
   mesh->mvert = mv;
-  for (int i = 0; i < mesh->totvert; i++, mv++) {
-    copy_v3_v3(mv->co, vert_coords[i]);
-  }
+  MeshVertCoordsData data = {
+      .mvert = mv,
+      .vert_coords = (float(*)[3])vert_coords,
+      .mat = mat,
+  };
+  mesh_vert_coords_parallel(mesh, &data, mesh_vert_coords_apply_cb);
   mesh->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
+  BKE_mesh_runtime_tag_coords_changed(mesh);
+}
+
+void BKE_mesh_vert_coords_apply(Mesh *mesh, const float (*vert_coords)[3])
+{
+  mesh_vert_coords_apply_ex(mesh, vert_coords, NULL);
 }
 
 void BKE_mesh_vert_coords_apply_with_mat4(Mesh *mesh,
                                           const float (*vert_coords)[3],
                                           const float mat[4][4])
 {
-  /* This will just return the pointer if it wasn't a referenced layer. */
-  MVert *mv = CustomData_duplicate_referenced_layer(&mesh->vdata, CD_MVERT, mesh->totvert);
-  mesh->mvert = mv;
-  for (int i = 0; i < mesh->totvert; i++, mv++) {
-    mul_v3_m4v3(mv->co, mat, vert_coords[i]);
-  }
-  mesh->runtime.cd_dirty_vert |= CD_MASK_NORMAL;
+  mesh_vert_coords_apply_ex(mesh, vert_coords, mat);
 }
 
 void BKE_mesh_vert_normals_apply(Mesh *mesh, const short (*vert_normals)[3])
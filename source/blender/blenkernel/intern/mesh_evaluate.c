@@ -383,14 +383,6 @@ void BKE_mesh_calc_normals_poly(MVert *mverts,
   MEM_freeN(lnors_weighted);
 }
 
-void BKE_mesh_ensure_normals(Mesh *mesh)
-{
-  if (mesh->runtime.cd_dirty_vert & CD_MASK_NORMAL) {
-    BKE_mesh_calc_normals(mesh);
-  }
-  BLI_assert((mesh->runtime.cd_dirty_vert & CD_MASK_NORMAL) == 0);
-}
-
 /**
  * Called after calculating all modifiers.
  */
@@ -798,11 +790,34 @@ typedef struct LoopSplitTaskDataCommon {
   int *loop_to_poly;
   const float (*polynors)[3];
 
+  /* Loops of each vertex, see #loop_split_generator(). */
+  const int *vert_loops_offset;
+  const int *vert_loops;
+  /* Per loop type, written for the loops of each vertex by a single task. */
+  char *loop_types;
+  /* Loops of #LOOP_SPLIT_SINGLE and #LOOP_SPLIT_FAN type, in increasing order. */
+  const int *entry_loops;
+  /* Lnor space of each entry loop, when computing lnor spacearr. */
+  MLoopNorSpace *lnor_spaces;
+
+  int numVerts;
   int numEdges;
   int numLoops;
   int numPolys;
 } LoopSplitTaskDataCommon;
 
+/* #LoopSplitTaskDataCommon.loop_types */
+enum {
+  /* Not visited yet. */
+  LOOP_SPLIT_UNSET = 0,
+  /* Part of a smooth fan which is computed from another loop. */
+  LOOP_SPLIT_SKIP,
+  /* Both edges are sharp, the loop just takes its poly normal. */
+  LOOP_SPLIT_SINGLE,
+  /* Entry point of a smooth fan. */
+  LOOP_SPLIT_FAN,
+};
+
 #define INDEX_UNSET INT_MIN
 #define INDEX_INVALID -1
 /* See comment about edge_to_loops below. */
@@ -1300,38 +1315,6 @@ static void loop_split_worker_do(LoopSplitTaskDataCommon *common_data,
   }
 }
 
-static void loop_split_worker(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
-{
-  LoopSplitTaskDataCommon *common_data = BLI_task_pool_userdata(pool);
-  LoopSplitTaskData *data = taskdata;
-
-  /* Temp edge vectors stack, only used when computing lnor spacearr. */
-  BLI_Stack *edge_vectors = common_data->lnors_spacearr ?
-                                BLI_stack_new(sizeof(float[3]), __func__) :
-                                NULL;
-
-#ifdef DEBUG_TIME
-  TIMEIT_START_AVERAGED(loop_split_worker);
-#endif
-
-  for (int i = 0; i < LOOP_SPLIT_TASK_BLOCK_SIZE; i++, data++) {
-    /* A NULL ml_curr is used to tag ended data! */
-    if (data->ml_curr == NULL) {
-      break;
-    }
-
-    loop_split_worker_do(common_data, data, edge_vectors);
-  }
-
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
-  }
-
-#ifdef DEBUG_TIME
-  TIMEIT_END_AVERAGED(loop_split_worker);
-#endif
-}
-
 /**
  * Check whether given loop is part of an unknown-so-far cyclic smooth fan, or not.
  * Needed because cyclic smooth fans have no obvious 'entry point',
@@ -1342,7 +1325,7 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
                                                          const int (*edge_to_loops)[2],
                                                          const int *loop_to_poly,
                                                          const int *e2l_prev,
-                                                         BLI_bitmap *skip_loops,
+                                                         char *loop_types,
                                                          const MLoop *ml_curr,
                                                          const MLoop *ml_prev,
                                                          const int ml_curr_index,
@@ -1370,8 +1353,8 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
   BLI_assert(mlfan_vert_index >= 0);
   BLI_assert(mpfan_curr_index >= 0);
 
-  BLI_assert(!BLI_BITMAP_TEST(skip_loops, mlfan_vert_index));
-  BLI_BITMAP_ENABLE(skip_loops, mlfan_vert_index);
+  BLI_assert(loop_types[mlfan_vert_index] == LOOP_SPLIT_UNSET);
+  loop_types[mlfan_vert_index] = LOOP_SPLIT_SKIP;
 
   while (true) {
     /* Find next loop of the smooth fan. */
@@ -1392,7 +1375,7 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
       return false;
     }
     /* Smooth loop/edge... */
-    else if (BLI_BITMAP_TEST(skip_loops, mlfan_vert_index)) {
+    else if (loop_types[mlfan_vert_index] != LOOP_SPLIT_UNSET) {
       if (mlfan_vert_index == ml_curr_index) {
         /* We walked around a whole cyclic smooth fan without finding any already-processed loop,
          * means we can use initial ml_curr/ml_prev edge as start for this smooth fan. */
@@ -1403,182 +1386,208 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
     }
     else {
       /* ... we can skip it in future, and keep checking the smooth fan. */
-      BLI_BITMAP_ENABLE(skip_loops, mlfan_vert_index);
+      loop_types[mlfan_vert_index] = LOOP_SPLIT_SKIP;
     }
   }
 }
 
-static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common_data)
+static void loop_split_generator_vert_cb(void *__restrict userdata,
+                                         const int v_index,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
-  float(*loopnors)[3] = common_data->loopnors;
-
+  LoopSplitTaskDataCommon *common_data = userdata;
   const MLoop *mloops = common_data->mloops;
   const MPoly *mpolys = common_data->mpolys;
   const int *loop_to_poly = common_data->loop_to_poly;
   const int(*edge_to_loops)[2] = common_data->edge_to_loops;
-  const int numLoops = common_data->numLoops;
-  const int numPolys = common_data->numPolys;
-
-  const MPoly *mp;
-  int mp_index;
+  const int *vert_loops = common_data->vert_loops;
+  char *loop_types = common_data->loop_types;
+
+  /* Fans only contain loops of their pivot vertex, so vertices can be handled in parallel.
+   * Loops are visited in increasing order (as a loop over all polygons would do),
+   * so the entry points of cyclic smooth fans don't depend on threading. */
+  for (int i = common_data->vert_loops_offset[v_index];
+       i < common_data->vert_loops_offset[v_index + 1];
+       i++) {
+    const int ml_curr_index = vert_loops[i];
+    const int mp_index = loop_to_poly[ml_curr_index];
+    const MPoly *mp = &mpolys[mp_index];
+    const int ml_prev_index = (ml_curr_index == mp->loopstart) ?
+                                  (mp->loopstart + mp->totloop) - 1 :
+                                  ml_curr_index - 1;
+    const MLoop *ml_curr = &mloops[ml_curr_index];
+    const MLoop *ml_prev = &mloops[ml_prev_index];
+    const int *e2l_curr = edge_to_loops[ml_curr->e];
+    const int *e2l_prev = edge_to_loops[ml_prev->e];
+
+    /* A smooth edge, we have to check for cyclic smooth fan case.
+     * If we find a new, never-processed cyclic smooth fan, we can do it now using that loop/edge
+     * as 'entry point', otherwise we can skip it. */
+
+    /* Note: In theory, we could make loop_split_generator_check_cyclic_smooth_fan() store
+     * mlfan_vert_index'es and edge indexes in two stacks, to avoid having to fan again around
+     * the vert during actual computation of clnor & clnorspace. However, this would complicate
+     * the code, add more memory usage, and despite its logical complexity,
+     * loop_manifold_fan_around_vert_next() is quite cheap in term of CPU cycles,
+     * so really think it's not worth it. */
+    if (!IS_EDGE_SHARP(e2l_curr) &&
+        ((loop_types[ml_curr_index] != LOOP_SPLIT_UNSET) ||
+         !loop_split_generator_check_cyclic_smooth_fan(mloops,
+                                                       mpolys,
+                                                       edge_to_loops,
+                                                       loop_to_poly,
+                                                       e2l_prev,
+                                                       loop_types,
+                                                       ml_curr,
+                                                       ml_prev,
+                                                       ml_curr_index,
+                                                       ml_prev_index,
+                                                       mp_index))) {
+      loop_types[ml_curr_index] = LOOP_SPLIT_SKIP;
+    }
+    /* We *do not need* to check/tag loops as already computed!
+     * Due to the fact a loop only links to one of its two edges,
+     * a same fan *will never be walked more than once!*
+     * Since we consider edges having neighbor polys with inverted
+     * (flipped) normals as sharp, we are sure that no fan will be skipped,
+     * even only considering the case (sharp curr_edge, smooth prev_edge),
+     * and not the alternative (smooth curr_edge, sharp prev_edge).
+     * All this due/thanks to link between normals and loop ordering (i.e. winding).
+     */
+    else if (IS_EDGE_SHARP(e2l_curr) && IS_EDGE_SHARP(e2l_prev)) {
+      loop_types[ml_curr_index] = LOOP_SPLIT_SINGLE;
+    }
+    else {
+      loop_types[ml_curr_index] = LOOP_SPLIT_FAN;
+    }
+  }
+}
 
-  const MLoop *ml_curr;
-  const MLoop *ml_prev;
-  int ml_curr_index;
-  int ml_prev_index;
+static void loop_split_worker_cb(void *__restrict userdata,
+                                 const int iter,
+                                 const TaskParallelTLS *__restrict tls)
+{
+  LoopSplitTaskDataCommon *common_data = userdata;
+  const MLoop *mloops = common_data->mloops;
+  const MPoly *mpolys = common_data->mpolys;
 
-  BLI_bitmap *skip_loops = BLI_BITMAP_NEW(numLoops, __func__);
+  const int ml_curr_index = common_data->entry_loops[iter];
+  const int mp_index = common_data->loop_to_poly[ml_curr_index];
+  const MPoly *mp = &mpolys[mp_index];
+  const int ml_prev_index = (ml_curr_index == mp->loopstart) ? (mp->loopstart + mp->totloop) - 1 :
+                                                               ml_curr_index - 1;
 
-  LoopSplitTaskData *data_buff = NULL;
-  int data_idx = 0;
+  LoopSplitTaskData data = {NULL};
+  data.ml_curr = &mloops[ml_curr_index];
+  data.ml_prev = &mloops[ml_prev_index];
+  data.ml_curr_index = ml_curr_index;
+  data.mp_index = mp_index;
+  if (common_data->lnor_spaces) {
+    data.lnor_space = &common_data->lnor_spaces[iter];
+  }
+  if (common_data->loop_types[ml_curr_index] == LOOP_SPLIT_SINGLE) {
+    data.lnor = &common_data->loopnors[ml_curr_index];
+  }
+  else {
+    data.ml_prev_index = ml_prev_index;
+    data.e2l_prev = common_data->edge_to_loops[data.ml_prev->e]; /* Also tag as 'fan' task. */
+  }
 
-  /* Temp edge vectors stack, only used when computing lnor spacearr
-   * (and we are not multi-threading). */
-  BLI_Stack *edge_vectors = NULL;
+  /* Temp edge vectors stack, only used when computing lnor spacearr. */
+  BLI_Stack **edge_vectors = tls->userdata_chunk;
+  if (common_data->lnors_spacearr && (*edge_vectors == NULL)) {
+    *edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
+  }
 
-#ifdef DEBUG_TIME
-  TIMEIT_START_AVERAGED(loop_split_generator);
-#endif
+  loop_split_worker_do(common_data, &data, *edge_vectors);
+}
 
-  if (!pool) {
-    if (lnors_spacearr) {
-      edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
-    }
+static void loop_split_worker_finalize(void *__restrict UNUSED(userdata),
+                                       void *__restrict userdata_chunk)
+{
+  BLI_Stack **edge_vectors = userdata_chunk;
+  if (*edge_vectors) {
+    BLI_stack_free(*edge_vectors);
   }
+}
 
-  /* We now know edges that can be smoothed (with their vector, and their two loops),
-   * and edges that will be hard! Now, time to generate the normals.
-   */
-  for (mp = mpolys, mp_index = 0; mp_index < numPolys; mp++, mp_index++) {
-    float(*lnors)[3];
-    const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
-    ml_curr_index = mp->loopstart;
-    ml_prev_index = ml_last_index;
-
-    ml_curr = &mloops[ml_curr_index];
-    ml_prev = &mloops[ml_prev_index];
-    lnors = &loopnors[ml_curr_index];
+static void loop_split_generator(LoopSplitTaskDataCommon *common_data)
+{
+  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
 
-    for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++, lnors++) {
-      const int *e2l_curr = edge_to_loops[ml_curr->e];
-      const int *e2l_prev = edge_to_loops[ml_prev->e];
+  const MLoop *mloops = common_data->mloops;
+  const int numVerts = common_data->numVerts;
+  const int numLoops = common_data->numLoops;
 
-#if 0
-      printf("Checking loop %d / edge %u / vert %u (sharp edge: %d, skiploop: %d)...",
-             ml_curr_index,
-             ml_curr->e,
-             ml_curr->v,
-             IS_EDGE_SHARP(e2l_curr),
-             BLI_BITMAP_TEST_BOOL(skip_loops, ml_curr_index));
+#ifdef DEBUG_TIME
+  TIMEIT_START_AVERAGED(loop_split_generator);
 #endif
 
-      /* A smooth edge, we have to check for cyclic smooth fan case.
-       * If we find a new, never-processed cyclic smooth fan, we can do it now using that loop/edge
-       * as 'entry point', otherwise we can skip it. */
-
-      /* Note: In theory, we could make loop_split_generator_check_cyclic_smooth_fan() store
-       * mlfan_vert_index'es and edge indexes in two stacks, to avoid having to fan again around
-       * the vert during actual computation of clnor & clnorspace. However, this would complicate
-       * the code, add more memory usage, and despite its logical complexity,
-       * loop_manifold_fan_around_vert_next() is quite cheap in term of CPU cycles,
-       * so really think it's not worth it. */
-      if (!IS_EDGE_SHARP(e2l_curr) && (BLI_BITMAP_TEST(skip_loops, ml_curr_index) ||
-                                       !loop_split_generator_check_cyclic_smooth_fan(mloops,
-                                                                                     mpolys,
-                                                                                     edge_to_loops,
-                                                                                     loop_to_poly,
-                                                                                     e2l_prev,
-                                                                                     skip_loops,
-                                                                                     ml_curr,
-                                                                                     ml_prev,
-                                                                                     ml_curr_index,
-                                                                                     ml_prev_index,
-                                                                                     mp_index))) {
-        //              printf("SKIPPING!\n");
-      }
-      else {
-        LoopSplitTaskData *data, data_local;
-
-        //              printf("PROCESSING!\n");
+  /* Loops of each vertex, in increasing order. */
+  int *vert_loops_offset = MEM_calloc_arrayN(
+      (size_t)numVerts + 1, sizeof(*vert_loops_offset), __func__);
+  int *vert_loops = MEM_malloc_arrayN((size_t)numLoops, sizeof(*vert_loops), __func__);
+  for (int i = 0; i < numLoops; i++) {
+    vert_loops_offset[mloops[i].v + 1]++;
+  }
+  for (int i = 0; i < numVerts; i++) {
+    vert_loops_offset[i + 1] += vert_loops_offset[i];
+  }
+  /* Fill using the start offsets as cursors, these end as the start of the next vertex. */
+  for (int i = 0; i < numLoops; i++) {
+    vert_loops[vert_loops_offset[mloops[i].v]++] = i;
+  }
+  memmove(&vert_loops_offset[1], vert_loops_offset, sizeof(*vert_loops_offset) * (size_t)numVerts);
+  vert_loops_offset[0] = 0;
 
-        if (pool) {
-          if (data_idx == 0) {
-            data_buff = MEM_calloc_arrayN(
-                LOOP_SPLIT_TASK_BLOCK_SIZE, sizeof(*data_buff), __func__);
-          }
-          data = &data_buff[data_idx];
-        }
-        else {
-          data = &data_local;
-          memset(data, 0, sizeof(*data));
-        }
+  common_data->vert_loops_offset = vert_loops_offset;
+  common_data->vert_loops = vert_loops;
+  common_data->loop_types = MEM_calloc_arrayN(
+      (size_t)numLoops, sizeof(*common_data->loop_types), __func__);
 
-        if (IS_EDGE_SHARP(e2l_curr) && IS_EDGE_SHARP(e2l_prev)) {
-          data->lnor = lnors;
-          data->ml_curr = ml_curr;
-          data->ml_prev = ml_prev;
-          data->ml_curr_index = ml_curr_index;
-#if 0 /* Not needed for 'single' loop. */
-          data->ml_prev_index = ml_prev_index;
-          data->e2l_prev = NULL; /* Tag as 'single' task. */
-#endif
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
-        }
-        /* We *do not need* to check/tag loops as already computed!
-         * Due to the fact a loop only links to one of its two edges,
-         * a same fan *will never be walked more than once!*
-         * Since we consider edges having neighbor polys with inverted
-         * (flipped) normals as sharp, we are sure that no fan will be skipped,
-         * even only considering the case (sharp curr_edge, smooth prev_edge),
-         * and not the alternative (smooth curr_edge, sharp prev_edge).
-         * All this due/thanks to link between normals and loop ordering (i.e. winding).
-         */
-        else {
-#if 0 /* Not needed for 'fan' loops. */
-          data->lnor = lnors;
-#endif
-          data->ml_curr = ml_curr;
-          data->ml_prev = ml_prev;
-          data->ml_curr_index = ml_curr_index;
-          data->ml_prev_index = ml_prev_index;
-          data->e2l_prev = e2l_prev; /* Also tag as 'fan' task. */
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
-        }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Not enough loops to be worth the whole threading overhead... */
+  settings.use_threading = (numLoops >= LOOP_SPLIT_TASK_BLOCK_SIZE * 8);
+  settings.min_iter_per_thread = LOOP_SPLIT_TASK_BLOCK_SIZE;
 
-        if (pool) {
-          data_idx++;
-          if (data_idx == LOOP_SPLIT_TASK_BLOCK_SIZE) {
-            BLI_task_pool_push(pool, loop_split_worker, data_buff, true, TASK_PRIORITY_LOW);
-            data_idx = 0;
-          }
-        }
-        else {
-          loop_split_worker_do(common_data, data, edge_vectors);
-        }
-      }
+  /* We now know edges that can be smoothed (with their vector, and their two loops),
+   * and edges that will be hard! Now find the loops starting each smooth fan... */
+  BLI_task_parallel_range(0, numVerts, common_data, loop_split_generator_vert_cb, &settings);
 
-      ml_prev = ml_curr;
-      ml_prev_index = ml_curr_index;
+  int entry_loops_len = 0;
+  for (int i = 0; i < numLoops; i++) {
+    if (ELEM(common_data->loop_types[i], LOOP_SPLIT_SINGLE, LOOP_SPLIT_FAN)) {
+      entry_loops_len++;
     }
   }
-
-  /* Last block of data... Since it is calloc'ed and we use first NULL item as stopper,
-   * everything is fine. */
-  if (pool && data_idx) {
-    BLI_task_pool_push(pool, loop_split_worker, data_buff, true, TASK_PRIORITY_LOW);
+  int *entry_loops = MEM_malloc_arrayN((size_t)entry_loops_len, sizeof(*entry_loops), __func__);
+  for (int i = 0, entry_index = 0; i < numLoops; i++) {
+    if (ELEM(common_data->loop_types[i], LOOP_SPLIT_SINGLE, LOOP_SPLIT_FAN)) {
+      entry_loops[entry_index++] = i;
+    }
   }
+  common_data->entry_loops = entry_loops;
 
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
+  /* We have to create those outside of tasks, since memarena is not threadsafe,
+   * all at once since their number is known. */
+  if (lnors_spacearr && entry_loops_len) {
+    common_data->lnor_spaces = BLI_memarena_calloc(
+        lnors_spacearr->mem, sizeof(*common_data->lnor_spaces) * (size_t)entry_loops_len);
+    lnors_spacearr->num_spaces += entry_loops_len;
   }
-  MEM_freeN(skip_loops);
+
+  /* ... and time to generate the normals. */
+  BLI_Stack *edge_vectors = NULL;
+  settings.userdata_chunk = &edge_vectors;
+  settings.userdata_chunk_size = sizeof(edge_vectors);
+  settings.func_finalize = loop_split_worker_finalize;
+  BLI_task_parallel_range(0, entry_loops_len, common_data, loop_split_worker_cb, &settings);
+
+  MEM_freeN(vert_loops_offset);
+  MEM_freeN(vert_loops);
+  MEM_freeN(entry_loops);
+  MEM_freeN(common_data->loop_types);
 
 #ifdef DEBUG_TIME
   TIMEIT_END_AVERAGED(loop_split_generator);
@@ -1591,7 +1600,7 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
  * (splitting edges).
  */
 void BKE_mesh_normals_loop_split(const MVert *mverts,
-                                 const int UNUSED(numVerts),
+                                 const int numVerts,
                                  MEdge *medges,
                                  const int numEdges,
                                  MLoop *mloops,
@@ -1691,6 +1700,7 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
       .edge_to_loops = edge_to_loops,
       .loop_to_poly = loop_to_poly,
       .polynors = polynors,
+      .numVerts = numVerts,
       .numEdges = numEdges,
       .numLoops = numLoops,
       .numPolys = numPolys,
@@ -1699,23 +1709,7 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
   /* This first loop check which edges are actually smooth, and compute edge vectors. */
   mesh_edges_sharp_tag(&common_data, check_angle, split_angle, false);
 
-  if (numLoops < LOOP_SPLIT_TASK_BLOCK_SIZE * 8) {
-    /* Not enough loops to be worth the whole threading overhead... */
-    loop_split_generator(NULL, &common_data);
-  }
-  else {
-    TaskScheduler *task_scheduler;
-    TaskPool *task_pool;
-
-    task_scheduler = BLI_task_scheduler_get();
-    task_pool = BLI_task_pool_create(task_scheduler, &common_data);
-
-    loop_split_generator(task_pool, &common_data);
-
-    BLI_task_pool_work_and_wait(task_pool);
-
-    BLI_task_pool_free(task_pool);
-  }
+  loop_split_generator(&common_data);
 
   MEM_freeN(edge_to_loops);
   if (!r_loop_to_poly) {
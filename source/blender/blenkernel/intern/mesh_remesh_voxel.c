@@ -32,6 +32,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_object_types.h"
@@ -62,10 +63,7 @@ struct OpenVDBLevelSet *BKE_mesh_remesh_voxel_ovdb_mesh_to_level_set_create(
 {
   BKE_mesh_runtime_looptri_recalc(mesh);
   const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(mesh);
-  MVertTri *verttri = MEM_callocN(sizeof(*verttri) * BKE_mesh_runtime_looptri_len(mesh),
-                                  "remesh_looptri");
-  BKE_mesh_runtime_verttri_from_looptri(
-      verttri, mesh->mloop, looptri, BKE_mesh_runtime_looptri_len(mesh));
+  const MLoop *mloop = mesh->mloop;
 
   unsigned int totfaces = BKE_mesh_runtime_looptri_len(mesh);
   unsigned int totverts = mesh->totvert;
@@ -80,11 +78,12 @@ struct OpenVDBLevelSet *BKE_mesh_remesh_voxel_ovdb_mesh_to_level_set_create(
     verts[i * 3 + 2] = mvert->co[2];
   }
 
+  /* Vertex indices of the triangles, read directly from the loops. */
   for (unsigned int i = 0; i < totfaces; i++) {
-    MVertTri *vt = &verttri[i];
-    faces[i * 3] = vt->tri[0];
-    faces[i * 3 + 1] = vt->tri[1];
-    faces[i * 3 + 2] = vt->tri[2];
+    const MLoopTri *lt = &looptri[i];
+    faces[i * 3] = mloop[lt->tri[0]].v;
+    faces[i * 3 + 1] = mloop[lt->tri[1]].v;
+    faces[i * 3 + 2] = mloop[lt->tri[2]].v;
   }
 
   struct OpenVDBLevelSet *level_set = OpenVDBLevelSet_create(false, NULL);
@@ -92,7 +91,6 @@ struct OpenVDBLevelSet *BKE_mesh_remesh_voxel_ovdb_mesh_to_level_set_create(
 
   MEM_freeN(verts);
   MEM_freeN(faces);
-  MEM_freeN(verttri);
 
   return level_set;
 }
@@ -168,10 +166,7 @@ static Mesh *BKE_mesh_remesh_quadriflow(Mesh *input_mesh,
   const MLoopTri *looptri = BKE_mesh_runtime_looptri_ensure(input_mesh);
 
   /* Gather the required data for export to the internal quadiflow mesh format */
-  MVertTri *verttri = MEM_callocN(sizeof(*verttri) * BKE_mesh_runtime_looptri_len(input_mesh),
-                                  "remesh_looptri");
-  BKE_mesh_runtime_verttri_from_looptri(
-      verttri, input_mesh->mloop, looptri, BKE_mesh_runtime_looptri_len(input_mesh));
+  const MLoop *mloop = input_mesh->mloop;
 
   unsigned int totfaces = BKE_mesh_runtime_looptri_len(input_mesh);
   unsigned int totverts = input_mesh->totvert;
@@ -186,11 +181,12 @@ static Mesh *BKE_mesh_remesh_quadriflow(Mesh *input_mesh,
     verts[i * 3 + 2] = mvert->co[2];
   }
 
+  /* Vertex indices of the triangles, read directly from the loops. */
   for (unsigned int i = 0; i < totfaces; i++) {
-    MVertTri *vt = &verttri[i];
-    faces[i * 3] = vt->tri[0];
-    faces[i * 3 + 1] = vt->tri[1];
-    faces[i * 3 + 2] = vt->tri[2];
+    const MLoopTri *lt = &looptri[i];
+    faces[i * 3] = mloop[lt->tri[0]].v;
+    faces[i * 3 + 1] = mloop[lt->tri[1]].v;
+    faces[i * 3 + 2] = mloop[lt->tri[2]].v;
   }
 
   /* Fill out the required input data */
@@ -216,7 +212,6 @@ static Mesh *BKE_mesh_remesh_quadriflow(Mesh *input_mesh,
 
   MEM_freeN(verts);
   MEM_freeN(faces);
-  MEM_freeN(verttri);
 
   if (qrd.out_faces == NULL) {
     /* The remeshing was canceled */
@@ -316,6 +311,30 @@ Mesh *BKE_mesh_remesh_voxel_to_mesh_nomain(Mesh *mesh,
   return new_mesh;
 }
 
+typedef struct ReprojectPaintMaskData {
+  BVHTreeFromMesh *bvhtree;
+  const MVert *target_verts;
+  float *target_mask;
+  const float *source_mask;
+} ReprojectPaintMaskData;
+
+static void reproject_paint_mask_cb(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReprojectPaintMaskData *data = userdata;
+  BVHTreeFromMesh *bvhtree = data->bvhtree;
+
+  BVHTreeNearest nearest;
+  nearest.index = -1;
+  nearest.dist_sq = FLT_MAX;
+  BLI_bvhtree_find_nearest(
+      bvhtree->tree, data->target_verts[i].co, &nearest, bvhtree->nearest_callback, bvhtree);
+  if (nearest.index != -1) {
+    data->target_mask[i] = data->source_mask[nearest.index];
+  }
+}
+
 void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
 {
   BVHTreeFromMesh bvhtree = {
@@ -342,17 +361,17 @@ void BKE_mesh_remesh_reproject_paint_mask(Mesh *target, Mesh *source)
         &source->vdata, CD_PAINT_MASK, CD_CALLOC, NULL, source->totvert);
   }
 
-  for (int i = 0; i < target->totvert; i++) {
-    float from_co[3];
-    BVHTreeNearest nearest;
-    nearest.index = -1;
-    nearest.dist_sq = FLT_MAX;
-    copy_v3_v3(from_co, target_verts[i].co);
-    BLI_bvhtree_find_nearest(bvhtree.tree, from_co, &nearest, bvhtree.nearest_callback, &bvhtree);
-    if (nearest.index != -1) {
-      target_mask[i] = source_mask[nearest.index];
-    }
-  }
+  ReprojectPaintMaskData data = {
+      .bvhtree = &bvhtree,
+      .target_verts = target_verts,
+      .target_mask = target_mask,
+      .source_mask = source_mask,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (target->totvert > 10000);
+  BLI_task_parallel_range(0, target->totvert, &data, reproject_paint_mask_cb, &settings);
+
   free_bvhtree_from_mesh(&bvhtree);
 }
 
@@ -43,7 +43,37 @@
 /** \name Mesh Runtime Struct Utils
  * \{ */
 
-static ThreadRWMutex loops_cache_lock = PTHREAD_RWLOCK_INITIALIZER;
+/* Used instead of the mutexes of meshes which don't have runtime data initialized,
+ * such as temporary meshes on the stack. */
+static ThreadMutex mesh_runtime_fallback_mutex = BLI_MUTEX_INITIALIZER;
+
+static void *mesh_runtime_mutex_new(const char *name)
+{
+  ThreadMutex *mutex = MEM_mallocN(sizeof(ThreadMutex), name);
+  BLI_mutex_init(mutex);
+  return mutex;
+}
+
+static void mesh_runtime_mutex_free(void **mutex)
+{
+  if (*mutex != NULL) {
+    BLI_mutex_end(*mutex);
+    MEM_freeN(*mutex);
+    *mutex = NULL;
+  }
+}
+
+static void mesh_runtime_mutexes_init(Mesh_Runtime *runtime)
+{
+  runtime->eval_mutex = mesh_runtime_mutex_new("mesh runtime eval_mutex");
+  runtime->normals_mutex = mesh_runtime_mutex_new("mesh runtime normals_mutex");
+  runtime->looptris_mutex = mesh_runtime_mutex_new("mesh runtime looptris_mutex");
+}
+
+static ThreadMutex *mesh_runtime_mutex_get(void *mutex)
+{
+  return mutex ? mutex : &mesh_runtime_fallback_mutex;
+}
 
 /**
  * Default values defined at read time.
@@ -51,8 +81,7 @@ static ThreadRWMutex loops_cache_lock = PTHREAD_RWLOCK_INITIALIZER;
 void BKE_mesh_runtime_reset(Mesh *mesh)
 {
   memset(&mesh->runtime, 0, sizeof(mesh->runtime));
-  mesh->runtime.eval_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime eval_mutex");
-  BLI_mutex_init(mesh->runtime.eval_mutex);
+  mesh_runtime_mutexes_init(&mesh->runtime);
 }
 
 /* Clear all pointers which we don't want to be shared on copying the datablock.
@@ -69,23 +98,25 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
   runtime->bvh_cache = NULL;
   runtime->shrinkwrap_data = NULL;
+  runtime->instance_mats = NULL;
+  runtime->instance_mats_len = 0;
+  runtime->is_batch_cache_deform_reused = false;
 
-  mesh->runtime.eval_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime eval_mutex");
-  BLI_mutex_init(mesh->runtime.eval_mutex);
+  mesh_runtime_mutexes_init(runtime);
 }
 
 void BKE_mesh_runtime_clear_cache(Mesh *mesh)
 {
-  if (mesh->runtime.eval_mutex != NULL) {
-    BLI_mutex_end(mesh->runtime.eval_mutex);
-    MEM_freeN(mesh->runtime.eval_mutex);
-    mesh->runtime.eval_mutex = NULL;
-  }
+  mesh_runtime_mutex_free(&mesh->runtime.eval_mutex);
+  mesh_runtime_mutex_free(&mesh->runtime.normals_mutex);
+  mesh_runtime_mutex_free(&mesh->runtime.looptris_mutex);
   if (mesh->runtime.mesh_eval != NULL) {
     mesh->runtime.mesh_eval->edit_mesh = NULL;
     BKE_id_free(NULL, mesh->runtime.mesh_eval);
     mesh->runtime.mesh_eval = NULL;
   }
+  MEM_SAFE_FREE(mesh->runtime.instance_mats);
+  mesh->runtime.instance_mats_len = 0;
   BKE_mesh_runtime_clear_geometry(mesh);
   BKE_mesh_batch_cache_free(mesh);
   BKE_mesh_runtime_clear_edit_data(mesh);
@@ -156,28 +187,46 @@ int BKE_mesh_runtime_looptri_len(const Mesh *mesh)
 /* This is a ported copy of dm_getLoopTriArray(dm). */
 const MLoopTri *BKE_mesh_runtime_looptri_ensure(Mesh *mesh)
 {
-  MLoopTri *looptri;
-
-  BLI_rw_mutex_lock(&loops_cache_lock, THREAD_LOCK_READ);
-  looptri = mesh->runtime.looptris.array;
-  BLI_rw_mutex_unlock(&loops_cache_lock);
+  /* Checked without locking first, looptris are usually computed already. */
+  MLoopTri *looptri = atomic_cas_ptr((void **)&mesh->runtime.looptris.array, NULL, NULL);
 
   if (looptri != NULL) {
     BLI_assert(BKE_mesh_runtime_looptri_len(mesh) == mesh->runtime.looptris.len);
   }
   else {
-    BLI_rw_mutex_lock(&loops_cache_lock, THREAD_LOCK_WRITE);
+    ThreadMutex *mutex = mesh_runtime_mutex_get(mesh->runtime.looptris_mutex);
+    BLI_mutex_lock(mutex);
     /* We need to ensure array is still NULL inside mutex-protected code,
      * some other thread might have already recomputed those looptris. */
     if (mesh->runtime.looptris.array == NULL) {
       BKE_mesh_runtime_looptri_recalc(mesh);
     }
     looptri = mesh->runtime.looptris.array;
-    BLI_rw_mutex_unlock(&loops_cache_lock);
+    BLI_mutex_unlock(mutex);
   }
   return looptri;
 }
 
+/**
+ * Compute the vertex normals when they're tagged as dirty (#CD_MASK_NORMAL of
+ * #Mesh_Runtime.cd_dirty_vert), this is safe to call for the same mesh from multiple threads.
+ */
+void BKE_mesh_ensure_normals(Mesh *mesh)
+{
+  /* Checked without locking first (adding zero only reads the flags with a memory barrier),
+   * so threads using up to date normals don't wait for each other. */
+  if (atomic_add_and_fetch_int64(&mesh->runtime.cd_dirty_vert, 0) & CD_MASK_NORMAL) {
+    ThreadMutex *mutex = mesh_runtime_mutex_get(mesh->runtime.normals_mutex);
+    BLI_mutex_lock(mutex);
+    /* Some other thread might have computed the normals meanwhile. */
+    if (mesh->runtime.cd_dirty_vert & CD_MASK_NORMAL) {
+      BKE_mesh_calc_normals(mesh);
+    }
+    BLI_mutex_unlock(mutex);
+  }
+  BLI_assert((mesh->runtime.cd_dirty_vert & CD_MASK_NORMAL) == 0);
+}
+
 /* This is a copy of DM_verttri_from_looptri(). */
 void BKE_mesh_runtime_verttri_from_looptri(MVertTri *r_verttri,
                                            const MLoop *mloop,
@@ -237,6 +286,16 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   BKE_shrinkwrap_discard_boundary_data(mesh);
 }
 
+/**
+ * Call after changing the vertex positions of \a mesh, when its topology stays the same.
+ * Cached BVH trees are refitted on their next use instead of being built again.
+ */
+void BKE_mesh_runtime_tag_coords_changed(Mesh *mesh)
+{
+  bvhcache_tag_coords_changed(&mesh->runtime.bvh_cache);
+  BKE_shrinkwrap_discard_boundary_data(mesh);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -946,7 +946,8 @@ void modifier_path_init(char *path, int path_maxlen, const char *name)
   BLI_join_dirfile(path, path_maxlen, G.relbase_valid ? "//" : BKE_tempdir_session(), name);
 }
 
-/* wrapper around ModifierTypeInfo.applyModifier that ensures valid normals */
+/* wrapper around ModifierTypeInfo.applyModifier that ensures valid normals,
+ * these are only computed when tagged as dirty (e.g. after deforming the vertices). */
 
 struct Mesh *modwrap_applyModifier(ModifierData *md,
                                    const ModifierEvalContext *ctx,
@@ -956,7 +957,7 @@ struct Mesh *modwrap_applyModifier(ModifierData *md,
   BLI_assert(CustomData_has_layer(&me->pdata, CD_NORMAL) == false);
 
   if (mti->dependsOnNormals && mti->dependsOnNormals(md)) {
-    BKE_mesh_calc_normals(me);
+    BKE_mesh_ensure_normals(me);
   }
   return mti->applyModifier(md, ctx, me);
 }
@@ -971,7 +972,7 @@ void modwrap_deformVerts(ModifierData *md,
   BLI_assert(!me || CustomData_has_layer(&me->pdata, CD_NORMAL) == false);
 
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
-    BKE_mesh_calc_normals(me);
+    BKE_mesh_ensure_normals(me);
   }
   mti->deformVerts(md, ctx, me, vertexCos, numVerts);
 }
@@ -987,7 +988,7 @@ void modwrap_deformVertsEM(ModifierData *md,
   BLI_assert(!me || CustomData_has_layer(&me->pdata, CD_NORMAL) == false);
 
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
-    BKE_mesh_calc_normals(me);
+    BKE_mesh_ensure_normals(me);
   }
   mti->deformVertsEM(md, ctx, em, me, vertexCos, numVerts);
 }
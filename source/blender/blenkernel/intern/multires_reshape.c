@@ -311,38 +311,48 @@ static void multires_reshape_init_level_key(CCGKey *key,
   key->grid_bytes = key->elem_size * key->grid_area;
 }
 
-static void multires_reshape_store_original_grids(MultiresPropagateData *data)
+static void multires_reshape_store_original_grids_task(
+    void *__restrict userdata,
+    const int grid_index,
+    const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  const int num_grids = data->num_grids;
+  MultiresPropagateData *data = userdata;
   /* Original data to be backed up. */
   const MDisps *mdisps = data->mdisps;
   const GridPaintMask *grid_paint_mask = data->grid_paint_mask;
-  /* Allocate grids for backup. */
   CCGKey *orig_key = &data->reshape_level_key;
-  CCGElem **orig_grids_data = allocate_grids(orig_key, num_grids);
-  /* Fill in grids. */
   const int orig_grid_size = data->reshape_grid_size;
   const int top_grid_size = data->top_grid_size;
   const int skip = (top_grid_size - 1) / (orig_grid_size - 1);
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    CCGElem *orig_grid = orig_grids_data[grid_index];
-    for (int y = 0; y < orig_grid_size; y++) {
-      const int top_y = y * skip;
-      for (int x = 0; x < orig_grid_size; x++) {
-        const int top_x = x * skip;
-        const int top_index = top_y * top_grid_size + top_x;
-        memcpy(CCG_grid_elem_co(orig_key, orig_grid, x, y),
-               mdisps[grid_index].disps[top_index],
-               sizeof(float) * 3);
-        if (orig_key->has_mask) {
-          *CCG_grid_elem_mask(
-              orig_key, orig_grid, x, y) = grid_paint_mask[grid_index].data[top_index];
-        }
+  CCGElem *orig_grid = data->orig_grids_data[grid_index];
+  for (int y = 0; y < orig_grid_size; y++) {
+    const int top_y = y * skip;
+    for (int x = 0; x < orig_grid_size; x++) {
+      const int top_x = x * skip;
+      const int top_index = top_y * top_grid_size + top_x;
+      memcpy(CCG_grid_elem_co(orig_key, orig_grid, x, y),
+             mdisps[grid_index].disps[top_index],
+             sizeof(float) * 3);
+      if (orig_key->has_mask) {
+        *CCG_grid_elem_mask(
+            orig_key, orig_grid, x, y) = grid_paint_mask[grid_index].data[top_index];
       }
     }
   }
-  /* Store in the context. */
-  data->orig_grids_data = orig_grids_data;
+}
+
+static void multires_reshape_store_original_grids(MultiresPropagateData *data)
+{
+  /* Allocate grids for backup. */
+  data->orig_grids_data = allocate_grids(&data->reshape_level_key, data->num_grids);
+  /* Fill in grids. */
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  BLI_task_parallel_range(0,
+                          data->num_grids,
+                          data,
+                          multires_reshape_store_original_grids_task,
+                          &parallel_range_settings);
 }
 
 static void multires_reshape_propagate_prepare(MultiresPropagateData *data,
@@ -389,9 +399,9 @@ static void multires_reshape_propagate_prepare_from_mmd(MultiresPropagateData *d
  * grids at top level (meaning, the result grids are only partially filled
  * in). */
 static void multires_reshape_calculate_delta(MultiresPropagateData *data,
-                                             CCGElem **delta_grids_data)
+                                             CCGElem *delta_grid,
+                                             const int grid_index)
 {
-  const int num_grids = data->num_grids;
   /* At this point those custom data layers has updated data for the
    * level we are propagating from. */
   const MDisps *mdisps = data->mdisps;
@@ -403,23 +413,20 @@ static void multires_reshape_calculate_delta(MultiresPropagateData *data,
   const int reshape_grid_size = data->reshape_grid_size;
   const int delta_grid_size = data->top_grid_size;
   const int skip = (top_grid_size - 1) / (reshape_grid_size - 1);
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    /*const*/ CCGElem *orig_grid = data->orig_grids_data[grid_index];
-    CCGElem *delta_grid = delta_grids_data[grid_index];
-    for (int y = 0; y < reshape_grid_size; y++) {
-      const int top_y = y * skip;
-      for (int x = 0; x < reshape_grid_size; x++) {
-        const int top_x = x * skip;
-        const int top_index = top_y * delta_grid_size + top_x;
-        sub_v3_v3v3(CCG_grid_elem_co(delta_level_key, delta_grid, top_x, top_y),
-                    mdisps[grid_index].disps[top_index],
-                    CCG_grid_elem_co(reshape_key, orig_grid, x, y));
-        if (delta_level_key->has_mask) {
-          const float old_mask_value = *CCG_grid_elem_mask(reshape_key, orig_grid, x, y);
-          const float new_mask_value = grid_paint_mask[grid_index].data[top_index];
-          *CCG_grid_elem_mask(delta_level_key, delta_grid, top_x, top_y) = new_mask_value -
-                                                                           old_mask_value;
-        }
+  /*const*/ CCGElem *orig_grid = data->orig_grids_data[grid_index];
+  for (int y = 0; y < reshape_grid_size; y++) {
+    const int top_y = y * skip;
+    for (int x = 0; x < reshape_grid_size; x++) {
+      const int top_x = x * skip;
+      const int top_index = top_y * delta_grid_size + top_x;
+      sub_v3_v3v3(CCG_grid_elem_co(delta_level_key, delta_grid, top_x, top_y),
+                  mdisps[grid_index].disps[top_index],
+                  CCG_grid_elem_co(reshape_key, orig_grid, x, y));
+      if (delta_level_key->has_mask) {
+        const float old_mask_value = *CCG_grid_elem_mask(reshape_key, orig_grid, x, y);
+        const float new_mask_value = grid_paint_mask[grid_index].data[top_index];
+        *CCG_grid_elem_mask(delta_level_key, delta_grid, top_x, top_y) = new_mask_value -
+                                                                         old_mask_value;
       }
     }
   }
@@ -524,81 +531,87 @@ BLI_INLINE void multires_reshape_propagate_and_smooth_delta_grid(MultiresPropaga
   }
 }
 
-/* Entry point to propagate+smooth. */
-static void multires_reshape_propagate_and_smooth_delta(MultiresPropagateData *data,
-                                                        CCGElem **delta_grids_data)
-{
-  const int num_grids = data->num_grids;
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    CCGElem *delta_grid = delta_grids_data[grid_index];
-    multires_reshape_propagate_and_smooth_delta_grid(data, delta_grid);
-  }
-}
-
 /* Apply smoothed deltas on the actual data layers. */
 static void multires_reshape_propagate_apply_delta(MultiresPropagateData *data,
-                                                   CCGElem **delta_grids_data)
+                                                   CCGElem *delta_grid,
+                                                   const int grid_index)
 {
-  const int num_grids = data->num_grids;
   /* At this point those custom data layers has updated data for the
    * level we are propagating from. */
   MDisps *mdisps = data->mdisps;
   GridPaintMask *grid_paint_mask = data->grid_paint_mask;
   CCGKey *orig_key = &data->reshape_level_key;
   CCGKey *delta_level_key = &data->top_level_key;
-  CCGElem **orig_grids_data = data->orig_grids_data;
+  CCGElem *orig_grid = data->orig_grids_data[grid_index];
   const int orig_grid_size = data->reshape_grid_size;
   const int top_grid_size = data->top_grid_size;
   const int skip = (top_grid_size - 1) / (orig_grid_size - 1);
   /* Restore grid values at the reshape level. Those values are to be changed
    * to the accommodate for the smooth delta. */
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    CCGElem *orig_grid = orig_grids_data[grid_index];
-    for (int y = 0; y < orig_grid_size; y++) {
-      const int top_y = y * skip;
-      for (int x = 0; x < orig_grid_size; x++) {
-        const int top_x = x * skip;
-        const int top_index = top_y * top_grid_size + top_x;
-        copy_v3_v3(mdisps[grid_index].disps[top_index],
-                   CCG_grid_elem_co(orig_key, orig_grid, x, y));
-        if (grid_paint_mask != NULL) {
-          grid_paint_mask[grid_index].data[top_index] = *CCG_grid_elem_mask(
-              orig_key, orig_grid, x, y);
-        }
+  for (int y = 0; y < orig_grid_size; y++) {
+    const int top_y = y * skip;
+    for (int x = 0; x < orig_grid_size; x++) {
+      const int top_x = x * skip;
+      const int top_index = top_y * top_grid_size + top_x;
+      copy_v3_v3(mdisps[grid_index].disps[top_index],
+                 CCG_grid_elem_co(orig_key, orig_grid, x, y));
+      if (grid_paint_mask != NULL) {
+        grid_paint_mask[grid_index].data[top_index] = *CCG_grid_elem_mask(
+            orig_key, orig_grid, x, y);
       }
     }
   }
   /* Add smoothed delta to all the levels. */
-  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
-    CCGElem *delta_grid = delta_grids_data[grid_index];
-    for (int y = 0; y < top_grid_size; y++) {
-      for (int x = 0; x < top_grid_size; x++) {
-        const int top_index = y * top_grid_size + x;
-        add_v3_v3(mdisps[grid_index].disps[top_index],
-                  CCG_grid_elem_co(delta_level_key, delta_grid, x, y));
-        if (delta_level_key->has_mask) {
-          grid_paint_mask[grid_index].data[top_index] += *CCG_grid_elem_mask(
-              delta_level_key, delta_grid, x, y);
-        }
+  for (int y = 0; y < top_grid_size; y++) {
+    for (int x = 0; x < top_grid_size; x++) {
+      const int top_index = y * top_grid_size + x;
+      add_v3_v3(mdisps[grid_index].disps[top_index],
+                CCG_grid_elem_co(delta_level_key, delta_grid, x, y));
+      if (delta_level_key->has_mask) {
+        grid_paint_mask[grid_index].data[top_index] += *CCG_grid_elem_mask(
+            delta_level_key, delta_grid, x, y);
       }
     }
   }
 }
 
+typedef struct MultiresPropagateTaskData {
+  MultiresPropagateData *data;
+  CCGElem **delta_grids_data;
+} MultiresPropagateTaskData;
+
+/* Grids are independent from each other, so the whole propagation happens per grid. */
+static void multires_reshape_propagate_task(void *__restrict userdata,
+                                            const int grid_index,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MultiresPropagateTaskData *task_data = userdata;
+  MultiresPropagateData *data = task_data->data;
+  CCGElem *delta_grid = task_data->delta_grids_data[grid_index];
+  /* Calculate delta made at the reshape level. */
+  multires_reshape_calculate_delta(data, delta_grid, grid_index);
+  /* Propagate deltas to the higher levels. */
+  multires_reshape_propagate_and_smooth_delta_grid(data, delta_grid);
+  /* Finally, apply smoothed deltas. */
+  multires_reshape_propagate_apply_delta(data, delta_grid, grid_index);
+}
+
 static void multires_reshape_propagate(MultiresPropagateData *data)
 {
   if (data->reshape_level == data->top_level) {
     return;
   }
   const int num_grids = data->num_grids;
-  /* Calculate delta made at the reshape level. */
   CCGKey *delta_level_key = &data->top_level_key;
   CCGElem **delta_grids_data = allocate_grids(delta_level_key, num_grids);
-  multires_reshape_calculate_delta(data, delta_grids_data);
-  /* Propagate deltas to the higher levels. */
-  multires_reshape_propagate_and_smooth_delta(data, delta_grids_data);
-  /* Finally, apply smoothed deltas. */
-  multires_reshape_propagate_apply_delta(data, delta_grids_data);
+  MultiresPropagateTaskData task_data = {
+      .data = data,
+      .delta_grids_data = delta_grids_data,
+  };
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  BLI_task_parallel_range(
+      0, num_grids, &task_data, multires_reshape_propagate_task, &parallel_range_settings);
   /* Cleanup. */
   free_grids(delta_grids_data, num_grids);
 }
@@ -739,6 +739,11 @@ int BKE_object_visibility(const Object *ob, const int dag_eval_mode)
     }
   }
 
+  /* Instances of the object's own mesh never hide it. */
+  if (BKE_object_has_mesh_instances(ob)) {
+    visibility |= OB_VISIBLE_INSTANCES;
+  }
+
   return visibility;
 }
 
@@ -28,6 +28,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_memarena.h"
 #include "BLI_string_utf8.h"
 
 #include "BLI_math.h"
@@ -83,6 +84,7 @@ typedef struct DupliContext {
 
   /** Result containers. */
   ListBase *duplilist; /* legacy doubly-linked list */
+  MemArena *arena;     /* the DupliObjects of the list are allocated from it */
 } DupliContext;
 
 typedef struct DupliGenerator {
@@ -117,6 +119,7 @@ static void init_context(DupliContext *r_ctx,
   r_ctx->gen = get_dupli_generator(r_ctx);
 
   r_ctx->duplilist = NULL;
+  r_ctx->arena = NULL;
 }
 
 /* create sub-context for recursive duplis */
@@ -151,7 +154,7 @@ static DupliObject *make_dupli(const DupliContext *ctx, Object *ob, float mat[4]
 
   /* add a DupliObject instance to the result container */
   if (ctx->duplilist) {
-    dob = MEM_callocN(sizeof(DupliObject), "dupli object");
+    dob = BLI_memarena_calloc(ctx->arena, sizeof(DupliObject));
     BLI_addtail(ctx->duplilist, dob);
   }
   else {
@@ -1078,6 +1081,36 @@ static const DupliGenerator gen_dupli_particles = {
     make_duplis_particles /* make_duplis */
 };
 
+/* OB_DUPLIMESH_INSTANCES */
+
+/* Instances of the evaluated mesh its self, see #Mesh_Runtime.instance_mats. */
+bool BKE_object_has_mesh_instances(const Object *ob)
+{
+  if (ob->type != OB_MESH) {
+    return false;
+  }
+  const Mesh *me_eval = ob->runtime.mesh_eval;
+  return (me_eval != NULL) && (me_eval->runtime.instance_mats_len != 0);
+}
+
+static void make_duplis_mesh_instances(const DupliContext *ctx)
+{
+  Object *ob = ctx->object;
+  const Mesh *me_eval = ob->runtime.mesh_eval;
+  float mat[4][4];
+
+  /* No recursion, the instances are of the object its self. */
+  for (int i = 0; i < me_eval->runtime.instance_mats_len; i++) {
+    mul_m4_m4m4(mat, ob->obmat, me_eval->runtime.instance_mats[i]);
+    make_dupli(ctx, ob, mat, i);
+  }
+}
+
+static const DupliGenerator gen_dupli_mesh_instances = {
+    OB_DUPLIMESH_INSTANCES,    /* type */
+    make_duplis_mesh_instances /* make_duplis */
+};
+
 /* ------------- */
 
 /* select dupli generator from given context */
@@ -1086,7 +1119,7 @@ static const DupliGenerator *get_dupli_generator(const DupliContext *ctx)
   int transflag = ctx->object->transflag;
   int restrictflag = ctx->object->restrictflag;
 
-  if ((transflag & OB_DUPLI) == 0) {
+  if ((transflag & OB_DUPLI) == 0 && !BKE_object_has_mesh_instances(ctx->object)) {
     return NULL;
   }
 
@@ -1115,28 +1148,43 @@ static const DupliGenerator *get_dupli_generator(const DupliContext *ctx)
   else if (transflag & OB_DUPLICOLLECTION) {
     return &gen_dupli_collection;
   }
+  else if (BKE_object_has_mesh_instances(ctx->object)) {
+    return &gen_dupli_mesh_instances;
+  }
 
   return NULL;
 }
 
 /* ---- ListBase dupli container implementation ---- */
 
+/* Instancers can generate millions of duplis, they are allocated in blocks instead of one by one.
+ * The arena is stored along with the list returned to the callers. */
+typedef struct DupliList {
+  ListBase list; /* must be first */
+  MemArena *arena;
+} DupliList;
+
 /* Returns a list of DupliObject */
 ListBase *object_duplilist(Depsgraph *depsgraph, Scene *sce, Object *ob)
 {
-  ListBase *duplilist = MEM_callocN(sizeof(ListBase), "duplilist");
+  DupliList *duplilist = MEM_callocN(sizeof(DupliList), "duplilist");
   DupliContext ctx;
   init_context(&ctx, depsgraph, sce, ob, NULL);
   if (ctx.gen) {
-    ctx.duplilist = duplilist;
+    duplilist->arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+    ctx.duplilist = &duplilist->list;
+    ctx.arena = duplilist->arena;
     ctx.gen->make_duplis(&ctx);
   }
 
-  return duplilist;
+  return &duplilist->list;
 }
 
 void free_object_duplilist(ListBase *lb)
 {
-  BLI_freelistN(lb);
-  MEM_freeN(lb);
+  DupliList *duplilist = (DupliList *)lb;
+  if (duplilist->arena) {
+    BLI_memarena_free(duplilist->arena);
+  }
+  MEM_freeN(duplilist);
 }
@@ -328,9 +328,25 @@ void BKE_object_eval_uber_transform(Depsgraph *depsgraph, Object *object)
 void BKE_object_batch_cache_dirty_tag(Object *ob)
 {
   switch (ob->type) {
-    case OB_MESH:
-      BKE_mesh_batch_cache_dirty_tag(ob->data, BKE_MESH_BATCH_DIRTY_ALL);
+    case OB_MESH: {
+      Mesh *mesh = ob->data;
+      BMEditMesh *em = mesh->edit_mesh;
+      if (mesh->runtime.is_batch_cache_deform_reused) {
+        mesh->runtime.is_batch_cache_deform_reused = false;
+        BKE_mesh_batch_cache_dirty_tag(mesh, BKE_MESH_BATCH_DIRTY_DEFORM);
+      }
+      else if (em && em->is_deform_only_update) {
+        em->is_deform_only_update = false;
+        /* Modifiers may change the topology when coordinates change. */
+        const bool is_original = em->mesh_eval_final && em->mesh_eval_final->runtime.is_original;
+        BKE_mesh_batch_cache_dirty_tag(
+            mesh, is_original ? BKE_MESH_BATCH_DIRTY_DEFORM : BKE_MESH_BATCH_DIRTY_ALL);
+      }
+      else {
+        BKE_mesh_batch_cache_dirty_tag(mesh, BKE_MESH_BATCH_DIRTY_ALL);
+      }
       break;
+    }
     case OB_LATTICE:
       BKE_lattice_batch_cache_dirty_tag(ob->data, BKE_LATTICE_BATCH_DIRTY_ALL);
       break;
@@ -825,8 +825,18 @@ static void set_height_normalize_factor(struct Ocean *oc)
 
   oc->normalize_factor = 1.0;
 
+  /* Only the height field is needed to find the factor, skip the other transforms. */
+  const short do_chop = oc->_do_chop;
+  const short do_normals = oc->_do_normals;
+  const short do_jacobian = oc->_do_jacobian;
+  oc->_do_chop = oc->_do_normals = oc->_do_jacobian = false;
+
   BKE_ocean_simulate(oc, 0.0, 1.0, 0);
 
+  oc->_do_chop = do_chop;
+  oc->_do_normals = do_normals;
+  oc->_do_jacobian = do_jacobian;
+
   BLI_rw_mutex_lock(&oc->oceanmutex, THREAD_LOCK_READ);
 
   for (i = 0; i < oc->_M; i++) {
@@ -3803,6 +3803,61 @@ static void dynamics_step_sph_classical_integrate_task_cb_ex(void *__restrict us
   }
 }
 
+static void dynamics_step_newton_task_cb_ex(void *__restrict userdata,
+                                            const int p,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DynamicStepSolverTaskData *data = userdata;
+  ParticleSimulationData *sim = data->sim;
+  ParticleSystem *psys = sim->psys;
+  ParticleSettings *part = psys->part;
+
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra);
+
+  /* deflection */
+  if (sim->colliders) {
+    collision_check(sim, p, pa->state.time, data->cfra);
+  }
+
+  /* rotations */
+  basic_rotate(part, pa, pa->state.time, data->timestep);
+}
+
+/* Random numbers of brownian forces, noisy effectors and collisions are drawn from streams
+ * shared by all particles, the results would depend on the order particles are evaluated in. */
+static bool dynamics_step_uses_random(ParticleSimulationData *sim)
+{
+  if (sim->psys->part->brownfac != 0.0f) {
+    return true;
+  }
+
+  if (sim->psys->effectors) {
+    for (EffectorCache *eff = sim->psys->effectors->first; eff; eff = eff->next) {
+      if (eff->pd && eff->pd->f_noise != 0.0f) {
+        return true;
+      }
+    }
+  }
+
+  if (sim->colliders) {
+    for (ColliderCache *coll = sim->colliders->first; coll; coll = coll->next) {
+      const PartDeflect *pd = coll->ob->pd;
+      if (pd && (pd->pdef_perm != 0.0f || pd->pdef_rdamp != 0.0f || pd->pdef_rfrict != 0.0f)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 /* unbaked particles are calculated dynamically */
 static void dynamics_step(ParticleSimulationData *sim, float cfra)
 {
@@ -3931,19 +3986,18 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
-      LOOP_DYNAMIC_PARTICLES
-      {
-        /* do global forces & effectors */
-        basic_integrate(sim, p, pa->state.time, cfra);
-
-        /* deflection */
-        if (sim->colliders) {
-          collision_check(sim, p, pa->state.time, cfra);
-        }
+      DynamicStepSolverTaskData task_data = {
+          .sim = sim,
+          .cfra = cfra,
+          .timestep = timestep,
+          .dtime = dtime,
+      };
 
-        /* rotations */
-        basic_rotate(part, pa, pa->state.time, timestep);
-      }
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = (psys->totpart > 100) && !dynamics_step_uses_random(sim);
+      BLI_task_parallel_range(
+          0, psys->totpart, &task_data, dynamics_step_newton_task_cb_ex, &settings);
       break;
     }
     case PART_PHYS_BOIDS: {
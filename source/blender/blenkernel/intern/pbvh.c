@@ -25,6 +25,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_math.h"
 #include "BLI_ghash.h"
+#include "BLI_sort_utils.h"
 #include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
@@ -285,6 +286,11 @@ static void build_mesh_leaf_node(PBVH *bvh, PBVHNode *node)
   node->uniq_verts = node->face_verts = 0;
   const int totface = node->totprim;
 
+  /* Brushes and drawing loop over the primitives and vertices of the node, sorting them keeps
+   * their accesses to the mesh arrays in memory order instead of the order of the partition and
+   * the hash. */
+  qsort(node->prim_indices, totface, sizeof(int), BLI_sortutil_cmp_int);
+
   /* reserve size is rough guess */
   GHash *map = BLI_ghash_int_new_ex("build_mesh_leaf_node gh", 2 * totface);
 
@@ -295,8 +301,7 @@ static void build_mesh_leaf_node(PBVH *bvh, PBVHNode *node)
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &bvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      face_vert_indices[i][j] = map_insert_vert(
-          bvh, map, &node->face_verts, &node->uniq_verts, bvh->mloop[lt->tri[j]].v);
+      map_insert_vert(bvh, map, &node->face_verts, &node->uniq_verts, bvh->mloop[lt->tri[j]].v);
     }
 
     if (!paint_is_face_hidden(lt, bvh->verts, bvh->mloop)) {
@@ -321,13 +326,20 @@ static void build_mesh_leaf_node(PBVH *bvh, PBVHNode *node)
     vert_indices[ndx] = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
   }
 
-  for (int i = 0; i < totface; i++) {
-    const int sides = 3;
+  /* Sort unique and shared verts separately, unique verts have to stay first. */
+  qsort(vert_indices, node->uniq_verts, sizeof(int), BLI_sortutil_cmp_int);
+  qsort(vert_indices + node->uniq_verts, node->face_verts, sizeof(int), BLI_sortutil_cmp_int);
 
-    for (int j = 0; j < sides; j++) {
-      if (face_vert_indices[i][j] < 0) {
-        face_vert_indices[i][j] = -face_vert_indices[i][j] + node->uniq_verts - 1;
-      }
+  for (int i = 0; i < node->uniq_verts + node->face_verts; i++) {
+    void **value_p = BLI_ghash_lookup_p(map, POINTER_FROM_INT(vert_indices[i]));
+    *value_p = POINTER_FROM_INT(i);
+  }
+
+  for (int i = 0; i < totface; i++) {
+    const MLoopTri *lt = &bvh->looptri[node->prim_indices[i]];
+    for (int j = 0; j < 3; j++) {
+      face_vert_indices[i][j] = POINTER_AS_INT(
+          BLI_ghash_lookup(map, POINTER_FROM_INT(bvh->mloop[lt->tri[j]].v)));
     }
   }
 
@@ -1895,6 +1907,32 @@ bool ray_face_nearest_tri(const float ray_start[3],
   }
 }
 
+static void pbvh_faces_node_raycast_hit(const MLoop *mloop,
+                                        const MLoopTri *lt,
+                                        const float *co[3],
+                                        const float ray_start[3],
+                                        const float ray_normal[3],
+                                        const float depth,
+                                        float nearest_vertex_co[3],
+                                        int *r_active_vertex_index,
+                                        float *r_face_normal)
+{
+  if (r_face_normal) {
+    normal_tri_v3(r_face_normal, co[0], co[1], co[2]);
+  }
+
+  if (r_active_vertex_index) {
+    float location[3] = {0.0f};
+    madd_v3_v3v3fl(location, ray_start, ray_normal, depth);
+    for (int j = 0; j < 3; j++) {
+      if (len_squared_v3v3(location, co[j]) < len_squared_v3v3(location, nearest_vertex_co)) {
+        copy_v3_v3(nearest_vertex_co, co[j]);
+        *r_active_vertex_index = mloop[lt->tri[j]].v;
+      }
+    }
+  }
+}
+
 static bool pbvh_faces_node_raycast(PBVH *bvh,
                                     const PBVHNode *node,
                                     float (*origco)[3],
@@ -1912,46 +1950,69 @@ static bool pbvh_faces_node_raycast(PBVH *bvh,
   bool hit = false;
   float nearest_vertex_co[3] = {0.0f};
 
-  for (int i = 0; i < totface; i++) {
-    const MLoopTri *lt = &bvh->looptri[faces[i]];
-    const int *face_verts = node->face_vert_indices[i];
+  /* The visible triangles are intersected four at a time, the hits are then handled in the
+   * same order as when intersecting them one by one. */
+  const MLoopTri *batch_lt[4];
+  const float *batch_co[3][4];
+  int batch_len = 0;
 
-    if (paint_is_face_hidden(lt, vert, mloop)) {
-      continue;
-    }
+  for (int i = 0; i <= totface; i++) {
+    if (i < totface) {
+      const MLoopTri *lt = &bvh->looptri[faces[i]];
+      const int *face_verts = node->face_vert_indices[i];
 
-    const float *co[3];
-    if (origco) {
-      /* intersect with backuped original coordinates */
-      co[0] = origco[face_verts[0]];
-      co[1] = origco[face_verts[1]];
-      co[2] = origco[face_verts[2]];
-    }
-    else {
-      /* intersect with current coordinates */
-      co[0] = vert[mloop[lt->tri[0]].v].co;
-      co[1] = vert[mloop[lt->tri[1]].v].co;
-      co[2] = vert[mloop[lt->tri[2]].v].co;
-    }
+      if (paint_is_face_hidden(lt, vert, mloop)) {
+        continue;
+      }
 
-    if (ray_face_intersection_tri(ray_start, isect_precalc, co[0], co[1], co[2], depth)) {
-      hit = true;
+      for (int j = 0; j < 3; j++) {
+        /* Intersect with backuped original coordinates or with current coordinates. */
+        batch_co[j][batch_len] = origco ? origco[face_verts[j]] : vert[mloop[lt->tri[j]].v].co;
+      }
+      batch_lt[batch_len++] = lt;
 
-      if (r_face_normal) {
-        normal_tri_v3(r_face_normal, co[0], co[1], co[2]);
+      if (batch_len < 4) {
+        continue;
       }
+    }
 
-      if (r_active_vertex_index) {
-        float location[3] = {0.0f};
-        madd_v3_v3v3fl(location, ray_start, ray_normal, *depth);
-        for (int j = 0; j < 3; j++) {
-          if (len_squared_v3v3(location, co[j]) < len_squared_v3v3(location, nearest_vertex_co)) {
-            copy_v3_v3(nearest_vertex_co, co[j]);
-            *r_active_vertex_index = mloop[lt->tri[j]].v;
-          }
+    float lambda[4];
+    int hits = 0;
+    if (batch_len == 4) {
+      hits = isect_ray_tri_watertight_v3_x4(
+          ray_start, isect_precalc, batch_co[0], batch_co[1], batch_co[2], lambda);
+    }
+    else {
+      for (int j = 0; j < batch_len; j++) {
+        if (isect_ray_tri_watertight_v3(ray_start,
+                                        isect_precalc,
+                                        batch_co[0][j],
+                                        batch_co[1][j],
+                                        batch_co[2][j],
+                                        &lambda[j],
+                                        NULL)) {
+          hits |= (1 << j);
         }
       }
     }
+
+    for (int j = 0; j < batch_len; j++) {
+      if ((hits & (1 << j)) && (lambda[j] < *depth)) {
+        const float *co[3] = {batch_co[0][j], batch_co[1][j], batch_co[2][j]};
+        hit = true;
+        *depth = lambda[j];
+        pbvh_faces_node_raycast_hit(mloop,
+                                    batch_lt[j],
+                                    co,
+                                    ray_start,
+                                    ray_normal,
+                                    *depth,
+                                    nearest_vertex_co,
+                                    r_active_vertex_index,
+                                    r_face_normal);
+      }
+    }
+    batch_len = 0;
   }
 
   return hit;
@@ -80,6 +80,7 @@ struct PBVHTask {
     TaskParallelTLS tls;
     tls.thread_id = get_thread_id();
     tls.userdata_chunk = userdata_chunk;
+    tls.scratch = NULL;
     for (int i = r.begin(); i != r.end(); ++i) {
       func(userdata, i, &tls);
     }
@@ -142,6 +143,7 @@ void BKE_pbvh_parallel_range(const int start,
   TaskParallelTLS tls;
   tls.thread_id = 0;
   tls.userdata_chunk = settings->userdata_chunk;
+  tls.scratch = NULL;
   for (int i = start; i < stop; i++) {
     func(userdata, i, &tls);
   }
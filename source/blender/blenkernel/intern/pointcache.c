@@ -146,6 +146,7 @@ static int ptcache_file_compressed_write(
     PTCacheFile *pf, unsigned char *in, unsigned int in_len, unsigned char *out, int mode);
 static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot, unsigned int size);
 static int ptcache_file_read(PTCacheFile *pf, void *f, unsigned int tot, unsigned int size);
+static void ptcache_file_seek(PTCacheFile *pf, long offset, int whence);
 
 /* Common functions */
 static int ptcache_basic_header_read(PTCacheFile *pf)
@@ -153,11 +154,11 @@ static int ptcache_basic_header_read(PTCacheFile *pf)
   int error = 0;
 
   /* Custom functions should read these basic elements too! */
-  if (!error && !fread(&pf->totpoint, sizeof(unsigned int), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &pf->totpoint, 1, sizeof(unsigned int))) {
     error = 1;
   }
 
-  if (!error && !fread(&pf->data_types, sizeof(unsigned int), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &pf->data_types, 1, sizeof(unsigned int))) {
     error = 1;
   }
 
@@ -847,7 +848,7 @@ static int ptcache_smoke_read(PTCacheFile *pf, void *smoke_v)
   ptcache_file_read(pf, version, 4, sizeof(char));
   if (!STREQLEN(version, SMOKE_CACHE_VERSION, 4)) {
     /* reset file pointer */
-    fseek(pf->fp, -4, SEEK_CUR);
+    ptcache_file_seek(pf, -4, SEEK_CUR);
     return ptcache_smoke_read_old(pf, smoke_v);
   }
 
@@ -2159,6 +2160,8 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
 {
   PTCacheFile *pf;
   FILE *fp = NULL;
+  unsigned char *mem = NULL;
+  size_t mem_size = 0;
   char filename[FILE_MAX * 2];
 
 #ifndef DURIAN_POINTCACHE_LIB_OK
@@ -2174,7 +2177,12 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
   ptcache_filename(pid, filename, cfra, 1, 1);
 
   if (mode == PTCACHE_FILE_READ) {
-    fp = BLI_fopen(filename, "rb");
+    /* Read the whole file at once, a single large read is much faster on network storage than
+     * the many small reads of the point data. */
+    mem = BLI_file_read_binary_as_mem(filename, 0, &mem_size);
+    if (!mem) {
+      return NULL;
+    }
   }
   else if (mode == PTCACHE_FILE_WRITE) {
     /* Will create the dir if needs be, same as "//textures" is created. */
@@ -2187,12 +2195,15 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
     fp = BLI_fopen(filename, "rb+");
   }
 
-  if (!fp) {
+  if (!fp && !mem) {
     return NULL;
   }
 
   pf = MEM_mallocN(sizeof(PTCacheFile), "PTCacheFile");
   pf->fp = fp;
+  pf->mem = mem;
+  pf->mem_size = mem_size;
+  pf->mem_offset = 0;
   pf->old_format = 0;
   pf->frame = cfra;
 
@@ -2201,7 +2212,12 @@ static PTCacheFile *ptcache_file_open(PTCacheID *pid, int mode, int cfra)
 static void ptcache_file_close(PTCacheFile *pf)
 {
   if (pf) {
-    fclose(pf->fp);
+    if (pf->fp) {
+      fclose(pf->fp);
+    }
+    if (pf->mem) {
+      MEM_freeN(pf->mem);
+    }
     MEM_freeN(pf);
   }
 }
@@ -2214,7 +2230,8 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
 #ifdef WITH_LZO
   size_t out_len = len;
 #endif
-  unsigned char *in;
+  const unsigned char *in;
+  unsigned char *in_alloc = NULL;
   unsigned char *props = MEM_callocN(16 * sizeof(char), "tmp");
 
   ptcache_file_read(pf, &compressed, 1, sizeof(unsigned char));
@@ -2225,10 +2242,21 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
     if (in_len == 0) {
       /* do nothing */
     }
+    else if (pf->mem && in_len > pf->mem_size - pf->mem_offset) {
+      /* Truncated file. */
+      pf->mem_offset = pf->mem_size;
+    }
     else {
-      in = (unsigned char *)MEM_callocN(sizeof(unsigned char) * in_len,
-                                        "pointcache_compressed_buffer");
-      ptcache_file_read(pf, in, in_len, sizeof(unsigned char));
+      if (pf->mem) {
+        /* Decompress directly from the file contents. */
+        in = pf->mem + pf->mem_offset;
+        pf->mem_offset += in_len;
+      }
+      else {
+        in = in_alloc = (unsigned char *)MEM_callocN(sizeof(unsigned char) * in_len,
+                                                     "pointcache_compressed_buffer");
+        ptcache_file_read(pf, in_alloc, in_len, sizeof(unsigned char));
+      }
 #ifdef WITH_LZO
       if (compressed == 1) {
         r = lzo1x_decompress_safe(in, (lzo_uint)in_len, result, (lzo_uint *)&out_len, NULL);
@@ -2244,7 +2272,10 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
-      MEM_freeN(in);
+      (void)in; /* unused when building w/o compression */
+      if (in_alloc) {
+        MEM_freeN(in_alloc);
+      }
     }
   }
   else {
@@ -2328,8 +2359,34 @@ static int ptcache_file_compressed_write(
 }
 static int ptcache_file_read(PTCacheFile *pf, void *f, unsigned int tot, unsigned int size)
 {
+  if (pf->mem) {
+    const size_t len = (size_t)tot * size;
+    if (len > pf->mem_size - pf->mem_offset) {
+      pf->mem_offset = pf->mem_size;
+      return 0;
+    }
+    memcpy(f, pf->mem + pf->mem_offset, len);
+    pf->mem_offset += len;
+    return 1;
+  }
   return (fread(f, size, tot, pf->fp) == tot);
 }
+/* Only SEEK_SET and SEEK_CUR are supported. */
+static void ptcache_file_seek(PTCacheFile *pf, long offset, int whence)
+{
+  if (pf->mem) {
+    const size_t start = (whence == SEEK_CUR) ? pf->mem_offset : 0;
+    if (offset < 0 && (size_t)-offset > start) {
+      pf->mem_offset = 0;
+    }
+    else {
+      pf->mem_offset = min_zz(start + (size_t)offset, pf->mem_size);
+    }
+  }
+  else {
+    fseek(pf->fp, offset, whence);
+  }
+}
 static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot, unsigned int size)
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
@@ -2368,7 +2425,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
 
   pf->data_types = 0;
 
-  if (fread(bphysics, sizeof(char), 8, pf->fp) != 8) {
+  if (!ptcache_file_read(pf, bphysics, 8, sizeof(char))) {
     error = 1;
   }
 
@@ -2376,7 +2433,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
     error = 1;
   }
 
-  if (!error && !fread(&typeflag, sizeof(unsigned int), 1, pf->fp)) {
+  if (!error && !ptcache_file_read(pf, &typeflag, 1, sizeof(unsigned int))) {
     error = 1;
   }
 
@@ -2385,7 +2442,7 @@ static int ptcache_file_header_begin_read(PTCacheFile *pf)
 
   /* if there was an error set file as it was */
   if (error) {
-    fseek(pf->fp, 0, SEEK_SET);
+    ptcache_file_seek(pf, 0, SEEK_SET);
   }
 
   return !error;
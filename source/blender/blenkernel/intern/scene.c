@@ -1402,6 +1402,18 @@ void BKE_scene_graph_evaluated_ensure(Depsgraph *depsgraph, Main *bmain)
 
 /* applies changes right away, does all sets too */
 void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph, Main *bmain)
+{
+  BKE_scene_graph_update_for_newframe_ex(depsgraph, bmain, true);
+}
+
+/**
+ * \param clear_recalc: When false the recalc flags are kept, so the caller can find out which
+ * data-blocks changed since the graph was evaluated the last time (persistent render data).
+ * The caller is then responsible for clearing them.
+ */
+void BKE_scene_graph_update_for_newframe_ex(Depsgraph *depsgraph,
+                                            Main *bmain,
+                                            const bool clear_recalc)
 {
   Scene *scene = DEG_get_input_scene(depsgraph);
   ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
@@ -1447,7 +1459,9 @@ void BKE_scene_graph_update_for_newframe(Depsgraph *depsgraph, Main *bmain)
     /* Inform editors about possible changes. */
     DEG_ids_check_recalc(bmain, depsgraph, scene, view_layer, true);
     /* clear recalc flags */
-    DEG_ids_clear_recalc(bmain, depsgraph);
+    if (clear_recalc) {
+      DEG_ids_clear_recalc(bmain, depsgraph);
+    }
 
     /* If user callback did not tag anything for update we can skip second iteration.
      * Otherwise we update scene once again, but without running callbacks to bring
@@ -2141,6 +2155,72 @@ Depsgraph *BKE_scene_get_depsgraph(Main *bmain, Scene *scene, ViewLayer *view_la
   return depsgraph;
 }
 
+/**
+ * Undo: give the scenes of \a bmain_dst the depsgraphs of the matching scenes of \a bmain_src
+ * (the same scene when it was reused), so the evaluated copies of the data-blocks
+ * which were reused are kept as well.
+ *
+ * \note Must be called while \a bmain_src is still valid, relations of the depsgraphs need to be
+ * updated before they're used again, see #BKE_scene_undo_depsgraphs_relations_update.
+ */
+void BKE_scene_undo_depsgraphs_transfer(Main *bmain_dst, Main *bmain_src)
+{
+  LISTBASE_FOREACH (Scene *, scene_dst, &bmain_dst->scenes) {
+    Scene *scene_src = scene_dst;
+    if (!ID_IS_LINKED(scene_dst) && (scene_dst->id.tag & LIB_TAG_UNDO_OLD_ID_REUSED) == 0) {
+      scene_src = BLI_findstring(&bmain_src->scenes, scene_dst->id.name, offsetof(ID, name));
+    }
+    if (scene_src == NULL || scene_src->depsgraph_hash == NULL) {
+      continue;
+    }
+
+    /* Keys use the view layer pointers, which differ when the scene was read again. */
+    GHash *depsgraph_hash = scene_src->depsgraph_hash;
+    scene_src->depsgraph_hash = NULL;
+
+    GHashIterator gh_iter;
+    GHASH_ITER (gh_iter, depsgraph_hash) {
+      DepsgraphKey *key = BLI_ghashIterator_getKey(&gh_iter);
+      Depsgraph *depsgraph = BLI_ghashIterator_getValue(&gh_iter);
+      ViewLayer *view_layer = key->view_layer;
+      if (scene_dst != scene_src) {
+        view_layer = BLI_findstring(
+            &scene_dst->view_layers, view_layer->name, offsetof(ViewLayer, name));
+      }
+      if (view_layer == NULL) {
+        depsgraph_key_free(key);
+        depsgraph_key_value_free(depsgraph);
+        continue;
+      }
+      key->view_layer = view_layer;
+      DEG_graph_replace_owners(depsgraph, bmain_dst, scene_dst, view_layer);
+      BKE_scene_ensure_depsgraph_hash(scene_dst);
+      BLI_ghash_insert(scene_dst->depsgraph_hash, key, depsgraph);
+    }
+    BLI_ghash_free(depsgraph_hash, NULL, NULL);
+  }
+}
+
+/**
+ * Undo: rebuild the relations of the depsgraphs moved by #BKE_scene_undo_depsgraphs_transfer,
+ * this frees the evaluated copies of the data-blocks which were read again.
+ */
+void BKE_scene_undo_depsgraphs_relations_update(Main *bmain)
+{
+  LISTBASE_FOREACH (Scene *, scene, &bmain->scenes) {
+    if (scene->depsgraph_hash == NULL) {
+      continue;
+    }
+    GHashIterator gh_iter;
+    GHASH_ITER (gh_iter, scene->depsgraph_hash) {
+      DepsgraphKey *key = BLI_ghashIterator_getKey(&gh_iter);
+      Depsgraph *depsgraph = BLI_ghashIterator_getValue(&gh_iter);
+      DEG_graph_tag_relations_update(depsgraph);
+      DEG_graph_relations_update(depsgraph, bmain, scene, key->view_layer);
+    }
+  }
+}
+
 /* -------------------------------------------------------------------- */
 /** \name Scene Orientation
  * \{ */
@@ -40,6 +40,15 @@
 #include "BKE_scene.h"
 #include "BKE_main.h"
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#  define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
+#endif
+
 /**
  * Sequencer Cache Design Notes
  * ============================
@@ -63,6 +72,10 @@
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Compression: Final images of the preview with byte pixels can be stored LZO compressed
+ * (#SEQ_CACHE_COMPRESS_FINAL_OUT). The item has no ImBuf then, a new one is decompressed every
+ * time the image is requested.
  */
 
 typedef struct SeqCache {
@@ -77,6 +90,12 @@ typedef struct SeqCache {
 typedef struct SeqCacheItem {
   struct SeqCache *cache_owner;
   struct ImBuf *ibuf;
+  /* Compressed pixels used instead of ibuf, with the properties needed to restore it. */
+  void *compressed;
+  size_t compressed_size;
+  int x, y;
+  unsigned char planes;
+  struct ColorSpace *rect_colorspace;
 } SeqCacheItem;
 
 typedef struct SeqCacheKey {
@@ -187,21 +206,97 @@ static void seq_cache_valfree(void *val)
     cache->memory_used -= IMB_get_size_in_memory(item->ibuf);
     IMB_freeImBuf(item->ibuf);
   }
+  if (item->compressed) {
+    cache->memory_used -= item->compressed_size;
+    MEM_freeN(item->compressed);
+  }
 
   BLI_mempool_free(item->cache_owner->items_pool, item);
 }
 
-static void seq_cache_put(SeqCache *cache, SeqCacheKey *key, ImBuf *ibuf)
+static bool seq_cache_compress(SeqCacheItem *item, ImBuf *ibuf)
+{
+#ifdef WITH_LZO
+  if (ibuf->rect == NULL || ibuf->rect_float || ibuf->x <= 0 || ibuf->y <= 0) {
+    return false;
+  }
+
+  const size_t in_len = sizeof(unsigned int) * (size_t)ibuf->x * (size_t)ibuf->y;
+  unsigned char *out = MEM_mallocN(LZO_OUT_LEN(in_len), "seq cache compressed");
+  void *wrkmem = MEM_mallocN(LZO1X_1_MEM_COMPRESS, "seq cache lzo");
+  lzo_uint out_len = 0;
+
+  int r = lzo1x_1_compress(
+      (const unsigned char *)ibuf->rect, (lzo_uint)in_len, out, &out_len, wrkmem);
+  MEM_freeN(wrkmem);
+
+  if (r != LZO_E_OK || out_len >= in_len) {
+    MEM_freeN(out);
+    return false;
+  }
+
+  item->compressed = MEM_reallocN(out, out_len);
+  item->compressed_size = out_len;
+  item->x = ibuf->x;
+  item->y = ibuf->y;
+  item->planes = ibuf->planes;
+  item->rect_colorspace = ibuf->rect_colorspace;
+  return true;
+#else
+  UNUSED_VARS(item, ibuf);
+  return false;
+#endif
+}
+
+static ImBuf *seq_cache_decompress(const SeqCacheItem *item)
+{
+#ifdef WITH_LZO
+  ImBuf *ibuf = IMB_allocImBuf(item->x, item->y, item->planes, IB_rect);
+  if (ibuf == NULL) {
+    return NULL;
+  }
+
+  lzo_uint out_len = sizeof(unsigned int) * (size_t)item->x * (size_t)item->y;
+  int r = lzo1x_decompress_safe(item->compressed,
+                                (lzo_uint)item->compressed_size,
+                                (unsigned char *)ibuf->rect,
+                                &out_len,
+                                NULL);
+  if (r != LZO_E_OK) {
+    IMB_freeImBuf(ibuf);
+    return NULL;
+  }
+
+  ibuf->rect_colorspace = item->rect_colorspace;
+  return ibuf;
+#else
+  UNUSED_VARS(item);
+  return NULL;
+#endif
+}
+
+static void seq_cache_put(SeqCache *cache, SeqCacheKey *key, ImBuf *ibuf, bool use_compression)
 {
   SeqCacheItem *item;
   item = BLI_mempool_alloc(cache->items_pool);
   item->cache_owner = cache;
-  item->ibuf = ibuf;
+  item->ibuf = NULL;
+  item->compressed = NULL;
+  item->compressed_size = 0;
+
+  if (!(use_compression && seq_cache_compress(item, ibuf))) {
+    item->ibuf = ibuf;
+  }
 
   if (BLI_ghash_reinsert(cache->hash, key, item, seq_cache_keyfree, seq_cache_valfree)) {
-    IMB_refImBuf(ibuf);
     cache->last_key = key;
-    cache->memory_used += IMB_get_size_in_memory(ibuf);
+    if (item->ibuf) {
+      IMB_refImBuf(ibuf);
+      cache->memory_used += IMB_get_size_in_memory(ibuf);
+    }
+    else {
+      cache->memory_used += item->compressed_size;
+    }
   }
 }
 
@@ -214,6 +309,9 @@ static ImBuf *seq_cache_get(SeqCache *cache, void *key)
 
     return item->ibuf;
   }
+  if (item && item->compressed) {
+    return seq_cache_decompress(item);
+  }
 
   return NULL;
 }
@@ -341,7 +439,7 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
     BLI_ghashIterator_step(&gh_iter);
 
     /* this shouldn't happen, but better be safe than sorry */
-    if (!item->ibuf) {
+    if (!item->ibuf && !item->compressed) {
       seq_cache_recycle_linked(scene, key);
       /* can not continue iterating after linked remove */
       BLI_ghashIterator_init(&gh_iter, cache->hash);
@@ -694,8 +792,12 @@ void BKE_sequencer_cache_put(
     key->link_prev = cache->last_key;
   }
 
+  /* Only the preview keeps many final images around for playback. */
+  const bool use_compression = (type == SEQ_CACHE_STORE_FINAL_OUT) && !context->for_render &&
+                               (scene->ed->cache_flag & SEQ_CACHE_COMPRESS_FINAL_OUT);
+
   SeqCacheKey *temp_last_key = cache->last_key;
-  seq_cache_put(cache, key, i);
+  seq_cache_put(cache, key, i, use_compression);
 
   /* Restore pointer to previous item as this one will be freed when stack is rendered */
   if (key->is_temp_cache) {
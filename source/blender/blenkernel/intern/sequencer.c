@@ -47,6 +47,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -3976,6 +3977,112 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/* Strips which only read their own data, they can be rendered in parallel with each other.
+ * Effects, scenes and masks render other strips or use data shared with them. */
+static bool seq_render_strip_is_threadsafe(Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+
+  for (SequenceModifierData *smd = seq->modifiers.first; smd; smd = smd->next) {
+    if (smd->mask_input_type == SEQUENCE_MASK_INPUT_STRIP ? smd->mask_sequence != NULL :
+                                                           smd->mask_id != NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
+typedef struct SeqRenderStripsData {
+  const SeqRenderData *context;
+  SeqRenderState *state;
+  Sequence **seq_arr;
+  ImBuf **ibuf_arr;
+  int *index_arr;
+  float cfra;
+} SeqRenderStripsData;
+
+static void seq_render_strips_threaded_cb(void *__restrict userdata,
+                                          const int iter,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SeqRenderStripsData *data = userdata;
+  const int i = data->index_arr[iter];
+  data->ibuf_arr[i] = seq_render_strip(data->context, data->state, data->seq_arr[i], data->cfra);
+}
+
+/* Render the strips the stack will blend in parallel, following the same rules as
+ * #seq_render_strip_stack. Decoding and preprocessing of the strips are independent, only
+ * blending them has to be done in order. */
+static void seq_render_strips_threaded(const SeqRenderData *context,
+                                       SeqRenderState *state,
+                                       Sequence **seq_arr,
+                                       ImBuf **ibuf_arr,
+                                       int count,
+                                       float cfra)
+{
+  int index_arr[MAXSEQ + 1];
+  int num_strips = 0;
+
+  memset(ibuf_arr, 0, sizeof(*ibuf_arr) * count);
+
+  for (int i = count - 1; i >= 0; i--) {
+    Sequence *seq = seq_arr[i];
+    ImBuf *ibuf = BKE_sequencer_cache_get(context, seq, cfra, SEQ_CACHE_STORE_COMPOSITE);
+
+    if (ibuf) {
+      IMB_freeImBuf(ibuf);
+      break;
+    }
+
+    const int early_out = seq_get_early_out_for_blend_mode(seq);
+    const bool is_bottom = (seq->blend_mode == SEQ_BLEND_REPLACE) ||
+                           ELEM(early_out, EARLY_NO_INPUT, EARLY_USE_INPUT_2);
+
+    if ((is_bottom || early_out == EARLY_DO_EFFECT) && seq_render_strip_is_threadsafe(seq)) {
+      index_arr[num_strips++] = i;
+    }
+    if (is_bottom) {
+      break;
+    }
+  }
+
+  if (num_strips < 2) {
+    return;
+  }
+
+  SeqRenderStripsData data = {
+      .context = context,
+      .state = state,
+      .seq_arr = seq_arr,
+      .ibuf_arr = ibuf_arr,
+      .index_arr = index_arr,
+      .cfra = cfra,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, num_strips, &data, seq_render_strips_threaded_cb, &settings);
+}
+
+/* Take the strip rendered by #seq_render_strips_threaded, or render it. */
+static ImBuf *seq_render_strip_stack_ibuf(const SeqRenderData *context,
+                                          SeqRenderState *state,
+                                          Sequence **seq_arr,
+                                          ImBuf **ibuf_arr,
+                                          int i,
+                                          float cfra)
+{
+  ImBuf *ibuf = ibuf_arr[i];
+  if (ibuf) {
+    ibuf_arr[i] = NULL;
+    return ibuf;
+  }
+  return seq_render_strip(context, state, seq_arr[i], cfra);
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
@@ -3983,6 +4090,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      int chanshown)
 {
   Sequence *seq_arr[MAXSEQ + 1];
+  ImBuf *ibuf_arr[MAXSEQ + 1];
   int count;
   int i;
   ImBuf *out = NULL;
@@ -3994,6 +4102,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     return NULL;
   }
 
+  seq_render_strips_threaded(context, state, seq_arr, ibuf_arr, count, cfra);
+
   for (i = count - 1; i >= 0; i--) {
     int early_out;
     Sequence *seq = seq_arr[i];
@@ -4004,7 +4114,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
       break;
     }
     if (seq->blend_mode == SEQ_BLEND_REPLACE) {
-      out = seq_render_strip(context, state, seq, cfra);
+      out = seq_render_strip_stack_ibuf(context, state, seq_arr, ibuf_arr, i, cfra);
       break;
     }
 
@@ -4013,7 +4123,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     switch (early_out) {
       case EARLY_NO_INPUT:
       case EARLY_USE_INPUT_2:
-        out = seq_render_strip(context, state, seq, cfra);
+        out = seq_render_strip_stack_ibuf(context, state, seq_arr, ibuf_arr, i, cfra);
         break;
       case EARLY_USE_INPUT_1:
         if (i == 0) {
@@ -4025,7 +4135,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
           begin = seq_estimate_render_cost_begin();
 
           ImBuf *ibuf1 = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
-          ImBuf *ibuf2 = seq_render_strip(context, state, seq, cfra);
+          ImBuf *ibuf2 = seq_render_strip_stack_ibuf(context, state, seq_arr, ibuf_arr, i, cfra);
 
           out = seq_render_strip_stack_apply_effect(context, seq, cfra, ibuf1, ibuf2);
 
@@ -4049,7 +4159,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, cfra);
+      ImBuf *ibuf2 = seq_render_strip_stack_ibuf(context, state, seq_arr, ibuf_arr, i, cfra);
 
       out = seq_render_strip_stack_apply_effect(context, seq, cfra, ibuf1, ibuf2);
 
@@ -4061,6 +4171,13 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     BKE_sequencer_cache_put(context, seq_arr[i], cfra, SEQ_CACHE_STORE_COMPOSITE, out, cost);
   }
 
+  /* Strips rendered in advance but covered by a composite cached meanwhile. */
+  for (i = 0; i < count; i++) {
+    if (ibuf_arr[i]) {
+      IMB_freeImBuf(ibuf_arr[i]);
+    }
+  }
+
   return out;
 }
 
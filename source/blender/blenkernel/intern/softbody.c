@@ -57,8 +57,11 @@
 
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
+#include "BLI_buffer.h"
 #include "BLI_listbase.h"
 #include "BLI_ghash.h"
+#include "BLI_kdopbvh.h"
+#include "BLI_sort_utils.h"
 #include "BLI_threads.h"
 
 #include "BKE_collection.h"
@@ -271,11 +274,79 @@ typedef struct ccd_Mesh {
   const MVertTri *tri;
   int safety;
   ccdf_minmax *mima;
+  /* Tree of the face bounds, same as mima. */
+  BVHTree *bvhtree;
+  float hull;
   /* Axis Aligned Bounding Box AABB */
   float bbmin[3];
   float bbmax[3];
 } ccd_Mesh;
 
+static void ccd_mesh_tri_co(const MVert *mvert, const MVertTri *vt, float r_co[3][3])
+{
+  copy_v3_v3(r_co[0], mvert[vt->tri[0]].co);
+  copy_v3_v3(r_co[1], mvert[vt->tri[1]].co);
+  copy_v3_v3(r_co[2], mvert[vt->tri[2]].co);
+}
+
+/* Update the bounds of the faces in the tree, which are padded by the hull like mima. */
+static void ccd_mesh_bvhtree_update(ccd_Mesh *pccd_M, float hull)
+{
+  float co[3][3], co_prev[3][3];
+  int i;
+
+  if (pccd_M->bvhtree && pccd_M->hull == hull) {
+    for (i = 0; i < pccd_M->tri_num; i++) {
+      ccd_mesh_tri_co(pccd_M->mvert, &pccd_M->tri[i], co);
+      if (pccd_M->mprevvert) {
+        ccd_mesh_tri_co(pccd_M->mprevvert, &pccd_M->tri[i], co_prev);
+        BLI_bvhtree_update_node(pccd_M->bvhtree, i, co_prev[0], co[0], 3);
+      }
+      else {
+        BLI_bvhtree_update_node(pccd_M->bvhtree, i, co[0], NULL, 3);
+      }
+    }
+    BLI_bvhtree_update_tree(pccd_M->bvhtree);
+    return;
+  }
+
+  if (pccd_M->bvhtree) {
+    BLI_bvhtree_free(pccd_M->bvhtree);
+  }
+  pccd_M->bvhtree = BLI_bvhtree_new(pccd_M->tri_num, hull, 4, 6);
+  pccd_M->hull = hull;
+
+  for (i = 0; i < pccd_M->tri_num; i++) {
+    ccd_mesh_tri_co(pccd_M->mvert, &pccd_M->tri[i], co);
+    BLI_bvhtree_insert(pccd_M->bvhtree, i, co[0], 3);
+  }
+  BLI_bvhtree_balance(pccd_M->bvhtree);
+
+  if (pccd_M->mprevvert) {
+    ccd_mesh_bvhtree_update(pccd_M, hull);
+  }
+}
+
+static void ccd_mesh_faces_find_cb(void *userdata,
+                                   int index,
+                                   const float UNUSED(co[3]),
+                                   float UNUSED(dist_sq))
+{
+  BLI_buffer_append((BLI_Buffer *)userdata, int, index);
+}
+
+/* Find the faces whose bounds may contain co, sorted to be processed in the same order as looping
+ * over all faces would. */
+static void ccd_mesh_faces_find(const ccd_Mesh *ccdm, const float co[3], BLI_Buffer *r_faces)
+{
+  BLI_buffer_clear(r_faces);
+  /* The range is exclusive, any radius finds the bounds the point is in. */
+  BLI_bvhtree_range_query(ccdm->bvhtree, co, FLT_EPSILON, ccd_mesh_faces_find_cb, r_faces);
+  if (r_faces->count > 1) {
+    qsort(r_faces->data, r_faces->count, sizeof(int), BLI_sortutil_cmp_int);
+  }
+}
+
 static ccd_Mesh *ccd_mesh_make(Object *ob)
 {
   CollisionModifierData *cmd;
@@ -302,6 +373,7 @@ static ccd_Mesh *ccd_mesh_make(Object *ob)
   pccd_M->bbmin[0] = pccd_M->bbmin[1] = pccd_M->bbmin[2] = 1e30f;
   pccd_M->bbmax[0] = pccd_M->bbmax[1] = pccd_M->bbmax[2] = -1e30f;
   pccd_M->mprevvert = NULL;
+  pccd_M->bvhtree = NULL;
 
   /* blow it up with forcefield ranges */
   hull = max_ff(ob->pd->pdef_sbift, ob->pd->pdef_sboft);
@@ -361,6 +433,8 @@ static ccd_Mesh *ccd_mesh_make(Object *ob)
     mima->maxz = max_ff(mima->maxz, v[2] + hull);
   }
 
+  ccd_mesh_bvhtree_update(pccd_M, hull);
+
   return pccd_M;
 }
 static void ccd_mesh_update(Object *ob, ccd_Mesh *pccd_M)
@@ -481,7 +555,8 @@ static void ccd_mesh_update(Object *ob, ccd_Mesh *pccd_M)
     mima->maxy = max_ff(mima->maxy, v[1] + hull);
     mima->maxz = max_ff(mima->maxz, v[2] + hull);
   }
-  return;
+
+  ccd_mesh_bvhtree_update(pccd_M, hull);
 }
 
 static void ccd_mesh_free(ccd_Mesh *ccdm)
@@ -494,6 +569,7 @@ static void ccd_mesh_free(ccd_Mesh *ccdm)
       MEM_freeN((void *)ccdm->mprevvert);
     }
     MEM_freeN(ccdm->mima);
+    BLI_bvhtree_free(ccdm->bvhtree);
     MEM_freeN(ccdm);
     ccdm = NULL;
   }
@@ -1635,7 +1711,8 @@ static int sb_detect_vertex_collisionCached(float opco[3],
       mindistedge = 1000.0f, outerforceaccu[3], innerforceaccu[3], facedist,
       /* n_mag, */ /* UNUSED */ force_mag_norm, minx, miny, minz, maxx, maxy, maxz,
       innerfacethickness = -0.5f, outerfacethickness = 0.2f, ee = 5.0f, ff = 0.1f, fa = 1;
-  int a, deflected = 0, cavel = 0, ci = 0;
+  int deflected = 0, cavel = 0, ci = 0;
+  BLI_buffer_declare_static(int, faces, BLI_BUFFER_NOP, 64);
   /* init */
   *intrusion = 0.0f;
   hash = vertexowner->soft->scratch->colliderhash;
@@ -1658,9 +1735,6 @@ static int sb_detect_vertex_collisionCached(float opco[3],
         if (ccdm) {
           mvert = ccdm->mvert;
           mprevvert = ccdm->mprevvert;
-          vt = ccdm->tri;
-          mima = ccdm->mima;
-          a = ccdm->tri_num;
 
           minx = ccdm->bbmin[0];
           miny = ccdm->bbmin[1];
@@ -1693,11 +1767,14 @@ static int sb_detect_vertex_collisionCached(float opco[3],
         fa = 1.0f / fa;
         avel[0] = avel[1] = avel[2] = 0.0f;
         /* use mesh*/
-        while (a--) {
+        ccd_mesh_faces_find(ccdm, opco, &faces);
+        for (int f = 0; f < (int)faces.count; f++) {
+          const int face_index = BLI_buffer_at(&faces, int, f);
+          mima = &ccdm->mima[face_index];
+          vt = &ccdm->tri[face_index];
+
           if ((opco[0] < mima->minx) || (opco[0] > mima->maxx) || (opco[1] < mima->miny) ||
               (opco[1] > mima->maxy) || (opco[2] < mima->minz) || (opco[2] > mima->maxz)) {
-            mima++;
-            vt++;
             continue;
           }
 
@@ -1768,10 +1845,7 @@ static int sb_detect_vertex_collisionCached(float opco[3],
               ci++;
             }
           }
-
-          mima++;
-          vt++;
-        } /* while a */
+        } /* for faces */
       }   /* if (ob->pd && ob->pd->deflect) */
       BLI_ghashIterator_step(ihash);
     }
@@ -1797,6 +1871,7 @@ static int sb_detect_vertex_collisionCached(float opco[3],
   }
 
   BLI_ghashIterator_free(ihash);
+  BLI_buffer_free(&faces);
   if (cavel) {
     mul_v3_fl(avel, 1.0f / (float)cavel);
   }
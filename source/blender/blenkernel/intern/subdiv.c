@@ -169,14 +169,42 @@ Subdiv *BKE_subdiv_update_from_converter(Subdiv *subdiv,
   return BKE_subdiv_new_from_converter(settings, converter);
 }
 
+static bool subdiv_mesh_topology_matches(const Subdiv *subdiv,
+                                         const Mesh *mesh,
+                                         const uint32_t topology_hash)
+{
+  return subdiv->mesh_topology_.is_valid && subdiv->mesh_topology_.num_vertices == mesh->totvert &&
+         subdiv->mesh_topology_.num_edges == mesh->totedge &&
+         subdiv->mesh_topology_.num_loops == mesh->totloop &&
+         subdiv->mesh_topology_.num_polys == mesh->totpoly &&
+         subdiv->mesh_topology_.hash == topology_hash;
+}
+
 Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
                                     const SubdivSettings *settings,
                                     const Mesh *mesh)
 {
+  /* Meshes created by modifiers are new on every evaluation, but their topology usually stays
+   * the same. Check this without going through the converter, which is costly to create and to
+   * compare with the topology refiner. */
+  const uint32_t topology_hash = BKE_subdiv_converter_mesh_topology_hash(settings, mesh);
+  if (subdiv != NULL && subdiv->topology_refiner != NULL &&
+      BKE_subdiv_settings_equal(&subdiv->settings, settings) &&
+      subdiv_mesh_topology_matches(subdiv, mesh, topology_hash)) {
+    return subdiv;
+  }
   OpenSubdiv_Converter converter;
   BKE_subdiv_converter_init_for_mesh(&converter, settings, mesh);
   subdiv = BKE_subdiv_update_from_converter(subdiv, settings, &converter);
   BKE_subdiv_converter_free(&converter);
+  if (subdiv != NULL) {
+    subdiv->mesh_topology_.is_valid = true;
+    subdiv->mesh_topology_.num_vertices = mesh->totvert;
+    subdiv->mesh_topology_.num_edges = mesh->totedge;
+    subdiv->mesh_topology_.num_loops = mesh->totloop;
+    subdiv->mesh_topology_.num_polys = mesh->totpoly;
+    subdiv->mesh_topology_.hash = topology_hash;
+  }
   return subdiv;
 }
 
@@ -44,7 +44,10 @@
  * Various forward declarations.
  */
 
-static void subdiv_ccg_average_all_boundaries_and_corners(SubdivCCG *subdiv_ccg, CCGKey *key);
+static void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG *subdiv_ccg,
+                                                            CCGKey *key,
+                                                            struct CCGFace **effected_faces,
+                                                            int num_effected_faces);
 
 static void subdiv_ccg_average_inner_face_grids(SubdivCCG *subdiv_ccg,
                                                 CCGKey *key,
@@ -399,20 +402,36 @@ static CCGElem *subdiv_ccg_coord_to_elem(const CCGKey *key,
   return CCG_grid_elem(key, subdiv_ccg->grids[coord->grid_index], coord->x, coord->y);
 }
 
-/* Returns storage where boundary elements are to be stored. */
-static SubdivCCGCoord *subdiv_ccg_adjacent_edge_add_face(SubdivCCG *subdiv_ccg,
-                                                         SubdivCCGAdjacentEdge *adjacent_edge)
+/* Store indices of coarse vertices and edges adjacent to every grid. */
+static void subdiv_ccg_init_grids_adjacency_task(void *__restrict userdata_v,
+                                                 const int face_index,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls_v))
 {
-  const int grid_size = subdiv_ccg->grid_size * 2;
-  const int adjacent_face_index = adjacent_edge->num_adjacent_faces;
-  ++adjacent_edge->num_adjacent_faces;
-  /* Allocate memory for the boundary elements. */
-  adjacent_edge->boundary_coords = MEM_reallocN(adjacent_edge->boundary_coords,
-                                                adjacent_edge->num_adjacent_faces *
-                                                    sizeof(*adjacent_edge->boundary_coords));
-  adjacent_edge->boundary_coords[adjacent_face_index] = MEM_malloc_arrayN(
-      grid_size * 2, sizeof(SubdivCCGCoord), "ccg adjacent boundary");
-  return adjacent_edge->boundary_coords[adjacent_face_index];
+  SubdivCCG *subdiv_ccg = userdata_v;
+  OpenSubdiv_TopologyRefiner *topology_refiner = subdiv_ccg->subdiv->topology_refiner;
+  const SubdivCCGFace *face = &subdiv_ccg->faces[face_index];
+  /* Note that order of edges is same as order of MLoops, which also
+   * means it's the same as order of grids. */
+  topology_refiner->getFaceVertices(
+      topology_refiner, face_index, &subdiv_ccg->grid_adjacent_vertices[face->start_grid_index]);
+  topology_refiner->getFaceEdges(
+      topology_refiner, face_index, &subdiv_ccg->grid_adjacent_edges[face->start_grid_index]);
+}
+
+static void subdiv_ccg_init_grids_adjacency(SubdivCCG *subdiv_ccg)
+{
+  const int num_grids = subdiv_ccg->num_grids;
+  subdiv_ccg->grid_adjacent_vertices = MEM_malloc_arrayN(
+      num_grids, sizeof(*subdiv_ccg->grid_adjacent_vertices), "ccg grid adjacent vertices");
+  subdiv_ccg->grid_adjacent_edges = MEM_malloc_arrayN(
+      num_grids, sizeof(*subdiv_ccg->grid_adjacent_edges), "ccg grid adjacent edges");
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  BLI_task_parallel_range(0,
+                          subdiv_ccg->num_faces,
+                          subdiv_ccg,
+                          subdiv_ccg_init_grids_adjacency_task,
+                          &parallel_range_settings);
 }
 
 static void subdiv_ccg_init_faces_edge_neighborhood(SubdivCCG *subdiv_ccg)
@@ -427,23 +446,36 @@ static void subdiv_ccg_init_faces_edge_neighborhood(SubdivCCG *subdiv_ccg)
     return;
   }
   subdiv_ccg_allocate_adjacent_edges(subdiv_ccg, num_edges);
-  /* Initialize storage. */
-  StaticOrHeapIntStorage face_vertices_storage;
-  StaticOrHeapIntStorage face_edges_storage;
-  static_or_heap_storage_init(&face_vertices_storage);
-  static_or_heap_storage_init(&face_edges_storage);
+  /* Count adjacent faces, so that storage for every edge is only allocated once. */
+  for (int grid_index = 0; grid_index < subdiv_ccg->num_grids; grid_index++) {
+    const int edge_index = subdiv_ccg->grid_adjacent_edges[grid_index];
+    subdiv_ccg->adjacent_edges[edge_index].num_adjacent_faces++;
+  }
+  for (int edge_index = 0; edge_index < num_edges; edge_index++) {
+    SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[edge_index];
+    const int num_adjacent_faces = adjacent_edge->num_adjacent_faces;
+    if (num_adjacent_faces == 0) {
+      continue;
+    }
+    adjacent_edge->boundary_coords = MEM_malloc_arrayN(
+        num_adjacent_faces, sizeof(*adjacent_edge->boundary_coords), "ccg adjacent boundaries");
+    /* Boundaries of all faces are stored in a single allocation. */
+    SubdivCCGCoord *boundary_coords = MEM_malloc_arrayN(
+        num_adjacent_faces * grid_size * 2, sizeof(SubdivCCGCoord), "ccg adjacent boundary");
+    for (int face_index = 0; face_index < num_adjacent_faces; face_index++) {
+      adjacent_edge->boundary_coords[face_index] = &boundary_coords[face_index * grid_size * 2];
+    }
+    /* Counter is restored while adding faces. */
+    adjacent_edge->num_adjacent_faces = 0;
+  }
   /* Store adjacency for all faces. */
   const int num_faces = subdiv_ccg->num_faces;
   for (int face_index = 0; face_index < num_faces; face_index++) {
     SubdivCCGFace *face = &faces[face_index];
     const int num_face_grids = face->num_grids;
     const int num_face_edges = num_face_grids;
-    int *face_vertices = static_or_heap_storage_get(&face_vertices_storage, num_face_edges);
-    topology_refiner->getFaceVertices(topology_refiner, face_index, face_vertices);
-    /* Note that order of edges is same as order of MLoops, which also
-     * means it's the same as order of grids. */
-    int *face_edges = static_or_heap_storage_get(&face_edges_storage, num_face_edges);
-    topology_refiner->getFaceEdges(topology_refiner, face_index, face_edges);
+    const int *face_vertices = &subdiv_ccg->grid_adjacent_vertices[face->start_grid_index];
+    const int *face_edges = &subdiv_ccg->grid_adjacent_edges[face->start_grid_index];
     /* Store grids adjacency for this edge. */
     for (int corner = 0; corner < num_face_edges; corner++) {
       const int vertex_index = face_vertices[corner];
@@ -457,8 +489,8 @@ static void subdiv_ccg_init_faces_edge_neighborhood(SubdivCCG *subdiv_ccg)
       const int next_grid_index = face->start_grid_index + (corner + 1) % num_face_grids;
       /* Add new face to the adjacent edge. */
       SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[edge_index];
-      SubdivCCGCoord *boundary_coords = subdiv_ccg_adjacent_edge_add_face(subdiv_ccg,
-                                                                          adjacent_edge);
+      SubdivCCGCoord *boundary_coords =
+          adjacent_edge->boundary_coords[adjacent_edge->num_adjacent_faces++];
       /* Fill CCG elements along the edge. */
       int boundary_element_index = 0;
       if (is_edge_flipped) {
@@ -483,9 +515,6 @@ static void subdiv_ccg_init_faces_edge_neighborhood(SubdivCCG *subdiv_ccg)
       }
     }
   }
-  /* Free possibly heap-allocated storage. */
-  static_or_heap_storage_free(&face_vertices_storage);
-  static_or_heap_storage_free(&face_edges_storage);
 }
 
 static void subdiv_ccg_allocate_adjacent_vertices(SubdivCCG *subdiv_ccg, const int num_vertices)
@@ -496,24 +525,9 @@ static void subdiv_ccg_allocate_adjacent_vertices(SubdivCCG *subdiv_ccg, const i
                                                     "ccg adjacent vertices");
 }
 
-/* Returns storage where corner elements are to be stored. This is a pointer
- * to the actual storage. */
-static SubdivCCGCoord *subdiv_ccg_adjacent_vertex_add_face(
-    SubdivCCGAdjacentVertex *adjacent_vertex)
-{
-  const int adjacent_face_index = adjacent_vertex->num_adjacent_faces;
-  ++adjacent_vertex->num_adjacent_faces;
-  /* Allocate memory for the boundary elements. */
-  adjacent_vertex->corner_coords = MEM_reallocN(adjacent_vertex->corner_coords,
-                                                adjacent_vertex->num_adjacent_faces *
-                                                    sizeof(*adjacent_vertex->corner_coords));
-  return &adjacent_vertex->corner_coords[adjacent_face_index];
-}
-
 static void subdiv_ccg_init_faces_vertex_neighborhood(SubdivCCG *subdiv_ccg)
 {
   Subdiv *subdiv = subdiv_ccg->subdiv;
-  SubdivCCGFace *faces = subdiv_ccg->faces;
   OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
   const int num_vertices = topology_refiner->getNumVertices(topology_refiner);
   const int grid_size = subdiv_ccg->grid_size;
@@ -522,36 +536,35 @@ static void subdiv_ccg_init_faces_vertex_neighborhood(SubdivCCG *subdiv_ccg)
     return;
   }
   subdiv_ccg_allocate_adjacent_vertices(subdiv_ccg, num_vertices);
-  /* Initialize storage. */
-  StaticOrHeapIntStorage face_vertices_storage;
-  static_or_heap_storage_init(&face_vertices_storage);
-  /* Key to access elements. */
-  CCGKey key;
-  BKE_subdiv_ccg_key_top_level(&key, subdiv_ccg);
-  /* Store adjacency for all faces. */
-  const int num_faces = subdiv_ccg->num_faces;
-  for (int face_index = 0; face_index < num_faces; face_index++) {
-    SubdivCCGFace *face = &faces[face_index];
-    const int num_face_grids = face->num_grids;
-    const int num_face_edges = num_face_grids;
-    int *face_vertices = static_or_heap_storage_get(&face_vertices_storage, num_face_edges);
-    topology_refiner->getFaceVertices(topology_refiner, face_index, face_vertices);
-    for (int corner = 0; corner < num_face_edges; corner++) {
-      const int vertex_index = face_vertices[corner];
-      /* Grid which is adjacent to the current corner. */
-      const int grid_index = face->start_grid_index + corner;
-      /* Add new face to the adjacent edge. */
-      SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[vertex_index];
-      SubdivCCGCoord *corner_coord = subdiv_ccg_adjacent_vertex_add_face(adjacent_vertex);
-      *corner_coord = subdiv_ccg_coord(grid_index, grid_size - 1, grid_size - 1);
+  /* Count adjacent faces, so that storage for every vertex is only allocated once. */
+  const int num_grids = subdiv_ccg->num_grids;
+  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
+    const int vertex_index = subdiv_ccg->grid_adjacent_vertices[grid_index];
+    subdiv_ccg->adjacent_vertices[vertex_index].num_adjacent_faces++;
+  }
+  for (int vertex_index = 0; vertex_index < num_vertices; vertex_index++) {
+    SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[vertex_index];
+    if (adjacent_vertex->num_adjacent_faces == 0) {
+      continue;
     }
+    adjacent_vertex->corner_coords = MEM_malloc_arrayN(adjacent_vertex->num_adjacent_faces,
+                                                       sizeof(*adjacent_vertex->corner_coords),
+                                                       "ccg adjacent corners");
+    /* Counter is restored while adding faces. */
+    adjacent_vertex->num_adjacent_faces = 0;
+  }
+  /* Store adjacency for all faces, grids are following corners of the faces. */
+  for (int grid_index = 0; grid_index < num_grids; grid_index++) {
+    const int vertex_index = subdiv_ccg->grid_adjacent_vertices[grid_index];
+    SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[vertex_index];
+    adjacent_vertex->corner_coords[adjacent_vertex->num_adjacent_faces++] = subdiv_ccg_coord(
+        grid_index, grid_size - 1, grid_size - 1);
   }
-  /* Free possibly heap-allocated storage. */
-  static_or_heap_storage_free(&face_vertices_storage);
 }
 
 static void subdiv_ccg_init_faces_neighborhood(SubdivCCG *subdiv_ccg)
 {
+  subdiv_ccg_init_grids_adjacency(subdiv_ccg);
   subdiv_ccg_init_faces_edge_neighborhood(subdiv_ccg);
   subdiv_ccg_init_faces_vertex_neighborhood(subdiv_ccg);
 }
@@ -632,13 +645,16 @@ void BKE_subdiv_ccg_destroy(SubdivCCG *subdiv_ccg)
   }
   MEM_SAFE_FREE(subdiv_ccg->faces);
   MEM_SAFE_FREE(subdiv_ccg->grid_faces);
+  MEM_SAFE_FREE(subdiv_ccg->grid_adjacent_vertices);
+  MEM_SAFE_FREE(subdiv_ccg->grid_adjacent_edges);
   /* Free map of adjacent edges. */
   for (int i = 0; i < subdiv_ccg->num_adjacent_edges; i++) {
     SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[i];
-    for (int face_index = 0; face_index < adjacent_edge->num_adjacent_faces; face_index++) {
-      MEM_SAFE_FREE(adjacent_edge->boundary_coords[face_index]);
+    if (adjacent_edge->boundary_coords != NULL) {
+      /* Boundaries of all faces share the allocation of the first one. */
+      MEM_freeN(adjacent_edge->boundary_coords[0]);
+      MEM_freeN(adjacent_edge->boundary_coords);
     }
-    MEM_SAFE_FREE(adjacent_edge->boundary_coords);
   }
   MEM_SAFE_FREE(subdiv_ccg->adjacent_edges);
   /* Free map of adjacent vertices. */
@@ -878,11 +894,10 @@ void BKE_subdiv_ccg_update_normals(SubdivCCG *subdiv_ccg,
     return;
   }
   subdiv_ccg_recalc_modified_inner_grid_normals(subdiv_ccg, effected_faces, num_effected_faces);
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
   CCGKey key;
   BKE_subdiv_ccg_key_top_level(&key, subdiv_ccg);
-  subdiv_ccg_average_all_boundaries_and_corners(subdiv_ccg, &key);
+  subdiv_ccg_average_faces_boundaries_and_corners(
+      subdiv_ccg, &key, effected_faces, num_effected_faces);
 }
 
 /* =============================================================================
@@ -1019,6 +1034,8 @@ static void subdiv_ccg_average_inner_grids_task(void *__restrict userdata_v,
 typedef struct AverageGridsBoundariesData {
   SubdivCCG *subdiv_ccg;
   CCGKey *key;
+  /* Indices of adjacent edges to be averaged, all edges are averaged when NULL. */
+  const int *adjacent_edge_indices;
 } AverageGridsBoundariesData;
 
 typedef struct AverageGridsBoundariesTLSData {
@@ -1066,13 +1083,16 @@ static void subdiv_ccg_average_grids_boundary(SubdivCCG *subdiv_ccg,
 }
 
 static void subdiv_ccg_average_grids_boundaries_task(void *__restrict userdata_v,
-                                                     const int adjacent_edge_index,
+                                                     const int index,
                                                      const TaskParallelTLS *__restrict tls_v)
 {
   AverageGridsBoundariesData *data = userdata_v;
   AverageGridsBoundariesTLSData *tls = tls_v->userdata_chunk;
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   CCGKey *key = data->key;
+  const int adjacent_edge_index = (data->adjacent_edge_indices != NULL) ?
+                                      data->adjacent_edge_indices[index] :
+                                      index;
   SubdivCCGAdjacentEdge *adjacent_edge = &subdiv_ccg->adjacent_edges[adjacent_edge_index];
   subdiv_ccg_average_grids_boundary(subdiv_ccg, key, adjacent_edge, tls);
 }
@@ -1087,6 +1107,8 @@ static void subdiv_ccg_average_grids_boundaries_finalize(void *__restrict UNUSED
 typedef struct AverageGridsCornerData {
   SubdivCCG *subdiv_ccg;
   CCGKey *key;
+  /* Indices of adjacent vertices to be averaged, all vertices are averaged when NULL. */
+  const int *adjacent_vertex_indices;
 } AverageGridsCornerData;
 
 static void subdiv_ccg_average_grids_corners(SubdivCCG *subdiv_ccg,
@@ -1115,45 +1137,56 @@ static void subdiv_ccg_average_grids_corners(SubdivCCG *subdiv_ccg,
 }
 
 static void subdiv_ccg_average_grids_corners_task(void *__restrict userdata_v,
-                                                  const int adjacent_vertex_index,
+                                                  const int index,
                                                   const TaskParallelTLS *__restrict UNUSED(tls_v))
 {
   AverageGridsCornerData *data = userdata_v;
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   CCGKey *key = data->key;
+  const int adjacent_vertex_index = (data->adjacent_vertex_indices != NULL) ?
+                                        data->adjacent_vertex_indices[index] :
+                                        index;
   SubdivCCGAdjacentVertex *adjacent_vertex = &subdiv_ccg->adjacent_vertices[adjacent_vertex_index];
   subdiv_ccg_average_grids_corners(subdiv_ccg, key, adjacent_vertex);
 }
 
-static void subdiv_ccg_average_all_boundaries(SubdivCCG *subdiv_ccg, CCGKey *key)
+static void subdiv_ccg_average_boundaries(SubdivCCG *subdiv_ccg,
+                                          CCGKey *key,
+                                          const int *adjacent_edge_indices,
+                                          const int num_adjacent_edges)
 {
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
   AverageGridsBoundariesData boundaries_data = {
       .subdiv_ccg = subdiv_ccg,
       .key = key,
+      .adjacent_edge_indices = adjacent_edge_indices,
   };
   AverageGridsBoundariesTLSData tls_data = {NULL};
   parallel_range_settings.userdata_chunk = &tls_data;
   parallel_range_settings.userdata_chunk_size = sizeof(tls_data);
   parallel_range_settings.func_finalize = subdiv_ccg_average_grids_boundaries_finalize;
   BLI_task_parallel_range(0,
-                          subdiv_ccg->num_adjacent_edges,
+                          num_adjacent_edges,
                           &boundaries_data,
                           subdiv_ccg_average_grids_boundaries_task,
                           &parallel_range_settings);
 }
 
-static void subdiv_ccg_average_all_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
+static void subdiv_ccg_average_corners(SubdivCCG *subdiv_ccg,
+                                       CCGKey *key,
+                                       const int *adjacent_vertex_indices,
+                                       const int num_adjacent_vertices)
 {
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
   AverageGridsCornerData corner_data = {
       .subdiv_ccg = subdiv_ccg,
       .key = key,
+      .adjacent_vertex_indices = adjacent_vertex_indices,
   };
   BLI_task_parallel_range(0,
-                          subdiv_ccg->num_adjacent_vertices,
+                          num_adjacent_vertices,
                           &corner_data,
                           subdiv_ccg_average_grids_corners_task,
                           &parallel_range_settings);
@@ -1161,8 +1194,54 @@ static void subdiv_ccg_average_all_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
 
 static void subdiv_ccg_average_all_boundaries_and_corners(SubdivCCG *subdiv_ccg, CCGKey *key)
 {
-  subdiv_ccg_average_all_boundaries(subdiv_ccg, key);
-  subdiv_ccg_average_all_corners(subdiv_ccg, key);
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, NULL, subdiv_ccg->num_adjacent_edges);
+  subdiv_ccg_average_corners(subdiv_ccg, key, NULL, subdiv_ccg->num_adjacent_vertices);
+}
+
+/* Average boundaries and corners which are adjacent to the given faces only.
+ * Boundaries between two unchanged faces are known to be averaged already. */
+static void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG *subdiv_ccg,
+                                                            CCGKey *key,
+                                                            struct CCGFace **effected_faces,
+                                                            int num_effected_faces)
+{
+  SubdivCCGFace **faces = (SubdivCCGFace **)effected_faces;
+  int num_effected_grids = 0;
+  for (int i = 0; i < num_effected_faces; i++) {
+    num_effected_grids += faces[i]->num_grids;
+  }
+  BLI_bitmap *adjacent_edge_used_map = BLI_BITMAP_NEW(subdiv_ccg->num_adjacent_edges,
+                                                      "adjacent edges used map");
+  BLI_bitmap *adjacent_vertex_used_map = BLI_BITMAP_NEW(subdiv_ccg->num_adjacent_vertices,
+                                                        "adjacent vertices used map");
+  int *adjacent_edge_indices = MEM_malloc_arrayN(
+      num_effected_grids, sizeof(int), "effected adjacent edges");
+  int *adjacent_vertex_indices = MEM_malloc_arrayN(
+      num_effected_grids, sizeof(int), "effected adjacent vertices");
+  int num_adjacent_edges = 0;
+  int num_adjacent_vertices = 0;
+  for (int i = 0; i < num_effected_faces; i++) {
+    const SubdivCCGFace *face = faces[i];
+    for (int corner = 0; corner < face->num_grids; corner++) {
+      const int grid_index = face->start_grid_index + corner;
+      const int edge_index = subdiv_ccg->grid_adjacent_edges[grid_index];
+      const int vertex_index = subdiv_ccg->grid_adjacent_vertices[grid_index];
+      if (!BLI_BITMAP_TEST(adjacent_edge_used_map, edge_index)) {
+        BLI_BITMAP_ENABLE(adjacent_edge_used_map, edge_index);
+        adjacent_edge_indices[num_adjacent_edges++] = edge_index;
+      }
+      if (!BLI_BITMAP_TEST(adjacent_vertex_used_map, vertex_index)) {
+        BLI_BITMAP_ENABLE(adjacent_vertex_used_map, vertex_index);
+        adjacent_vertex_indices[num_adjacent_vertices++] = vertex_index;
+      }
+    }
+  }
+  subdiv_ccg_average_boundaries(subdiv_ccg, key, adjacent_edge_indices, num_adjacent_edges);
+  subdiv_ccg_average_corners(subdiv_ccg, key, adjacent_vertex_indices, num_adjacent_vertices);
+  MEM_freeN(adjacent_edge_used_map);
+  MEM_freeN(adjacent_vertex_used_map);
+  MEM_freeN(adjacent_edge_indices);
+  MEM_freeN(adjacent_vertex_indices);
 }
 
 void BKE_subdiv_ccg_average_grids(SubdivCCG *subdiv_ccg)
@@ -1223,9 +1302,8 @@ void BKE_subdiv_ccg_average_stitch_faces(SubdivCCG *subdiv_ccg,
                           &data,
                           subdiv_ccg_stitch_face_inner_grids_task,
                           &parallel_range_settings);
-  /* TODO(sergey): Only average elements which are adjacent to modified
-   * faces. */
-  subdiv_ccg_average_all_boundaries_and_corners(subdiv_ccg, &key);
+  subdiv_ccg_average_faces_boundaries_and_corners(
+      subdiv_ccg, &key, effected_faces, num_effected_faces);
 }
 
 void BKE_subdiv_ccg_topology_counters(const SubdivCCG *subdiv_ccg,
@@ -1429,24 +1507,7 @@ static void neighbor_coords_corner_center_get(const SubdivCCG *subdiv_ccg,
 static int adjacent_vertex_index_from_coord(const SubdivCCG *subdiv_ccg,
                                             const SubdivCCGCoord *coord)
 {
-  Subdiv *subdiv = subdiv_ccg->subdiv;
-  OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
-
-  const SubdivCCGFace *face = subdiv_ccg->grid_faces[coord->grid_index];
-  const int face_index = face - subdiv_ccg->faces;
-  const int face_grid_index = coord->grid_index - face->start_grid_index;
-  const int num_face_grids = face->num_grids;
-  const int num_face_vertices = num_face_grids;
-
-  StaticOrHeapIntStorage face_vertices_storage;
-  static_or_heap_storage_init(&face_vertices_storage);
-
-  int *face_vertices = static_or_heap_storage_get(&face_vertices_storage, num_face_vertices);
-  topology_refiner->getFaceVertices(topology_refiner, face_index, face_vertices);
-
-  const int adjacent_vertex_index = face_vertices[face_grid_index];
-  static_or_heap_storage_free(&face_vertices_storage);
-  return adjacent_vertex_index;
+  return subdiv_ccg->grid_adjacent_vertices[coord->grid_index];
 }
 
 /* The corner is adjacent to a coarse vertex. */
@@ -1517,18 +1578,9 @@ static void neighbor_coords_corner_vertex_get(const SubdivCCG *subdiv_ccg,
 
 static int adjacent_edge_index_from_coord(const SubdivCCG *subdiv_ccg, const SubdivCCGCoord *coord)
 {
-  Subdiv *subdiv = subdiv_ccg->subdiv;
-  OpenSubdiv_TopologyRefiner *topology_refiner = subdiv->topology_refiner;
-  SubdivCCGFace *face = subdiv_ccg->grid_faces[coord->grid_index];
-
+  const SubdivCCGFace *face = subdiv_ccg->grid_faces[coord->grid_index];
   const int face_grid_index = coord->grid_index - face->start_grid_index;
-  const int face_index = face - subdiv_ccg->faces;
-  const int num_face_edges = topology_refiner->getNumFaceEdges(topology_refiner, face_index);
-
-  StaticOrHeapIntStorage face_edges_storage;
-  static_or_heap_storage_init(&face_edges_storage);
-  int *face_edges_indices = static_or_heap_storage_get(&face_edges_storage, num_face_edges);
-  topology_refiner->getFaceEdges(topology_refiner, face_index, face_edges_indices);
+  const int *face_edges_indices = &subdiv_ccg->grid_adjacent_edges[face->start_grid_index];
 
   const int grid_size_1 = subdiv_ccg->grid_size - 1;
   int adjacent_edge_index = -1;
@@ -1541,8 +1593,6 @@ static int adjacent_edge_index_from_coord(const SubdivCCG *subdiv_ccg, const Sub
         face_edges_indices[face_grid_index == 0 ? face->num_grids - 1 : face_grid_index - 1];
   }
 
-  static_or_heap_storage_free(&face_edges_storage);
-
   return adjacent_edge_index;
 }
 
@@ -38,6 +38,11 @@ void BKE_subdiv_converter_init_for_mesh(struct OpenSubdiv_Converter *converter,
                                         const struct SubdivSettings *settings,
                                         const struct Mesh *mesh);
 
+/* Hash of everything the mesh converter feeds to the topology refiner, except for the element
+ * counts which are to be compared separately. */
+uint32_t BKE_subdiv_converter_mesh_topology_hash(const struct SubdivSettings *settings,
+                                                 const struct Mesh *mesh);
+
 /* NOTE: Frees converter data, but not converter itself. This means, that if
  * converter was allocated on heap, it is up to the user to free that memory. */
 void BKE_subdiv_converter_free(struct OpenSubdiv_Converter *converter);
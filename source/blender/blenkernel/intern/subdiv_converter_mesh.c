@@ -30,6 +30,7 @@
 
 #include "BLI_utildefines.h"
 #include "BLI_bitmap.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BKE_customdata.h"
 #include "BKE_mesh_mapping.h"
@@ -399,6 +400,39 @@ static void init_user_data(OpenSubdiv_Converter *converter,
   converter->user_data = user_data;
 }
 
+uint32_t BKE_subdiv_converter_mesh_topology_hash(const SubdivSettings *settings,
+                                                 const Mesh *mesh)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  const MPoly *mpoly = mesh->mpoly;
+  for (int poly_index = 0; poly_index < mesh->totpoly; poly_index++) {
+    BLI_hash_mm2a_add_int(&mm2, mpoly[poly_index].loopstart);
+    BLI_hash_mm2a_add_int(&mm2, mpoly[poly_index].totloop);
+  }
+  /* Loops only store vertex and edge indices. */
+  BLI_hash_mm2a_add(&mm2, (const unsigned char *)mesh->mloop, sizeof(MLoop) * mesh->totloop);
+  const MEdge *medge = mesh->medge;
+  for (int edge_index = 0; edge_index < mesh->totedge; edge_index++) {
+    BLI_hash_mm2a_add_int(&mm2, (int)medge[edge_index].v1);
+    BLI_hash_mm2a_add_int(&mm2, (int)medge[edge_index].v2);
+    if (settings->use_creases) {
+      BLI_hash_mm2a_add_int(&mm2, medge[edge_index].crease);
+    }
+  }
+  /* Face-varying topology is built from the UV coordinates, see precalc_uv_layer(). */
+  const int num_uv_layers = CustomData_number_of_layers(&mesh->ldata, CD_MLOOPUV);
+  BLI_hash_mm2a_add_int(&mm2, num_uv_layers);
+  for (int layer_index = 0; layer_index < num_uv_layers; layer_index++) {
+    const MLoopUV *mloopuv = CustomData_get_layer_n(&mesh->ldata, CD_MLOOPUV, layer_index);
+    for (int loop_index = 0; loop_index < mesh->totloop; loop_index++) {
+      BLI_hash_mm2a_add(
+          &mm2, (const unsigned char *)mloopuv[loop_index].uv, sizeof(mloopuv[loop_index].uv));
+    }
+  }
+  return BLI_hash_mm2a_end(&mm2);
+}
+
 void BKE_subdiv_converter_init_for_mesh(struct OpenSubdiv_Converter *converter,
                                         const SubdivSettings *settings,
                                         const Mesh *mesh)
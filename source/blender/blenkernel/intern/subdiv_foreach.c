@@ -29,7 +29,7 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_key_types.h"
 
-#include "BLI_bitmap.h"
+#include "BLI_math_vector.h"
 #include "BLI_task.h"
 
 #include "BKE_customdata.h"
@@ -75,6 +75,21 @@ BLI_INLINE int ptex_face_resolution_get(const MPoly *poly, int resolution)
   return (poly->totloop == 4) ? (resolution) : ((resolution >> 1) + 1);
 }
 
+/* Owner of coarse geometry which is not used by any polygon. */
+#define NO_OWNER_POLY INT_MAX
+
+BLI_INLINE void atomic_min_int32(int *value, const int new_value)
+{
+  int old_value = *value;
+  while (new_value < old_value) {
+    const int prev_value = atomic_cas_int32(value, old_value, new_value);
+    if (prev_value == old_value) {
+      break;
+    }
+    old_value = prev_value;
+  }
+}
+
 /* =============================================================================
  * Context which is passed to all threaded tasks.
  */
@@ -108,18 +123,14 @@ typedef struct SubdivForeachTaskContext {
    * created for preceding base faces.
    */
   int *face_ptex_offset;
-  /* Bitmap indicating whether vertex was used already or not.
-   * - During patch evaluation indicates whether coarse vertex was already
-   *   evaluated and its position on limit is already known.
-   */
-  BLI_bitmap *coarse_vertices_used_map;
-  /* Bitmap indicating whether edge was used already or not. This includes:
-   * - During context initialization it indicates whether subdivided vertices
-   *   for corresponding edge were already calculated or not.
-   * - During patch evaluation it indicates whether vertices along this edge
-   *   were already evaluated.
+  /* Indexed by coarse vertex index, lowest index of the polygon which uses the vertex.
+   * Callbacks for the geometry which is shared between polygons are only run for the owner
+   * polygon, so they can be run from threads without any synchronization.
+   * Loose vertices have no owner (#NO_OWNER_POLY).
    */
-  BLI_bitmap *coarse_edges_used_map;
+  int *coarse_vertex_owner_poly;
+  /* Same as above, but for coarse edges. */
+  int *coarse_edge_owner_poly;
 } SubdivForeachTaskContext;
 
 /* =============================================================================
@@ -152,78 +163,56 @@ static void subdiv_foreach_tls_free(SubdivForeachTaskContext *ctx, void *tls)
  * Initialization.
  */
 
-/* NOTE: Expects edge map to be zeroed. */
-static void subdiv_foreach_ctx_count(SubdivForeachTaskContext *ctx)
+/* Calculate number of subdivided geometry which is created for the given coarse polygon and
+ * claim the coarse vertices and edges of the polygon. */
+static void subdiv_foreach_ctx_layout_task(void *__restrict userdata,
+                                           const int poly_index,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  /* Reset counters. */
-  ctx->num_subdiv_vertices = 0;
-  ctx->num_subdiv_edges = 0;
-  ctx->num_subdiv_loops = 0;
-  ctx->num_subdiv_polygons = 0;
-  /* Static geometry counters. */
+  SubdivForeachTaskContext *ctx = userdata;
   const int resolution = ctx->settings->resolution;
+  const int resolution_2 = resolution - 2;
   const int no_quad_patch_resolution = ((resolution >> 1) + 1);
+  const int num_irregular_vertices_per_patch = (no_quad_patch_resolution - 2) *
+                                               (no_quad_patch_resolution - 1);
   const int num_subdiv_vertices_per_coarse_edge = resolution - 2;
-  const int num_inner_vertices_per_quad = (resolution - 2) * (resolution - 2);
-  const int num_inner_vertices_per_noquad_patch = (no_quad_patch_resolution - 2) *
-                                                  (no_quad_patch_resolution - 2);
   const Mesh *coarse_mesh = ctx->coarse_mesh;
-  const MLoop *coarse_mloop = coarse_mesh->mloop;
-  const MPoly *coarse_mpoly = coarse_mesh->mpoly;
-  ctx->num_subdiv_vertices = coarse_mesh->totvert;
-  ctx->num_subdiv_edges = coarse_mesh->totedge * (num_subdiv_vertices_per_coarse_edge + 1);
-  /* Calculate extra vertices and edges created by non-loose geometry. */
-  for (int poly_index = 0; poly_index < coarse_mesh->totpoly; poly_index++) {
-    const MPoly *coarse_poly = &coarse_mpoly[poly_index];
-    const int num_ptex_faces_per_poly = num_ptex_faces_per_poly_get(coarse_poly);
-    for (int corner = 0; corner < coarse_poly->totloop; corner++) {
-      const MLoop *loop = &coarse_mloop[coarse_poly->loopstart + corner];
-      const bool is_edge_used = BLI_BITMAP_TEST_BOOL(ctx->coarse_edges_used_map, loop->e);
-      /* Edges which aren't counted yet. */
-      if (!is_edge_used) {
-        BLI_BITMAP_ENABLE(ctx->coarse_edges_used_map, loop->e);
-        ctx->num_subdiv_vertices += num_subdiv_vertices_per_coarse_edge;
-      }
-    }
-    /* Inner vertices of polygon. */
-    if (num_ptex_faces_per_poly == 1) {
-      ctx->num_subdiv_vertices += num_inner_vertices_per_quad;
-      ctx->num_subdiv_edges += num_edges_per_ptex_face_get(resolution - 2) +
-                               4 * num_subdiv_vertices_per_coarse_edge;
-      ctx->num_subdiv_polygons += num_polys_per_ptex_get(resolution);
-    }
-    else {
-      ctx->num_subdiv_vertices += 1 + num_ptex_faces_per_poly * (no_quad_patch_resolution - 2) +
-                                  num_ptex_faces_per_poly * num_inner_vertices_per_noquad_patch;
-      ctx->num_subdiv_edges += num_ptex_faces_per_poly *
-                               (num_inner_edges_per_ptex_face_get(no_quad_patch_resolution - 1) +
-                                (no_quad_patch_resolution - 2) +
-                                num_subdiv_vertices_per_coarse_edge);
-      if (no_quad_patch_resolution >= 3) {
-        ctx->num_subdiv_edges += coarse_poly->totloop;
-      }
-      ctx->num_subdiv_polygons += num_ptex_faces_per_poly *
-                                  num_polys_per_ptex_get(no_quad_patch_resolution);
-    }
+  const MPoly *coarse_poly = &coarse_mesh->mpoly[poly_index];
+  const MLoop *coarse_mloop = &coarse_mesh->mloop[coarse_poly->loopstart];
+  const int num_ptex_faces_per_poly = num_ptex_faces_per_poly_get(coarse_poly);
+  int num_vertices, num_edges, num_polygons;
+  if (num_ptex_faces_per_poly == 1) {
+    num_vertices = resolution_2 * resolution_2;
+    num_edges = num_edges_per_ptex_face_get(resolution - 2) +
+                4 * num_subdiv_vertices_per_coarse_edge;
+    num_polygons = num_polys_per_ptex_get(resolution);
   }
-  /* Calculate extra vertices created by loose edges. */
-  for (int edge_index = 0; edge_index < coarse_mesh->totedge; edge_index++) {
-    if (!BLI_BITMAP_TEST_BOOL(ctx->coarse_edges_used_map, edge_index)) {
-      ctx->num_subdiv_vertices += num_subdiv_vertices_per_coarse_edge;
+  else {
+    num_vertices = 1 + num_ptex_faces_per_poly * num_irregular_vertices_per_patch;
+    num_edges = num_ptex_faces_per_poly *
+                (num_inner_edges_per_ptex_face_get(no_quad_patch_resolution - 1) +
+                 (no_quad_patch_resolution - 2) + num_subdiv_vertices_per_coarse_edge);
+    if (no_quad_patch_resolution >= 3) {
+      num_edges += coarse_poly->totloop;
     }
+    num_polygons = num_ptex_faces_per_poly * num_polys_per_ptex_get(no_quad_patch_resolution);
+  }
+  /* Sizes are converted to offsets once all polygons are handled. */
+  ctx->subdiv_vertex_offset[poly_index] = num_vertices;
+  ctx->subdiv_edge_offset[poly_index] = num_edges;
+  ctx->subdiv_polygon_offset[poly_index] = num_polygons;
+  /* Lowest polygon index wins, which gives the same owners as a serial traversal. */
+  for (int corner = 0; corner < coarse_poly->totloop; corner++) {
+    const MLoop *coarse_loop = &coarse_mloop[corner];
+    atomic_min_int32(&ctx->coarse_vertex_owner_poly[coarse_loop->v], poly_index);
+    atomic_min_int32(&ctx->coarse_edge_owner_poly[coarse_loop->e], poly_index);
   }
-  ctx->num_subdiv_loops = ctx->num_subdiv_polygons * 4;
 }
 
 static void subdiv_foreach_ctx_init_offsets(SubdivForeachTaskContext *ctx)
 {
   const Mesh *coarse_mesh = ctx->coarse_mesh;
   const int resolution = ctx->settings->resolution;
-  const int resolution_2 = resolution - 2;
-  const int resolution_2_squared = resolution_2 * resolution_2;
-  const int no_quad_patch_resolution = ((resolution >> 1) + 1);
-  const int num_irregular_vertices_per_patch = (no_quad_patch_resolution - 2) *
-                                               (no_quad_patch_resolution - 1);
   const int num_subdiv_vertices_per_coarse_edge = resolution - 2;
   const int num_subdiv_edges_per_coarse_edge = resolution - 1;
   /* Constant offsets in arrays. */
@@ -234,61 +223,61 @@ static void subdiv_foreach_ctx_init_offsets(SubdivForeachTaskContext *ctx)
   ctx->edge_boundary_offset = 0;
   ctx->edge_inner_offset = ctx->edge_boundary_offset +
                            coarse_mesh->totedge * num_subdiv_edges_per_coarse_edge;
-  /* "Indexed" offsets. */
-  const MPoly *coarse_mpoly = coarse_mesh->mpoly;
+  /* "Indexed" offsets: sizes of every polygon are calculated from threads, followed by an
+   * exclusive prefix sum over them. */
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  parallel_range_settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(
+      0, coarse_mesh->totpoly, ctx, subdiv_foreach_ctx_layout_task, &parallel_range_settings);
   int vertex_offset = 0;
   int edge_offset = 0;
   int polygon_offset = 0;
   for (int poly_index = 0; poly_index < coarse_mesh->totpoly; poly_index++) {
-    const MPoly *coarse_poly = &coarse_mpoly[poly_index];
-    const int num_ptex_faces_per_poly = num_ptex_faces_per_poly_get(coarse_poly);
+    const int num_vertices = ctx->subdiv_vertex_offset[poly_index];
+    const int num_edges = ctx->subdiv_edge_offset[poly_index];
+    const int num_polygons = ctx->subdiv_polygon_offset[poly_index];
     ctx->subdiv_vertex_offset[poly_index] = vertex_offset;
     ctx->subdiv_edge_offset[poly_index] = edge_offset;
     ctx->subdiv_polygon_offset[poly_index] = polygon_offset;
-    if (num_ptex_faces_per_poly == 1) {
-      vertex_offset += resolution_2_squared;
-      edge_offset += num_edges_per_ptex_face_get(resolution - 2) +
-                     4 * num_subdiv_vertices_per_coarse_edge;
-      polygon_offset += num_polys_per_ptex_get(resolution);
-    }
-    else {
-      vertex_offset += 1 + num_ptex_faces_per_poly * num_irregular_vertices_per_patch;
-      edge_offset += num_ptex_faces_per_poly *
-                     (num_inner_edges_per_ptex_face_get(no_quad_patch_resolution - 1) +
-                      (no_quad_patch_resolution - 2) + num_subdiv_vertices_per_coarse_edge);
-      if (no_quad_patch_resolution >= 3) {
-        edge_offset += coarse_poly->totloop;
-      }
-      polygon_offset += num_ptex_faces_per_poly * num_polys_per_ptex_get(no_quad_patch_resolution);
-    }
+    vertex_offset += num_vertices;
+    edge_offset += num_edges;
+    polygon_offset += num_polygons;
   }
+  /* Every coarse edge has the same number of subdivided vertices and edges, regardless of
+   * whether it's loose or not, so the totals follow from the offsets. */
+  ctx->num_subdiv_vertices = ctx->vertices_inner_offset + vertex_offset;
+  ctx->num_subdiv_edges = ctx->edge_inner_offset + edge_offset;
+  ctx->num_subdiv_polygons = polygon_offset;
+  ctx->num_subdiv_loops = polygon_offset * 4;
 }
 
 static void subdiv_foreach_ctx_init(Subdiv *subdiv, SubdivForeachTaskContext *ctx)
 {
   const Mesh *coarse_mesh = ctx->coarse_mesh;
   /* Allocate maps and offsets. */
-  ctx->coarse_vertices_used_map = BLI_BITMAP_NEW(coarse_mesh->totvert, "vertices used map");
-  ctx->coarse_edges_used_map = BLI_BITMAP_NEW(coarse_mesh->totedge, "edges used map");
+  ctx->coarse_vertex_owner_poly = MEM_malloc_arrayN(
+      coarse_mesh->totvert, sizeof(*ctx->coarse_vertex_owner_poly), "vertex owner poly");
+  ctx->coarse_edge_owner_poly = MEM_malloc_arrayN(
+      coarse_mesh->totedge, sizeof(*ctx->coarse_edge_owner_poly), "edge owner poly");
+  copy_vn_i(ctx->coarse_vertex_owner_poly, coarse_mesh->totvert, NO_OWNER_POLY);
+  copy_vn_i(ctx->coarse_edge_owner_poly, coarse_mesh->totedge, NO_OWNER_POLY);
   ctx->subdiv_vertex_offset = MEM_malloc_arrayN(
       coarse_mesh->totpoly, sizeof(*ctx->subdiv_vertex_offset), "vertex_offset");
   ctx->subdiv_edge_offset = MEM_malloc_arrayN(
       coarse_mesh->totpoly, sizeof(*ctx->subdiv_edge_offset), "subdiv_edge_offset");
   ctx->subdiv_polygon_offset = MEM_malloc_arrayN(
       coarse_mesh->totpoly, sizeof(*ctx->subdiv_polygon_offset), "subdiv_edge_offset");
-  /* Initialize all offsets. */
+  /* Initialize all offsets, number of geometry in the result subdivision mesh and owners of
+   * the coarse vertices and edges. */
   subdiv_foreach_ctx_init_offsets(ctx);
-  /* Calculate number of geometry in the result subdivision mesh. */
-  subdiv_foreach_ctx_count(ctx);
-  /* Re-set maps which were used at this step. */
-  BLI_bitmap_set_all(ctx->coarse_edges_used_map, false, coarse_mesh->totedge);
   ctx->face_ptex_offset = BKE_subdiv_face_ptex_offset_get(subdiv);
 }
 
 static void subdiv_foreach_ctx_free(SubdivForeachTaskContext *ctx)
 {
-  MEM_freeN(ctx->coarse_vertices_used_map);
-  MEM_freeN(ctx->coarse_edges_used_map);
+  MEM_freeN(ctx->coarse_vertex_owner_poly);
+  MEM_freeN(ctx->coarse_edge_owner_poly);
   MEM_freeN(ctx->subdiv_vertex_offset);
   MEM_freeN(ctx->subdiv_edge_offset);
   MEM_freeN(ctx->subdiv_polygon_offset);
@@ -314,8 +303,7 @@ static void subdiv_foreach_corner_vertices_regular_do(
   const int ptex_face_index = ctx->face_ptex_offset[coarse_poly_index];
   for (int corner = 0; corner < coarse_poly->totloop; corner++) {
     const MLoop *coarse_loop = &coarse_mloop[coarse_poly->loopstart + corner];
-    if (check_usage &&
-        BLI_BITMAP_TEST_AND_SET_ATOMIC(ctx->coarse_vertices_used_map, coarse_loop->v)) {
+    if (check_usage && ctx->coarse_vertex_owner_poly[coarse_loop->v] != coarse_poly_index) {
       continue;
     }
     const int coarse_vertex_index = coarse_loop->v;
@@ -355,8 +343,7 @@ static void subdiv_foreach_corner_vertices_special_do(
   int ptex_face_index = ctx->face_ptex_offset[coarse_poly_index];
   for (int corner = 0; corner < coarse_poly->totloop; corner++, ptex_face_index++) {
     const MLoop *coarse_loop = &coarse_mloop[coarse_poly->loopstart + corner];
-    if (check_usage &&
-        BLI_BITMAP_TEST_AND_SET_ATOMIC(ctx->coarse_vertices_used_map, coarse_loop->v)) {
+    if (check_usage && ctx->coarse_vertex_owner_poly[coarse_loop->v] != coarse_poly_index) {
       continue;
     }
     const int coarse_vertex_index = coarse_loop->v;
@@ -449,8 +436,7 @@ static void subdiv_foreach_edge_vertices_regular_do(SubdivForeachTaskContext *ct
   for (int corner = 0; corner < coarse_poly->totloop; corner++) {
     const MLoop *coarse_loop = &coarse_mloop[coarse_poly->loopstart + corner];
     const int coarse_edge_index = coarse_loop->e;
-    if (check_usage &&
-        BLI_BITMAP_TEST_AND_SET_ATOMIC(ctx->coarse_edges_used_map, coarse_edge_index)) {
+    if (check_usage && ctx->coarse_edge_owner_poly[coarse_edge_index] != coarse_poly_index) {
       continue;
     }
     const MEdge *coarse_edge = &coarse_medge[coarse_edge_index];
@@ -517,8 +503,7 @@ static void subdiv_foreach_edge_vertices_special_do(SubdivForeachTaskContext *ct
   for (int corner = 0; corner < coarse_poly->totloop; corner++, ptex_face_index++) {
     const MLoop *coarse_loop = &coarse_mloop[coarse_poly->loopstart + corner];
     const int coarse_edge_index = coarse_loop->e;
-    if (check_usage &&
-        BLI_BITMAP_TEST_AND_SET_ATOMIC(ctx->coarse_edges_used_map, coarse_edge_index)) {
+    if (check_usage && ctx->coarse_edge_owner_poly[coarse_edge_index] != coarse_poly_index) {
       continue;
     }
     const MEdge *coarse_edge = &coarse_medge[coarse_edge_index];
@@ -1684,7 +1669,7 @@ static void subdiv_foreach_loose_vertices_task(void *__restrict userdata,
                                                const TaskParallelTLS *__restrict tls)
 {
   SubdivForeachTaskContext *ctx = userdata;
-  if (BLI_BITMAP_TEST_BOOL(ctx->coarse_vertices_used_map, coarse_vertex_index)) {
+  if (ctx->coarse_vertex_owner_poly[coarse_vertex_index] != NO_OWNER_POLY) {
     /* Vertex is not loose, was handled when handling polygons. */
     return;
   }
@@ -1698,7 +1683,7 @@ static void subdiv_foreach_vertices_of_loose_edges_task(void *__restrict userdat
                                                         const TaskParallelTLS *__restrict tls)
 {
   SubdivForeachTaskContext *ctx = userdata;
-  if (BLI_BITMAP_TEST_BOOL(ctx->coarse_edges_used_map, coarse_edge_index)) {
+  if (ctx->coarse_edge_owner_poly[coarse_edge_index] != NO_OWNER_POLY) {
     /* Vertex is not loose, was handled when handling polygons. */
     return;
   }
@@ -1736,20 +1721,6 @@ static void subdiv_foreach_vertices_of_loose_edges_task(void *__restrict userdat
  * Subdivision process entry points.
  */
 
-static void subdiv_foreach_single_geometry_vertices(SubdivForeachTaskContext *ctx, void *tls)
-{
-  if (ctx->foreach_context->vertex_corner == NULL) {
-    return;
-  }
-  const Mesh *coarse_mesh = ctx->coarse_mesh;
-  const MPoly *coarse_mpoly = coarse_mesh->mpoly;
-  for (int poly_index = 0; poly_index < coarse_mesh->totpoly; poly_index++) {
-    const MPoly *coarse_poly = &coarse_mpoly[poly_index];
-    subdiv_foreach_corner_vertices(ctx, tls, coarse_poly);
-    subdiv_foreach_edge_vertices(ctx, tls, coarse_poly);
-  }
-}
-
 static void subdiv_foreach_single_thread_tasks(SubdivForeachTaskContext *ctx)
 {
   /* NOTE: In theory, we can try to skip allocation of TLS here, but in
@@ -1760,8 +1731,6 @@ static void subdiv_foreach_single_thread_tasks(SubdivForeachTaskContext *ctx)
    * and boundary edges. */
   subdiv_foreach_every_corner_vertices(ctx, tls);
   subdiv_foreach_every_edge_vertices(ctx, tls);
-  /* Run callbacks which are supposed to be run once per shared geometry. */
-  subdiv_foreach_single_geometry_vertices(ctx, tls);
   subdiv_foreach_tls_free(ctx, tls);
 }
 
@@ -1770,6 +1739,15 @@ static void subdiv_foreach_task(void *__restrict userdata,
                                 const TaskParallelTLS *__restrict tls)
 {
   SubdivForeachTaskContext *ctx = userdata;
+  const MPoly *coarse_poly = &ctx->coarse_mesh->mpoly[poly_index];
+  /* Run callbacks which are supposed to be run once per shared geometry,
+   * only done by the polygon which owns the geometry. */
+  if (ctx->foreach_context->vertex_corner != NULL) {
+    subdiv_foreach_corner_vertices(ctx, tls->userdata_chunk, coarse_poly);
+  }
+  if (ctx->foreach_context->vertex_edge != NULL) {
+    subdiv_foreach_edge_vertices(ctx, tls->userdata_chunk, coarse_poly);
+  }
   /* Traverse hi-poly vertex coordinates and normals. */
   subdiv_foreach_vertices(ctx, tls->userdata_chunk, poly_index);
   /* Traverse mesh geometry for the given base poly index. */
@@ -1818,7 +1796,8 @@ bool BKE_subdiv_foreach_subdiv_geometry(Subdiv *subdiv,
       return false;
     }
   }
-  /* Run all the code which is not supposed to be run from threads. */
+  /* Run all the code which is not supposed to be run from threads: accumulation on the
+   * geometry which is shared between polygons. */
   subdiv_foreach_single_thread_tasks(&ctx);
   /* Threaded traversal of the rest of topology. */
   TaskParallelSettings parallel_range_settings;
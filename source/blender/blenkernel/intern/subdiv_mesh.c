@@ -31,6 +31,7 @@
 
 #include "BLI_alloca.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 #include "BKE_mesh.h"
@@ -41,6 +42,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
+
 /* =============================================================================
  * Subdivision context.
  */
@@ -76,6 +79,11 @@ typedef struct SubdivMeshContext {
    * when it's not possible is when displacement is used. */
   bool can_evaluate_normals;
   bool have_displacement;
+  /* Patch coordinates of inner vertices, which are evaluated in batches once the traversal is
+   * done (ptex face is -1 for the other vertices). NULL when displacement is used, in which case
+   * the inner vertices are evaluated during the traversal. */
+  OpenSubdiv_PatchCoord *inner_vertex_patch_coords;
+  int num_vertices;
 } SubdivMeshContext;
 
 static void subdiv_mesh_ctx_cache_uv_layers(SubdivMeshContext *ctx)
@@ -113,10 +121,25 @@ static void subdiv_mesh_prepare_accumulator(SubdivMeshContext *ctx, int num_vert
       sizeof(*ctx->accumulated_counters), num_vertices, "subdiv accumulated counters");
 }
 
+static void subdiv_mesh_prepare_inner_vertex_patch_coords(SubdivMeshContext *ctx,
+                                                          int num_vertices)
+{
+  ctx->num_vertices = num_vertices;
+  if (ctx->have_displacement) {
+    return;
+  }
+  ctx->inner_vertex_patch_coords = MEM_malloc_arrayN(
+      num_vertices, sizeof(*ctx->inner_vertex_patch_coords), "subdiv inner patch coords");
+  for (int i = 0; i < num_vertices; i++) {
+    ctx->inner_vertex_patch_coords[i].ptex_face = -1;
+  }
+}
+
 static void subdiv_mesh_context_free(SubdivMeshContext *ctx)
 {
   MEM_SAFE_FREE(ctx->accumulated_normals);
   MEM_SAFE_FREE(ctx->accumulated_counters);
+  MEM_SAFE_FREE(ctx->inner_vertex_patch_coords);
 }
 
 /* =============================================================================
@@ -510,6 +533,7 @@ static bool subdiv_mesh_topology_info(const SubdivForeachContext *foreach_contex
       subdiv_context->coarse_mesh, num_vertices, num_edges, 0, num_loops, num_polygons, mask);
   subdiv_mesh_ctx_cache_custom_data_layers(subdiv_context);
   subdiv_mesh_prepare_accumulator(subdiv_context, num_vertices);
+  subdiv_mesh_prepare_inner_vertex_patch_coords(subdiv_context, num_vertices);
   return true;
 }
 
@@ -773,11 +797,80 @@ static void subdiv_mesh_vertex_inner(const SubdivForeachContext *foreach_context
   MVert *subdiv_vert = &subdiv_mvert[subdiv_vertex_index];
   subdiv_mesh_ensure_vertex_interpolation(ctx, tls, coarse_poly, coarse_corner);
   subdiv_vertex_data_interpolate(ctx, subdiv_vert, &tls->vertex_interpolation, u, v);
-  eval_final_point_and_vertex_normal(
-      subdiv, ptex_face_index, u, v, subdiv_vert->co, subdiv_vert->no);
+  if (ctx->inner_vertex_patch_coords != NULL) {
+    /* Evaluated later, see subdiv_mesh_evaluate_inner_vertices(). */
+    OpenSubdiv_PatchCoord *patch_coord = &ctx->inner_vertex_patch_coords[subdiv_vertex_index];
+    patch_coord->ptex_face = ptex_face_index;
+    patch_coord->u = u;
+    patch_coord->v = v;
+  }
+  else {
+    eval_final_point_and_vertex_normal(
+        subdiv, ptex_face_index, u, v, subdiv_vert->co, subdiv_vert->no);
+  }
   subdiv_mesh_tag_center_vertex(coarse_poly, subdiv_vert, u, v);
 }
 
+/* =============================================================================
+ * Batched evaluation of inner vertices.
+ */
+
+/* Number of vertices evaluated by a single batch. */
+#define INNER_VERTICES_BATCH_SIZE 1024
+
+static void subdiv_mesh_evaluate_inner_vertices_batch(
+    void *__restrict userdata,
+    const int batch_index,
+    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SubdivMeshContext *ctx = userdata;
+  MVert *subdiv_mvert = ctx->subdiv_mesh->mvert;
+  const int start_vertex_index = batch_index * INNER_VERTICES_BATCH_SIZE;
+  const int end_vertex_index = min_ii(start_vertex_index + INNER_VERTICES_BATCH_SIZE,
+                                      ctx->num_vertices);
+  OpenSubdiv_PatchCoord patch_coords[INNER_VERTICES_BATCH_SIZE];
+  int vertex_indices[INNER_VERTICES_BATCH_SIZE];
+  int num_patch_coords = 0;
+  for (int i = start_vertex_index; i < end_vertex_index; i++) {
+    if (ctx->inner_vertex_patch_coords[i].ptex_face != -1) {
+      patch_coords[num_patch_coords] = ctx->inner_vertex_patch_coords[i];
+      vertex_indices[num_patch_coords] = i;
+      num_patch_coords++;
+    }
+  }
+  if (num_patch_coords == 0) {
+    return;
+  }
+  float(*P)[3] = MEM_malloc_arrayN(num_patch_coords * 3, sizeof(*P), __func__);
+  float(*dPdu)[3] = P + num_patch_coords;
+  float(*dPdv)[3] = dPdu + num_patch_coords;
+  BKE_subdiv_eval_limit_patch_coords_point_and_derivatives(
+      ctx->subdiv, patch_coords, num_patch_coords, P, dPdu, dPdv);
+  for (int i = 0; i < num_patch_coords; i++) {
+    MVert *subdiv_vert = &subdiv_mvert[vertex_indices[i]];
+    float N[3];
+    copy_v3_v3(subdiv_vert->co, P[i]);
+    cross_v3_v3v3(N, dPdu[i], dPdv[i]);
+    normalize_v3(N);
+    normal_float_to_short_v3(subdiv_vert->no, N);
+  }
+  MEM_freeN(P);
+}
+
+static void subdiv_mesh_evaluate_inner_vertices(SubdivMeshContext *ctx)
+{
+  if (ctx->inner_vertex_patch_coords == NULL) {
+    return;
+  }
+  const int num_batches = (ctx->num_vertices + INNER_VERTICES_BATCH_SIZE - 1) /
+                          INNER_VERTICES_BATCH_SIZE;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, num_batches, ctx, subdiv_mesh_evaluate_inner_vertices_batch, &settings);
+}
+
 /* =============================================================================
  * Edge subdivision process.
  */
@@ -1192,6 +1285,7 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
   foreach_context.user_data_tls_size = sizeof(SubdivMeshTLS);
   foreach_context.user_data_tls = &tls;
   BKE_subdiv_foreach_subdiv_geometry(subdiv, &foreach_context, settings, coarse_mesh);
+  subdiv_mesh_evaluate_inner_vertices(&subdiv_context);
   BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
   Mesh *result = subdiv_context.subdiv_mesh;
   // BKE_mesh_validate(result, true, true);
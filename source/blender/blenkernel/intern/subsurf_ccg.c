@@ -2230,35 +2230,33 @@ static void set_ccgdm_all_geometry(CCGDerivedMesh *ccgdm,
 
     vertNum++;
 
-    /*interpolate per-vert data*/
+    /*interpolate per-vert data, the weights of a row of vertices are consecutive*/
     for (s = 0; s < numVerts; s++) {
-      for (x = 1; x < gridFaces; x++) {
-        w2 = w + s * numVerts * g2_wid * g2_wid + x * numVerts;
-        DM_interp_vert_data(dm, &ccgdm->dm, vertidx, w2, numVerts, vertNum);
-
-        if (vertOrigIndex) {
-          *vertOrigIndex = ORIGINDEX_NONE;
-          vertOrigIndex++;
-        }
+      w2 = w + s * numVerts * g2_wid * g2_wid + numVerts;
+      CustomData_interp_range(
+          &dm->vertData, &ccgdm->dm.vertData, vertidx, w2, numVerts, vertNum, gridFaces - 1);
 
-        vertNum++;
+      if (vertOrigIndex) {
+        copy_vn_i(vertOrigIndex, gridFaces - 1, ORIGINDEX_NONE);
+        vertOrigIndex += gridFaces - 1;
       }
+
+      vertNum += gridFaces - 1;
     }
 
     /*interpolate per-vert data*/
     for (s = 0; s < numVerts; s++) {
       for (y = 1; y < gridFaces; y++) {
-        for (x = 1; x < gridFaces; x++) {
-          w2 = w + s * numVerts * g2_wid * g2_wid + (y * g2_wid + x) * numVerts;
-          DM_interp_vert_data(dm, &ccgdm->dm, vertidx, w2, numVerts, vertNum);
-
-          if (vertOrigIndex) {
-            *vertOrigIndex = ORIGINDEX_NONE;
-            vertOrigIndex++;
-          }
+        w2 = w + s * numVerts * g2_wid * g2_wid + (y * g2_wid + 1) * numVerts;
+        CustomData_interp_range(
+            &dm->vertData, &ccgdm->dm.vertData, vertidx, w2, numVerts, vertNum, gridFaces - 1);
 
-          vertNum++;
+        if (vertOrigIndex) {
+          copy_vn_i(vertOrigIndex, gridFaces - 1, ORIGINDEX_NONE);
+          vertOrigIndex += gridFaces - 1;
         }
+
+        vertNum += gridFaces - 1;
       }
     }
 
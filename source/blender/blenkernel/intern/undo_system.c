@@ -155,7 +155,9 @@ static bool undosys_step_encode(bContext *C, Main *bmain, UndoStack *ustack, Und
 {
   CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
   UNDO_NESTED_CHECK_BEGIN;
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_UNDO);
   bool ok = us->type->step_encode(C, bmain, us);
+  MEM_category_end(category_prev);
   UNDO_NESTED_CHECK_END;
   if (ok) {
     if (us->type->step_foreach_ID_ref != NULL) {
@@ -445,6 +447,40 @@ void BKE_undosys_stack_limit_steps_and_memory(UndoStack *ustack, int steps, size
   }
 }
 
+/**
+ * Spill the oldest steps to disk (when their type supports it),
+ * so the data kept in memory fits in \a memory_limit without losing undo history.
+ *
+ * \note Call before #BKE_undosys_stack_limit_steps_and_memory,
+ * so only the steps which can't be spilled are freed.
+ */
+void BKE_undosys_stack_spill_steps(UndoStack *ustack, size_t memory_limit)
+{
+  UNDO_NESTED_ASSERT(false);
+  if (memory_limit == 0) {
+    return;
+  }
+
+  UndoStep *us;
+  size_t data_size_all = 0;
+  for (us = ustack->steps.last; us; us = us->prev) {
+    data_size_all += us->data_size;
+    if (data_size_all > memory_limit) {
+      break;
+    }
+  }
+
+  for (; us; us = us->prev) {
+    /* The active steps are needed to undo and redo (or to push the next step). */
+    if ((us->type->step_spill == NULL) || (us == ustack->step_active) ||
+        (us == ustack->step_active_memfile)) {
+      continue;
+    }
+    CLOG_INFO(&LOG, 1, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
+    us->type->step_spill(us);
+  }
+}
+
 /** \} */
 
 UndoStep *BKE_undosys_step_push_init_with_type(UndoStack *ustack,
@@ -37,6 +37,7 @@
 #  endif
 
 #  include "BLI_math_base.h"
+#  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_global.h"
@@ -50,6 +51,8 @@
 
 #  include "IMB_imbuf.h"
 
+#  include "atomic_ops.h"
+
 /* This needs to be included after BLI_math_base.h otherwise it will redefine some math defines
  * like M_SQRT1_2 leading to warnings with MSVC */
 #  include <libavformat/avformat.h>
@@ -103,10 +106,27 @@ typedef struct FFMpegContext {
 #  ifdef WITH_AUDASPACE
   AUD_Device *audio_mixdown_device;
 #  endif
+
+  /* Frames are converted and encoded on a thread of their own while the next frame renders,
+   * see #ffmpeg_encode_thread. NULL when encoding on the render thread. */
+  ThreadQueue *encode_queue;
+  ListBase encode_threads;
+  int encode_failed;
 } FFMpegContext;
 
+/* Frame queued for #ffmpeg_encode_thread, the pixels are a copy owned by the item. */
+typedef struct FFMpegEncodeItem {
+  RenderData *rd;
+  int frame;
+  uint8_t *pixels;
+  double audio_time;
+} FFMpegEncodeItem;
+
 #  define FFMPEG_AUTOSPLIT_SIZE 2000000000
 
+/* Rendered frames waiting for the encoder, limits the memory used when rendering is faster. */
+#  define FFMPEG_ENCODE_QUEUE_MAX 4
+
 #  define PRINT \
     if (G.debug & G_DEBUG_FFMPEG) \
     printf
@@ -114,6 +134,7 @@ typedef struct FFMpegContext {
 static void ffmpeg_dict_set_int(AVDictionary **dict, const char *key, int value);
 static void ffmpeg_dict_set_float(AVDictionary **dict, const char *key, float value);
 static void ffmpeg_set_expert_options(RenderData *rd);
+static void ffmpeg_encode_thread_start(FFMpegContext *context);
 static void ffmpeg_filepath_get(
     FFMpegContext *context, char *string, struct RenderData *rd, bool preview, const char *suffix);
 
@@ -1339,6 +1360,9 @@ int BKE_ffmpeg_start(void *context_v,
 #    endif
   }
 #  endif
+  if (success) {
+    ffmpeg_encode_thread_start(context);
+  }
   return success;
 }
 
@@ -1357,6 +1381,94 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
+static int ffmpeg_encode_frame(FFMpegContext *context,
+                               RenderData *rd,
+                               int frame,
+                               const uint8_t *pixels,
+                               ReportList *reports)
+{
+  AVFrame *avframe = generate_video_frame(context, pixels, reports);
+  return (avframe && write_video_frame(context, rd, frame, avframe, reports));
+}
+
+static void *ffmpeg_encode_thread(void *context_v)
+{
+  FFMpegContext *context = context_v;
+  FFMpegEncodeItem *item;
+
+  /* Audio is written here as well, packets of the output file are written by one thread. */
+  while ((item = BLI_thread_queue_pop(context->encode_queue))) {
+    if (!ffmpeg_encode_frame(context, item->rd, item->frame, item->pixels, NULL)) {
+      atomic_fetch_and_or_int32(&context->encode_failed, 1);
+    }
+#  ifdef WITH_AUDASPACE
+    write_audio_frames(context, item->audio_time);
+#  endif
+    MEM_freeN(item->pixels);
+    MEM_freeN(item);
+  }
+  return NULL;
+}
+
+/* Encoding overlaps with rendering, except with autosplit which restarts the output from the
+ * render thread. The encoder itself uses frame threading as well. */
+static void ffmpeg_encode_thread_start(FFMpegContext *context)
+{
+  if (context->video_stream == NULL || context->ffmpeg_autosplit) {
+    return;
+  }
+
+  context->encode_queue = BLI_thread_queue_init();
+  context->encode_failed = 0;
+  BLI_threadpool_init(&context->encode_threads, ffmpeg_encode_thread, 1);
+  BLI_threadpool_insert(&context->encode_threads, context);
+}
+
+/* Wait for the queued frames to be written. */
+static void ffmpeg_encode_thread_end(FFMpegContext *context)
+{
+  if (context->encode_queue == NULL) {
+    return;
+  }
+
+  BLI_thread_queue_nowait(context->encode_queue);
+  BLI_threadpool_end(&context->encode_threads);
+  BLI_thread_queue_free(context->encode_queue);
+  context->encode_queue = NULL;
+}
+
+static int ffmpeg_encode_thread_check(FFMpegContext *context, ReportList *reports)
+{
+  if (atomic_fetch_and_and_int32(&context->encode_failed, 0)) {
+    BKE_report(reports, RPT_ERROR, "Error writing frame");
+    return 0;
+  }
+  return 1;
+}
+
+static void ffmpeg_encode_thread_push(FFMpegContext *context,
+                                      RenderData *rd,
+                                      int frame,
+                                      const int *pixels,
+                                      int rectx,
+                                      int recty,
+                                      double audio_time)
+{
+  if (BLI_thread_queue_len(context->encode_queue) >= FFMPEG_ENCODE_QUEUE_MAX) {
+    BLI_thread_queue_wait_finish(context->encode_queue);
+  }
+
+  const size_t size = sizeof(int) * (size_t)rectx * (size_t)recty;
+  FFMpegEncodeItem *item = MEM_mallocN(sizeof(FFMpegEncodeItem), "ffmpeg encode item");
+  item->rd = rd;
+  item->frame = frame;
+  item->pixels = MEM_mallocN(size, "ffmpeg encode pixels");
+  item->audio_time = audio_time;
+  memcpy(item->pixels, pixels, size);
+
+  BLI_thread_queue_push(context->encode_queue, item);
+}
+
 int BKE_ffmpeg_append(void *context_v,
                       RenderData *rd,
                       int start_frame,
@@ -1368,7 +1480,6 @@ int BKE_ffmpeg_append(void *context_v,
                       ReportList *reports)
 {
   FFMpegContext *context = context_v;
-  AVFrame *avframe;
   int success = 1;
 
   PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, rectx, recty);
@@ -1376,9 +1487,17 @@ int BKE_ffmpeg_append(void *context_v,
   /* why is this done before writing the video frame and again at end_ffmpeg? */
   //  write_audio_frames(frame / (((double)rd->frs_sec) / rd->frs_sec_base));
 
+  if (context->encode_queue) {
+    const double audio_time = (frame - start_frame) /
+                              (((double)rd->frs_sec) / (double)rd->frs_sec_base);
+    ffmpeg_encode_thread_push(
+        context, rd, frame - start_frame, pixels, rectx, recty, audio_time);
+    return ffmpeg_encode_thread_check(context, reports);
+  }
+
   if (context->video_stream) {
-    avframe = generate_video_frame(context, (unsigned char *)pixels, reports);
-    success = (avframe && write_video_frame(context, rd, frame - start_frame, avframe, reports));
+    success = ffmpeg_encode_frame(
+        context, rd, frame - start_frame, (const uint8_t *)pixels, reports);
 
     if (context->ffmpeg_autosplit) {
       if (avio_tell(context->outfile->pb) > FFMPEG_AUTOSPLIT_SIZE) {
@@ -1475,6 +1594,8 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 void BKE_ffmpeg_end(void *context_v)
 {
   FFMpegContext *context = context_v;
+  ffmpeg_encode_thread_end(context);
+  ffmpeg_encode_thread_check(context, NULL);
   end_ffmpeg_impl(context, false);
 }
 
@@ -1886,6 +2007,7 @@ void BKE_ffmpeg_context_free(void *context_v)
   if (context == NULL) {
     return;
   }
+  ffmpeg_encode_thread_end(context);
   if (context->stamp_data) {
     MEM_freeN(context->stamp_data);
   }
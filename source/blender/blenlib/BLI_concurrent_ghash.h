@@ -0,0 +1,107 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BLI_CONCURRENT_GHASH_H__
+#define __BLI_CONCURRENT_GHASH_H__
+
+/** \file
+ * \ingroup bli
+ *
+ * Hash map which can be accessed from multiple threads at once.
+ *
+ * Entries are spread over a fixed number of stripes by their hash, each stripe being a separate
+ * hash table with its own spin lock. Threads only wait for each other when accessing keys of the
+ * same stripe, instead of all serializing on a single lock around a #GHash.
+ *
+ * Uses the same hash and compare callbacks as #GHash.
+ */
+
+#include "BLI_ghash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ConcurrentGHash ConcurrentGHash;
+
+/* Create the value of a key which is not in the map yet, see #BLI_concurrent_ghash_ensure. */
+typedef void *(*ConcurrentGHashCreateFP)(const void *key, void *userdata);
+typedef void (*ConcurrentGHashForeachFP)(void *key, void *val, void *userdata);
+
+/* ************************************************************************** */
+/* NOTE: These functions are NOT safe for use from threads. */
+
+ConcurrentGHash *BLI_concurrent_ghash_new(GHashHashFP hashfp,
+                                          GHashCmpFP cmpfp,
+                                          const char *info);
+void BLI_concurrent_ghash_free(ConcurrentGHash *cgh,
+                               GHashKeyFreeFP keyfreefp,
+                               GHashValFreeFP valfreefp);
+
+/* Remove all the entries, keep the map usable for further inserts. */
+void BLI_concurrent_ghash_clear(ConcurrentGHash *cgh,
+                                GHashKeyFreeFP keyfreefp,
+                                GHashValFreeFP valfreefp);
+
+/* Call the function for all entries, in no particular order. */
+void BLI_concurrent_ghash_foreach(ConcurrentGHash *cgh,
+                                  ConcurrentGHashForeachFP foreach_fn,
+                                  void *userdata);
+
+/* ************************************************************************** */
+/* NOTE: These functions are safe for use from threads. */
+
+/* Add \a key if it is not in the map yet, returns true if it was added.
+ * Otherwise the map is not changed, and the caller keeps ownership of \a key and \a val. */
+bool BLI_concurrent_ghash_add(ConcurrentGHash *cgh, void *key, void *val);
+
+/* Add \a key or replace its value, returns true when the key was not in the map yet. */
+bool BLI_concurrent_ghash_reinsert(ConcurrentGHash *cgh,
+                                   void *key,
+                                   void *val,
+                                   GHashKeyFreeFP keyfreefp,
+                                   GHashValFreeFP valfreefp);
+
+/* Get the value of \a key, creating it with \a createfp when the key is not in the map yet.
+ * The value is created while the stripe of the key is locked, so it is only created once even
+ * when multiple threads ask for the same key at the same time.
+ *
+ * \a key is only stored in the map when \a r_created is set to true. */
+void *BLI_concurrent_ghash_ensure(ConcurrentGHash *cgh,
+                                  void *key,
+                                  ConcurrentGHashCreateFP createfp,
+                                  void *userdata,
+                                  bool *r_created);
+
+void *BLI_concurrent_ghash_lookup(ConcurrentGHash *cgh, const void *key);
+void *BLI_concurrent_ghash_lookup_default(ConcurrentGHash *cgh,
+                                          const void *key,
+                                          void *val_default);
+bool BLI_concurrent_ghash_haskey(ConcurrentGHash *cgh, const void *key);
+
+bool BLI_concurrent_ghash_remove(ConcurrentGHash *cgh,
+                                 const void *key,
+                                 GHashKeyFreeFP keyfreefp,
+                                 GHashValFreeFP valfreefp);
+
+/* Number of entries, only exact when no other thread is modifying the map. */
+unsigned int BLI_concurrent_ghash_len(ConcurrentGHash *cgh);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_CONCURRENT_GHASH_H__ */
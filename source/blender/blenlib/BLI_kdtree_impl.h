@@ -59,6 +59,16 @@ int BLI_kdtree_nd_(find_nearest_cb)(
     int (*filter_cb)(void *user_data, int index, const float co[KD_DIMS], float dist_sq),
     void *user_data,
     KDTreeNearest *r_nearest);
+void BLI_kdtree_nd_(range_search_batch)(
+    const KDTree *tree,
+    const float (*co)[KD_DIMS],
+    unsigned int co_len,
+    float range,
+    void (*batch_cb)(void *user_data,
+                     unsigned int co_index,
+                     const KDTreeNearest *nearest,
+                     int nearest_len),
+    void *user_data) ATTR_NONNULL(1, 5);
 void BLI_kdtree_nd_(range_search_cb)(
     const KDTree *tree,
     const float co[KD_DIMS],
@@ -70,6 +80,11 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
                                          const float range,
                                          bool use_index_order,
                                          int *doubles);
+int BLI_kdtree_nd_(calc_duplicates_fast_ex)(const KDTree *tree,
+                                            const float range,
+                                            bool use_index_order,
+                                            bool use_threading,
+                                            int *doubles);
 
 int BLI_kdtree_nd_(deduplicate)(KDTree *tree);
 
@@ -434,6 +434,12 @@ bool isect_ray_tri_watertight_v3(const float ray_origin[3],
                                  const float v2[3],
                                  float *r_dist,
                                  float r_uv[2]);
+int isect_ray_tri_watertight_v3_x4(const float ray_origin[3],
+                                   const struct IsectRayPrecalc *isect_precalc,
+                                   const float *v0[4],
+                                   const float *v1[4],
+                                   const float *v2[4],
+                                   float r_lambda[4]);
 /* slower version which calculates IsectRayPrecalc each time */
 bool isect_ray_tri_watertight_v3_simple(const float ray_origin[3],
                                         const float ray_direction[3],
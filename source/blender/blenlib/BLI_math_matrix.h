@@ -196,6 +196,13 @@ void mul_project_m4_v3(const float M[4][4], float vec[3]);
 void mul_v3_project_m4_v3(float r[3], const float mat[4][4], const float vec[3]);
 void mul_v2_project_m4_v3(float r[2], const float M[4][4], const float vec[3]);
 
+void mul_m4_v3_array(const float M[4][4], float (*vec_arr)[3], const int nbr);
+void mul_v3_m4v3_array(float (*r_arr)[3],
+                       const float M[4][4],
+                       const float (*vec_arr)[3],
+                       const int nbr);
+void mul_mat3_m4_v3_array(const float M[4][4], float (*vec_arr)[3], const int nbr);
+
 void mul_m3_v2(const float m[3][3], float r[2]);
 void mul_v2_m3v2(float r[2], const float m[3][3], const float v[2]);
 void mul_m3_v3(const float M[3][3], float r[3]);
@@ -434,6 +434,12 @@ void minmax_v2v2_v2(float min[2], float max[2], const float vec[2]);
 
 void minmax_v3v3_v3_array(float r_min[3], float r_max[3], const float (*vec_arr)[3], int nbr);
 
+void normalize_v3_array(float (*vec_arr)[3], const int nbr);
+void cross_v3_v3v3_array(float (*r_arr)[3],
+                         const float (*a_arr)[3],
+                         const float (*b_arr)[3],
+                         const int nbr);
+
 void dist_ensure_v3_v3fl(float v1[3], const float v2[3], const float dist);
 void dist_ensure_v2_v2fl(float v1[2], const float v2[2], const float dist);
 
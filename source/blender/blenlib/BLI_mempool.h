@@ -68,6 +68,8 @@ typedef struct BLI_mempool_iter {
   BLI_mempool *pool;
   struct BLI_mempool_chunk *curchunk;
   unsigned int curindex;
+  /* Iteration stops when reaching this chunk, NULL to iterate until the last chunk. */
+  struct BLI_mempool_chunk *endchunk;
 
   struct BLI_mempool_chunk **curchunk_threaded_shared;
 } BLI_mempool_iter;
@@ -93,6 +95,18 @@ BLI_mempool_iter *BLI_mempool_iter_threadsafe_create(BLI_mempool *pool,
     ATTR_NONNULL();
 void BLI_mempool_iter_threadsafe_free(BLI_mempool_iter *iter_arr) ATTR_NONNULL();
 
+struct BLI_mempool_chunk **BLI_mempool_chunks_as_tableN(BLI_mempool *pool,
+                                                        unsigned int *r_chunks_len,
+                                                        const char *allocstr)
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1, 2, 3);
+unsigned int BLI_mempool_chunk_used_len(const BLI_mempool *pool,
+                                        const struct BLI_mempool_chunk *chunk)
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
+void BLI_mempool_iternew_chunks(BLI_mempool *pool,
+                                BLI_mempool_iter *iter,
+                                struct BLI_mempool_chunk *chunk_first,
+                                struct BLI_mempool_chunk *chunk_end) ATTR_NONNULL(1, 2, 3);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,154 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BLI_OHASH_H__
+#define __BLI_OHASH_H__
+
+/** \file
+ * \ingroup bli
+ *
+ * Open addressing hash table (#OHash) and set (#OSet).
+ *
+ * Same hash and compare callbacks as #GHash (so all `BLI_ghashutil_*` functions can be used),
+ * but all entries are stored in a single array, without per-entry allocation, which makes
+ * lookups much more cache friendly. Use it for hot lookup paths.
+ *
+ * Differences with #GHash:
+ * - Pointers returned by #BLI_ohash_lookup_p and #BLI_ohash_ensure_p are only valid until the
+ *   next insertion or removal.
+ * - Items must not be added or removed while iterating.
+ */
+
+#include "BLI_compiler_attrs.h"
+#include "BLI_ghash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct OHash OHash;
+
+typedef struct OHashIterator {
+  OHash *oh;
+  unsigned int curr_slot;
+} OHashIterator;
+
+/** \name OHash API
+ *
+ * Defined in ``BLI_ohash.c``
+ * \{ */
+
+OHash *BLI_ohash_new_ex(GHashHashFP hashfp,
+                        GHashCmpFP cmpfp,
+                        const char *info,
+                        const unsigned int nentries_reserve) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+OHash *BLI_ohash_new(GHashHashFP hashfp,
+                     GHashCmpFP cmpfp,
+                     const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+void BLI_ohash_free(OHash *oh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+void BLI_ohash_reserve(OHash *oh, const unsigned int nentries_reserve);
+void BLI_ohash_insert(OHash *oh, void *key, void *val);
+bool BLI_ohash_reinsert(
+    OHash *oh, void *key, void *val, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+void *BLI_ohash_lookup(const OHash *oh, const void *key) ATTR_WARN_UNUSED_RESULT;
+void *BLI_ohash_lookup_default(const OHash *oh,
+                               const void *key,
+                               void *val_default) ATTR_WARN_UNUSED_RESULT;
+void **BLI_ohash_lookup_p(OHash *oh, const void *key) ATTR_WARN_UNUSED_RESULT;
+bool BLI_ohash_ensure_p(OHash *oh, void *key, void ***r_val) ATTR_WARN_UNUSED_RESULT;
+bool BLI_ohash_remove(OHash *oh,
+                      const void *key,
+                      GHashKeyFreeFP keyfreefp,
+                      GHashValFreeFP valfreefp);
+void BLI_ohash_clear(OHash *oh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp);
+void *BLI_ohash_popkey(OHash *oh,
+                       const void *key,
+                       GHashKeyFreeFP keyfreefp) ATTR_WARN_UNUSED_RESULT;
+bool BLI_ohash_haskey(const OHash *oh, const void *key) ATTR_WARN_UNUSED_RESULT;
+unsigned int BLI_ohash_len(const OHash *oh) ATTR_WARN_UNUSED_RESULT;
+
+/** \} */
+
+/** \name OHash Iterator
+ * \{ */
+
+void BLI_ohashIterator_init(OHashIterator *ohi, OHash *oh);
+void BLI_ohashIterator_step(OHashIterator *ohi);
+bool BLI_ohashIterator_done(const OHashIterator *ohi) ATTR_WARN_UNUSED_RESULT;
+void *BLI_ohashIterator_getKey(const OHashIterator *ohi) ATTR_WARN_UNUSED_RESULT;
+void *BLI_ohashIterator_getValue(const OHashIterator *ohi) ATTR_WARN_UNUSED_RESULT;
+void **BLI_ohashIterator_getValue_p(const OHashIterator *ohi) ATTR_WARN_UNUSED_RESULT;
+
+#define OHASH_ITER(oh_iter_, ohash_) \
+  for (BLI_ohashIterator_init(&oh_iter_, ohash_); BLI_ohashIterator_done(&oh_iter_) == false; \
+       BLI_ohashIterator_step(&oh_iter_))
+
+/** \} */
+
+/** \name OSet API
+ * A 'set' implementation (unordered collection of unique elements).
+ *
+ * Internally this is an #OHash without values, like #GSet is for #GHash.
+ * \{ */
+
+typedef struct OSet OSet;
+
+typedef OHashIterator OSetIterator;
+
+OSet *BLI_oset_new_ex(GSetHashFP hashfp,
+                      GSetCmpFP cmpfp,
+                      const char *info,
+                      const unsigned int nentries_reserve) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+OSet *BLI_oset_new(GSetHashFP hashfp,
+                   GSetCmpFP cmpfp,
+                   const char *info) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+void BLI_oset_free(OSet *os, GSetKeyFreeFP keyfreefp);
+void BLI_oset_reserve(OSet *os, const unsigned int nentries_reserve);
+void BLI_oset_insert(OSet *os, void *key);
+bool BLI_oset_add(OSet *os, void *key);
+bool BLI_oset_haskey(const OSet *os, const void *key) ATTR_WARN_UNUSED_RESULT;
+bool BLI_oset_remove(OSet *os, const void *key, GSetKeyFreeFP keyfreefp);
+void BLI_oset_clear(OSet *os, GSetKeyFreeFP keyfreefp);
+unsigned int BLI_oset_len(const OSet *os) ATTR_WARN_UNUSED_RESULT;
+
+BLI_INLINE void BLI_osetIterator_init(OSetIterator *osi, OSet *os)
+{
+  BLI_ohashIterator_init((OHashIterator *)osi, (OHash *)os);
+}
+BLI_INLINE void BLI_osetIterator_step(OSetIterator *osi)
+{
+  BLI_ohashIterator_step((OHashIterator *)osi);
+}
+BLI_INLINE bool BLI_osetIterator_done(const OSetIterator *osi)
+{
+  return BLI_ohashIterator_done((const OHashIterator *)osi);
+}
+BLI_INLINE void *BLI_osetIterator_getKey(const OSetIterator *osi)
+{
+  return BLI_ohashIterator_getKey((const OHashIterator *)osi);
+}
+
+#define OSET_ITER(os_iter_, oset_) \
+  for (BLI_osetIterator_init(&os_iter_, oset_); BLI_osetIterator_done(&os_iter_) == false; \
+       BLI_osetIterator_step(&os_iter_))
+
+/** \} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_OHASH_H__ */
@@ -0,0 +1,184 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BLI_PARALLEL_H__
+#define __BLI_PARALLEL_H__
+
+/** \file
+ * \ingroup bli
+ *
+ * Typed C++ wrappers around the parallel range routines of BLI_task.h.
+ *
+ * The range is split into sub-ranges of at least `grain_size` numbers, and the function is called
+ * once per sub-range. This allows the function to keep its state in local variables, instead of
+ * going through the `userdata_chunk` of #TaskParallelSettings.
+ *
+ * Example, computing the sum of an array:
+ *
+ *   int sum = BLI::parallel_reduce(
+ *       IndexRange(values.size()),
+ *       1024,
+ *       0,
+ *       [&](IndexRange range, int partial_sum) {
+ *         for (uint i : range) {
+ *           partial_sum += values[i];
+ *         }
+ *         return partial_sum;
+ *       },
+ *       [](int a, int b) { return a + b; });
+ */
+
+#include "BLI_index_range.h"
+#include "BLI_task.h"
+#include "BLI_vector.h"
+
+namespace BLI {
+
+namespace ParallelDetail {
+
+/* The range is not split in more pieces than this times the number of threads. More pieces allow
+ * better load balancing when the work per number is uneven, but make the reduction step longer. */
+static constexpr uint max_chunks_per_thread = 4;
+
+/**
+ * Get the size of the sub-ranges the range is split into. Returns the size of the whole range
+ * when it should not be split at all.
+ */
+inline uint chunk_size_get(IndexRange range, uint grain_size)
+{
+  const uint num_threads = (uint)BLI_task_scheduler_num_threads(BLI_task_scheduler_get());
+  const uint max_chunks = num_threads * max_chunks_per_thread;
+  grain_size = std::max(grain_size, 1u);
+  if (num_threads == 1 || range.size() <= grain_size) {
+    return std::max(range.size(), 1u);
+  }
+  const uint min_chunk_size = (range.size() + max_chunks - 1) / max_chunks;
+  return std::max(grain_size, min_chunk_size);
+}
+
+inline uint chunks_num_get(IndexRange range, uint chunk_size)
+{
+  return (range.size() + chunk_size - 1) / chunk_size;
+}
+
+inline IndexRange chunk_get(IndexRange range, uint chunk_size, uint chunk_index)
+{
+  const uint start = chunk_index * chunk_size;
+  return range.slice(start, std::min(chunk_size, range.size() - start));
+}
+
+template<typename Function> struct ForData {
+  const Function &function;
+  IndexRange range;
+  uint chunk_size;
+
+  static void run(void *__restrict userdata,
+                  const int chunk_index,
+                  const TaskParallelTLS *__restrict UNUSED(tls))
+  {
+    const ForData *data = (const ForData *)userdata;
+    data->function(chunk_get(data->range, data->chunk_size, (uint)chunk_index));
+  }
+};
+
+template<typename Value, typename Function> struct ReduceData {
+  const Function &function;
+  IndexRange range;
+  uint chunk_size;
+  MutableArrayRef<Value> results;
+
+  static void run(void *__restrict userdata,
+                  const int chunk_index,
+                  const TaskParallelTLS *__restrict UNUSED(tls))
+  {
+    const ReduceData *data = (const ReduceData *)userdata;
+    Value &result = data->results[(uint)chunk_index];
+    result = data->function(chunk_get(data->range, data->chunk_size, (uint)chunk_index), result);
+  }
+};
+
+inline void chunks_parallel_range(uint chunks_num, void *userdata, TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Chunks are already big enough, every one of them is a separate piece of work. */
+  settings.min_iter_per_thread = 1;
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  BLI_task_parallel_range(0, (int)chunks_num, userdata, func, &settings);
+}
+
+}  // namespace ParallelDetail
+
+/**
+ * Call `function(IndexRange sub_range)` for sub-ranges covering the given range, possibly from
+ * multiple threads. Sub-ranges are never smaller than `grain_size`, unless the range itself is.
+ */
+template<typename Function>
+void parallel_for(IndexRange range, uint grain_size, const Function &function)
+{
+  if (range.size() == 0) {
+    return;
+  }
+  const uint chunk_size = ParallelDetail::chunk_size_get(range, grain_size);
+  const uint chunks_num = ParallelDetail::chunks_num_get(range, chunk_size);
+  if (chunks_num == 1) {
+    function(range);
+    return;
+  }
+  ParallelDetail::ForData<Function> data = {function, range, chunk_size};
+  ParallelDetail::chunks_parallel_range(
+      chunks_num, &data, ParallelDetail::ForData<Function>::run);
+}
+
+/**
+ * Compute `function(sub_range, identity)` for sub-ranges covering the given range, possibly from
+ * multiple threads, and combine the results with `reduction(a, b)`.
+ *
+ * Results of the sub-ranges are always combined in order from the calling thread, so the result
+ * is deterministic even when the reduction is not associative (e.g. floating point sums). No heap
+ * allocation is done unless the range is split into many pieces on machines with lots of threads.
+ */
+template<typename Value, typename Function, typename Reduction>
+Value parallel_reduce(IndexRange range,
+                      uint grain_size,
+                      const Value &identity,
+                      const Function &function,
+                      const Reduction &reduction)
+{
+  if (range.size() == 0) {
+    return identity;
+  }
+  const uint chunk_size = ParallelDetail::chunk_size_get(range, grain_size);
+  const uint chunks_num = ParallelDetail::chunks_num_get(range, chunk_size);
+  if (chunks_num == 1) {
+    return function(range, identity);
+  }
+
+  Vector<Value, 64> results(chunks_num, identity);
+  ParallelDetail::ReduceData<Value, Function> data = {function, range, chunk_size, results};
+  ParallelDetail::chunks_parallel_range(
+      chunks_num, &data, ParallelDetail::ReduceData<Value, Function>::run);
+
+  Value result = results[0];
+  for (uint i = 1; i < chunks_num; i++) {
+    result = reduction(result, results[i]);
+  }
+  return result;
+}
+
+}  // namespace BLI
+
+#endif /* __BLI_PARALLEL_H__ */
@@ -33,11 +33,14 @@ extern "C" {
 #include "BLI_utildefines.h"
 
 struct BLI_mempool;
+struct MemArena;
 
 /* Task Scheduler
  *
- * Central scheduler that holds running threads ready to execute tasks. A single
- * queue holds the task from all pools.
+ * Central scheduler that holds running threads ready to execute tasks. Every
+ * worker thread owns a queue of the tasks it pushed itself, and threads which
+ * run out of work steal tasks from the queues of other threads. Tasks pushed
+ * from threads not managed by the scheduler go to a shared queue.
  *
  * Init/exit must be called before/after any task pools are created/freed, and
  * must be called from the main threads. All other scheduler and pool functions
@@ -62,6 +65,11 @@ int BLI_task_scheduler_num_threads(TaskScheduler *scheduler);
  * pool with smaller tasks. When other threads are busy they will continue
  * working on their own tasks, if not they will join in, no new threads will
  * be launched.
+ *
+ * Tasks of a nested pool are put in the queue of the worker thread which runs
+ * the parent task, other threads only steal them once they are out of work.
+ * This is also how parallel range routines below behave when they are called
+ * from within a task.
  */
 
 typedef enum TaskPriority {
@@ -119,6 +127,21 @@ ThreadMutex *BLI_task_pool_user_mutex(TaskPool *pool);
 void BLI_task_pool_delayed_push_begin(TaskPool *pool, int thread_id);
 void BLI_task_pool_delayed_push_end(TaskPool *pool, int thread_id);
 
+/* Profiling, record the timing of all tasks of the pool to find scheduling stalls.
+ * Enable before pushing any task, print or export once all tasks are done. */
+void BLI_task_pool_profile_enable(TaskPool *pool, const char *name);
+void BLI_task_pool_profile_print(TaskPool *pool);
+bool BLI_task_pool_profile_write_chrome_trace(TaskPool *pool, const char *filepath);
+typedef void (*TaskProfileEventFunction)(void *userdata,
+                                         void *taskdata,
+                                         int thread_id,
+                                         double push_time,
+                                         double start_time,
+                                         double end_time);
+void BLI_task_pool_profile_foreach_event(TaskPool *pool,
+                                         TaskProfileEventFunction func,
+                                         void *userdata);
+
 /* Parallel for routines */
 
 typedef enum eTaskSchedulingMode {
@@ -143,8 +166,14 @@ typedef struct TaskParallelTLS {
    * worker threads. This is similar to OpenMP's firstprivate.
    */
   void *userdata_chunk;
+  /* Scratch memory of the running task, private, use BLI_task_parallel_tls_arena()
+   * to access it. Only set by the parallel range and iterator routines below.
+   */
+  struct TaskParallelScratch *scratch;
 } TaskParallelTLS;
 
+struct MemArena *BLI_task_parallel_tls_arena(const TaskParallelTLS *__restrict tls);
+
 typedef void (*TaskParallelFinalizeFunc)(void *__restrict userdata,
                                          void *__restrict userdata_chunk);
 
@@ -251,6 +280,13 @@ void BLI_task_parallel_mempool(struct BLI_mempool *mempool,
                                void *userdata,
                                TaskParallelMempoolFunc func,
                                const bool use_threading);
+typedef void (*TaskParallelMempoolIndexFunc)(void *userdata,
+                                             MempoolIterData *iter,
+                                             const int index);
+void BLI_task_parallel_mempool_index(struct BLI_mempool *mempool,
+                                     void *userdata,
+                                     TaskParallelMempoolIndexFunc func,
+                                     const bool use_threading);
 
 /* TODO(sergey): Think of a better place for this. */
 BLI_INLINE void BLI_parallel_range_settings_defaults(TaskParallelSettings *settings)
@@ -0,0 +1,114 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BLI_TRACE_H__
+#define __BLI_TRACE_H__
+
+/** \file
+ * \ingroup bli
+ *
+ * Trace of the time spent in zones of code, written as Chrome trace events (JSON Array Format)
+ * which can be opened by `chrome://tracing` or Perfetto.
+ *
+ * Every zone is a slice on the timeline of the thread which ran it. While no trace is being
+ * written, zones only cost reading a global flag.
+ *
+ * \code{.c}
+ * TraceZone zone;
+ * BLI_trace_zone_begin(&zone, "Read File", "io");
+ * ...
+ * BLI_trace_zone_end(&zone);
+ * \endcode
+ */
+
+#include "BLI_compiler_attrs.h"
+#include "BLI_sys_types.h"
+#include "BLI_utildefines.h"
+
+#include "PIL_time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Process of the zones, other processes group slices of their own threads (task pools...). */
+#define BLI_TRACE_PROCESS_ZONES 0
+#define BLI_TRACE_PROCESS_MAX 8
+
+/* Only read through #BLI_trace_is_enabled. */
+extern bool BLI_trace_enabled;
+
+/* Start writing a trace to the file, a trace being written is ended first. */
+bool BLI_trace_begin(const char *filepath);
+/* Finish writing the trace, does nothing when no trace is being written. */
+void BLI_trace_end(void);
+/* Write the events so far to the file, the trace stays usable if Blender doesn't exit cleanly. */
+void BLI_trace_flush(void);
+
+BLI_INLINE bool BLI_trace_is_enabled(void)
+{
+  return BLI_trace_enabled;
+}
+
+/* Name shown for the process, the name is copied. */
+void BLI_trace_process_name_set(int process_id, const char *name);
+
+/* ID of the calling thread on the timeline of the zones, the main thread is 0. */
+int BLI_trace_thread_id(void);
+
+/**
+ * Write a slice, times are in seconds as returned by #PIL_check_seconds_timer.
+ * \param detail: Optional string shown as argument of the slice.
+ * \param wait_time: Time waited before starting to run, only written when positive.
+ */
+void BLI_trace_slice(int process_id,
+                     int thread_id,
+                     const char *name,
+                     const char *category,
+                     const char *detail,
+                     double start_time,
+                     double end_time,
+                     double wait_time);
+
+typedef struct TraceZone {
+  const char *name;
+  const char *category;
+  /* Zero when no trace was being written when the zone began. */
+  double start_time;
+} TraceZone;
+
+/* Name and category are not copied, they must be valid until the end of the zone. */
+BLI_INLINE void BLI_trace_zone_begin(TraceZone *zone, const char *name, const char *category)
+{
+  zone->name = name;
+  zone->category = category;
+  zone->start_time = BLI_trace_enabled ? PIL_check_seconds_timer() : 0.0;
+}
+
+void BLI_trace_zone_write(const TraceZone *zone, double end_time);
+
+BLI_INLINE void BLI_trace_zone_end(const TraceZone *zone)
+{
+  if (UNLIKELY(zone->start_time != 0.0)) {
+    BLI_trace_zone_write(zone, PIL_check_seconds_timer());
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLI_TRACE_H__ */
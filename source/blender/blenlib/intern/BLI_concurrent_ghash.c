@@ -0,0 +1,208 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * Lock striped hash map, each stripe is an #OHash protected by a spin lock.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "BLI_concurrent_ghash.h"
+#include "BLI_ohash.h"
+#include "BLI_threads.h"
+
+#include "BLI_strict_flags.h"
+
+/* Enough stripes for contention to be rare with the usual thread counts.
+ * Must be a power of two. */
+#define STRIPES_NUM 64
+#define STRIPE_ALIGN 64
+
+typedef struct ConcurrentGHashStripe {
+  SpinLock lock;
+  OHash *hash;
+  /* Keep each stripe on its own cache line,
+   * so threads working on different stripes don't slow each other down. */
+  char _pad[STRIPE_ALIGN - sizeof(SpinLock) - sizeof(OHash *)];
+} ConcurrentGHashStripe;
+
+struct ConcurrentGHash {
+  ConcurrentGHashStripe *stripes;
+  GHashHashFP hashfp;
+};
+
+BLI_INLINE ConcurrentGHashStripe *concurrent_ghash_stripe(ConcurrentGHash *cgh, const void *key)
+{
+  const uint hash = cgh->hashfp(key);
+  /* Mix the hash differently from the Fibonacci hashing of #OHash,
+   * so the entries of a stripe still spread over its whole table. */
+  return &cgh->stripes[(hash ^ (hash >> 16)) & (STRIPES_NUM - 1)];
+}
+
+/* ************************************************************************** */
+/* NOTE: These functions are NOT safe for use from threads. */
+
+ConcurrentGHash *BLI_concurrent_ghash_new(GHashHashFP hashfp,
+                                          GHashCmpFP cmpfp,
+                                          const char *info)
+{
+  ConcurrentGHash *cgh = MEM_mallocN(sizeof(*cgh), info);
+  cgh->hashfp = hashfp;
+  cgh->stripes = MEM_mallocN_aligned(sizeof(*cgh->stripes) * STRIPES_NUM, STRIPE_ALIGN, info);
+  for (int i = 0; i < STRIPES_NUM; i++) {
+    ConcurrentGHashStripe *stripe = &cgh->stripes[i];
+    BLI_spin_init(&stripe->lock);
+    stripe->hash = BLI_ohash_new(hashfp, cmpfp, info);
+  }
+  return cgh;
+}
+
+void BLI_concurrent_ghash_free(ConcurrentGHash *cgh,
+                               GHashKeyFreeFP keyfreefp,
+                               GHashValFreeFP valfreefp)
+{
+  for (int i = 0; i < STRIPES_NUM; i++) {
+    ConcurrentGHashStripe *stripe = &cgh->stripes[i];
+    BLI_ohash_free(stripe->hash, keyfreefp, valfreefp);
+    BLI_spin_end(&stripe->lock);
+  }
+  MEM_freeN(cgh->stripes);
+  MEM_freeN(cgh);
+}
+
+void BLI_concurrent_ghash_clear(ConcurrentGHash *cgh,
+                                GHashKeyFreeFP keyfreefp,
+                                GHashValFreeFP valfreefp)
+{
+  for (int i = 0; i < STRIPES_NUM; i++) {
+    BLI_ohash_clear(cgh->stripes[i].hash, keyfreefp, valfreefp);
+  }
+}
+
+void BLI_concurrent_ghash_foreach(ConcurrentGHash *cgh,
+                                  ConcurrentGHashForeachFP foreach_fn,
+                                  void *userdata)
+{
+  for (int i = 0; i < STRIPES_NUM; i++) {
+    OHashIterator ohi;
+    OHASH_ITER (ohi, cgh->stripes[i].hash) {
+      foreach_fn(BLI_ohashIterator_getKey(&ohi), BLI_ohashIterator_getValue(&ohi), userdata);
+    }
+  }
+}
+
+/* ************************************************************************** */
+/* NOTE: These functions are safe for use from threads. */
+
+bool BLI_concurrent_ghash_add(ConcurrentGHash *cgh, void *key, void *val)
+{
+  ConcurrentGHashStripe *stripe = concurrent_ghash_stripe(cgh, key);
+  void **val_p;
+  BLI_spin_lock(&stripe->lock);
+  const bool added = !BLI_ohash_ensure_p(stripe->hash, key, &val_p);
+  if (added) {
+    *val_p = val;
+  }
+  BLI_spin_unlock(&stripe->lock);
+  return added;
+}
+
+bool BLI_concurrent_ghash_reinsert(ConcurrentGHash *cgh,
+                                   void *key,
+                                   void *val,
+                                   GHashKeyFreeFP keyfreefp,
+                                   GHashValFreeFP valfreefp)
+{
+  ConcurrentGHashStripe *stripe = concurrent_ghash_stripe(cgh, key);
+  BLI_spin_lock(&stripe->lock);
+  const bool added = BLI_ohash_reinsert(stripe->hash, key, val, keyfreefp, valfreefp);
+  BLI_spin_unlock(&stripe->lock);
+  return added;
+}
+
+void *BLI_concurrent_ghash_ensure(ConcurrentGHash *cgh,
+                                  void *key,
+                                  ConcurrentGHashCreateFP createfp,
+                                  void *userdata,
+                                  bool *r_created)
+{
+  ConcurrentGHashStripe *stripe = concurrent_ghash_stripe(cgh, key);
+  void **val_p;
+  BLI_spin_lock(&stripe->lock);
+  const bool created = !BLI_ohash_ensure_p(stripe->hash, key, &val_p);
+  if (created) {
+    *val_p = createfp(key, userdata);
+  }
+  void *val = *val_p;
+  BLI_spin_unlock(&stripe->lock);
+  if (r_created) {
+    *r_created = created;
+  }
+  return val;
+}
+
+void *BLI_concurrent_ghash_lookup(ConcurrentGHash *cgh, const void *key)
+{
+  return BLI_concurrent_ghash_lookup_default(cgh, key, NULL);
+}
+
+void *BLI_concurrent_ghash_lookup_default(ConcurrentGHash *cgh,
+                                          const void *key,
+                                          void *val_default)
+{
+  ConcurrentGHashStripe *stripe = concurrent_ghash_stripe(cgh, key);
+  BLI_spin_lock(&stripe->lock);
+  void *val = BLI_ohash_lookup_default(stripe->hash, key, val_default);
+  BLI_spin_unlock(&stripe->lock);
+  return val;
+}
+
+bool BLI_concurrent_ghash_haskey(ConcurrentGHash *cgh, const void *key)
+{
+  ConcurrentGHashStripe *stripe = concurrent_ghash_stripe(cgh, key);
+  BLI_spin_lock(&stripe->lock);
+  const bool haskey = BLI_ohash_haskey(stripe->hash, key);
+  BLI_spin_unlock(&stripe->lock);
+  return haskey;
+}
+
+bool BLI_concurrent_ghash_remove(ConcurrentGHash *cgh,
+                                 const void *key,
+                                 GHashKeyFreeFP keyfreefp,
+                                 GHashValFreeFP valfreefp)
+{
+  ConcurrentGHashStripe *stripe = concurrent_ghash_stripe(cgh, key);
+  BLI_spin_lock(&stripe->lock);
+  const bool removed = BLI_ohash_remove(stripe->hash, key, keyfreefp, valfreefp);
+  BLI_spin_unlock(&stripe->lock);
+  return removed;
+}
+
+uint BLI_concurrent_ghash_len(ConcurrentGHash *cgh)
+{
+  uint len = 0;
+  for (int i = 0; i < STRIPES_NUM; i++) {
+    ConcurrentGHashStripe *stripe = &cgh->stripes[i];
+    BLI_spin_lock(&stripe->lock);
+    len += BLI_ohash_len(stripe->hash);
+    BLI_spin_unlock(&stripe->lock);
+  }
+  return len;
+}
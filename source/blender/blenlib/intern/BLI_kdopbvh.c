@@ -30,6 +30,7 @@
  *
  * - Ray-cast:
  *   #BLI_bvhtree_ray_cast, #BVHRayCastData
+ *   #BLI_bvhtree_ray_cast_packet, #BVHRayCastPacketData
  * - Nearest point on surface:
  *   #BLI_bvhtree_find_nearest, #BVHNearestData
  * - Overlapping 2 trees:
@@ -52,6 +53,10 @@
 
 #include "BLI_strict_flags.h"
 
+#ifdef __SSE2__
+#  include <xmmintrin.h>
+#endif
+
 /* used for iterative_raycast */
 // #define USE_SKIP_LINKS
 
@@ -72,6 +77,12 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/* Branches with more leafs than this compute their bounds with multiple threads,
+ * the upper levels of the tree don't have enough branches to keep all threads busy otherwise. */
+#define KDOPBVH_THREAD_REFIT_LEAF_THRESHOLD (1 << 16)
+/* Number of leafs each thread refits at once when computing bounds of a single branch. */
+#define KDOPBVH_THREAD_REFIT_CHUNK_SIZE (1 << 12)
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -157,6 +168,17 @@ typedef struct BVHRayCastData {
   BVHTreeRayHit hit;
 } BVHRayCastData;
 
+typedef struct BVHRayCastPacketData {
+  /* Each ray of the packet, unused rays are copies of the first one which never hit. */
+  BVHRayCastData rays[BVH_RAYCAST_PACKET_SIZE];
+  int rays_len;
+#ifdef __SSE2__
+  /* Transposed from `rays`, each register holds one component of all rays. */
+  __m128 origin[3];
+  __m128 idot_axis[3];
+#endif
+} BVHRayCastPacketData;
+
 typedef struct BVHNearestProjectedData {
   const BVHTree *tree;
   struct DistProjectedAABBPrecalc precalc;
@@ -228,23 +250,71 @@ static void node_minmax_init(const BVHTree *tree, BVHNode *node)
   }
 }
 
+#ifdef __SSE2__
+/**
+ * SSE versions of the bounding volume operations.
+ *
+ * The min/max pairs of the axes are processed 4 floats (two axes) at a time. All k-DOP types use
+ * at least 2 axes; with an odd number of axes the last chunk overlaps the previous one, which is
+ * harmless since min/max and overlap tests give the same result when done twice.
+ */
+#  define BV_SSE_CHUNKS_MAX ((13 * 2 + 3) / 4)
+
+BLI_INLINE int bv_sse_chunks_init(const BVHTree *tree, int r_chunk_offset[BV_SSE_CHUNKS_MAX])
+{
+  const int start = tree->start_axis * 2;
+  const int stop = tree->stop_axis * 2;
+  int num_chunks = 0;
+  BLI_assert(stop - start >= 4);
+  for (int ofs = start; ofs < stop; ofs += 4) {
+    r_chunk_offset[num_chunks++] = min_ii(ofs, stop - 4);
+  }
+  return num_chunks;
+}
+
+/* Lanes of a chunk which hold a maximum. */
+BLI_INLINE __m128 bv_sse_max_mask(void)
+{
+  return _mm_castsi128_ps(_mm_set_epi32(-1, 0, -1, 0));
+}
+
+/* Minimum in the min lanes, maximum in the max lanes. */
+BLI_INLINE __m128 bv_sse_union(const __m128 a, const __m128 b, const __m128 max_mask)
+{
+  return _mm_or_ps(_mm_and_ps(max_mask, _mm_max_ps(a, b)),
+                   _mm_andnot_ps(max_mask, _mm_min_ps(a, b)));
+}
+#endif /* __SSE2__ */
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
 /** \name Balance Utility Functions
  * \{ */
 
+/**
+ * Leaf with a copy of its bounds along the x, y and z axes.
+ *
+ * The leafs are sorted in an array of these instead of sorting the leaf pointers directly.
+ * This way each level of the tree build reads the bounds it needs from contiguous memory, instead
+ * of accessing the bounding volumes of the leafs which end up scattered in memory.
+ */
+typedef struct BVHSplitItem {
+  float bv[6];
+  BVHNode *node;
+} BVHSplitItem;
+
 /**
  * Insertion sort algorithm
  */
-static void bvh_insertionsort(BVHNode **a, int lo, int hi, int axis)
+static void bvh_insertionsort(BVHSplitItem *a, int lo, int hi, int axis)
 {
   int i, j;
-  BVHNode *t;
+  BVHSplitItem t;
   for (i = lo; i < hi; i++) {
     j = i;
     t = a[i];
-    while ((j != lo) && (t->bv[axis] < (a[j - 1])->bv[axis])) {
+    while ((j != lo) && (t.bv[axis] < a[j - 1].bv[axis])) {
       a[j] = a[j - 1];
       j--;
     }
@@ -252,52 +322,52 @@ static void bvh_insertionsort(BVHNode **a, int lo, int hi, int axis)
   }
 }
 
-static int bvh_partition(BVHNode **a, int lo, int hi, BVHNode *x, int axis)
+static int bvh_partition(BVHSplitItem *a, int lo, int hi, const float x, int axis)
 {
   int i = lo, j = hi;
   while (1) {
-    while (a[i]->bv[axis] < x->bv[axis]) {
+    while (a[i].bv[axis] < x) {
       i++;
     }
     j--;
-    while (x->bv[axis] < a[j]->bv[axis]) {
+    while (x < a[j].bv[axis]) {
       j--;
     }
     if (!(i < j)) {
       return i;
     }
-    SWAP(BVHNode *, a[i], a[j]);
+    SWAP(BVHSplitItem, a[i], a[j]);
     i++;
   }
 }
 
 /* returns Sortable */
-static BVHNode *bvh_medianof3(BVHNode **a, int lo, int mid, int hi, int axis)
+static float bvh_medianof3(const BVHSplitItem *a, int lo, int mid, int hi, int axis)
 {
-  if ((a[mid])->bv[axis] < (a[lo])->bv[axis]) {
-    if ((a[hi])->bv[axis] < (a[mid])->bv[axis]) {
-      return a[mid];
+  if (a[mid].bv[axis] < a[lo].bv[axis]) {
+    if (a[hi].bv[axis] < a[mid].bv[axis]) {
+      return a[mid].bv[axis];
     }
     else {
-      if ((a[hi])->bv[axis] < (a[lo])->bv[axis]) {
-        return a[hi];
+      if (a[hi].bv[axis] < a[lo].bv[axis]) {
+        return a[hi].bv[axis];
       }
       else {
-        return a[lo];
+        return a[lo].bv[axis];
       }
     }
   }
   else {
-    if ((a[hi])->bv[axis] < (a[mid])->bv[axis]) {
-      if ((a[hi])->bv[axis] < (a[lo])->bv[axis]) {
-        return a[lo];
+    if (a[hi].bv[axis] < a[mid].bv[axis]) {
+      if (a[hi].bv[axis] < a[lo].bv[axis]) {
+        return a[lo].bv[axis];
       }
       else {
-        return a[hi];
+        return a[hi].bv[axis];
       }
     }
     else {
-      return a[mid];
+      return a[mid].bv[axis];
     }
   }
 }
@@ -306,7 +376,8 @@ static BVHNode *bvh_medianof3(BVHNode **a, int lo, int mid, int hi, int axis)
  * \note after a call to this function you can expect one of:
  * - every node to left of a[n] are smaller or equal to it
  * - every node to the right of a[n] are greater or equal to it */
-static void partition_nth_element(BVHNode **a, int begin, int end, const int n, const int axis)
+static void partition_nth_element(
+    BVHSplitItem *a, int begin, int end, const int n, const int axis)
 {
   while (end - begin > 3) {
     const int cut = bvh_partition(
@@ -373,19 +444,38 @@ static void create_kdop_hull(
 }
 
 /**
- * \note depends on the fact that the BVH's for each face is already built
+ * Expand \a bv to also contain the bounding volumes of \a nodes.
  */
-static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+static void bv_expand_nodes(const BVHTree *tree,
+                            float *__restrict bv,
+                            BVHNode *const *nodes,
+                            const int nodes_len)
 {
+#ifdef __SSE2__
+  int chunk_offset[BV_SSE_CHUNKS_MAX];
+  __m128 chunk_bv[BV_SSE_CHUNKS_MAX];
+  const int num_chunks = bv_sse_chunks_init(tree, chunk_offset);
+  const __m128 max_mask = bv_sse_max_mask();
+
+  for (int c = 0; c < num_chunks; c++) {
+    chunk_bv[c] = _mm_loadu_ps(&bv[chunk_offset[c]]);
+  }
+  for (int j = 0; j < nodes_len; j++) {
+    const float *__restrict node_bv = nodes[j]->bv;
+    for (int c = 0; c < num_chunks; c++) {
+      chunk_bv[c] = bv_sse_union(chunk_bv[c], _mm_loadu_ps(&node_bv[chunk_offset[c]]), max_mask);
+    }
+  }
+  for (int c = 0; c < num_chunks; c++) {
+    _mm_storeu_ps(&bv[chunk_offset[c]], chunk_bv[c]);
+  }
+#else
   float newmin, newmax;
-  float *__restrict bv = node->bv;
   int j;
   axis_t axis_iter;
 
-  node_minmax_init(tree, node);
-
-  for (j = start; j < end; j++) {
-    float *__restrict node_bv = tree->nodes[j]->bv;
+  for (j = 0; j < nodes_len; j++) {
+    const float *__restrict node_bv = nodes[j]->bv;
 
     /* for all Axes. */
     for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
@@ -400,6 +490,111 @@ static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int e
       }
     }
   }
+#endif
+}
+
+/**
+ * \note depends on the fact that the BVH's for each face is already built
+ */
+static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  node_minmax_init(tree, node);
+  bv_expand_nodes(tree, node->bv, &tree->nodes[start], end - start);
+}
+
+/**
+ * Expand \a bv (bounds along the x, y and z axes) to contain the leafs in \a items.
+ */
+static void split_items_bounds_expand(float bv[6], const BVHSplitItem *items, const int items_len)
+{
+#ifdef __SSE2__
+  const __m128 max_mask = bv_sse_max_mask();
+  __m128 bv_xy = _mm_loadu_ps(&bv[0]);
+  __m128 bv_yz = _mm_loadu_ps(&bv[2]);
+  for (int i = 0; i < items_len; i++) {
+    bv_xy = bv_sse_union(bv_xy, _mm_loadu_ps(&items[i].bv[0]), max_mask);
+    bv_yz = bv_sse_union(bv_yz, _mm_loadu_ps(&items[i].bv[2]), max_mask);
+  }
+  _mm_storeu_ps(&bv[0], bv_xy);
+  _mm_storeu_ps(&bv[2], bv_yz);
+#else
+  for (int i = 0; i < items_len; i++) {
+    for (int j = 0; j < 6; j += 2) {
+      bv[j] = min_ff(bv[j], items[i].bv[j]);
+      bv[j + 1] = max_ff(bv[j + 1], items[i].bv[j + 1]);
+    }
+  }
+#endif
+}
+
+BLI_INLINE void split_items_bounds_init(float bv[6])
+{
+  for (int j = 0; j < 6; j += 2) {
+    bv[j] = FLT_MAX;
+    bv[j + 1] = -FLT_MAX;
+  }
+}
+
+typedef struct BVHSplitBoundsData {
+  const BVHSplitItem *items;
+  int begin, end;
+  float *bv;
+} BVHSplitBoundsData;
+
+static void split_items_bounds_task_cb(void *__restrict userdata,
+                                       const int chunk,
+                                       const TaskParallelTLS *__restrict tls)
+{
+  const BVHSplitBoundsData *data = userdata;
+  const int begin = data->begin + chunk * KDOPBVH_THREAD_REFIT_CHUNK_SIZE;
+  const int end = min_ii(begin + KDOPBVH_THREAD_REFIT_CHUNK_SIZE, data->end);
+  split_items_bounds_expand(tls->userdata_chunk, &data->items[begin], end - begin);
+}
+
+static void split_items_bounds_finalize(void *__restrict userdata, void *__restrict userdata_chunk)
+{
+  const BVHSplitBoundsData *data = userdata;
+  const float *chunk_bv = userdata_chunk;
+  for (int j = 0; j < 6; j += 2) {
+    data->bv[j] = min_ff(data->bv[j], chunk_bv[j]);
+    data->bv[j + 1] = max_ff(data->bv[j + 1], chunk_bv[j + 1]);
+  }
+}
+
+/**
+ * Bounds along the x, y and z axes of the leafs in the given range,
+ * using multiple threads for branches with many leafs.
+ */
+static void split_items_bounds(const BVHSplitItem *items, int begin, int end, float r_bv[6])
+{
+  split_items_bounds_init(r_bv);
+
+  if (end - begin <= KDOPBVH_THREAD_REFIT_LEAF_THRESHOLD) {
+    split_items_bounds_expand(r_bv, &items[begin], end - begin);
+    return;
+  }
+
+  BVHSplitBoundsData data = {
+      .items = items,
+      .begin = begin,
+      .end = end,
+      .bv = r_bv,
+  };
+  /* Each thread expands its own copy of the initialized bounds. */
+  float chunk_bv[6];
+  split_items_bounds_init(chunk_bv);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = chunk_bv;
+  settings.userdata_chunk_size = sizeof(chunk_bv);
+  settings.func_finalize = split_items_bounds_finalize;
+  BLI_task_parallel_range(0,
+                          (end - begin + KDOPBVH_THREAD_REFIT_CHUNK_SIZE - 1) /
+                              KDOPBVH_THREAD_REFIT_CHUNK_SIZE,
+                          &data,
+                          split_items_bounds_task_cb,
+                          &settings);
 }
 
 /**
@@ -433,31 +628,16 @@ static char get_largest_axis(const float *bv)
 /**
  * bottom-up update of bvh node BV
  * join the children on the parent BV */
-static void node_join(BVHTree *tree, BVHNode *node)
+static void node_join(const BVHTree *tree, BVHNode *node)
 {
   int i;
-  axis_t axis_iter;
 
   node_minmax_init(tree, node);
 
-  for (i = 0; i < tree->tree_type; i++) {
-    if (node->children[i]) {
-      for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
-        /* update minimum */
-        if (node->children[i]->bv[(2 * axis_iter)] < node->bv[(2 * axis_iter)]) {
-          node->bv[(2 * axis_iter)] = node->children[i]->bv[(2 * axis_iter)];
-        }
-
-        /* update maximum */
-        if (node->children[i]->bv[(2 * axis_iter) + 1] > node->bv[(2 * axis_iter) + 1]) {
-          node->bv[(2 * axis_iter) + 1] = node->children[i]->bv[(2 * axis_iter) + 1];
-        }
-      }
-    }
-    else {
-      break;
-    }
+  for (i = 0; i < tree->tree_type && node->children[i]; i++) {
+    /* pass */
   }
+  bv_expand_nodes(tree, node->bv, node->children, i);
 }
 
 #ifdef USE_PRINT_TREE
@@ -669,7 +849,7 @@ static int implicit_needed_branches(int tree_type, int leafs)
  *
  * TODO: This can be optimized a bit by doing a specialized nth_element instead of K nth_elements
  */
-static void split_leafs(BVHNode **leafs_array,
+static void split_leafs(BVHSplitItem *leafs_array,
                         const int nth[],
                         const int partitions,
                         const int split_axis)
@@ -687,7 +867,7 @@ static void split_leafs(BVHNode **leafs_array,
 typedef struct BVHDivNodesData {
   const BVHTree *tree;
   BVHNode *branches_array;
-  BVHNode **leafs_array;
+  BVHSplitItem *leafs_array;
 
   int tree_type;
   int tree_offset;
@@ -709,15 +889,18 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
   const int parent_level_index = j - data->i;
   BVHNode *parent = &data->branches_array[j];
   int nth_positions[MAX_TREETYPE + 1];
+  float leafs_bv[6];
   char split_axis;
 
   int parent_leafs_begin = implicit_leafs_index(data->data, data->depth, parent_level_index);
   int parent_leafs_end = implicit_leafs_index(data->data, data->depth, parent_level_index + 1);
 
   /* This calculates the bounding box of this branch
-   * and chooses the largest axis as the axis to divide leafs */
-  refit_kdop_hull(data->tree, parent, parent_leafs_begin, parent_leafs_end);
-  split_axis = get_largest_axis(parent->bv);
+   * and chooses the largest axis as the axis to divide leafs.
+   * The full bounding volume of the branch is only calculated once all its leafs are known,
+   * see #non_recursive_bvh_div_nodes. */
+  split_items_bounds(data->leafs_array, parent_leafs_begin, parent_leafs_end, leafs_bv);
+  split_axis = get_largest_axis(leafs_bv);
 
   /* Save split axis (this can be used on raytracing to speedup the query time) */
   parent->main_axis = split_axis / 2;
@@ -755,7 +938,7 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
       parent->children[k]->parent = parent;
     }
     else if (child_leafs_end - child_leafs_begin == 1) {
-      parent->children[k] = data->leafs_array[child_leafs_begin];
+      parent->children[k] = data->leafs_array[child_leafs_begin].node;
       parent->children[k]->parent = parent;
     }
     else {
@@ -765,6 +948,19 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
   parent->totnode = (char)k;
 }
 
+typedef struct BVHJoinNodesData {
+  const BVHTree *tree;
+  BVHNode *branches_array;
+} BVHJoinNodesData;
+
+static void non_recursive_bvh_join_nodes_task_cb(void *__restrict userdata,
+                                                 const int j,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHJoinNodesData *data = userdata;
+  node_join(data->tree, &data->branches_array[j]);
+}
+
 /**
  * This functions builds an optimal implicit tree from the given leafs.
  * Where optimal stands for:
@@ -782,6 +978,9 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
  * To archive this is necessary to find how much leafs are accessible from a certain branch,
  * #BVHBuildHelper, #implicit_needed_branches and #implicit_leafs_index
  * are auxiliary functions to solve that "optimal-split".
+ *
+ * The bounding volumes of the branches are joined from their children once all levels are built,
+ * from the last level to the root (children always have a greater index than their parent).
  */
 static void non_recursive_bvh_div_nodes(const BVHTree *tree,
                                         BVHNode *branches_array,
@@ -818,10 +1017,20 @@ static void non_recursive_bvh_div_nodes(const BVHTree *tree,
 
   build_implicit_tree_helper(tree, &data);
 
+  BVHSplitItem *split_items = MEM_mallocN(sizeof(*split_items) * (size_t)num_leafs, __func__);
+  for (i = 0; i < num_leafs; i++) {
+    memcpy(split_items[i].bv, leafs_array[i]->bv, sizeof(split_items[i].bv));
+    split_items[i].node = leafs_array[i];
+  }
+
+  /* First branch of each level, followed by the end of the last level. */
+  int level_begin[32 + 1];
+  int num_levels = 0;
+
   BVHDivNodesData cb_data = {
       .tree = tree,
       .branches_array = branches_array,
-      .leafs_array = leafs_array,
+      .leafs_array = split_items,
       .tree_type = tree_type,
       .tree_offset = tree_offset,
       .data = &data,
@@ -836,6 +1045,9 @@ static void non_recursive_bvh_div_nodes(const BVHTree *tree,
     /* index of last branch on this level */
     const int i_stop = min_ii(first_of_next_level, num_branches + 1);
 
+    level_begin[num_levels++] = i;
+    level_begin[num_levels] = i_stop;
+
     /* Loop all branches on this level */
     cb_data.first_of_next_level = first_of_next_level;
     cb_data.i = i;
@@ -855,6 +1067,27 @@ static void non_recursive_bvh_div_nodes(const BVHTree *tree,
       }
     }
   }
+
+  for (i = 0; i < num_leafs; i++) {
+    leafs_array[i] = split_items[i].node;
+  }
+  MEM_freeN(split_items);
+
+  BVHJoinNodesData join_data = {
+      .tree = tree,
+      .branches_array = branches_array,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  for (depth = num_levels - 1; depth >= 0; depth--) {
+    settings.use_threading = (level_begin[depth + 1] - level_begin[depth] >
+                              KDOPBVH_THREAD_LEAF_THRESHOLD);
+    BLI_task_parallel_range(level_begin[depth],
+                            level_begin[depth + 1],
+                            &join_data,
+                            non_recursive_bvh_join_nodes_task_cb,
+                            &settings);
+  }
 }
 
 /** \} */
@@ -1082,6 +1315,24 @@ static bool tree_overlap_test(const BVHNode *node1,
                               axis_t start_axis,
                               axis_t stop_axis)
 {
+#ifdef __SSE2__
+  const int start = start_axis << 1;
+  const int stop = stop_axis << 1;
+
+  /* test two axes at once if min + max overlap */
+  for (int ofs = start; ofs < stop; ofs += 4) {
+    const int ofs_chunk = min_ii(ofs, stop - 4);
+    const __m128 bv1 = _mm_loadu_ps(&node1->bv[ofs_chunk]);
+    const __m128 bv2 = _mm_loadu_ps(&node2->bv[ofs_chunk]);
+    /* Swap min and max of each axis, to compare the min of one volume with the max of the
+     * other in the min lanes, and the other way around in the max lanes. */
+    const __m128 bv2_swap = _mm_shuffle_ps(bv2, bv2, _MM_SHUFFLE(2, 3, 0, 1));
+    if ((_mm_movemask_ps(_mm_cmpgt_ps(bv1, bv2_swap)) & 0x5) ||
+        (_mm_movemask_ps(_mm_cmplt_ps(bv1, bv2_swap)) & 0xa)) {
+      return 0;
+    }
+  }
+#else
   const float *bv1 = node1->bv + (start_axis << 1);
   const float *bv2 = node2->bv + (start_axis << 1);
   const float *bv1_end = node1->bv + (stop_axis << 1);
@@ -1092,6 +1343,7 @@ static bool tree_overlap_test(const BVHNode *node1,
       return 0;
     }
   }
+#endif
 
   return 1;
 }
@@ -1989,6 +2241,258 @@ void BLI_bvhtree_ray_cast_all(BVHTree *tree,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name BLI_bvhtree_ray_cast_packet
+ *
+ * Multiple rays traverse the tree together, testing the bounds of a node against all of them at
+ * once. A node is visited while any ray of the packet can still hit it.
+ *
+ * The hits are the ones found by casting each ray with #BLI_bvhtree_ray_cast, except between
+ * multiple hits at the same distance: the order leaves are visited in is picked from the first ray.
+ *
+ * \{ */
+
+/**
+ * A version of #fast_ray_nearest_hit for all the rays of the packet,
+ * returns the bit-mask of the rays which hit the bounds closer than their current hit.
+ */
+static int ray_packet_nearest_hit(const BVHRayCastPacketData *data,
+                                  const BVHNode *node,
+                                  float r_dist[BVH_RAYCAST_PACKET_SIZE])
+{
+  const float *bv = node->bv;
+
+#ifdef __SSE2__
+  __m128 t_near = _mm_set1_ps(-FLT_MAX);
+  __m128 t_far = _mm_set1_ps(FLT_MAX);
+  for (int i = 0; i < 3; i++) {
+    const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bv[2 * i]), data->origin[i]),
+                                 data->idot_axis[i]);
+    const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bv[2 * i + 1]), data->origin[i]),
+                                 data->idot_axis[i]);
+    t_near = _mm_max_ps(t_near, _mm_min_ps(t1, t2));
+    t_far = _mm_min_ps(t_far, _mm_max_ps(t1, t2));
+  }
+
+  const __m128 hit_dist = _mm_set_ps(data->rays[3].hit.dist,
+                                     data->rays[2].hit.dist,
+                                     data->rays[1].hit.dist,
+                                     data->rays[0].hit.dist);
+  const __m128 mask = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(t_near, t_far),
+                                            _mm_cmpge_ps(t_far, _mm_setzero_ps())),
+                                 _mm_cmplt_ps(t_near, hit_dist));
+  _mm_storeu_ps(r_dist, t_near);
+  return _mm_movemask_ps(mask);
+#else
+  int mask = 0;
+  for (int i = 0; i < BVH_RAYCAST_PACKET_SIZE; i++) {
+    r_dist[i] = fast_ray_nearest_hit(&data->rays[i], node);
+    if (r_dist[i] < data->rays[i].hit.dist) {
+      mask |= 1 << i;
+    }
+  }
+  UNUSED_VARS(bv);
+  return mask;
+#endif
+}
+
+static void dfs_raycast_packet(BVHRayCastPacketData *data, const BVHNode *node, int mask)
+{
+  float dist[BVH_RAYCAST_PACKET_SIZE];
+  int i;
+
+  /* A ray which misses a node misses all its children. */
+  mask &= ray_packet_nearest_hit(data, node, dist);
+  if (mask == 0) {
+    return;
+  }
+
+  if (node->totnode == 0) {
+    for (i = 0; i < data->rays_len; i++) {
+      if ((mask & (1 << i)) == 0) {
+        continue;
+      }
+      BVHRayCastData *ray_data = &data->rays[i];
+      if (ray_data->callback) {
+        ray_data->callback(ray_data->userdata, node->index, &ray_data->ray, &ray_data->hit);
+      }
+      else {
+        ray_data->hit.index = node->index;
+        ray_data->hit.dist = dist[i];
+        madd_v3_v3v3fl(ray_data->hit.co, ray_data->ray.origin, ray_data->ray.direction, dist[i]);
+      }
+    }
+  }
+  else {
+    /* Pick loop direction from the first ray, the rays of a packet are expected
+     * to point in similar directions for packet traversal to pay off. */
+    if (data->rays[0].ray_dot_axis[node->main_axis] > 0.0f) {
+      for (i = 0; i != node->totnode; i++) {
+        dfs_raycast_packet(data, node->children[i], mask);
+      }
+    }
+    else {
+      for (i = node->totnode - 1; i >= 0; i--) {
+        dfs_raycast_packet(data, node->children[i], mask);
+      }
+    }
+  }
+}
+
+/**
+ * Cast up to #BVH_RAYCAST_PACKET_SIZE rays at once, see #BLI_bvhtree_ray_cast_ex.
+ *
+ * \param hits: The hit of each ray, must be initialized by the caller
+ * (as done for the \a hit argument of a single ray cast).
+ *
+ * \note Rays with a \a radius are cast one by one.
+ */
+void BLI_bvhtree_ray_cast_packet(BVHTree *tree,
+                                 const float (*co)[3],
+                                 const float (*dir)[3],
+                                 int rays_len,
+                                 float radius,
+                                 BVHTreeRayHit *hits,
+                                 BVHTree_RayCastCallback callback,
+                                 void *userdata,
+                                 int flag)
+{
+  BVHRayCastPacketData data;
+  BVHNode *root = tree->nodes[tree->totleaf];
+  int i;
+
+  BLI_assert(rays_len > 0 && rays_len <= BVH_RAYCAST_PACKET_SIZE);
+
+  if (radius != 0.0f) {
+    /* Only #ray_nearest_hit supports a radius, there is no packet version of it. */
+    for (i = 0; i < rays_len; i++) {
+      BLI_bvhtree_ray_cast_ex(tree, co[i], dir[i], radius, &hits[i], callback, userdata, flag);
+    }
+    return;
+  }
+
+  if (root == NULL) {
+    return;
+  }
+
+  data.rays_len = rays_len;
+
+  for (i = 0; i < rays_len; i++) {
+    BVHRayCastData *ray_data = &data.rays[i];
+
+    BLI_ASSERT_UNIT_V3(dir[i]);
+
+    ray_data->tree = tree;
+    ray_data->callback = callback;
+    ray_data->userdata = userdata;
+
+    copy_v3_v3(ray_data->ray.origin, co[i]);
+    copy_v3_v3(ray_data->ray.direction, dir[i]);
+    ray_data->ray.radius = 0.0f;
+
+    bvhtree_ray_cast_data_precalc(ray_data, flag);
+
+    ray_data->hit = hits[i];
+  }
+
+  /* Fill the unused rays with valid values, they are masked out by their negative hit distance. */
+  for (; i < BVH_RAYCAST_PACKET_SIZE; i++) {
+    data.rays[i] = data.rays[0];
+    data.rays[i].hit.dist = -FLT_MAX;
+  }
+
+#ifdef __SSE2__
+  for (i = 0; i < 3; i++) {
+    data.origin[i] = _mm_set_ps(data.rays[3].ray.origin[i],
+                                data.rays[2].ray.origin[i],
+                                data.rays[1].ray.origin[i],
+                                data.rays[0].ray.origin[i]);
+    data.idot_axis[i] = _mm_set_ps(data.rays[3].idot_axis[i],
+                                   data.rays[2].idot_axis[i],
+                                   data.rays[1].idot_axis[i],
+                                   data.rays[0].idot_axis[i]);
+  }
+#endif
+
+  dfs_raycast_packet(&data, root, (1 << rays_len) - 1);
+
+  for (i = 0; i < rays_len; i++) {
+    hits[i] = data.rays[i].hit;
+  }
+}
+
+typedef struct BVHRayCastBatchData {
+  BVHTree *tree;
+  const float (*co)[3];
+  const float (*dir)[3];
+  int rays_len;
+  float radius;
+  BVHTreeRayHit *hits;
+  BVHTree_RayCastCallback callback;
+  void *userdata;
+  int flag;
+} BVHRayCastBatchData;
+
+static void bvhtree_ray_cast_batch_cb(void *__restrict userdata,
+                                      const int packet_index,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHRayCastBatchData *data = userdata;
+  const int start = packet_index * BVH_RAYCAST_PACKET_SIZE;
+
+  BLI_bvhtree_ray_cast_packet(data->tree,
+                              &data->co[start],
+                              &data->dir[start],
+                              min_ii(BVH_RAYCAST_PACKET_SIZE, data->rays_len - start),
+                              data->radius,
+                              &data->hits[start],
+                              data->callback,
+                              data->userdata,
+                              data->flag);
+}
+
+/**
+ * Cast all the rays, as packets of consecutive rays spread over multiple threads,
+ * see #BLI_bvhtree_ray_cast_packet.
+ *
+ * Rays next to each other in the arrays should start close to each other and point in similar
+ * directions (e.g. rays for neighboring pixels), for their packets to share most of the traversal.
+ *
+ * \note The \a callback is called from multiple threads at once.
+ */
+void BLI_bvhtree_ray_cast_batch(BVHTree *tree,
+                                const float (*co)[3],
+                                const float (*dir)[3],
+                                int rays_len,
+                                float radius,
+                                BVHTreeRayHit *hits,
+                                BVHTree_RayCastCallback callback,
+                                void *userdata,
+                                int flag)
+{
+  BVHRayCastBatchData data = {
+      .tree = tree,
+      .co = co,
+      .dir = dir,
+      .rays_len = rays_len,
+      .radius = radius,
+      .hits = hits,
+      .callback = callback,
+      .userdata = userdata,
+      .flag = flag,
+  };
+
+  const int packets_len = (rays_len + BVH_RAYCAST_PACKET_SIZE - 1) / BVH_RAYCAST_PACKET_SIZE;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (rays_len > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, packets_len, &data, bvhtree_ray_cast_batch_cb, &settings);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name BLI_bvhtree_range_query
  *
@@ -541,10 +541,75 @@ void BLI_mempool_iternew(BLI_mempool *pool, BLI_mempool_iter *iter)
   iter->pool = pool;
   iter->curchunk = pool->chunks;
   iter->curindex = 0;
+  iter->endchunk = NULL;
 
   iter->curchunk_threaded_shared = NULL;
 }
 
+/**
+ * Initialize a mempool iterator only going over the chunks from \a chunk_first
+ * up to (but not including) \a chunk_end, NULL meaning the end of the pool.
+ *
+ * Used with #BLI_mempool_chunks_as_tableN to split iteration into ranges of chunks.
+ */
+void BLI_mempool_iternew_chunks(BLI_mempool *pool,
+                                BLI_mempool_iter *iter,
+                                BLI_mempool_chunk *chunk_first,
+                                BLI_mempool_chunk *chunk_end)
+{
+  BLI_assert(pool->flag & BLI_MEMPOOL_ALLOW_ITER);
+  BLI_assert(chunk_first != chunk_end);
+
+  iter->pool = pool;
+  iter->curchunk = chunk_first;
+  iter->curindex = 0;
+  iter->endchunk = chunk_end;
+
+  iter->curchunk_threaded_shared = NULL;
+}
+
+/**
+ * \return all chunks of the pool in iteration order, the array must be freed by the caller.
+ * It is terminated by an extra NULL item, so `chunks[i + 1]` is always a valid end chunk.
+ */
+BLI_mempool_chunk **BLI_mempool_chunks_as_tableN(BLI_mempool *pool,
+                                                 uint *r_chunks_len,
+                                                 const char *allocstr)
+{
+  uint chunks_len = 0;
+  for (BLI_mempool_chunk *mpchunk = pool->chunks; mpchunk; mpchunk = mpchunk->next) {
+    chunks_len++;
+  }
+
+  BLI_mempool_chunk **chunks = MEM_mallocN(sizeof(*chunks) * (chunks_len + 1), allocstr);
+  BLI_mempool_chunk **chunk_p = chunks;
+  for (BLI_mempool_chunk *mpchunk = pool->chunks; mpchunk; mpchunk = mpchunk->next) {
+    *chunk_p++ = mpchunk;
+  }
+  *chunk_p = NULL;
+
+  *r_chunks_len = chunks_len;
+  return chunks;
+}
+
+/**
+ * \return the number of used elements in \a chunk, #BLI_MEMPOOL_ALLOW_ITER flag must be set.
+ */
+uint BLI_mempool_chunk_used_len(const BLI_mempool *pool, const BLI_mempool_chunk *chunk)
+{
+  BLI_assert(pool->flag & BLI_MEMPOOL_ALLOW_ITER);
+
+  const uint esize = pool->esize;
+  const BLI_freenode *curnode = (const void *)(chunk + 1);
+  uint used_len = 0;
+  for (uint i = pool->pchunk; i--; curnode = NODE_STEP_NEXT(curnode)) {
+    if (curnode->freeword != FREEWORD) {
+      used_len++;
+    }
+  }
+  return used_len;
+}
+
 /**
  * Initialize an array of mempool iterators, #BLI_MEMPOOL_ALLOW_ITER flag must be set.
  *
@@ -619,6 +684,9 @@ static void *bli_mempool_iternext(BLI_mempool_iter *iter)
       }
     }
     iter->curchunk = iter->curchunk->next;
+    if (iter->curchunk == iter->endchunk) {
+      iter->curchunk = NULL;
+    }
   }
 
   return ret;
@@ -673,7 +741,8 @@ void *BLI_mempool_iterstep(BLI_mempool_iter *iter)
         }
       }
       iter->curchunk = iter->curchunk->next;
-      if (UNLIKELY(iter->curchunk == NULL)) {
+      if (UNLIKELY(iter->curchunk == iter->endchunk)) {
+        iter->curchunk = NULL;
         return (ret->freeword == FREEWORD) ? NULL : ret;
       }
       curnode = CHUNK_DATA(iter->curchunk);
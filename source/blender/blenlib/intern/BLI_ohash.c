@@ -0,0 +1,637 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * Open addressing hash table, see BLI_ohash.h for the public API.
+ *
+ * All entries are stored in one power of two sized array. Collisions are resolved with linear
+ * probing, which keeps the probe sequence in as few cache lines as possible. The slot of a hash
+ * is found with Fibonacci hashing, so weak hash functions (e.g. identity hashes of integers)
+ * still spread well over the table.
+ *
+ * Removal uses backward shift deletion instead of tombstones, so lookups never become slower
+ * after many removals.
+ *
+ * The full hash is stored in every entry, so growing the table and skipping non-matching entries
+ * never have to call the hash or compare callbacks.
+ */
+
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+
+#include "BLI_ohash.h"
+
+#include "BLI_strict_flags.h"
+
+/* Smallest table size, as a power of two. */
+#define OHASH_SIZE_EXP_MIN 4
+/* Golden ratio multiplier for Fibonacci hashing. */
+#define OHASH_FIB_MULT 2654435769u
+
+typedef struct OHashEntry {
+  void *key;
+  void *val;
+  uint hash;
+  /* Keys may be NULL (e.g. integer keys), so emptiness can't be stored in the key. */
+  uint is_used;
+} OHashEntry;
+
+struct OHash {
+  GHashHashFP hashfp;
+  GHashCmpFP cmpfp;
+
+  OHashEntry *entries;
+  uint nentries;
+  /* Number of entries the table may hold before it has to grow. */
+  uint limit_grow;
+  uint size_mask;
+  /* 32 - log2(table size). */
+  uint hash_shift;
+
+  const char *info;
+};
+
+/* -------------------------------------------------------------------- */
+/** \name Internal Utility API
+ * \{ */
+
+BLI_INLINE uint ohash_size(const OHash *oh)
+{
+  return oh->size_mask + 1;
+}
+
+BLI_INLINE uint ohash_limit_grow(const uint size)
+{
+  /* Keep the load factor below 2/3, linear probing degrades quickly above that. */
+  return (size * 2) / 3;
+}
+
+BLI_INLINE uint ohash_slot_from_hash(const OHash *oh, const uint hash)
+{
+  return (hash * OHASH_FIB_MULT) >> oh->hash_shift;
+}
+
+static uint ohash_size_exp_for_reserve(const uint nentries_reserve)
+{
+  uint size_exp = OHASH_SIZE_EXP_MIN;
+  while (ohash_limit_grow(1u << size_exp) < nentries_reserve) {
+    size_exp++;
+  }
+  return size_exp;
+}
+
+/**
+ * Allocate a new, empty table and reinsert all existing entries into it.
+ */
+static void ohash_resize(OHash *oh, const uint size_exp)
+{
+  OHashEntry *entries_old = oh->entries;
+  const uint size_old = entries_old ? ohash_size(oh) : 0;
+  const uint size_new = 1u << size_exp;
+
+  BLI_assert(ohash_limit_grow(size_new) >= oh->nentries);
+
+  oh->entries = MEM_calloc_arrayN(size_new, sizeof(*oh->entries), oh->info);
+  oh->size_mask = size_new - 1;
+  oh->hash_shift = 32 - size_exp;
+  oh->limit_grow = ohash_limit_grow(size_new);
+
+  for (uint i = 0; i < size_old; i++) {
+    const OHashEntry *e_old = &entries_old[i];
+    if (e_old->is_used) {
+      uint slot = ohash_slot_from_hash(oh, e_old->hash);
+      while (oh->entries[slot].is_used) {
+        slot = (slot + 1) & oh->size_mask;
+      }
+      oh->entries[slot] = *e_old;
+    }
+  }
+
+  MEM_SAFE_FREE(entries_old);
+}
+
+/**
+ * Ensure there is room for one more entry.
+ * Invalidates all entry pointers when the table grows.
+ */
+BLI_INLINE void ohash_ensure_space_for_one(OHash *oh)
+{
+  if (UNLIKELY(oh->nentries >= oh->limit_grow)) {
+    ohash_resize(oh, 33 - oh->hash_shift);
+  }
+}
+
+/**
+ * Return the entry matching \a key, or NULL.
+ */
+BLI_INLINE OHashEntry *ohash_lookup_entry(const OHash *oh, const void *key)
+{
+  const uint hash = oh->hashfp(key);
+  uint slot = ohash_slot_from_hash(oh, hash);
+  while (true) {
+    OHashEntry *e = &oh->entries[slot];
+    if (!e->is_used) {
+      return NULL;
+    }
+    if (e->hash == hash && !oh->cmpfp(key, e->key)) {
+      return e;
+    }
+    slot = (slot + 1) & oh->size_mask;
+  }
+}
+
+/**
+ * Return the entry matching \a key or the empty entry it should be inserted in.
+ * The table must have room for one more entry.
+ */
+BLI_INLINE OHashEntry *ohash_lookup_entry_or_empty(const OHash *oh,
+                                                   const void *key,
+                                                   const uint hash)
+{
+  uint slot = ohash_slot_from_hash(oh, hash);
+  while (true) {
+    OHashEntry *e = &oh->entries[slot];
+    if (!e->is_used || (e->hash == hash && !oh->cmpfp(key, e->key))) {
+      return e;
+    }
+    slot = (slot + 1) & oh->size_mask;
+  }
+}
+
+/**
+ * Insert without checking if the key already exists.
+ */
+BLI_INLINE OHashEntry *ohash_insert_entry(OHash *oh, void *key, void *val, const uint hash)
+{
+  uint slot = ohash_slot_from_hash(oh, hash);
+  while (oh->entries[slot].is_used) {
+    slot = (slot + 1) & oh->size_mask;
+  }
+  OHashEntry *e = &oh->entries[slot];
+  e->key = key;
+  e->val = val;
+  e->hash = hash;
+  e->is_used = true;
+  oh->nentries++;
+  return e;
+}
+
+/**
+ * Remove the entry, shifting back the entries following it in the probe sequence so that no
+ * entry becomes unreachable from its ideal slot.
+ */
+static void ohash_remove_entry(OHash *oh, OHashEntry *e)
+{
+  uint slot_empty = (uint)(e - oh->entries);
+  uint slot = slot_empty;
+
+  while (true) {
+    slot = (slot + 1) & oh->size_mask;
+    OHashEntry *e_next = &oh->entries[slot];
+    if (!e_next->is_used) {
+      break;
+    }
+    /* The entry can only move back to the empty slot if that does not put it before its ideal
+     * slot, taking wrapping around the end of the table into account. */
+    const uint slot_ideal = ohash_slot_from_hash(oh, e_next->hash);
+    const uint dist_empty = (slot - slot_empty) & oh->size_mask;
+    const uint dist_ideal = (slot - slot_ideal) & oh->size_mask;
+    if (dist_ideal >= dist_empty) {
+      oh->entries[slot_empty] = *e_next;
+      slot_empty = slot;
+    }
+  }
+
+  memset(&oh->entries[slot_empty], 0, sizeof(*oh->entries));
+  oh->nentries--;
+}
+
+static void ohash_free_entries(OHash *oh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  if (keyfreefp == NULL && valfreefp == NULL) {
+    return;
+  }
+  const uint size = ohash_size(oh);
+  for (uint i = 0; i < size; i++) {
+    OHashEntry *e = &oh->entries[i];
+    if (e->is_used) {
+      if (keyfreefp) {
+        keyfreefp(e->key);
+      }
+      if (valfreefp) {
+        valfreefp(e->val);
+      }
+    }
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name OHash Public API
+ * \{ */
+
+/**
+ * Creates a new, empty OHash.
+ *
+ * \param hashfp: Hash callback.
+ * \param cmpfp: Comparison callback.
+ * \param info: Identifier string for the OHash.
+ * \param nentries_reserve: Optionally reserve the number of members that the hash will hold.
+ * Use this to avoid resizing buckets if the size is known or can be closely approximated.
+ * \return  An empty OHash.
+ */
+OHash *BLI_ohash_new_ex(GHashHashFP hashfp,
+                        GHashCmpFP cmpfp,
+                        const char *info,
+                        const uint nentries_reserve)
+{
+  OHash *oh = MEM_mallocN(sizeof(*oh), info);
+  oh->hashfp = hashfp;
+  oh->cmpfp = cmpfp;
+  oh->entries = NULL;
+  oh->nentries = 0;
+  oh->info = info;
+  ohash_resize(oh, ohash_size_exp_for_reserve(nentries_reserve));
+  return oh;
+}
+
+/**
+ * Wraps #BLI_ohash_new_ex with zero entries reserved.
+ */
+OHash *BLI_ohash_new(GHashHashFP hashfp, GHashCmpFP cmpfp, const char *info)
+{
+  return BLI_ohash_new_ex(hashfp, cmpfp, info, 0);
+}
+
+/**
+ * Frees the OHash and its members.
+ *
+ * \param oh: The OHash to free.
+ * \param keyfreefp: Optional callback to free the key.
+ * \param valfreefp: Optional callback to free the value.
+ */
+void BLI_ohash_free(OHash *oh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  ohash_free_entries(oh, keyfreefp, valfreefp);
+  MEM_freeN(oh->entries);
+  MEM_freeN(oh);
+}
+
+/**
+ * Reserve given amount of entries (resize \a oh accordingly if needed).
+ */
+void BLI_ohash_reserve(OHash *oh, const uint nentries_reserve)
+{
+  const uint size_exp = ohash_size_exp_for_reserve(nentries_reserve);
+  if ((1u << size_exp) > ohash_size(oh)) {
+    ohash_resize(oh, size_exp);
+  }
+}
+
+/**
+ * Insert a key/value pair into the \a oh.
+ *
+ * \note Duplicates are not checked,
+ * the caller is expected to ensure elements are unique.
+ */
+void BLI_ohash_insert(OHash *oh, void *key, void *val)
+{
+  BLI_assert(!BLI_ohash_haskey(oh, key));
+  ohash_ensure_space_for_one(oh);
+  ohash_insert_entry(oh, key, val, oh->hashfp(key));
+}
+
+/**
+ * Inserts a new value to a key that may already be in ohash.
+ *
+ * Avoids #BLI_ohash_remove, #BLI_ohash_insert calls (double lookups)
+ *
+ * \returns true if a new key has been added.
+ */
+bool BLI_ohash_reinsert(
+    OHash *oh, void *key, void *val, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  ohash_ensure_space_for_one(oh);
+  const uint hash = oh->hashfp(key);
+  OHashEntry *e = ohash_lookup_entry_or_empty(oh, key, hash);
+  if (e->is_used) {
+    if (keyfreefp) {
+      keyfreefp(e->key);
+    }
+    if (valfreefp) {
+      valfreefp(e->val);
+    }
+    e->key = key;
+    e->val = val;
+    return false;
+  }
+  e->key = key;
+  e->val = val;
+  e->hash = hash;
+  e->is_used = true;
+  oh->nentries++;
+  return true;
+}
+
+/**
+ * Lookup the value of \a key in \a oh.
+ *
+ * \param key: The key to lookup.
+ * \returns the value for \a key or NULL.
+ *
+ * \note When NULL is a valid value, use #BLI_ohash_lookup_p to differentiate a missing key
+ * from a key with a NULL value. (Avoid calling #BLI_ohash_haskey before #BLI_ohash_lookup)
+ */
+void *BLI_ohash_lookup(const OHash *oh, const void *key)
+{
+  const OHashEntry *e = ohash_lookup_entry(oh, key);
+  return e ? e->val : NULL;
+}
+
+/**
+ * A version of #BLI_ohash_lookup which accepts a fallback argument.
+ */
+void *BLI_ohash_lookup_default(const OHash *oh, const void *key, void *val_default)
+{
+  const OHashEntry *e = ohash_lookup_entry(oh, key);
+  return e ? e->val : val_default;
+}
+
+/**
+ * Lookup a pointer to the value of \a key in \a oh.
+ *
+ * \param key: The key to lookup.
+ * \returns the pointer to value for \a key or NULL.
+ *
+ * \note This has 2 main benefits over #BLI_ohash_lookup.
+ * - A NULL return always means that \a key isn't in \a oh.
+ * - The value can be modified in-place without further function calls (faster).
+ *
+ * \warning The pointer is only valid until the next insertion or removal.
+ */
+void **BLI_ohash_lookup_p(OHash *oh, const void *key)
+{
+  OHashEntry *e = ohash_lookup_entry(oh, key);
+  return e ? &e->val : NULL;
+}
+
+/**
+ * Ensure \a key is exists in \a oh.
+ *
+ * This handles the common situation where the caller needs ensure a key is added to \a oh,
+ * constructing a new value in the case the key isn't found.
+ * Otherwise use the existing value.
+ *
+ * Such situations typically incur multiple lookups, however this function
+ * avoids them by ensuring the key is added,
+ * returning a pointer to the value so it can be used or initialized by the caller.
+ *
+ * \returns true when the value didn't need to be added.
+ * (when false, the caller _must_ initialize the value).
+ */
+bool BLI_ohash_ensure_p(OHash *oh, void *key, void ***r_val)
+{
+  ohash_ensure_space_for_one(oh);
+  const uint hash = oh->hashfp(key);
+  OHashEntry *e = ohash_lookup_entry_or_empty(oh, key, hash);
+  const bool haskey = e->is_used;
+  if (!haskey) {
+    e->key = key;
+    e->val = NULL;
+    e->hash = hash;
+    e->is_used = true;
+    oh->nentries++;
+  }
+  *r_val = &e->val;
+  return haskey;
+}
+
+/**
+ * Remove \a key from \a oh, or return false if the key wasn't found.
+ *
+ * \param key: The key to remove.
+ * \param keyfreefp: Optional callback to free the key.
+ * \param valfreefp: Optional callback to free the value.
+ * \return true if \a key was removed from \a oh.
+ */
+bool BLI_ohash_remove(OHash *oh,
+                      const void *key,
+                      GHashKeyFreeFP keyfreefp,
+                      GHashValFreeFP valfreefp)
+{
+  OHashEntry *e = ohash_lookup_entry(oh, key);
+  if (e == NULL) {
+    return false;
+  }
+  if (keyfreefp) {
+    keyfreefp(e->key);
+  }
+  if (valfreefp) {
+    valfreefp(e->val);
+  }
+  ohash_remove_entry(oh, e);
+  return true;
+}
+
+/**
+ * Remove \a key from \a oh, returning the value or NULL if the key wasn't found.
+ *
+ * \param key: The key to remove.
+ * \param keyfreefp: Optional callback to free the key.
+ * \return the value of \a key int \a oh or NULL.
+ */
+void *BLI_ohash_popkey(OHash *oh, const void *key, GHashKeyFreeFP keyfreefp)
+{
+  OHashEntry *e = ohash_lookup_entry(oh, key);
+  if (e == NULL) {
+    return NULL;
+  }
+  void *val = e->val;
+  if (keyfreefp) {
+    keyfreefp(e->key);
+  }
+  ohash_remove_entry(oh, e);
+  return val;
+}
+
+/**
+ * Reset \a oh clearing all entries.
+ *
+ * The table keeps its size, so refilling it to a similar size doesn't need to grow it again.
+ *
+ * \param keyfreefp: Optional callback to free the key.
+ * \param valfreefp: Optional callback to free the value.
+ */
+void BLI_ohash_clear(OHash *oh, GHashKeyFreeFP keyfreefp, GHashValFreeFP valfreefp)
+{
+  ohash_free_entries(oh, keyfreefp, valfreefp);
+  memset(oh->entries, 0, sizeof(*oh->entries) * ohash_size(oh));
+  oh->nentries = 0;
+}
+
+/**
+ * \return true if the \a key is in \a oh.
+ */
+bool BLI_ohash_haskey(const OHash *oh, const void *key)
+{
+  return (ohash_lookup_entry(oh, key) != NULL);
+}
+
+/**
+ * \return size of the OHash.
+ */
+uint BLI_ohash_len(const OHash *oh)
+{
+  return oh->nentries;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name OHash Iterator API
+ * \{ */
+
+BLI_INLINE uint ohash_iterator_next_used(const OHash *oh, uint slot)
+{
+  const uint size = ohash_size(oh);
+  while (slot < size && !oh->entries[slot].is_used) {
+    slot++;
+  }
+  return slot;
+}
+
+/**
+ * Init an already allocated OHashIterator. The hash table must not be mutated during the lifetime
+ * of the iterator (i.e. after init'ing the iterator and until the last step).
+ */
+void BLI_ohashIterator_init(OHashIterator *ohi, OHash *oh)
+{
+  ohi->oh = oh;
+  ohi->curr_slot = ohash_iterator_next_used(oh, 0);
+}
+
+/**
+ * Steps the iterator to the next index.
+ */
+void BLI_ohashIterator_step(OHashIterator *ohi)
+{
+  BLI_assert(!BLI_ohashIterator_done(ohi));
+  ohi->curr_slot = ohash_iterator_next_used(ohi->oh, ohi->curr_slot + 1);
+}
+
+/**
+ * \return true when there are no more entries to step over.
+ */
+bool BLI_ohashIterator_done(const OHashIterator *ohi)
+{
+  return ohi->curr_slot >= ohash_size(ohi->oh);
+}
+
+void *BLI_ohashIterator_getKey(const OHashIterator *ohi)
+{
+  BLI_assert(!BLI_ohashIterator_done(ohi));
+  return ohi->oh->entries[ohi->curr_slot].key;
+}
+
+void *BLI_ohashIterator_getValue(const OHashIterator *ohi)
+{
+  BLI_assert(!BLI_ohashIterator_done(ohi));
+  return ohi->oh->entries[ohi->curr_slot].val;
+}
+
+void **BLI_ohashIterator_getValue_p(const OHashIterator *ohi)
+{
+  BLI_assert(!BLI_ohashIterator_done(ohi));
+  return &ohi->oh->entries[ohi->curr_slot].val;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name OSet Public API
+ *
+ * Use ohash API to give 'set' functionality
+ * \{ */
+
+OSet *BLI_oset_new_ex(GSetHashFP hashfp,
+                      GSetCmpFP cmpfp,
+                      const char *info,
+                      const uint nentries_reserve)
+{
+  return (OSet *)BLI_ohash_new_ex(hashfp, cmpfp, info, nentries_reserve);
+}
+
+OSet *BLI_oset_new(GSetHashFP hashfp, GSetCmpFP cmpfp, const char *info)
+{
+  return BLI_oset_new_ex(hashfp, cmpfp, info, 0);
+}
+
+void BLI_oset_free(OSet *os, GSetKeyFreeFP keyfreefp)
+{
+  BLI_ohash_free((OHash *)os, keyfreefp, NULL);
+}
+
+void BLI_oset_reserve(OSet *os, const uint nentries_reserve)
+{
+  BLI_ohash_reserve((OHash *)os, nentries_reserve);
+}
+
+/**
+ * Adds the key to the set (no checks for unique keys!).
+ * Matching #BLI_ohash_insert
+ */
+void BLI_oset_insert(OSet *os, void *key)
+{
+  BLI_ohash_insert((OHash *)os, key, NULL);
+}
+
+/**
+ * A version of BLI_oset_insert which checks first if the key is in the set.
+ * \returns true if a new key has been added.
+ */
+bool BLI_oset_add(OSet *os, void *key)
+{
+  void **val_p;
+  return !BLI_ohash_ensure_p((OHash *)os, key, &val_p);
+}
+
+bool BLI_oset_haskey(const OSet *os, const void *key)
+{
+  return BLI_ohash_haskey((const OHash *)os, key);
+}
+
+bool BLI_oset_remove(OSet *os, const void *key, GSetKeyFreeFP keyfreefp)
+{
+  return BLI_ohash_remove((OHash *)os, key, keyfreefp, NULL);
+}
+
+void BLI_oset_clear(OSet *os, GSetKeyFreeFP keyfreefp)
+{
+  BLI_ohash_clear((OHash *)os, keyfreefp, NULL);
+}
+
+uint BLI_oset_len(const OSet *os)
+{
+  return BLI_ohash_len((const OHash *)os);
+}
+
+/** \} */
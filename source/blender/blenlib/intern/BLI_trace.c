@@ -0,0 +1,193 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * The events are written as they happen under a mutex. The closing bracket is optional in the
+ * JSON Array Format, so a trace which wasn't ended is still usable after #BLI_trace_flush.
+ */
+
+#include <stdio.h>
+
+#include "BLI_utildefines.h"
+
+#include "BLI_fileops.h"
+#include "BLI_string.h"
+#include "BLI_threads.h"
+#include "BLI_trace.h"
+
+#include "atomic_ops.h"
+
+bool BLI_trace_enabled = false;
+
+static ThreadMutex trace_mutex = BLI_MUTEX_INITIALIZER;
+static FILE *trace_file = NULL;
+/* All the times in the trace are relative to it. */
+static double trace_begin_time = 0.0;
+static char trace_process_names[BLI_TRACE_PROCESS_MAX][64] = {{0}};
+
+/* Thread IDs of the zones, stored plus one so zero means not assigned yet. */
+static ThreadLocal(void *) trace_thread_id;
+static bool trace_thread_id_created = false;
+static int trace_thread_id_last = 0;
+
+static void trace_write_string(const char *str)
+{
+  fputc('"', trace_file);
+  for (const char *c = str; *c != '\0'; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fputc('\\', trace_file);
+      fputc(*c, trace_file);
+    }
+    else if ((unsigned char)*c < 0x20) {
+      fprintf(trace_file, "\\u%04x", (unsigned char)*c);
+    }
+    else {
+      fputc(*c, trace_file);
+    }
+  }
+  fputc('"', trace_file);
+}
+
+bool BLI_trace_begin(const char *filepath)
+{
+  BLI_trace_end();
+  FILE *file = BLI_fopen(filepath, "w");
+  if (file == NULL) {
+    return false;
+  }
+  BLI_mutex_lock(&trace_mutex);
+  if (!trace_thread_id_created) {
+    BLI_thread_local_create(trace_thread_id);
+    trace_thread_id_created = true;
+  }
+  trace_file = file;
+  trace_begin_time = PIL_check_seconds_timer();
+  fprintf(file, "[\n");
+  BLI_trace_enabled = true;
+  BLI_mutex_unlock(&trace_mutex);
+  BLI_trace_process_name_set(BLI_TRACE_PROCESS_ZONES, "Blender");
+  return true;
+}
+
+void BLI_trace_end(void)
+{
+  BLI_mutex_lock(&trace_mutex);
+  if (trace_file != NULL) {
+    BLI_trace_enabled = false;
+    for (int i = 0; i < BLI_TRACE_PROCESS_MAX; i++) {
+      if (trace_process_names[i][0] != '\0') {
+        fprintf(trace_file,
+                "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":",
+                i);
+        trace_write_string(trace_process_names[i]);
+        fprintf(trace_file, "}},\n");
+      }
+    }
+    /* Metadata event, avoids having to special case the separator of the last event. */
+    fprintf(trace_file,
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,"
+            "\"args\":{\"name\":\"Main\"}}\n",
+            BLI_TRACE_PROCESS_ZONES);
+    fprintf(trace_file, "]\n");
+    fclose(trace_file);
+    trace_file = NULL;
+  }
+  BLI_mutex_unlock(&trace_mutex);
+}
+
+void BLI_trace_flush(void)
+{
+  BLI_mutex_lock(&trace_mutex);
+  if (trace_file != NULL) {
+    fflush(trace_file);
+  }
+  BLI_mutex_unlock(&trace_mutex);
+}
+
+void BLI_trace_process_name_set(int process_id, const char *name)
+{
+  BLI_assert(process_id >= 0 && process_id < BLI_TRACE_PROCESS_MAX);
+  BLI_mutex_lock(&trace_mutex);
+  BLI_strncpy(trace_process_names[process_id], name, sizeof(trace_process_names[process_id]));
+  BLI_mutex_unlock(&trace_mutex);
+}
+
+int BLI_trace_thread_id(void)
+{
+  if (BLI_thread_is_main()) {
+    return 0;
+  }
+  if (!trace_thread_id_created) {
+    /* Only possible when no trace was ever begun, see #BLI_trace_begin. */
+    return 0;
+  }
+  int thread_id = POINTER_AS_INT(BLI_thread_local_get(trace_thread_id));
+  if (thread_id == 0) {
+    thread_id = (int)atomic_add_and_fetch_int32(&trace_thread_id_last, 1);
+    BLI_thread_local_set(trace_thread_id, POINTER_FROM_INT(thread_id));
+  }
+  return thread_id;
+}
+
+void BLI_trace_slice(int process_id,
+                     int thread_id,
+                     const char *name,
+                     const char *category,
+                     const char *detail,
+                     double start_time,
+                     double end_time,
+                     double wait_time)
+{
+  BLI_mutex_lock(&trace_mutex);
+  if (trace_file != NULL) {
+    fprintf(trace_file, "{\"name\":");
+    trace_write_string(name);
+    fprintf(trace_file, ",\"cat\":");
+    trace_write_string(category);
+    fprintf(trace_file,
+            ",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+            process_id,
+            thread_id,
+            (start_time - trace_begin_time) * 1e6,
+            (end_time - start_time) * 1e6);
+    if (detail != NULL) {
+      fprintf(trace_file, "\"detail\":");
+      trace_write_string(detail);
+      if (wait_time > 0.0) {
+        fputc(',', trace_file);
+      }
+    }
+    if (wait_time > 0.0) {
+      fprintf(trace_file, "\"wait_us\":%.3f", wait_time * 1e6);
+    }
+    fprintf(trace_file, "}},\n");
+  }
+  BLI_mutex_unlock(&trace_mutex);
+}
+
+void BLI_trace_zone_write(const TraceZone *zone, double end_time)
+{
+  BLI_trace_slice(BLI_TRACE_PROCESS_ZONES,
+                  BLI_trace_thread_id(),
+                  zone->name,
+                  zone->category,
+                  NULL,
+                  zone->start_time,
+                  end_time,
+                  0.0);
+}
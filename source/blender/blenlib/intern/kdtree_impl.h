@@ -22,6 +22,8 @@
 
 #include "BLI_math.h"
 #include "BLI_kdtree_impl.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #include "BLI_strict_flags.h"
 
@@ -58,6 +60,20 @@ struct KDTree {
 
 #define KD_NODE_UNSET ((uint)-1)
 
+/* Sub-trees with more nodes than this are balanced in their own task. */
+#define KD_BALANCE_THREAD_THRESHOLD 10000
+/* Number of points each thread searches at once in #BLI_kdtree_nd_(range_search_batch). */
+#define KD_RANGE_SEARCH_BATCH_CHUNK_SIZE 64
+/* Trees with fewer nodes than this search for duplicates on a single thread. */
+#define KD_DEDUPLICATE_THREAD_THRESHOLD 10000
+/* Systems with fewer threads than this search for duplicates on a single thread. */
+#define KD_DEDUPLICATE_THREAD_MIN 4
+/* Number of nodes each task searches the neighbors of in the threaded duplicate search. */
+#define KD_DEDUPLICATE_CHUNK_SIZE 1024
+/* Neighbors are stored for the threaded duplicate search, when there are more than this
+ * on average (many coincident points) fall back to the single threaded search. */
+#define KD_DEDUPLICATE_NEIGHBORS_AVERAGE_MAX 32
+
 /**
  * When set we know all values are unbalanced,
  * otherwise clear them when re-balancing: see T62210.
@@ -145,19 +161,15 @@ void BLI_kdtree_nd_(insert)(KDTree *tree, int index, const float co[KD_DIMS])
 #endif
 }
 
-static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+/**
+ * Partially sort \a nodes so the median along \a axis is in the middle,
+ * with smaller values before it and larger ones after it.
+ */
+static uint kdtree_balance_median(KDTreeNode *nodes, uint nodes_len, uint axis)
 {
-  KDTreeNode *node;
   float co;
   uint left, right, median, i, j;
 
-  if (nodes_len <= 0) {
-    return KD_NODE_UNSET;
-  }
-  else if (nodes_len == 1) {
-    return 0 + ofs;
-  }
-
   /* quicksort style sorting around median */
   left = 0;
   right = nodes_len - 1;
@@ -190,6 +202,23 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
     }
   }
 
+  return median;
+}
+
+static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const uint ofs)
+{
+  KDTreeNode *node;
+  uint median;
+
+  if (nodes_len <= 0) {
+    return KD_NODE_UNSET;
+  }
+  else if (nodes_len == 1) {
+    return 0 + ofs;
+  }
+
+  median = kdtree_balance_median(nodes, nodes_len, axis);
+
   /* set node and sort subnodes */
   node = &nodes[median];
   node->d = axis;
@@ -201,6 +230,66 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   return median + ofs;
 }
 
+/**
+ * Multi-threaded balancing: both sub-trees of a node are independent ranges of the array,
+ * large ones are balanced in tasks of their own. The result is the same as #kdtree_balance.
+ */
+typedef struct KDTreeBalanceTask {
+  KDTreeNode *nodes;
+  uint nodes_len;
+  uint axis;
+  uint ofs;
+  /* Where to store the root of the sub-tree. */
+  uint *r_root;
+} KDTreeBalanceTask;
+
+static void kdtree_balance_task_cb(TaskPool *__restrict pool, void *taskdata, int threadid);
+
+static void kdtree_balance_task_push(TaskPool *__restrict pool,
+                                     KDTreeNode *nodes,
+                                     uint nodes_len,
+                                     uint axis,
+                                     uint ofs,
+                                     uint *r_root,
+                                     int threadid)
+{
+  if (nodes_len <= KD_BALANCE_THREAD_THRESHOLD) {
+    *r_root = kdtree_balance(nodes, nodes_len, axis, ofs);
+    return;
+  }
+
+  KDTreeBalanceTask *task = MEM_mallocN(sizeof(*task), __func__);
+  task->nodes = nodes;
+  task->nodes_len = nodes_len;
+  task->axis = axis;
+  task->ofs = ofs;
+  task->r_root = r_root;
+  BLI_task_pool_push_from_thread(
+      pool, kdtree_balance_task_cb, task, true, TASK_PRIORITY_HIGH, threadid);
+}
+
+static void kdtree_balance_task_cb(TaskPool *__restrict pool, void *taskdata, int threadid)
+{
+  const KDTreeBalanceTask *task = taskdata;
+  KDTreeNode *nodes = task->nodes;
+  const uint nodes_len = task->nodes_len;
+  const uint median = kdtree_balance_median(nodes, nodes_len, task->axis);
+  const uint axis = (task->axis + 1) % KD_DIMS;
+  KDTreeNode *node = &nodes[median];
+
+  node->d = task->axis;
+  *task->r_root = median + task->ofs;
+
+  kdtree_balance_task_push(pool, nodes, median, axis, task->ofs, &node->left, threadid);
+  kdtree_balance_task_push(pool,
+                           nodes + median + 1,
+                           nodes_len - (median + 1),
+                           axis,
+                           (median + 1) + task->ofs,
+                           &node->right,
+                           threadid);
+}
+
 void BLI_kdtree_nd_(balance)(KDTree *tree)
 {
   if (tree->root != KD_NODE_ROOT_IS_INIT) {
@@ -210,7 +299,15 @@ void BLI_kdtree_nd_(balance)(KDTree *tree)
     }
   }
 
-  tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  if (tree->nodes_len > KD_BALANCE_THREAD_THRESHOLD) {
+    TaskPool *pool = BLI_task_pool_create(BLI_task_scheduler_get(), NULL);
+    kdtree_balance_task_push(pool, tree->nodes, tree->nodes_len, 0, 0, &tree->root, -1);
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
+  else {
+    tree->root = kdtree_balance(tree->nodes, tree->nodes_len, 0, 0);
+  }
 
 #ifdef DEBUG
   tree->is_balanced = true;
@@ -637,14 +734,14 @@ static void nearest_add_in_range(KDTreeNearest **r_nearest,
 }
 
 /**
- * Range search returns number of points nearest_len, with results in nearest
- *
- * \param r_nearest: Allocated array of nearest nearest_len (caller is responsible for freeing).
+ * Range search into the array \a r_nearest, which is re-allocated when it's too small
+ * (\a r_nearest_len_capacity being its size), so it can be re-used by multiple searches.
  */
-int BLI_kdtree_nd_(range_search_with_len_squared_cb)(
+static uint kdtree_range_search_into(
     const KDTree *tree,
     const float co[KD_DIMS],
     KDTreeNearest **r_nearest,
+    uint *r_nearest_len_capacity,
     const float range,
     float (*len_sq_fn)(const float co_search[KD_DIMS],
                        const float co_test[KD_DIMS],
@@ -653,11 +750,11 @@ int BLI_kdtree_nd_(range_search_with_len_squared_cb)(
 {
   const KDTreeNode *nodes = tree->nodes;
   uint *stack, stack_default[KD_STACK_INIT];
-  KDTreeNearest *nearest = NULL;
+  KDTreeNearest *nearest = *r_nearest;
   const float range_sq = range * range;
   float dist_sq;
   uint stack_len_capacity, cur = 0;
-  uint nearest_len = 0, nearest_len_capacity = 0;
+  uint nearest_len = 0, nearest_len_capacity = *r_nearest_len_capacity;
 
 #ifdef DEBUG
   BLI_assert(tree->is_balanced == true);
@@ -718,6 +815,35 @@ int BLI_kdtree_nd_(range_search_with_len_squared_cb)(
     qsort(nearest, nearest_len, sizeof(KDTreeNearest), nearest_cmp_dist);
   }
 
+  *r_nearest = nearest;
+  *r_nearest_len_capacity = nearest_len_capacity;
+
+  return nearest_len;
+}
+
+/**
+ * Range search returns number of points nearest_len, with results in nearest
+ *
+ * \param r_nearest: Allocated array of nearest nearest_len (caller is responsible for freeing).
+ */
+int BLI_kdtree_nd_(range_search_with_len_squared_cb)(
+    const KDTree *tree,
+    const float co[KD_DIMS],
+    KDTreeNearest **r_nearest,
+    const float range,
+    float (*len_sq_fn)(const float co_search[KD_DIMS],
+                       const float co_test[KD_DIMS],
+                       const void *user_data),
+    const void *user_data)
+{
+  KDTreeNearest *nearest = NULL;
+  uint nearest_len_capacity = 0;
+  const uint nearest_len = kdtree_range_search_into(
+      tree, co, &nearest, &nearest_len_capacity, range, len_sq_fn, user_data);
+
+  if (nearest_len == 0) {
+    MEM_SAFE_FREE(nearest);
+  }
   *r_nearest = nearest;
 
   return (int)nearest_len;
@@ -731,6 +857,77 @@ int BLI_kdtree_nd_(range_search)(const KDTree *tree,
   return BLI_kdtree_nd_(range_search_with_len_squared_cb)(tree, co, r_nearest, range, NULL, NULL);
 }
 
+typedef struct KDTreeRangeSearchBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  float range;
+  void (*batch_cb)(void *user_data, uint co_index, const KDTreeNearest *nearest, int nearest_len);
+  void *user_data;
+} KDTreeRangeSearchBatchData;
+
+typedef struct KDTreeRangeSearchBatchTLS {
+  KDTreeNearest *nearest;
+  uint nearest_len_capacity;
+} KDTreeRangeSearchBatchTLS;
+
+static void kdtree_range_search_batch_cb(void *__restrict userdata,
+                                         const int iter,
+                                         const TaskParallelTLS *__restrict tls)
+{
+  const KDTreeRangeSearchBatchData *data = userdata;
+  KDTreeRangeSearchBatchTLS *tls_data = tls->userdata_chunk;
+  const uint nearest_len = kdtree_range_search_into(data->tree,
+                                                    data->co[iter],
+                                                    &tls_data->nearest,
+                                                    &tls_data->nearest_len_capacity,
+                                                    data->range,
+                                                    len_squared_vnvn_cb,
+                                                    NULL);
+  data->batch_cb(data->user_data, (uint)iter, tls_data->nearest, (int)nearest_len);
+}
+
+static void kdtree_range_search_batch_finalize(void *__restrict UNUSED(userdata),
+                                               void *__restrict userdata_chunk)
+{
+  KDTreeRangeSearchBatchTLS *tls_data = userdata_chunk;
+  MEM_SAFE_FREE(tls_data->nearest);
+}
+
+/**
+ * Range search around each of the \a co_len points of \a co, using multiple threads.
+ *
+ * \param batch_cb: Called with the result of each search, sorted by distance like
+ * #BLI_kdtree_3d_range_search. The array is only valid during the call, each thread reuses its
+ * array for all its searches.
+ *
+ * \note \a batch_cb is called from multiple threads at once.
+ */
+void BLI_kdtree_nd_(range_search_batch)(
+    const KDTree *tree,
+    const float (*co)[KD_DIMS],
+    uint co_len,
+    float range,
+    void (*batch_cb)(void *user_data, uint co_index, const KDTreeNearest *nearest, int nearest_len),
+    void *user_data)
+{
+  KDTreeRangeSearchBatchData data = {
+      .tree = tree,
+      .co = co,
+      .range = range,
+      .batch_cb = batch_cb,
+      .user_data = user_data,
+  };
+  KDTreeRangeSearchBatchTLS tls_data = {NULL, 0};
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = KD_RANGE_SEARCH_BATCH_CHUNK_SIZE;
+  settings.userdata_chunk = &tls_data;
+  settings.userdata_chunk_size = sizeof(tls_data);
+  settings.func_finalize = kdtree_range_search_batch_finalize;
+  BLI_task_parallel_range(0, (int)co_len, &data, kdtree_range_search_batch_cb, &settings);
+}
+
 /**
  * A version of #BLI_kdtree_3d_range_search which runs a callback
  * instead of allocating an array.
@@ -866,6 +1063,160 @@ static void deduplicate_recursive(const struct DeDuplicateParams *p, uint i)
   }
 }
 
+/**
+ * Threaded duplicate search: the neighbors of all nodes are found on multiple threads first,
+ * the merges are then made in the same order as #deduplicate_recursive would,
+ * so the result is exactly the same as for the single threaded search.
+ */
+struct DeDuplicateNeighborsChunk {
+  /* Neighbors of the nodes in this chunk, one after the other. */
+  int *neighbors;
+  uint neighbors_len;
+  uint neighbors_alloc;
+};
+
+struct DeDuplicateNeighborsData {
+  const KDTreeNode *nodes;
+  uint nodes_len;
+  uint root;
+  float range;
+  float range_sq;
+  /* Offset of the neighbors of each node (in tree order) in the #DeDuplicateNeighborsChunk of
+   * its chunk, #DeDuplicateNeighborsData.neighbors_len stores the number of neighbors. */
+  uint *neighbors_offset;
+  uint *neighbors_len;
+  struct DeDuplicateNeighborsChunk *chunks;
+  /* Set when any chunk has too many neighbors. */
+  bool is_overflow;
+};
+
+static void deduplicate_neighbors_recursive(const struct DeDuplicateNeighborsData *data,
+                                            struct DeDuplicateNeighborsChunk *chunk,
+                                            const float search_co[KD_DIMS],
+                                            const int search,
+                                            uint i)
+{
+  const KDTreeNode *node = &data->nodes[i];
+  if (search_co[node->d] + data->range <= node->co[node->d]) {
+    if (node->left != KD_NODE_UNSET) {
+      deduplicate_neighbors_recursive(data, chunk, search_co, search, node->left);
+    }
+  }
+  else if (search_co[node->d] - data->range >= node->co[node->d]) {
+    if (node->right != KD_NODE_UNSET) {
+      deduplicate_neighbors_recursive(data, chunk, search_co, search, node->right);
+    }
+  }
+  else {
+    if ((search != node->index) && (len_squared_vnvn(node->co, search_co) <= data->range_sq)) {
+      if (UNLIKELY(chunk->neighbors_len == chunk->neighbors_alloc)) {
+        chunk->neighbors_alloc *= 2;
+        chunk->neighbors = MEM_reallocN(chunk->neighbors,
+                                        sizeof(*chunk->neighbors) * chunk->neighbors_alloc);
+      }
+      chunk->neighbors[chunk->neighbors_len++] = node->index;
+    }
+    if (node->left != KD_NODE_UNSET) {
+      deduplicate_neighbors_recursive(data, chunk, search_co, search, node->left);
+    }
+    if (node->right != KD_NODE_UNSET) {
+      deduplicate_neighbors_recursive(data, chunk, search_co, search, node->right);
+    }
+  }
+}
+
+static void deduplicate_neighbors_cb(void *__restrict userdata,
+                                     const int iter,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct DeDuplicateNeighborsData *data = userdata;
+  struct DeDuplicateNeighborsChunk *chunk = &data->chunks[iter];
+  const uint node_start = (uint)iter * KD_DEDUPLICATE_CHUNK_SIZE;
+  const uint node_end = MIN2(node_start + KD_DEDUPLICATE_CHUNK_SIZE, data->nodes_len);
+  const uint neighbors_limit = KD_DEDUPLICATE_CHUNK_SIZE * KD_DEDUPLICATE_NEIGHBORS_AVERAGE_MAX;
+
+  chunk->neighbors_alloc = (node_end - node_start) * 2;
+  chunk->neighbors_len = 0;
+  chunk->neighbors = MEM_mallocN(sizeof(*chunk->neighbors) * chunk->neighbors_alloc, __func__);
+
+  for (uint i = node_start; i < node_end; i++) {
+    const KDTreeNode *node = &data->nodes[i];
+    const uint neighbors_len_prev = chunk->neighbors_len;
+    deduplicate_neighbors_recursive(data, chunk, node->co, node->index, data->root);
+    data->neighbors_offset[i] = neighbors_len_prev;
+    data->neighbors_len[i] = chunk->neighbors_len - neighbors_len_prev;
+    if (chunk->neighbors_len > neighbors_limit) {
+      /* Many coincident points, storing all neighbors would use too much memory. */
+      data->is_overflow = true;
+    }
+    if (data->is_overflow) {
+      break;
+    }
+  }
+}
+
+/* Returns false (without changing \a duplicates) when there are too many neighbors. */
+static bool deduplicate_threaded(const KDTree *tree,
+                                 const float range,
+                                 bool use_index_order,
+                                 int *duplicates,
+                                 int *r_found)
+{
+  const uint nodes_len = tree->nodes_len;
+  const uint chunks_len = (nodes_len + KD_DEDUPLICATE_CHUNK_SIZE - 1) / KD_DEDUPLICATE_CHUNK_SIZE;
+  struct DeDuplicateNeighborsData data = {
+      .nodes = tree->nodes,
+      .nodes_len = nodes_len,
+      .root = tree->root,
+      .range = range,
+      .range_sq = SQUARE(range),
+      .neighbors_offset = MEM_mallocN(sizeof(uint) * nodes_len, __func__),
+      .neighbors_len = MEM_mallocN(sizeof(uint) * nodes_len, __func__),
+      .chunks = MEM_calloc_arrayN(chunks_len, sizeof(*data.chunks), __func__),
+      .is_overflow = false,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, (int)chunks_len, &data, deduplicate_neighbors_cb, &settings);
+
+  int found = 0;
+  if (!data.is_overflow) {
+    uint *order = use_index_order ? kdtree_order(tree) : NULL;
+    for (uint i = 0; i < nodes_len; i++) {
+      const uint node_index = order ? order[i] : i;
+      const int index = order ? (int)i : tree->nodes[node_index].index;
+      if (ELEM(duplicates[index], -1, index)) {
+        const int *neighbors = &data.chunks[node_index / KD_DEDUPLICATE_CHUNK_SIZE]
+                                    .neighbors[data.neighbors_offset[node_index]];
+        const int found_prev = found;
+        for (uint j = 0; j < data.neighbors_len[node_index]; j++) {
+          if (duplicates[neighbors[j]] == -1) {
+            duplicates[neighbors[j]] = index;
+            found++;
+          }
+        }
+        if (found != found_prev) {
+          /* Prevent chains of doubles. */
+          duplicates[index] = index;
+        }
+      }
+    }
+    MEM_SAFE_FREE(order);
+    *r_found = found;
+  }
+
+  for (uint i = 0; i < chunks_len; i++) {
+    MEM_SAFE_FREE(data.chunks[i].neighbors);
+  }
+  MEM_freeN(data.chunks);
+  MEM_freeN(data.neighbors_offset);
+  MEM_freeN(data.neighbors_len);
+
+  return !data.is_overflow;
+}
+
 /**
  * Find duplicate points in \a range.
  * Favors speed over quality since it doesn't find the best target vertex for merging.
@@ -888,8 +1239,31 @@ int BLI_kdtree_nd_(calc_duplicates_fast)(const KDTree *tree,
                                          const float range,
                                          bool use_index_order,
                                          int *duplicates)
+{
+  /* Threads search the neighbors of points which the single threaded search skips,
+   * this only pays off with enough threads. */
+  const bool use_threading = (tree->nodes_len >= KD_DEDUPLICATE_THREAD_THRESHOLD) &&
+                             (BLI_system_thread_count() >= KD_DEDUPLICATE_THREAD_MIN);
+  return BLI_kdtree_nd_(calc_duplicates_fast_ex)(
+      tree, range, use_index_order, use_threading, duplicates);
+}
+
+/**
+ * A version of #BLI_kdtree_3d_calc_duplicates_fast which can skip threading,
+ * the result doesn't depend on \a use_threading.
+ */
+int BLI_kdtree_nd_(calc_duplicates_fast_ex)(const KDTree *tree,
+                                            const float range,
+                                            bool use_index_order,
+                                            bool use_threading,
+                                            int *duplicates)
 {
   int found = 0;
+
+  if (use_threading && deduplicate_threaded(tree, range, use_index_order, duplicates, &found)) {
+    return found;
+  }
+
   struct DeDuplicateParams p = {
       .nodes = tree->nodes,
       .range = range,
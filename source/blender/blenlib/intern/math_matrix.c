@@ -32,6 +32,10 @@
 #  include "eigen_capi.h"
 #endif
 
+#ifdef __SSE2__
+#  include "math_v3_array_sse2.h"
+#endif
+
 /********************************* Init **************************************/
 
 void zero_m2(float m[2][2])
@@ -760,6 +764,78 @@ void mul_v3_mat3_m4v3(float r[3], const float mat[4][4], const float vec[3])
   r[2] = x * mat[0][2] + y * mat[1][2] + mat[2][2] * vec[2];
 }
 
+/**
+ * Transform \a nbr vectors of \a vec_arr by \a mat, same as calling #mul_v3_m4v3 for each of
+ * them (the result is the same), but processes multiple vectors at once when SIMD is available.
+ *
+ * \param r_arr: The output array, may be the same as \a vec_arr but not overlap it otherwise.
+ * \param use_translation: When false, only the 3x3 part of the matrix is used.
+ */
+BLI_INLINE void mul_v3_m4v3_array_ex(float (*r_arr)[3],
+                                     const float mat[4][4],
+                                     const float (*vec_arr)[3],
+                                     const int nbr,
+                                     const bool use_translation)
+{
+  int i = 0;
+
+#ifdef __SSE2__
+  const __m128 m00 = _mm_set1_ps(mat[0][0]), m01 = _mm_set1_ps(mat[0][1]),
+               m02 = _mm_set1_ps(mat[0][2]);
+  const __m128 m10 = _mm_set1_ps(mat[1][0]), m11 = _mm_set1_ps(mat[1][1]),
+               m12 = _mm_set1_ps(mat[1][2]);
+  const __m128 m20 = _mm_set1_ps(mat[2][0]), m21 = _mm_set1_ps(mat[2][1]),
+               m22 = _mm_set1_ps(mat[2][2]);
+  const __m128 m30 = _mm_set1_ps(use_translation ? mat[3][0] : 0.0f),
+               m31 = _mm_set1_ps(use_translation ? mat[3][1] : 0.0f),
+               m32 = _mm_set1_ps(use_translation ? mat[3][2] : 0.0f);
+
+  for (; i + V3_ARRAY_SSE2_STEP < nbr; i += V3_ARRAY_SSE2_STEP) {
+    __m128 x, y, z, w;
+    v3_array_load_sse2(&vec_arr[i], &x, &y, &z, &w);
+
+    __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m00), _mm_mul_ps(y, m10)), _mm_mul_ps(m20, z));
+    __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m01), _mm_mul_ps(y, m11)), _mm_mul_ps(m21, z));
+    __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m02), _mm_mul_ps(y, m12)), _mm_mul_ps(m22, z));
+    if (use_translation) {
+      rx = _mm_add_ps(rx, m30);
+      ry = _mm_add_ps(ry, m31);
+      rz = _mm_add_ps(rz, m32);
+    }
+
+    v3_array_store_sse2(&r_arr[i], rx, ry, rz, w);
+  }
+#endif
+
+  for (; i < nbr; i++) {
+    if (use_translation) {
+      mul_v3_m4v3(r_arr[i], mat, vec_arr[i]);
+    }
+    else {
+      mul_v3_mat3_m4v3(r_arr[i], mat, vec_arr[i]);
+    }
+  }
+}
+
+void mul_v3_m4v3_array(float (*r_arr)[3],
+                       const float mat[4][4],
+                       const float (*vec_arr)[3],
+                       const int nbr)
+{
+  BLI_assert((r_arr == vec_arr) || (r_arr + nbr <= vec_arr) || (vec_arr + nbr <= r_arr));
+  mul_v3_m4v3_array_ex(r_arr, mat, vec_arr, nbr, true);
+}
+
+void mul_m4_v3_array(const float mat[4][4], float (*vec_arr)[3], const int nbr)
+{
+  mul_v3_m4v3_array_ex(vec_arr, mat, (const float(*)[3])vec_arr, nbr, true);
+}
+
+void mul_mat3_m4_v3_array(const float mat[4][4], float (*vec_arr)[3], const int nbr)
+{
+  mul_v3_m4v3_array_ex(vec_arr, mat, (const float(*)[3])vec_arr, nbr, false);
+}
+
 void mul_v3_mat3_m4v3_db(double r[3], const double mat[4][4], const double vec[3])
 {
   const double x = vec[0];
@@ -0,0 +1,71 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ *
+ * Helpers for SSE2 versions of functions over arrays of 3D vectors (`float (*)[3]`).
+ *
+ * Four vectors are loaded at once and transposed, so the x, y and z components each end up in
+ * their own register, and the math can be written exactly like the scalar version of a single
+ * vector (giving the same results).
+ *
+ * Every vector is loaded and stored with 4 floats, so the first float of the next vector is
+ * accessed too: these must only be used while there is at least one more vector after the four
+ * being processed. The extra float is stored back unchanged (see #v3_array_store_sse2).
+ *
+ * NOTE: Are to be included ONLY from inside `#ifdef __SSE2__` !!!
+ */
+
+#ifndef __MATH_V3_ARRAY_SSE2_H__
+#define __MATH_V3_ARRAY_SSE2_H__
+
+#include <xmmintrin.h>
+
+/* Number of vectors processed at once. */
+#define V3_ARRAY_SSE2_STEP 4
+
+/**
+ * Load `arr[0..3]`, \a r_w receives the first float of each of the following vectors.
+ */
+BLI_INLINE void v3_array_load_sse2(
+    const float (*arr)[3], __m128 *r_x, __m128 *r_y, __m128 *r_z, __m128 *r_w)
+{
+  __m128 x = _mm_loadu_ps(arr[0]);
+  __m128 y = _mm_loadu_ps(arr[1]);
+  __m128 z = _mm_loadu_ps(arr[2]);
+  __m128 w = _mm_loadu_ps(arr[3]);
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+  *r_x = x;
+  *r_y = y;
+  *r_z = z;
+  *r_w = w;
+}
+
+/**
+ * Store `arr[0..3]`, \a w must be the value loaded by #v3_array_load_sse2
+ * (when storing into another array, the extra float is overwritten by the next store).
+ */
+BLI_INLINE void v3_array_store_sse2(float (*arr)[3], __m128 x, __m128 y, __m128 z, __m128 w)
+{
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+  _mm_storeu_ps(arr[0], x);
+  _mm_storeu_ps(arr[1], y);
+  _mm_storeu_ps(arr[2], z);
+  _mm_storeu_ps(arr[3], w);
+}
+
+#endif /* __MATH_V3_ARRAY_SSE2_H__ */
@@ -28,6 +28,10 @@
 
 #include "BLI_strict_flags.h"
 
+#ifdef __SSE2__
+#  include "math_v3_array_sse2.h"
+#endif
+
 //******************************* Interpolation *******************************/
 
 void interp_v2_v2v2(float target[2], const float a[2], const float b[2], const float t)
@@ -1059,6 +1063,71 @@ void axis_sort_v3(const float axis_values[3], int r_axis_order[3])
 #undef SWAP_AXIS
 }
 
+/**
+ * Normalize \a nbr vectors, same as calling #normalize_v3 for each of them (the result is the
+ * same), but processes multiple vectors at once when SIMD is available.
+ */
+void normalize_v3_array(float (*vec_arr)[3], const int nbr)
+{
+  int i = 0;
+
+#ifdef __SSE2__
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 eps = _mm_set1_ps(1.0e-35f);
+
+  for (; i + V3_ARRAY_SSE2_STEP < nbr; i += V3_ARRAY_SSE2_STEP) {
+    __m128 x, y, z, w;
+    v3_array_load_sse2((const float(*)[3])&vec_arr[i], &x, &y, &z, &w);
+
+    const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    /* Zero vectors which are too small to be normalized, like #normalize_v3. */
+    const __m128 mask = _mm_cmpgt_ps(d, eps);
+    const __m128 fac = _mm_and_ps(_mm_div_ps(one, _mm_sqrt_ps(d)), mask);
+
+    v3_array_store_sse2(
+        &vec_arr[i], _mm_mul_ps(x, fac), _mm_mul_ps(y, fac), _mm_mul_ps(z, fac), w);
+  }
+#endif
+
+  for (; i < nbr; i++) {
+    normalize_v3(vec_arr[i]);
+  }
+}
+
+/**
+ * Cross product of \a nbr pairs of vectors, same as calling #cross_v3_v3v3 for each of them,
+ * but processes multiple vectors at once when SIMD is available.
+ */
+void cross_v3_v3v3_array(float (*r_arr)[3],
+                         const float (*a_arr)[3],
+                         const float (*b_arr)[3],
+                         const int nbr)
+{
+  BLI_assert((r_arr + nbr <= a_arr) || (a_arr + nbr <= r_arr));
+  BLI_assert((r_arr + nbr <= b_arr) || (b_arr + nbr <= r_arr));
+  int i = 0;
+
+#ifdef __SSE2__
+  for (; i + V3_ARRAY_SSE2_STEP < nbr; i += V3_ARRAY_SSE2_STEP) {
+    __m128 ax, ay, az, aw;
+    __m128 bx, by, bz, bw;
+    v3_array_load_sse2(&a_arr[i], &ax, &ay, &az, &aw);
+    v3_array_load_sse2(&b_arr[i], &bx, &by, &bz, &bw);
+
+    const __m128 rx = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+    const __m128 ry = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+    const __m128 rz = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+
+    /* The extra float belongs to the next vector of the output, which is written afterwards. */
+    v3_array_store_sse2(&r_arr[i], rx, ry, rz, aw);
+  }
+#endif
+
+  for (; i < nbr; i++) {
+    cross_v3_v3v3(r_arr[i], a_arr[i], b_arr[i]);
+  }
+}
+
 /***************************** Array Functions *******************************/
 
 MINLINE double sqr_db(double f)
@@ -20,6 +20,7 @@
  * A generic task system which can be used for any task based subsystem.
  */
 
+#include <float.h>
 #include <stdlib.h>
 
 #include "MEM_guardedalloc.h"
@@ -28,10 +29,15 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_memarena.h"
+#include "BLI_memblock.h"
 #include "BLI_mempool.h"
+#include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
 
+#include "PIL_time.h"
+
 #include "atomic_ops.h"
 
 /* Define this to enable some detailed statistic print. */
@@ -58,6 +64,13 @@
  */
 #define DELAYED_QUEUE_SIZE 4096
 
+/* Number of scratch memory arenas each thread keeps around for re-use.
+ *
+ * More than one is needed when parallel ranges are nested, since the outer task keeps its arena
+ * while the thread runs tasks of the inner range.
+ */
+#define SCRATCH_ARENA_CACHE_SIZE 4
+
 #ifndef NDEBUG
 #  define ASSERT_THREAD_ID(scheduler, thread_id) \
     do { \
@@ -86,6 +99,8 @@ typedef struct Task {
   bool free_taskdata;
   TaskFreeFunction freedata;
   TaskPool *pool;
+  /* Time at which the task was pushed, only set when the pool is profiled. */
+  double push_time;
 } Task;
 
 /* This is a per-thread storage of pre-allocated tasks.
@@ -132,6 +147,24 @@ typedef struct TaskMemPoolStats {
 } TaskMemPoolStats;
 #endif
 
+/* Timing of a single task of a profiled pool, see #BLI_task_pool_profile_enable. */
+typedef struct TaskProfileEvent {
+  void *taskdata;
+  double push_time;
+  double start_time;
+  double end_time;
+} TaskProfileEvent;
+
+typedef struct TaskPoolProfile {
+  char name[64];
+  /* Time at which profiling was enabled, all exported times are relative to it. */
+  double begin_time;
+  /* #TaskProfileEvent of all tasks, per thread which did run them (indexed by thread ID).
+   * Only written by the corresponding thread, so no lock is needed when adding events. */
+  BLI_memblock **thread_events;
+  int num_threads;
+} TaskPoolProfile;
+
 typedef struct TaskThreadLocalStorage {
   /* Memory pool for faster task allocation.
    * The idea is to re-use memory of finished/discarded tasks by this thread.
@@ -155,6 +188,11 @@ typedef struct TaskThreadLocalStorage {
   bool do_delayed_push;
   int num_delayed_queue;
   Task *delayed_queue[DELAYED_QUEUE_SIZE];
+
+  /* Cleared scratch arenas of finished parallel range tasks, re-used by the next ones so that
+   * their memory is not allocated over and over again. */
+  int num_scratch_arenas;
+  MemArena *scratch_arenas[SCRATCH_ARENA_CACHE_SIZE];
 } TaskThreadLocalStorage;
 
 struct TaskPool {
@@ -199,6 +237,9 @@ struct TaskPool {
 #ifdef DEBUG_STATS
   TaskMemPoolStats *mempool_stats;
 #endif
+
+  /* Only allocated when profiling was enabled for this pool. */
+  TaskPoolProfile *profile;
 };
 
 struct TaskScheduler {
@@ -217,6 +258,15 @@ struct TaskScheduler {
 
   volatile bool do_exit;
 
+  /* Number of tasks in all queues (shared and per-thread ones), and number of worker threads
+   * which are sleeping waiting for new tasks. Used to avoid locking the queue mutex on push when
+   * there is nobody who needs to be woken up. */
+  volatile int num_queued_tasks;
+  volatile int num_sleeping_threads;
+  /* Incremented on every push, allows sleeping threads to detect tasks which were pushed after
+   * they did scan the queues but before they went to sleep. */
+  volatile unsigned int push_generation;
+
   /* NOTE: In pthread's TLS we store the whole TaskThread structure. */
   pthread_key_t tls_id_key;
 };
@@ -225,6 +275,14 @@ typedef struct TaskThread {
   TaskScheduler *scheduler;
   int id;
   TaskThreadLocalStorage tls;
+
+  /* Work-stealing queue of this thread.
+   *
+   * Tasks pushed from this thread are put here instead of the scheduler's shared queue. The
+   * owner thread takes tasks from the head of the queue (most recently pushed high priority
+   * tasks first), other threads which ran out of work steal from the tail. */
+  ListBase queue;
+  SpinLock queue_lock;
 } TaskThread;
 
 /* Helper */
@@ -240,6 +298,28 @@ BLI_INLINE void task_data_free(Task *task, const int thread_id)
   }
 }
 
+/* Run the task, recording its timing when the pool is profiled. */
+BLI_INLINE void task_run(Task *task, const int thread_id)
+{
+  TaskPool *pool = task->pool;
+  TaskPoolProfile *profile = pool->profile;
+
+  if (profile == NULL) {
+    task->run(pool, task->taskdata, thread_id);
+    return;
+  }
+
+  const double start_time = PIL_check_seconds_timer();
+  task->run(pool, task->taskdata, thread_id);
+  const double end_time = PIL_check_seconds_timer();
+
+  TaskProfileEvent *event = BLI_memblock_alloc(profile->thread_events[thread_id]);
+  event->taskdata = task->taskdata;
+  event->push_time = task->push_time;
+  event->start_time = start_time;
+  event->end_time = end_time;
+}
+
 BLI_INLINE void initialize_task_tls(TaskThreadLocalStorage *tls)
 {
   memset(tls, 0, sizeof(TaskThreadLocalStorage));
@@ -269,6 +349,9 @@ BLI_INLINE void free_task_tls(TaskThreadLocalStorage *tls)
   for (int i = 0; i < task_mempool->num_tasks; i++) {
     MEM_freeN(task_mempool->tasks[i]);
   }
+  for (int i = 0; i < tls->num_scratch_arenas; i++) {
+    BLI_memarena_free(tls->scratch_arenas[i]);
+  }
 }
 
 static Task *task_alloc(TaskPool *pool, const int thread_id)
@@ -353,55 +436,141 @@ static void task_pool_num_increase(TaskPool *pool, size_t new)
   BLI_mutex_unlock(&pool->num_mutex);
 }
 
-static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler, Task **task)
+/* Queues */
+
+/* Find and remove a task from the given queue, the queue must be locked by the caller.
+ *
+ * When \a pool is not NULL only tasks from that pool are considered, when \a background_only is
+ * true only tasks from background pools are considered. */
+static Task *task_queue_pop(ListBase *queue,
+                            const TaskPool *pool,
+                            const bool background_only,
+                            const bool from_tail)
 {
-  bool found_task = false;
-  BLI_mutex_lock(&scheduler->queue_mutex);
+  for (Task *task = from_tail ? queue->last : queue->first; task != NULL;
+       task = from_tail ? task->prev : task->next) {
+    if (pool != NULL && task->pool != pool) {
+      continue;
+    }
+    if (background_only && !task->pool->run_in_background) {
+      continue;
+    }
+    BLI_remlink(queue, task);
+    return task;
+  }
+  return NULL;
+}
+
+static Task *task_thread_queue_pop(TaskThread *thread,
+                                   const TaskPool *pool,
+                                   const bool background_only,
+                                   const bool from_tail)
+{
+  /* Cheap early output without taking the lock, it is fine to miss a task which is being pushed
+   * at this exact moment: the pusher will wake us up. */
+  if (thread->queue.first == NULL) {
+    return NULL;
+  }
+  BLI_spin_lock(&thread->queue_lock);
+  Task *task = task_queue_pop(&thread->queue, pool, background_only, from_tail);
+  BLI_spin_unlock(&thread->queue_lock);
+  return task;
+}
 
-  while (!scheduler->queue.first && !scheduler->do_exit) {
-    BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+/* Find a task to be executed by the thread with the given ID.
+ *
+ * The order is: own queue of the thread, shared queue of the scheduler, tail of the queues of
+ * other threads. When \a pool is given, only tasks of that pool are returned. */
+static Task *task_scheduler_find_task(TaskScheduler *scheduler, const int thread_id, TaskPool *pool)
+{
+  if (atomic_add_and_fetch_int32((int32_t *)&scheduler->num_queued_tasks, 0) == 0) {
+    return NULL;
   }
 
-  do {
-    Task *current_task;
+  const bool background_only = (pool == NULL && scheduler->background_thread_only);
+  Task *task = NULL;
 
-    /* Assuming we can only have a void queue in 'exit' case here seems logical
-     * (we should only be here after our worker thread has been woken up from a
-     * condition_wait(), which only happens after a new task was added to the queue),
-     * but it is wrong.
-     * Waiting on condition may wake up the thread even if condition is not signaled
-     * (spurious wake-ups), and some race condition may also empty the queue **after**
-     * condition has been signaled, but **before** awoken thread reaches this point...
-     * See http://stackoverflow.com/questions/8594591
-     *
-     * So we only abort here if do_exit is set.
-     */
-    if (scheduler->do_exit) {
-      BLI_mutex_unlock(&scheduler->queue_mutex);
-      return false;
-    }
+  if (thread_id > 0) {
+    task = task_thread_queue_pop(&scheduler->task_threads[thread_id], pool, background_only, false);
+  }
 
-    for (current_task = scheduler->queue.first; current_task != NULL;
-         current_task = current_task->next) {
-      TaskPool *pool = current_task->pool;
+  if (task == NULL && scheduler->queue.first != NULL) {
+    BLI_mutex_lock(&scheduler->queue_mutex);
+    task = task_queue_pop(&scheduler->queue, pool, background_only, false);
+    BLI_mutex_unlock(&scheduler->queue_mutex);
+  }
 
-      if (scheduler->background_thread_only && !pool->run_in_background) {
+  if (task == NULL) {
+    /* Start stealing from the thread next to us, so that idle threads do not all hammer the same
+     * victim. */
+    const int num_threads = scheduler->num_threads;
+    for (int i = 0; i < num_threads && task == NULL; i++) {
+      const int victim_id = 1 + (max_ii(thread_id, 1) + i) % num_threads;
+      if (victim_id == thread_id) {
         continue;
       }
+      task = task_thread_queue_pop(&scheduler->task_threads[victim_id], pool, background_only, true);
+    }
+  }
 
-      *task = current_task;
-      found_task = true;
-      BLI_remlink(&scheduler->queue, *task);
-      break;
+  if (task != NULL) {
+    atomic_sub_and_fetch_int32((int32_t *)&scheduler->num_queued_tasks, 1);
+  }
+  return task;
+}
+
+/* Account for tasks which were just added to one of the queues, and wake up sleeping worker
+ * threads if there are any. */
+static void task_scheduler_notify_pushed(TaskScheduler *scheduler, const int num_tasks)
+{
+  atomic_add_and_fetch_int32((int32_t *)&scheduler->num_queued_tasks, num_tasks);
+  atomic_add_and_fetch_u((unsigned int *)&scheduler->push_generation, 1);
+
+  /* NOTE: Sleeping thread increments this counter before checking the push generation, so either
+   * it sees the new generation, or we see it sleeping here. */
+  if (atomic_add_and_fetch_int32((int32_t *)&scheduler->num_sleeping_threads, 0) == 0) {
+    return;
+  }
+
+  BLI_mutex_lock(&scheduler->queue_mutex);
+  if (num_tasks == 1) {
+    BLI_condition_notify_one(&scheduler->queue_cond);
+  }
+  else {
+    BLI_condition_notify_all(&scheduler->queue_cond);
+  }
+  BLI_mutex_unlock(&scheduler->queue_mutex);
+}
+
+static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler,
+                                           TaskThread *thread,
+                                           Task **task)
+{
+  while (!scheduler->do_exit) {
+    const unsigned int generation = atomic_add_and_fetch_u(
+        (unsigned int *)&scheduler->push_generation, 0);
+
+    *task = task_scheduler_find_task(scheduler, thread->id, NULL);
+    if (*task != NULL) {
+      return true;
     }
-    if (!found_task) {
+
+    /* Nothing to do, sleep until new tasks are pushed.
+     *
+     * Waiting on condition may wake up the thread even if condition is not signaled (spurious
+     * wake-ups), so we loop until push generation actually changes. */
+    BLI_mutex_lock(&scheduler->queue_mutex);
+    atomic_add_and_fetch_int32((int32_t *)&scheduler->num_sleeping_threads, 1);
+    while (!scheduler->do_exit &&
+           generation ==
+               atomic_add_and_fetch_u((unsigned int *)&scheduler->push_generation, 0)) {
       BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
     }
-  } while (!found_task);
-
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+    atomic_sub_and_fetch_int32((int32_t *)&scheduler->num_sleeping_threads, 1);
+    BLI_mutex_unlock(&scheduler->queue_mutex);
+  }
 
-  return true;
+  return false;
 }
 
 BLI_INLINE void handle_local_queue(TaskThreadLocalStorage *tls, const int thread_id)
@@ -417,7 +586,7 @@ BLI_INLINE void handle_local_queue(TaskThreadLocalStorage *tls, const int thread
      * pool tasks.
      */
     TaskPool *local_pool = local_task->pool;
-    local_task->run(local_pool, local_task->taskdata, thread_id);
+    task_run(local_task, thread_id);
     task_free(local_pool, local_task, thread_id);
   }
   BLI_assert(!tls->do_delayed_push);
@@ -442,12 +611,12 @@ static void *task_scheduler_thread_run(void *thread_p)
   BLI_mutex_unlock(&scheduler->startup_mutex);
 
   /* keep popping off tasks */
-  while (task_scheduler_thread_wait_pop(scheduler, &task)) {
+  while (task_scheduler_thread_wait_pop(scheduler, thread, &task)) {
     TaskPool *pool = task->pool;
 
     /* run task */
     BLI_assert(!tls->do_delayed_push);
-    task->run(pool, task->taskdata, thread_id);
+    task_run(task, thread_id);
     BLI_assert(!tls->do_delayed_push);
 
     /* delete task */
@@ -498,6 +667,8 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
 
   /* Initialize TLS for main thread. */
   initialize_task_tls(&scheduler->task_threads[0].tls);
+  BLI_listbase_clear(&scheduler->task_threads[0].queue);
+  BLI_spin_init(&scheduler->task_threads[0].queue_lock);
 
   pthread_key_create(&scheduler->tls_id_key, NULL);
 
@@ -513,6 +684,8 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
       thread->scheduler = scheduler;
       thread->id = i + 1;
       initialize_task_tls(&thread->tls);
+      BLI_listbase_clear(&thread->queue);
+      BLI_spin_init(&thread->queue_lock);
 
       if (pthread_create(&scheduler->threads[i], NULL, task_scheduler_thread_run, thread) != 0) {
         fprintf(stderr, "TaskScheduler failed to launch thread %d/%d\n", i, num_threads);
@@ -562,8 +735,15 @@ void BLI_task_scheduler_free(TaskScheduler *scheduler)
   /* Delete task thread data */
   if (scheduler->task_threads) {
     for (int i = 0; i < scheduler->num_threads + 1; i++) {
-      TaskThreadLocalStorage *tls = &scheduler->task_threads[i].tls;
-      free_task_tls(tls);
+      TaskThread *thread = &scheduler->task_threads[i];
+      free_task_tls(&thread->tls);
+
+      /* delete leftover tasks of this thread */
+      for (task = thread->queue.first; task; task = task->next) {
+        task_data_free(task, 0);
+      }
+      BLI_freelistN(&thread->queue);
+      BLI_spin_end(&thread->queue_lock);
     }
 
     MEM_freeN(scheduler->task_threads);
@@ -589,28 +769,45 @@ int BLI_task_scheduler_num_threads(TaskScheduler *scheduler)
   return scheduler->num_threads + 1;
 }
 
-static void task_scheduler_push(TaskScheduler *scheduler, Task *task, TaskPriority priority)
+static void task_scheduler_push(TaskScheduler *scheduler,
+                                Task *task,
+                                TaskPriority priority,
+                                const int thread_id)
 {
   task_pool_num_increase(task->pool, 1);
 
-  /* add task to queue */
-  BLI_mutex_lock(&scheduler->queue_mutex);
-
-  if (priority == TASK_PRIORITY_HIGH) {
-    BLI_addhead(&scheduler->queue, task);
+  if (thread_id > 0) {
+    /* Pushing from a worker thread, add task to its own queue. */
+    TaskThread *thread = &scheduler->task_threads[thread_id];
+    BLI_spin_lock(&thread->queue_lock);
+    if (priority == TASK_PRIORITY_HIGH) {
+      BLI_addhead(&thread->queue, task);
+    }
+    else {
+      BLI_addtail(&thread->queue, task);
+    }
+    BLI_spin_unlock(&thread->queue_lock);
   }
   else {
-    BLI_addtail(&scheduler->queue, task);
+    /* add task to shared queue */
+    BLI_mutex_lock(&scheduler->queue_mutex);
+    if (priority == TASK_PRIORITY_HIGH) {
+      BLI_addhead(&scheduler->queue, task);
+    }
+    else {
+      BLI_addtail(&scheduler->queue, task);
+    }
+    BLI_mutex_unlock(&scheduler->queue_mutex);
   }
 
-  BLI_condition_notify_one(&scheduler->queue_cond);
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+  task_scheduler_notify_pushed(scheduler, 1);
 }
 
 static void task_scheduler_push_all(TaskScheduler *scheduler,
                                     TaskPool *pool,
                                     Task **tasks,
-                                    int num_tasks)
+                                    int num_tasks,
+                                    const int thread_id)
 {
   if (num_tasks == 0) {
     return;
@@ -618,37 +815,63 @@ static void task_scheduler_push_all(TaskScheduler *scheduler,
 
   task_pool_num_increase(pool, num_tasks);
 
-  BLI_mutex_lock(&scheduler->queue_mutex);
-
-  for (int i = 0; i < num_tasks; i++) {
-    BLI_addhead(&scheduler->queue, tasks[i]);
+  if (thread_id > 0) {
+    TaskThread *thread = &scheduler->task_threads[thread_id];
+    BLI_spin_lock(&thread->queue_lock);
+    for (int i = 0; i < num_tasks; i++) {
+      BLI_addhead(&thread->queue, tasks[i]);
+    }
+    BLI_spin_unlock(&thread->queue_lock);
+  }
+  else {
+    BLI_mutex_lock(&scheduler->queue_mutex);
+    for (int i = 0; i < num_tasks; i++) {
+      BLI_addhead(&scheduler->queue, tasks[i]);
+    }
+    BLI_mutex_unlock(&scheduler->queue_mutex);
   }
 
-  BLI_condition_notify_all(&scheduler->queue_cond);
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+  task_scheduler_notify_pushed(scheduler, num_tasks);
 }
 
-static void task_scheduler_clear(TaskScheduler *scheduler, TaskPool *pool)
+/* Free all tasks from the given pool from the queue, return number of freed tasks. */
+static size_t task_queue_clear(ListBase *queue, TaskPool *pool)
 {
   Task *task, *nexttask;
   size_t done = 0;
 
-  BLI_mutex_lock(&scheduler->queue_mutex);
-
-  /* free all tasks from this pool from the queue */
-  for (task = scheduler->queue.first; task; task = nexttask) {
+  for (task = queue->first; task; task = nexttask) {
     nexttask = task->next;
 
     if (task->pool == pool) {
       task_data_free(task, pool->thread_id);
-      BLI_freelinkN(&scheduler->queue, task);
+      BLI_freelinkN(queue, task);
 
       done++;
     }
   }
 
+  return done;
+}
+
+static void task_scheduler_clear(TaskScheduler *scheduler, TaskPool *pool)
+{
+  size_t done = 0;
+
+  /* free all tasks from this pool from the queues */
+  BLI_mutex_lock(&scheduler->queue_mutex);
+  done += task_queue_clear(&scheduler->queue, pool);
   BLI_mutex_unlock(&scheduler->queue_mutex);
 
+  for (int i = 1; i <= scheduler->num_threads; i++) {
+    TaskThread *thread = &scheduler->task_threads[i];
+    BLI_spin_lock(&thread->queue_lock);
+    done += task_queue_clear(&thread->queue, pool);
+    BLI_spin_unlock(&thread->queue_lock);
+  }
+
+  atomic_sub_and_fetch_int32((int32_t *)&scheduler->num_queued_tasks, (int32_t)done);
+
   /* notify done */
   task_pool_num_decrease(pool, done);
 }
@@ -685,6 +908,7 @@ static TaskPool *task_pool_create_ex(TaskScheduler *scheduler,
   pool->suspended_queue.first = pool->suspended_queue.last = NULL;
   pool->run_in_background = is_background;
   pool->use_local_tls = false;
+  pool->profile = NULL;
 
   BLI_mutex_init(&pool->num_mutex);
   BLI_condition_init(&pool->num_cond);
@@ -766,6 +990,15 @@ TaskPool *BLI_task_pool_create_suspended(TaskScheduler *scheduler, void *userdat
   return task_pool_create_ex(scheduler, userdata, false, true);
 }
 
+static void task_pool_profile_free(TaskPoolProfile *profile)
+{
+  for (int i = 0; i < profile->num_threads; i++) {
+    BLI_memblock_destroy(profile->thread_events[i], NULL);
+  }
+  MEM_freeN(profile->thread_events);
+  MEM_freeN(profile);
+}
+
 void BLI_task_pool_free(TaskPool *pool)
 {
   BLI_task_pool_cancel(pool);
@@ -791,6 +1024,10 @@ void BLI_task_pool_free(TaskPool *pool)
     free_task_tls(&pool->local_tls);
   }
 
+  if (pool->profile) {
+    task_pool_profile_free(pool->profile);
+  }
+
   MEM_freeN(pool);
 
   BLI_threaded_malloc_end();
@@ -816,6 +1053,9 @@ static void task_pool_push(TaskPool *pool,
   task->free_taskdata = free_taskdata;
   task->freedata = freedata;
   task->pool = pool;
+  if (pool->profile) {
+    task->push_time = PIL_check_seconds_timer();
+  }
   /* For suspended pools we put everything yo a global queue first
    * and exit as soon as possible.
    *
@@ -849,10 +1089,11 @@ static void task_pool_push(TaskPool *pool,
       return;
     }
   }
-  /* Do push to a global execution pool, slowest possible method,
-   * causes quite reasonable amount of threading overhead.
+  /* Do push to the scheduler's queues, to the own queue of the thread when pushing from a worker
+   * thread, and to the shared queue otherwise (slowest possible method, causes quite reasonable
+   * amount of threading overhead).
    */
-  task_scheduler_push(pool->scheduler, task, priority);
+  task_scheduler_push(pool->scheduler, task, priority, thread_id);
 }
 
 void BLI_task_pool_push_ex(TaskPool *pool,
@@ -889,12 +1130,26 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
   if (atomic_fetch_and_and_uint8((uint8_t *)&pool->is_suspended, 0)) {
     if (pool->num_suspended) {
       task_pool_num_increase(pool, pool->num_suspended);
-      BLI_mutex_lock(&scheduler->queue_mutex);
 
-      BLI_movelisttolist(&scheduler->queue, &pool->suspended_queue);
+      if (pool->thread_id > 0) {
+        /* Pool is used from within a task running on a worker thread (nested parallelism, for
+         * example #BLI_task_parallel_range() called from a depsgraph task). Put the tasks at the
+         * head of the thread's own queue: this thread will process them first while waiting,
+         * and other threads will only steal them once they run out of their own work, so the
+         * nested loop scales when there are idle threads without fighting over the shared
+         * queue with all the other pools. */
+        TaskThread *thread = &scheduler->task_threads[pool->thread_id];
+        BLI_spin_lock(&thread->queue_lock);
+        BLI_movelisttolist_reverse(&thread->queue, &pool->suspended_queue);
+        BLI_spin_unlock(&thread->queue_lock);
+      }
+      else {
+        BLI_mutex_lock(&scheduler->queue_mutex);
+        BLI_movelisttolist(&scheduler->queue, &pool->suspended_queue);
+        BLI_mutex_unlock(&scheduler->queue_mutex);
+      }
 
-      BLI_condition_notify_all(&scheduler->queue_cond);
-      BLI_mutex_unlock(&scheduler->queue_mutex);
+      task_scheduler_notify_pushed(scheduler, (int)pool->num_suspended);
 
       pool->num_suspended = 0;
     }
@@ -909,36 +1164,22 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
   BLI_mutex_lock(&pool->num_mutex);
 
   while (pool->num != 0) {
-    Task *task, *work_task = NULL;
-    bool found_task = false;
-
     BLI_mutex_unlock(&pool->num_mutex);
 
-    BLI_mutex_lock(&scheduler->queue_mutex);
-
     /* find task from this pool. if we get a task from another pool,
      * we can get into deadlock */
-
-    for (task = scheduler->queue.first; task; task = task->next) {
-      if (task->pool == pool) {
-        work_task = task;
-        found_task = true;
-        BLI_remlink(&scheduler->queue, task);
-        break;
-      }
-    }
-
-    BLI_mutex_unlock(&scheduler->queue_mutex);
+    Task *work_task = task_scheduler_find_task(scheduler, pool->thread_id, pool);
+    const bool found_task = (work_task != NULL);
 
     /* if found task, do it, otherwise wait until other tasks are done */
     if (found_task) {
       /* run task */
       BLI_assert(!tls->do_delayed_push);
-      work_task->run(pool, work_task->taskdata, pool->thread_id);
+      task_run(work_task, pool->thread_id);
       BLI_assert(!tls->do_delayed_push);
 
       /* delete task */
-      task_free(pool, task, pool->thread_id);
+      task_free(pool, work_task, pool->thread_id);
 
       /* Handle all tasks from local queue. */
       handle_local_queue(tls, pool->thread_id);
@@ -1016,12 +1257,228 @@ void BLI_task_pool_delayed_push_end(TaskPool *pool, int thread_id)
     ASSERT_THREAD_ID(pool->scheduler, thread_id);
     TaskThreadLocalStorage *tls = get_task_tls(pool, thread_id);
     BLI_assert(tls->do_delayed_push);
-    task_scheduler_push_all(pool->scheduler, pool, tls->delayed_queue, tls->num_delayed_queue);
+    task_scheduler_push_all(
+        pool->scheduler, pool, tls->delayed_queue, tls->num_delayed_queue, thread_id);
     tls->do_delayed_push = false;
     tls->num_delayed_queue = 0;
   }
 }
 
+/* Profiling */
+
+/**
+ * Start recording when each task of the pool is pushed, started and finished, and which thread
+ * runs it. Must be called before any task is pushed to the pool.
+ *
+ * Recording is done per thread without locks, the overhead is two timer queries per task.
+ * The \a name is used to identify the pool in the exported trace.
+ */
+void BLI_task_pool_profile_enable(TaskPool *pool, const char *name)
+{
+  BLI_assert(pool->profile == NULL);
+  BLI_assert(pool->num == 0 && pool->num_suspended == 0);
+
+  TaskPoolProfile *profile = MEM_callocN(sizeof(*profile), __func__);
+  BLI_strncpy(profile->name, name, sizeof(profile->name));
+  profile->begin_time = PIL_check_seconds_timer();
+  profile->num_threads = pool->scheduler->num_threads + 1;
+  profile->thread_events = MEM_mallocN(sizeof(*profile->thread_events) * profile->num_threads,
+                                       __func__);
+  for (int i = 0; i < profile->num_threads; i++) {
+    profile->thread_events[i] = BLI_memblock_create(sizeof(TaskProfileEvent));
+  }
+  pool->profile = profile;
+}
+
+/**
+ * Print the number of tasks, time spent in them and time they waited in the queues,
+ * per thread and in total.
+ *
+ * Only call when no tasks of the pool are running, e.g. after #BLI_task_pool_work_and_wait.
+ */
+void BLI_task_pool_profile_print(TaskPool *pool)
+{
+  TaskPoolProfile *profile = pool->profile;
+  BLI_assert(profile != NULL);
+
+  int total_tasks = 0;
+  double total_busy = 0.0, total_wait = 0.0, max_wait = 0.0;
+  double first_push = DBL_MAX, last_end = 0.0;
+
+  printf("Task pool \"%s\"\n", profile->name);
+  printf("Thread ID    Tasks      Busy (ms)    Wait avg (ms)\n");
+  for (int i = 0; i < profile->num_threads; i++) {
+    int num_tasks = 0;
+    double busy = 0.0, wait = 0.0;
+
+    BLI_memblock_iter iter;
+    BLI_memblock_iternew(profile->thread_events[i], &iter);
+    TaskProfileEvent *event;
+    while ((event = BLI_memblock_iterstep(&iter))) {
+      num_tasks++;
+      busy += event->end_time - event->start_time;
+      wait += event->start_time - event->push_time;
+      max_wait = max_dd(max_wait, event->start_time - event->push_time);
+      first_push = min_dd(first_push, event->push_time);
+      last_end = max_dd(last_end, event->end_time);
+    }
+
+    printf("%02d           %-10d %-12.3f %.3f\n",
+           i,
+           num_tasks,
+           busy * 1e3,
+           (num_tasks != 0) ? wait / num_tasks * 1e3 : 0.0);
+    total_tasks += num_tasks;
+    total_busy += busy;
+    total_wait += wait;
+  }
+
+  if (total_tasks == 0) {
+    printf("No tasks were run\n");
+    return;
+  }
+  printf("Total: %d tasks, wall time %.3f ms, busy %.3f ms, wait avg %.3f ms, max %.3f ms\n",
+         total_tasks,
+         (last_end - first_push) * 1e3,
+         total_busy * 1e3,
+         total_wait / total_tasks * 1e3,
+         max_wait * 1e3);
+}
+
+/**
+ * Write the recorded tasks as a Chrome trace (JSON Trace Event Format), which can be opened by
+ * `chrome://tracing` or Perfetto. Each task is a slice on the timeline of the thread which ran
+ * it, with the time it waited in the queue as argument.
+ *
+ * Only call when no tasks of the pool are running, e.g. after #BLI_task_pool_work_and_wait.
+ *
+ * \return false when the file could not be written.
+ */
+bool BLI_task_pool_profile_write_chrome_trace(TaskPool *pool, const char *filepath)
+{
+  TaskPoolProfile *profile = pool->profile;
+  BLI_assert(profile != NULL);
+
+  FILE *file = fopen(filepath, "w");
+  if (file == NULL) {
+    return false;
+  }
+
+  fprintf(file, "{\"traceEvents\":[\n");
+  for (int i = 0; i < profile->num_threads; i++) {
+    fprintf(file,
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,"
+            "\"args\":{\"name\":\"%s %d\"}},\n",
+            i,
+            (i == 0) ? "Pool thread" : "Worker",
+            i);
+  }
+  for (int i = 0; i < profile->num_threads; i++) {
+    BLI_memblock_iter iter;
+    BLI_memblock_iternew(profile->thread_events[i], &iter);
+    TaskProfileEvent *event;
+    while ((event = BLI_memblock_iterstep(&iter))) {
+      fprintf(file,
+              "{\"name\":\"%s\",\"cat\":\"task\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,"
+              "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"wait_us\":%.3f}},\n",
+              profile->name,
+              i,
+              (event->start_time - profile->begin_time) * 1e6,
+              (event->end_time - event->start_time) * 1e6,
+              (event->start_time - event->push_time) * 1e6);
+    }
+  }
+  /* Metadata event, avoids having to special case the separator of the last task. */
+  fprintf(file,
+          "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+          "\"args\":{\"name\":\"%s\"}}\n",
+          profile->name);
+  fprintf(file, "]}\n");
+
+  const bool ok = (ferror(file) == 0);
+  fclose(file);
+  return ok;
+}
+
+/**
+ * Call \a func for every recorded task, with the task data it was pushed with and the thread
+ * which did run it. Times are the ones of #PIL_check_seconds_timer. Allows callers to export
+ * the tasks in their own way, knowing what the task data is.
+ *
+ * Only call when no tasks of the pool are running, e.g. after #BLI_task_pool_work_and_wait.
+ * The task data may be freed already when the task owned it.
+ */
+void BLI_task_pool_profile_foreach_event(TaskPool *pool,
+                                         TaskProfileEventFunction func,
+                                         void *userdata)
+{
+  TaskPoolProfile *profile = pool->profile;
+  BLI_assert(profile != NULL);
+
+  for (int i = 0; i < profile->num_threads; i++) {
+    BLI_memblock_iter iter;
+    BLI_memblock_iternew(profile->thread_events[i], &iter);
+    TaskProfileEvent *event;
+    while ((event = BLI_memblock_iterstep(&iter))) {
+      func(userdata, event->taskdata, i, event->push_time, event->start_time, event->end_time);
+    }
+  }
+}
+
+/* Scratch memory of parallel tasks */
+
+/* Scratch memory of a running parallel range or iterator task, the arena is only acquired when
+ * the task callback actually asks for it. */
+typedef struct TaskParallelScratch {
+  /* Storage of the thread the task runs on, cleared arenas are kept there for the next tasks.
+   * NULL when not running on a task scheduler thread, the arena is freed at the end then. */
+  TaskThreadLocalStorage *task_tls;
+  MemArena *arena;
+} TaskParallelScratch;
+
+/**
+ * Get memory arena for short-lived allocations of a task callback of the parallel range and
+ * iterator routines, avoiding the guarded allocator in hot loops.
+ *
+ * The arena is private to the task, so no locking is needed. It is cleared once the task is done
+ * processing its iterations, so memory allocated from it must not be accessed after that,
+ * in particular not from the finalize callback.
+ */
+MemArena *BLI_task_parallel_tls_arena(const TaskParallelTLS *__restrict tls)
+{
+  TaskParallelScratch *scratch = tls->scratch;
+  BLI_assert(scratch != NULL);
+  if (scratch->arena == NULL) {
+    TaskThreadLocalStorage *task_tls = scratch->task_tls;
+    if (task_tls != NULL && task_tls->num_scratch_arenas > 0) {
+      task_tls->num_scratch_arenas--;
+      scratch->arena = task_tls->scratch_arenas[task_tls->num_scratch_arenas];
+    }
+    else {
+      scratch->arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "task scratch arena");
+    }
+  }
+  return scratch->arena;
+}
+
+static void task_parallel_scratch_end(TaskParallelScratch *scratch)
+{
+  MemArena *arena = scratch->arena;
+  if (arena == NULL) {
+    return;
+  }
+  TaskThreadLocalStorage *task_tls = scratch->task_tls;
+  if (task_tls != NULL && task_tls->num_scratch_arenas < SCRATCH_ARENA_CACHE_SIZE) {
+    BLI_memarena_clear(arena);
+    task_tls->scratch_arenas[task_tls->num_scratch_arenas] = arena;
+    task_tls->num_scratch_arenas++;
+  }
+  else {
+    BLI_memarena_free(arena);
+  }
+  scratch->arena = NULL;
+}
+
 /* Parallel range routines */
 
 /**
@@ -1218,9 +1675,14 @@ BLI_INLINE bool parallel_range_next_iter_get(TaskParallelRangePool *__restrict r
 static void parallel_range_func(TaskPool *__restrict pool, void *tls_data_idx, int thread_id)
 {
   TaskParallelRangePool *__restrict range_pool = BLI_task_pool_userdata(pool);
+  TaskParallelScratch scratch = {
+      .task_tls = get_task_tls(pool, thread_id),
+      .arena = NULL,
+  };
   TaskParallelTLS tls = {
       .thread_id = thread_id,
       .userdata_chunk = NULL,
+      .scratch = &scratch,
   };
   TaskParallelRangeState *state;
   int iter, count;
@@ -1231,6 +1693,7 @@ static void parallel_range_func(TaskPool *__restrict pool, void *tls_data_idx, i
       state->func(state->userdata_shared, iter + i, &tls);
     }
   }
+  task_parallel_scratch_end(&scratch);
 }
 
 static void parallel_range_single_thread(TaskParallelRangePool *range_pool)
@@ -1250,13 +1713,19 @@ static void parallel_range_single_thread(TaskParallelRangePool *range_pool)
       flatten_tls_storage = MALLOCA(tls_data_size);
       memcpy(flatten_tls_storage, initial_tls_memory, tls_data_size);
     }
+    TaskParallelScratch scratch = {
+        .task_tls = NULL,
+        .arena = NULL,
+    };
     TaskParallelTLS tls = {
         .thread_id = 0,
         .userdata_chunk = flatten_tls_storage,
+        .scratch = &scratch,
     };
     for (int i = start; i < stop; i++) {
       func(userdata, i, &tls);
     }
+    task_parallel_scratch_end(&scratch);
     if (state->func_finalize != NULL) {
       state->func_finalize(userdata, flatten_tls_storage);
     }
@@ -1595,11 +2064,17 @@ BLI_INLINE void task_parallel_iterator_calc_chunk_size(const TaskParallelSetting
 
 static void parallel_iterator_func_do(TaskParallelIteratorState *__restrict state,
                                       void *userdata_chunk,
+                                      TaskThreadLocalStorage *task_tls,
                                       int threadid)
 {
+  TaskParallelScratch scratch = {
+      .task_tls = task_tls,
+      .arena = NULL,
+  };
   TaskParallelTLS tls = {
       .thread_id = threadid,
       .userdata_chunk = userdata_chunk,
+      .scratch = &scratch,
   };
 
   void **current_chunk_items;
@@ -1647,6 +2122,8 @@ static void parallel_iterator_func_do(TaskParallelIteratorState *__restrict stat
     }
   }
 
+  task_parallel_scratch_end(&scratch);
+
   MALLOCA_FREE(current_chunk_items, items_size);
   MALLOCA_FREE(current_chunk_indices, indices_size);
 }
@@ -1655,7 +2132,7 @@ static void parallel_iterator_func(TaskPool *__restrict pool, void *userdata_chu
 {
   TaskParallelIteratorState *__restrict state = BLI_task_pool_userdata(pool);
 
-  parallel_iterator_func_do(state, userdata_chunk, threadid);
+  parallel_iterator_func_do(state, userdata_chunk, get_task_tls(pool, threadid), threadid);
 }
 
 static void task_parallel_iterator_no_threads(const TaskParallelSettings *settings,
@@ -1674,7 +2151,7 @@ static void task_parallel_iterator_no_threads(const TaskParallelSettings *settin
   /* Also marking it as non-threaded for the iterator callback. */
   state->iter_shared.spin_lock = NULL;
 
-  parallel_iterator_func_do(state, userdata_chunk, 0);
+  parallel_iterator_func_do(state, userdata_chunk, NULL, 0);
 
   if (use_userdata_chunk) {
     if (settings->func_finalize != NULL) {
@@ -1846,85 +2323,205 @@ void BLI_task_parallel_listbase(ListBase *listbase,
 
 typedef struct ParallelMempoolState {
   void *userdata;
+  /* Only one of these is set. */
   TaskParallelMempoolFunc func;
+  TaskParallelMempoolIndexFunc func_index;
 } ParallelMempoolState;
 
+/* A contiguous range of chunks, iterated over by a single task. */
+typedef struct ParallelMempoolTaskData {
+  BLI_mempool_iter iter;
+  /* Iteration index of the first used item of the range. */
+  int index_start;
+} ParallelMempoolTaskData;
+
+typedef struct ParallelMempoolCountData {
+  const BLI_mempool *mempool;
+  struct BLI_mempool_chunk **chunks;
+  int *chunks_used_len;
+} ParallelMempoolCountData;
+
+static void parallel_mempool_count_func(void *__restrict userdata,
+                                        const int chunk_index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ParallelMempoolCountData *data = userdata;
+  data->chunks_used_len[chunk_index] = (int)BLI_mempool_chunk_used_len(data->mempool,
+                                                                       data->chunks[chunk_index]);
+}
+
 static void parallel_mempool_func(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
 {
   ParallelMempoolState *__restrict state = BLI_task_pool_userdata(pool);
-  BLI_mempool_iter *iter = taskdata;
+  ParallelMempoolTaskData *task_data = taskdata;
+  BLI_mempool_iter *iter = &task_data->iter;
   MempoolIterData *item;
 
-  while ((item = BLI_mempool_iterstep(iter)) != NULL) {
-    state->func(state->userdata, item);
+  if (state->func_index) {
+    int index = task_data->index_start;
+    while ((item = BLI_mempool_iterstep(iter)) != NULL) {
+      state->func_index(state->userdata, item, index++);
+    }
+  }
+  else {
+    while ((item = BLI_mempool_iterstep(iter)) != NULL) {
+      state->func(state->userdata, item);
+    }
   }
 }
 
-/**
- * This function allows to parallelize for loops over Mempool items.
- *
- * \param mempool: The iterable BLI_mempool to loop over.
- * \param userdata: Common userdata passed to all instances of \a func.
- * \param func: Callback function.
- * \param use_threading: If \a true, actually split-execute loop in threads,
- * else just do a sequential for loop
- * (allows caller to use any kind of test to switch on parallelization or not).
- *
- * \note There is no static scheduling here.
- */
-void BLI_task_parallel_mempool(BLI_mempool *mempool,
-                               void *userdata,
-                               TaskParallelMempoolFunc func,
-                               const bool use_threading)
+/* Index of the item at which range `range_num` should end, when splitting `items_len` items into
+ * `ranges_len` ranges. */
+BLI_INLINE int parallel_mempool_range_end(const int range_num,
+                                          const int ranges_len,
+                                          const int items_len)
 {
-  TaskScheduler *task_scheduler;
-  TaskPool *task_pool;
-  ParallelMempoolState state;
-  int i, num_threads, num_tasks;
+  return (int)(((int64_t)range_num * items_len) / ranges_len);
+}
 
-  if (BLI_mempool_len(mempool) == 0) {
+static void task_parallel_mempool_do(BLI_mempool *mempool,
+                                     ParallelMempoolState *state,
+                                     const bool use_threading)
+{
+  const int items_len = BLI_mempool_len(mempool);
+  if (items_len == 0) {
     return;
   }
 
-  if (!use_threading) {
+  uint chunks_len;
+  struct BLI_mempool_chunk **chunks = NULL;
+  if (use_threading) {
+    chunks = BLI_mempool_chunks_as_tableN(mempool, &chunks_len, __func__);
+  }
+
+  if (!use_threading || chunks_len == 1) {
     BLI_mempool_iter iter;
     BLI_mempool_iternew(mempool, &iter);
 
+    int index = 0;
     for (void *item = BLI_mempool_iterstep(&iter); item != NULL;
-         item = BLI_mempool_iterstep(&iter)) {
-      func(userdata, item);
+         item = BLI_mempool_iterstep(&iter), index++) {
+      if (state->func_index) {
+        state->func_index(state->userdata, item, index);
+      }
+      else {
+        state->func(state->userdata, item);
+      }
     }
+    MEM_SAFE_FREE(chunks);
     return;
   }
 
-  task_scheduler = BLI_task_scheduler_get();
-  task_pool = BLI_task_pool_create_suspended(task_scheduler, &state);
-  num_threads = BLI_task_scheduler_num_threads(task_scheduler);
-
-  /* The idea here is to prevent creating task for each of the loop iterations
-   * and instead have tasks which are evenly distributed across CPU cores and
-   * pull next item to be crunched using the threaded-aware BLI_mempool_iter.
-   */
-  num_tasks = num_threads + 2;
+  TaskScheduler *task_scheduler = BLI_task_scheduler_get();
+  const int num_threads = BLI_task_scheduler_num_threads(task_scheduler);
 
-  state.userdata = userdata;
-  state.func = func;
+  /* Chunks may contain any number of freed items, so handing them out in order can give some
+   * tasks much more work than others. Count the used items of every chunk first (this only reads
+   * one word per item, and is done in parallel), then split the chunks into contiguous ranges
+   * holding about the same number of used items. Use a few ranges per thread so uneven cost per
+   * item is still balanced by the scheduler. */
+  int *chunks_used_len = MEM_mallocN(sizeof(*chunks_used_len) * chunks_len, __func__);
+  {
+    ParallelMempoolCountData count_data = {
+        .mempool = mempool,
+        .chunks = chunks,
+        .chunks_used_len = chunks_used_len,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 8;
+    BLI_task_parallel_range(
+        0, (int)chunks_len, &count_data, parallel_mempool_count_func, &settings);
+  }
 
-  BLI_mempool_iter *mempool_iterators = BLI_mempool_iter_threadsafe_create(mempool,
-                                                                           (size_t)num_tasks);
+  const int num_tasks = min_ii(num_threads * 4, (int)chunks_len);
+  ParallelMempoolTaskData *tasks_data = MEM_mallocN(sizeof(*tasks_data) * (size_t)num_tasks,
+                                                    __func__);
+  TaskPool *task_pool = BLI_task_pool_create_suspended(task_scheduler, state);
 
-  for (i = 0; i < num_tasks; i++) {
-    /* Use this pool's pre-allocated tasks. */
-    BLI_task_pool_push_from_thread(task_pool,
-                                   parallel_mempool_func,
-                                   &mempool_iterators[i],
-                                   false,
-                                   TASK_PRIORITY_HIGH,
-                                   task_pool->thread_id);
+  int tasks_len = 0;
+  /* Ranges end once they reach their share of the items, see #parallel_mempool_range_end. */
+  int range_num = 1;
+  int range_first = 0;
+  int index_start = 0;
+  int index = 0;
+  for (int i = 0; i < (int)chunks_len; i++) {
+    index += chunks_used_len[i];
+    if (index < parallel_mempool_range_end(range_num, num_tasks, items_len) &&
+        i != (int)chunks_len - 1) {
+      continue;
+    }
+    if (index != index_start) {
+      BLI_assert(tasks_len < num_tasks);
+      ParallelMempoolTaskData *task_data = &tasks_data[tasks_len++];
+      BLI_mempool_iternew_chunks(mempool, &task_data->iter, chunks[range_first], chunks[i + 1]);
+      task_data->index_start = index_start;
+      /* Use this pool's pre-allocated tasks. */
+      BLI_task_pool_push_from_thread(task_pool,
+                                     parallel_mempool_func,
+                                     task_data,
+                                     false,
+                                     TASK_PRIORITY_HIGH,
+                                     task_pool->thread_id);
+    }
+    /* A chunk with many items may cover the share of multiple ranges. */
+    while (range_num < num_tasks &&
+           parallel_mempool_range_end(range_num, num_tasks, items_len) <= index) {
+      range_num++;
+    }
+    range_first = i + 1;
+    index_start = index;
   }
+  BLI_assert(index == items_len);
 
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
-  BLI_mempool_iter_threadsafe_free(mempool_iterators);
+  MEM_freeN(tasks_data);
+  MEM_freeN(chunks_used_len);
+  MEM_freeN(chunks);
+}
+
+/**
+ * This function allows to parallelize for loops over Mempool items.
+ *
+ * \param mempool: The iterable BLI_mempool to loop over.
+ * \param userdata: Common userdata passed to all instances of \a func.
+ * \param func: Callback function.
+ * \param use_threading: If \a true, actually split-execute loop in threads,
+ * else just do a sequential for loop
+ * (allows caller to use any kind of test to switch on parallelization or not).
+ *
+ * \note The mempool is split into ranges of chunks holding about the same number of used items,
+ * so mempools with many freed items are still evenly distributed over the threads.
+ */
+void BLI_task_parallel_mempool(BLI_mempool *mempool,
+                               void *userdata,
+                               TaskParallelMempoolFunc func,
+                               const bool use_threading)
+{
+  ParallelMempoolState state = {
+      .userdata = userdata,
+      .func = func,
+      .func_index = NULL,
+  };
+  task_parallel_mempool_do(mempool, &state, use_threading);
+}
+
+/**
+ * Same as #BLI_task_parallel_mempool, also passing the index of every item, which is its position
+ * in the (single threaded) iteration order of the mempool. This allows e.g. to assign indices to
+ * items in parallel.
+ */
+void BLI_task_parallel_mempool_index(BLI_mempool *mempool,
+                                     void *userdata,
+                                     TaskParallelMempoolIndexFunc func,
+                                     const bool use_threading)
+{
+  ParallelMempoolState state = {
+      .userdata = userdata,
+      .func = NULL,
+      .func_index = func,
+  };
+  task_parallel_mempool_do(mempool, &state, use_threading);
 }
@@ -65,6 +65,10 @@ typedef struct BlendFileData {
   struct ViewLayer *cur_view_layer; /* layer to activate in workspaces when reading without UI */
 
   eBlenFileType type;
+
+  /** Undo only, some data-blocks were kept from the previous state instead of being read again,
+   * see #LIB_TAG_UNDO_OLD_ID_REUSED. */
+  bool is_undo_partial;
 } BlendFileData;
 
 typedef struct WorkspaceConfigFileData {
@@ -89,6 +93,11 @@ typedef enum eBLOReadSkip {
 BlendFileData *BLO_read_from_file(const char *filepath,
                                   eBLOReadSkip skip_flags,
                                   struct ReportList *reports);
+BlendFileData *BLO_read_from_file_partial(const char *filepath,
+                                          eBLOReadSkip skip_flags,
+                                          const int id_types_filter,
+                                          const bool use_placeholders,
+                                          struct ReportList *reports);
 BlendFileData *BLO_read_from_memory(const void *mem,
                                     int memsize,
                                     eBLOReadSkip skip_flags,
@@ -96,6 +105,7 @@ BlendFileData *BLO_read_from_memory(const void *mem,
 BlendFileData *BLO_read_from_memfile(struct Main *oldmain,
                                      const char *filename,
                                      struct MemFile *memfile,
+                                     const struct MemFile *memfile_current,
                                      eBLOReadSkip skip_flags,
                                      struct ReportList *reports);
 
@@ -32,6 +32,8 @@ typedef struct {
   const char *buf;
   /** Size in bytes. */
   unsigned int size;
+  /** Hash of the contents, used to find identical chunks. */
+  unsigned int hash;
   /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
   bool is_identical;
 } MemFileChunk;
@@ -39,6 +41,9 @@ typedef struct {
 typedef struct MemFile {
   ListBase chunks;
   size_t size;
+  /** Buffers moved to a file mapped in memory, NULL unless spilled (see #BLO_memfile_spill). */
+  const char *spill_data;
+  size_t spill_size;
 } MemFile;
 
 typedef struct MemFileUndoData {
@@ -47,15 +52,28 @@ typedef struct MemFileUndoData {
   size_t undo_size;
 } MemFileUndoData;
 
+typedef struct MemFileWriteData {
+  MemFile *written_memfile;
+  /** The previous undo step (can be NULL), its chunks are shared when the data didn't change. */
+  MemFile *reference_memfile;
+  /** All chunks of both memory files, by content (see #MemFileChunk.hash). */
+  struct GSet *chunks_by_content;
+} MemFileWriteData;
+
 /* actually only used writefile.c */
-extern void memfile_chunk_add(MemFile *memfile,
-                              const char *buf,
-                              unsigned int size,
-                              MemFileChunk **compchunk_step);
+extern void memfile_write_init(MemFileWriteData *mem_data,
+                               MemFile *written_memfile,
+                               MemFile *reference_memfile);
+extern void memfile_write_finalize(MemFileWriteData *mem_data);
+extern void memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, unsigned int size);
 
 /* exports */
 extern void BLO_memfile_free(MemFile *memfile);
 extern void BLO_memfile_merge(MemFile *first, MemFile *second);
+extern size_t BLO_memfile_spill(MemFile *memfile,
+                                const MemFile *memfile_next,
+                                const char *filepath);
+extern void BLO_memfile_unspill(MemFile *memfile);
 
 /* utilities */
 extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
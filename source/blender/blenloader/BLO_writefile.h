@@ -40,4 +40,19 @@ extern bool BLO_write_file_mem(struct Main *mainvar,
                                struct MemFile *current,
                                int write_flags);
 
+/* Writing on a background thread. */
+typedef struct BlendFileWriteSnapshot BlendFileWriteSnapshot;
+
+extern BlendFileWriteSnapshot *BLO_write_file_snapshot(struct Main *mainvar,
+                                                       const char *filepath,
+                                                       int write_flags,
+                                                       struct ReportList *reports,
+                                                       const struct BlendThumbnail *thumb);
+extern BlendFileWriteSnapshot *BLO_write_file_snapshot_from_memfile(const struct MemFile *memfile,
+                                                                    const char *filepath,
+                                                                    int write_flags);
+extern bool BLO_write_file_snapshot_save(const BlendFileWriteSnapshot *snapshot,
+                                         struct ReportList *reports);
+extern void BLO_write_file_snapshot_free(BlendFileWriteSnapshot *snapshot);
+
 #endif
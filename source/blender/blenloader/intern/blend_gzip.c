@@ -0,0 +1,433 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup blenloader
+ */
+
+#include "zlib.h"
+
+#include <fcntl.h>
+#include <string.h>
+
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_utildefines.h"
+#include "BLI_fileops.h"
+#include "BLI_task.h"
+
+#include "blend_gzip.h"
+
+/* Same as the previous `gzopen(filepath, "wb1")`, favor speed over size. */
+#define BLEND_GZIP_LEVEL 1
+
+/* Fixed header with the #GZIP_FLAG_EXTRA field, followed by the extra field itself. */
+#define GZIP_HEADER_SIZE (10 + 2 + 8)
+/* CRC32 and size of the uncompressed data. */
+#define GZIP_TRAILER_SIZE 8
+#define GZIP_FLAG_EXTRA 4
+
+/* Sanity check for sizes read from the file, a block can't compress to much more than this. */
+#define GZIP_MEMBER_SIZE_MAX (BLEND_GZIP_BLOCK_SIZE * 2)
+
+typedef struct GzipBlock {
+  /** Uncompressed data, #BLEND_GZIP_BLOCK_SIZE allocated. */
+  uchar *data;
+  size_t data_len;
+  /** Compressed gzip member, including its header and trailer. */
+  uchar *member;
+  size_t member_len;
+  size_t member_alloc_len;
+  bool error;
+} GzipBlock;
+
+/* -------------------------------------------------------------------- */
+/** \name Blocks
+ * \{ */
+
+static void gzip_uint16_store(uchar *p, const uint value)
+{
+  p[0] = (uchar)(value & 0xff);
+  p[1] = (uchar)((value >> 8) & 0xff);
+}
+
+static void gzip_uint32_store(uchar *p, const uint value)
+{
+  gzip_uint16_store(p, value & 0xffff);
+  gzip_uint16_store(p + 2, value >> 16);
+}
+
+static uint gzip_uint16_load(const uchar *p)
+{
+  return (uint)p[0] | ((uint)p[1] << 8);
+}
+
+static uint gzip_uint32_load(const uchar *p)
+{
+  return gzip_uint16_load(p) | (gzip_uint16_load(p + 2) << 16);
+}
+
+static void gzip_header_store(uchar *header, const uint member_len)
+{
+  header[0] = 0x1f;
+  header[1] = 0x8b;
+  header[2] = Z_DEFLATED;
+  header[3] = GZIP_FLAG_EXTRA;
+  /* No modification time, no extra flags and unknown OS. */
+  gzip_uint32_store(&header[4], 0);
+  header[8] = 0;
+  header[9] = 0xff;
+  /* Length of the extra field, a single sub-field. */
+  gzip_uint16_store(&header[10], 8);
+  header[12] = 'B';
+  header[13] = 'L';
+  gzip_uint16_store(&header[14], 4);
+  gzip_uint32_store(&header[16], member_len);
+}
+
+static bool gzip_header_load(const uchar *header, uint *r_member_len)
+{
+  if ((header[0] != 0x1f) || (header[1] != 0x8b) || (header[2] != Z_DEFLATED) ||
+      (header[3] != GZIP_FLAG_EXTRA) || (gzip_uint16_load(&header[10]) != 8) ||
+      (header[12] != 'B') || (header[13] != 'L') || (gzip_uint16_load(&header[14]) != 4)) {
+    return false;
+  }
+  *r_member_len = gzip_uint32_load(&header[16]);
+  return true;
+}
+
+static void gzip_block_member_ensure(GzipBlock *block, const size_t member_len)
+{
+  if (block->member_alloc_len < member_len) {
+    MEM_SAFE_FREE(block->member);
+    block->member = MEM_mallocN(member_len, __func__);
+    block->member_alloc_len = member_len;
+  }
+}
+
+static GzipBlock *gzip_blocks_new(const int blocks_num)
+{
+  GzipBlock *blocks = MEM_callocN(sizeof(*blocks) * (size_t)blocks_num, __func__);
+  for (int i = 0; i < blocks_num; i++) {
+    blocks[i].data = MEM_mallocN(BLEND_GZIP_BLOCK_SIZE, __func__);
+  }
+  return blocks;
+}
+
+static void gzip_blocks_free(GzipBlock *blocks, const int blocks_num)
+{
+  for (int i = 0; i < blocks_num; i++) {
+    MEM_freeN(blocks[i].data);
+    MEM_SAFE_FREE(blocks[i].member);
+  }
+  MEM_freeN(blocks);
+}
+
+/* Enough blocks to keep all threads busy, while the previous blocks are written or read. */
+static int gzip_blocks_num(void)
+{
+  return MAX2(BLI_task_scheduler_num_threads(BLI_task_scheduler_get()) * 2, 2);
+}
+
+static void gzip_blocks_parallel(GzipBlock *blocks,
+                                 const int blocks_len,
+                                 TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (blocks_len > 1);
+  BLI_task_parallel_range(0, blocks_len, blocks, func, &settings);
+}
+
+static void gzip_block_compress_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GzipBlock *block = &((GzipBlock *)userdata)[i];
+  z_stream strm = {NULL};
+
+  block->error = true;
+  if (deflateInit2(&strm, BLEND_GZIP_LEVEL, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) !=
+      Z_OK) {
+    return;
+  }
+
+  const size_t deflate_len_max = deflateBound(&strm, (uLong)block->data_len);
+  gzip_block_member_ensure(block, GZIP_HEADER_SIZE + deflate_len_max + GZIP_TRAILER_SIZE);
+
+  strm.next_in = block->data;
+  strm.avail_in = (uInt)block->data_len;
+  strm.next_out = block->member + GZIP_HEADER_SIZE;
+  strm.avail_out = (uInt)deflate_len_max;
+
+  if (deflate(&strm, Z_FINISH) == Z_STREAM_END) {
+    block->member_len = GZIP_HEADER_SIZE + strm.total_out + GZIP_TRAILER_SIZE;
+    gzip_header_store(block->member, (uint)block->member_len);
+
+    uchar *trailer = block->member + block->member_len - GZIP_TRAILER_SIZE;
+    gzip_uint32_store(trailer, (uint)crc32(0, block->data, (uInt)block->data_len));
+    gzip_uint32_store(trailer + 4, (uint)block->data_len);
+    block->error = false;
+  }
+
+  deflateEnd(&strm);
+}
+
+static void gzip_block_decompress_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GzipBlock *block = &((GzipBlock *)userdata)[i];
+  z_stream strm = {NULL};
+
+  block->error = true;
+  const uchar *trailer = block->member + block->member_len - GZIP_TRAILER_SIZE;
+  const uint data_len = gzip_uint32_load(trailer + 4);
+  if ((data_len > BLEND_GZIP_BLOCK_SIZE) || (inflateInit2(&strm, -MAX_WBITS) != Z_OK)) {
+    return;
+  }
+
+  strm.next_in = block->member + GZIP_HEADER_SIZE;
+  strm.avail_in = (uInt)(block->member_len - GZIP_HEADER_SIZE - GZIP_TRAILER_SIZE);
+  strm.next_out = block->data;
+  strm.avail_out = BLEND_GZIP_BLOCK_SIZE;
+
+  if ((inflate(&strm, Z_FINISH) == Z_STREAM_END) && (strm.total_out == data_len) &&
+      ((uint)crc32(0, block->data, data_len) == gzip_uint32_load(trailer))) {
+    block->data_len = data_len;
+    block->error = false;
+  }
+
+  inflateEnd(&strm);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Writing
+ * \{ */
+
+struct BlendGzipWriter {
+  int filedes;
+  bool error;
+  GzipBlock *blocks;
+  int blocks_num;
+  /** Number of filled blocks, the block after them is being filled. */
+  int blocks_len;
+};
+
+BlendGzipWriter *blo_gzip_writer_open(const char *filepath)
+{
+  const int filedes = BLI_open(filepath, O_BINARY | O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (filedes == -1) {
+    return NULL;
+  }
+
+  BlendGzipWriter *gzip_writer = MEM_callocN(sizeof(*gzip_writer), __func__);
+  gzip_writer->filedes = filedes;
+  gzip_writer->blocks_num = gzip_blocks_num();
+  gzip_writer->blocks = gzip_blocks_new(gzip_writer->blocks_num);
+  return gzip_writer;
+}
+
+static void gzip_writer_flush(BlendGzipWriter *gzip_writer, const int blocks_len)
+{
+  GzipBlock *blocks = gzip_writer->blocks;
+  gzip_blocks_parallel(blocks, blocks_len, gzip_block_compress_cb);
+
+  /* Members must be written in order. */
+  for (int i = 0; i < blocks_len; i++) {
+    GzipBlock *block = &blocks[i];
+    if (!gzip_writer->error) {
+      if (block->error || (write(gzip_writer->filedes, block->member, (uint)block->member_len) !=
+                           (int)block->member_len)) {
+        gzip_writer->error = true;
+      }
+    }
+    block->data_len = 0;
+  }
+  gzip_writer->blocks_len = 0;
+}
+
+bool blo_gzip_writer_write(BlendGzipWriter *gzip_writer, const void *data, size_t data_len)
+{
+  const uchar *data_iter = data;
+  while ((data_len != 0) && !gzip_writer->error) {
+    GzipBlock *block = &gzip_writer->blocks[gzip_writer->blocks_len];
+    const size_t copy_len = MIN2(data_len, BLEND_GZIP_BLOCK_SIZE - block->data_len);
+    memcpy(block->data + block->data_len, data_iter, copy_len);
+    block->data_len += copy_len;
+    data_iter += copy_len;
+    data_len -= copy_len;
+
+    if (block->data_len == BLEND_GZIP_BLOCK_SIZE) {
+      gzip_writer->blocks_len++;
+      if (gzip_writer->blocks_len == gzip_writer->blocks_num) {
+        gzip_writer_flush(gzip_writer, gzip_writer->blocks_len);
+      }
+    }
+  }
+  return !gzip_writer->error;
+}
+
+bool blo_gzip_writer_close(BlendGzipWriter *gzip_writer)
+{
+  int blocks_len = gzip_writer->blocks_len;
+  if (gzip_writer->blocks[blocks_len].data_len != 0) {
+    blocks_len++;
+  }
+  if (blocks_len != 0) {
+    gzip_writer_flush(gzip_writer, blocks_len);
+  }
+
+  if (close(gzip_writer->filedes) == -1) {
+    gzip_writer->error = true;
+  }
+
+  const bool success = !gzip_writer->error;
+  gzip_blocks_free(gzip_writer->blocks, gzip_writer->blocks_num);
+  MEM_freeN(gzip_writer);
+  return success;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Reading
+ * \{ */
+
+struct BlendGzipReader {
+  int filedes;
+  bool error;
+  /** All members have been read from the file. */
+  bool is_eof;
+  GzipBlock *blocks;
+  int blocks_num;
+  /** Number of decompressed blocks. */
+  int blocks_len;
+  /** Block being read from and the position in it. */
+  int block_index;
+  size_t block_offset;
+};
+
+BlendGzipReader *blo_gzip_reader_open(int filedes)
+{
+  uchar header[GZIP_HEADER_SIZE];
+  uint member_len;
+  const bool is_blocked = (read(filedes, header, sizeof(header)) == sizeof(header)) &&
+                          gzip_header_load(header, &member_len);
+  if ((lseek(filedes, 0, SEEK_SET) == -1) || !is_blocked) {
+    return NULL;
+  }
+
+  BlendGzipReader *gzip_reader = MEM_callocN(sizeof(*gzip_reader), __func__);
+  gzip_reader->filedes = filedes;
+  gzip_reader->blocks_num = gzip_blocks_num();
+  gzip_reader->blocks = gzip_blocks_new(gzip_reader->blocks_num);
+  return gzip_reader;
+}
+
+/* Read the next members from the file and decompress them. */
+static void gzip_reader_fill(BlendGzipReader *gzip_reader)
+{
+  gzip_reader->blocks_len = 0;
+  gzip_reader->block_index = 0;
+  gzip_reader->block_offset = 0;
+
+  while (!gzip_reader->is_eof && (gzip_reader->blocks_len < gzip_reader->blocks_num)) {
+    GzipBlock *block = &gzip_reader->blocks[gzip_reader->blocks_len];
+    uchar header[GZIP_HEADER_SIZE];
+    uint member_len;
+
+    const int readsize = read(gzip_reader->filedes, header, sizeof(header));
+    if (readsize == 0) {
+      gzip_reader->is_eof = true;
+      break;
+    }
+    if ((readsize != sizeof(header)) || !gzip_header_load(header, &member_len) ||
+        (member_len < GZIP_HEADER_SIZE + GZIP_TRAILER_SIZE) ||
+        (member_len > GZIP_MEMBER_SIZE_MAX)) {
+      gzip_reader->error = true;
+      return;
+    }
+
+    gzip_block_member_ensure(block, member_len);
+    memcpy(block->member, header, sizeof(header));
+    const uint remaining_len = member_len - GZIP_HEADER_SIZE;
+    if (read(gzip_reader->filedes, block->member + GZIP_HEADER_SIZE, remaining_len) !=
+        (int)remaining_len) {
+      gzip_reader->error = true;
+      return;
+    }
+    block->member_len = member_len;
+    gzip_reader->blocks_len++;
+  }
+
+  gzip_blocks_parallel(gzip_reader->blocks, gzip_reader->blocks_len, gzip_block_decompress_cb);
+  for (int i = 0; i < gzip_reader->blocks_len; i++) {
+    if (gzip_reader->blocks[i].error) {
+      gzip_reader->error = true;
+    }
+  }
+}
+
+int blo_gzip_reader_read(BlendGzipReader *gzip_reader, void *buffer, uint size)
+{
+  uchar *buffer_iter = buffer;
+  uint readsize = 0;
+
+  while (readsize < size) {
+    if (gzip_reader->block_index == gzip_reader->blocks_len) {
+      if (gzip_reader->is_eof) {
+        break;
+      }
+      gzip_reader_fill(gzip_reader);
+      if (gzip_reader->error) {
+        return -1;
+      }
+      continue;
+    }
+
+    GzipBlock *block = &gzip_reader->blocks[gzip_reader->block_index];
+    const size_t copy_len = MIN2((size_t)(size - readsize),
+                                 block->data_len - gzip_reader->block_offset);
+    memcpy(buffer_iter, block->data + gzip_reader->block_offset, copy_len);
+    buffer_iter += copy_len;
+    readsize += (uint)copy_len;
+    gzip_reader->block_offset += copy_len;
+
+    if (gzip_reader->block_offset == block->data_len) {
+      gzip_reader->block_index++;
+      gzip_reader->block_offset = 0;
+    }
+  }
+
+  return (int)readsize;
+}
+
+void blo_gzip_reader_close(BlendGzipReader *gzip_reader)
+{
+  gzip_blocks_free(gzip_reader->blocks, gzip_reader->blocks_num);
+  MEM_freeN(gzip_reader);
+}
+
+/** \} */
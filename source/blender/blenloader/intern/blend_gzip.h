@@ -0,0 +1,58 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BLEND_GZIP_H__
+#define __BLEND_GZIP_H__
+
+/** \file
+ * \ingroup blenloader
+ *
+ * Blocked gzip files, used for compressed .blend files.
+ *
+ * The data is split into blocks of #BLEND_GZIP_BLOCK_SIZE, each compressed into its own gzip
+ * member. Concatenated members are a valid gzip file, so these can be read by any gzip reader
+ * (including older Blender versions). Since blocks don't depend on each other,
+ * they're compressed and decompressed on multiple threads.
+ *
+ * The header of every member has an extra field (sub-field ID `BL`) storing the size
+ * of the whole member, this is used to find the members without decompressing them.
+ */
+
+#include "BLI_sys_types.h"
+
+/* Size of the uncompressed data of a block. */
+#define BLEND_GZIP_BLOCK_SIZE (1 << 20)
+
+typedef struct BlendGzipWriter BlendGzipWriter;
+typedef struct BlendGzipReader BlendGzipReader;
+
+BlendGzipWriter *blo_gzip_writer_open(const char *filepath);
+bool blo_gzip_writer_write(BlendGzipWriter *gzip_writer, const void *data, size_t data_len);
+/* Writes the remaining data, returns false if there was an error at any point. */
+bool blo_gzip_writer_close(BlendGzipWriter *gzip_writer);
+
+/**
+ * Start reading from the beginning of \a filedes,
+ * returns NULL when the file isn't a blocked gzip file.
+ *
+ * \note The caller keeps ownership of \a filedes.
+ */
+BlendGzipReader *blo_gzip_reader_open(int filedes);
+/* Returns the number of bytes read (less than \a size at the end of the file), -1 on error. */
+int blo_gzip_reader_read(BlendGzipReader *gzip_reader, void *buffer, uint size);
+void blo_gzip_reader_close(BlendGzipReader *gzip_reader);
+
+#endif /* __BLEND_GZIP_H__ */
@@ -36,6 +36,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_trace.h"
 
 #include "DNA_genfile.h"
 #include "DNA_sdna_types.h"
@@ -312,7 +313,9 @@ BlendFileData *BLO_read_from_file(const char *filepath,
 {
   BlendFileData *bfd = NULL;
   FileData *fd;
+  TraceZone zone;
 
+  BLI_trace_zone_begin(&zone, "Read File", "io");
   fd = blo_filedata_from_file(filepath, reports);
   if (fd) {
     fd->reports = reports;
@@ -320,6 +323,43 @@ BlendFileData *BLO_read_from_file(const char *filepath,
     bfd = blo_read_file_internal(fd, filepath);
     blo_filedata_free(fd);
   }
+  BLI_trace_zone_end(&zone);
+
+  return bfd;
+}
+
+/**
+ * Same as #BLO_read_from_file, only reading the data-blocks of the requested types
+ * (and libraries), skipping all the data of the other ones.
+ *
+ * \param id_types_filter: The types of data-blocks to read (`FILTER_ID_*` flags).
+ * \param use_placeholders: Add empty placeholder data-blocks (tagged #LIB_TAG_MISSING)
+ * for the skipped ones, so the pointers of the data-blocks that are read remain valid.
+ * Otherwise these pointers are cleared.
+ *
+ * \note Skipped data-blocks include the window-manager and screens,
+ * the result is meant for inspecting the file, not for loading it as the current file.
+ */
+BlendFileData *BLO_read_from_file_partial(const char *filepath,
+                                          eBLOReadSkip skip_flags,
+                                          const int id_types_filter,
+                                          const bool use_placeholders,
+                                          ReportList *reports)
+{
+  BlendFileData *bfd = NULL;
+  FileData *fd;
+
+  BLI_assert(id_types_filter != 0);
+
+  fd = blo_filedata_from_file(filepath, reports);
+  if (fd) {
+    fd->reports = reports;
+    fd->skip_flags = skip_flags;
+    fd->id_types_filter = id_types_filter;
+    fd->use_id_types_placeholders = use_placeholders;
+    bfd = blo_read_file_internal(fd, filepath);
+    blo_filedata_free(fd);
+  }
 
   return bfd;
 }
@@ -359,10 +399,13 @@ BlendFileData *BLO_read_from_memory(const void *mem,
  * \param oldmain: old main,
  * from which we will keep libraries and other data-blocks that should not have changed.
  * \param filename: current file, only for retrieving library data.
+ * \param memfile_current: memfile of the state \a oldmain is in (may be NULL),
+ * data-blocks which didn't change since then are moved from \a oldmain instead of being read.
  */
 BlendFileData *BLO_read_from_memfile(Main *oldmain,
                                      const char *filename,
                                      MemFile *memfile,
+                                     const MemFile *memfile_current,
                                      eBLOReadSkip skip_flags,
                                      ReportList *reports)
 {
@@ -370,7 +413,7 @@ BlendFileData *BLO_read_from_memfile(Main *oldmain,
   FileData *fd;
   ListBase old_mainlist;
 
-  fd = blo_filedata_from_memfile(memfile, reports);
+  fd = blo_filedata_from_memfile(memfile, memfile_current, reports);
   if (fd) {
     fd->reports = reports;
     fd->skip_flags = skip_flags;
@@ -34,6 +34,8 @@
 #include "BLI_utildefines.h"
 #ifndef WIN32
 #  include <unistd.h>  // for read close
+#  include <sys/mman.h>
+#  include <sys/stat.h>
 #else
 #  include <io.h>  // for open close read
 #  include "winsock2.h"
@@ -101,6 +103,7 @@
 #include "BLI_threads.h"
 #include "BLI_mempool.h"
 #include "BLI_ghash.h"
+#include "BLI_task.h"
 
 #include "BLT_translation.h"
 
@@ -156,6 +159,7 @@
 
 #include "RE_engine.h"
 
+#include "blend_gzip.h"
 #include "readfile.h"
 
 #include <errno.h>
@@ -222,6 +226,27 @@
  */
 #define USE_BHEAD_READ_ON_DEMAND
 
+/**
+ * Map uncompressed files into memory instead of reading them with system calls.
+ *
+ * Combined with #USE_BHEAD_READ_ON_DEMAND the data of blocks is never copied into the #BHeadN,
+ * it's copied from the mapped file straight into its final allocation
+ * (or reconstructed from the mapped file when the struct differs).
+ *
+ * \note The data can't be used from the mapped file directly,
+ * since the data-blocks own their memory and free it with #MEM_freeN.
+ */
+#if defined(USE_BHEAD_READ_ON_DEMAND) && !defined(WIN32)
+#  define USE_MMAP_FILE_READ
+#endif
+
+/**
+ * Decode blocks which need their endian switched or their struct reconstructed on multiple
+ * threads, before reading the data-blocks. Only the decoding is threaded, reading the data-blocks
+ * (direct linking) stays single threaded since it depends on the pointer maps of the file data.
+ */
+#define USE_THREADED_STRUCT_DECODE
+
 /* use GHash for BHead name-based lookups (speeds up linking) */
 #define USE_GHASH_BHEAD
 
@@ -258,6 +283,9 @@ typedef struct BHeadN {
   /** When set, the remainder of this allocation is the data, otherwise it needs to be read. */
   bool has_data;
 #endif
+  /** All the data of this block was read from memfile chunks shared with the current state,
+   * see #FileData.memfile_current_chunks. */
+  bool is_memchunk_identical;
   struct BHead bhead;
 } BHeadN;
 
@@ -318,17 +346,31 @@ typedef struct OldNewMap {
   int32_t *map;
 
   int capacity_exp;
+  /* Size of the allocated arrays, kept when the map is cleared, so it's not grown again. */
+  int capacity_exp_alloc;
 } OldNewMap;
 
-#define ENTRIES_CAPACITY(onm) (1ll << (onm)->capacity_exp)
-#define MAP_CAPACITY(onm) (1ll << ((onm)->capacity_exp + 1))
+#define ENTRIES_CAPACITY_FROM_EXP(exp) (1ll << (exp))
+#define MAP_CAPACITY_FROM_EXP(exp) (1ll << ((exp) + 1))
+#define ENTRIES_CAPACITY(onm) ENTRIES_CAPACITY_FROM_EXP((onm)->capacity_exp)
+#define MAP_CAPACITY(onm) MAP_CAPACITY_FROM_EXP((onm)->capacity_exp)
 #define SLOT_MASK(onm) (MAP_CAPACITY(onm) - 1)
 #define DEFAULT_SIZE_EXP 6
 #define PERTURB_SHIFT 5
 
+/**
+ * Same as #BLI_ghashutil_ptrhash, inlined since this is done for every pointer that is read.
+ * The bottom bits of pointers are likely to be 0, rotate them out of the way.
+ */
+BLI_INLINE uint32_t oldnewmap_ptrhash(const void *ptr)
+{
+  const size_t y = (size_t)ptr;
+  return (uint32_t)(y >> 4) | ((uint32_t)y << 28);
+}
+
 /* based on the probing algorithm used in Python dicts. */
 #define ITER_SLOTS(onm, KEY, SLOT_NAME, INDEX_NAME) \
-  uint32_t hash = BLI_ghashutil_ptrhash(KEY); \
+  uint32_t hash = oldnewmap_ptrhash(KEY); \
   uint32_t mask = SLOT_MASK(onm); \
   uint perturb = hash; \
   int SLOT_NAME = mask & hash; \
@@ -383,17 +425,27 @@ static void oldnewmap_clear_map(OldNewMap *onm)
   memset(onm->map, 0xFF, MAP_CAPACITY(onm) * sizeof(*onm->map));
 }
 
-static void oldnewmap_increase_size(OldNewMap *onm)
+static void oldnewmap_resize(OldNewMap *onm, const int capacity_exp)
 {
-  onm->capacity_exp++;
-  onm->entries = MEM_reallocN(onm->entries, sizeof(*onm->entries) * ENTRIES_CAPACITY(onm));
-  onm->map = MEM_reallocN(onm->map, sizeof(*onm->map) * MAP_CAPACITY(onm));
+  onm->capacity_exp = capacity_exp;
+  if (capacity_exp > onm->capacity_exp_alloc) {
+    onm->capacity_exp_alloc = capacity_exp;
+    onm->entries = MEM_reallocN(onm->entries, sizeof(*onm->entries) * ENTRIES_CAPACITY(onm));
+    /* The map is rebuilt, no need to copy it. */
+    MEM_freeN(onm->map);
+    onm->map = MEM_malloc_arrayN(MAP_CAPACITY(onm), sizeof(*onm->map), "OldNewMap.map");
+  }
   oldnewmap_clear_map(onm);
   for (int i = 0; i < onm->nentries; i++) {
     oldnewmap_insert_index_in_map(onm, onm->entries[i].oldp, i);
   }
 }
 
+static void oldnewmap_increase_size(OldNewMap *onm)
+{
+  oldnewmap_resize(onm, onm->capacity_exp + 1);
+}
+
 /* Public OldNewMap API */
 
 static OldNewMap *oldnewmap_new(void)
@@ -401,6 +453,7 @@ static OldNewMap *oldnewmap_new(void)
   OldNewMap *onm = MEM_callocN(sizeof(*onm), "OldNewMap");
 
   onm->capacity_exp = DEFAULT_SIZE_EXP;
+  onm->capacity_exp_alloc = DEFAULT_SIZE_EXP;
   onm->entries = MEM_malloc_arrayN(
       ENTRIES_CAPACITY(onm), sizeof(*onm->entries), "OldNewMap.entries");
   onm->map = MEM_malloc_arrayN(MAP_CAPACITY(onm), sizeof(*onm->map), "OldNewMap.map");
@@ -426,6 +479,21 @@ static void oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr,
   oldnewmap_insert_or_replace(onm, entry);
 }
 
+/**
+ * Make room for \a len more entries up-front,
+ * instead of growing the map (and rebuilding it) multiple times while inserting them.
+ */
+static void oldnewmap_reserve(OldNewMap *onm, const int len)
+{
+  int capacity_exp = onm->capacity_exp;
+  while (ENTRIES_CAPACITY_FROM_EXP(capacity_exp) < (int64_t)onm->nentries + len) {
+    capacity_exp++;
+  }
+  if (capacity_exp != onm->capacity_exp) {
+    oldnewmap_resize(onm, capacity_exp);
+  }
+}
+
 void blo_do_versions_oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr, int nr)
 {
   oldnewmap_insert(onm, oldaddr, newaddr, nr);
@@ -485,6 +553,8 @@ static void oldnewmap_free(OldNewMap *onm)
   MEM_freeN(onm);
 }
 
+#undef ENTRIES_CAPACITY_FROM_EXP
+#undef MAP_CAPACITY_FROM_EXP
 #undef ENTRIES_CAPACITY
 #undef MAP_CAPACITY
 #undef SLOT_MASK
@@ -779,6 +849,8 @@ static BHeadN *get_bhead(FileData *fd)
       BHead4 bhead4 = {0};
       BHead bhead = {0};
 
+      fd->is_memchunk_identical = true;
+
       /* First read the bhead structure.
        * Depending on the platform the file was written on this can
        * be a big or little endian BHead4 or BHead8 structure.
@@ -852,6 +924,7 @@ static BHeadN *get_bhead(FileData *fd)
           new_bhead->next = new_bhead->prev = NULL;
           new_bhead->file_offset = fd->file_offset;
           new_bhead->has_data = false;
+          new_bhead->is_memchunk_identical = false;
           new_bhead->bhead = bhead;
           off64_t seek_new = fd->seek(fd, bhead.len, SEEK_CUR);
           if (seek_new == -1) {
@@ -883,6 +956,9 @@ static BHeadN *get_bhead(FileData *fd)
             MEM_freeN(new_bhead);
             new_bhead = NULL;
           }
+          else {
+            new_bhead->is_memchunk_identical = fd->is_memchunk_identical;
+          }
         }
         else {
           fd->is_eof = true;
@@ -991,6 +1067,28 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
 }
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
+/**
+ * Data of the block when it can be accessed without reading it from the file,
+ * either because it's in memory or because the file is mapped (see: #USE_MMAP_FILE_READ).
+ */
+static const void *blo_bhead_data_get(const FileData *fd, BHead *thisblock)
+{
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  const BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  if (new_bhead->has_data == false) {
+#  ifdef USE_MMAP_FILE_READ
+    if (fd->mmap_data != NULL) {
+      return fd->mmap_data + new_bhead->file_offset;
+    }
+#  endif
+    return NULL;
+  }
+#else
+  UNUSED_VARS(fd);
+#endif
+  return thisblock + 1;
+}
+
 /* Warning! Caller's responsibility to ensure given bhead **is** and ID one! */
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead)
 {
@@ -1155,6 +1253,59 @@ static off64_t fd_seek_data_from_file(FileData *filedata, off64_t offset, int wh
   return filedata->file_offset;
 }
 
+#ifdef USE_MMAP_FILE_READ
+/* Memory mapped file reading. */
+
+static const char *fd_mmap_file(int filedes, size_t *r_size)
+{
+  struct stat st;
+  if ((fstat(filedes, &st) == -1) || !S_ISREG(st.st_mode) || (st.st_size <= 0)) {
+    return NULL;
+  }
+  void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, filedes, 0);
+  if (data == MAP_FAILED) {
+    return NULL;
+  }
+  *r_size = (size_t)st.st_size;
+  return data;
+}
+
+static int fd_read_from_mmap(FileData *filedata, void *buffer, uint size)
+{
+  /* don't read more bytes then there are available in the file */
+  const size_t offset = (size_t)filedata->file_offset;
+  const size_t readsize = (offset < filedata->mmap_size) ?
+                              MIN2((size_t)size, filedata->mmap_size - offset) :
+                              0;
+
+  memcpy(buffer, filedata->mmap_data + offset, readsize);
+  filedata->file_offset += (int64_t)readsize;
+
+  return (int)readsize;
+}
+
+static off64_t fd_seek_from_mmap(FileData *filedata, off64_t offset, int whence)
+{
+  switch (whence) {
+    case SEEK_SET:
+      break;
+    case SEEK_CUR:
+      offset += filedata->file_offset;
+      break;
+    case SEEK_END:
+      offset += (off64_t)filedata->mmap_size;
+      break;
+    default:
+      return -1;
+  }
+  if ((offset < 0) || ((size_t)offset > filedata->mmap_size)) {
+    return -1;
+  }
+  filedata->file_offset = offset;
+  return offset;
+}
+#endif /* USE_MMAP_FILE_READ */
+
 /* GZip file reading. */
 
 static int fd_read_gzip_from_file(FileData *filedata, void *buffer, uint size)
@@ -1171,6 +1322,22 @@ static int fd_read_gzip_from_file(FileData *filedata, void *buffer, uint size)
   return (readsize);
 }
 
+/* Blocked GZip file reading (decompressed on multiple threads, see: blend_gzip.h). */
+
+static int fd_read_gzip_blocked_from_file(FileData *filedata, void *buffer, uint size)
+{
+  int readsize = blo_gzip_reader_read(filedata->gzip_reader, buffer, size);
+
+  if (readsize < 0) {
+    readsize = EOF;
+  }
+  else {
+    filedata->file_offset += readsize;
+  }
+
+  return (readsize);
+}
+
 /* Memory reading. */
 
 static int fd_read_from_memory(FileData *filedata, void *buffer, uint size)
@@ -1240,6 +1407,10 @@ static int fd_read_from_memfile(FileData *filedata, void *buffer, uint size)
 
       memcpy(POINTER_OFFSET(buffer, totread), chunk->buf + chunkoffset, readsize);
       totread += readsize;
+      if (filedata->memfile_current_chunks &&
+          !BLI_gset_haskey(filedata->memfile_current_chunks, chunk->buf)) {
+        filedata->is_memchunk_identical = false;
+      }
       filedata->file_offset += readsize;
       seek += readsize;
     } while (totread < size);
@@ -1295,8 +1466,13 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 {
   FileDataReadFn *read_fn = NULL;
   FileDataSeekFn *seek_fn = NULL; /* Optional. */
+#ifdef USE_MMAP_FILE_READ
+  const char *mmap_data = NULL;
+  size_t mmap_size = 0;
+#endif
 
   gzFile gzfile = (gzFile)Z_NULL;
+  BlendGzipReader *gzip_reader = NULL;
 
   char header[7];
 
@@ -1318,6 +1494,24 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
   if (memcmp(header, "BLENDER", sizeof(header)) == 0) {
     read_fn = fd_read_data_from_file;
     seek_fn = fd_seek_data_from_file;
+#ifdef USE_MMAP_FILE_READ
+    mmap_data = fd_mmap_file(file, &mmap_size);
+    if (mmap_data != NULL) {
+      read_fn = fd_read_from_mmap;
+      seek_fn = fd_seek_from_mmap;
+    }
+#endif
+  }
+
+  /* Blocked gzip file (written by Blender). */
+  if ((read_fn == NULL) &&
+      /* Check header magic. */
+      (header[0] == 0x1f && header[1] == 0x8b)) {
+    gzip_reader = blo_gzip_reader_open(file);
+    if (gzip_reader != NULL) {
+      /* Like 'gzfile' there is no 'seek_fn', blocks are decompressed in order. */
+      read_fn = fd_read_gzip_blocked_from_file;
+    }
   }
 
   /* Gzip file. */
@@ -1351,10 +1545,16 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   fd->filedes = file;
   fd->gzfiledes = gzfile;
+  fd->gzip_reader = gzip_reader;
 
   fd->read = read_fn;
   fd->seek = seek_fn;
 
+#ifdef USE_MMAP_FILE_READ
+  fd->mmap_data = mmap_data;
+  fd->mmap_size = mmap_size;
+#endif
+
   return fd;
 }
 
@@ -1418,6 +1618,13 @@ static int fd_read_gzip_from_memory(FileData *filedata, void *buffer, uint size)
   // Inflate another chunk.
   err = inflate(&filedata->strm, Z_SYNC_FLUSH);
 
+  /* Blocked gzip files are made of multiple members (see: blend_gzip.h), continue with the next
+   * one, when the buffer is already full the next read continues with it. */
+  while ((err == Z_STREAM_END) && (filedata->strm.avail_in != 0)) {
+    inflateReset(&filedata->strm);
+    err = (filedata->strm.avail_out != 0) ? inflate(&filedata->strm, Z_SYNC_FLUSH) : Z_OK;
+  }
+
   if (err == Z_STREAM_END) {
     return 0;
   }
@@ -1479,7 +1686,13 @@ FileData *blo_filedata_from_memory(const void *mem, int memsize, ReportList *rep
   }
 }
 
-FileData *blo_filedata_from_memfile(MemFile *memfile, ReportList *reports)
+/**
+ * \param memfile_current: The memfile of the current state (may be NULL),
+ * used to detect the data-blocks which don't need to be read again.
+ */
+FileData *blo_filedata_from_memfile(MemFile *memfile,
+                                    const MemFile *memfile_current,
+                                    ReportList *reports)
 {
   if (!memfile) {
     BKE_report(reports, RPT_WARNING, "Unable to open blend <memory>");
@@ -1489,6 +1702,14 @@ FileData *blo_filedata_from_memfile(MemFile *memfile, ReportList *reports)
     FileData *fd = filedata_new();
     fd->memfile = memfile;
 
+    if (memfile_current != NULL) {
+      fd->memfile_current_chunks = BLI_gset_ptr_new_ex(
+          __func__, (uint)BLI_listbase_count(&memfile_current->chunks));
+      LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile_current->chunks) {
+        BLI_gset_add(fd->memfile_current_chunks, (void *)chunk->buf);
+      }
+    }
+
     fd->read = fd_read_from_memfile;
     fd->flags |= FD_FLAGS_NOT_MY_BUFFER;
 
@@ -1507,6 +1728,10 @@ void blo_filedata_free(FileData *fd)
       gzclose(fd->gzfiledes);
     }
 
+    if (fd->gzip_reader != NULL) {
+      blo_gzip_reader_close(fd->gzip_reader);
+    }
+
     if (fd->strm.next_in) {
       if (inflateEnd(&fd->strm) != Z_OK) {
         printf("close gzip stream error\n");
@@ -1518,6 +1743,12 @@ void blo_filedata_free(FileData *fd)
       fd->buffer = NULL;
     }
 
+#ifdef USE_MMAP_FILE_READ
+    if (fd->mmap_data) {
+      munmap((void *)fd->mmap_data, fd->mmap_size);
+    }
+#endif
+
     /* Free all BHeadN data blocks */
 #ifndef NDEBUG
     BLI_freelistN(&fd->bhead_list);
@@ -1565,6 +1796,19 @@ void blo_filedata_free(FileData *fd)
     if (fd->bheadmap) {
       MEM_freeN(fd->bheadmap);
     }
+    if (fd->memfile_current_chunks) {
+      BLI_gset_free(fd->memfile_current_chunks, NULL);
+    }
+    if (fd->undo_reused_ids) {
+      BLI_gset_free(fd->undo_reused_ids, NULL);
+    }
+
+#ifdef USE_THREADED_STRUCT_DECODE
+    /* Decoded data of blocks which weren't read. */
+    if (fd->bhead_decoded) {
+      BLI_ghash_free(fd->bhead_decoded, NULL, MEM_freeN);
+    }
+#endif
 
 #ifdef USE_GHASH_BHEAD
     if (fd->bhead_idname_hash) {
@@ -2226,6 +2470,15 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 {
   void *temp = NULL;
 
+#ifdef USE_THREADED_STRUCT_DECODE
+  if (fd->bhead_decoded) {
+    temp = BLI_ghash_popkey(fd->bhead_decoded, bh, NULL);
+    if (temp) {
+      return temp;
+    }
+  }
+#endif
+
   if (bh->len) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
     BHead *bh_orig = bh;
@@ -2247,17 +2500,19 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+        const void *data = blo_bhead_data_get(fd, bh);
 #ifdef USE_BHEAD_READ_ON_DEMAND
-        if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+        if (data == NULL) {
           bh = blo_bhead_read_full(fd, bh);
           if (UNLIKELY(bh == NULL)) {
             fd->flags &= ~FD_FLAGS_FILE_OK;
             return NULL;
           }
+          data = (bh + 1);
         }
 #endif
         temp = DNA_struct_reconstruct(
-            fd->memsdna, fd->filesdna, fd->compflags, bh->SDNAnr, bh->nr, (bh + 1));
+            fd->memsdna, fd->filesdna, fd->compflags, bh->SDNAnr, bh->nr, data);
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -2290,6 +2545,168 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
   return temp;
 }
 
+#ifdef USE_THREADED_STRUCT_DECODE
+
+/* Only decode on multiple threads when there are enough blocks for it to pay off. */
+#define STRUCT_DECODE_THREADED_MIN 256
+/* Limit the memory used by data which is read from the file only to be decoded. */
+#define STRUCT_DECODE_BATCH_SIZE (64 * 1024 * 1024)
+
+typedef struct StructDecodeData {
+  FileData *fd;
+  /** Blocks with their data in memory (or in the mapped file when there is no endian switch). */
+  BHead **bheads;
+  void **decoded;
+} StructDecodeData;
+
+/* Same as #read_struct, doesn't handle the #SDNA_CMP_EQUAL case which has nothing to decode. */
+static bool read_struct_needs_decode(const FileData *fd, const BHead *bh)
+{
+  if ((bh->len == 0) || (fd->compflags[bh->SDNAnr] == SDNA_CMP_REMOVED)) {
+    return false;
+  }
+  return (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) ||
+         (bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN));
+}
+
+static bool read_libblock_is_filtered(FileData *fd, BHead *bhead);
+
+/**
+ * Whether \a bh is left to #read_struct instead of being decoded up-front,
+ * \a id_filtered tracks whether the data-block of the following blocks is skipped.
+ */
+static bool read_struct_decode_skip(FileData *fd, BHead *bh, bool *id_filtered)
+{
+  if (ELEM(bh->code, DNA1, TEST, REND)) {
+    return true;
+  }
+  if (bh->code != DATA) {
+    *id_filtered = read_libblock_is_filtered(fd, bh);
+  }
+  return *id_filtered || !read_struct_needs_decode(fd, bh);
+}
+
+static void read_struct_decode_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  StructDecodeData *data = userdata;
+  const FileData *fd = data->fd;
+  BHead *bh = data->bheads[i];
+
+  if (bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    switch_endian_structs(fd->filesdna, bh);
+  }
+
+  if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    data->decoded[i] = DNA_struct_reconstruct(
+        fd->memsdna, fd->filesdna, fd->compflags, bh->SDNAnr, bh->nr, blo_bhead_data_get(fd, bh));
+  }
+  else {
+    data->decoded[i] = MEM_mallocN(bh->len, "read struct decoded");
+    memcpy(data->decoded[i], (bh + 1), bh->len);
+  }
+}
+
+static void read_struct_decode_batch(FileData *fd,
+                                     BHead **bheads_orig,
+                                     StructDecodeData *data,
+                                     const int bheads_len,
+                                     const bool use_threading)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = use_threading;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, bheads_len, data, read_struct_decode_cb, &settings);
+
+  for (int i = 0; i < bheads_len; i++) {
+    BLI_ghash_insert(fd->bhead_decoded, bheads_orig[i], data->decoded[i]);
+#  ifdef USE_BHEAD_READ_ON_DEMAND
+    if (data->bheads[i] != bheads_orig[i]) {
+      MEM_freeN(BHEADN_FROM_BHEAD(data->bheads[i]));
+    }
+#  endif
+  }
+}
+
+/**
+ * Decode all blocks of the file which need it, so #read_struct only has to look them up.
+ *
+ * Data which is read on demand is read from the file here (sequentially),
+ * in batches so it doesn't all have to be kept in memory twice.
+ */
+static void read_file_decode_structs(FileData *fd)
+{
+  BLI_assert(fd->bhead_decoded == NULL);
+
+  int bheads_len = 0;
+  bool id_filtered = false;
+  for (BHead *bh = blo_bhead_first(fd); bh && bh->code != ENDB; bh = blo_bhead_next(fd, bh)) {
+    if (!read_struct_decode_skip(fd, bh, &id_filtered)) {
+      bheads_len++;
+    }
+  }
+
+  if (bheads_len < STRUCT_DECODE_THREADED_MIN) {
+    /* Let #read_struct decode them as they're read. */
+    return;
+  }
+
+  fd->bhead_decoded = BLI_ghash_ptr_new_ex(__func__, (uint)bheads_len);
+
+  BHead **bheads_orig = MEM_mallocN(sizeof(*bheads_orig) * (size_t)bheads_len, __func__);
+  StructDecodeData data = {
+      .fd = fd,
+      .bheads = MEM_mallocN(sizeof(*data.bheads) * (size_t)bheads_len, __func__),
+      .decoded = MEM_mallocN(sizeof(*data.decoded) * (size_t)bheads_len, __func__),
+  };
+
+  int batch_len = 0;
+  size_t batch_size = 0;
+  id_filtered = false;
+  for (BHead *bh = blo_bhead_first(fd); bh && bh->code != ENDB; bh = blo_bhead_next(fd, bh)) {
+    if (read_struct_decode_skip(fd, bh, &id_filtered)) {
+      continue;
+    }
+
+    BHead *bh_data = bh;
+#  ifdef USE_BHEAD_READ_ON_DEMAND
+    /* The endian switch is done in place, so it needs a copy of mapped data. */
+    if ((BHEADN_FROM_BHEAD(bh)->has_data == false) &&
+        ((blo_bhead_data_get(fd, bh) == NULL) ||
+         (bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)))) {
+      bh_data = blo_bhead_read_full(fd, bh);
+      if (UNLIKELY(bh_data == NULL)) {
+        /* Leave it to #read_struct, which reports the error. */
+        continue;
+      }
+      batch_size += (size_t)bh->len;
+    }
+#  endif
+    bheads_orig[batch_len] = bh;
+    data.bheads[batch_len] = bh_data;
+    batch_len++;
+
+    if (batch_size >= STRUCT_DECODE_BATCH_SIZE) {
+      read_struct_decode_batch(fd, bheads_orig, &data, batch_len, true);
+      batch_len = 0;
+      batch_size = 0;
+    }
+  }
+
+  if (batch_len) {
+    read_struct_decode_batch(
+        fd, bheads_orig, &data, batch_len, batch_len >= STRUCT_DECODE_THREADED_MIN);
+  }
+
+  MEM_freeN(bheads_orig);
+  MEM_freeN(data.bheads);
+  MEM_freeN(data.decoded);
+}
+
+#endif /* USE_THREADED_STRUCT_DECODE */
+
 typedef void (*link_list_cb)(FileData *fd, void *data);
 
 static void link_list_ex(FileData *fd, ListBase *lb, link_list_cb callback) /* only direct data */
@@ -5033,7 +5450,7 @@ static void direct_link_customdata(FileData *fd, CustomData *data, int count)
       layer->flag &= ~CD_FLAG_IN_MEMORY;
     }
 
-    layer->flag &= ~CD_FLAG_NOFREE;
+    layer->flag &= ~(CD_FLAG_NOFREE | CD_FLAG_SHARED);
 
     if (CustomData_verify_versions(data, i)) {
       layer->data = newdataadr(fd, layer->data);
@@ -7879,6 +8296,7 @@ static void direct_link_windowmanager(FileData *fd, wmWindowManager *wm)
   wm->undo_stack = NULL;
 
   wm->message_bus = NULL;
+  wm->notifier_queue_set = NULL;
 
   BLI_listbase_clear(&wm->jobs);
   BLI_listbase_clear(&wm->drags);
@@ -9200,6 +9618,198 @@ static void placeholders_ensure_valid(Main *bmain)
   }
 }
 
+/**
+ * Whether the data-block starting at \a bhead isn't read because of #FileData.id_types_filter.
+ * Libraries are always read, types that can't be filtered are never read when filtering.
+ */
+static bool read_libblock_is_filtered(FileData *fd, BHead *bhead)
+{
+  if ((fd->id_types_filter == 0) ||
+      ELEM(bhead->code, DATA, DNA1, TEST, REND, GLOB, USER, ENDB, ID_LI)) {
+    return false;
+  }
+  short idcode = bhead->code;
+  if (idcode == ID_LINK_PLACEHOLDER) {
+    idcode = GS(blo_bhead_id_name(fd, bhead));
+  }
+  else if (idcode == ID_SCRN) {
+    idcode = ID_SCR;
+  }
+  return (BKE_idcode_to_idfilter(idcode) & fd->id_types_filter) == 0;
+}
+
+/**
+ * Skip a data-block filtered out by #read_libblock_is_filtered,
+ * adding a placeholder for it when requested, so pointers to it remain valid.
+ */
+static BHead *read_libblock_filtered(FileData *fd, Main *main, BHead *bhead, const int tag)
+{
+  const char *idname = blo_bhead_id_name(fd, bhead);
+  const short idcode = GS(idname);
+  if (fd->use_id_types_placeholders && BKE_idcode_to_idfilter(idcode) &&
+      which_libbase(main, idcode)) {
+    ID *ph_id = create_placeholder(main, idcode, idname + 2, tag);
+    oldnewmap_insert(fd->libmap, bhead->old, ph_id, bhead->code);
+  }
+  return blo_bhead_next(fd, bhead);
+}
+
+/* Undo: when the current state and the undo step being read share the memfile chunks of a
+ * data-block, it didn't change in between, so it's kept as is instead of being read again.
+ * This only works as long as it doesn't use any data-block which is read again,
+ * since the pointers to them would become invalid. */
+
+typedef struct UndoReuseCheckData {
+  GHash *old_ids;
+  GSet *reused_ids;
+  bool is_reusable;
+} UndoReuseCheckData;
+
+static bool read_undo_bhead_is_reusable_id(const BHead *bhead)
+{
+  return !ELEM(bhead->code,
+               DATA,
+               DNA1,
+               TEST,
+               REND,
+               GLOB,
+               USER,
+               ENDB,
+               ID_LINK_PLACEHOLDER,
+               ID_LI,
+               ID_WM,
+               ID_WS,
+               ID_SCR,
+               ID_SCRN);
+}
+
+static int read_undo_reused_id_check_cb(void *user_data,
+                                        ID *UNUSED(id_self),
+                                        ID **id_pointer,
+                                        int cb_flag)
+{
+  UndoReuseCheckData *data = user_data;
+  ID *id = *id_pointer;
+
+  /* Embedded data-blocks are part of their owner. */
+  if (id == NULL || (cb_flag & IDWALK_CB_PRIVATE)) {
+    return IDWALK_RET_NOP;
+  }
+  if (BLI_ghash_haskey(data->old_ids, id) && !BLI_gset_haskey(data->reused_ids, id)) {
+    data->is_reusable = false;
+    return IDWALK_RET_STOP_ITER;
+  }
+  return IDWALK_RET_NOP;
+}
+
+/**
+ * Find the local data-blocks of the old Main which can be reused as is,
+ * stored as #FileData.undo_reused_ids (using their address, which is also their old address).
+ */
+static void read_undo_reused_ids_find(FileData *fd)
+{
+  Main *oldmain = fd->old_mainlist->first;
+  GHash *old_ids = BLI_ghash_ptr_new(__func__);
+  GSet *reused_ids = BLI_gset_ptr_new(__func__);
+  ID *id;
+
+  FOREACH_MAIN_ID_BEGIN (oldmain, id) {
+    BLI_ghash_insert(old_ids, id, id);
+  }
+  FOREACH_MAIN_ID_END;
+
+  /* Candidates: data-blocks which were not changed. */
+  BHead *bhead = blo_bhead_first(fd);
+  while (bhead && bhead->code != ENDB) {
+    if (!read_undo_bhead_is_reusable_id(bhead)) {
+      bhead = blo_bhead_next(fd, bhead);
+      continue;
+    }
+    const BHead *bhead_id = bhead;
+    bool is_identical = BHEADN_FROM_BHEAD(bhead)->is_memchunk_identical;
+    for (bhead = blo_bhead_next(fd, bhead); bhead && bhead->code == DATA;
+         bhead = blo_bhead_next(fd, bhead)) {
+      is_identical &= BHEADN_FROM_BHEAD(bhead)->is_memchunk_identical;
+    }
+    if (!is_identical) {
+      continue;
+    }
+    ID *id_old = BLI_ghash_lookup(old_ids, bhead_id->old);
+    if (id_old == NULL || !STREQ(id_old->name, blo_bhead_id_name(fd, bhead_id))) {
+      continue;
+    }
+    /* Proxies are re-assigned to the linked objects when linking them. */
+    if (GS(id_old->name) == ID_OB && ((Object *)id_old)->proxy != NULL) {
+      continue;
+    }
+    BLI_gset_add(reused_ids, id_old);
+  }
+
+  /* Remove the data-blocks using others which are read again, until none are left. */
+  UndoReuseCheckData data = {old_ids, reused_ids, true};
+  ID **ids_remove = MEM_mallocN(sizeof(*ids_remove) * MAX2(BLI_gset_len(reused_ids), 1), __func__);
+  int ids_remove_len;
+  do {
+    ids_remove_len = 0;
+    GSET_FOREACH_BEGIN (ID *, id_iter, reused_ids) {
+      data.is_reusable = true;
+      BKE_library_foreach_ID_link(
+          NULL, id_iter, read_undo_reused_id_check_cb, &data, IDWALK_READONLY);
+      if (!data.is_reusable) {
+        ids_remove[ids_remove_len++] = id_iter;
+      }
+    }
+    GSET_FOREACH_END();
+    for (int i = 0; i < ids_remove_len; i++) {
+      BLI_gset_remove(reused_ids, ids_remove[i], NULL);
+    }
+  } while (ids_remove_len != 0);
+  MEM_freeN(ids_remove);
+
+  BLI_ghash_free(old_ids, NULL, NULL);
+
+  if (BLI_gset_len(reused_ids) == 0) {
+    BLI_gset_free(reused_ids, NULL);
+    reused_ids = NULL;
+  }
+  fd->undo_reused_ids = reused_ids;
+}
+
+/**
+ * Move a data-block found by #read_undo_reused_ids_find from the old Main,
+ * skipping its data.
+ */
+static BHead *read_libblock_undo_reuse(FileData *fd, Main *main, BHead *bhead, ID **r_id)
+{
+  Main *oldmain = fd->old_mainlist->first;
+  ID *id = (ID *)bhead->old;
+  const short idcode = GS(id->name);
+
+  BLI_remlink(which_libbase(oldmain, idcode), id);
+  BLI_addtail(which_libbase(main, idcode), id);
+  oldnewmap_insert(fd->libmap, bhead->old, id, bhead->code);
+
+  id->tag &= ~(LIB_TAG_NEED_LINK | LIB_TAG_NEW);
+  id->tag |= LIB_TAG_UNDO_OLD_ID_REUSED;
+
+  if (idcode == ID_SCE) {
+    /* The active view layer is looked up through the global map, see #link_global. */
+    LISTBASE_FOREACH (ViewLayer *, view_layer, &((Scene *)id)->view_layers) {
+      oldnewmap_insert(fd->globmap, view_layer, view_layer, 0);
+    }
+  }
+
+  if (r_id) {
+    *r_id = id;
+  }
+
+  for (bhead = blo_bhead_next(fd, bhead); bhead && bhead->code == DATA;
+       bhead = blo_bhead_next(fd, bhead)) {
+    /* pass */
+  }
+  return bhead;
+}
+
 static const char *dataname(short id_code)
 {
   switch (id_code) {
@@ -9283,6 +9893,13 @@ static BHead *read_data_into_oldnewmap(FileData *fd, BHead *bhead, const char *a
 {
   bhead = blo_bhead_next(fd, bhead);
 
+  int data_len = 0;
+  for (BHead *bhead_iter = bhead; bhead_iter && bhead_iter->code == DATA;
+       bhead_iter = blo_bhead_next(fd, bhead_iter)) {
+    data_len++;
+  }
+  oldnewmap_reserve(fd->datamap, data_len);
+
   while (bhead && bhead->code == DATA) {
     void *data;
 #if 0
@@ -9385,6 +10002,10 @@ static BHead *read_libblock(FileData *fd,
     }
   }
 
+  if (fd->undo_reused_ids && BLI_gset_haskey(fd->undo_reused_ids, bhead->old)) {
+    return read_libblock_undo_reuse(fd, main, bhead, r_id);
+  }
+
   /* read libblock */
   id = read_struct(fd, bhead, "lib block");
 
@@ -9980,6 +10601,30 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
+    /* All data-blocks are added to the library map, make room for them up-front. */
+    int id_len = 0;
+    for (BHead *bhead_iter = bhead; bhead_iter && bhead_iter->code != ENDB;
+         bhead_iter = blo_bhead_next(fd, bhead_iter)) {
+      if (!ELEM(bhead_iter->code, DATA, DNA1, TEST, REND, GLOB, USER)) {
+        id_len++;
+      }
+    }
+    oldnewmap_reserve(fd->libmap, id_len);
+
+    if (fd->memfile_current_chunks != NULL) {
+      read_undo_reused_ids_find(fd);
+      bfd->is_undo_partial = (fd->undo_reused_ids != NULL);
+    }
+  }
+
+#ifdef USE_THREADED_STRUCT_DECODE
+  /* Undo files are written with the current DNA, so there is nothing to decode. */
+  if ((fd->memfile == NULL) && ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0)) {
+    read_file_decode_structs(fd);
+  }
+#endif
+
   while (bhead) {
     switch (bhead->code) {
       case DATA:
@@ -10013,7 +10658,12 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
            * to the file format definition. So we can use the entry at the
            * end of mainlist, added in direct_link_library. */
           Main *libmain = mainlist.last;
-          bhead = read_libblock(fd, libmain, bhead, 0, true, NULL);
+          if (read_libblock_is_filtered(fd, bhead)) {
+            bhead = read_libblock_filtered(fd, libmain, bhead, LIB_TAG_EXTERN);
+          }
+          else {
+            bhead = read_libblock(fd, libmain, bhead, 0, true, NULL);
+          }
         }
         break;
       /* in 2.50+ files, the file identifier for screens is patched, forward compatibility */
@@ -10025,12 +10675,22 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
         if (fd->skip_flags & BLO_READ_SKIP_DATA) {
           bhead = blo_bhead_next(fd, bhead);
         }
+        else if (read_libblock_is_filtered(fd, bhead)) {
+          bhead = read_libblock_filtered(fd, bfd->main, bhead, LIB_TAG_LOCAL);
+        }
         else {
           bhead = read_libblock(fd, bfd->main, bhead, LIB_TAG_LOCAL, false, NULL);
         }
     }
   }
 
+#ifdef USE_THREADED_STRUCT_DECODE
+  if (fd->bhead_decoded) {
+    BLI_ghash_free(fd->bhead_decoded, NULL, MEM_freeN);
+    fd->bhead_decoded = NULL;
+  }
+#endif
+
   /* do before read_libraries, but skip undo case */
   if (fd->memfile == NULL) {
     if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
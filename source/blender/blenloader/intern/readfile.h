@@ -30,6 +30,7 @@
 #include "DNA_space_types.h"
 #include "DNA_windowmanager_types.h" /* for ReportType */
 
+struct GSet;
 struct Key;
 struct MemFile;
 struct Object;
@@ -73,14 +74,24 @@ typedef struct FileData {
 
   /** Regular file reading. */
   int filedes;
+  /** Regular file mapped into memory, see: #USE_MMAP_FILE_READ. */
+  const char *mmap_data;
+  size_t mmap_size;
 
   /** Variables needed for reading from memory / stream. */
   const char *buffer;
   /** Variables needed for reading from memfile (undo). */
   struct MemFile *memfile;
+  /** Buffers of the chunks of the memfile matching the current state (undo),
+   * data read from chunks shared with it is known to be unchanged. */
+  struct GSet *memfile_current_chunks;
+  /** Cleared when reading data from a chunk which isn't in #FileData.memfile_current_chunks. */
+  bool is_memchunk_identical;
 
   /** Variables needed for reading from file. */
   gzFile gzfiledes;
+  /** Variables needed for reading from blocked gzip file, see: blend_gzip.h. */
+  struct BlendGzipReader *gzip_reader;
   /** Gzip stream for memory decompression. */
   z_stream strm;
 
@@ -101,6 +112,10 @@ typedef struct FileData {
 
   /** Optionally skip some data-blocks when they're not needed. */
   eBLOReadSkip skip_flags;
+  /** Only read data-blocks of these types (`FILTER_ID_*`), all of them when zero. */
+  int id_types_filter;
+  /** Add placeholders for the data-blocks that are skipped by #FileData.id_types_filter. */
+  bool use_id_types_placeholders;
 
   struct OldNewMap *datamap;
   struct OldNewMap *globmap;
@@ -117,9 +132,16 @@ typedef struct FileData {
   /** See: #USE_GHASH_BHEAD. */
   struct GHash *bhead_idname_hash;
 
+  /** Blocks decoded before reading the data-blocks (#BHead to data),
+   * see: #USE_THREADED_STRUCT_DECODE. */
+  struct GHash *bhead_decoded;
+
   ListBase *mainlist;
   /** Used for undo. */
   ListBase *old_mainlist;
+  /** Data-blocks of the old Main kept as is instead of being read again (undo),
+   * see #LIB_TAG_UNDO_OLD_ID_REUSED. */
+  struct GSet *undo_reused_ids;
 
   struct ReportList *reports;
 } FileData;
@@ -135,7 +157,9 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath);
 
 FileData *blo_filedata_from_file(const char *filepath, struct ReportList *reports);
 FileData *blo_filedata_from_memory(const void *buffer, int buffersize, struct ReportList *reports);
-FileData *blo_filedata_from_memfile(struct MemFile *memfile, struct ReportList *reports);
+FileData *blo_filedata_from_memfile(struct MemFile *memfile,
+                                    const struct MemFile *memfile_current,
+                                    struct ReportList *reports);
 
 void blo_clear_proxy_pointers_from_lib(struct Main *oldmain);
 void blo_make_image_pointer_map(FileData *fd, struct Main *oldmain);
@@ -32,6 +32,7 @@
 /* open/close */
 #ifndef _WIN32
 #  include <unistd.h>
+#  include <sys/mman.h>
 #else
 #  include <io.h>
 #endif
@@ -41,6 +42,8 @@
 #include "DNA_listBase.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BLO_undofile.h"
 #include "BLO_readfile.h"
@@ -50,75 +53,276 @@
 /* keep last */
 #include "BLI_strict_flags.h"
 
+/**
+ * Allow moving the buffers of old undo steps to a file mapped in memory,
+ * so the system can page them out (see #BLO_memfile_spill).
+ */
+#ifndef _WIN32
+#  define USE_MEMFILE_SPILL
+#endif
+
 /* **************** support for memory-write, for undo buffers *************** */
 
+static bool memfile_chunk_is_spilled(const MemFile *memfile, const MemFileChunk *chunk)
+{
+  return (memfile->spill_data != NULL) && (chunk->buf >= memfile->spill_data) &&
+         (chunk->buf < memfile->spill_data + memfile->spill_size);
+}
+
 /* not memfile itself */
 void BLO_memfile_free(MemFile *memfile)
 {
   MemFileChunk *chunk;
 
   while ((chunk = BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
+    if (chunk->is_identical == false && !memfile_chunk_is_spilled(memfile, chunk)) {
       MEM_freeN((void *)chunk->buf);
     }
     MEM_freeN(chunk);
   }
   memfile->size = 0;
+
+#ifdef USE_MEMFILE_SPILL
+  if (memfile->spill_data) {
+    munmap((void *)memfile->spill_data, memfile->spill_size);
+    memfile->spill_data = NULL;
+    memfile->spill_size = 0;
+  }
+#endif
 }
 
 /* to keep list of memfiles consistent, 'first' is always first in list */
 /* result is that 'first' is being freed */
 void BLO_memfile_merge(MemFile *first, MemFile *second)
 {
-  MemFileChunk *fc, *sc;
+  /* Identical chunks may share the buffer of any chunk of the previous step,
+   * a chunk of 'second' takes over the buffers of 'first' it uses. */
+  GHash *chunk_by_buf = BLI_ghash_ptr_new(__func__);
+  LISTBASE_FOREACH (MemFileChunk *, sc, &second->chunks) {
+    void **sc_p;
+    if (sc->is_identical && !BLI_ghash_ensure_p(chunk_by_buf, (void *)sc->buf, &sc_p)) {
+      *sc_p = sc;
+    }
+  }
 
-  fc = first->chunks.first;
-  sc = second->chunks.first;
-  while (fc || sc) {
-    if (fc && sc) {
-      if (sc->is_identical) {
+  LISTBASE_FOREACH (MemFileChunk *, fc, &first->chunks) {
+    if (fc->is_identical == false) {
+      MemFileChunk *sc = BLI_ghash_popkey(chunk_by_buf, fc->buf, NULL);
+      /* Only buffers no other memory file uses are spilled. */
+      BLI_assert(sc == NULL || !memfile_chunk_is_spilled(first, fc));
+      if (sc != NULL) {
         sc->is_identical = false;
         fc->is_identical = true;
+        second->size += sc->size;
       }
     }
-    if (fc) {
-      fc = fc->next;
+  }
+  BLI_ghash_free(chunk_by_buf, NULL, NULL);
+
+  BLO_memfile_free(first);
+}
+
+/**
+ * Move the buffers only \a memfile uses to the file \a filepath mapped in memory,
+ * so they don't take memory anymore when the system is short of it.
+ * The file is removed right away, it remains available for as long as it's mapped.
+ *
+ * \param memfile_next: The next memory file in the undo history, which may share buffers
+ * of \a memfile. It's the only one that can, later ones can only share a buffer it shares too.
+ * \return the number of bytes moved out of memory.
+ *
+ * \note The buffers have to be back in memory (see #BLO_memfile_unspill)
+ * before \a memfile is used as a reference to write another memory file.
+ */
+size_t BLO_memfile_spill(MemFile *memfile, const MemFile *memfile_next, const char *filepath)
+{
+#ifdef USE_MEMFILE_SPILL
+  if (memfile->spill_data != NULL) {
+    return 0;
+  }
+
+  GSet *bufs_shared = BLI_gset_ptr_new(__func__);
+  if (memfile_next != NULL) {
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile_next->chunks) {
+      if (chunk->is_identical) {
+        BLI_gset_add(bufs_shared, (void *)chunk->buf);
+      }
+    }
+  }
+
+  /* Write the buffers owned by this memory file and not shared. */
+  GHash *buf_spilled = BLI_ghash_ptr_new(__func__);
+  size_t spill_size = 0;
+  int file = -1;
+  bool ok = true;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->is_identical || BLI_gset_haskey(bufs_shared, chunk->buf)) {
+      continue;
+    }
+    if (file == -1) {
+      file = BLI_open(filepath, O_BINARY | O_RDWR | O_CREAT | O_TRUNC, 0600);
+      if (file == -1) {
+        ok = false;
+        break;
+      }
     }
-    if (sc) {
-      sc = sc->next;
+    if ((size_t)write(file, chunk->buf, chunk->size) != chunk->size) {
+      ok = false;
+      break;
     }
+    BLI_ghash_insert(buf_spilled, (void *)chunk->buf, POINTER_FROM_UINT(0));
+    spill_size += chunk->size;
   }
+  BLI_gset_free(bufs_shared, NULL);
 
-  BLO_memfile_free(first);
+  const char *spill_data = NULL;
+  if (file != -1) {
+    if (ok && spill_size != 0) {
+      void *data = mmap(NULL, spill_size, PROT_READ, MAP_PRIVATE, file, 0);
+      if (data != MAP_FAILED) {
+        spill_data = data;
+      }
+    }
+    close(file);
+    BLI_delete(filepath, false, false);
+  }
+
+  if (spill_data == NULL) {
+    BLI_ghash_free(buf_spilled, NULL, NULL);
+    return 0;
+  }
+
+  /* Chunks are written in order, so the offsets follow the same order. */
+  size_t offset = 0;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    void **buf_p = BLI_ghash_lookup_p(buf_spilled, chunk->buf);
+    if (buf_p != NULL && chunk->is_identical == false) {
+      *buf_p = (void *)(spill_data + offset);
+      offset += chunk->size;
+    }
+  }
+  BLI_assert(offset == spill_size);
+
+  /* Identical chunks of this memory file may use the same buffers. */
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    const char *buf_new = BLI_ghash_lookup(buf_spilled, chunk->buf);
+    if (buf_new != NULL) {
+      if (chunk->is_identical == false) {
+        MEM_freeN((void *)chunk->buf);
+      }
+      chunk->buf = buf_new;
+    }
+  }
+  BLI_ghash_free(buf_spilled, NULL, NULL);
+
+  memfile->spill_data = spill_data;
+  memfile->spill_size = spill_size;
+  return spill_size;
+#else
+  UNUSED_VARS(memfile, memfile_next, filepath);
+  return 0;
+#endif
+}
+
+/* Read the buffers moved out by #BLO_memfile_spill back in memory. */
+void BLO_memfile_unspill(MemFile *memfile)
+{
+#ifdef USE_MEMFILE_SPILL
+  if (memfile->spill_data == NULL) {
+    return;
+  }
+
+  GHash *buf_loaded = BLI_ghash_ptr_new(__func__);
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->is_identical == false && memfile_chunk_is_spilled(memfile, chunk)) {
+      char *buf_new = MEM_mallocN(chunk->size, "Chunk buffer");
+      memcpy(buf_new, chunk->buf, chunk->size);
+      BLI_ghash_insert(buf_loaded, (void *)chunk->buf, buf_new);
+    }
+  }
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (memfile_chunk_is_spilled(memfile, chunk)) {
+      chunk->buf = BLI_ghash_lookup(buf_loaded, chunk->buf);
+      BLI_assert(chunk->buf != NULL);
+    }
+  }
+  BLI_ghash_free(buf_loaded, NULL, NULL);
+
+  munmap((void *)memfile->spill_data, memfile->spill_size);
+  memfile->spill_data = NULL;
+  memfile->spill_size = 0;
+#else
+  UNUSED_VARS(memfile);
+#endif
 }
 
-void memfile_chunk_add(MemFile *memfile, const char *buf, uint size, MemFileChunk **compchunk_step)
+static uint memfile_chunk_hash(const void *key)
 {
+  const MemFileChunk *chunk = key;
+  return chunk->hash;
+}
+
+static bool memfile_chunk_cmp(const void *a, const void *b)
+{
+  const MemFileChunk *chunk_a = a;
+  const MemFileChunk *chunk_b = b;
+  return (chunk_a->hash != chunk_b->hash) || (chunk_a->size != chunk_b->size) ||
+         (memcmp(chunk_a->buf, chunk_b->buf, chunk_a->size) != 0);
+}
+
+void memfile_write_init(MemFileWriteData *mem_data,
+                        MemFile *written_memfile,
+                        MemFile *reference_memfile)
+{
+  mem_data->written_memfile = written_memfile;
+  mem_data->reference_memfile = reference_memfile;
+
+  const uint chunks_len = reference_memfile ?
+                              (uint)BLI_listbase_count(&reference_memfile->chunks) :
+                              0;
+  mem_data->chunks_by_content = BLI_gset_new_ex(
+      memfile_chunk_hash, memfile_chunk_cmp, __func__, chunks_len);
+  if (reference_memfile) {
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &reference_memfile->chunks) {
+      BLI_gset_add(mem_data->chunks_by_content, chunk);
+    }
+  }
+}
+
+void memfile_write_finalize(MemFileWriteData *mem_data)
+{
+  BLI_gset_free(mem_data->chunks_by_content, NULL);
+  mem_data->chunks_by_content = NULL;
+}
+
+/**
+ * Add a chunk, sharing the buffer of an identical chunk of the reference or written memory file
+ * when there is one. Since these are found by their contents (not their position),
+ * data that moved in the file is still shared.
+ */
+void memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, uint size)
+{
+  MemFile *memfile = mem_data->written_memfile;
   MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
   curchunk->size = size;
-  curchunk->buf = NULL;
+  curchunk->buf = buf;
+  curchunk->hash = BLI_hash_mm2((const uchar *)buf, size, 0);
   curchunk->is_identical = false;
   BLI_addtail(&memfile->chunks, curchunk);
 
-  /* we compare compchunk with buf */
-  if (*compchunk_step != NULL) {
-    MemFileChunk *compchunk = *compchunk_step;
-    if (compchunk->size == curchunk->size) {
-      if (memcmp(compchunk->buf, buf, size) == 0) {
-        curchunk->buf = compchunk->buf;
-        curchunk->is_identical = true;
-      }
-    }
-    *compchunk_step = compchunk->next;
+  MemFileChunk *compchunk = BLI_gset_lookup(mem_data->chunks_by_content, curchunk);
+  if (compchunk != NULL) {
+    curchunk->buf = compchunk->buf;
+    curchunk->is_identical = true;
+    return;
   }
 
   /* not equal... */
-  if (curchunk->buf == NULL) {
-    char *buf_new = MEM_mallocN(size, "Chunk buffer");
-    memcpy(buf_new, buf, size);
-    curchunk->buf = buf_new;
-    memfile->size += size;
-  }
+  char *buf_new = MEM_mallocN(size, "Chunk buffer");
+  memcpy(buf_new, buf, size);
+  curchunk->buf = buf_new;
+  memfile->size += size;
+  BLI_gset_insert(mem_data->chunks_by_content, curchunk);
 }
 
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
@@ -127,7 +331,7 @@ struct Main *BLO_memfile_main_get(struct MemFile *memfile,
 {
   struct Main *bmain_undo = NULL;
   BlendFileData *bfd = BLO_read_from_memfile(
-      oldmain, BKE_main_blendfile_path(oldmain), memfile, BLO_READ_SKIP_NONE, NULL);
+      oldmain, BKE_main_blendfile_path(oldmain), memfile, NULL, BLO_READ_SKIP_NONE, NULL);
 
   if (bfd) {
     bmain_undo = bfd->main;
@@ -576,7 +576,7 @@ void BLO_version_defaults_userpref_blend(Main *bmain, UserDef *userdef)
 
     userdef->flag &= ~(USER_FLAG_UNUSED_4);
 
-    userdef->uiflag &= ~(USER_HEADER_FROM_PREF | USER_UIFLAG_UNUSED_12 | USER_UIFLAG_UNUSED_22);
+    userdef->uiflag &= ~(USER_HEADER_FROM_PREF | USER_GLOBALUNDO_DISK | USER_UIFLAG_UNUSED_22);
   }
 
   if (!USER_VERSION_ATLEAST(280, 41)) {
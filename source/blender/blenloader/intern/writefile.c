@@ -145,6 +145,7 @@
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_mempool.h"
+#include "BLI_trace.h"
 
 #include "BKE_action.h"
 #include "BKE_blender_version.h"
@@ -174,6 +175,7 @@
 #include "BLO_undofile.h"
 #include "BLO_writefile.h"
 
+#include "blend_gzip.h"
 #include "readfile.h"
 
 /* for SDNA_TYPE_FROM_STRUCT() macro */
@@ -200,6 +202,8 @@
 typedef enum {
   WW_WRAP_NONE = 1,
   WW_WRAP_ZLIB,
+  /** Write into a #MemFile, see: #BLO_write_file_snapshot. */
+  WW_WRAP_MEMFILE,
 } eWriteWrapType;
 
 typedef struct WriteWrap WriteWrap;
@@ -215,7 +219,8 @@ struct WriteWrap {
   /* internal */
   union {
     int file_handle;
-    gzFile gz_handle;
+    BlendGzipWriter *gzip_writer;
+    MemFileWriteData *mem_data;
   } _user_data;
 };
 
@@ -246,17 +251,17 @@ static size_t ww_write_none(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
-/* zlib */
-#define FILE_HANDLE(ww) (ww)->_user_data.gz_handle
+/* zlib (blocked gzip compressed on multiple threads, see: blend_gzip.h) */
+#define FILE_HANDLE(ww) (ww)->_user_data.gzip_writer
 
 static bool ww_open_zlib(WriteWrap *ww, const char *filepath)
 {
-  gzFile file;
+  BlendGzipWriter *gzip_writer;
 
-  file = BLI_gzopen(filepath, "wb1");
+  gzip_writer = blo_gzip_writer_open(filepath);
 
-  if (file != Z_NULL) {
-    FILE_HANDLE(ww) = file;
+  if (gzip_writer != NULL) {
+    FILE_HANDLE(ww) = gzip_writer;
     return true;
   }
   else {
@@ -265,11 +270,29 @@ static bool ww_open_zlib(WriteWrap *ww, const char *filepath)
 }
 static bool ww_close_zlib(WriteWrap *ww)
 {
-  return (gzclose(FILE_HANDLE(ww)) == Z_OK);
+  return blo_gzip_writer_close(FILE_HANDLE(ww));
 }
 static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 {
-  return gzwrite(FILE_HANDLE(ww), buf, buf_len);
+  return blo_gzip_writer_write(FILE_HANDLE(ww), buf, buf_len) ? buf_len : 0;
+}
+#undef FILE_HANDLE
+
+/* memfile */
+#define FILE_HANDLE(ww) (ww)->_user_data.mem_data
+
+static bool ww_open_memfile(WriteWrap *UNUSED(ww), const char *UNUSED(filepath))
+{
+  return true;
+}
+static bool ww_close_memfile(WriteWrap *UNUSED(ww))
+{
+  return true;
+}
+static size_t ww_write_memfile(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  memfile_chunk_add(FILE_HANDLE(ww), buf, (uint)buf_len);
+  return buf_len;
 }
 #undef FILE_HANDLE
 
@@ -287,6 +310,13 @@ static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
       r_ww->use_buf = false;
       break;
     }
+    case WW_WRAP_MEMFILE: {
+      r_ww->open = ww_open_memfile;
+      r_ww->close = ww_close_memfile;
+      r_ww->write = ww_write_memfile;
+      r_ww->use_buf = true;
+      break;
+    }
     default: {
       r_ww->open = ww_open_none;
       r_ww->close = ww_close_none;
@@ -320,12 +350,7 @@ typedef struct {
   bool error;
 
   /** #MemFile writing (used for undo). */
-  struct {
-    MemFile *current;
-    MemFile *compare;
-    /** Use to de-duplicate chunks when writing. */
-    MemFileChunk *compare_chunk;
-  } mem;
+  MemFileWriteData mem;
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
   bool use_memfile;
 
@@ -364,7 +389,7 @@ static void writedata_do_write(WriteData *wd, const void *mem, int memlen)
 
   /* memory based save */
   if (wd->use_memfile) {
-    memfile_chunk_add(wd->mem.current, mem, memlen, &wd->mem.compare_chunk);
+    memfile_chunk_add(&wd->mem, mem, memlen);
   }
   else {
     if (wd->ww->write(wd->ww, mem, memlen) != memlen) {
@@ -465,9 +490,7 @@ static WriteData *mywrite_begin(WriteWrap *ww, MemFile *compare, MemFile *curren
   WriteData *wd = writedata_new(ww);
 
   if (current != NULL) {
-    wd->mem.current = current;
-    wd->mem.compare = compare;
-    wd->mem.compare_chunk = compare ? compare->chunks.first : NULL;
+    memfile_write_init(&wd->mem, current, compare);
     wd->use_memfile = true;
   }
 
@@ -487,6 +510,10 @@ static bool mywrite_end(WriteData *wd)
     wd->buf_used_len = 0;
   }
 
+  if (wd->use_memfile) {
+    memfile_write_finalize(&wd->mem);
+  }
+
   const bool err = wd->error;
   writedata_free(wd);
 
@@ -3929,6 +3956,12 @@ static bool write_file_handle(Main *mainvar,
         if (do_override) {
           BKE_override_library_operations_store_end(override_storage, id);
         }
+
+        /* Keep every data-block in its own chunks for undo,
+         * so they're still shared with the previous step when other data-blocks change. */
+        if (wd->use_memfile) {
+          mywrite_flush(wd);
+        }
       }
 
       mywrite_flush(wd);
@@ -4015,53 +4048,21 @@ static bool do_history(const char *name, ReportList *reports)
  * \{ */
 
 /**
- * \return Success.
+ * Remap relative paths to the new file location (when requested by \a r_write_flags),
+ * returns the paths to restore with #write_file_paths_restore.
  */
-bool BLO_write_file(Main *mainvar,
-                    const char *filepath,
-                    int write_flags,
-                    ReportList *reports,
-                    const BlendThumbnail *thumb)
+static void *write_file_paths_remap(Main *mainvar, const char *filepath, int *r_write_flags)
 {
-  char tempname[FILE_MAX + 1];
-  eWriteWrapType ww_type;
-  WriteWrap ww;
-
-  /* path backup/restore */
   void *path_list_backup = NULL;
   const int path_list_flag = (BKE_BPATH_TRAVERSE_SKIP_LIBRARY | BKE_BPATH_TRAVERSE_SKIP_MULTIFILE);
 
-  if (G.debug & G_DEBUG_IO && mainvar->lock != NULL) {
-    BKE_report(reports, RPT_INFO, "Checking sanity of current .blend file *BEFORE* save to disk");
-    BLO_main_validate_libraries(mainvar, reports);
-    BLO_main_validate_shapekeys(mainvar, reports);
-  }
-
-  /* open temporary file, so we preserve the original in case we crash */
-  BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
-
-  if (write_flags & G_FILE_COMPRESS) {
-    ww_type = WW_WRAP_ZLIB;
-  }
-  else {
-    ww_type = WW_WRAP_NONE;
-  }
-
-  ww_handle_init(ww_type, &ww);
-
-  if (ww.open(&ww, tempname) == false) {
-    BKE_reportf(
-        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
-    return 0;
-  }
-
   /* check if we need to backup and restore paths */
-  if (UNLIKELY((write_flags & G_FILE_RELATIVE_REMAP) && (G_FILE_SAVE_COPY & write_flags))) {
+  if (UNLIKELY((*r_write_flags & G_FILE_RELATIVE_REMAP) && (G_FILE_SAVE_COPY & *r_write_flags))) {
     path_list_backup = BKE_bpath_list_backup(mainvar, path_list_flag);
   }
 
   /* remapping of relative paths to new file location */
-  if (write_flags & G_FILE_RELATIVE_REMAP) {
+  if (*r_write_flags & G_FILE_RELATIVE_REMAP) {
     char dir1[FILE_MAX];
     char dir2[FILE_MAX];
     BLI_split_dir_part(filepath, dir1, sizeof(dir1));
@@ -4072,7 +4073,7 @@ bool BLO_write_file(Main *mainvar,
     BLI_cleanup_dir(mainvar->name, dir2);
 
     if (G.relbase_valid && (BLI_path_cmp(dir1, dir2) == 0)) {
-      write_flags &= ~G_FILE_RELATIVE_REMAP;
+      *r_write_flags &= ~G_FILE_RELATIVE_REMAP;
     }
     else {
       if (G.relbase_valid) {
@@ -4085,40 +4086,109 @@ bool BLO_write_file(Main *mainvar,
     }
   }
 
-  if (write_flags & G_FILE_RELATIVE_REMAP) {
+  if (*r_write_flags & G_FILE_RELATIVE_REMAP) {
     /* note, making relative to something OTHER then G_MAIN->name */
     BKE_bpath_relative_convert(mainvar, filepath, NULL);
   }
 
-  /* actual file writing */
-  const bool err = write_file_handle(mainvar, &ww, NULL, NULL, write_flags, thumb);
+  return path_list_backup;
+}
 
-  ww.close(&ww);
+static void write_file_paths_restore(Main *mainvar, void *path_list_backup)
+{
+  const int path_list_flag = (BKE_BPATH_TRAVERSE_SKIP_LIBRARY | BKE_BPATH_TRAVERSE_SKIP_MULTIFILE);
 
   if (UNLIKELY(path_list_backup)) {
     BKE_bpath_list_restore(mainvar, path_list_flag, path_list_backup);
     BKE_bpath_list_free(path_list_backup);
   }
+}
 
-  if (err) {
-    BKE_report(reports, RPT_ERROR, strerror(errno));
-    remove(tempname);
-
-    return 0;
-  }
-
+/**
+ * Replace \a filepath by the temporary file it was written to.
+ * \return success.
+ */
+static bool write_file_move_from_temp(const char *tempname,
+                                      const char *filepath,
+                                      const int write_flags,
+                                      ReportList *reports)
+{
   /* file save to temporary file was successful */
   /* now do reverse file history (move .blend1 -> .blend2, .blend -> .blend1) */
   if (write_flags & G_FILE_HISTORY) {
     const bool err_hist = do_history(filepath, reports);
     if (err_hist) {
       BKE_report(reports, RPT_ERROR, "Version backup failed (file saved with @)");
-      return 0;
+      return false;
     }
   }
 
   if (BLI_rename(tempname, filepath) != 0) {
     BKE_report(reports, RPT_ERROR, "Cannot change old file (file saved with @)");
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * \return Success.
+ */
+bool BLO_write_file(Main *mainvar,
+                    const char *filepath,
+                    int write_flags,
+                    ReportList *reports,
+                    const BlendThumbnail *thumb)
+{
+  char tempname[FILE_MAX + 1];
+  eWriteWrapType ww_type;
+  WriteWrap ww;
+
+  if (G.debug & G_DEBUG_IO && mainvar->lock != NULL) {
+    BKE_report(reports, RPT_INFO, "Checking sanity of current .blend file *BEFORE* save to disk");
+    BLO_main_validate_libraries(mainvar, reports);
+    BLO_main_validate_shapekeys(mainvar, reports);
+  }
+
+  /* open temporary file, so we preserve the original in case we crash */
+  BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
+
+  if (write_flags & G_FILE_COMPRESS) {
+    ww_type = WW_WRAP_ZLIB;
+  }
+  else {
+    ww_type = WW_WRAP_NONE;
+  }
+
+  ww_handle_init(ww_type, &ww);
+
+  if (ww.open(&ww, tempname) == false) {
+    BKE_reportf(
+        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
+    return 0;
+  }
+
+  /* path backup/restore */
+  void *path_list_backup = write_file_paths_remap(mainvar, filepath, &write_flags);
+
+  /* actual file writing */
+  TraceZone zone;
+  BLI_trace_zone_begin(&zone, "Write File", "io");
+  const bool err = write_file_handle(mainvar, &ww, NULL, NULL, write_flags, thumb);
+
+  ww.close(&ww);
+  BLI_trace_zone_end(&zone);
+
+  write_file_paths_restore(mainvar, path_list_backup);
+
+  if (err) {
+    BKE_report(reports, RPT_ERROR, strerror(errno));
+    remove(tempname);
+
+    return 0;
+  }
+
+  if (!write_file_move_from_temp(tempname, filepath, write_flags, reports)) {
     return 0;
   }
 
@@ -4130,9 +4200,6 @@ bool BLO_write_file(Main *mainvar,
   return 1;
 }
 
-/**
- * \return Success.
- */
 bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags)
 {
   write_flags &= ~G_FILE_USERPREFS;
@@ -4143,3 +4210,125 @@ bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int w
 }
 
 /** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name File Writing Snapshots
+ *
+ * Split writing a file in two steps, so only the first has to be done on the main thread:
+ * - #BLO_write_file_snapshot writes the file into memory (needs access to #Main).
+ * - #BLO_write_file_snapshot_save compresses and writes it to disk, this can be done on any
+ *   thread (used for auto-save).
+ * \{ */
+
+struct BlendFileWriteSnapshot {
+  MemFile memfile;
+  char filepath[FILE_MAX];
+  int write_flags;
+};
+
+/**
+ * Write \a mainvar into memory exactly as #BLO_write_file would write it to \a filepath.
+ * \return The snapshot (to free with #BLO_write_file_snapshot_free) or NULL on failure.
+ */
+BlendFileWriteSnapshot *BLO_write_file_snapshot(Main *mainvar,
+                                                const char *filepath,
+                                                int write_flags,
+                                                ReportList *reports,
+                                                const BlendThumbnail *thumb)
+{
+  BlendFileWriteSnapshot *snapshot = MEM_callocN(sizeof(*snapshot), __func__);
+  WriteWrap ww;
+
+  MemFileWriteData mem_data;
+
+  ww_handle_init(WW_WRAP_MEMFILE, &ww);
+  memfile_write_init(&mem_data, &snapshot->memfile, NULL);
+  ww._user_data.mem_data = &mem_data;
+
+  void *path_list_backup = write_file_paths_remap(mainvar, filepath, &write_flags);
+
+  const bool err = write_file_handle(mainvar, &ww, NULL, NULL, write_flags, thumb);
+  memfile_write_finalize(&mem_data);
+
+  write_file_paths_restore(mainvar, path_list_backup);
+
+  if (err) {
+    BKE_report(reports, RPT_ERROR, "Cannot write file into memory");
+    BLO_write_file_snapshot_free(snapshot);
+    return NULL;
+  }
+
+  BLI_strncpy(snapshot->filepath, filepath, sizeof(snapshot->filepath));
+  snapshot->write_flags = write_flags;
+  return snapshot;
+}
+
+/**
+ * Snapshot of an existing memory file, such as an undo step (which may be freed meanwhile).
+ */
+BlendFileWriteSnapshot *BLO_write_file_snapshot_from_memfile(const MemFile *memfile,
+                                                             const char *filepath,
+                                                             int write_flags)
+{
+  BlendFileWriteSnapshot *snapshot = MEM_callocN(sizeof(*snapshot), __func__);
+
+  MemFileWriteData mem_data;
+  memfile_write_init(&mem_data, &snapshot->memfile, NULL);
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    memfile_chunk_add(&mem_data, chunk->buf, chunk->size);
+  }
+  memfile_write_finalize(&mem_data);
+
+  BLI_strncpy(snapshot->filepath, filepath, sizeof(snapshot->filepath));
+  snapshot->write_flags = write_flags;
+  return snapshot;
+}
+
+/**
+ * Write the snapshot to disk, doesn't access any global data so it can run on any thread.
+ * \return Success.
+ */
+bool BLO_write_file_snapshot_save(const BlendFileWriteSnapshot *snapshot, ReportList *reports)
+{
+  char tempname[FILE_MAX + 1];
+  WriteWrap ww;
+
+  /* open temporary file, so we preserve the original in case we crash */
+  BLI_snprintf(tempname, sizeof(tempname), "%s@", snapshot->filepath);
+
+  ww_handle_init((snapshot->write_flags & G_FILE_COMPRESS) ? WW_WRAP_ZLIB : WW_WRAP_NONE, &ww);
+
+  if (ww.open(&ww, tempname) == false) {
+    BKE_reportf(
+        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
+    return false;
+  }
+
+  bool err = false;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &snapshot->memfile.chunks) {
+    if (ww.write(&ww, chunk->buf, chunk->size) != chunk->size) {
+      err = true;
+      break;
+    }
+  }
+
+  if (!ww.close(&ww)) {
+    err = true;
+  }
+
+  if (err) {
+    BKE_report(reports, RPT_ERROR, strerror(errno));
+    remove(tempname);
+    return false;
+  }
+
+  return write_file_move_from_temp(tempname, snapshot->filepath, snapshot->write_flags, reports);
+}
+
+void BLO_write_file_snapshot_free(BlendFileWriteSnapshot *snapshot)
+{
+  BLO_memfile_free(&snapshot->memfile);
+  MEM_freeN(snapshot);
+}
+
+/** \} */
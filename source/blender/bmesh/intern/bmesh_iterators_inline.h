@@ -209,6 +209,37 @@ BLI_INLINE void BM_iter_parallel(BMesh *bm,
   }
 }
 
+/**
+ * \brief Parallel (threaded) iterator, also passing the index of each element.
+ *
+ * The index is the position of the element in #BM_ITER_MESH order,
+ * see #BLI_task_parallel_mempool_index.
+ */
+ATTR_NONNULL(1)
+BLI_INLINE void BM_iter_parallel_index(BMesh *bm,
+                                       const char itype,
+                                       TaskParallelMempoolIndexFunc func,
+                                       void *userdata,
+                                       const bool use_threading)
+{
+  /* inlining optimizes out this switch when called with the defined type */
+  switch ((BMIterType)itype) {
+    case BM_VERTS_OF_MESH:
+      BLI_task_parallel_mempool_index(bm->vpool, userdata, func, use_threading);
+      break;
+    case BM_EDGES_OF_MESH:
+      BLI_task_parallel_mempool_index(bm->epool, userdata, func, use_threading);
+      break;
+    case BM_FACES_OF_MESH:
+      BLI_task_parallel_mempool_index(bm->fpool, userdata, func, use_threading);
+      break;
+    default:
+      /* should never happen */
+      BLI_assert(0);
+      break;
+  }
+}
+
 #endif /* __BLI_TASK_H__ */
 
 #endif /* __BMESH_ITERATORS_INLINE_H__ */
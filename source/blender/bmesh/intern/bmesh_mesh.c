@@ -1711,6 +1711,12 @@ void bmesh_edit_end(BMesh *bm, BMOpTypeFlag type_flag)
   }
 }
 
+static void mesh_elem_index_set_cb(void *userdata, MempoolIterData *mp_ele, const int index)
+{
+  const int *index_offset = userdata;
+  BM_elem_index_set((BMElem *)mp_ele, *index_offset + index); /* set_ok */
+}
+
 void BM_mesh_elem_index_ensure_ex(BMesh *bm, const char htype, int elem_offset[4])
 {
 
@@ -1728,14 +1734,12 @@ void BM_mesh_elem_index_ensure_ex(BMesh *bm, const char htype, int elem_offset[4
 
   if (htype & BM_VERT) {
     if ((bm->elem_index_dirty & BM_VERT) || (elem_offset && elem_offset[0])) {
-      BMIter iter;
-      BMElem *ele;
-
-      int index = elem_offset ? elem_offset[0] : 0;
-      BM_ITER_MESH (ele, &iter, bm, BM_VERTS_OF_MESH) {
-        BM_elem_index_set(ele, index++); /* set_ok */
-      }
-      BLI_assert(elem_offset || index == bm->totvert);
+      int index_offset = elem_offset ? elem_offset[0] : 0;
+      BM_iter_parallel_index(bm,
+                             BM_VERTS_OF_MESH,
+                             mesh_elem_index_set_cb,
+                             &index_offset,
+                             bm->totvert >= BM_OMP_LIMIT);
     }
     else {
       // printf("%s: skipping vert index calc!\n", __func__);
@@ -1744,14 +1748,12 @@ void BM_mesh_elem_index_ensure_ex(BMesh *bm, const char htype, int elem_offset[4
 
   if (htype & BM_EDGE) {
     if ((bm->elem_index_dirty & BM_EDGE) || (elem_offset && elem_offset[1])) {
-      BMIter iter;
-      BMElem *ele;
-
-      int index = elem_offset ? elem_offset[1] : 0;
-      BM_ITER_MESH (ele, &iter, bm, BM_EDGES_OF_MESH) {
-        BM_elem_index_set(ele, index++); /* set_ok */
-      }
-      BLI_assert(elem_offset || index == bm->totedge);
+      int index_offset = elem_offset ? elem_offset[1] : 0;
+      BM_iter_parallel_index(bm,
+                             BM_EDGES_OF_MESH,
+                             mesh_elem_index_set_cb,
+                             &index_offset,
+                             bm->totedge >= BM_OMP_LIMIT);
     }
     else {
       // printf("%s: skipping edge index calc!\n", __func__);
@@ -1770,24 +1772,31 @@ void BM_mesh_elem_index_ensure_ex(BMesh *bm, const char htype, int elem_offset[4
       int index_loop = elem_offset ? elem_offset[2] : 0;
       int index = elem_offset ? elem_offset[3] : 0;
 
-      BM_ITER_MESH (ele, &iter, bm, BM_FACES_OF_MESH) {
-        if (update_face) {
-          BM_elem_index_set(ele, index++); /* set_ok */
-        }
+      if (update_face && !update_loop) {
+        BM_iter_parallel_index(
+            bm, BM_FACES_OF_MESH, mesh_elem_index_set_cb, &index, bm->totface >= BM_OMP_LIMIT);
+      }
+      else {
+        /* Loop indices depend on the size of all previous faces, keep this single threaded. */
+        BM_ITER_MESH (ele, &iter, bm, BM_FACES_OF_MESH) {
+          if (update_face) {
+            BM_elem_index_set(ele, index++); /* set_ok */
+          }
 
-        if (update_loop) {
-          BMLoop *l_iter, *l_first;
+          if (update_loop) {
+            BMLoop *l_iter, *l_first;
 
-          l_iter = l_first = BM_FACE_FIRST_LOOP((BMFace *)ele);
-          do {
-            BM_elem_index_set(l_iter, index_loop++); /* set_ok */
-          } while ((l_iter = l_iter->next) != l_first);
+            l_iter = l_first = BM_FACE_FIRST_LOOP((BMFace *)ele);
+            do {
+              BM_elem_index_set(l_iter, index_loop++); /* set_ok */
+            } while ((l_iter = l_iter->next) != l_first);
+          }
         }
-      }
 
-      BLI_assert(elem_offset || !update_face || index == bm->totface);
-      if (update_loop) {
-        BLI_assert(elem_offset || !update_loop || index_loop == bm->totloop);
+        BLI_assert(elem_offset || !update_face || index == bm->totface);
+        if (update_loop) {
+          BLI_assert(elem_offset || !update_loop || index_loop == bm->totloop);
+        }
       }
     }
     else {
@@ -40,6 +40,9 @@ struct BMeshFromMeshParams {
   uint use_shapekey : 1;
   /* define the active shape key (index + 1) */
   int active_shapekey;
+  /* Don't add layers for the shape-keys of the mesh. Evaluated meshes keep a pointer to the
+   * shape-keys of the original mesh, these layers are not needed when only evaluating. */
+  uint skip_shapekey_layers : 1;
   struct CustomData_MeshMasks cd_mask_extra;
 };
 void BM_mesh_bm_from_me(BMesh *bm, const struct Mesh *me, const struct BMeshFromMeshParams *params)
@@ -940,6 +940,76 @@ static int isect_bvhtree_point_v3(BVHTree *tree, const float **looptris, const f
   return num_isect;
 }
 
+struct TriTriOverlapData {
+  BMLoop *(*looptris)[3];
+  float eps;
+  float eps_margin;
+};
+
+/* Check whether all points of a triangle are on the same side of the plane of the other one. */
+static bool isect_tri_tri_plane_side_test(const float *tri_plane[3],
+                                          const float *tri[3],
+                                          const float dist_eps)
+{
+  float no[3];
+  if (normal_tri_v3(no, UNPACK3(tri_plane)) == 0.0f) {
+    /* Degenerate triangle, can't tell anything. */
+    return false;
+  }
+  float plane[4];
+  plane_from_point_normal_v3(plane, tri_plane[0], no);
+  const float dist[3] = {
+      dist_signed_to_plane_v3(tri[0], plane),
+      dist_signed_to_plane_v3(tri[1], plane),
+      dist_signed_to_plane_v3(tri[2], plane),
+  };
+  return ((dist[0] > dist_eps && dist[1] > dist_eps && dist[2] > dist_eps) ||
+          (dist[0] < -dist_eps && dist[1] < -dist_eps && dist[2] < -dist_eps));
+}
+
+/**
+ * Filter out pairs of overlapping bounding boxes whose triangles can't intersect,
+ * run from threads while overlapping the trees, so the (single threaded) cutting only
+ * needs to handle pairs which are likely to intersect.
+ *
+ * Must never reject a pair which #bm_isect_tri_tri would cut,
+ * so the tolerance also accounts for epsilon which is relative to the edge lengths.
+ */
+static bool bm_isect_tri_tri_overlap_cb(void *userdata,
+                                        int index_a,
+                                        int index_b,
+                                        int UNUSED(thread))
+{
+  struct TriTriOverlapData *data = userdata;
+  BMLoop **a = data->looptris[index_a];
+  BMLoop **b = data->looptris[index_b];
+  BMVert *fv_a[3] = {UNPACK3_EX(, a, ->v)};
+  BMVert *fv_b[3] = {UNPACK3_EX(, b, ->v)};
+
+  /* Triangles sharing vertices are skipped by #bm_isect_tri_tri. */
+  if (UNLIKELY(ELEM(fv_a[0], UNPACK3(fv_b)) || ELEM(fv_a[1], UNPACK3(fv_b)) ||
+               ELEM(fv_a[2], UNPACK3(fv_b)))) {
+    return false;
+  }
+
+  const float *f_a_cos[3] = {UNPACK3_EX(, fv_a, ->co)};
+  const float *f_b_cos[3] = {UNPACK3_EX(, fv_b, ->co)};
+  float len_max_sq = 0.0f;
+  for (uint i = 0; i < 3; i++) {
+    const uint i_next = (i + 1) % 3;
+    len_max_sq = max_fff(len_max_sq,
+                         len_squared_v3v3(f_a_cos[i], f_a_cos[i_next]),
+                         len_squared_v3v3(f_b_cos[i], f_b_cos[i_next]));
+  }
+  const float dist_eps = data->eps_margin + data->eps * sqrtf(len_max_sq);
+
+  if (isect_tri_tri_plane_side_test(f_a_cos, f_b_cos, dist_eps) ||
+      isect_tri_tri_plane_side_test(f_b_cos, f_a_cos, dist_eps)) {
+    return false;
+  }
+  return true;
+}
+
 #endif /* USE_BVH */
 
 /**
@@ -1090,7 +1160,18 @@ bool BM_mesh_intersect(BMesh *bm,
     flag &= ~BVH_OVERLAP_USE_THREADING;
   }
 #  endif
-  overlap = BLI_bvhtree_overlap_ex(tree_b, tree_a, &tree_overlap_tot, NULL, NULL, 0, flag);
+  struct TriTriOverlapData overlap_data = {
+      .looptris = looptris,
+      .eps = s.epsilon.eps,
+      .eps_margin = s.epsilon.eps_margin,
+  };
+  overlap = BLI_bvhtree_overlap_ex(tree_b,
+                                   tree_a,
+                                   &tree_overlap_tot,
+                                   bm_isect_tri_tri_overlap_cb,
+                                   &overlap_data,
+                                   0,
+                                   flag);
 
   if (overlap) {
     uint i;
@@ -242,12 +242,11 @@ extern "C" {
  * For witching these between the state you need to recompile blender
  *
  * \subsection multithread Multi threaded
- * Default the work-scheduler will place all work as WorkPackage in a queue.
- * For every CPUcore a working thread is created.
- * These working threads will ask the WorkScheduler if there is work
- * for a specific Device.
- * the work-scheduler will find work for the device and the device
- * will be asked to execute the WorkPackage.
+ * Default the work-scheduler will push all work for the CPU as WorkPackage in a task pool.
+ * The tasks are executed by the threads of the global task scheduler, which are shared with
+ * the rest of Blender, so the number of threads doesn't exceed the number of CPU cores.
+ * Every thread of the task scheduler has its own CPUDevice executing the WorkPackage.
+ * For every OpenCL device a working thread is created, asking the WorkScheduler for work.
  *
  * \subsection singlethread Single threaded
  * For debugging reasons the multi-threading can be disabled.
@@ -360,7 +359,7 @@ void COM_deinitialize(void);
  * \brief Clear all compositor caches. (Compositor system will still remain available).
  * To deinitialize the compositor use the COM_deinitialize method.
  */
-// void COM_clearCaches(void); // NOT YET WRITTEN
+void COM_clearCaches(void);
 
 #ifdef __cplusplus
 }
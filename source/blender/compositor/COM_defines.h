@@ -68,10 +68,11 @@ typedef enum CompositorPriority {
 
 // workscheduler threading models
 /**
- * COM_TM_QUEUE is a multi-threaded model, which uses the BLI_thread_queue pattern.
+ * COM_TM_TASK is a multi-threaded model, CPU work is executed by the global BLI_task scheduler
+ * and OpenCL work uses the BLI_thread_queue pattern with a thread per device.
  * This is the default option.
  */
-#define COM_TM_QUEUE 1
+#define COM_TM_TASK 1
 
 /**
  * COM_TM_NOTHREAD is a single threading model, everything is executed in the caller thread.
@@ -80,9 +81,9 @@ typedef enum CompositorPriority {
 #define COM_TM_NOTHREAD 0
 
 /**
- * COM_CURRENT_THREADING_MODEL can be one of the above, COM_TM_QUEUE is currently default.
+ * COM_CURRENT_THREADING_MODEL can be one of the above, COM_TM_TASK is currently default.
  */
-#define COM_CURRENT_THREADING_MODEL COM_TM_QUEUE
+#define COM_CURRENT_THREADING_MODEL COM_TM_TASK
 // chunk order
 /**
  * \brief The order of chunks to be scheduled
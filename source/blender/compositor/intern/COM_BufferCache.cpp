@@ -0,0 +1,390 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include <string.h>
+#include <typeinfo>
+
+#include "COM_BufferCache.h"
+
+#include "atomic_ops.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "DNA_camera_types.h"
+#include "DNA_color_types.h"
+#include "DNA_image_types.h"
+#include "DNA_node_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_image.h"
+#include "BKE_node.h"
+}
+
+#include "COM_CompositorContext.h"
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+#include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
+
+BufferCache::Entries BufferCache::s_entries;
+std::string BufferCache::s_view_name;
+uint8_t BufferCache::s_clear_tagged = 0;
+
+/* -------------------------------------------------------------------- */
+/** \name Hashing
+ * \{ */
+
+/* FNV-1a, keys are compared without the data they are computed from so a 64 bit hash is used to
+ * make collisions practically impossible. */
+#define COM_BUFFER_CACHE_KEY_INIT 0xcbf29ce484222325ULL
+#define COM_BUFFER_CACHE_KEY_PRIME 0x100000001b3ULL
+
+static void hash_bytes(BufferCache::Key &key, const void *data, size_t size)
+{
+  const unsigned char *bytes = (const unsigned char *)data;
+  for (size_t i = 0; i < size; i++) {
+    key ^= bytes[i];
+    key *= COM_BUFFER_CACHE_KEY_PRIME;
+  }
+}
+
+template<typename T> static void hash_value(BufferCache::Key &key, const T &value)
+{
+  hash_bytes(key, &value, sizeof(value));
+}
+
+static void hash_string(BufferCache::Key &key, const char *str)
+{
+  if (str) {
+    hash_bytes(key, str, strlen(str) + 1);
+  }
+  else {
+    hash_value(key, (char)0);
+  }
+}
+
+/* Data allocated by guarded-alloc, which is the case for all node storage and socket values. */
+static void hash_allocated(BufferCache::Key &key, const void *data)
+{
+  if (data) {
+    hash_bytes(key, data, MEM_allocN_len(data));
+  }
+}
+
+static void hash_curve_mapping(BufferCache::Key &key, const CurveMapping *cumap)
+{
+  /* The curves are copied along with the node tree, so only their points can be compared. */
+  CurveMapping cumap_data = *cumap;
+  for (int a = 0; a < CM_TOT; a++) {
+    cumap_data.cm[a].curve = NULL;
+    cumap_data.cm[a].table = NULL;
+    cumap_data.cm[a].premultable = NULL;
+  }
+  hash_value(key, cumap_data);
+
+  for (int a = 0; a < CM_TOT; a++) {
+    const CurveMap *cuma = &cumap->cm[a];
+    if (cuma->curve) {
+      hash_bytes(key, cuma->curve, sizeof(CurveMapPoint) * cuma->totpoint);
+    }
+  }
+}
+
+static void hash_node_storage(BufferCache::Key &key, const bNode *node)
+{
+  if (node->storage == NULL) {
+    return;
+  }
+
+  const char *storagename = node->typeinfo->storagename;
+  if (STREQ(storagename, "CurveMapping")) {
+    hash_curve_mapping(key, (const CurveMapping *)node->storage);
+  }
+  else if (STREQ(storagename, "NodeCryptomatte")) {
+    NodeCryptomatte cryptomatte = *(const NodeCryptomatte *)node->storage;
+    hash_string(key, cryptomatte.matte_id);
+    cryptomatte.matte_id = NULL;
+    hash_value(key, cryptomatte);
+  }
+  else {
+    hash_allocated(key, node->storage);
+  }
+}
+
+/* Defocus reads the lens and focus distance from the scene camera. */
+static void hash_scene_camera(BufferCache::Key &key, const Scene *scene)
+{
+  const Object *camera_object = scene ? scene->camera : NULL;
+  hash_value(key, camera_object);
+  if (camera_object == NULL) {
+    return;
+  }
+
+  hash_value(key, camera_object->obmat);
+  if (camera_object->type == OB_CAMERA && camera_object->data) {
+    const Camera *camera = (const Camera *)camera_object->data;
+    hash_value(key, camera->lens);
+    hash_value(key, camera->sensor_x);
+    hash_value(key, camera->sensor_y);
+    hash_value(key, camera->sensor_fit);
+    hash_value(key, camera->dof);
+    if (camera->dof.focus_object) {
+      hash_value(key, camera->dof.focus_object->obmat);
+    }
+  }
+}
+
+/* Data which changes without the node being tagged for re-execution. */
+static bool node_id_is_volatile(const ID *id)
+{
+  switch (GS(id->name)) {
+    case ID_IM: {
+      Image *image = (Image *)id;
+      if (!ELEM(image->type, IMA_TYPE_IMAGE, IMA_TYPE_MULTILAYER, IMA_TYPE_UV_TEST)) {
+        /* Render result and viewer images. */
+        return true;
+      }
+      /* Painted images. */
+      return BKE_image_is_dirty(image);
+    }
+    case ID_MSK:
+    case ID_MC:
+    case ID_TE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Keys
+ * \{ */
+
+BufferCache::Key BufferCache::determineContextKey(const CompositorContext &context)
+{
+  Key key = COM_BUFFER_CACHE_KEY_INIT;
+  const bNodeTree *editingtree = context.getbNodeTree();
+  const RenderData *rd = context.getRenderData();
+
+  hash_value(key, context.getScene());
+  hash_value(key, context.getFramenumber());
+  hash_value(key, context.getQuality());
+  hash_value(key, context.isFastCalculation());
+  hash_string(key, context.getViewName());
+  hash_value(key, rd->xsch);
+  hash_value(key, rd->ysch);
+  hash_value(key, rd->size);
+  /* Only the chunks inside the viewer border are calculated. */
+  hash_value(key, editingtree->flag & NTREE_VIEWER_BORDER);
+  if (editingtree->flag & NTREE_VIEWER_BORDER) {
+    hash_value(key, editingtree->viewer_border);
+  }
+  return key;
+}
+
+void BufferCache::determineNodeKey(Key &key,
+                                   OperationKey &result,
+                                   const bNode *node,
+                                   const Scene *scene)
+{
+  hash_value(key, node->type);
+  hash_value(key, node->custom1);
+  hash_value(key, node->custom2);
+  hash_value(key, node->custom3);
+  hash_value(key, node->custom4);
+  hash_value(key, node->flag & NODE_MUTED);
+
+  /* Node groups are localized along with the tree, their nodes are hashed on their own. */
+  if (node->id && GS(node->id->name) != ID_NT) {
+    hash_value(key, node->id);
+    hash_string(key, node->id->name);
+    if (node_id_is_volatile(node->id)) {
+      result.is_volatile = true;
+    }
+  }
+
+  hash_node_storage(key, node);
+
+  for (const bNodeSocket *sock = (const bNodeSocket *)node->inputs.first; sock;
+       sock = sock->next) {
+    hash_allocated(key, sock->default_value);
+  }
+  for (const bNodeSocket *sock = (const bNodeSocket *)node->outputs.first; sock;
+       sock = sock->next) {
+    hash_allocated(key, sock->default_value);
+  }
+
+  if (node->type == CMP_NODE_DEFOCUS) {
+    hash_scene_camera(key, node->id ? (const Scene *)node->id : scene);
+  }
+
+  if (node->need_exec) {
+    result.is_tagged = true;
+  }
+}
+
+const BufferCache::OperationKey &BufferCache::determineOperationKey(OperationKeys &keys,
+                                                                    NodeOperation *operation,
+                                                                    Key context_key,
+                                                                    const Scene *scene)
+{
+  OperationKeys::const_iterator it = keys.find(operation);
+  if (it != keys.end()) {
+    return it->second;
+  }
+
+  OperationKey result;
+  result.key = context_key;
+  result.is_tagged = false;
+  result.is_volatile = false;
+
+  const char *type_name = typeid(*operation).name();
+  hash_string(result.key, type_name);
+  hash_value(result.key, operation->getWidth());
+  hash_value(result.key, operation->getHeight());
+
+  const bNode *node = operation->getbNode();
+  if (node) {
+    determineNodeKey(result.key, result, node, scene);
+  }
+  else if (operation->isSetOperation()) {
+    /* Constants of unconnected inputs, their value can come from a node group socket. */
+    float value[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    operation->readSampled(value, 0.0f, 0.0f, COM_PS_NEAREST);
+    hash_value(result.key, value);
+  }
+
+  if (operation->isReadBufferOperation()) {
+    ReadBufferOperation *read_operation = (ReadBufferOperation *)operation;
+    NodeOperation *write_operation =
+        read_operation->getMemoryProxy()->getWriteBufferOperation();
+    const OperationKey &input = determineOperationKey(keys, write_operation, context_key, scene);
+    hash_value(result.key, input.key);
+    result.is_tagged |= input.is_tagged;
+    result.is_volatile |= input.is_volatile;
+  }
+
+  for (unsigned int index = 0; index < operation->getNumberOfInputSockets(); index++) {
+    const NodeOperationInput *socket = operation->getInputSocket(index);
+    hash_value(result.key, socket->getDataType());
+    hash_value(result.key, socket->getResizeMode());
+
+    const NodeOperationOutput *link = socket->getLink();
+    if (link == NULL) {
+      continue;
+    }
+    NodeOperation &input_operation = link->getOperation();
+    for (unsigned int output = 0; output < input_operation.getNumberOfOutputSockets(); output++) {
+      if (input_operation.getOutputSocket(output) == link) {
+        hash_value(result.key, output);
+        break;
+      }
+    }
+    const OperationKey &input = determineOperationKey(keys, &input_operation, context_key, scene);
+    hash_value(result.key, input.key);
+    result.is_tagged |= input.is_tagged;
+    result.is_volatile |= input.is_volatile;
+  }
+
+  for (unsigned int index = 0; index < operation->getNumberOfOutputSockets(); index++) {
+    hash_value(result.key, operation->getOutputSocket(index)->getDataType());
+  }
+
+  return keys[operation] = result;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Buffers
+ * \{ */
+
+void BufferCache::begin(const char *viewName)
+{
+  if (atomic_fetch_and_and_uint8(&s_clear_tagged, 0)) {
+    clear();
+  }
+
+  s_view_name = viewName ? viewName : "";
+  for (Entries::iterator it = s_entries.begin(); it != s_entries.end(); ++it) {
+    if (it->second.view_name == s_view_name) {
+      it->second.is_used = false;
+    }
+  }
+}
+
+MemoryBuffer *BufferCache::acquire(Key key)
+{
+  Entries::iterator it = s_entries.find(key);
+  if (it == s_entries.end()) {
+    return NULL;
+  }
+  MemoryBuffer *buffer = it->second.buffer;
+  s_entries.erase(it);
+  return buffer;
+}
+
+void BufferCache::store(Key key, MemoryBuffer *buffer)
+{
+  Entries::iterator it = s_entries.find(key);
+  if (it != s_entries.end()) {
+    delete it->second.buffer;
+    s_entries.erase(it);
+  }
+
+  Entry entry;
+  entry.buffer = buffer;
+  entry.view_name = s_view_name;
+  entry.is_used = true;
+  s_entries[key] = entry;
+}
+
+void BufferCache::end()
+{
+  Entries::iterator it = s_entries.begin();
+  while (it != s_entries.end()) {
+    if (it->second.view_name == s_view_name && !it->second.is_used) {
+      delete it->second.buffer;
+      s_entries.erase(it++);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+void BufferCache::clear()
+{
+  for (Entries::iterator it = s_entries.begin(); it != s_entries.end(); ++it) {
+    delete it->second.buffer;
+  }
+  s_entries.clear();
+}
+
+void BufferCache::tagClear()
+{
+  atomic_fetch_and_or_uint8(&s_clear_tagged, 1);
+}
+
+/** \} */
@@ -0,0 +1,138 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#ifndef __COM_BUFFERCACHE_H__
+#define __COM_BUFFERCACHE_H__
+
+#include <map>
+#include <string>
+
+#include "BLI_sys_types.h"
+
+struct Scene;
+struct bNode;
+
+class CompositorContext;
+class MemoryBuffer;
+class NodeOperation;
+
+/**
+ * \brief Keeps the buffers of the write buffer operations between executions of the compositor.
+ *
+ * A buffer is identified by a key hashing the operations it is calculated from: the settings
+ * of their editor nodes, their resolutions and the keys of their inputs. After changing a
+ * single node only the buffers depending on it get a new key and are calculated again.
+ *
+ * \note Only used while editing, all methods except #tagClear are called with the compositor
+ * mutex locked.
+ * \ingroup Memory
+ */
+class BufferCache {
+ public:
+  typedef uint64_t Key;
+
+  /**
+   * \brief key of the result of an operation in the current execution.
+   */
+  typedef struct OperationKey {
+    Key key;
+    /**
+     * \brief an editor node the operation depends on was tagged for re-execution
+     * (external data like a reloaded image or a new render result), the cached buffers
+     * can't be used but the new ones can be stored.
+     */
+    bool is_tagged;
+    /**
+     * \brief the operation depends on data whose changes are not tracked (masks, textures,
+     * painted images...), buffers are neither used nor stored.
+     */
+    bool is_volatile;
+  } OperationKey;
+
+  typedef std::map<NodeOperation *, OperationKey> OperationKeys;
+
+ private:
+  typedef struct Entry {
+    MemoryBuffer *buffer;
+    /** \brief the view the buffer was calculated for, entries are freed per view. */
+    std::string view_name;
+    /** \brief the buffer was used or stored during the current execution. */
+    bool is_used;
+  } Entry;
+
+  typedef std::map<Key, Entry> Entries;
+
+  static Entries s_entries;
+  static std::string s_view_name;
+  static uint8_t s_clear_tagged;
+
+  static void determineNodeKey(Key &key,
+                               OperationKey &result,
+                               const bNode *node,
+                               const Scene *scene);
+
+ public:
+  /**
+   * \brief key of everything in the context influencing all operations
+   * (frame, view, quality, viewer border...).
+   */
+  static Key determineContextKey(const CompositorContext &context);
+
+  /**
+   * \brief determine the key of an operation, the keys of its inputs are added to keys as well.
+   * \param scene: the scene of the context, used by nodes falling back to it.
+   */
+  static const OperationKey &determineOperationKey(OperationKeys &keys,
+                                                   NodeOperation *operation,
+                                                   Key context_key,
+                                                   const Scene *scene);
+
+  /**
+   * \brief start an execution of the compositor for a view.
+   * The buffers of this view which are not used until #end are freed.
+   */
+  static void begin(const char *viewName);
+
+  /**
+   * \brief take the buffer out of the cache, the caller is responsible for storing it again.
+   * \return NULL when there is no buffer for the key.
+   */
+  static MemoryBuffer *acquire(Key key);
+
+  /**
+   * \brief store a buffer, the cache takes ownership of it.
+   */
+  static void store(Key key, MemoryBuffer *buffer);
+
+  /**
+   * \brief free the buffers of the current view which were not used since #begin.
+   */
+  static void end();
+
+  /**
+   * \brief free all buffers.
+   */
+  static void clear();
+
+  /**
+   * \brief free all buffers when the next execution begins, can be called from any thread.
+   */
+  static void tagClear();
+};
+
+#endif /* __COM_BUFFERCACHE_H__ */
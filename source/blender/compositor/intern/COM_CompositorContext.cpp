@@ -26,6 +26,7 @@ CompositorContext::CompositorContext()
   this->m_rd = NULL;
   this->m_quality = COM_QUALITY_HIGH;
   this->m_hasActiveOpenCLDevices = false;
+  this->m_hasActiveGLSLDevice = false;
   this->m_fastCalculation = false;
   this->m_viewSettings = NULL;
   this->m_displaySettings = NULL;
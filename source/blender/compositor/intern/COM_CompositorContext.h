@@ -73,6 +73,11 @@ class CompositorContext {
    */
   bool m_hasActiveOpenCLDevices;
 
+  /**
+   * \brief is the GLSLDevice used for this execution
+   */
+  bool m_hasActiveGLSLDevice;
+
   /**
    * \brief Skip slow nodes
    */
@@ -235,6 +240,19 @@ class CompositorContext {
     this->m_hasActiveOpenCLDevices = hasAvtiveOpenCLDevices;
   }
 
+  /**
+   * \brief is the GLSLDevice used for this execution
+   */
+  bool getHasActiveGLSLDevice() const
+  {
+    return this->m_hasActiveGLSLDevice;
+  }
+
+  void setHasActiveGLSLDevice(bool hasActiveGLSLDevice)
+  {
+    this->m_hasActiveGLSLDevice = hasActiveGLSLDevice;
+  }
+
   /**
    * \brief get the active rendering view
    */
@@ -55,6 +55,8 @@ ExecutionGroup::ExecutionGroup()
   this->m_numberOfChunks = 0;
   this->m_initialized = false;
   this->m_openCL = false;
+  this->m_glsl = true;
+  this->m_hasGLSLOperation = false;
   this->m_singleThreaded = false;
   this->m_chunksFinished = 0;
   BLI_rcti_init(&this->m_viewerBorder, 0, 0, 0, 0);
@@ -106,6 +108,12 @@ bool ExecutionGroup::addOperation(NodeOperation *operation)
     m_openCL = operation->isOpenCL();
     m_singleThreaded = operation->isSingleThreaded();
     m_initialized = true;
+
+    /* Values are uploaded by the GLSLDevice, all other operations need a shader. */
+    if (!operation->isSetOperation()) {
+      m_glsl &= operation->isGLSL();
+      m_hasGLSLOperation = true;
+    }
   }
 
   m_operations.push_back(operation);
@@ -162,6 +170,27 @@ void ExecutionGroup::deinitExecution()
   this->m_cachedReadOperations.clear();
   this->m_bTree = NULL;
 }
+
+void ExecutionGroup::setChunksExecuted()
+{
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    this->m_chunkExecutionStates[index] = COM_ES_EXECUTED;
+  }
+}
+
+bool ExecutionGroup::isExecuted() const
+{
+  if (this->m_numberOfChunks == 0) {
+    return false;
+  }
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    if (this->m_chunkExecutionStates[index] != COM_ES_EXECUTED) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void ExecutionGroup::determineResolution(unsigned int resolution[2])
 {
   NodeOperation *operation = this->getOutputOperation();
@@ -601,6 +630,12 @@ bool ExecutionGroup::isOpenCL()
   return this->m_openCL;
 }
 
+bool ExecutionGroup::isGLSL()
+{
+  return this->m_glsl && this->m_hasGLSLOperation &&
+         this->getOutputOperation()->isWriteBufferOperation();
+}
+
 void ExecutionGroup::setViewerBorder(float xmin, float xmax, float ymin, float ymax)
 {
   NodeOperation *operation = this->getOutputOperation();
@@ -119,6 +119,13 @@ class ExecutionGroup {
    */
   bool m_openCL;
 
+  /**
+   * \brief all operations calculating pixels (not buffers and values) support GLSL
+   * \see m_hasGLSLOperation
+   */
+  bool m_glsl;
+  bool m_hasGLSLOperation;
+
   /**
    * \brief Is this Execution group SingleThreaded
    */
@@ -378,6 +385,19 @@ class ExecutionGroup {
    */
   void deinitExecution();
 
+  /**
+   * \brief mark all chunks as executed, used when the output buffer is taken from the cache.
+   * \note Only valid between initExecution and deinitExecution.
+   * \see BufferCache
+   */
+  void setChunksExecuted();
+
+  /**
+   * \brief check whether all chunks are executed, so the output buffer is complete.
+   * \note Only valid between initExecution and deinitExecution.
+   */
+  bool isExecuted() const;
+
   /**
    * \brief schedule an ExecutionGroup
    * \note this method will return when all chunks have been calculated, or the execution has
@@ -417,6 +437,12 @@ class ExecutionGroup {
    */
   bool isOpenCL();
 
+  /**
+   * \brief can this ExecutionGroup be scheduled on a GLSLDevice
+   * \see WorkScheduler.schedule
+   */
+  bool isGLSL();
+
   void setChunksize(int chunksize)
   {
     this->m_chunkSize = chunksize;
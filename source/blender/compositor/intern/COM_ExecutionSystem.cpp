@@ -32,6 +32,7 @@ extern "C" {
 #include "COM_ExecutionGroup.h"
 #include "COM_WorkScheduler.h"
 #include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
 #include "COM_Debug.h"
 
 #ifdef WITH_CXX_GUARDEDALLOC
@@ -62,6 +63,8 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
   this->m_context.setRendering(rendering);
   this->m_context.setHasActiveOpenCLDevices(WorkScheduler::hasGPUDevices() &&
                                             (editingtree->flag & NTREE_COM_OPENCL));
+  this->m_context.setHasActiveGLSLDevice(WorkScheduler::hasGLSLDevice() &&
+                                         (editingtree->flag & NTREE_COM_GLSL));
 
   this->m_context.setRenderData(rd);
   this->m_context.setViewSettings(viewSettings);
@@ -156,6 +159,7 @@ void ExecutionSystem::execute()
       operation->initExecution();
     }
   }
+  restoreCachedBuffers();
   // Connect read buffers to their write buffers
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
@@ -177,6 +181,12 @@ void ExecutionSystem::execute()
     executionGroup->setChunksize(this->m_context.getChunksize());
     executionGroup->initExecution();
   }
+  for (index = 0; index < this->m_cachedBuffers.size(); index++) {
+    const CachedBuffer &cached = this->m_cachedBuffers[index];
+    if (cached.is_cached) {
+      cached.operation->getMemoryProxy()->getExecutor()->setChunksExecuted();
+    }
+  }
 
   WorkScheduler::start(this->m_context);
 
@@ -189,6 +199,8 @@ void ExecutionSystem::execute()
   WorkScheduler::finish();
   WorkScheduler::stop();
 
+  storeCachedBuffers();
+
   editingtree->stats_draw(editingtree->sdh, TIP_("Compositing | De-initializing execution"));
   for (index = 0; index < this->m_operations.size(); index++) {
     NodeOperation *operation = this->m_operations[index];
@@ -200,6 +212,72 @@ void ExecutionSystem::execute()
   }
 }
 
+void ExecutionSystem::restoreCachedBuffers()
+{
+  /* Renders are executed once per frame, there is nothing to reuse. */
+  if (this->m_context.isRendering()) {
+    return;
+  }
+
+  const BufferCache::Key context_key = BufferCache::determineContextKey(this->m_context);
+  BufferCache::OperationKeys keys;
+
+  for (unsigned int index = 0; index < this->m_operations.size(); index++) {
+    NodeOperation *operation = this->m_operations[index];
+    if (!operation->isWriteBufferOperation()) {
+      continue;
+    }
+    WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+    MemoryProxy *memoryProxy = writeOperation->getMemoryProxy();
+    if (memoryProxy->getExecutor() == NULL) {
+      continue;
+    }
+
+    const BufferCache::OperationKey &key = BufferCache::determineOperationKey(
+        keys, writeOperation, context_key, this->m_context.getScene());
+    if (key.is_volatile) {
+      continue;
+    }
+
+    CachedBuffer cached;
+    cached.operation = writeOperation;
+    cached.key = key.key;
+    cached.is_cached = false;
+
+    MemoryBuffer *buffer = key.is_tagged ? NULL : BufferCache::acquire(key.key);
+    if (buffer) {
+      MemoryBuffer *allocated = memoryProxy->getBuffer();
+      if (buffer->getWidth() == allocated->getWidth() &&
+          buffer->getHeight() == allocated->getHeight() &&
+          buffer->get_num_channels() == allocated->get_num_channels()) {
+        memoryProxy->setBuffer(buffer);
+        cached.is_cached = true;
+      }
+      else {
+        delete buffer;
+      }
+    }
+
+    this->m_cachedBuffers.push_back(cached);
+  }
+}
+
+void ExecutionSystem::storeCachedBuffers()
+{
+  const bNodeTree *editingtree = this->m_context.getbNodeTree();
+  /* Chunks are marked as executed when breaking, even though they are incomplete. */
+  const bool breaked = editingtree->test_break && editingtree->test_break(editingtree->tbh);
+
+  for (unsigned int index = 0; index < this->m_cachedBuffers.size(); index++) {
+    const CachedBuffer &cached = this->m_cachedBuffers[index];
+    MemoryProxy *memoryProxy = cached.operation->getMemoryProxy();
+    if (cached.is_cached || (!breaked && memoryProxy->getExecutor()->isExecuted())) {
+      BufferCache::store(cached.key, memoryProxy->releaseBuffer());
+    }
+  }
+  this->m_cachedBuffers.clear();
+}
+
 void ExecutionSystem::executeGroups(CompositorPriority priority)
 {
   unsigned int index;
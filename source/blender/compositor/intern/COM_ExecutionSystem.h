@@ -25,6 +25,7 @@ class ExecutionGroup;
 #include "DNA_node_types.h"
 #include "COM_Node.h"
 #include "BKE_text.h"
+#include "COM_BufferCache.h"
 #include "COM_ExecutionGroup.h"
 #include "COM_NodeOperation.h"
 
@@ -134,6 +135,21 @@ class ExecutionSystem {
    */
   Groups m_groups;
 
+  /**
+   * \brief write buffer operation of which the result can be kept between executions
+   */
+  typedef struct CachedBuffer {
+    WriteBufferOperation *operation;
+    BufferCache::Key key;
+    /** \brief the buffer is taken from the cache, its execution group is skipped. */
+    bool is_cached;
+  } CachedBuffer;
+
+  /**
+   * \brief the buffers taken from or stored in the BufferCache, only used while editing
+   */
+  std::vector<CachedBuffer> m_cachedBuffers;
+
  private:  // methods
   /**
    * find all execution group with output nodes
@@ -189,6 +205,17 @@ class ExecutionSystem {
  private:
   void executeGroups(CompositorPriority priority);
 
+  /**
+   * \brief take the buffers of the write buffer operations from the cache when their inputs
+   * didn't change since the previous execution.
+   */
+  void restoreCachedBuffers();
+
+  /**
+   * \brief give the buffers taken from the cache back and store the newly calculated ones.
+   */
+  void storeCachedBuffers();
+
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
 
@@ -0,0 +1,321 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "COM_GLSLDevice.h"
+#include "COM_ExecutionGroup.h"
+#include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_rect.h"
+#include "BLI_utildefines.h"
+
+#include "DRW_engine.h"
+
+#include "GPU_batch.h"
+#include "GPU_framebuffer.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+#include "GPU_vertex_buffer.h"
+#include "GPU_vertex_format.h"
+
+extern char datatoc_compositor_lib_glsl[];
+extern char datatoc_compositor_vert_glsl[];
+}
+
+GLSLDevice::GLSLDevice() : Device()
+{
+  this->m_batch = NULL;
+  this->m_framebuffer = NULL;
+  this->m_inputMemoryBuffers = NULL;
+}
+
+void GLSLDevice::deinitialize()
+{
+  if (this->m_shaders.empty() && this->m_batch == NULL && this->m_framebuffer == NULL) {
+    return;
+  }
+
+  DRW_opengl_context_enable();
+  for (Shaders::iterator it = this->m_shaders.begin(); it != this->m_shaders.end(); ++it) {
+    if (it->second) {
+      GPU_shader_free(it->second);
+    }
+  }
+  this->m_shaders.clear();
+  GPU_BATCH_DISCARD_SAFE(this->m_batch);
+  GPU_FRAMEBUFFER_FREE_SAFE(this->m_framebuffer);
+  DRW_opengl_context_disable();
+}
+
+void GLSLDevice::execute(WorkPackage *work)
+{
+  const unsigned int chunkNumber = work->getChunkNumber();
+  ExecutionGroup *executionGroup = work->getExecutionGroup();
+  rcti rect;
+
+  executionGroup->determineChunkRect(&rect, chunkNumber);
+  MemoryBuffer **inputBuffers = executionGroup->getInputBuffersOpenCL(chunkNumber);
+  MemoryBuffer *outputBuffer = executionGroup->allocateOutputBuffer(chunkNumber, &rect);
+
+  DRW_opengl_context_enable();
+  GPU_blend(false);
+  GPU_depth_test(false);
+
+  if (this->m_batch == NULL) {
+    /* A triangle covering the viewport. */
+    const float pos[3][2] = {{-1.0f, -1.0f}, {3.0f, -1.0f}, {-1.0f, 3.0f}};
+    static GPUVertFormat format = {0};
+    static uint pos_id;
+    if (format.attr_len == 0) {
+      pos_id = GPU_vertformat_attr_add(&format, "pos", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+    }
+    GPUVertBuf *vbo = GPU_vertbuf_create_with_format(&format);
+    GPU_vertbuf_data_alloc(vbo, 3);
+    for (int i = 0; i < 3; i++) {
+      GPU_vertbuf_attr_set(vbo, pos_id, i, pos[i]);
+    }
+    this->m_batch = GPU_batch_create_ex(GPU_PRIM_TRIS, vbo, NULL, GPU_BATCH_OWNS_VBO);
+  }
+
+  this->m_inputMemoryBuffers = inputBuffers;
+  executionGroup->getOutputOperation()->executeGLSLRegion(
+      this, &rect, chunkNumber, inputBuffers, outputBuffer);
+  this->m_inputMemoryBuffers = NULL;
+
+  freeBuffers();
+  GPU_framebuffer_restore();
+  DRW_opengl_context_disable();
+
+  delete outputBuffer;
+
+  executionGroup->finalizeChunkExecution(chunkNumber, inputBuffers);
+}
+
+GPUShader *GLSLDevice::getShader(const char *name, const char *fragcode, const char *defines)
+{
+  Shaders::iterator it = this->m_shaders.find(name);
+  if (it != this->m_shaders.end()) {
+    return it->second;
+  }
+
+  GPUShader *shader = GPU_shader_create(
+      datatoc_compositor_vert_glsl, fragcode, NULL, datatoc_compositor_lib_glsl, defines, name);
+  if (shader == NULL) {
+    printf("Compositor: failed to compile GLSL shader %s\n", name);
+  }
+  /* Failed shaders are stored as well, so they are not compiled for every chunk. */
+  this->m_shaders[name] = shader;
+  return shader;
+}
+
+GLSLBuffer *GLSLDevice::createBuffer(const rcti *rect,
+                                     int num_channels,
+                                     const float *pixels,
+                                     bool single)
+{
+  const int width = single ? 1 : BLI_rcti_size_x(rect);
+  const int height = single ? 1 : BLI_rcti_size_y(rect);
+  const eGPUTextureFormat format = (num_channels == 1) ? GPU_R32F : GPU_RGBA32F;
+
+  /* There is no three channel float format, vectors are stored with a fourth channel. */
+  float *pixels_rgba = NULL;
+  if (num_channels == 3 && pixels) {
+    const int size = width * height;
+    pixels_rgba = (float *)MEM_mallocN(sizeof(float) * 4 * size, __func__);
+    for (int index = 0; index < size; index++) {
+      copy_v3_v3(&pixels_rgba[index * 4], &pixels[index * 3]);
+      pixels_rgba[index * 4 + 3] = 1.0f;
+    }
+    pixels = pixels_rgba;
+  }
+
+  GPUTexture *texture = GPU_texture_create_nD(
+      width, height, 0, 2, pixels, format, GPU_DATA_FLOAT, 0, false, NULL);
+  if (pixels_rgba) {
+    MEM_freeN(pixels_rgba);
+  }
+  if (texture == NULL) {
+    return NULL;
+  }
+  GPU_texture_filter_mode(texture, false);
+
+  GLSLBuffer *buffer = (GLSLBuffer *)MEM_mallocN(sizeof(GLSLBuffer), __func__);
+  buffer->texture = texture;
+  buffer->rect = *rect;
+  buffer->is_single_value = single;
+  this->m_temporary_buffers.push_back(buffer);
+  return buffer;
+}
+
+void GLSLDevice::freeBuffers()
+{
+  for (unsigned int index = 0; index < this->m_temporary_buffers.size(); index++) {
+    GLSLBuffer *buffer = this->m_temporary_buffers[index];
+    if (buffer->texture) {
+      GPU_texture_free(buffer->texture);
+    }
+    MEM_freeN(buffer);
+  }
+  this->m_temporary_buffers.clear();
+  this->m_buffers.clear();
+}
+
+const GLSLBuffer *GLSLDevice::getInputBuffer(NodeOperation *operation, const rcti *rect)
+{
+  /* Operations used by multiple inputs are calculated once, all pixel operations are calculated
+   * over the chunk and buffers have the area read by the group. */
+  Buffers::iterator it = this->m_buffers.find(operation);
+  if (it != this->m_buffers.end()) {
+    return it->second;
+  }
+
+  const GLSLBuffer *buffer = NULL;
+  if (operation->isReadBufferOperation()) {
+    ReadBufferOperation *readOperation = (ReadBufferOperation *)operation;
+    MemoryProxy *memoryProxy = readOperation->getMemoryProxy();
+    const bool single = memoryProxy->getWriteBufferOperation()->isSingleValue();
+    /* Single values are stored at (0,0) of the whole buffer. */
+    MemoryBuffer *memoryBuffer = single ?
+                                     memoryProxy->getBuffer() :
+                                     readOperation->getInputMemoryBuffer(
+                                         this->m_inputMemoryBuffers);
+    buffer = createBuffer(memoryBuffer->getRect(),
+                          memoryBuffer->get_num_channels(),
+                          memoryBuffer->getBuffer(),
+                          single);
+  }
+  else if (operation->isSetOperation()) {
+    float value[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    operation->readSampled(value, 0.0f, 0.0f, COM_PS_NEAREST);
+    buffer = createBuffer(rect, 4, value, true);
+  }
+  else {
+    buffer = operation->executeGLSL(this, rect);
+  }
+
+  if (buffer) {
+    this->m_buffers[operation] = buffer;
+  }
+  return buffer;
+}
+
+GPUTexture *GLSLDevice::createDataTexture(int width, int num_channels, const float *pixels)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, width, 0, 1);
+  GLSLBuffer *buffer = createBuffer(&rect, num_channels, pixels, false);
+  return buffer ? buffer->texture : NULL;
+}
+
+void GLSLDevice::bindTexture(GPUShader *shader, const char *name, int slot, GPUTexture *texture)
+{
+  BoundTexture bound;
+  bound.texture = texture;
+  bound.location = GPU_shader_get_uniform_ensure(shader, name);
+  bound.slot = slot;
+  this->m_bound_textures.push_back(bound);
+}
+
+void GLSLDevice::unbindTextures()
+{
+  for (unsigned int index = 0; index < this->m_bound_textures.size(); index++) {
+    GPU_texture_unbind(this->m_bound_textures[index].texture);
+  }
+  this->m_bound_textures.clear();
+}
+
+void GLSLDevice::bindInput(GPUShader *shader,
+                           const char *name,
+                           int slot,
+                           const GLSLBuffer *buffer)
+{
+  bindTexture(shader, name, slot, buffer->texture);
+
+  /* An empty area makes read_input return the single value everywhere. */
+  const int area[4] = {
+      buffer->rect.xmin,
+      buffer->rect.ymin,
+      buffer->is_single_value ? 0 : BLI_rcti_size_x(&buffer->rect),
+      buffer->is_single_value ? 0 : BLI_rcti_size_y(&buffer->rect),
+  };
+  std::string area_name = std::string(name) + "_area";
+  GPU_shader_uniform_vector_int(
+      shader, GPU_shader_get_uniform_ensure(shader, area_name.c_str()), 4, 1, area);
+}
+
+const GLSLBuffer *GLSLDevice::drawBuffer(GPUShader *shader, const rcti *rect, DataType datatype)
+{
+  /* Three channel textures can't be rendered to, vectors are stored in four channels. */
+  GLSLBuffer *buffer = createBuffer(rect, datatype == COM_DT_VALUE ? 1 : 4, NULL, false);
+  if (buffer) {
+    for (unsigned int index = 0; index < this->m_bound_textures.size(); index++) {
+      const BoundTexture &bound = this->m_bound_textures[index];
+      GPU_texture_bind(bound.texture, bound.slot);
+      GPU_shader_uniform_texture(shader, bound.location, bound.texture);
+    }
+
+    const int offset[2] = {rect->xmin, rect->ymin};
+    GPU_shader_uniform_vector_int(
+        shader, GPU_shader_get_uniform_ensure(shader, "output_offset"), 2, 1, offset);
+
+    if (this->m_framebuffer == NULL) {
+      this->m_framebuffer = GPU_framebuffer_create();
+    }
+    GPU_framebuffer_texture_attach(this->m_framebuffer, buffer->texture, 0, 0);
+    GPU_framebuffer_bind(this->m_framebuffer);
+
+    GPU_batch_program_set_shader(this->m_batch, shader);
+    GPU_batch_draw(this->m_batch);
+  }
+
+  unbindTextures();
+  GPU_shader_unbind();
+  return buffer;
+}
+
+void GLSLDevice::readBuffer(const GLSLBuffer *buffer, MemoryBuffer *memoryBuffer)
+{
+  /* Detach the texture so it is not being rendered to while reading. */
+  GPU_framebuffer_restore();
+
+  BLI_assert(!buffer->is_single_value && BLI_rcti_compare(&buffer->rect, memoryBuffer->getRect()));
+
+  float *pixels = (float *)GPU_texture_read(buffer->texture, GPU_DATA_FLOAT, 0);
+  const int texture_channels = GPU_texture_format(buffer->texture) == GPU_R32F ? 1 : 4;
+  const int num_channels = memoryBuffer->get_num_channels();
+  const int size = memoryBuffer->getWidth() * memoryBuffer->getHeight();
+  float *output = memoryBuffer->getBuffer();
+
+  if (texture_channels == num_channels) {
+    memcpy(output, pixels, sizeof(float) * size * num_channels);
+  }
+  else {
+    for (int index = 0; index < size; index++) {
+      copy_v3_v3(&output[index * num_channels], &pixels[index * texture_channels]);
+    }
+  }
+
+  MEM_freeN(pixels);
+}
@@ -0,0 +1,145 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+class GLSLDevice;
+
+#ifndef __COM_GLSLDEVICE_H__
+#define __COM_GLSLDEVICE_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "COM_Device.h"
+#include "COM_NodeOperation.h"
+
+struct GPUBatch;
+struct GPUFrameBuffer;
+struct GPUShader;
+struct GPUTexture;
+
+/**
+ * \brief result of an operation calculated by a GLSLDevice.
+ * The texture contains the pixels of rect, single values are stored in a texture of one pixel
+ * which is read at every coordinate.
+ */
+typedef struct GLSLBuffer {
+  GPUTexture *texture;
+  rcti rect;
+  bool is_single_value;
+} GLSLBuffer;
+
+/**
+ * \brief device calculating execution groups with GLSL shaders on the GPU of the draw manager.
+ *
+ * Every operation of the group calculates its result into a texture by drawing a shader over the
+ * chunk, its inputs are calculated the same way so the intermediate results of the group never
+ * leave the GPU. Only the inputs of the group are uploaded and the output read back.
+ *
+ * Shaders have access to the functions of `compositor_lib.glsl`, every input is bound by
+ * #bindInput as a sampler and an `ivec4 <name>_area` uniform used by `read_input`.
+ */
+class GLSLDevice : public Device {
+ private:
+  typedef std::map<std::string, GPUShader *> Shaders;
+  typedef std::map<NodeOperation *, const GLSLBuffer *> Buffers;
+
+  typedef struct BoundTexture {
+    GPUTexture *texture;
+    int location;
+    int slot;
+  } BoundTexture;
+
+  Shaders m_shaders;
+  GPUBatch *m_batch;
+  GPUFrameBuffer *m_framebuffer;
+
+  /**
+   * \brief buffers calculated for the chunk being executed, freed at the end of the chunk.
+   */
+  Buffers m_buffers;
+  std::vector<GLSLBuffer *> m_temporary_buffers;
+  /**
+   * \brief textures of the shader being drawn, creating textures can change the bound ones so
+   * they are only bound by #drawBuffer.
+   */
+  std::vector<BoundTexture> m_bound_textures;
+  MemoryBuffer **m_inputMemoryBuffers;
+
+  GLSLBuffer *createBuffer(const rcti *rect, int num_channels, const float *pixels, bool single);
+  void unbindTextures();
+  void freeBuffers();
+
+ public:
+  GLSLDevice();
+
+  /**
+   * \brief free the shaders, needs the GPU context of the draw manager to be available.
+   */
+  void deinitialize();
+
+  /**
+   * \brief execute a WorkPackage
+   * \param work: the WorkPackage to execute
+   */
+  void execute(WorkPackage *work);
+
+  /**
+   * \brief get a shader, compiled the first time it is requested.
+   * \param name: unique name of the shader, including its defines.
+   * \return NULL when the shader failed to compile.
+   */
+  GPUShader *getShader(const char *name, const char *fragcode, const char *defines = NULL);
+
+  /**
+   * \brief get the result of an operation over rect.
+   * Read buffers and set operations are uploaded, other operations are calculated with
+   * NodeOperation.executeGLSL. The result is owned by the device.
+   * \note call before binding the shader using the result.
+   */
+  const GLSLBuffer *getInputBuffer(NodeOperation *operation, const rcti *rect);
+
+  /**
+   * \brief create a texture for data needed by a shader (weights, curves...)
+   * which is freed at the end of the chunk.
+   */
+  GPUTexture *createDataTexture(int width, int num_channels, const float *pixels);
+
+  /**
+   * \brief bind a buffer to the sampler `name` of the shader, the shader must be bound.
+   */
+  void bindInput(GPUShader *shader, const char *name, int slot, const GLSLBuffer *buffer);
+  void bindTexture(GPUShader *shader, const char *name, int slot, GPUTexture *texture);
+
+  /**
+   * \brief draw the bound shader over rect into a new buffer.
+   * \param datatype: the type of the result.
+   */
+  const GLSLBuffer *drawBuffer(GPUShader *shader, const rcti *rect, DataType datatype);
+
+  /**
+   * \brief copy the pixels of a buffer to a MemoryBuffer with the same rect.
+   */
+  void readBuffer(const GLSLBuffer *buffer, MemoryBuffer *memoryBuffer);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:GLSLDevice")
+#endif
+};
+
+#endif
@@ -253,6 +253,31 @@ class MemoryBuffer {
     }
   }
 
+  /**
+   * \brief read a row of pixels, pixels outside of the buffer are zero
+   */
+  inline void readRow(float *result, int x, int y, int width)
+  {
+    const int x_begin = max_ii(x, m_rect.xmin);
+    const int x_end = min_ii(x + width, m_rect.xmax);
+    if (y < m_rect.ymin || y >= m_rect.ymax || x_begin >= x_end) {
+      memset(result, 0, sizeof(float) * width * this->m_num_channels);
+      return;
+    }
+
+    const int num_before = x_begin - x;
+    const int num_inside = x_end - x_begin;
+    const int num_after = width - num_before - num_inside;
+    const int offset = (this->m_width * (y - m_rect.ymin) + (x_begin - m_rect.xmin)) *
+                       this->m_num_channels;
+
+    memset(result, 0, sizeof(float) * num_before * this->m_num_channels);
+    result += num_before * this->m_num_channels;
+    memcpy(result, &this->m_buffer[offset], sizeof(float) * num_inside * this->m_num_channels);
+    result += num_inside * this->m_num_channels;
+    memset(result, 0, sizeof(float) * num_after * this->m_num_channels);
+  }
+
   inline void readNoCheck(float *result,
                           int x,
                           int y,
@@ -111,6 +111,17 @@ class MemoryProxy {
    */
   void free();
 
+  /**
+   * \brief use an existing buffer instead of the allocated memory
+   * \note the buffer must have the size of the allocated memory.
+   */
+  void setBuffer(MemoryBuffer *buffer);
+
+  /**
+   * \brief take the ownership of the allocated memory, it is not freed by the proxy anymore.
+   */
+  MemoryBuffer *releaseBuffer();
+
   /**
    * \brief get the allocated memory
    */
@@ -36,7 +36,9 @@ NodeOperation::NodeOperation()
   this->m_height = 0;
   this->m_isResolutionSet = false;
   this->m_openCL = false;
+  this->m_glsl = false;
   this->m_btree = NULL;
+  this->m_bnode = NULL;
 }
 
 NodeOperation::~NodeOperation()
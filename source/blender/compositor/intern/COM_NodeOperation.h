@@ -40,6 +40,9 @@ using std::list;
 using std::max;
 using std::min;
 
+struct GLSLBuffer;
+
+class GLSLDevice;
 class OpenCLDevice;
 class ReadBufferOperation;
 class WriteBufferOperation;
@@ -105,6 +108,12 @@ class NodeOperation : public SocketReader {
    */
   bool m_openCL;
 
+  /**
+   * \brief can this operation be calculated by GLSLDevice
+   * \see NodeOperation.executeGLSL
+   */
+  bool m_glsl;
+
   /**
    * \brief mutex reference for very special node initializations
    * \note only use when you really know what you are doing.
@@ -121,6 +130,13 @@ class NodeOperation : public SocketReader {
    */
   const bNodeTree *m_btree;
 
+  /**
+   * \brief editor node this operation is created for, NULL for internal operations.
+   * Used to identify the results of the operation between executions.
+   * \see BufferCache
+   */
+  const bNode *m_bnode;
+
   /**
    * \brief set to truth when resolution for this operation is set
    */
@@ -190,6 +206,14 @@ class NodeOperation : public SocketReader {
   {
     this->m_btree = tree;
   }
+  void setbNode(const bNode *node)
+  {
+    this->m_bnode = node;
+  }
+  const bNode *getbNode() const
+  {
+    return this->m_bnode;
+  }
   virtual void initExecution();
 
   /**
@@ -246,6 +270,37 @@ class NodeOperation : public SocketReader {
                              list<cl_kernel> * /*clKernelsToCleanUp*/)
   {
   }
+
+  /**
+   * \brief when a chunk is executed by a GLSLDevice, this method is called
+   * \ingroup execution
+   * \note this method is only implemented in WriteBufferOperation
+   * \param device: the device the chunk is executed on, its GPU context is active
+   * \param rect: the rectangle of the chunk (location and size)
+   * \param chunkNumber: the chunkNumber to be calculated
+   * \param memoryBuffers: all input MemoryBuffer's needed
+   * \param outputBuffer: the outputbuffer to write to
+   */
+  virtual void executeGLSLRegion(GLSLDevice * /*device*/,
+                                 rcti * /*rect*/,
+                                 unsigned int /*chunkNumber*/,
+                                 MemoryBuffer ** /*memoryBuffers*/,
+                                 MemoryBuffer * /*outputBuffer*/)
+  {
+  }
+
+  /**
+   * \brief calculate the result of this operation over rect on the GPU.
+   * \ingroup execution
+   * The inputs are requested with GLSLDevice.getInputBuffer, then a shader is bound and drawn
+   * with GLSLDevice.drawBuffer.
+   * \return the result owned by the device, NULL when it can't be calculated and the chunk is
+   * calculated on the CPU instead.
+   */
+  virtual const GLSLBuffer *executeGLSL(GLSLDevice * /*device*/, const rcti * /*rect*/)
+  {
+    return NULL;
+  }
   virtual void deinitExecution();
 
   bool isResolutionSet()
@@ -346,6 +401,15 @@ class NodeOperation : public SocketReader {
     return this->m_openCL;
   }
 
+  /**
+   * \brief can this NodeOperation be calculated by a GLSLDevice
+   * \see ExecutionGroup.isGLSL
+   */
+  bool isGLSL() const
+  {
+    return this->m_glsl;
+  }
+
   virtual bool isViewerOperation() const
   {
     return false;
@@ -423,6 +487,14 @@ class NodeOperation : public SocketReader {
     this->m_openCL = openCL;
   }
 
+  /**
+   * \brief set if this NodeOperation can be calculated by a GLSLDevice
+   */
+  void setGLSL(bool glsl)
+  {
+    this->m_glsl = glsl;
+  }
+
   /* allow the DebugInfo class to look at internals */
   friend class DebugInfo;
 
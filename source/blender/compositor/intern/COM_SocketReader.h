@@ -94,6 +94,26 @@ class SocketReader {
   {
   }
 
+  /**
+   * \brief calculate a row of pixels using nearest sampling
+   * \note operations can override this to calculate the whole row in a single loop, instead of
+   * a virtual call for every pixel
+   * \param output: is a float array to store width pixels of num_channels floats
+   * \param x: the x-coordinate of the first pixel to calculate in image space
+   * \param y: the y-coordinate of the row to calculate in image space
+   * \param width: the number of pixels to calculate
+   * \param num_channels: the number of channels of the output
+   */
+  virtual void executeRow(float *output, int x, int y, int width, int num_channels)
+  {
+    /* Pixels are calculated as float[4], don't write past the end of the row. */
+    float pixel[4];
+    for (int i = 0; i < width; i++, output += num_channels) {
+      executePixelSampled(pixel, x + i, y, COM_PS_NEAREST);
+      memcpy(output, pixel, sizeof(float) * num_channels);
+    }
+  }
+
  public:
   inline void readSampled(float result[4], float x, float y, PixelSampler sampler)
   {
@@ -107,6 +127,10 @@ class SocketReader {
   {
     executePixelFiltered(result, x, y, dx, dy);
   }
+  inline void readRow(float *result, int x, int y, int width, int num_channels)
+  {
+    executeRow(result, x, y, width, num_channels);
+  }
 
   virtual void *initializeTileData(rcti * /*rect*/)
   {
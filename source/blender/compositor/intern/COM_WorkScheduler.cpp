@@ -22,6 +22,7 @@
 #include "COM_compositor.h"
 #include "COM_WorkScheduler.h"
 #include "COM_CPUDevice.h"
+#include "COM_GLSLDevice.h"
 #include "COM_OpenCLDevice.h"
 #include "COM_OpenCLKernels.cl.h"
 #include "clew.h"
@@ -30,6 +31,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "PIL_time.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_global.h"
@@ -38,23 +40,28 @@
 #  ifndef DEBUG /* test this so we dont get warnings in debug builds */
 #    warning COM_CURRENT_THREADING_MODEL COM_TM_NOTHREAD is activated. Use only for debugging.
 #  endif
-#elif COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 /* do nothing - default */
 #else
 #  error COM_CURRENT_THREADING_MODEL No threading model selected
 #endif
 
-/// \brief list of all CPUDevices. for every hardware thread an instance of CPUDevice is created
+/// \brief list of all CPUDevices. for every thread of the task scheduler an instance of CPUDevice
+/// is created, indexed by the thread id of the task.
 static vector<CPUDevice *> g_cpudevices;
 static ThreadLocal(CPUDevice *) g_thread_device;
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-/// \brief list of all thread for every CPUDevice in cpudevices a thread exists
-static ListBase g_cputhreads;
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 static bool g_cpuInitialized = false;
 /// \brief all scheduled work for the cpu
-static ThreadQueue *g_cpuqueue;
+static TaskPool *g_cpupool;
 static ThreadQueue *g_gpuqueue;
+/// \brief device calculating on the GPU of the draw manager, it has a single thread since the
+/// GPU context can be active in one thread at a time
+static GLSLDevice *g_glsldevice = NULL;
+static ListBase g_glslthreads;
+static ThreadQueue *g_glslqueue;
+static bool g_glslActive = false;
 #  ifdef COM_OPENCL_ENABLED
 static cl_context g_context;
 static cl_program g_program;
@@ -71,13 +78,24 @@ static bool g_openclInitialized = false;
 #  endif
 #endif
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-void *WorkScheduler::thread_execute_cpu(void *data)
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+void WorkScheduler::thread_execute_cpu(TaskPool *__restrict /*pool*/,
+                                       void *taskdata,
+                                       int threadid)
 {
-  CPUDevice *device = (CPUDevice *)data;
-  WorkPackage *work;
+  CPUDevice *device = g_cpudevices[threadid];
+  WorkPackage *work = (WorkPackage *)taskdata;
   BLI_thread_local_set(g_thread_device, device);
-  while ((work = (WorkPackage *)BLI_thread_queue_pop(g_cpuqueue))) {
+  device->execute(work);
+  delete work;
+}
+
+void *WorkScheduler::thread_execute_gpu(void *data)
+{
+  Device *device = (Device *)data;
+  WorkPackage *work;
+
+  while ((work = (WorkPackage *)BLI_thread_queue_pop(g_gpuqueue))) {
     device->execute(work);
     delete work;
   }
@@ -85,12 +103,12 @@ void *WorkScheduler::thread_execute_cpu(void *data)
   return NULL;
 }
 
-void *WorkScheduler::thread_execute_gpu(void *data)
+void *WorkScheduler::thread_execute_glsl(void *data)
 {
   Device *device = (Device *)data;
   WorkPackage *work;
 
-  while ((work = (WorkPackage *)BLI_thread_queue_pop(g_gpuqueue))) {
+  while ((work = (WorkPackage *)BLI_thread_queue_pop(g_glslqueue))) {
     device->execute(work);
     delete work;
   }
@@ -106,31 +124,39 @@ void WorkScheduler::schedule(ExecutionGroup *group, int chunkNumber)
   CPUDevice device(0);
   device.execute(package);
   delete package;
-#elif COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  if (group->isGLSL() && g_glslActive) {
+    BLI_thread_queue_push(g_glslqueue, package);
+    return;
+  }
 #  ifdef COM_OPENCL_ENABLED
   if (group->isOpenCL() && g_openclActive) {
     BLI_thread_queue_push(g_gpuqueue, package);
   }
   else {
-    BLI_thread_queue_push(g_cpuqueue, package);
+    BLI_task_pool_push(g_cpupool, thread_execute_cpu, package, false, TASK_PRIORITY_HIGH);
   }
 #  else
-  BLI_thread_queue_push(g_cpuqueue, package);
+  BLI_task_pool_push(g_cpupool, thread_execute_cpu, package, false, TASK_PRIORITY_HIGH);
 #  endif
 #endif
 }
 
 void WorkScheduler::start(CompositorContext &context)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-  unsigned int index;
-  g_cpuqueue = BLI_thread_queue_init();
-  BLI_threadpool_init(&g_cputhreads, thread_execute_cpu, g_cpudevices.size());
-  for (index = 0; index < g_cpudevices.size(); index++) {
-    Device *device = g_cpudevices[index];
-    BLI_threadpool_insert(&g_cputhreads, device);
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  g_cpupool = BLI_task_pool_create(BLI_task_scheduler_get(), NULL);
+  if (context.getHasActiveGLSLDevice()) {
+    g_glslqueue = BLI_thread_queue_init();
+    BLI_threadpool_init(&g_glslthreads, thread_execute_glsl, 1);
+    BLI_threadpool_insert(&g_glslthreads, g_glsldevice);
+    g_glslActive = true;
+  }
+  else {
+    g_glslActive = false;
   }
 #  ifdef COM_OPENCL_ENABLED
+  unsigned int index;
   if (context.getHasActiveOpenCLDevices()) {
     g_gpuqueue = BLI_thread_queue_init();
     BLI_threadpool_init(&g_gputhreads, thread_execute_gpu, g_gpudevices.size());
@@ -148,27 +174,30 @@ void WorkScheduler::start(CompositorContext &context)
 }
 void WorkScheduler::finish()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 #  ifdef COM_OPENCL_ENABLED
   if (g_openclActive) {
     BLI_thread_queue_wait_finish(g_gpuqueue);
-    BLI_thread_queue_wait_finish(g_cpuqueue);
   }
-  else {
-    BLI_thread_queue_wait_finish(g_cpuqueue);
-  }
-#  else
-  BLI_thread_queue_wait_finish(cpuqueue);
 #  endif
+  if (g_glslActive) {
+    BLI_thread_queue_wait_finish(g_glslqueue);
+  }
+  BLI_task_pool_work_and_wait(g_cpupool);
 #endif
 }
 void WorkScheduler::stop()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-  BLI_thread_queue_nowait(g_cpuqueue);
-  BLI_threadpool_end(&g_cputhreads);
-  BLI_thread_queue_free(g_cpuqueue);
-  g_cpuqueue = NULL;
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  BLI_task_pool_free(g_cpupool);
+  g_cpupool = NULL;
+  if (g_glslActive) {
+    BLI_thread_queue_nowait(g_glslqueue);
+    BLI_threadpool_end(&g_glslthreads);
+    BLI_thread_queue_free(g_glslqueue);
+    g_glslqueue = NULL;
+    g_glslActive = false;
+  }
 #  ifdef COM_OPENCL_ENABLED
   if (g_openclActive) {
     BLI_thread_queue_nowait(g_gpuqueue);
@@ -182,7 +211,7 @@ void WorkScheduler::stop()
 
 bool WorkScheduler::hasGPUDevices()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 #  ifdef COM_OPENCL_ENABLED
   return g_gpudevices.size() > 0;
 #  else
@@ -193,7 +222,16 @@ bool WorkScheduler::hasGPUDevices()
 #endif
 }
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+bool WorkScheduler::hasGLSLDevice()
+{
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  return g_glsldevice != NULL;
+#else
+  return false;
+#endif
+}
+
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 static void CL_CALLBACK clContextError(const char *errinfo,
                                        const void * /*private_info*/,
                                        size_t /*cb*/,
@@ -203,9 +241,13 @@ static void CL_CALLBACK clContextError(const char *errinfo,
 }
 #endif
 
-void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
+void WorkScheduler::initialize(bool use_opencl, bool use_glsl, int /*num_cpu_threads*/)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  /* One device for every thread id of the task scheduler, including the thread waiting for
+   * the tasks which has thread id 0. */
+  const int num_cpu_threads = BLI_task_scheduler_num_threads(BLI_task_scheduler_get());
+
   /* deinitialize if number of threads doesn't match */
   if (g_cpudevices.size() != num_cpu_threads) {
     Device *device;
@@ -233,6 +275,12 @@ void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
     g_cpuInitialized = true;
   }
 
+  /* initialize GLSL, its shaders are compiled when first used */
+  if (use_glsl && g_glsldevice == NULL) {
+    g_glsldevice = new GLSLDevice();
+    g_glsldevice->initialize();
+  }
+
 #  ifdef COM_OPENCL_ENABLED
   /* deinitialize OpenCL GPU's */
   if (use_opencl && !g_openclInitialized) {
@@ -327,7 +375,7 @@ void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
 
 void WorkScheduler::deinitialize()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
   /* deinitialize CPU threads */
   if (g_cpuInitialized) {
     Device *device;
@@ -341,6 +389,13 @@ void WorkScheduler::deinitialize()
     g_cpuInitialized = false;
   }
 
+  /* deinitialize GLSL */
+  if (g_glsldevice) {
+    g_glsldevice->deinitialize();
+    delete g_glsldevice;
+    g_glsldevice = NULL;
+  }
+
 #  ifdef COM_OPENCL_ENABLED
   /* deinitialize OpenCL GPU's */
   if (g_openclInitialized) {
@@ -21,6 +21,7 @@
 
 #include "COM_ExecutionGroup.h"
 extern "C" {
+#include "BLI_task.h"
 #include "BLI_threads.h"
 }
 #include "COM_WorkPackage.h"
@@ -32,29 +33,34 @@ extern "C" {
  */
 class WorkScheduler {
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
   /**
    * \brief are we being stopped.
    */
   static bool isStopping();
 
   /**
-   * \brief main thread loop for cpudevices
-   * inside this loop new work is queried and being executed
+   * \brief task executing a work package on the cpudevice of the task scheduler thread
    */
-  static void *thread_execute_cpu(void *data);
+  static void thread_execute_cpu(TaskPool *__restrict pool, void *taskdata, int threadid);
 
   /**
    * \brief main thread loop for gpudevices
    * inside this loop new work is queried and being executed
    */
   static void *thread_execute_gpu(void *data);
+
+  /**
+   * \brief thread loop of the GLSLDevice
+   */
+  static void *thread_execute_glsl(void *data);
 #endif
  public:
   /**
    * \brief schedule a chunk of a group to be calculated.
    * An execution group schedules a chunk in the WorkScheduler
-   * when ExecutionGroup.isOpenCL is set the work will be handled by a OpenCLDevice
+   * when ExecutionGroup.isOpenCL is set the work will be handled by a OpenCLDevice,
+   * when ExecutionGroup.isGLSL is set by the GLSLDevice,
    * otherwise the work is scheduled for an CPUDevice
    * \see ExecutionGroup.execute
    * \param group: the execution group
@@ -68,13 +74,15 @@ class WorkScheduler {
    * during initialization the mutexes are initialized.
    * there are two mutexes (for every device type one)
    * After mutex initialization the system is queried in order to count the number of CPUDevices
-   * and GPUDevices to be created. For every hardware thread a CPUDevice and for every OpenCL GPU
-   * device a OpenCLDevice is created. these devices are stored in a separate list (cpudevices &
-   * gpudevices)
+   * and GPUDevices to be created. For every thread of the task scheduler a CPUDevice and for
+   * every OpenCL GPU device a OpenCLDevice is created. these devices are stored in a separate
+   * list (cpudevices & gpudevices)
    *
-   * This function can be called multiple times to lazily initialize OpenCL.
+   * This function can be called multiple times to lazily initialize OpenCL and GLSL.
+   * \note num_cpu_threads is not used anymore, the CPU work is spread over all threads of the
+   * task scheduler.
    */
-  static void initialize(bool use_opencl, int num_cpu_threads);
+  static void initialize(bool use_opencl, bool use_glsl, int num_cpu_threads);
 
   /**
    * \brief deinitialize the WorkScheduler
@@ -84,8 +92,8 @@ class WorkScheduler {
 
   /**
    * \brief Start the execution
-   * this methods will start the WorkScheduler. Inside this method all threads are initialized.
-   * for every device a thread is created.
+   * this methods will start the WorkScheduler. Inside this method the task pool for the CPU
+   * work is created, and for every OpenCL device and the GLSL device a thread.
    * \see initialize Initialization and query of the number of devices
    */
   static void start(CompositorContext &context);
@@ -110,6 +118,12 @@ class WorkScheduler {
    */
   static bool hasGPUDevices();
 
+  /**
+   * \brief Is the GLSL device initialized?
+   * \see CompositorContext.getHasActiveGLSLDevice
+   */
+  static bool hasGLSLDevice();
+
   static int current_thread_id();
 
 #ifdef WITH_CXX_GUARDEDALLOC
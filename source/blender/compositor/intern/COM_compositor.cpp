@@ -26,6 +26,7 @@ extern "C" {
 #include "BKE_scene.h"
 
 #include "COM_compositor.h"
+#include "COM_BufferCache.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_WorkScheduler.h"
 #include "clew.h"
@@ -80,12 +81,19 @@ void COM_execute(RenderData *rd,
 
   /* initialize workscheduler, will check if already done. TODO deinitialize somewhere */
   bool use_opencl = (editingtree->flag & NTREE_COM_OPENCL) != 0;
-  WorkScheduler::initialize(use_opencl, BKE_render_num_threads(rd));
+  bool use_glsl = (editingtree->flag & NTREE_COM_GLSL) != 0;
+  WorkScheduler::initialize(use_opencl, use_glsl, BKE_render_num_threads(rd));
 
   /* set progress bar to 0% and status to init compositing */
   editingtree->progress(editingtree->prh, 0.0);
   editingtree->stats_draw(editingtree->sdh, IFACE_("Compositing"));
 
+  /* buffers of the previous execution which are not used by this one are freed afterwards,
+   * unless it's canceled */
+  if (!rendering) {
+    BufferCache::begin(viewName);
+  }
+
   bool twopass = (editingtree->flag & NTREE_TWO_PASS) && !rendering;
   /* initialize execution system */
   if (twopass) {
@@ -97,6 +105,7 @@ void COM_execute(RenderData *rd,
     if (editingtree->test_break(editingtree->tbh)) {
       // during editing multiple calls to this method can be triggered.
       // make sure one the last one will be doing the work.
+      // the cached buffers are kept for it as well.
       BLI_mutex_unlock(&s_compositorMutex);
       return;
     }
@@ -107,13 +116,34 @@ void COM_execute(RenderData *rd,
   system->execute();
   delete system;
 
+  if (!rendering) {
+    BufferCache::end();
+  }
+
   BLI_mutex_unlock(&s_compositorMutex);
 }
 
+void COM_clearCaches()
+{
+  if (!is_compositorMutex_init) {
+    return;
+  }
+
+  if (BLI_mutex_trylock(&s_compositorMutex)) {
+    BufferCache::clear();
+    BLI_mutex_unlock(&s_compositorMutex);
+  }
+  else {
+    /* Don't wait for the running execution, the next one frees the buffers. */
+    BufferCache::tagClear();
+  }
+}
+
 void COM_deinitialize()
 {
   if (is_compositorMutex_init) {
     BLI_mutex_lock(&s_compositorMutex);
+    BufferCache::clear();
     WorkScheduler::deinitialize();
     is_compositorMutex_init = false;
     BLI_mutex_unlock(&s_compositorMutex);
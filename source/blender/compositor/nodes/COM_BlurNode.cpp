@@ -48,7 +48,26 @@ void BlurNode::convertToOperations(NodeConverter &converter,
   CompositorQuality quality = context.getQuality();
   NodeOperation *input_operation = NULL, *output_operation = NULL;
 
-  if (data->filtertype == R_FILTER_FAST_GAUSS) {
+  /* Relative sizes are only known on execution, they keep the separable blur. */
+  const bool use_iir = data->filtertype == R_FILTER_GAUSS && !data->bokeh && !data->relative &&
+                       !connectedSizeSocket &&
+                       !(editorNode->custom1 & CMP_NODEFLAG_BLUR_VARIABLE_SIZE) &&
+                       size * max_ii(data->sizex, data->sizey) >= COM_BLUR_IIR_MIN_RADIUS;
+
+  if (use_iir) {
+    FastGaussianBlurOperation *operationfgb = new FastGaussianBlurOperation();
+    operationfgb->setData(data);
+    operationfgb->setSize(size);
+    operationfgb->setSigmaFactor(1.0f / 3.0f);
+    operationfgb->setExtendBounds(extend_bounds);
+    converter.addOperation(operationfgb);
+
+    converter.mapInputSocket(getInputSocket(1), operationfgb->getInputSocket(1));
+
+    input_operation = operationfgb;
+    output_operation = operationfgb;
+  }
+  else if (data->filtertype == R_FILTER_FAST_GAUSS) {
     FastGaussianBlurOperation *operationfgb = new FastGaussianBlurOperation();
     operationfgb->setData(data);
     operationfgb->setExtendBounds(extend_bounds);
@@ -17,11 +17,16 @@
  */
 
 #include "COM_BlurBaseOperation.h"
+#include "COM_GLSLDevice.h"
 #include "BLI_math.h"
 #include "MEM_guardedalloc.h"
 
 extern "C" {
+#include "GPU_extensions.h"
+#include "GPU_shader.h"
 #include "RE_pipeline.h"
+
+extern char datatoc_compositor_gaussian_blur_frag_glsl[];
 }
 
 BlurBaseOperation::BlurBaseOperation(DataType data_type) : NodeOperation()
@@ -175,6 +180,36 @@ void BlurBaseOperation::updateSize()
   }
 }
 
+const GLSLBuffer *BlurBaseOperation::executeGaussianGLSL(
+    GLSLDevice *device, const rcti *rect, const float *gausstab, int filtersize, bool vertical)
+{
+  /* The weights are stored in a texture of one row. */
+  if (gausstab == NULL || filtersize * 2 + 1 > GPU_max_texture_size()) {
+    return NULL;
+  }
+
+  const GLSLBuffer *input = device->getInputBuffer(getInputOperation(0), rect);
+  GPUShader *shader = device->getShader("compositor_gaussian_blur",
+                                        datatoc_compositor_gaussian_blur_frag_glsl);
+  if (input == NULL || shader == NULL) {
+    return NULL;
+  }
+  GPUTexture *gausstab_tex = device->createDataTexture(filtersize * 2 + 1, 1, gausstab);
+  if (gausstab_tex == NULL) {
+    return NULL;
+  }
+
+  const int direction[2] = {vertical ? 0 : 1, vertical ? 1 : 0};
+  GPU_shader_bind(shader);
+  device->bindInput(shader, "inputImage", 0, input);
+  device->bindTexture(shader, "gausstab", 1, gausstab_tex);
+  GPU_shader_uniform_int(shader, GPU_shader_get_uniform_ensure(shader, "filter_size"), filtersize);
+  GPU_shader_uniform_int(shader, GPU_shader_get_uniform_ensure(shader, "sample_step"), getStep());
+  GPU_shader_uniform_vector_int(
+      shader, GPU_shader_get_uniform_ensure(shader, "direction"), 2, 1, direction);
+  return device->drawBuffer(shader, rect, getOutputSocket(0)->getDataType());
+}
+
 void BlurBaseOperation::determineResolution(unsigned int resolution[2],
                                             unsigned int preferredResolution[2])
 {
@@ -23,6 +23,10 @@
 
 #define MAX_GAUSSTAB_RADIUS 30000
 
+/* Gaussian blurs with a larger radius use the recursive filter of FastGaussianBlurOperation,
+ * its cost doesn't depend on the radius. */
+#define COM_BLUR_IIR_MIN_RADIUS 64.0f
+
 #ifdef __SSE2__
 #  include <emmintrin.h>
 #endif
@@ -39,6 +43,16 @@ class BlurBaseOperation : public NodeOperation, public QualityStepHelper {
 
   void updateSize();
 
+  /**
+   * \brief calculate a gaussian blur of the first input in one direction with a GLSLDevice.
+   * \param gausstab: the weights from -filtersize to filtersize.
+   */
+  const GLSLBuffer *executeGaussianGLSL(GLSLDevice *device,
+                                        const rcti *rect,
+                                        const float *gausstab,
+                                        int filtersize,
+                                        bool vertical);
+
   /**
    * Cached reference to the inputProgram
    */
@@ -17,6 +17,13 @@
  */
 
 #include "COM_BrightnessOperation.h"
+#include "COM_GLSLDevice.h"
+
+extern "C" {
+#include "GPU_shader.h"
+
+extern char datatoc_compositor_brightness_frag_glsl[];
+}
 
 BrightnessOperation::BrightnessOperation() : NodeOperation()
 {
@@ -26,6 +33,7 @@ BrightnessOperation::BrightnessOperation() : NodeOperation()
   this->addOutputSocket(COM_DT_COLOR);
   this->m_inputProgram = NULL;
   this->m_use_premultiply = false;
+  this->setGLSL(true);
 }
 
 void BrightnessOperation::setUsePremultiply(bool use_premultiply)
@@ -83,6 +91,27 @@ void BrightnessOperation::executePixelSampled(float output[4],
   }
 }
 
+const GLSLBuffer *BrightnessOperation::executeGLSL(GLSLDevice *device, const rcti *rect)
+{
+  const GLSLBuffer *color = device->getInputBuffer(getInputOperation(0), rect);
+  const GLSLBuffer *brightness = device->getInputBuffer(getInputOperation(1), rect);
+  const GLSLBuffer *contrast = device->getInputBuffer(getInputOperation(2), rect);
+  GPUShader *shader = device->getShader("compositor_brightness",
+                                        datatoc_compositor_brightness_frag_glsl);
+  if (color == NULL || brightness == NULL || contrast == NULL || shader == NULL) {
+    return NULL;
+  }
+
+  GPU_shader_bind(shader);
+  device->bindInput(shader, "inputColor", 0, color);
+  device->bindInput(shader, "inputBrightness", 1, brightness);
+  device->bindInput(shader, "inputContrast", 2, contrast);
+  GPU_shader_uniform_int(shader,
+                         GPU_shader_get_uniform_ensure(shader, "use_premultiply"),
+                         this->m_use_premultiply);
+  return device->drawBuffer(shader, rect, COM_DT_COLOR);
+}
+
 void BrightnessOperation::deinitExecution()
 {
   this->m_inputProgram = NULL;
@@ -49,6 +49,8 @@ class BrightnessOperation : public NodeOperation {
    */
   void deinitExecution();
 
+  const GLSLBuffer *executeGLSL(GLSLDevice *device, const rcti *rect);
+
   void setUsePremultiply(bool use_premultiply);
 };
 #endif
@@ -25,6 +25,7 @@
 FastGaussianBlurOperation::FastGaussianBlurOperation() : BlurBaseOperation(COM_DT_COLOR)
 {
   this->m_iirgaus = NULL;
+  this->m_sigma_factor = 0.5f;
 }
 
 void FastGaussianBlurOperation::executePixel(float output[4], int x, int y, void *data)
@@ -85,8 +86,8 @@ void *FastGaussianBlurOperation::initializeTileData(rcti *rect)
     updateSize();
 
     int c;
-    this->m_sx = this->m_data.sizex * this->m_size / 2.0f;
-    this->m_sy = this->m_data.sizey * this->m_size / 2.0f;
+    this->m_sx = this->m_data.sizex * this->m_size * this->m_sigma_factor;
+    this->m_sy = this->m_data.sizey * this->m_size * this->m_sigma_factor;
 
     if ((this->m_sx == this->m_sy) && (this->m_sx > 0.0f)) {
       for (c = 0; c < COM_NUM_CHANNELS_COLOR; c++) {
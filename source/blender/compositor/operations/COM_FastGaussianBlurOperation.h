@@ -26,6 +26,7 @@ class FastGaussianBlurOperation : public BlurBaseOperation {
  private:
   float m_sx;
   float m_sy;
+  float m_sigma_factor;
   MemoryBuffer *m_iirgaus;
 
  public:
@@ -39,6 +40,16 @@ class FastGaussianBlurOperation : public BlurBaseOperation {
   void *initializeTileData(rcti *rect);
   void deinitExecution();
   void initExecution();
+
+  /**
+   * \brief factor converting the blur size to the sigma of the gaussian.
+   * Defaults to the one of the Fast Gaussian filter type, the Gaussian filter type reaches
+   * zero at three times sigma.
+   */
+  void setSigmaFactor(float factor)
+  {
+    this->m_sigma_factor = factor;
+  }
 };
 
 enum {
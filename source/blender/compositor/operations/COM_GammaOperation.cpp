@@ -17,8 +17,15 @@
  */
 
 #include "COM_GammaOperation.h"
+#include "COM_GLSLDevice.h"
 #include "BLI_math.h"
 
+extern "C" {
+#include "GPU_shader.h"
+
+extern char datatoc_compositor_gamma_frag_glsl[];
+}
+
 GammaOperation::GammaOperation() : NodeOperation()
 {
   this->addInputSocket(COM_DT_COLOR);
@@ -26,6 +33,7 @@ GammaOperation::GammaOperation() : NodeOperation()
   this->addOutputSocket(COM_DT_COLOR);
   this->m_inputProgram = NULL;
   this->m_inputGammaProgram = NULL;
+  this->setGLSL(true);
 }
 void GammaOperation::initExecution()
 {
@@ -49,6 +57,21 @@ void GammaOperation::executePixelSampled(float output[4], float x, float y, Pixe
   output[3] = inputValue[3];
 }
 
+const GLSLBuffer *GammaOperation::executeGLSL(GLSLDevice *device, const rcti *rect)
+{
+  const GLSLBuffer *color = device->getInputBuffer(getInputOperation(0), rect);
+  const GLSLBuffer *gamma = device->getInputBuffer(getInputOperation(1), rect);
+  GPUShader *shader = device->getShader("compositor_gamma", datatoc_compositor_gamma_frag_glsl);
+  if (color == NULL || gamma == NULL || shader == NULL) {
+    return NULL;
+  }
+
+  GPU_shader_bind(shader);
+  device->bindInput(shader, "inputColor", 0, color);
+  device->bindInput(shader, "inputGamma", 1, gamma);
+  return device->drawBuffer(shader, rect, COM_DT_COLOR);
+}
+
 void GammaOperation::deinitExecution()
 {
   this->m_inputProgram = NULL;
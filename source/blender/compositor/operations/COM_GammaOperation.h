@@ -45,5 +45,7 @@ class GammaOperation : public NodeOperation {
    * Deinitialize the execution
    */
   void deinitExecution();
+
+  const GLSLBuffer *executeGLSL(GLSLDevice *device, const rcti *rect);
 };
 #endif
@@ -113,11 +113,7 @@ void GaussianBokehBlurOperation::updateGauss()
 
 void GaussianBokehBlurOperation::executePixel(float output[4], int x, int y, void *data)
 {
-  float tempColor[4];
-  tempColor[0] = 0;
-  tempColor[1] = 0;
-  tempColor[2] = 0;
-  tempColor[3] = 0;
+  float ATTR_ALIGN(16) tempColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
   float multiplier_accum = 0;
   MemoryBuffer *inputBuffer = (MemoryBuffer *)data;
   float *buffer = inputBuffer->getBuffer();
@@ -136,17 +132,29 @@ void GaussianBokehBlurOperation::executePixel(float output[4], int x, int y, voi
   int offsetadd = QualityStepHelper::getOffsetAdd();
   const int addConst = (xmin - x + this->m_radx);
   const int mulConst = (this->m_radx * 2 + 1);
+#ifdef __SSE2__
+  __m128 accum_r = _mm_load_ps(tempColor);
+#endif
   for (int ny = ymin; ny < ymax; ny += step) {
     index = ((ny - y) + this->m_rady) * mulConst + addConst;
     int bufferindex = ((xmin - bufferstartx) * 4) + ((ny - bufferstarty) * 4 * bufferwidth);
     for (int nx = xmin; nx < xmax; nx += step) {
       const float multiplier = this->m_gausstab[index];
+#ifdef __SSE2__
+      __m128 reg_a = _mm_load_ps(&buffer[bufferindex]);
+      reg_a = _mm_mul_ps(reg_a, _mm_set1_ps(multiplier));
+      accum_r = _mm_add_ps(accum_r, reg_a);
+#else
       madd_v4_v4fl(tempColor, &buffer[bufferindex], multiplier);
+#endif
       multiplier_accum += multiplier;
       index += step;
       bufferindex += offsetadd;
     }
   }
+#ifdef __SSE2__
+  _mm_store_ps(tempColor, accum_r);
+#endif
 
   mul_v4_v4fl(output, tempColor, 1.0f / multiplier_accum);
 }
@@ -32,6 +32,7 @@ GaussianXBlurOperation::GaussianXBlurOperation() : BlurBaseOperation(COM_DT_COLO
   this->m_gausstab_sse = NULL;
 #endif
   this->m_filtersize = 0;
+  this->setGLSL(true);
 }
 
 void *GaussianXBlurOperation::initializeTileData(rcti * /*rect*/)
@@ -155,6 +156,16 @@ void GaussianXBlurOperation::executeOpenCL(OpenCLDevice *device,
   clReleaseMemObject(gausstab);
 }
 
+const GLSLBuffer *GaussianXBlurOperation::executeGLSL(GLSLDevice *device, const rcti *rect)
+{
+  lockMutex();
+  if (!this->m_sizeavailable) {
+    updateGauss();
+  }
+  unlockMutex();
+  return executeGaussianGLSL(device, rect, this->m_gausstab, this->m_filtersize, false);
+}
+
 void GaussianXBlurOperation::deinitExecution()
 {
   BlurBaseOperation::deinitExecution();
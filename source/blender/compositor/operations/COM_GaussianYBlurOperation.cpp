@@ -32,6 +32,7 @@ GaussianYBlurOperation::GaussianYBlurOperation() : BlurBaseOperation(COM_DT_COLO
   this->m_gausstab_sse = NULL;
 #endif
   this->m_filtersize = 0;
+  this->setGLSL(true);
 }
 
 void *GaussianYBlurOperation::initializeTileData(rcti * /*rect*/)
@@ -155,6 +156,16 @@ void GaussianYBlurOperation::executeOpenCL(OpenCLDevice *device,
   clReleaseMemObject(gausstab);
 }
 
+const GLSLBuffer *GaussianYBlurOperation::executeGLSL(GLSLDevice *device, const rcti *rect)
+{
+  lockMutex();
+  if (!this->m_sizeavailable) {
+    updateGauss();
+  }
+  unlockMutex();
+  return executeGaussianGLSL(device, rect, this->m_gausstab, this->m_filtersize, true);
+}
+
 void GaussianYBlurOperation::deinitExecution()
 {
   BlurBaseOperation::deinitExecution();
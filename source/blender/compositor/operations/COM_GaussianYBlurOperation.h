@@ -45,6 +45,8 @@ class GaussianYBlurOperation : public BlurBaseOperation {
                      list<cl_mem> *clMemToCleanUp,
                      list<cl_kernel> *clKernelsToCleanUp);
 
+  const GLSLBuffer *executeGLSL(GLSLDevice *device, const rcti *rect);
+
   /**
    * \brief initialize the execution
    */
@@ -72,6 +72,13 @@ void MathBaseOperation::clampIfNeeded(float *color)
   }
 }
 
+void MathAddOperation::executeRow(float *output, int x, int y, int width, int num_channels)
+{
+  executeRowBinary(output, x, y, width, num_channels, [](float value1, float value2) {
+    return value1 + value2;
+  });
+}
+
 void MathAddOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
 {
   float inputValue1[4];
@@ -85,6 +92,13 @@ void MathAddOperation::executePixelSampled(float output[4], float x, float y, Pi
   clampIfNeeded(output);
 }
 
+void MathSubtractOperation::executeRow(float *output, int x, int y, int width, int num_channels)
+{
+  executeRowBinary(output, x, y, width, num_channels, [](float value1, float value2) {
+    return value1 - value2;
+  });
+}
+
 void MathSubtractOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -101,6 +115,13 @@ void MathSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathMultiplyOperation::executeRow(float *output, int x, int y, int width, int num_channels)
+{
+  executeRowBinary(output, x, y, width, num_channels, [](float value1, float value2) {
+    return value1 * value2;
+  });
+}
+
 void MathMultiplyOperation::executePixelSampled(float output[4],
                                                 float x,
                                                 float y,
@@ -117,6 +138,14 @@ void MathMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MathDivideOperation::executeRow(float *output, int x, int y, int width, int num_channels)
+{
+  executeRowBinary(output, x, y, width, num_channels, [](float value1, float value2) {
+    /* We don't want to divide by zero. */
+    return (value2 == 0.0f) ? 0.0f : value1 / value2;
+  });
+}
+
 void MathDivideOperation::executePixelSampled(float output[4],
                                               float x,
                                               float y,
@@ -20,6 +20,9 @@
 #define __COM_MATHBASEOPERATION_H__
 #include "COM_NodeOperation.h"
 
+/* Number of pixels of the input rows read at once when calculating a row. */
+#define COM_MATH_ROW_BLOCK_SIZE 64
+
 /**
  * this program converts an input color to an output value.
  * it assumes we are in sRGB color space.
@@ -43,6 +46,36 @@ class MathBaseOperation : public NodeOperation {
 
   void clampIfNeeded(float color[4]);
 
+  /**
+   * Calculate a row by reading the rows of the first two inputs in blocks and combining them
+   * with func, without a virtual call for every pixel.
+   */
+  template<typename Func>
+  void executeRowBinary(float *output, int x, int y, int width, int num_channels, Func func)
+  {
+    if (num_channels != COM_NUM_CHANNELS_VALUE) {
+      NodeOperation::executeRow(output, x, y, width, num_channels);
+      return;
+    }
+
+    float value1[COM_MATH_ROW_BLOCK_SIZE];
+    float value2[COM_MATH_ROW_BLOCK_SIZE];
+    for (int block_x = 0; block_x < width; block_x += COM_MATH_ROW_BLOCK_SIZE) {
+      const int block_width = min_ii(COM_MATH_ROW_BLOCK_SIZE, width - block_x);
+      this->m_inputValue1Operation->readRow(value1, x + block_x, y, block_width, 1);
+      this->m_inputValue2Operation->readRow(value2, x + block_x, y, block_width, 1);
+      for (int i = 0; i < block_width; i++) {
+        output[block_x + i] = func(value1[i], value2[i]);
+      }
+    }
+
+    if (this->m_useClamp) {
+      for (int i = 0; i < width; i++) {
+        CLAMP(output[i], 0.0f, 1.0f);
+      }
+    }
+  }
+
  public:
   /**
    * the inner loop of this program
@@ -76,6 +109,7 @@ class MathAddOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width, int num_channels);
 };
 class MathSubtractOperation : public MathBaseOperation {
  public:
@@ -83,6 +117,7 @@ class MathSubtractOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width, int num_channels);
 };
 class MathMultiplyOperation : public MathBaseOperation {
  public:
@@ -90,6 +125,7 @@ class MathMultiplyOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width, int num_channels);
 };
 class MathDivideOperation : public MathBaseOperation {
  public:
@@ -97,6 +133,7 @@ class MathDivideOperation : public MathBaseOperation {
   {
   }
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeRow(float *output, int x, int y, int width, int num_channels);
 };
 class MathSineOperation : public MathBaseOperation {
  public:
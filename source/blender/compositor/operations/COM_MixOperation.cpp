@@ -18,8 +18,14 @@
 
 #include "COM_MixOperation.h"
 
+#include "COM_GLSLDevice.h"
+
 extern "C" {
 #include "BLI_math.h"
+
+#include "GPU_shader.h"
+
+extern char datatoc_compositor_mix_frag_glsl[];
 }
 
 /* ******** Mix Base Operation ******** */
@@ -35,6 +41,7 @@ MixBaseOperation::MixBaseOperation() : NodeOperation()
   this->m_inputColor2Operation = NULL;
   this->setUseValueAlphaMultiply(false);
   this->setUseClamp(false);
+  this->m_glslBlendDefine = NULL;
 }
 
 void MixBaseOperation::initExecution()
@@ -90,6 +97,32 @@ void MixBaseOperation::determineResolution(unsigned int resolution[2],
   NodeOperation::determineResolution(resolution, preferredResolution);
 }
 
+const GLSLBuffer *MixBaseOperation::executeGLSL(GLSLDevice *device, const rcti *rect)
+{
+  const GLSLBuffer *value = device->getInputBuffer(getInputOperation(0), rect);
+  const GLSLBuffer *color1 = device->getInputBuffer(getInputOperation(1), rect);
+  const GLSLBuffer *color2 = device->getInputBuffer(getInputOperation(2), rect);
+
+  std::string name = std::string("compositor_mix_") + this->m_glslBlendDefine;
+  std::string define = std::string("#define ") + this->m_glslBlendDefine + "\n";
+  GPUShader *shader = device->getShader(
+      name.c_str(), datatoc_compositor_mix_frag_glsl, define.c_str());
+  if (value == NULL || color1 == NULL || color2 == NULL || shader == NULL) {
+    return NULL;
+  }
+
+  GPU_shader_bind(shader);
+  device->bindInput(shader, "inputValue", 0, value);
+  device->bindInput(shader, "inputColor1", 1, color1);
+  device->bindInput(shader, "inputColor2", 2, color2);
+  GPU_shader_uniform_int(shader,
+                         GPU_shader_get_uniform_ensure(shader, "use_value_alpha_multiply"),
+                         this->m_valueAlphaMultiply);
+  GPU_shader_uniform_int(
+      shader, GPU_shader_get_uniform_ensure(shader, "use_clamp"), this->m_useClamp);
+  return device->drawBuffer(shader, rect, COM_DT_COLOR);
+}
+
 void MixBaseOperation::deinitExecution()
 {
   this->m_inputValueOperation = NULL;
@@ -101,7 +134,7 @@ void MixBaseOperation::deinitExecution()
 
 MixAddOperation::MixAddOperation() : MixBaseOperation()
 {
-  /* pass */
+  this->setGLSLBlendDefine("MIX_ADD");
 }
 
 void MixAddOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
@@ -130,7 +163,7 @@ void MixAddOperation::executePixelSampled(float output[4], float x, float y, Pix
 
 MixBlendOperation::MixBlendOperation() : MixBaseOperation()
 {
-  /* pass */
+  this->setGLSLBlendDefine("MIX_BLEND");
 }
 
 void MixBlendOperation::executePixelSampled(float output[4],
@@ -292,7 +325,7 @@ void MixColorOperation::executePixelSampled(float output[4],
 
 MixDarkenOperation::MixDarkenOperation() : MixBaseOperation()
 {
-  /* pass */
+  this->setGLSLBlendDefine("MIX_DARKEN");
 }
 
 void MixDarkenOperation::executePixelSampled(float output[4],
@@ -325,7 +358,7 @@ void MixDarkenOperation::executePixelSampled(float output[4],
 
 MixDifferenceOperation::MixDifferenceOperation() : MixBaseOperation()
 {
-  /* pass */
+  this->setGLSLBlendDefine("MIX_DIFFERENCE");
 }
 
 void MixDifferenceOperation::executePixelSampled(float output[4],
@@ -579,7 +612,7 @@ void MixHueOperation::executePixelSampled(float output[4], float x, float y, Pix
 
 MixLightenOperation::MixLightenOperation() : MixBaseOperation()
 {
-  /* pass */
+  this->setGLSLBlendDefine("MIX_LIGHTEN");
 }
 
 void MixLightenOperation::executePixelSampled(float output[4],
@@ -678,7 +711,7 @@ void MixLinearLightOperation::executePixelSampled(float output[4],
 
 MixMultiplyOperation::MixMultiplyOperation() : MixBaseOperation()
 {
-  /* pass */
+  this->setGLSLBlendDefine("MIX_MULTIPLY");
 }
 
 void MixMultiplyOperation::executePixelSampled(float output[4],
@@ -803,7 +836,7 @@ void MixSaturationOperation::executePixelSampled(float output[4],
 
 MixScreenOperation::MixScreenOperation() : MixBaseOperation()
 {
-  /* pass */
+  this->setGLSLBlendDefine("MIX_SCREEN");
 }
 
 void MixScreenOperation::executePixelSampled(float output[4],
@@ -883,7 +916,7 @@ void MixSoftLightOperation::executePixelSampled(float output[4],
 
 MixSubtractOperation::MixSubtractOperation() : MixBaseOperation()
 {
-  /* pass */
+  this->setGLSLBlendDefine("MIX_SUBTRACT");
 }
 
 void MixSubtractOperation::executePixelSampled(float output[4],
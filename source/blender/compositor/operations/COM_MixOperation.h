@@ -35,6 +35,10 @@ class MixBaseOperation : public NodeOperation {
   SocketReader *m_inputColor2Operation;
   bool m_valueAlphaMultiply;
   bool m_useClamp;
+  /**
+   * \brief define of the blend mode in compositor_mix_frag.glsl, NULL when not supported.
+   */
+  const char *m_glslBlendDefine;
 
   inline void clampIfNeeded(float color[4])
   {
@@ -69,6 +73,17 @@ class MixBaseOperation : public NodeOperation {
 
   void determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2]);
 
+  const GLSLBuffer *executeGLSL(GLSLDevice *device, const rcti *rect);
+
+  /**
+   * \brief calculate the operation with the blend mode of define on a GLSLDevice.
+   */
+  void setGLSLBlendDefine(const char *define)
+  {
+    this->m_glslBlendDefine = define;
+    this->setGLSL(define != NULL);
+  }
+
   void setUseValueAlphaMultiply(const bool value)
   {
     this->m_valueAlphaMultiply = value;
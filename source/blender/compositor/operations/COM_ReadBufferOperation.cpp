@@ -107,6 +107,22 @@ void ReadBufferOperation::executePixelFiltered(
   }
 }
 
+void ReadBufferOperation::executeRow(float *output, int x, int y, int width, int num_channels)
+{
+  if (num_channels != (int)m_buffer->get_num_channels()) {
+    NodeOperation::executeRow(output, x, y, width, num_channels);
+  }
+  else if (m_single_value) {
+    /* write buffer has a single value stored at (0,0) */
+    for (int i = 0; i < width; i++, output += num_channels) {
+      m_buffer->read(output, 0, 0);
+    }
+  }
+  else {
+    m_buffer->readRow(output, x, y, width);
+  }
+}
+
 bool ReadBufferOperation::determineDependingAreaOfInterest(rcti *input,
                                                            ReadBufferOperation *readOperation,
                                                            rcti *output)
@@ -51,6 +51,7 @@ class ReadBufferOperation : public NodeOperation {
                           MemoryBufferExtend extend_x,
                           MemoryBufferExtend extend_y);
   void executePixelFiltered(float output[4], float x, float y, float dx[2], float dy[2]);
+  void executeRow(float *output, int x, int y, int width, int num_channels);
   bool isReadBufferOperation() const
   {
     return true;
@@ -31,6 +31,17 @@ void SetColorOperation::executePixelSampled(float output[4],
   copy_v4_v4(output, this->m_color);
 }
 
+void SetColorOperation::executeRow(float *output, int x, int y, int width, int num_channels)
+{
+  if (num_channels != COM_NUM_CHANNELS_COLOR) {
+    NodeOperation::executeRow(output, x, y, width, num_channels);
+    return;
+  }
+  for (int i = 0; i < width; i++, output += num_channels) {
+    copy_v4_v4(output, this->m_color);
+  }
+}
+
 void SetColorOperation::determineResolution(unsigned int resolution[2],
                                             unsigned int preferredResolution[2])
 {
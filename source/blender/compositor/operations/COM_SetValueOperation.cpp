@@ -31,6 +31,14 @@ void SetValueOperation::executePixelSampled(float output[4],
   output[0] = this->m_value;
 }
 
+void SetValueOperation::executeRow(
+    float *output, int /*x*/, int /*y*/, int width, int num_channels)
+{
+  for (int i = 0; i < width; i++, output += num_channels) {
+    output[0] = this->m_value;
+  }
+}
+
 void SetValueOperation::determineResolution(unsigned int resolution[2],
                                             unsigned int preferredResolution[2])
 {
@@ -34,6 +34,19 @@ void SetVectorOperation::executePixelSampled(float output[4],
   output[2] = this->m_z;
 }
 
+void SetVectorOperation::executeRow(float *output, int x, int y, int width, int num_channels)
+{
+  if (num_channels != COM_NUM_CHANNELS_VECTOR) {
+    NodeOperation::executeRow(output, x, y, width, num_channels);
+    return;
+  }
+  for (int i = 0; i < width; i++, output += num_channels) {
+    output[0] = this->m_x;
+    output[1] = this->m_y;
+    output[2] = this->m_z;
+  }
+}
+
 void SetVectorOperation::determineResolution(unsigned int resolution[2],
                                              unsigned int preferredResolution[2])
 {
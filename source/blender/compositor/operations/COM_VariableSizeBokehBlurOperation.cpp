@@ -20,6 +20,10 @@
 #include "BLI_math.h"
 #include "COM_OpenCLDevice.h"
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 extern "C" {
 #include "RE_pipeline.h"
 }
@@ -99,10 +103,10 @@ void VariableSizeBokehBlurOperation::executePixel(float output[4], int x, int y,
   float *inputSizeFloatBuffer = inputSizeBuffer->getBuffer();
   float *inputProgramFloatBuffer = inputProgramBuffer->getBuffer();
   float readColor[4];
-  float bokeh[4];
+  float ATTR_ALIGN(16) bokeh[4];
   float tempSize[4];
-  float multiplier_accum[4];
-  float color_accum[4];
+  float ATTR_ALIGN(16) multiplier_accum[4];
+  float ATTR_ALIGN(16) color_accum[4];
 
   const float max_dim = max(m_width, m_height);
   const float scalar = this->m_do_size_scale ? (max_dim / 100.0f) : 1.0f;
@@ -140,6 +144,10 @@ void VariableSizeBokehBlurOperation::executePixel(float output[4], int x, int y,
     const int addXStepColor = addXStepValue * COM_NUM_CHANNELS_COLOR;
 
     if (size_center > this->m_threshold) {
+#ifdef __SSE2__
+      __m128 color_accum_r = _mm_load_ps(color_accum);
+      __m128 multiplier_accum_r = _mm_load_ps(multiplier_accum);
+#endif
       for (int ny = miny; ny < maxy; ny += addYStepValue) {
         float dy = ny - y;
         int offsetValueNy = ny * inputSizeBuffer->getWidth();
@@ -158,8 +166,15 @@ void VariableSizeBokehBlurOperation::executePixel(float output[4], int x, int y,
                         (dy / size) * (float)((COM_BLUR_BOKEH_PIXELS / 2) - 1),
                 };
                 inputBokehBuffer->read(bokeh, uv[0], uv[1]);
+#ifdef __SSE2__
+                __m128 bokeh_r = _mm_load_ps(bokeh);
+                __m128 color_r = _mm_load_ps(&inputProgramFloatBuffer[offsetColorNxNy]);
+                color_accum_r = _mm_add_ps(color_accum_r, _mm_mul_ps(bokeh_r, color_r));
+                multiplier_accum_r = _mm_add_ps(multiplier_accum_r, bokeh_r);
+#else
                 madd_v4_v4v4(color_accum, bokeh, &inputProgramFloatBuffer[offsetColorNxNy]);
                 add_v4_v4(multiplier_accum, bokeh);
+#endif
               }
             }
           }
@@ -167,6 +182,10 @@ void VariableSizeBokehBlurOperation::executePixel(float output[4], int x, int y,
           offsetValueNxNy += addXStepValue;
         }
       }
+#ifdef __SSE2__
+      _mm_store_ps(color_accum, color_accum_r);
+      _mm_store_ps(multiplier_accum, multiplier_accum_r);
+#endif
     }
 
     output[0] = color_accum[0] / multiplier_accum[0];
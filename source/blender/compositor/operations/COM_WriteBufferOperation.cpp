@@ -19,6 +19,7 @@
 #include "COM_WriteBufferOperation.h"
 #include "COM_defines.h"
 #include <stdio.h>
+#include "COM_GLSLDevice.h"
 #include "COM_OpenCLDevice.h"
 
 WriteBufferOperation::WriteBufferOperation(DataType datatype) : NodeOperation()
@@ -91,15 +92,11 @@ void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/
     int x2 = rect->xmax;
     int y2 = rect->ymax;
 
-    int x;
     int y;
     bool breaked = false;
     for (y = y1; y < y2 && (!breaked); y++) {
       int offset4 = (y * memoryBuffer->getWidth() + x1) * num_channels;
-      for (x = x1; x < x2; x++) {
-        this->m_input->readSampled(&(buffer[offset4]), x, y, COM_PS_NEAREST);
-        offset4 += num_channels;
-      }
+      this->m_input->readRow(&(buffer[offset4]), x1, y, x2 - x1, num_channels);
       if (isBraked()) {
         breaked = true;
       }
@@ -204,6 +201,23 @@ void WriteBufferOperation::executeOpenCLRegion(OpenCLDevice *device,
   delete clKernelsToCleanUp;
 }
 
+void WriteBufferOperation::executeGLSLRegion(GLSLDevice *device,
+                                             rcti *rect,
+                                             unsigned int chunkNumber,
+                                             MemoryBuffer ** /*inputMemoryBuffers*/,
+                                             MemoryBuffer *outputBuffer)
+{
+  const GLSLBuffer *result = device->getInputBuffer(this->m_input, rect);
+  if (result == NULL) {
+    /* A shader failed to compile. */
+    executeRegion(rect, chunkNumber);
+    return;
+  }
+
+  device->readBuffer(result, outputBuffer);
+  this->getMemoryProxy()->getBuffer()->copyContentFrom(outputBuffer);
+}
+
 void WriteBufferOperation::determineResolution(unsigned int resolution[2],
                                                unsigned int preferredResolution[2])
 {
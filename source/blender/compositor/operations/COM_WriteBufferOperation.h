@@ -56,6 +56,11 @@ class WriteBufferOperation : public NodeOperation {
                            unsigned int chunkNumber,
                            MemoryBuffer **memoryBuffers,
                            MemoryBuffer *outputBuffer);
+  void executeGLSLRegion(GLSLDevice *device,
+                         rcti *rect,
+                         unsigned int chunkNumber,
+                         MemoryBuffer **memoryBuffers,
+                         MemoryBuffer *outputBuffer);
   void determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2]);
   void readResolutionFromInputSocket();
   inline NodeOperation *getInput()
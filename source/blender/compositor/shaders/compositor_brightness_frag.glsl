@@ -0,0 +1,35 @@
+
+uniform sampler2D inputColor;
+uniform ivec4 inputColor_area;
+uniform sampler2D inputBrightness;
+uniform ivec4 inputBrightness_area;
+uniform sampler2D inputContrast;
+uniform ivec4 inputContrast_area;
+
+uniform bool use_premultiply;
+
+/* Same as BrightnessOperation, the algorithm is by Werner D. Streidt. */
+void main()
+{
+  ivec2 co = output_coord();
+  vec4 color = read_input(inputColor, inputColor_area, co);
+  float brightness = read_input(inputBrightness, inputBrightness_area, co).r / 100.0;
+  float contrast = read_input(inputContrast, inputContrast_area, co).r;
+  float delta = contrast / 200.0;
+
+  float a, b;
+  if (contrast > 0.0) {
+    a = 1.0 / max(1.0 - delta * 2.0, 1.192092896e-07);
+    b = a * (brightness - delta);
+  }
+  else {
+    delta *= -1.0;
+    a = max(1.0 - delta * 2.0, 0.0);
+    b = a * brightness + delta;
+  }
+
+  if (use_premultiply && color.a != 0.0 && color.a != 1.0) {
+    color.rgb /= color.a;
+  }
+  fragColor = vec4(a * color.rgb + b, color.a);
+}
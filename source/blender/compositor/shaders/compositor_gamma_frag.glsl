@@ -0,0 +1,16 @@
+
+uniform sampler2D inputColor;
+uniform ivec4 inputColor_area;
+uniform sampler2D inputGamma;
+uniform ivec4 inputGamma_area;
+
+void main()
+{
+  ivec2 co = output_coord();
+  vec4 color = read_input(inputColor, inputColor_area, co);
+  float gamma = read_input(inputGamma, inputGamma_area, co).r;
+
+  /* Check for negative to avoid NaN's. */
+  fragColor = vec4(mix(color.rgb, pow(color.rgb, vec3(gamma)), greaterThan(color.rgb, vec3(0.0))),
+                   color.a);
+}
@@ -0,0 +1,31 @@
+
+uniform sampler2D inputImage;
+uniform ivec4 inputImage_area;
+
+/* Weights of the offsets from -filter_size to filter_size. */
+uniform sampler2D gausstab;
+uniform int filter_size;
+uniform int sample_step;
+/* (1, 0) for the X blur and (0, 1) for the Y blur. */
+uniform ivec2 direction;
+
+void main()
+{
+  ivec2 co = output_coord();
+  int center = co.x * direction.x + co.y * direction.y;
+  int area_min = inputImage_area.x * direction.x + inputImage_area.y * direction.y;
+  int area_size = inputImage_area.z * direction.x + inputImage_area.w * direction.y;
+
+  int n_min = max(center - filter_size, area_min);
+  int n_max = min(center + filter_size + 1, area_min + area_size);
+
+  vec4 color = vec4(0.0);
+  float weight = 0.0;
+  for (int n = n_min; n < n_max; n += sample_step) {
+    float w = texelFetch(gausstab, ivec2(n - center + filter_size, 0), 0).r;
+    color += read_input(inputImage, inputImage_area, co + direction * (n - center)) * w;
+    weight += w;
+  }
+
+  fragColor = (weight > 0.0) ? color / weight : vec4(0.0);
+}
@@ -0,0 +1,25 @@
+
+/* Offset of the chunk being drawn, pixels are addressed in the space of the operation. */
+uniform ivec2 output_offset;
+
+out vec4 fragColor;
+
+ivec2 output_coord()
+{
+  return ivec2(gl_FragCoord.xy) + output_offset;
+}
+
+/* Area of the buffer stored in the texture: xy is its offset and zw its size, a single value
+ * has an empty area and is read everywhere. Outside the area the result is zero, like reading
+ * outside of a MemoryBuffer. */
+vec4 read_input(sampler2D tex, ivec4 area, ivec2 co)
+{
+  if (area.z == 0) {
+    return texelFetch(tex, ivec2(0), 0);
+  }
+  co -= area.xy;
+  if (any(lessThan(co, ivec2(0))) || any(greaterThanEqual(co, area.zw))) {
+    return vec4(0.0);
+  }
+  return texelFetch(tex, co, 0);
+}
@@ -0,0 +1,47 @@
+
+uniform sampler2D inputValue;
+uniform ivec4 inputValue_area;
+uniform sampler2D inputColor1;
+uniform ivec4 inputColor1_area;
+uniform sampler2D inputColor2;
+uniform ivec4 inputColor2_area;
+
+uniform bool use_value_alpha_multiply;
+uniform bool use_clamp;
+
+void main()
+{
+  ivec2 co = output_coord();
+  vec4 color1 = read_input(inputColor1, inputColor1_area, co);
+  vec4 color2 = read_input(inputColor2, inputColor2_area, co);
+  float value = read_input(inputValue, inputValue_area, co).r;
+
+  if (use_value_alpha_multiply) {
+    value *= color2.a;
+  }
+  float valuem = 1.0 - value;
+
+  vec3 result;
+#if defined(MIX_ADD)
+  result = color1.rgb + value * color2.rgb;
+#elif defined(MIX_SUBTRACT)
+  result = color1.rgb - value * color2.rgb;
+#elif defined(MIX_MULTIPLY)
+  result = color1.rgb * (valuem + value * color2.rgb);
+#elif defined(MIX_SCREEN)
+  result = 1.0 - (valuem + value * (1.0 - color2.rgb)) * (1.0 - color1.rgb);
+#elif defined(MIX_DIFFERENCE)
+  result = valuem * color1.rgb + value * abs(color1.rgb - color2.rgb);
+#elif defined(MIX_DARKEN)
+  result = min(color1.rgb, color2.rgb) * value + color1.rgb * valuem;
+#elif defined(MIX_LIGHTEN)
+  result = max(color1.rgb, value * color2.rgb);
+#else /* MIX_BLEND */
+  result = valuem * color1.rgb + value * color2.rgb;
+#endif
+
+  fragColor = vec4(result, color1.a);
+  if (use_clamp) {
+    fragColor = clamp(fragColor, 0.0, 1.0);
+  }
+}
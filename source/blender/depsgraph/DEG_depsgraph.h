@@ -92,6 +92,14 @@ Depsgraph *DEG_graph_new(struct Main *bmain,
                          struct ViewLayer *view_layer,
                          eEvaluationMode mode);
 
+/* Move the graph to the given owners, keeping its evaluated data-blocks
+ * (used by undo, when the original data-blocks are re-allocated).
+ * Relations need to be updated before evaluating or querying the graph. */
+void DEG_graph_replace_owners(struct Depsgraph *depsgraph,
+                              struct Main *bmain,
+                              struct Scene *scene,
+                              struct ViewLayer *view_layer);
+
 /* Free Depsgraph itself and all its data */
 void DEG_graph_free(Depsgraph *graph);
 
@@ -158,6 +166,35 @@ void DEG_evaluate_on_refresh(struct Main *bmain, Depsgraph *graph);
 
 bool DEG_needs_eval(Depsgraph *graph);
 
+/* Frame-Parallel Evaluation --------------------- */
+
+/* Evaluates upcoming frames in parallel, each on its own copy of the dependency graph,
+ * and hands them out in frame order. Meant for playback of scenes without simulations:
+ * frames don't depend on previous ones, and the original data-blocks must not be modified
+ * while the queue exists. */
+typedef struct DepsgraphFrameQueue DepsgraphFrameQueue;
+
+/* Create num_depsgraphs graphs for the view layer, which is the number of frames evaluated
+ * ahead. Must be called from the main thread. */
+DepsgraphFrameQueue *DEG_frame_queue_new(struct Main *bmain,
+                                         struct Scene *scene,
+                                         struct ViewLayer *view_layer,
+                                         eEvaluationMode mode,
+                                         int num_depsgraphs);
+void DEG_frame_queue_free(DepsgraphFrameQueue *queue);
+
+/* Start evaluating the frames from frame_start to frame_end (inclusive). */
+void DEG_frame_queue_begin(DepsgraphFrameQueue *queue,
+                           int frame_start,
+                           int frame_end,
+                           int frame_step);
+
+/* Wait for the next frame to be evaluated, returns NULL once all frames were handed out.
+ * The graph has to be given back with DEG_frame_queue_release() once it's not used anymore,
+ * so a later frame can be evaluated on it. */
+Depsgraph *DEG_frame_queue_next(DepsgraphFrameQueue *queue, int *r_frame);
+void DEG_frame_queue_release(DepsgraphFrameQueue *queue, Depsgraph *graph);
+
 /* Editors Integration  -------------------------- */
 
 /* Mechanism to allow editors to be informed of depsgraph updates,
@@ -84,6 +84,11 @@ void DEG_graph_build_from_ids(struct Depsgraph *graph,
 /* Tag relations from the given graph for update. */
 void DEG_graph_tag_relations_update(struct Depsgraph *graph);
 
+/* Tag relations from the given graph for update after objects were added to the view layer,
+ * without any other change to the relations. Unless relations were tagged for update otherwise,
+ * the graph is then extended with the new objects instead of being built again. */
+void DEG_graph_tag_relations_update_objects_added(struct Depsgraph *graph);
+
 /* Create or update relations in the specified graph. */
 void DEG_graph_relations_update(struct Depsgraph *graph,
                                 struct Main *bmain,
@@ -93,6 +98,10 @@ void DEG_graph_relations_update(struct Depsgraph *graph,
 /* Tag all relations in the database for update.*/
 void DEG_relations_tag_update(struct Main *bmain);
 
+/* Tag all relations in the database for update after objects were added,
+ * see #DEG_graph_tag_relations_update_objects_added. */
+void DEG_relations_tag_update_objects_added(struct Main *bmain);
+
 /* Add Dependencies  ----------------------------- */
 
 /* Handle for components to define their dependencies from callbacks.
@@ -375,6 +375,26 @@ void DepsgraphNodeBuilder::end_build()
   }
 }
 
+void DepsgraphNodeBuilder::begin_build_extend()
+{
+  /* Existing nodes are kept as they are, including their copy-on-write datablocks. The current
+   * state becomes the previous one, so only changes caused by the new nodes are tagged for update
+   * when finalizing the build. */
+  id_info_hash_ = BLI_ghash_ptr_new("Depsgraph id hash");
+  for (IDNode *id_node : graph_->id_nodes) {
+    IDInfo *id_info = (IDInfo *)MEM_mallocN(sizeof(IDInfo), "depsgraph id info");
+    id_info->id_cow = nullptr;
+    id_info->previously_visible_components_mask = id_node->visible_components_mask;
+    id_info->previous_eval_flags = id_node->eval_flags;
+    id_info->previous_customdata_masks = id_node->customdata_masks;
+    BLI_ghash_insert(id_info_hash_, id_node->id_orig, id_info);
+    id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+    built_map_.tagBuild(id_node->id_orig);
+  }
+}
+
 void DepsgraphNodeBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
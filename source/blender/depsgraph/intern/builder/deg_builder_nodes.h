@@ -98,6 +98,10 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void begin_build();
   virtual void end_build();
 
+  /* Begin adding nodes to the graph keeping all the nodes it already has,
+   * see #build_view_layer_objects_added. */
+  virtual void begin_build_extend();
+
   IDNode *add_id_node(ID *id);
   IDNode *find_id_node(ID *id);
   TimeSourceNode *add_time_source();
@@ -157,6 +161,11 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void build_view_layer(Scene *scene,
                                 ViewLayer *view_layer,
                                 eDepsNode_LinkedState_Type linked_state);
+  /* Build objects of the bases which were added to the view layer after the graph was built.
+   * These are all the bases pulled into the graph from #first_added_base_index on. */
+  virtual void build_view_layer_objects_added(Scene *scene,
+                                              ViewLayer *view_layer,
+                                              int first_added_base_index);
   virtual void build_collection(LayerCollection *from_layer_collection, Collection *collection);
   virtual void build_object(int base_index,
                             Object *object,
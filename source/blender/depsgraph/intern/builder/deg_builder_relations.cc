@@ -33,6 +33,7 @@
 
 #include "BLI_utildefines.h"
 #include "BLI_blenlib.h"
+#include "BLI_task.h"
 
 extern "C" {
 #include "DNA_action_types.h"
@@ -476,6 +477,13 @@ void DepsgraphRelationBuilder::begin_build()
 {
 }
 
+void DepsgraphRelationBuilder::begin_build_extend()
+{
+  for (IDNode *id_node : graph_->id_nodes) {
+    built_map_.tagBuild(id_node->id_orig);
+  }
+}
+
 void DepsgraphRelationBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -2540,10 +2548,34 @@ void DepsgraphRelationBuilder::build_scene_speakers(Scene * /*scene*/, ViewLayer
   }
 }
 
+static void build_copy_on_write_relations_func(void *__restrict data_v,
+                                               const int i,
+                                               const TaskParallelTLS *__restrict /*tls*/)
+{
+  DepsgraphRelationBuilder *builder = reinterpret_cast<DepsgraphRelationBuilder *>(data_v);
+  builder->build_copy_on_write_relations(builder->getGraph()->id_nodes[i]);
+}
+
 void DepsgraphRelationBuilder::build_copy_on_write_relations()
 {
-  for (IDNode *id_node : graph_->id_nodes) {
-    build_copy_on_write_relations(id_node);
+  build_copy_on_write_relations(0);
+}
+
+void DepsgraphRelationBuilder::build_copy_on_write_relations(int first_id_node_index)
+{
+  const int num_id_nodes = graph_->id_nodes.size();
+  /* Relations added for an ID only connect nodes of that ID,
+   * so the IDs are handled in parallel. */
+  {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(
+        first_id_node_index, num_id_nodes, this, build_copy_on_write_relations_func, &settings);
+  }
+  /* Relations between IDs modify the nodes of both IDs, they're added afterwards. */
+  for (int i = first_id_node_index; i < num_id_nodes; i++) {
+    build_copy_on_write_relations_between_ids(graph_->id_nodes[i]);
   }
 }
 
@@ -2668,6 +2700,12 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * to Mesh copy-on-write already. */
   }
   GHASH_FOREACH_END();
+}
+
+void DepsgraphRelationBuilder::build_copy_on_write_relations_between_ids(IDNode *id_node)
+{
+  ID *id_orig = id_node->id_orig;
+  OperationKey copy_on_write_key(id_orig, NodeType::COPY_ON_WRITE, OperationCode::COPY_ON_WRITE);
   /* TODO(sergey): This solves crash for now, but causes too many
    * updates potentially. */
   if (GS(id_orig->name) == ID_OB) {
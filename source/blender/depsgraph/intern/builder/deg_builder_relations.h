@@ -160,6 +160,9 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   DepsgraphRelationBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache);
 
   void begin_build();
+  /* Begin adding relations to the graph keeping all the relations it already has,
+   * see #build_view_layer_objects_added. */
+  void begin_build_extend();
 
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
@@ -203,6 +206,9 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   virtual void build_view_layer(Scene *scene,
                                 ViewLayer *view_layer,
                                 eDepsNode_LinkedState_Type linked_state);
+  virtual void build_view_layer_objects_added(Scene *scene,
+                                              ViewLayer *view_layer,
+                                              int first_added_base_index);
   virtual void build_collection(LayerCollection *from_layer_collection,
                                 Object *object,
                                 Collection *collection);
@@ -301,7 +307,10 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
                                          const char *name);
 
   virtual void build_copy_on_write_relations();
+  /* Only build copy-on-write relations of the ID nodes from #first_id_node_index on. */
+  virtual void build_copy_on_write_relations(int first_id_node_index);
   virtual void build_copy_on_write_relations(IDNode *id_node);
+  virtual void build_copy_on_write_relations_between_ids(IDNode *id_node);
 
   template<typename KeyType> OperationNode *find_operation_node(const KeyType &key);
 
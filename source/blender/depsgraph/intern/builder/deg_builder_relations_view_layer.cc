@@ -155,4 +155,20 @@ void DepsgraphRelationBuilder::build_view_layer(Scene *scene,
   }
 }
 
+void DepsgraphRelationBuilder::build_view_layer_objects_added(Scene *scene,
+                                                              ViewLayer *view_layer,
+                                                              int first_added_base_index)
+{
+  scene_ = scene;
+  int base_index = 0;
+  LISTBASE_FOREACH (Base *, base, &view_layer->object_bases) {
+    if (need_pull_base_into_graph(base)) {
+      if (base_index >= first_added_base_index) {
+        build_object(base, base->object);
+      }
+      base_index++;
+    }
+  }
+}
+
 }  // namespace DEG
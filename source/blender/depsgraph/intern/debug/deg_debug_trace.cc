@@ -0,0 +1,88 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Evaluation of all dependency graphs in the trace of #BLI_trace_begin.
+ *
+ * Every evaluated operation is a slice on the timeline of the thread which evaluated it, with the
+ * time it waited for a thread after it became ready as argument. The events of an evaluation are
+ * written once it's done and the file is flushed.
+ */
+
+#include "intern/debug/deg_debug_trace.h"
+
+#include "BLI_utildefines.h"
+#include "BLI_task.h"
+#include "BLI_trace.h"
+
+#include "intern/depsgraph.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace DEG {
+
+namespace {
+
+/* Operations are on their own process, thread IDs of task pools don't match the ones of zones. */
+const int TRACE_PROCESS_DEPSGRAPH = 1;
+
+void trace_write_operation(void *userdata,
+                           void *taskdata,
+                           int thread_id,
+                           double push_time,
+                           double start_time,
+                           double end_time)
+{
+  const Depsgraph *graph = (const Depsgraph *)userdata;
+  const OperationNode *operation_node = (const OperationNode *)taskdata;
+  BLI_trace_slice(TRACE_PROCESS_DEPSGRAPH,
+                  thread_id,
+                  operation_node->full_identifier().c_str(),
+                  "operation",
+                  graph->debug.name.c_str(),
+                  start_time,
+                  end_time,
+                  start_time - push_time);
+}
+
+}  // namespace
+
+bool deg_debug_trace_is_enabled()
+{
+  return BLI_trace_is_enabled();
+}
+
+void deg_debug_trace_write_evaluation(const Depsgraph *graph,
+                                      TaskPool *task_pool,
+                                      double start_time,
+                                      double end_time)
+{
+  BLI_trace_process_name_set(TRACE_PROCESS_DEPSGRAPH, "Depsgraph");
+  BLI_task_pool_profile_foreach_event(task_pool, trace_write_operation, (void *)graph);
+  /* Evaluation as a whole, on the timeline of the thread which waited for the operations. */
+  BLI_trace_slice(TRACE_PROCESS_DEPSGRAPH,
+                  0,
+                  "Evaluation",
+                  "evaluation",
+                  graph->debug.name.c_str(),
+                  start_time,
+                  end_time,
+                  0.0);
+  BLI_trace_flush();
+}
+
+}  // namespace DEG
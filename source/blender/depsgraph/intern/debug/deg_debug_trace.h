@@ -0,0 +1,39 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+struct TaskPool;
+
+namespace DEG {
+
+struct Depsgraph;
+
+/* Whether evaluation is being traced, see #BLI_trace_begin. */
+bool deg_debug_trace_is_enabled();
+
+/* Write operations evaluated by the task pool of an evaluation to the trace, the pool has
+ * profiling enabled (#BLI_task_pool_profile_enable) and all its tasks are done. */
+void deg_debug_trace_write_evaluation(const Depsgraph *graph,
+                                      TaskPool *task_pool,
+                                      double start_time,
+                                      double end_time);
+
+}  // namespace DEG
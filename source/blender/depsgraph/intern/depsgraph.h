@@ -110,6 +110,10 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update;
 
+  /* Relations only need to be updated for the objects which were added to the view layer,
+   * so the graph can be extended instead of being built from scratch. */
+  bool need_update_objects_added_only;
+
   /* Indicates which ID types were updated. */
   char id_type_updated[MAX_LIBARRAY];
 
@@ -125,6 +129,10 @@ struct Depsgraph {
    * scene frame changes, so then when dependency graph becomes visible it is on a proper state. */
   bool need_update_time;
 
+  /* Number of evaluations left before the next one which measures timings of operations,
+   * used to estimate operation costs for scheduling. */
+  int num_evaluations_until_cost_sample;
+
   /* Convenience Data ................... */
 
   /* XXX: should be collected after building (if actually needed?) */
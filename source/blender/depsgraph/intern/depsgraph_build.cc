@@ -34,9 +34,13 @@
 
 extern "C" {
 #include "DNA_cachefile_types.h"
+#include "DNA_collection_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_force_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "BKE_collection.h"
 #include "BKE_main.h"
 #include "BKE_scene.h"
 } /* extern "C" */
@@ -223,6 +227,9 @@ static void graph_build_finalize_common(DEG::Depsgraph *deg_graph, Main *bmain)
 #endif
   /* Relations are up to date. */
   deg_graph->need_update = false;
+  deg_graph->need_update_objects_added_only = false;
+  /* Measure costs of the new operations on the next evaluation. */
+  deg_graph->num_evaluations_until_cost_sample = 0;
 }
 
 /* Build depsgraph for the given scene layer, and dump results in given graph container. */
@@ -466,11 +473,160 @@ void DEG_graph_build_from_ids(Depsgraph *graph,
   }
 }
 
-/* Tag graph relations for update. */
-void DEG_graph_tag_relations_update(Depsgraph *graph)
+/* Extending the graph with objects added to the view layer.
+ *
+ * Nodes and relations of the new objects are added to the existing graph, which is much cheaper
+ * than building it again when adding objects to a big scene. This is only done when the new
+ * objects can't change anything about the objects which are already in the graph, otherwise
+ * the graph is built from scratch. */
+
+namespace DEG {
+namespace {
+
+bool object_can_extend_graph(const Depsgraph *graph, Object *object)
+{
+  /* Objects which affect other objects through physics or the scene. */
+  if (object->pd != nullptr && object->pd->forcefield != PFIELD_NULL) {
+    return false;
+  }
+  if (object->rigidbody_object != nullptr || object->rigidbody_constraint != nullptr) {
+    return false;
+  }
+  if (object->type == OB_SPEAKER || object->proxy != nullptr || object->proxy_group != nullptr) {
+    return false;
+  }
+  if (!BLI_listbase_is_empty(&object->particlesystem)) {
+    return false;
+  }
+  LISTBASE_FOREACH (ModifierData *, md, &object->modifiers) {
+    if (ELEM(md->type,
+             eModifierType_Collision,
+             eModifierType_DynamicPaint,
+             eModifierType_Fluid,
+             eModifierType_Fluidsim,
+             eModifierType_Surface)) {
+      return false;
+    }
+  }
+  /* Instanced collections which are already in the graph must have their objects built. */
+  if (object->instance_collection != nullptr) {
+    const IDNode *id_node = graph->find_id_node(&object->instance_collection->id);
+    if (id_node != nullptr && !id_node->is_collection_fully_expanded) {
+      return false;
+    }
+  }
+  /* Collections which are instanced or otherwise fully expanded depend on all their objects. */
+  for (const IDNode *id_node : graph->id_nodes) {
+    if (GS(id_node->id_orig->name) == ID_GR && id_node->is_collection_fully_expanded &&
+        BKE_collection_has_object_recursive((Collection *)id_node->id_orig, object)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool layer_collections_are_in_graph(const Depsgraph *graph, ListBase *lb)
+{
+  const int restrict_flag = (graph->mode == DAG_EVAL_VIEWPORT) ? COLLECTION_RESTRICT_VIEWPORT :
+                                                                 COLLECTION_RESTRICT_RENDER;
+  LISTBASE_FOREACH (LayerCollection *, lc, lb) {
+    if (lc->collection->flag & restrict_flag) {
+      continue;
+    }
+    if ((lc->flag & LAYER_COLLECTION_EXCLUDE) == 0 &&
+        graph->find_id_node(&lc->collection->id) == nullptr) {
+      return false;
+    }
+    if (!layer_collections_are_in_graph(graph, &lc->layer_collections)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Get index of the first base added since the graph was built, among the bases pulled into the
+ * graph. Returns -1 when the graph can't be extended with the objects of the added bases. */
+int view_layer_first_added_base_index(const Depsgraph *graph,
+                                      DepsgraphBuilder *builder,
+                                      ViewLayer *view_layer)
+{
+  int first_added_base_index = -1;
+  int base_index = 0;
+  LISTBASE_FOREACH (Base *, base, &view_layer->object_bases) {
+    if (!builder->need_pull_base_into_graph(base)) {
+      continue;
+    }
+    const IDNode *id_node = graph->find_id_node(&base->object->id);
+    if (id_node == nullptr) {
+      if (!object_can_extend_graph(graph, base->object)) {
+        return -1;
+      }
+      if (first_added_base_index == -1) {
+        first_added_base_index = base_index;
+      }
+    }
+    else if (first_added_base_index != -1 || !id_node->has_base) {
+      /* Base indices of objects which are in the graph would change. */
+      return -1;
+    }
+    base_index++;
+  }
+  if (first_added_base_index == -1) {
+    /* Nothing was added, build from scratch to be on the safe side. */
+    return -1;
+  }
+  if (!layer_collections_are_in_graph(graph, &view_layer->layer_collections)) {
+    return -1;
+  }
+  return first_added_base_index;
+}
+
+bool graph_build_extend_with_added_objects(Depsgraph *deg_graph,
+                                           Main *bmain,
+                                           Scene *scene,
+                                           ViewLayer *view_layer)
+{
+  if (deg_graph->is_render_pipeline_depsgraph || deg_graph->scene != scene ||
+      deg_graph->view_layer != view_layer || deg_graph->find_id_node(&scene->id) == nullptr) {
+    return false;
+  }
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = PIL_check_seconds_timer();
+  }
+  DepsgraphBuilderCache builder_cache;
+  DepsgraphNodeBuilder node_builder(bmain, deg_graph, &builder_cache);
+  const int first_added_base_index = view_layer_first_added_base_index(
+      deg_graph, &node_builder, view_layer);
+  if (first_added_base_index == -1) {
+    return false;
+  }
+  const int first_added_id_node_index = deg_graph->id_nodes.size();
+  /* Generate nodes of the added objects. */
+  node_builder.begin_build_extend();
+  node_builder.build_view_layer_objects_added(scene, view_layer, first_added_base_index);
+  node_builder.end_build();
+  /* Hook up relationships of the added objects. */
+  DepsgraphRelationBuilder relation_builder(bmain, deg_graph, &builder_cache);
+  relation_builder.begin_build_extend();
+  relation_builder.build_view_layer_objects_added(scene, view_layer, first_added_base_index);
+  relation_builder.build_copy_on_write_relations(first_added_id_node_index);
+  /* Finalize building. */
+  graph_build_finalize_common(deg_graph, bmain);
+  /* Finish statistics. */
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    printf("Depsgraph extended with %d IDs in %f seconds.\n",
+           (int)deg_graph->id_nodes.size() - first_added_id_node_index,
+           PIL_check_seconds_timer() - start_time);
+  }
+  return true;
+}
+
+}  // namespace
+}  // namespace DEG
+
+static void deg_graph_tag_relations_update(DEG::Depsgraph *deg_graph)
 {
-  DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
-  DEG::Depsgraph *deg_graph = reinterpret_cast<DEG::Depsgraph *>(graph);
   deg_graph->need_update = true;
   /* NOTE: When relations are updated, it's quite possible that
    * we've got new bases in the scene. This means, we need to
@@ -484,6 +640,26 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   }
 }
 
+/* Tag graph relations for update. */
+void DEG_graph_tag_relations_update(Depsgraph *graph)
+{
+  DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
+  DEG::Depsgraph *deg_graph = reinterpret_cast<DEG::Depsgraph *>(graph);
+  deg_graph->need_update_objects_added_only = false;
+  deg_graph_tag_relations_update(deg_graph);
+}
+
+/* Tag graph relations for update after objects were added. */
+void DEG_graph_tag_relations_update_objects_added(Depsgraph *graph)
+{
+  DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
+  DEG::Depsgraph *deg_graph = reinterpret_cast<DEG::Depsgraph *>(graph);
+  if (!deg_graph->need_update) {
+    deg_graph->need_update_objects_added_only = true;
+  }
+  deg_graph_tag_relations_update(deg_graph);
+}
+
 /* Create or update relations in the specified graph. */
 void DEG_graph_relations_update(Depsgraph *graph, Main *bmain, Scene *scene, ViewLayer *view_layer)
 {
@@ -492,6 +668,10 @@ void DEG_graph_relations_update(Depsgraph *graph, Main *bmain, Scene *scene, Vie
     /* Graph is up to date, nothing to do. */
     return;
   }
+  if (deg_graph->need_update_objects_added_only &&
+      DEG::graph_build_extend_with_added_objects(deg_graph, bmain, scene, view_layer)) {
+    return;
+  }
   DEG_graph_build_from_view_layer(graph, bmain, scene, view_layer);
 }
 
@@ -503,3 +683,12 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+/* Tag all relations for update after objects were added. */
+void DEG_relations_tag_update_objects_added(Main *bmain)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations for update.\n", __func__);
+  for (DEG::Depsgraph *depsgraph : DEG::get_all_registered_graphs(bmain)) {
+    DEG_graph_tag_relations_update_objects_added(reinterpret_cast<Depsgraph *>(depsgraph));
+  }
+}
@@ -0,0 +1,259 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Evaluation of upcoming frames on multiple dependency graphs in parallel.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_task.h"
+#include "BLI_threads.h"
+#include "BLI_utildefines.h"
+
+extern "C" {
+#include "BKE_scene.h"
+} /* extern "C" */
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "intern/eval/deg_eval.h"
+#include "intern/eval/deg_eval_flush.h"
+
+#include "intern/node/deg_node_time.h"
+
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_registry.h"
+
+namespace DEG {
+
+namespace {
+
+enum eFrameSlotState {
+  /* Graph is not used, a new frame can be evaluated on it. */
+  FRAME_SLOT_FREE,
+  /* Frame is being evaluated (or waits to be). */
+  FRAME_SLOT_EVALUATING,
+  /* Frame is evaluated and waits to be handed out. */
+  FRAME_SLOT_READY,
+  /* Frame was handed out, and not released yet. */
+  FRAME_SLOT_IN_USE,
+};
+
+struct FrameSlot {
+  Depsgraph *graph;
+  int frame;
+  eFrameSlotState state;
+};
+
+}  // namespace
+
+}  // namespace DEG
+
+struct DepsgraphFrameQueue {
+  Main *bmain;
+  DEG::vector<DEG::FrameSlot> slots;
+
+  TaskPool *task_pool;
+  ThreadMutex mutex;
+  ThreadCondition condition;
+
+  /* Next frame to be scheduled for evaluation. */
+  int frame_scheduled;
+  /* Next frame to be handed out. */
+  int frame_next;
+  int frame_end;
+  int frame_step;
+};
+
+namespace DEG {
+
+namespace {
+
+/* Similar to DEG_evaluate_on_framechange(), but doesn't take the frame from the original scene,
+ * which stays at the current frame. */
+void frame_queue_evaluate_frame(Main *bmain, Depsgraph *graph, const int frame)
+{
+  const float ctime = (float)frame;
+  graph->ctime = ctime;
+  TimeSourceNode *time_source = graph->find_time_source();
+  time_source->cfra = ctime;
+  time_source->tag_update(graph, DEG_UPDATE_SOURCE_TIME);
+  deg_graph_flush_updates(bmain, graph);
+  if (graph->scene_cow) {
+    BKE_scene_frame_set(graph->scene_cow, ctime);
+  }
+  deg_evaluate_on_refresh(graph);
+}
+
+void frame_queue_evaluate_task(TaskPool *__restrict pool, void *taskdata, int /*threadid*/)
+{
+  DepsgraphFrameQueue *queue = reinterpret_cast<DepsgraphFrameQueue *>(
+      BLI_task_pool_userdata(pool));
+  FrameSlot *slot = reinterpret_cast<FrameSlot *>(taskdata);
+  frame_queue_evaluate_frame(queue->bmain, slot->graph, slot->frame);
+
+  BLI_mutex_lock(&queue->mutex);
+  slot->state = FRAME_SLOT_READY;
+  BLI_condition_notify_all(&queue->condition);
+  BLI_mutex_unlock(&queue->mutex);
+}
+
+/* Evaluate the next scheduled frame on the free slot, called with the queue mutex locked. */
+void frame_queue_schedule(DepsgraphFrameQueue *queue, FrameSlot *slot)
+{
+  BLI_assert(slot->state == FRAME_SLOT_FREE);
+  if (queue->frame_scheduled > queue->frame_end) {
+    return;
+  }
+  slot->frame = queue->frame_scheduled;
+  slot->state = FRAME_SLOT_EVALUATING;
+  queue->frame_scheduled += queue->frame_step;
+  BLI_task_pool_push(queue->task_pool, frame_queue_evaluate_task, slot, false, TASK_PRIORITY_LOW);
+}
+
+}  // namespace
+
+}  // namespace DEG
+
+DepsgraphFrameQueue *DEG_frame_queue_new(Main *bmain,
+                                         Scene *scene,
+                                         ViewLayer *view_layer,
+                                         eEvaluationMode mode,
+                                         int num_depsgraphs)
+{
+  BLI_assert(num_depsgraphs > 0);
+  DepsgraphFrameQueue *queue = OBJECT_GUARDED_NEW(DepsgraphFrameQueue);
+  queue->bmain = bmain;
+  queue->slots.resize(num_depsgraphs);
+  for (DEG::FrameSlot &slot : queue->slots) {
+    Depsgraph *graph = DEG_graph_new(bmain, scene, view_layer, mode);
+    DEG_graph_build_from_view_layer(graph, bmain, scene, view_layer);
+    slot.graph = reinterpret_cast<DEG::Depsgraph *>(graph);
+    slot.frame = 0;
+    slot.state = DEG::FRAME_SLOT_FREE;
+    /* The graphs are evaluated from other threads while the original data-blocks are tagged for
+     * updates from the main thread, keep them out of the registry which is used by tagging. */
+    DEG::unregister_graph(slot.graph);
+  }
+  /* Frames take long to evaluate, so don't have them run from the main thread. */
+  queue->task_pool = BLI_task_pool_create_background(BLI_task_scheduler_get(), queue);
+  BLI_mutex_init(&queue->mutex);
+  BLI_condition_init(&queue->condition);
+  queue->frame_scheduled = 0;
+  queue->frame_next = 0;
+  queue->frame_end = -1;
+  queue->frame_step = 1;
+  return queue;
+}
+
+void DEG_frame_queue_free(DepsgraphFrameQueue *queue)
+{
+  BLI_task_pool_cancel(queue->task_pool);
+  BLI_task_pool_free(queue->task_pool);
+  for (DEG::FrameSlot &slot : queue->slots) {
+    DEG::register_graph(slot.graph);
+    DEG_graph_free(reinterpret_cast<Depsgraph *>(slot.graph));
+  }
+  BLI_condition_end(&queue->condition);
+  BLI_mutex_end(&queue->mutex);
+  OBJECT_GUARDED_DELETE(queue, DepsgraphFrameQueue);
+}
+
+void DEG_frame_queue_begin(DepsgraphFrameQueue *queue,
+                           int frame_start,
+                           int frame_end,
+                           int frame_step)
+{
+  BLI_assert(frame_step > 0);
+  /* Frames of a previous range are not needed anymore. */
+  BLI_task_pool_cancel(queue->task_pool);
+
+  BLI_mutex_lock(&queue->mutex);
+  queue->frame_scheduled = frame_start;
+  queue->frame_next = frame_start;
+  queue->frame_end = frame_end;
+  queue->frame_step = frame_step;
+  for (DEG::FrameSlot &slot : queue->slots) {
+    if (slot.state == DEG::FRAME_SLOT_IN_USE) {
+      continue;
+    }
+    slot.state = DEG::FRAME_SLOT_FREE;
+    DEG::frame_queue_schedule(queue, &slot);
+  }
+  BLI_mutex_unlock(&queue->mutex);
+}
+
+Depsgraph *DEG_frame_queue_next(DepsgraphFrameQueue *queue, int *r_frame)
+{
+  DEG::FrameSlot *result = nullptr;
+
+  BLI_mutex_lock(&queue->mutex);
+  while (queue->frame_next <= queue->frame_end) {
+    DEG::FrameSlot *slot_next = nullptr;
+    for (DEG::FrameSlot &slot : queue->slots) {
+      if (slot.state != DEG::FRAME_SLOT_FREE && slot.state != DEG::FRAME_SLOT_IN_USE &&
+          slot.frame == queue->frame_next) {
+        slot_next = &slot;
+        break;
+      }
+    }
+    /* All graphs are handed out and not released, no way to evaluate the frame. */
+    BLI_assert(slot_next != nullptr);
+    if (slot_next == nullptr) {
+      break;
+    }
+    if (slot_next->state == DEG::FRAME_SLOT_READY) {
+      slot_next->state = DEG::FRAME_SLOT_IN_USE;
+      queue->frame_next += queue->frame_step;
+      result = slot_next;
+      break;
+    }
+    BLI_condition_wait(&queue->condition, &queue->mutex);
+  }
+  BLI_mutex_unlock(&queue->mutex);
+
+  if (result == nullptr) {
+    return nullptr;
+  }
+  if (r_frame != nullptr) {
+    *r_frame = result->frame;
+  }
+  return reinterpret_cast<Depsgraph *>(result->graph);
+}
+
+void DEG_frame_queue_release(DepsgraphFrameQueue *queue, Depsgraph *graph)
+{
+  /* The graph is not evaluated, safe to clear the tags as done after regular updates. */
+  DEG_ids_clear_recalc(queue->bmain, graph);
+
+  BLI_mutex_lock(&queue->mutex);
+  for (DEG::FrameSlot &slot : queue->slots) {
+    if (slot.graph == reinterpret_cast<DEG::Depsgraph *>(graph)) {
+      BLI_assert(slot.state == DEG::FRAME_SLOT_IN_USE);
+      slot.state = DEG::FRAME_SLOT_FREE;
+      DEG::frame_queue_schedule(queue, &slot);
+      break;
+    }
+  }
+  BLI_mutex_unlock(&queue->mutex);
+}
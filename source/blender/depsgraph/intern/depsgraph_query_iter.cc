@@ -221,7 +221,8 @@ void deg_iterator_objects_step(BLI_Iterator *iter, DEG::IDNode *id_node)
   }
 
   if (ob_visibility & OB_VISIBLE_INSTANCES) {
-    if ((data->flag & DEG_ITER_OBJECT_FLAG_DUPLI) && (object->transflag & OB_DUPLI)) {
+    if ((data->flag & DEG_ITER_OBJECT_FLAG_DUPLI) &&
+        ((object->transflag & OB_DUPLI) || BKE_object_has_mesh_instances(object))) {
       data->dupli_parent = object;
       data->dupli_list = object_duplilist(data->graph, data->scene, object);
       data->dupli_object_next = (DupliObject *)data->dupli_list->first;
@@ -27,11 +27,14 @@
 
 #include "PIL_time.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_utildefines.h"
 #include "BLI_task.h"
 #include "BLI_ghash.h"
 #include "BLI_gsqueue.h"
+#include "BLI_vector.h"
 
 #include "BKE_global.h"
 
@@ -43,6 +46,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/eval/deg_eval_copy_on_write.h"
 #include "intern/eval/deg_eval_flush.h"
 #include "intern/eval/deg_eval_stats.h"
@@ -58,6 +62,10 @@ namespace DEG {
 
 namespace {
 
+/* Measure timings of the operations once every this many evaluations, to keep the estimated costs
+ * of operations up to date without timing every single evaluation. */
+const int COST_SAMPLE_INTERVAL = 8;
+
 struct DepsgraphEvalState;
 
 void deg_task_run_func(TaskPool *pool, void *taskdata, int thread_id);
@@ -69,10 +77,32 @@ void schedule_children(DepsgraphEvalState *state,
                        ScheduleFunction *schedule_function,
                        ScheduleFunctionArgs... schedule_function_args);
 
-void schedule_node_to_pool(OperationNode *node, const int thread_id, TaskPool *pool)
+/* Operations which became ready for evaluation, pushed to the task pool in one go. */
+typedef BLI::Vector<OperationNode *, 16> ReadyOperations;
+
+void schedule_node_to_ready_operations(OperationNode *node,
+                                       const int /*thread_id*/,
+                                       ReadyOperations *ready_operations)
 {
-  BLI_task_pool_push_from_thread(
-      pool, deg_task_run_func, node, false, TASK_PRIORITY_HIGH, thread_id);
+  ready_operations->append(node);
+}
+
+bool operation_critical_path_cost_less(const OperationNode *a, const OperationNode *b)
+{
+  return a->critical_path_cost < b->critical_path_cost;
+}
+
+void push_ready_operations_to_pool(ReadyOperations &ready_operations,
+                                   const int thread_id,
+                                   TaskPool *pool)
+{
+  /* Tasks pushed last are picked up first, so push by increasing cost of the longest chain of
+   * operations, which makes the most expensive chain start first. */
+  std::sort(ready_operations.begin(), ready_operations.end(), operation_critical_path_cost_less);
+  for (OperationNode *node : ready_operations) {
+    BLI_task_pool_push_from_thread(
+        pool, deg_task_run_func, node, false, TASK_PRIORITY_HIGH, thread_id);
+  }
 }
 
 /* Denotes which part of dependency graph is being evaluated. */
@@ -106,6 +136,7 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert(!operation_node->is_noop() && "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_EVALUATED);
   if (state->do_stats) {
     const double start_time = PIL_check_seconds_timer();
     operation_node->evaluate(depsgraph);
@@ -114,6 +145,7 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   else {
     operation_node->evaluate(depsgraph);
   }
+  MEM_category_end(category_prev);
 }
 
 void deg_task_run_func(TaskPool *pool, void *taskdata, int thread_id)
@@ -126,8 +158,11 @@ void deg_task_run_func(TaskPool *pool, void *taskdata, int thread_id)
   evaluate_node(state, operation_node);
 
   /* Schedule children. */
+  ReadyOperations ready_operations;
+  schedule_children(
+      state, operation_node, thread_id, schedule_node_to_ready_operations, &ready_operations);
   BLI_task_pool_delayed_push_begin(pool, thread_id);
-  schedule_children(state, operation_node, thread_id, schedule_node_to_pool, pool);
+  push_ready_operations_to_pool(ready_operations, thread_id, pool);
   BLI_task_pool_delayed_push_end(pool, thread_id);
 }
 
@@ -336,6 +371,13 @@ void evaluate_graph_single_threaded(DepsgraphEvalState *state)
   BLI_gsqueue_free(evaluation_queue);
 }
 
+void schedule_graph_to_pool(DepsgraphEvalState *state, TaskPool *pool)
+{
+  ReadyOperations ready_operations;
+  schedule_graph(state, schedule_node_to_ready_operations, &ready_operations);
+  push_ready_operations_to_pool(ready_operations, -1, pool);
+}
+
 void depsgraph_ensure_view_layer(Depsgraph *graph)
 {
   /* We update copy-on-write scene in the following cases:
@@ -373,7 +415,6 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   /* Set up evaluation state. */
   DepsgraphEvalState state;
   state.graph = graph;
-  state.do_stats = graph->debug.do_time_debug();
   state.need_single_thread_pass = false;
   /* Set up task scheduler and pull for threaded evaluation. */
   TaskScheduler *task_scheduler;
@@ -386,7 +427,23 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
     task_scheduler = BLI_task_scheduler_get();
     need_free_scheduler = false;
   }
+  /* Costs of operations are only used to decide which ones to start first, which doesn't matter
+   * when there is a single thread. */
+  bool do_cost_sample = false;
+  if (BLI_task_scheduler_num_threads(task_scheduler) > 1) {
+    if (graph->num_evaluations_until_cost_sample == 0) {
+      graph->num_evaluations_until_cost_sample = COST_SAMPLE_INTERVAL;
+      do_cost_sample = true;
+    }
+    graph->num_evaluations_until_cost_sample--;
+  }
+  state.do_stats = do_cost_sample || graph->debug.do_time_debug();
   TaskPool *task_pool = BLI_task_pool_create_suspended(task_scheduler, &state);
+  const bool do_trace = deg_debug_trace_is_enabled();
+  const double trace_start_time = do_trace ? PIL_check_seconds_timer() : 0.0;
+  if (do_trace) {
+    BLI_task_pool_profile_enable(task_pool, "Depsgraph");
+  }
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
 
@@ -394,13 +451,17 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_wait_and_reset(task_pool);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
+  if (do_trace) {
+    deg_debug_trace_write_evaluation(
+        graph, task_pool, trace_start_time, PIL_check_seconds_timer());
+  }
   BLI_task_pool_free(task_pool);
 
   if (state.need_single_thread_pass) {
@@ -413,6 +474,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
    * synchronization. */
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
+    deg_eval_stats_update_critical_path(graph);
   }
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
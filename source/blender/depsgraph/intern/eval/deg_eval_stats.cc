@@ -25,8 +25,10 @@
 
 #include "BLI_utildefines.h"
 #include "BLI_ghash.h"
+#include "BLI_stack.h"
 
 #include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
@@ -56,4 +58,56 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_stats_update_critical_path(Depsgraph *graph)
+{
+  /* Weight of the latest timing in the average, smooths out noise of individual timings. */
+  const double average_factor = 0.25;
+  /* Start with operations which have no operations depending on them, their cost is the cost of
+   * the operation itself. Then go up to the operations they depend on, once all the operations
+   * depending on those are handled. */
+  BLI_Stack *stack = BLI_stack_new(sizeof(OperationNode *), "DEG critical path stack");
+  for (OperationNode *op_node : graph->operations) {
+    /* Operations which were not evaluated this time keep the average time they had. */
+    if (op_node->stats.current_time > 0.0) {
+      if (op_node->stats.average_time == 0.0) {
+        op_node->stats.average_time = op_node->stats.current_time;
+      }
+      else {
+        op_node->stats.average_time += (op_node->stats.current_time -
+                                        op_node->stats.average_time) *
+                                       average_factor;
+      }
+    }
+    op_node->critical_path_cost = 0.0;
+    op_node->num_links_pending = 0;
+    for (Relation *rel : op_node->outlinks) {
+      if ((rel->to->type == NodeType::OPERATION) && (rel->flag & RELATION_FLAG_CYCLIC) == 0) {
+        ++op_node->num_links_pending;
+      }
+    }
+    if (op_node->num_links_pending == 0) {
+      BLI_stack_push(stack, &op_node);
+    }
+  }
+  while (!BLI_stack_is_empty(stack)) {
+    OperationNode *op_node;
+    BLI_stack_pop(stack, &op_node);
+    /* All operations depending on this one are handled, so the maximum is known. */
+    op_node->critical_path_cost += op_node->stats.average_time;
+    for (Relation *rel : op_node->inlinks) {
+      if ((rel->from->type != NodeType::OPERATION) || (rel->flag & RELATION_FLAG_CYCLIC) != 0) {
+        continue;
+      }
+      OperationNode *op_from = (OperationNode *)rel->from;
+      op_from->critical_path_cost = max(op_from->critical_path_cost,
+                                        op_node->critical_path_cost);
+      BLI_assert(op_from->num_links_pending > 0);
+      if (--op_from->num_links_pending == 0) {
+        BLI_stack_push(stack, &op_from);
+      }
+    }
+  }
+  BLI_stack_free(stack);
+}
+
 }  // namespace DEG
@@ -30,4 +30,8 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Accumulate timings of the evaluated operations into their average time, and update the
+ * critical path cost of all operations from it. */
+void deg_eval_stats_update_critical_path(Depsgraph *graph);
+
 }  // namespace DEG
@@ -259,6 +259,11 @@ struct OperationNode : public Node {
   /* (OperationFlag) extra settings affecting evaluation. */
   int flag;
 
+  /* Estimated time to evaluate this operation and the longest chain of operations depending on
+   * it, based on timings of previous evaluations. Operations with the higher cost are scheduled
+   * first, so the long chains don't start late. */
+  double critical_path_cost;
+
   DEG_DEPSNODE_DECLARE;
 };
 
@@ -159,6 +159,10 @@ void DRW_opengl_context_disable(void);
 /* For garbage collection */
 void DRW_cache_free_old_batches(struct Main *bmain);
 
+/* Profiling, record the viewport timings to a file. */
+bool DRW_stats_record_begin(const char *filepath);
+void DRW_stats_record_end(void);
+
 /* Never use this. Only for closing blender. */
 void DRW_opengl_context_enable_ex(bool restore);
 void DRW_opengl_context_disable_ex(bool restore);
@@ -67,6 +67,9 @@
 #  define IRRADIANCE_FORMAT GPU_RGBA8
 #endif
 
+/* Irradiance samples rendered with the same draw cache when baking in a job. */
+#define LIGHTBAKE_GRID_SAMPLE_BATCH_LEN 16
+
 /* OpenGL 3.3 core requirement, can be extended but it's already very big */
 #define IRRADIANCE_MAX_POOL_LAYER 256
 #define IRRADIANCE_MAX_POOL_SIZE 1024
@@ -130,6 +133,8 @@ typedef struct EEVEE_LightBake {
   int grid_sample;
   /** Total number of samples for the current grid. */
   int grid_sample_len;
+  /** Number of grid samples rendered using the same draw cache. */
+  int grid_sample_batch_len;
   /** Nth grid in the cache being rendered. */
   int grid_curr;
   /** The current light bounce being evaluated. */
@@ -911,7 +916,9 @@ static void grid_loc_to_world_loc(EEVEE_LightGrid *egrid, int local_cell[3], flo
   madd_v3_v3fl(r_pos, egrid->increment_z, local_cell[2]);
 }
 
-static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
+static void eevee_lightbake_render_grid_sample(void *ved,
+                                               void *user_data,
+                                               const bool is_first_batch_sample)
 {
   EEVEE_Data *vedata = (EEVEE_Data *)ved;
   EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
@@ -934,7 +941,9 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
 
   /* TODO do this once for the whole bake when we have independent DRWManagers.
    * Warning: Some of the things above require this. */
-  eevee_lightbake_cache_create(vedata, lbake);
+  if (is_first_batch_sample) {
+    eevee_lightbake_cache_create(vedata, lbake);
+  }
 
   /* Compute sample position */
   compute_cell_id(egrid, prb, lbake->grid_sample, &sample_id, grid_loc, &stride);
@@ -995,6 +1004,20 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   }
 }
 
+/* Render several samples of the same grid and bounce in one draw pipeline: the scene draw cache
+ * does not change between them so it is only created for the first one. */
+static void eevee_lightbake_render_grid_sample_batch(void *ved, void *user_data)
+{
+  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
+  const int sample_start = lbake->grid_sample;
+
+  for (int i = 0; i < lbake->grid_sample_batch_len; i++) {
+    lbake->grid_sample = sample_start + i;
+    eevee_lightbake_render_grid_sample(ved, user_data, i == 0);
+  }
+  lbake->grid_sample = sample_start;
+}
+
 static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
 {
   EEVEE_Data *vedata = (EEVEE_Data *)ved;
@@ -1150,7 +1173,8 @@ void EEVEE_lightbake_update(void *custom_data)
 }
 
 static bool lightbake_do_sample(EEVEE_LightBake *lbake,
-                                void (*render_callback)(void *ved, void *user_data))
+                                void (*render_callback)(void *ved, void *user_data),
+                                int samples_len)
 {
   if (G.is_break == true || *lbake->stop) {
     return false;
@@ -1161,7 +1185,7 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   /* TODO: make DRW manager instanciable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
+  lbake->done += samples_len;
   *lbake->progress = lbake->done / (float)lbake->total;
   *lbake->do_update = 1;
   eevee_lightbake_context_disable(lbake);
@@ -1208,11 +1232,14 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
   /* Render world irradiance and reflection first */
   if (lcache->flag & LIGHTCACHE_UPDATE_WORLD) {
     lbake->probe = NULL;
-    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample);
+    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample, 1);
   }
 
   /* Render irradiance grids */
   if (lcache->flag & LIGHTCACHE_UPDATE_GRID) {
+    /* The draw manager is locked while rendering a batch, keep them small when baking in a job
+     * so the interface stays responsive. */
+    const int batch_len = (lbake->gl_context) ? LIGHTBAKE_GRID_SAMPLE_BATCH_LEN : INT_MAX;
     for (lbake->bounce_curr = 0; lbake->bounce_curr < lbake->bounce_len; lbake->bounce_curr++) {
       /* Bypass world, start at 1. */
       lbake->probe = lbake->grid_prb + 1;
@@ -1223,8 +1250,11 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
         for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
-             ++lbake->grid_sample) {
-          lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
+             lbake->grid_sample += lbake->grid_sample_batch_len) {
+          lbake->grid_sample_batch_len = min_ii(batch_len,
+                                                lbake->grid_sample_len - lbake->grid_sample);
+          lightbake_do_sample(
+              lbake, eevee_lightbake_render_grid_sample_batch, lbake->grid_sample_batch_len);
         }
       }
     }
@@ -1237,7 +1267,7 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample, 1);
     }
   }
 
@@ -402,6 +402,14 @@ typedef struct EEVEE_ShadowCascadeRender {
   float cascade_exponent;
   float cascade_fade;
   int cascade_count;
+  /* Last rendered state of the cascades, used to skip rendering them when nothing changed. */
+  float cache_shadowmat[MAX_CASCADE_NUM][4][4];
+  int cache_tex_id, cache_cascade_count;
+  bool cache_valid;
+  /* AABB of the shadow casters updated or deleted since the cascades were last rendered. */
+  struct {
+    float min[3], max[3];
+  } dirty_aabb;
 } EEVEE_ShadowCascadeRender;
 
 BLI_STATIC_ASSERT_ALIGN(EEVEE_Light, 16)
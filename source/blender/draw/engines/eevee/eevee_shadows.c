@@ -255,6 +255,15 @@ static bool sphere_bbox_intersect(const BoundSphere *bs, const EEVEE_BoundBox *b
   return x && y && z;
 }
 
+static void shadow_caster_bbox_minmax(const EEVEE_BoundBox *bb, float min[3], float max[3])
+{
+  float vec[3];
+  sub_v3_v3v3(vec, bb->center, bb->halfdim);
+  minmax_v3v3_v3(min, max, vec);
+  add_v3_v3v3(vec, bb->center, bb->halfdim);
+  minmax_v3v3_v3(min, max, vec);
+}
+
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 {
   EEVEE_StorageList *stl = vedata->stl;
@@ -291,6 +300,10 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   }
 
   if (!sldata->shadow_cascade_pool) {
+    /* Previous cascade renders are lost. */
+    for (int i = 0; i < MAX_SHADOW_CASCADE; i++) {
+      linfo->shadow_cascade_render[i].cache_valid = false;
+    }
     sldata->shadow_cascade_pool = DRW_texture_create_2d_array(linfo->shadow_cascade_size,
                                                               linfo->shadow_cascade_size,
                                                               max_ii(1, linfo->num_cascade_layer),
@@ -312,6 +325,11 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     }
   }
 
+  /* Bounds of all updated shadow casters, cascades cover the whole scene so they are only
+   * tested against it when drawn. */
+  float dirty_min[3], dirty_max[3];
+  INIT_MINMAX(dirty_min, dirty_max);
+
   /* TODO(fclem) This part can be slow, optimize it. */
   EEVEE_BoundBox *bbox = backbuffer->bbox;
   BoundSphere *bsphere = linfo->shadow_bounds;
@@ -319,6 +337,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadowcaster has been deleted or updated. */
     if (BLI_BITMAP_TEST(backbuffer->update, i)) {
+      shadow_caster_bbox_minmax(&bbox[i], dirty_min, dirty_max);
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
@@ -333,6 +352,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < frontbuffer->count; i++) {
     /* If the shadowcaster has been updated. */
     if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
+      shadow_caster_bbox_minmax(&bbox[i], dirty_min, dirty_max);
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
@@ -343,6 +363,14 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     }
   }
 
+  if (dirty_min[0] <= dirty_max[0]) {
+    for (int j = 0; j < linfo->cascade_len; j++) {
+      EEVEE_ShadowCascadeRender *csm_render = linfo->shadow_cascade_render + j;
+      minmax_v3v3_v3(csm_render->dirty_aabb.min, csm_render->dirty_aabb.max, dirty_min);
+      minmax_v3v3_v3(csm_render->dirty_aabb.min, csm_render->dirty_aabb.max, dirty_max);
+    }
+  }
+
   /* Resize shcasters buffers if too big. */
   if (frontbuffer->alloc_count - frontbuffer->count > SH_CASTER_ALLOC_CHUNK) {
     frontbuffer->alloc_count = (frontbuffer->count / SH_CASTER_ALLOC_CHUNK) *
@@ -397,6 +397,42 @@ static void eevee_ensure_cascade_views(EEVEE_ShadowCascadeRender *csm_render,
   }
 }
 
+/* Return true if the cascade layer still contains a valid render: same matrices as when it was
+ * last rendered and none of the updated shadow casters are inside its bounds. */
+static bool eevee_shadow_cascade_is_cached(const EEVEE_ShadowCascade *csm_data,
+                                           const EEVEE_ShadowCascadeRender *csm_render,
+                                           int cascade)
+{
+  if (!equals_m4m4(csm_render->cache_shadowmat[cascade], csm_data->shadowmat[cascade])) {
+    return false;
+  }
+
+  const float *dirty_min = csm_render->dirty_aabb.min;
+  const float *dirty_max = csm_render->dirty_aabb.max;
+  if (dirty_min[0] > dirty_max[0]) {
+    /* No shadow caster updated. */
+    return true;
+  }
+
+  /* Only the light space XY extent matters, the depth range covers all shadow casters
+   * and would have changed the matrices. Shadow matrices are in [0..1] texture space. */
+  rctf rect_dirty;
+  BLI_rctf_init_minmax(&rect_dirty);
+  for (int i = 0; i < 8; i++) {
+    const float co[3] = {
+        (i & 1) ? dirty_max[0] : dirty_min[0],
+        (i & 2) ? dirty_max[1] : dirty_min[1],
+        (i & 4) ? dirty_max[2] : dirty_min[2],
+    };
+    float co_shadow[3];
+    mul_v3_project_m4_v3(co_shadow, csm_data->shadowmat[cascade], co);
+    BLI_rctf_do_minmax_v(&rect_dirty, co_shadow);
+  }
+
+  const rctf rect_layer = {0.0f, 1.0f, 0.0f, 1.0f};
+  return !BLI_rctf_isect(&rect_dirty, &rect_layer, NULL);
+}
+
 void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
                                  EEVEE_Data *vedata,
                                  DRWView *view,
@@ -423,11 +459,20 @@ void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
   BLI_assert(MAX_CASCADE_NUM <= 6);
   eevee_ensure_cascade_views(csm_render, g_data->cube_views);
 
+  const bool use_cache = csm_render->cache_valid &&
+                         (csm_render->cache_tex_id == csm_data->tex_id) &&
+                         (csm_render->cache_cascade_count == csm_render->cascade_count);
+
   /* Render shadow cascades */
   /* Render cascade separately: seems to be faster for the general case.
    * The only time it's more beneficial is when the CPU culling overhead
    * outweigh the instancing overhead. which is rarely the case. */
   for (int j = 0; j < csm_render->cascade_count; j++) {
+    if (use_cache && eevee_shadow_cascade_is_cached(csm_data, csm_render, j)) {
+      continue;
+    }
+    copy_m4_m4(csm_render->cache_shadowmat[j], csm_data->shadowmat[j]);
+
     DRW_view_set_active(g_data->cube_views[j]);
     int layer = csm_data->tex_id + j;
     GPU_framebuffer_texture_layer_attach(
@@ -436,4 +481,9 @@ void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
     GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
     DRW_draw_pass(psl->shadow_pass);
   }
+
+  csm_render->cache_valid = true;
+  csm_render->cache_tex_id = csm_data->tex_id;
+  csm_render->cache_cascade_count = csm_render->cascade_count;
+  INIT_MINMAX(csm_render->dirty_aabb.min, csm_render->dirty_aabb.max);
 }
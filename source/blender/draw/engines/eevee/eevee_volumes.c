@@ -225,13 +225,22 @@ void EEVEE_volumes_init(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     do_taa = do_taa && (ED_screen_animation_no_scrub(wm) == NULL);
   }
 
-  if (do_taa) {
+  /* The TAA accumulation restarts every redraw while navigating, reproject the previous
+   * result instead so the volumetrics keep converging. */
+  const bool do_taa_restart = do_taa && (effects->taa_current_sample == 1) &&
+                              !DRW_state_is_image_render();
+  const uint max_sample = (ht_primes[0] * ht_primes[1] * ht_primes[2]);
+
+  if (do_taa_restart) {
+    current_sample = effects->volume_current_sample = (effects->volume_current_sample + 1) %
+                                                      max_sample;
+  }
+  else if (do_taa) {
     common_data->vol_history_alpha = 0.0f;
     current_sample = effects->taa_current_sample - 1;
     effects->volume_current_sample = -1;
   }
   else if (DRW_state_is_image_render()) {
-    const uint max_sample = (ht_primes[0] * ht_primes[1] * ht_primes[2]);
     current_sample = effects->volume_current_sample = (effects->volume_current_sample + 1) %
                                                       max_sample;
     if (current_sample != max_sample - 1) {
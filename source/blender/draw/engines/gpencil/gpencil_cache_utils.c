@@ -168,13 +168,40 @@ tGPencilObjectCache *gpencil_object_cache_add(tGPencilObjectCache *cache_array,
   return cache_array;
 }
 
-/* add a shading group to the cache to create later */
+/* Check if the stroke can be drawn by the shading group of the previous stroke,
+ * all the uniforms the shading group takes from the stroke must match. */
+static bool gpencil_group_cache_is_compatible(const GpencilBatchGroup *cache_elem,
+                                              const bGPDlayer *gpl,
+                                              const bGPDframe *gpf,
+                                              const bGPDstroke *gps,
+                                              const short type,
+                                              const bool onion)
+{
+  const bGPDstroke *gps_prev = cache_elem->gps;
+
+  if ((cache_elem->gpl != gpl) || (cache_elem->gpf != gpf) || (cache_elem->type != type) ||
+      (cache_elem->onion != onion) || (gps_prev->mat_nr != gps->mat_nr)) {
+    return false;
+  }
+  if (ELEM(type, eGpencilBatchGroupType_Stroke, eGpencilBatchGroupType_Point)) {
+    if ((gps_prev->caps[0] != gps->caps[0]) || (gps_prev->caps[1] != gps->caps[1]) ||
+        (gps_prev->gradient_f != gps->gradient_f) ||
+        !equals_v2v2(gps_prev->gradient_s, gps->gradient_s)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* add a shading group to the cache to create later,
+ * when possible the vertex range of the previous group is extended instead */
 GpencilBatchGroup *gpencil_group_cache_add(GpencilBatchGroup *cache_array,
                                            bGPDlayer *gpl,
                                            bGPDframe *gpf,
                                            bGPDstroke *gps,
                                            const short type,
                                            const bool onion,
+                                           const bool can_merge,
                                            const int vertex_idx,
                                            int *grp_size,
                                            int *grp_used)
@@ -182,6 +209,18 @@ GpencilBatchGroup *gpencil_group_cache_add(GpencilBatchGroup *cache_array,
   GpencilBatchGroup *cache_elem = NULL;
   GpencilBatchGroup *p = NULL;
 
+  /* Consecutive strokes using the same shading group settings are drawn with a single
+   * draw call, this keeps the number of shading groups low for drawings with many strokes.
+   * Only the last group can be extended to keep the drawing order. */
+  if (can_merge && (*grp_used > 0)) {
+    cache_elem = &cache_array[*grp_used - 1];
+    if (cache_elem->can_merge &&
+        gpencil_group_cache_is_compatible(cache_elem, gpl, gpf, gps, type, onion)) {
+      cache_elem->vertex_idx = vertex_idx;
+      return cache_array;
+    }
+  }
+
   /* By default a cache is created with one block with a predefined number of free slots,
    * if the size is not enough, the cache is reallocated adding a new block of free slots.
    * This is done in order to keep cache small. */
@@ -206,6 +245,7 @@ GpencilBatchGroup *gpencil_group_cache_add(GpencilBatchGroup *cache_array,
   cache_elem->gps = gps;
   cache_elem->type = type;
   cache_elem->onion = onion;
+  cache_elem->can_merge = can_merge;
   cache_elem->vertex_idx = vertex_idx;
 
   /* increase slots used in cache */
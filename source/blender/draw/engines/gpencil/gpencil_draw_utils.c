@@ -894,6 +894,12 @@ static DRWShadingGroup *gpencil_shgroup_point_create(GPENCIL_e_data *e_data,
   return grp;
 }
 
+static bool gpencil_is_stencil_required(MaterialGPencilStyle *gp_style)
+{
+  return (bool)((gp_style->stroke_style == GP_STYLE_STROKE_STYLE_SOLID) &&
+                ((gp_style->flag & GP_STYLE_DISABLE_STENCIL) == 0));
+}
+
 /* add fill vertex info  */
 static void gpencil_add_fill_vertexdata(GpencilBatchCache *cache,
                                         Object *ob,
@@ -939,6 +945,7 @@ static void gpencil_add_fill_vertexdata(GpencilBatchCache *cache,
                                                      gps,
                                                      eGpencilBatchGroupType_Fill,
                                                      onion,
+                                                     true,
                                                      cache->b_fill.vbo_len,
                                                      &cache->grp_size,
                                                      &cache->grp_used);
@@ -1005,6 +1012,7 @@ static void gpencil_add_stroke_vertexdata(GpencilBatchCache *cache,
                                                    gps,
                                                    eGpencilBatchGroupType_Stroke,
                                                    onion,
+                                                   !gpencil_is_stencil_required(gp_style),
                                                    cache->b_stroke.vbo_len,
                                                    &cache->grp_size,
                                                    &cache->grp_used);
@@ -1023,6 +1031,7 @@ static void gpencil_add_stroke_vertexdata(GpencilBatchCache *cache,
                                                    gps,
                                                    eGpencilBatchGroupType_Point,
                                                    onion,
+                                                   true,
                                                    cache->b_point.vbo_len,
                                                    &cache->grp_size,
                                                    &cache->grp_used);
@@ -1091,6 +1100,7 @@ static void gpencil_add_editpoints_vertexdata(GpencilBatchCache *cache,
                                                    gps,
                                                    eGpencilBatchGroupType_Edlin,
                                                    false,
+                                                   true,
                                                    cache->b_edlin.vbo_len,
                                                    &cache->grp_size,
                                                    &cache->grp_used);
@@ -1115,6 +1125,7 @@ static void gpencil_add_editpoints_vertexdata(GpencilBatchCache *cache,
                                                        gps,
                                                        eGpencilBatchGroupType_Edit,
                                                        false,
+                                                       true,
                                                        cache->b_edit.vbo_len,
                                                        &cache->grp_size,
                                                        &cache->grp_used);
@@ -1456,12 +1467,6 @@ static void gpencil_draw_onionskins(GpencilBatchCache *cache,
 }
 
 /* Check if stencil is required */
-static bool gpencil_is_stencil_required(MaterialGPencilStyle *gp_style)
-{
-  return (bool)((gp_style->stroke_style == GP_STYLE_STROKE_STYLE_SOLID) &&
-                ((gp_style->flag & GP_STYLE_DISABLE_STENCIL) == 0));
-}
-
 /* draw stroke in drawing buffer */
 void gpencil_populate_buffer_strokes(GPENCIL_e_data *e_data,
                                      void *vedata,
@@ -1762,7 +1767,7 @@ static void gpencil_shgroups_create(GPENCIL_e_data *e_data,
         }
 
         if ((do_onion) || (elm->onion == false)) {
-          DRW_shgroup_call_range(shgrp, cache->b_stroke.batch, start_stroke, len);
+          DRW_shgroup_call_range(shgrp, NULL, cache->b_stroke.batch, start_stroke, len);
         }
         stl->storage->shgroup_id++;
         start_stroke = elm->vertex_idx;
@@ -1790,7 +1795,7 @@ static void gpencil_shgroups_create(GPENCIL_e_data *e_data,
         DRW_shgroup_state_disable(shgrp, DRW_STATE_WRITE_STENCIL | DRW_STATE_STENCIL_NEQUAL);
 
         if ((do_onion) || (elm->onion == false)) {
-          DRW_shgroup_call_range(shgrp, cache->b_point.batch, start_point, len);
+          DRW_shgroup_call_range(shgrp, NULL, cache->b_point.batch, start_point, len);
         }
         stl->storage->shgroup_id++;
         start_point = elm->vertex_idx;
@@ -1815,7 +1820,7 @@ static void gpencil_shgroups_create(GPENCIL_e_data *e_data,
         DRW_shgroup_state_disable(shgrp, DRW_STATE_WRITE_STENCIL | DRW_STATE_STENCIL_NEQUAL);
 
         if ((do_onion) || (elm->onion == false)) {
-          DRW_shgroup_call_range(shgrp, cache->b_fill.batch, start_fill, len);
+          DRW_shgroup_call_range(shgrp, NULL, cache->b_fill.batch, start_fill, len);
         }
         stl->storage->shgroup_id++;
         start_fill = elm->vertex_idx;
@@ -1829,7 +1834,7 @@ static void gpencil_shgroups_create(GPENCIL_e_data *e_data,
           DRW_shgroup_uniform_mat4(shgrp, "gpModelMatrix", obmat);
           /* use always the same group */
           DRW_shgroup_call_range(
-              stl->g_data->shgrps_edit_point, cache->b_edit.batch, start_edit, len);
+              stl->g_data->shgrps_edit_point, NULL, cache->b_edit.batch, start_edit, len);
 
           start_edit = elm->vertex_idx;
         }
@@ -1843,7 +1848,7 @@ static void gpencil_shgroups_create(GPENCIL_e_data *e_data,
           DRW_shgroup_uniform_mat4(shgrp, "gpModelMatrix", obmat);
           /* use always the same group */
           DRW_shgroup_call_range(
-              stl->g_data->shgrps_edit_line, cache->b_edlin.batch, start_edlin, len);
+              stl->g_data->shgrps_edit_line, NULL, cache->b_edlin.batch, start_edlin, len);
 
           start_edlin = elm->vertex_idx;
         }
@@ -356,6 +356,7 @@ typedef struct GpencilBatchGroup {
   struct bGPDstroke *gps; /* reference to original stroke */
   short type;             /* type of element */
   bool onion;             /* the group is part of onion skin */
+  bool can_merge;         /* the next strokes can be added to the group */
   int vertex_idx;         /* index of vertex data */
 } GpencilBatchGroup;
 
@@ -467,6 +468,7 @@ struct GpencilBatchGroup *gpencil_group_cache_add(struct GpencilBatchGroup *cach
                                                   struct bGPDstroke *gps,
                                                   const short type,
                                                   const bool onion,
+                                                  const bool can_merge,
                                                   const int vertex_idx,
                                                   int *grp_size,
                                                   int *grp_used);
@@ -1105,7 +1105,7 @@ void workbench_deferred_solid_cache_populate(WORKBENCH_Data *vedata, Object *ob)
           geom = DRW_cache_mesh_surface_vertpaint_get(ob);
         }
         else {
-          geom = DRW_cache_object_surface_get(ob);
+          geom = DRW_cache_object_surface_lod_get(ob);
         }
 
         if (geom) {
@@ -824,6 +824,48 @@ GPUBatch *DRW_cache_object_surface_get(Object *ob)
   }
 }
 
+/* Meshes with less faces are always drawn at full resolution. */
+#define DRW_LOD_POLY_LEN_MIN 50000
+/* Size on screen (in pixels) under which the simplified surface is used. */
+#define DRW_LOD_SCREEN_SIZE_MAX 128.0f
+
+static bool drw_object_use_lod(Object *ob)
+{
+  const Mesh *me = ob->data;
+  if (me->edit_mesh != NULL || me->totpoly < DRW_LOD_POLY_LEN_MIN ||
+      DRW_state_is_image_render()) {
+    return false;
+  }
+
+  BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb == NULL) {
+    return false;
+  }
+  float center[3], half_size[3], persmat[4][4];
+  BKE_boundbox_calc_center_aabb(bb, center);
+  BKE_boundbox_calc_size_aabb(bb, half_size);
+  mul_m4_v3(ob->obmat, center);
+  const float radius = len_v3(half_size) * mat4_to_scale(ob->obmat);
+
+  DRW_view_persmat_get(NULL, persmat, false);
+  const float pixel_size = mul_project_m4_v3_zfac(persmat, center) * *DRW_viewport_pixelsize_get();
+  /* Behind or around the view origin. */
+  if (pixel_size <= radius * 1e-6f) {
+    return false;
+  }
+  return (2.0f * radius / pixel_size) < DRW_LOD_SCREEN_SIZE_MAX;
+}
+
+/* Same as #DRW_cache_object_surface_get but returns a simplified surface for heavy meshes when
+ * they are small enough on screen for the difference not to be noticeable. */
+GPUBatch *DRW_cache_object_surface_lod_get(Object *ob)
+{
+  if (ob->type == OB_MESH && drw_object_use_lod(ob)) {
+    return DRW_cache_mesh_surface_lod_get(ob);
+  }
+  return DRW_cache_object_surface_get(ob);
+}
+
 int DRW_cache_object_material_count_get(struct Object *ob)
 {
   Mesh *me = (ob->runtime.mesh_eval != NULL) ? ob->runtime.mesh_eval : (Mesh *)ob->data;
@@ -2734,6 +2776,12 @@ GPUBatch *DRW_cache_mesh_surface_get(Object *ob)
   return DRW_mesh_batch_cache_get_surface(ob->data);
 }
 
+GPUBatch *DRW_cache_mesh_surface_lod_get(Object *ob)
+{
+  BLI_assert(ob->type == OB_MESH);
+  return DRW_mesh_batch_cache_get_surface_lod(ob->data);
+}
+
 GPUBatch *DRW_cache_mesh_surface_edges_get(Object *ob)
 {
   BLI_assert(ob->type == OB_MESH);
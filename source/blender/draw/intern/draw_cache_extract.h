@@ -116,6 +116,7 @@ typedef struct MeshBufferCache {
   struct {
     /* Indices to vloops. */
     GPUIndexBuf *tris;        /* Ordered per material. */
+    GPUIndexBuf *tris_lod;    /* Simplified triangles, not ordered per material. */
     GPUIndexBuf *lines;       /* Loose edges last. */
     GPUIndexBuf *lines_loose; /* sub buffer of `lines` only containing the loose edges. */
     GPUIndexBuf *points;
@@ -160,6 +161,7 @@ typedef enum DRWBatchFlag {
   MBC_WIRE_LOOPS_UVS = (1 << 25),
   MBC_SURF_PER_MAT = (1 << 26),
   MBC_SKIN_ROOTS = (1 << 27),
+  MBC_SURFACE_LOD = (1 << 28),
 } DRWBatchFlag;
 
 #define MBC_EDITUV \
@@ -179,6 +181,7 @@ typedef struct MeshBatchCache {
   struct {
     /* Surfaces / Render */
     GPUBatch *surface;
+    GPUBatch *surface_lod; /* Same as surface, with simplified triangles. */
     GPUBatch *surface_weights;
     /* Edit mode */
     GPUBatch *edit_triangles;
@@ -561,6 +561,149 @@ static const MeshExtract extract_tris = {
 
 /** \} */
 
+/* ---------------------------------------------------------------------- */
+/** \name Extract Simplified Triangles Indices
+ *
+ * Vertex clustering: vertices are snapped to a regular grid over the mesh bounds, each cell is
+ * drawn using the first loop found in it and the triangles collapsing to a line or a point are
+ * dropped. Referencing existing loops allows to use the full resolution vertex buffers.
+ * \{ */
+
+/* Number of cells along each axis of the bounds. */
+#define MESH_LOD_GRID_RES 64
+
+typedef struct MeshExtract_TriLod_Data {
+  GPUIndexBufBuilder elb;
+  /* Loop drawn in place of each loop. */
+  int *loop_cluster;
+} MeshExtract_TriLod_Data;
+
+BLI_INLINE int mesh_lod_cell_index(const float co[3], const float min[3], const float scale[3])
+{
+  int cell[3];
+  for (int i = 0; i < 3; i++) {
+    cell[i] = clamp_i((int)((co[i] - min[i]) * scale[i]), 0, MESH_LOD_GRID_RES - 1);
+  }
+  return (cell[2] * MESH_LOD_GRID_RES + cell[1]) * MESH_LOD_GRID_RES + cell[0];
+}
+
+BLI_INLINE void mesh_lod_loop_cluster_add(int *cells, int *loop_cluster, int cell, int l)
+{
+  if (cells[cell] == -1) {
+    cells[cell] = l;
+  }
+  loop_cluster[l] = cells[cell];
+}
+
+static void *extract_tris_lod_init(const MeshRenderData *mr, void *UNUSED(ibo))
+{
+  MeshExtract_TriLod_Data *data = MEM_callocN(sizeof(*data), __func__);
+  data->loop_cluster = MEM_mallocN(sizeof(int) * max_ii(mr->loop_len, 1), __func__);
+
+  float min[3], max[3], scale[3];
+  INIT_MINMAX(min, max);
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter;
+    BMVert *eve;
+    BM_ITER_MESH (eve, &iter, mr->bm, BM_VERTS_OF_MESH) {
+      minmax_v3v3_v3(min, max, eve->co);
+    }
+  }
+  else {
+    for (int v = 0; v < mr->vert_len; v++) {
+      minmax_v3v3_v3(min, max, mr->mvert[v].co);
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    const float size = max[i] - min[i];
+    scale[i] = (size > FLT_EPSILON) ? MESH_LOD_GRID_RES / size : 0.0f;
+  }
+
+  const size_t cells_len = MESH_LOD_GRID_RES * MESH_LOD_GRID_RES * MESH_LOD_GRID_RES;
+  int *cells = MEM_mallocN(sizeof(int) * cells_len, __func__);
+  copy_vn_i(cells, (int)cells_len, -1);
+
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter, l_iter;
+    BMFace *efa;
+    BMLoop *loop;
+    BM_ITER_MESH (efa, &iter, mr->bm, BM_FACES_OF_MESH) {
+      BM_ITER_ELEM (loop, &l_iter, efa, BM_LOOPS_OF_FACE) {
+        const int cell = mesh_lod_cell_index(loop->v->co, min, scale);
+        mesh_lod_loop_cluster_add(cells, data->loop_cluster, cell, BM_elem_index_get(loop));
+      }
+    }
+  }
+  else {
+    const MLoop *mloop = mr->mloop;
+    for (int l = 0; l < mr->loop_len; l++, mloop++) {
+      const int cell = mesh_lod_cell_index(mr->mvert[mloop->v].co, min, scale);
+      mesh_lod_loop_cluster_add(cells, data->loop_cluster, cell, l);
+    }
+  }
+  MEM_freeN(cells);
+
+  GPU_indexbuf_init(&data->elb, GPU_PRIM_TRIS, mr->tri_len, mr->loop_len);
+  return data;
+}
+
+BLI_INLINE void extract_tris_lod_add(MeshExtract_TriLod_Data *data, int l1, int l2, int l3)
+{
+  const int c1 = data->loop_cluster[l1];
+  const int c2 = data->loop_cluster[l2];
+  const int c3 = data->loop_cluster[l3];
+  if (c1 != c2 && c2 != c3 && c3 != c1) {
+    GPU_indexbuf_add_tri_verts(&data->elb, c1, c2, c3);
+  }
+}
+
+static void extract_tris_lod_looptri_bmesh(const MeshRenderData *UNUSED(mr),
+                                           int UNUSED(t),
+                                           BMLoop **elt,
+                                           void *data)
+{
+  if (!BM_elem_flag_test(elt[0]->f, BM_ELEM_HIDDEN)) {
+    extract_tris_lod_add(
+        data, BM_elem_index_get(elt[0]), BM_elem_index_get(elt[1]), BM_elem_index_get(elt[2]));
+  }
+}
+
+static void extract_tris_lod_looptri_mesh(const MeshRenderData *mr,
+                                          int UNUSED(t),
+                                          const MLoopTri *mlt,
+                                          void *data)
+{
+  const MPoly *mpoly = &mr->mpoly[mlt->poly];
+  if (!(mr->use_hide && (mpoly->flag & ME_HIDE))) {
+    extract_tris_lod_add(data, mlt->tri[0], mlt->tri[1], mlt->tri[2]);
+  }
+}
+
+static void extract_tris_lod_finish(const MeshRenderData *UNUSED(mr), void *ibo, void *_data)
+{
+  MeshExtract_TriLod_Data *data = _data;
+  GPU_indexbuf_build_in_place(&data->elb, ibo);
+  MEM_freeN(data->loop_cluster);
+  MEM_freeN(data);
+}
+
+static const MeshExtract extract_tris_lod = {
+    extract_tris_lod_init,
+    extract_tris_lod_looptri_bmesh,
+    extract_tris_lod_looptri_mesh,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    extract_tris_lod_finish,
+    0,
+    false,
+};
+
+/** \} */
+
 /* ---------------------------------------------------------------------- */
 /** \name Extract Edges Indices
  * \{ */
@@ -1780,7 +1923,7 @@ static void *extract_tan_init(const MeshRenderData *mr, void *buf)
       GPU_vertformat_safe_attrib_name(layer_name, attr_safe_name, GPU_MAX_SAFE_ATTRIB_NAME);
       /* Tangent layer name. */
       BLI_snprintf(attr_name, sizeof(attr_name), "t%s", attr_safe_name);
-      GPU_vertformat_attr_add(&format, attr_name, GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+      GPU_vertformat_attr_add(&format, attr_name, GPU_COMP_I16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
       /* Active render layer name. */
       if (i == CustomData_get_render_layer(cd_ldata, CD_MLOOPUV)) {
         GPU_vertformat_alias_add(&format, "t");
@@ -1856,7 +1999,7 @@ static void *extract_tan_init(const MeshRenderData *mr, void *buf)
     const char *layer_name = CustomData_get_layer_name(cd_ldata, CD_TANGENT, 0);
     GPU_vertformat_safe_attrib_name(layer_name, attr_safe_name, GPU_MAX_SAFE_ATTRIB_NAME);
     BLI_snprintf(attr_name, sizeof(*attr_name), "t%s", attr_safe_name);
-    GPU_vertformat_attr_add(&format, attr_name, GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&format, attr_name, GPU_COMP_I16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
     GPU_vertformat_alias_add(&format, "t");
     GPU_vertformat_alias_add(&format, "at");
   }
@@ -1876,15 +2019,21 @@ static void *extract_tan_init(const MeshRenderData *mr, void *buf)
   GPU_vertbuf_init_with_format(vbo, &format);
   GPU_vertbuf_data_alloc(vbo, v_len);
 
-  float(*tan_data)[4] = (float(*)[4])vbo->data;
+  /* Tangents are unit vectors with the bi-tangent sign as last component,
+   * normalized 16-bit integers are precise enough and use half the memory of floats. */
+  short(*tan_data)[4] = (short(*)[4])vbo->data;
   for (int i = 0; i < tan_len; i++) {
-    void *layer_data = CustomData_get_layer_named(cd_ldata, CD_TANGENT, tangent_names[i]);
-    memcpy(tan_data, layer_data, sizeof(*tan_data) * mr->loop_len);
-    tan_data += mr->loop_len;
+    const float(*layer_data)[4] = CustomData_get_layer_named(
+        cd_ldata, CD_TANGENT, tangent_names[i]);
+    for (int l = 0; l < mr->loop_len; l++, tan_data++) {
+      normal_float_to_short_v4(*tan_data, layer_data[l]);
+    }
   }
   if (use_orco_tan) {
-    void *layer_data = CustomData_get_layer_n(cd_ldata, CD_TANGENT, 0);
-    memcpy(tan_data, layer_data, sizeof(*tan_data) * mr->loop_len);
+    const float(*layer_data)[4] = CustomData_get_layer_n(cd_ldata, CD_TANGENT, 0);
+    for (int l = 0; l < mr->loop_len; l++, tan_data++) {
+      normal_float_to_short_v4(*tan_data, layer_data[l]);
+    }
   }
 
   CustomData_free_layers(cd_ldata, CD_TANGENT, mr->loop_len);
@@ -4217,23 +4366,62 @@ static const MeshExtract extract_fdot_idx = {
 /** \name Extract Loop
  * \{ */
 
+/* One requested buffer and the extractor filling it. */
+typedef struct ExtractorRun {
+  const MeshExtract *extract;
+  eMRIterType iter_type;
+  void *buf;
+  void *user_data;
+} ExtractorRun;
+
+#define EXTRACTORS_MAX (sizeof(MeshBufferCache) / sizeof(void *))
+
+/* Extractors iterating the mesh together, each element is passed to all of them in turn. */
+typedef struct ExtractorRunDatas {
+  ExtractorRun *items;
+  int len;
+} ExtractorRunDatas;
+
 typedef struct ExtractTaskData {
   const MeshRenderData *mr;
-  const MeshExtract *extract;
+  ExtractorRunDatas *extractors;
   eMRIterType iter_type;
   int start, end;
   /** Decremented each time a task is finished. */
   int32_t *task_counter;
-  void *buf;
-  void *user_data;
 } ExtractTaskData;
 
+static void extractor_run_init(ExtractorRun *run,
+                               const MeshRenderData *mr,
+                               const MeshExtract *extract,
+                               void *buf)
+{
+  run->extract = extract;
+  run->iter_type = mesh_extract_iter_type(extract);
+  run->buf = buf;
+  run->user_data = extract->init(mr, buf);
+}
+
+static eMRIterType extractors_iter_type(const ExtractorRunDatas *extractors)
+{
+  eMRIterType type = 0;
+  for (int i = 0; i < extractors->len; i++) {
+    type |= extractors->items[i].iter_type;
+  }
+  return type;
+}
+
+#define FOREACH_EXTRACTOR_RUN(extractors, _type, run) \
+  for (ExtractorRun *run = (extractors)->items, *run##_end = run + (extractors)->len; \
+       run != run##_end; \
+       run++) \
+    if (run->iter_type & (_type))
+
 BLI_INLINE void mesh_extract_iter(const MeshRenderData *mr,
                                   const eMRIterType iter_type,
                                   int start,
                                   int end,
-                                  const MeshExtract *extract,
-                                  void *user_data)
+                                  ExtractorRunDatas *extractors)
 {
   switch (mr->extract_type) {
     case MR_EXTRACT_BMESH:
@@ -4241,7 +4429,9 @@ BLI_INLINE void mesh_extract_iter(const MeshRenderData *mr,
         int t_end = min_ii(mr->tri_len, end);
         for (int t = start; t < t_end; t++) {
           BMLoop **elt = &mr->edit_bmesh->looptris[t][0];
-          extract->iter_looptri_bm(mr, t, elt, user_data);
+          FOREACH_EXTRACTOR_RUN (extractors, MR_ITER_LOOPTRI, run) {
+            run->extract->iter_looptri_bm(mr, t, elt, run->user_data);
+          }
         }
       }
       if (iter_type & MR_ITER_LOOP) {
@@ -4251,7 +4441,10 @@ BLI_INLINE void mesh_extract_iter(const MeshRenderData *mr,
           BMLoop *loop;
           BMIter l_iter;
           BM_ITER_ELEM (loop, &l_iter, efa, BM_LOOPS_OF_FACE) {
-            extract->iter_loop_bm(mr, BM_elem_index_get(loop), loop, user_data);
+            const int l = BM_elem_index_get(loop);
+            FOREACH_EXTRACTOR_RUN (extractors, MR_ITER_LOOP, run) {
+              run->extract->iter_loop_bm(mr, l, loop, run->user_data);
+            }
           }
         }
       }
@@ -4259,14 +4452,18 @@ BLI_INLINE void mesh_extract_iter(const MeshRenderData *mr,
         int le_end = min_ii(mr->edge_loose_len, end);
         for (int e = start; e < le_end; e++) {
           BMEdge *eed = BM_edge_at_index(mr->bm, mr->ledges[e]);
-          extract->iter_ledge_bm(mr, e, eed, user_data);
+          FOREACH_EXTRACTOR_RUN (extractors, MR_ITER_LEDGE, run) {
+            run->extract->iter_ledge_bm(mr, e, eed, run->user_data);
+          }
         }
       }
       if (iter_type & MR_ITER_LVERT) {
         int lv_end = min_ii(mr->vert_loose_len, end);
         for (int v = start; v < lv_end; v++) {
           BMVert *eve = BM_vert_at_index(mr->bm, mr->lverts[v]);
-          extract->iter_lvert_bm(mr, v, eve, user_data);
+          FOREACH_EXTRACTOR_RUN (extractors, MR_ITER_LVERT, run) {
+            run->extract->iter_lvert_bm(mr, v, eve, run->user_data);
+          }
         }
       }
       break;
@@ -4275,7 +4472,10 @@ BLI_INLINE void mesh_extract_iter(const MeshRenderData *mr,
       if (iter_type & MR_ITER_LOOPTRI) {
         int t_end = min_ii(mr->tri_len, end);
         for (int t = start; t < t_end; t++) {
-          extract->iter_looptri(mr, t, &mr->mlooptri[t], user_data);
+          const MLoopTri *mlt = &mr->mlooptri[t];
+          FOREACH_EXTRACTOR_RUN (extractors, MR_ITER_LOOPTRI, run) {
+            run->extract->iter_looptri(mr, t, mlt, run->user_data);
+          }
         }
       }
       if (iter_type & MR_ITER_LOOP) {
@@ -4284,36 +4484,52 @@ BLI_INLINE void mesh_extract_iter(const MeshRenderData *mr,
           const MPoly *mpoly = &mr->mpoly[p];
           int l = mpoly->loopstart;
           for (int i = 0; i < mpoly->totloop; i++, l++) {
-            extract->iter_loop(mr, l, &mr->mloop[l], p, mpoly, user_data);
+            const MLoop *mloop = &mr->mloop[l];
+            FOREACH_EXTRACTOR_RUN (extractors, MR_ITER_LOOP, run) {
+              run->extract->iter_loop(mr, l, mloop, p, mpoly, run->user_data);
+            }
           }
         }
       }
       if (iter_type & MR_ITER_LEDGE) {
         int le_end = min_ii(mr->edge_loose_len, end);
         for (int e = start; e < le_end; e++) {
-          extract->iter_ledge(mr, e, &mr->medge[mr->ledges[e]], user_data);
+          const MEdge *medge = &mr->medge[mr->ledges[e]];
+          FOREACH_EXTRACTOR_RUN (extractors, MR_ITER_LEDGE, run) {
+            run->extract->iter_ledge(mr, e, medge, run->user_data);
+          }
         }
       }
       if (iter_type & MR_ITER_LVERT) {
         int lv_end = min_ii(mr->vert_loose_len, end);
         for (int v = start; v < lv_end; v++) {
-          extract->iter_lvert(mr, v, &mr->mvert[mr->lverts[v]], user_data);
+          const MVert *mvert = &mr->mvert[mr->lverts[v]];
+          FOREACH_EXTRACTOR_RUN (extractors, MR_ITER_LVERT, run) {
+            run->extract->iter_lvert(mr, v, mvert, run->user_data);
+          }
         }
       }
       break;
   }
 }
 
+#undef FOREACH_EXTRACTOR_RUN
+
 static void extract_run(TaskPool *__restrict UNUSED(pool), void *taskdata, int UNUSED(threadid))
 {
   ExtractTaskData *data = taskdata;
-  mesh_extract_iter(
-      data->mr, data->iter_type, data->start, data->end, data->extract, data->user_data);
+  mesh_extract_iter(data->mr, data->iter_type, data->start, data->end, data->extractors);
 
-  /* If this is the last task, we do the finish function. */
+  /* If this is the last task, we do the finish functions. */
   int remainin_tasks = atomic_sub_and_fetch_int32(data->task_counter, 1);
-  if (remainin_tasks == 0 && data->extract->finish != NULL) {
-    data->extract->finish(data->mr, data->buf, data->user_data);
+  if (remainin_tasks == 0) {
+    ExtractorRunDatas *extractors = data->extractors;
+    for (int i = 0; i < extractors->len; i++) {
+      ExtractorRun *run = &extractors->items[i];
+      if (run->extract->finish != NULL) {
+        run->extract->finish(data->mr, run->buf, run->user_data);
+      }
+    }
   }
 }
 
@@ -4328,26 +4544,30 @@ static void extract_range_task_create(
   BLI_task_pool_push(task_pool, extract_run, taskdata, true, TASK_PRIORITY_HIGH);
 }
 
+/**
+ * Extract all buffers of \a extractors iterating the mesh once, the extractors need to be
+ * initialized and to stay valid until the tasks are done.
+ *
+ * \param use_thread: Extract in the task pool instead of the calling thread.
+ * \param use_range: Divide the extraction into chunks of elements extracted in parallel,
+ * all extractors need #MeshExtract.use_threading for this.
+ */
 static void extract_task_create(TaskPool *task_pool,
                                 const MeshRenderData *mr,
-                                const MeshExtract *extract,
-                                void *buf,
+                                ExtractorRunDatas *extractors,
+                                const bool use_thread,
+                                const bool use_range,
                                 int32_t *task_counter)
 {
-  /* Divide extraction of the VBO/IBO into sensible chunks of works. */
   ExtractTaskData *taskdata = MEM_mallocN(sizeof(*taskdata), "ExtractTaskData");
   taskdata->mr = mr;
-  taskdata->extract = extract;
-  taskdata->buf = buf;
-  taskdata->user_data = extract->init(mr, buf);
-  taskdata->iter_type = mesh_extract_iter_type(extract);
+  taskdata->extractors = extractors;
+  taskdata->iter_type = extractors_iter_type(extractors);
   taskdata->task_counter = task_counter;
   taskdata->start = 0;
   taskdata->end = INT_MAX;
 
-  /* Simple heuristic. */
-  const bool use_thread = (mr->loop_len + mr->loop_loose_len) > 8192;
-  if (use_thread && extract->use_threading) {
+  if (use_thread && use_range) {
     /* Divide task into sensible chunks. */
     const int chunk_size = 8192;
     if (taskdata->iter_type & MR_ITER_LOOPTRI) {
@@ -4370,10 +4590,15 @@ static void extract_task_create(TaskPool *task_pool,
         extract_range_task_create(task_pool, taskdata, MR_ITER_LVERT, i, chunk_size);
       }
     }
+    if (*task_counter == 0) {
+      /* Nothing to iterate, still finish the buffers. */
+      (*task_counter)++;
+      extract_run(NULL, taskdata, -1);
+    }
     MEM_freeN(taskdata);
   }
   else if (use_thread) {
-    /* One task for the whole VBO. */
+    /* One task for the whole buffers. */
     (*task_counter)++;
     BLI_task_pool_push(task_pool, extract_run, taskdata, true, TASK_PRIORITY_HIGH);
   }
@@ -4432,6 +4657,7 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   TEST_ASSIGN(VBO, vbo, skin_roots);
 
   TEST_ASSIGN(IBO, ibo, tris);
+  TEST_ASSIGN(IBO, ibo, tris_lod);
   TEST_ASSIGN(IBO, ibo, lines);
   TEST_ASSIGN(IBO, ibo, points);
   TEST_ASSIGN(IBO, ibo, fdots);
@@ -4466,14 +4692,26 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   task_scheduler = BLI_task_scheduler_get();
   task_pool = BLI_task_pool_create_suspended(task_scheduler, NULL);
 
+  /* Simple heuristic. */
+  const bool use_thread = (mr->loop_len + mr->loop_loose_len) > 8192;
+
+  /* Extractors supporting it share the same range tasks, so each chunk of the mesh is iterated
+   * once for all of them. The others iterate the whole mesh in their own task when threading,
+   * otherwise everything is extracted in a single pass over the mesh. */
+  ExtractorRun runs_range[EXTRACTORS_MAX], runs_single[EXTRACTORS_MAX];
+  int runs_range_len = 0, runs_single_len = 0;
+
   size_t counters_size = (sizeof(mbc) / sizeof(void *)) * sizeof(int32_t);
   int32_t *task_counters = MEM_callocN(counters_size, __func__);
   int counter_used = 0;
 
+  /* Initialized on the main thread, in the order buffers are listed. */
 #define EXTRACT(buf, name) \
   if (mbc.buf.name) { \
-    extract_task_create( \
-        task_pool, mr, &extract_##name, mbc.buf.name, &task_counters[counter_used++]); \
+    ExtractorRun *run = (use_thread && extract_##name.use_threading) ? \
+                            &runs_range[runs_range_len++] : \
+                            &runs_single[runs_single_len++]; \
+    extractor_run_init(run, mr, &extract_##name, mbc.buf.name); \
   } \
   ((void)0)
 
@@ -4501,6 +4739,7 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   EXTRACT(vbo, skin_roots);
 
   EXTRACT(ibo, tris);
+  EXTRACT(ibo, tris_lod);
   EXTRACT(ibo, lines);
   EXTRACT(ibo, points);
   EXTRACT(ibo, fdots);
@@ -4511,6 +4750,42 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
   EXTRACT(ibo, edituv_points);
   EXTRACT(ibo, edituv_fdots);
 
+#undef EXTRACT
+
+  /* Referenced by the tasks, kept until all of them are done. */
+  ExtractorRunDatas extractors[EXTRACTORS_MAX + 1];
+  int extractors_len = 0;
+
+  if (runs_range_len != 0) {
+    extractors[extractors_len] = (ExtractorRunDatas){runs_range, runs_range_len};
+    extract_task_create(task_pool,
+                        mr,
+                        &extractors[extractors_len++],
+                        use_thread,
+                        true,
+                        &task_counters[counter_used++]);
+  }
+  if (!use_thread && runs_single_len != 0) {
+    extractors[extractors_len] = (ExtractorRunDatas){runs_single, runs_single_len};
+    extract_task_create(task_pool,
+                        mr,
+                        &extractors[extractors_len++],
+                        false,
+                        false,
+                        &task_counters[counter_used++]);
+  }
+  else {
+    for (int i = 0; i < runs_single_len; i++) {
+      extractors[extractors_len] = (ExtractorRunDatas){&runs_single[i], 1};
+      extract_task_create(task_pool,
+                          mr,
+                          &extractors[extractors_len++],
+                          use_thread,
+                          false,
+                          &task_counters[counter_used++]);
+    }
+  }
+
   /* TODO(fclem) Ideally, we should have one global pool for all
    * objects and wait for finish only before drawing when buffers
    * need to be ready. */
@@ -4520,12 +4795,20 @@ void mesh_buffer_cache_create_requested(MeshBatchCache *cache,
 
   /* The `lines_loose` is a sub buffer from `ibo.lines`.
    * We schedule it here due to potential synchronization issues.*/
-  EXTRACT(ibo, lines_loose);
+  if (mbc.ibo.lines_loose) {
+    ExtractorRun *run = &runs_single[runs_single_len++];
+    extractor_run_init(run, mr, &extract_lines_loose, mbc.ibo.lines_loose);
+    extractors[extractors_len] = (ExtractorRunDatas){run, 1};
+    extract_task_create(task_pool,
+                        mr,
+                        &extractors[extractors_len++],
+                        use_thread,
+                        false,
+                        &task_counters[counter_used++]);
+  }
 
   BLI_task_pool_work_and_wait(task_pool);
 
-#undef EXTRACT
-
   BLI_task_pool_free(task_pool);
   MEM_freeN(task_counters);
 
@@ -470,7 +470,8 @@ static void mesh_batch_cache_discard_uvedit(MeshBatchCache *cache)
   mesh_batch_cache_discard_shaded_batches(cache);
 
   GPU_BATCH_DISCARD_SAFE(cache->batch.surface);
-  cache->batch_ready &= ~MBC_SURFACE;
+  GPU_BATCH_DISCARD_SAFE(cache->batch.surface_lod);
+  cache->batch_ready &= ~(MBC_SURFACE | MBC_SURFACE_LOD);
 }
 
 static void mesh_batch_cache_discard_uvedit_select(MeshBatchCache *cache)
@@ -494,6 +495,41 @@ static void mesh_batch_cache_discard_uvedit_select(MeshBatchCache *cache)
   cache->batch_ready &= ~MBC_EDITUV;
 }
 
+/* Discard everything that depends on vertex positions,
+ * index buffers and attributes which only depend on topology and custom-data are kept. */
+static void mesh_batch_cache_discard_deform(MeshBatchCache *cache)
+{
+  FOREACH_MESH_BUFFER_CACHE(cache, mbufcache)
+  {
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.pos_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.lnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.skin_roots);
+    /* Triangulation of n-gons (and quads in edit-mode) depends on vertex positions. */
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.tris);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.tris_lod);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.lines_adjacency);
+    GPU_INDEXBUF_DISCARD_SAFE(mbufcache->ibo.edituv_tris);
+  }
+  /* Nearly all batches use positions, they are cheap to create again from the kept buffers. */
+  for (int i = 0; i < sizeof(cache->batch) / sizeof(void *); i++) {
+    GPUBatch **batch = (GPUBatch **)&cache->batch;
+    GPU_BATCH_DISCARD_SAFE(batch[i]);
+  }
+  mesh_batch_cache_discard_shaded_batches(cache);
+
+  cache->tot_area = 0.0f;
+  cache->tot_uv_area = 0.0f;
+
+  cache->batch_ready = 0;
+}
+
 void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
 {
   MeshBatchCache *cache = me->runtime.batch_cache;
@@ -533,6 +569,7 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
         GPU_VERTBUF_DISCARD_SAFE(mbufcache->vbo.lnor);
       }
       GPU_BATCH_DISCARD_SAFE(cache->batch.surface);
+      GPU_BATCH_DISCARD_SAFE(cache->batch.surface_lod);
       GPU_BATCH_DISCARD_SAFE(cache->batch.wire_loops);
       GPU_BATCH_DISCARD_SAFE(cache->batch.wire_edges);
       if (cache->surface_per_mat) {
@@ -540,11 +577,15 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, int mode)
           GPU_BATCH_DISCARD_SAFE(cache->surface_per_mat[i]);
         }
       }
-      cache->batch_ready &= ~(MBC_SURFACE | MBC_WIRE_EDGES | MBC_WIRE_LOOPS | MBC_SURF_PER_MAT);
+      cache->batch_ready &= ~(MBC_SURFACE | MBC_SURFACE_LOD | MBC_WIRE_EDGES | MBC_WIRE_LOOPS |
+                              MBC_SURF_PER_MAT);
       break;
     case BKE_MESH_BATCH_DIRTY_ALL:
       cache->is_dirty = true;
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      mesh_batch_cache_discard_deform(cache);
+      break;
     case BKE_MESH_BATCH_DIRTY_SHADING:
       mesh_batch_cache_discard_shaded_tri(cache);
       mesh_batch_cache_discard_uvedit(cache);
@@ -660,6 +701,13 @@ GPUBatch *DRW_mesh_batch_cache_get_surface(Mesh *me)
   return DRW_batch_request(&cache->batch.surface);
 }
 
+GPUBatch *DRW_mesh_batch_cache_get_surface_lod(Mesh *me)
+{
+  MeshBatchCache *cache = mesh_batch_cache_get(me);
+  mesh_batch_cache_add_request(cache, MBC_SURFACE_LOD);
+  return DRW_batch_request(&cache->batch.surface_lod);
+}
+
 GPUBatch *DRW_mesh_batch_cache_get_loose_edges(Mesh *me)
 {
   MeshBatchCache *cache = mesh_batch_cache_get(me);
@@ -1037,8 +1085,9 @@ void DRW_mesh_batch_cache_create_requested(
   }
 
   if (batch_requested &
-      (MBC_SURFACE | MBC_SURF_PER_MAT | MBC_WIRE_LOOPS_UVS | MBC_EDITUV_FACES_STRETCH_AREA |
-       MBC_EDITUV_FACES_STRETCH_ANGLE | MBC_EDITUV_FACES | MBC_EDITUV_EDGES | MBC_EDITUV_VERTS)) {
+      (MBC_SURFACE | MBC_SURFACE_LOD | MBC_SURF_PER_MAT | MBC_WIRE_LOOPS_UVS |
+       MBC_EDITUV_FACES_STRETCH_AREA | MBC_EDITUV_FACES_STRETCH_ANGLE | MBC_EDITUV_FACES |
+       MBC_EDITUV_EDGES | MBC_EDITUV_VERTS)) {
     /* Modifiers will only generate an orco layer if the mesh is deformed. */
     if (cache->cd_needed.orco != 0) {
       /* Orco is always extracted from final mesh. */
@@ -1089,7 +1138,8 @@ void DRW_mesh_batch_cache_create_requested(
         GPU_BATCH_CLEAR_SAFE(cache->surface_per_mat[i]);
       }
       GPU_BATCH_CLEAR_SAFE(cache->batch.surface);
-      cache->batch_ready &= ~(MBC_SURFACE | MBC_SURF_PER_MAT);
+      GPU_BATCH_CLEAR_SAFE(cache->batch.surface_lod);
+      cache->batch_ready &= ~(MBC_SURFACE | MBC_SURFACE_LOD | MBC_SURF_PER_MAT);
 
       mesh_cd_layers_type_merge(&cache->cd_used, cache->cd_needed);
     }
@@ -1153,6 +1203,18 @@ void DRW_mesh_batch_cache_create_requested(
       DRW_vbo_request(cache->batch.surface, &mbufcache->vbo.vcol);
     }
   }
+  if (DRW_batch_requested(cache->batch.surface_lod, GPU_PRIM_TRIS)) {
+    DRW_ibo_request(cache->batch.surface_lod, &mbufcache->ibo.tris_lod);
+    /* Same attributes as the full resolution surface. */
+    DRW_vbo_request(cache->batch.surface_lod, &mbufcache->vbo.lnor);
+    DRW_vbo_request(cache->batch.surface_lod, &mbufcache->vbo.pos_nor);
+    if (cache->cd_used.uv != 0) {
+      DRW_vbo_request(cache->batch.surface_lod, &mbufcache->vbo.uv);
+    }
+    if (cache->cd_used.vcol != 0) {
+      DRW_vbo_request(cache->batch.surface_lod, &mbufcache->vbo.vcol);
+    }
+  }
   if (DRW_batch_requested(cache->batch.all_verts, GPU_PRIM_POINTS)) {
     DRW_vbo_request(cache->batch.all_verts, &mbufcache->vbo.pos_nor);
   }
@@ -31,6 +31,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -152,8 +153,24 @@ static void particle_batch_cache_init(ParticleSystem *psys)
 static ParticleBatchCache *particle_batch_cache_get(ParticleSystem *psys)
 {
   if (!particle_batch_cache_valid(psys)) {
+    /* Keep the interpolated strands, evaluating the particle system again often gives the same
+     * control points (e.g. only the emitter moved) in which case they are still valid. */
+    ParticleHairCache hair_prev = {NULL};
+    ParticleBatchCache *cache = psys->batch_cache;
+    if (cache != NULL) {
+      hair_prev = cache->hair;
+      memset(cache->hair.final, 0, sizeof(cache->hair.final));
+    }
+
     particle_batch_cache_clear(psys);
     particle_batch_cache_init(psys);
+
+    cache = psys->batch_cache;
+    memcpy(cache->hair.final, hair_prev.final, sizeof(cache->hair.final));
+    cache->hair.final_is_stale = true;
+    cache->hair.point_hash = hair_prev.point_hash;
+    cache->hair.point_len = hair_prev.point_len;
+    cache->hair.strands_len = hair_prev.strands_len;
   }
   return psys->batch_cache;
 }
@@ -179,6 +196,17 @@ static void particle_batch_cache_clear_point(ParticlePointCache *point_cache)
   GPU_VERTBUF_DISCARD_SAFE(point_cache->pos);
 }
 
+static void particle_batch_cache_clear_hair_final(ParticleHairCache *hair_cache)
+{
+  for (int i = 0; i < MAX_HAIR_SUBDIV; i++) {
+    GPU_VERTBUF_DISCARD_SAFE(hair_cache->final[i].proc_buf);
+    DRW_TEXTURE_FREE_SAFE(hair_cache->final[i].proc_tex);
+    for (int j = 0; j < MAX_THICKRES; j++) {
+      GPU_BATCH_DISCARD_SAFE(hair_cache->final[i].proc_hairs[j]);
+    }
+  }
+}
+
 static void particle_batch_cache_clear_hair(ParticleHairCache *hair_cache)
 {
   /* TODO more granular update tagging. */
@@ -198,13 +226,7 @@ static void particle_batch_cache_clear_hair(ParticleHairCache *hair_cache)
     GPU_VERTBUF_DISCARD_SAFE(hair_cache->proc_col_buf[i]);
     DRW_TEXTURE_FREE_SAFE(hair_cache->col_tex[i]);
   }
-  for (int i = 0; i < MAX_HAIR_SUBDIV; i++) {
-    GPU_VERTBUF_DISCARD_SAFE(hair_cache->final[i].proc_buf);
-    DRW_TEXTURE_FREE_SAFE(hair_cache->final[i].proc_tex);
-    for (int j = 0; j < MAX_THICKRES; j++) {
-      GPU_BATCH_DISCARD_SAFE(hair_cache->final[i].proc_hairs[j]);
-    }
-  }
+  particle_batch_cache_clear_hair_final(hair_cache);
 
   /* "Normal" legacy hairs */
   GPU_BATCH_DISCARD_SAFE(hair_cache->hairs);
@@ -1106,6 +1128,9 @@ static void particle_batch_cache_ensure_procedural_pos(PTCacheEdit *edit,
     }
   }
 
+  cache->point_hash = BLI_hash_mm2(
+      cache->proc_point_buf->data, GPU_vertbuf_size_get(cache->proc_point_buf), 0);
+
   /* Create vbo immediately to bind to texture buffer. */
   GPU_vertbuf_use(cache->proc_point_buf);
 
@@ -1664,9 +1689,21 @@ bool particles_ensure_procedural_data(Object *object,
 
   /* Refreshed on combing and simulation. */
   if ((*r_hair_cache)->proc_point_buf == NULL) {
-    ensure_seg_pt_count(source.edit, source.psys, &cache->hair);
-    particle_batch_cache_ensure_procedural_pos(source.edit, source.psys, &cache->hair);
-    need_ft_update = true;
+    ParticleHairCache *hair_cache = *r_hair_cache;
+    const uint point_hash_prev = hair_cache->point_hash;
+    const int point_len_prev = hair_cache->point_len;
+    const int strands_len_prev = hair_cache->strands_len;
+
+    ensure_seg_pt_count(source.edit, source.psys, hair_cache);
+    particle_batch_cache_ensure_procedural_pos(source.edit, source.psys, hair_cache);
+
+    /* When the control points are unchanged there is no need to interpolate them again. */
+    if (!hair_cache->final_is_stale || (hair_cache->point_hash != point_hash_prev) ||
+        (hair_cache->point_len != point_len_prev) ||
+        (hair_cache->strands_len != strands_len_prev)) {
+      particle_batch_cache_clear_hair_final(hair_cache);
+    }
+    hair_cache->final_is_stale = false;
   }
 
   /* Refreshed if active layer or custom data changes. */
@@ -33,6 +33,7 @@
 #include "DNA_customdata_types.h"
 
 #include "BKE_anim.h"
+#include "BKE_object.h"
 
 #include "GPU_batch.h"
 #include "GPU_shader.h"
@@ -43,6 +44,13 @@
 #  define USE_TRANSFORM_FEEDBACK
 #endif
 
+/* Only reduce the strand count of systems with at least that many strands. */
+#define HAIR_LOD_STRANDS_LEN_MIN 10000
+/* Objects covering at least that many pixels on screen draw all their strands. */
+#define HAIR_LOD_SCREEN_SIZE_FULL 512.0f
+/* Lowest fraction of the strands drawn. */
+#define HAIR_LOD_FAC_MIN 0.1f
+
 typedef enum ParticleRefineShader {
   PART_REFINE_CATMULL_ROM = 0,
   PART_REFINE_MAX_SHADER,
@@ -95,6 +103,34 @@ static GPUShader *hair_refine_shader_get(ParticleRefineShader sh)
   return g_refine_shaders[sh];
 }
 
+/* Fraction of the strands to draw, depending on the object size on screen. */
+static float hair_lod_factor_get(Object *object, const ParticleHairCache *hair_cache)
+{
+  if (hair_cache->strands_len < HAIR_LOD_STRANDS_LEN_MIN || DRW_state_is_image_render() ||
+      DRW_state_is_select()) {
+    return 1.0f;
+  }
+
+  BoundBox *bb = BKE_object_boundbox_get(object);
+  if (bb == NULL) {
+    return 1.0f;
+  }
+  float center[3], half_size[3], persmat[4][4];
+  BKE_boundbox_calc_center_aabb(bb, center);
+  BKE_boundbox_calc_size_aabb(bb, half_size);
+  mul_m4_v3(object->obmat, center);
+  const float radius = len_v3(half_size) * mat4_to_scale(object->obmat);
+
+  DRW_view_persmat_get(NULL, persmat, false);
+  const float pixel_size = mul_project_m4_v3_zfac(persmat, center) * *DRW_viewport_pixelsize_get();
+  /* Behind or around the view origin. */
+  if (pixel_size <= radius * 1e-6f) {
+    return 1.0f;
+  }
+  const float screen_size = 2.0f * radius / pixel_size;
+  return clamp_f(screen_size / HAIR_LOD_SCREEN_SIZE_FULL, HAIR_LOD_FAC_MIN, 1.0f);
+}
+
 void DRW_hair_init(void)
 {
 #ifdef USE_TRANSFORM_FEEDBACK
@@ -180,7 +216,17 @@ static DRWShadingGroup *drw_shgroup_create_hair_procedural_ex(Object *object,
   /* TODO(fclem): Until we have a better way to cull the hair and render with orco, bypass culling
    * test. */
   GPUBatch *geom = hair_cache->final[subdiv].proc_hairs[thickness_res - 1];
-  DRW_shgroup_call_no_cull(shgrp, geom, object);
+  const float lod_fac = hair_lod_factor_get(object, hair_cache);
+  if (lod_fac < 1.0f) {
+    /* Strands are drawn in order, each with the same element count. Skipping the last ones
+     * matches how the display percentage of child particles works. */
+    const int elems_per_strand = hair_cache->final[subdiv].strands_res * thickness_res + 1;
+    const int strands_len = max_ii(1, (int)(hair_cache->strands_len * lod_fac));
+    DRW_shgroup_call_range(shgrp, object, geom, 0, strands_len * elems_per_strand);
+  }
+  else {
+    DRW_shgroup_call_no_cull(shgrp, geom, object);
+  }
 
   /* Transform Feedback subdiv. */
   if (need_ft_update) {
@@ -73,6 +73,11 @@ typedef struct ParticleHairCache {
   int num_col_layers;
 
   ParticleHairFinalCache final[MAX_HAIR_SUBDIV];
+  /** Set when #ParticleHairCache.final was kept from before the cache was tagged dirty,
+   * it is only valid if the control points are unchanged. */
+  bool final_is_stale;
+  /** Hash of the control points, to detect when they are unchanged after an update. */
+  uint point_hash;
 
   int strands_len;
   int elems_len;
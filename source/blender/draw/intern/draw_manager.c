@@ -28,6 +28,7 @@
 #include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BLF_api.h"
 
@@ -834,9 +835,13 @@ static void duplidata_value_free(void *val)
 static void drw_duplidata_free(void)
 {
   if (DST.dupli_ghash != NULL) {
+    PROFILE_START(stime);
+    const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_DRAW_CACHE);
     BLI_ghash_free(DST.dupli_ghash,
                    (void (*)(void *key))drw_batch_cache_generate_requested,
                    duplidata_value_free);
+    MEM_category_end(category_prev);
+    PROFILE_END_ACCUM(DST.extract_time, stime);
     DST.dupli_ghash = NULL;
   }
 }
@@ -1152,6 +1157,8 @@ static void drw_engines_world_update(Scene *scene)
 
 static void drw_engines_cache_populate(Object *ob)
 {
+  /* Batch caches are created by the engines and filled in by the requested batches. */
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_DRAW_CACHE);
   DST.ob_handle = 0;
 
   /* HACK: DrawData is copied by COW from the duplicated object.
@@ -1182,12 +1189,15 @@ static void drw_engines_cache_populate(Object *ob)
   /* TODO: in the future it would be nice to generate once for all viewports.
    * But we need threaded DRW manager first. */
   if (!DST.dupli_source) {
+    PROFILE_START(stime);
     drw_batch_cache_generate_requested(ob);
+    PROFILE_END_ACCUM(DST.extract_time, stime);
   }
 
   /* ... and clearing it here too because this draw data is
    * from a mempool and must not be free individually by depsgraph. */
   drw_drawdata_unlink_dupli((ID *)ob);
+  MEM_category_end(category_prev);
 }
 
 static void drw_engines_cache_finish(void)
@@ -1515,7 +1525,11 @@ void DRW_draw_view(const bContext *C)
   DST.options.draw_background = (scene->r.alphamode == R_ADDSKY) ||
                                 (v3d->shading.type != OB_RENDER);
   DST.options.do_color_management = true;
+
+  TraceZone zone;
+  BLI_trace_zone_begin(&zone, "Draw View", "draw");
   DRW_draw_render_loop_ex(depsgraph, engine_type, ar, v3d, viewport, C);
+  BLI_trace_zone_end(&zone);
 }
 
 /**
@@ -2871,6 +2885,7 @@ void DRW_engines_free(void)
   DRW_hair_free();
   DRW_shape_cache_free();
   DRW_stats_free();
+  DRW_stats_record_end();
   DRW_globals_free();
 
   DrawEngineType *next;
@@ -2889,6 +2904,8 @@ void DRW_engines_free(void)
   DRW_TEXTURE_FREE_SAFE(G_draw.weight_ramp);
 
   MEM_SAFE_FREE(DST.uniform_names.buffer);
+  MEM_SAFE_FREE(DST.sorted_calls.buffer);
+  DST.sorted_calls.buffer_len = 0;
 
   if (DST.draw_list) {
     GPU_draw_list_discard(DST.draw_list);
@@ -200,6 +200,7 @@ typedef struct DRWCommandDraw {
 /* Assume DRWResourceHandle to be 0. */
 typedef struct DRWCommandDrawRange {
   GPUBatch *batch;
+  DRWResourceHandle handle;
   uint vert_first;
   uint vert_count;
 } DRWCommandDrawRange;
@@ -459,6 +460,8 @@ typedef struct DRWManager {
   DRWInstanceData *object_instance_data[MAX_INSTANCE_DATA_SIZE];
   /* Array of dupli_data (one for each enabled engine) to handle duplis. */
   void **dupli_datas;
+  /** Time spent generating the requested batches during cache filling (in ms). */
+  double extract_time;
 
   /* Rendering state */
   GPUShader *shader;
@@ -548,6 +551,12 @@ typedef struct DRWManager {
     uint buffer_len;
     uint buffer_ofs;
   } uniform_names;
+
+  /** Scratch storage to reorder the draw calls of a shading group, see #draw_shgroup. */
+  struct {
+    DRWCommandDraw *buffer;
+    uint buffer_len;
+  } sorted_calls;
 } DRWManager;
 
 extern DRWManager DST; /* TODO: get rid of this and allow multi-threaded rendering. */
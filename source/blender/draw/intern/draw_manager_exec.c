@@ -25,6 +25,8 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -586,47 +588,86 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float) * 6 * 4);
 }
 
+static void draw_culling_state_compute(const DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+
+#ifdef DRW_DEBUG_CULLING
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
+      }
+      else {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
+#endif
+
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
+    }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+typedef struct DRWCullingTaskData {
+  const DRWView *view;
+  BLI_memblock *cullstates;
+  int cullstates_len;
+} DRWCullingTaskData;
+
+/* Compute one chunk of the culling states memblock. */
+static void draw_compute_culling_cb(void *__restrict userdata,
+                                    const int chunk,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DRWCullingTaskData *data = userdata;
+  const int elem_start = chunk * DRW_RESOURCE_CHUNK_LEN;
+  const int elem_len = min_ii(DRW_RESOURCE_CHUNK_LEN, data->cullstates_len - elem_start);
+
+  /* Elements of a chunk are contiguous. */
+  DRWCullingState *cull = BLI_memblock_elem_get(data->cullstates, chunk, 0);
+  for (int i = 0; i < elem_len; i++, cull++) {
+    draw_culling_state_compute(data->view, cull);
+  }
+}
+
 static void draw_compute_culling(DRWView *view)
 {
   view = view->parent ? view->parent : view;
 
-  /* TODO(fclem) multithread this. */
   /* TODO(fclem) compute all dirty views at once. */
   if (!view->is_dirty) {
     return;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
-    }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+  /* One culling state is allocated for each resource handle. */
+  const int cullstates_len = DRW_handle_chunk_get(&DST.resource_handle) * DRW_RESOURCE_CHUNK_LEN +
+                             DRW_handle_id_get(&DST.resource_handle);
+  const int chunks_len = (cullstates_len + DRW_RESOURCE_CHUNK_LEN - 1) / DRW_RESOURCE_CHUNK_LEN;
+
+  DRWCullingTaskData data = {
+      .view = view,
+      .cullstates = DST.vmempool->cullstates,
+      .cullstates_len = cullstates_len,
+  };
 
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Engine visibility callbacks are not expected to be thread-safe. */
+  settings.use_threading = (chunks_len > 1) && (view->visibility_fn == NULL);
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
-      }
+  settings.use_threading = false;
 #endif
-
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
-
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
-    }
-  }
+  BLI_task_parallel_range(0, chunks_len, &data, draw_compute_culling_cb, &settings);
 
   view->is_dirty = false;
 }
@@ -1217,6 +1258,94 @@ static void draw_call_batching_finish(DRWShadingGroup *shgroup, DRWCommandsState
   }
 }
 
+/* Draw calls of a shading group can be reordered if nothing depends on their submission order:
+ * no blending, no stencil writes and a depth test resolving the overlaps. */
+static bool draw_shgroup_calls_order_independent(DRWState state)
+{
+  const DRWState order_dependent = DRW_STATE_WRITE_STENCIL_ENABLED | DRW_STATE_BLEND_ADD |
+                                   DRW_STATE_BLEND_ADD_FULL | DRW_STATE_BLEND_ALPHA |
+                                   DRW_STATE_BLEND_ALPHA_PREMUL |
+                                   DRW_STATE_BLEND_ALPHA_UNDER_PREMUL | DRW_STATE_BLEND_OIT |
+                                   DRW_STATE_BLEND_MUL | DRW_STATE_BLEND_CUSTOM |
+                                   DRW_STATE_LOGIC_INVERT;
+  const DRWState depth_test = DRW_STATE_DEPTH_TEST_ENABLED & ~DRW_STATE_DEPTH_ALWAYS;
+  return ((state & order_dependent) == 0) && ((state & depth_test) != 0);
+}
+
+static int draw_call_sort_cmp(const void *a_, const void *b_)
+{
+  const DRWCommandDraw *a = a_, *b = b_;
+  /* Negative scale bit and resource chunk first: changing them interrupts the batching. */
+  const uint a_chunk = a->handle >> 9, b_chunk = b->handle >> 9;
+  if (a_chunk != b_chunk) {
+    return (a_chunk < b_chunk) ? -1 : 1;
+  }
+  if (a->batch != b->batch) {
+    return ((uintptr_t)a->batch < (uintptr_t)b->batch) ? -1 : 1;
+  }
+  /* Consecutive resource ids are merged into a single instanced draw. */
+  if (a->handle != b->handle) {
+    return (a->handle < b->handle) ? -1 : 1;
+  }
+  return 0;
+}
+
+/**
+ * Draw the calls of a shading group grouped by batch and resource id, so calls interleaved
+ * with other batches still end up in the same multi-draw-indirect list.
+ * Return false (without drawing anything) if the shading group contains other commands
+ * or if its calls can't be reordered.
+ */
+static bool draw_call_batching_sorted_do(DRWShadingGroup *shgroup,
+                                         DRWCommandsState *state,
+                                         DRWState pass_state,
+                                         bool use_tfeedback)
+{
+  if (!USE_BATCHING || state->obmats_loc == -1 || (G.f & G_FLAG_PICKSEL) || use_tfeedback ||
+      !draw_shgroup_calls_order_independent(pass_state)) {
+    return false;
+  }
+
+  DRWCommandIterator iter;
+  DRWCommand *cmd;
+  eDRWCommandType cmd_type;
+  uint calls_len = 0;
+  bool is_sorted = true;
+
+  draw_command_iter_begin(&iter, shgroup);
+  while ((cmd = draw_command_iter_step(&iter, &cmd_type))) {
+    if (cmd_type != DRW_CMD_DRAW || cmd->draw.batch->inst[0]) {
+      return false;
+    }
+    if (draw_call_is_culled(&cmd->draw.handle, DST.view_active)) {
+      continue;
+    }
+    if (calls_len == DST.sorted_calls.buffer_len) {
+      DST.sorted_calls.buffer_len = max_ii(256, DST.sorted_calls.buffer_len * 2);
+      DST.sorted_calls.buffer = MEM_reallocN_id(DST.sorted_calls.buffer,
+                                                sizeof(DRWCommandDraw) *
+                                                    DST.sorted_calls.buffer_len,
+                                                __func__);
+    }
+    DST.sorted_calls.buffer[calls_len] = cmd->draw;
+    if (calls_len > 0 && draw_call_sort_cmp(&DST.sorted_calls.buffer[calls_len - 1],
+                                            &DST.sorted_calls.buffer[calls_len]) > 0) {
+      is_sorted = false;
+    }
+    calls_len++;
+  }
+
+  /* Most shading groups only contain calls in the right order already. */
+  if (!is_sorted) {
+    qsort(DST.sorted_calls.buffer, calls_len, sizeof(DRWCommandDraw), draw_call_sort_cmp);
+  }
+
+  for (uint i = 0; i < calls_len; i++) {
+    draw_call_batching_do(shgroup, state, &DST.sorted_calls.buffer[i]);
+  }
+  return true;
+}
+
 static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
 {
   BLI_assert(shgroup->shader);
@@ -1262,11 +1391,14 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
     DRWCommand *cmd;
     eDRWCommandType cmd_type;
 
-    draw_command_iter_begin(&iter, shgroup);
-
     draw_call_batching_start(&state);
 
-    while ((cmd = draw_command_iter_step(&iter, &cmd_type))) {
+    const bool calls_drawn = draw_call_batching_sorted_do(
+        shgroup, &state, pass_state, use_tfeedback);
+
+    draw_command_iter_begin(&iter, shgroup);
+
+    while (!calls_drawn && (cmd = draw_command_iter_step(&iter, &cmd_type))) {
 
       switch (cmd_type) {
         case DRW_CMD_DRWSTATE:
@@ -1345,7 +1477,7 @@ static void draw_shgroup(DRWShadingGroup *shgroup, DRWState pass_state)
           draw_call_single_do(shgroup,
                               &state,
                               cmd->range.batch,
-                              (DRWResourceHandle)0,
+                              cmd->range.handle,
                               cmd->range.vert_first,
                               cmd->range.vert_count,
                               1,
@@ -1373,6 +1505,18 @@ static void drw_update_view(void)
   draw_compute_culling(DST.view_active);
 }
 
+static void drw_stats_shgroup_start(DRWShadingGroup *shgroup, int index)
+{
+  char name[32];
+#ifndef NDEBUG
+  BLI_snprintf(name, sizeof(name), "%d %s", index, shgroup->shader->name);
+#else
+  UNUSED_VARS(shgroup);
+  BLI_snprintf(name, sizeof(name), "Shading Group %d", index);
+#endif
+  DRW_stats_query_start(name);
+}
+
 static void drw_draw_pass_ex(DRWPass *pass,
                              DRWShadingGroup *start_group,
                              DRWShadingGroup *end_group)
@@ -1401,8 +1545,17 @@ static void drw_draw_pass_ex(DRWPass *pass,
 
   DRW_stats_query_start(pass->name);
 
+  const bool do_shgroup_stats = DRW_stats_sub_timers_enabled();
+  int shgroup_index = 0;
+
   for (DRWShadingGroup *shgroup = start_group; shgroup; shgroup = shgroup->next) {
+    if (do_shgroup_stats) {
+      drw_stats_shgroup_start(shgroup, shgroup_index++);
+    }
     draw_shgroup(shgroup, pass->state);
+    if (do_shgroup_stats) {
+      DRW_stats_query_end();
+    }
     /* break if upper limit */
     if (shgroup == end_group) {
       break;
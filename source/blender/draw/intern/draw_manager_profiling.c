@@ -20,6 +20,11 @@
  * \ingroup draw
  */
 
+#include <stdio.h>
+
+#include "BLI_utildefines.h"
+
+#include "BLI_fileops.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
 
@@ -29,6 +34,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "PIL_time.h"
+
 #include "draw_manager.h"
 
 #include "GPU_texture.h"
@@ -43,11 +50,13 @@
 #define GPU_TIMER_FALLOFF 0.1
 
 typedef struct DRWTimer {
-  GLuint query[2];
-  GLuint64 time_average;
+  /* Start and end timestamps of the current and the previous frame. */
+  GLuint query[2][2];
+  GLuint64 time_last, time_average;
+  double cpu_time_start;
+  double cpu_time_last, cpu_time_average; /* In milliseconds. */
   char name[MAX_TIMER_NAME];
-  int lvl;       /* Hierarchy level for nested timer. */
-  bool is_query; /* Does this timer actually perform queries or is it just a group. */
+  int lvl; /* Hierarchy level for nested timer. */
 } DRWTimer;
 
 static struct DRWTimerPool {
@@ -56,8 +65,13 @@ static struct DRWTimerPool {
   int timer_count;     /* chunk_count * CHUNK_SIZE */
   int timer_increment; /* Keep track of where we are in the stack. */
   int end_increment;   /* Keep track of bad usage. */
-  bool is_recording;   /* Are we in the render loop? */
-  bool is_querying;    /* Keep track of bad usage. */
+  /* Timers that are started and not ended yet. */
+  int timer_stack[MAX_NESTED_TIMER];
+  int timer_stack_len;
+  bool is_recording; /* Are we in the render loop? */
+  /* Recording of the timings to a file, see #DRW_stats_record_begin. */
+  FILE *record_file;
+  int record_frame;
 } DTP = {NULL};
 
 void DRW_stats_free(void)
@@ -65,7 +79,7 @@ void DRW_stats_free(void)
   if (DTP.timers != NULL) {
     for (int i = 0; i < DTP.timer_count; i++) {
       DRWTimer *timer = &DTP.timers[i];
-      glDeleteQueries(2, timer->query);
+      glDeleteQueries(4, &timer->query[0][0]);
     }
     MEM_freeN(DTP.timers);
     DTP.timers = NULL;
@@ -74,7 +88,7 @@ void DRW_stats_free(void)
 
 void DRW_stats_begin(void)
 {
-  if (G.debug_value > 20 && G.debug_value < 30) {
+  if ((G.debug_value > 20 && G.debug_value < 30) || (DTP.record_file != NULL)) {
     DTP.is_recording = true;
   }
 
@@ -87,9 +101,9 @@ void DRW_stats_begin(void)
     DRW_stats_free();
   }
 
-  DTP.is_querying = false;
   DTP.timer_increment = 0;
   DTP.end_increment = 0;
+  DTP.timer_stack_len = 0;
 }
 
 static DRWTimer *drw_stats_timer_get(void)
@@ -104,58 +118,107 @@ static DRWTimer *drw_stats_timer_get(void)
   return &DTP.timers[DTP.timer_increment++];
 }
 
-static void drw_stats_timer_start_ex(const char *name, const bool is_query)
+/* Timestamp queries are used so that timers can be nested, every level gets its own
+ * GPU time and not only the sum of the timers inside it. */
+static void drw_stats_timer_start(const char *name)
 {
   if (DTP.is_recording) {
+    BLI_assert(DTP.timer_stack_len < MAX_NESTED_TIMER);
+    DTP.timer_stack[DTP.timer_stack_len++] = DTP.timer_increment;
+
     DRWTimer *timer = drw_stats_timer_get();
     BLI_strncpy(timer->name, name, MAX_TIMER_NAME);
-    timer->lvl = DTP.timer_increment - DTP.end_increment - 1;
-    timer->is_query = is_query;
-
-    /* Queries cannot be nested or interleaved. */
-    BLI_assert(!DTP.is_querying);
-    if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        glGenQueries(1, timer->query);
-      }
+    timer->lvl = DTP.timer_stack_len - 1;
 
-      glFinish();
-      /* Issue query for the next frame */
-      glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
-      DTP.is_querying = true;
+    if (timer->query[0][0] == 0) {
+      glGenQueries(2, timer->query[0]);
     }
+    /* Issue query for the next frame */
+    glQueryCounter(timer->query[0][0], GL_TIMESTAMP);
+    timer->cpu_time_start = PIL_check_seconds_timer();
+  }
+}
+
+static void drw_stats_timer_end(void)
+{
+  if (DTP.is_recording) {
+    BLI_assert(DTP.timer_stack_len > 0);
+    DTP.end_increment++;
+
+    DRWTimer *timer = &DTP.timers[DTP.timer_stack[--DTP.timer_stack_len]];
+    timer->cpu_time_last = (PIL_check_seconds_timer() - timer->cpu_time_start) * 1e3;
+    timer->cpu_time_average = timer->cpu_time_average * (1.0 - GPU_TIMER_FALLOFF) +
+                              timer->cpu_time_last * GPU_TIMER_FALLOFF;
+    glQueryCounter(timer->query[0][1], GL_TIMESTAMP);
   }
 }
 
-/* Use this to group the queries. It does NOT keep track
- * of the time, it only sum what the queries inside it. */
+/* Use this to group the queries. The time of the whole group is measured,
+ * so it also includes the work that is not inside any of its sub timers. */
 void DRW_stats_group_start(const char *name)
 {
-  drw_stats_timer_start_ex(name, false);
+  drw_stats_timer_start(name);
 }
 
 void DRW_stats_group_end(void)
 {
-  if (DTP.is_recording) {
-    BLI_assert(!DTP.is_querying);
-    DTP.end_increment++;
-  }
+  drw_stats_timer_end();
 }
 
-/* NOTE: Only call this when no sub timer will be called. */
 void DRW_stats_query_start(const char *name)
 {
-  drw_stats_timer_start_ex(name, true);
+  drw_stats_timer_start(name);
 }
 
 void DRW_stats_query_end(void)
 {
-  if (DTP.is_recording) {
-    DTP.end_increment++;
-    BLI_assert(DTP.is_querying);
-    glEndQuery(GL_TIME_ELAPSED);
-    DTP.is_querying = false;
+  drw_stats_timer_end();
+}
+
+/* Return true if a timer started now would be displayed or recorded.
+ * Used to avoid the overhead of fine grained timers (i.e: per shading group). */
+bool DRW_stats_sub_timers_enabled(void)
+{
+  if (!DTP.is_recording || DTP.timer_stack_len >= MAX_NESTED_TIMER) {
+    return false;
   }
+  return (DTP.record_file != NULL) || (DTP.timer_stack_len <= G.debug_value - 21);
+}
+
+/* Write the timings of the frame as CSV rows: frame, level, name, GPU time, CPU time.
+ * The values are not averaged, note that GPU times are the ones of the previous frame. */
+static void drw_stats_record_frame(void)
+{
+  FILE *fp = DTP.record_file;
+
+  for (LinkData *link = DST.enabled_engines.first; link; link = link->next) {
+    DrawEngineType *engine = link->data;
+    ViewportEngineData *data = drw_viewport_engine_data_ensure(engine);
+    fprintf(fp,
+            "%d,0,\"%s\",,%f\n",
+            DTP.record_frame,
+            engine->idname,
+            data->init_time + data->background_time + data->render_time);
+  }
+  if (DST.viewport != NULL) {
+    fprintf(fp,
+            "%d,0,\"Cache Time\",,%f\n",
+            DTP.record_frame,
+            *GPU_viewport_cache_time_get(DST.viewport));
+  }
+  fprintf(fp, "%d,0,\"Batch Extraction\",,%f\n", DTP.record_frame, DST.extract_time);
+
+  for (int i = 0; i < DTP.timer_increment; i++) {
+    DRWTimer *timer = &DTP.timers[i];
+    fprintf(fp,
+            "%d,%d,\"%s\",%f,%f\n",
+            DTP.record_frame,
+            timer->lvl + 1,
+            timer->name,
+            timer->time_last / 1000000.0,
+            timer->cpu_time_last);
+  }
+  DTP.record_frame++;
 }
 
 void DRW_stats_reset(void)
@@ -166,40 +229,64 @@ void DRW_stats_reset(void)
              "You forgot a DRW_stats_group/query_start somewhere!");
 
   if (DTP.is_recording) {
-    GLuint64 lvl_time[MAX_NESTED_TIMER] = {0};
-
-    /* Swap queries for the next frame and sum up each lvl time. */
+    /* Swap queries for the next frame. */
     for (int i = DTP.timer_increment - 1; i >= 0; i--) {
       DRWTimer *timer = &DTP.timers[i];
-      SWAP(GLuint, timer->query[0], timer->query[1]);
+      SWAP(GLuint, timer->query[0][0], timer->query[1][0]);
+      SWAP(GLuint, timer->query[0][1], timer->query[1][1]);
 
       BLI_assert(timer->lvl < MAX_NESTED_TIMER);
 
-      if (timer->is_query) {
-        GLuint64 time;
-        if (timer->query[0] != 0) {
-          glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
+      GLuint64 time = 0;
+      if (timer->query[0][0] != 0) {
+        GLuint64 time_start, time_end;
+        glGetQueryObjectui64v(timer->query[0][0], GL_QUERY_RESULT, &time_start);
+        glGetQueryObjectui64v(timer->query[0][1], GL_QUERY_RESULT, &time_end);
+        if (time_end > time_start) {
+          time = time_end - time_start;
         }
-        else {
-          time = 1000000000; /* 1ms default */
-        }
-
-        timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
-                              time * GPU_TIMER_FALLOFF;
-        timer->time_average = MIN2(timer->time_average, 1000000000);
       }
       else {
-        timer->time_average = lvl_time[timer->lvl + 1];
-        lvl_time[timer->lvl + 1] = 0;
+        time = 1000000000; /* 1ms default */
       }
 
-      lvl_time[timer->lvl] += timer->time_average;
+      timer->time_last = time;
+      timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
+                            time * GPU_TIMER_FALLOFF;
+      timer->time_average = MIN2(timer->time_average, 1000000000);
+    }
+
+    if (DTP.record_file != NULL) {
+      drw_stats_record_frame();
     }
 
     DTP.is_recording = false;
   }
 }
 
+/* Record the timings of every drawn frame to a CSV file until #DRW_stats_record_end
+ * is called, all the timer levels are recorded. */
+bool DRW_stats_record_begin(const char *filepath)
+{
+  DRW_stats_record_end();
+
+  DTP.record_file = BLI_fopen(filepath, "w");
+  if (DTP.record_file == NULL) {
+    return false;
+  }
+  DTP.record_frame = 0;
+  fprintf(DTP.record_file, "frame,level,name,gpu_ms,cpu_ms\n");
+  return true;
+}
+
+void DRW_stats_record_end(void)
+{
+  if (DTP.record_file != NULL) {
+    fclose(DTP.record_file);
+    DTP.record_file = NULL;
+  }
+}
+
 static void draw_stat_5row(const rcti *rect, int u, int v, const char *txt, const int size)
 {
   BLF_draw_default_ascii(rect->xmin + (1 + u * 5) * U.widget_unit,
@@ -295,6 +382,13 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   sprintf(time_to_txt, "%.2fms", *cache_time);
   draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
+  v++;
+
+  u = 0;
+  sprintf(col_label, "Batch Extraction");
+  draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+  sprintf(time_to_txt, "%.2fms", DST.extract_time);
+  draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
   v += 2;
 
   /* ------------------------------------------ */
@@ -321,7 +415,9 @@ void DRW_stats_draw(const rcti *rect)
 
   /* GPU Timings */
   BLI_strncpy(stat_string, "GPU Render Timings", sizeof(stat_string));
-  draw_stat(rect, 0, v++, stat_string, sizeof(stat_string));
+  draw_stat(rect, 0, v, stat_string, sizeof(stat_string));
+  BLI_strncpy(stat_string, "CPU", sizeof(stat_string));
+  draw_stat(rect, 20, v++, stat_string, sizeof(stat_string));
 
   for (int i = 0; i < DTP.timer_increment; i++) {
     double time_ms, time_percent;
@@ -355,6 +451,8 @@ void DRW_stats_draw(const rcti *rect)
     draw_stat(rect, 12 + timer->lvl, v, stat_string, sizeof(stat_string));
     BLI_snprintf(stat_string, sizeof(stat_string), "%.0f", time_percent);
     draw_stat(rect, 16 + timer->lvl, v, stat_string, sizeof(stat_string));
+    BLI_snprintf(stat_string, sizeof(stat_string), "%.2fms", MIN2(timer->cpu_time_average, 999.0));
+    draw_stat(rect, 20 + timer->lvl, v, stat_string, sizeof(stat_string));
     v++;
   }
 
@@ -35,6 +35,8 @@ void DRW_stats_group_end(void);
 void DRW_stats_query_start(const char *name);
 void DRW_stats_query_end(void);
 
+bool DRW_stats_sub_timers_enabled(void);
+
 void DRW_stats_draw(const rcti *rect);
 
 #endif /* __DRAW_MANAGER_PROFILING_H__ */
@@ -25,6 +25,7 @@
 #include "DNA_material_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_string_utils.h"
 #include "BLI_threads.h"
 
@@ -62,17 +63,31 @@ typedef struct DRWDeferredShader {
   GPUMaterial *mat;
 } DRWDeferredShader;
 
-typedef struct DRWShaderCompiler {
-  ListBase queue;          /* DRWDeferredShader */
-  ListBase queue_conclude; /* DRWDeferredShader */
-  SpinLock list_lock;
+/* Each worker compiles in its own thread with its own context. */
+#define DRW_DEFERRED_SHADER_WORKERS_MAX 4
+
+typedef struct DRWShaderCompilerWorker {
+  struct DRWShaderCompiler *comp;
 
   DRWDeferredShader *mat_compiling;
   ThreadMutex compilation_lock;
 
   void *gl_context;
+} DRWShaderCompilerWorker;
+
+typedef struct DRWShaderCompiler {
+  ListBase queue;          /* DRWDeferredShader */
+  ListBase queue_conclude; /* DRWDeferredShader */
+  SpinLock list_lock;
+
+  DRWShaderCompilerWorker workers[DRW_DEFERRED_SHADER_WORKERS_MAX];
+  int workers_len;
   bool own_context;
 
+  /* Job state, shared by all workers (protected by list_lock). */
+  short *stop, *do_update;
+  float *progress;
+
   int shaders_done; /* To compute progress. */
 } DRWShaderCompiler;
 
@@ -90,20 +105,22 @@ static void drw_deferred_shader_queue_free(ListBase *queue)
   }
 }
 
-static void drw_deferred_shader_compilation_exec(void *custom_data,
-                                                 short *stop,
-                                                 short *do_update,
-                                                 float *progress)
+static int drw_deferred_shader_workers_len(void)
 {
-  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
-  void *gl_context = comp->gl_context;
+  /* Leave one thread to the UI. */
+  return clamp_i(BLI_system_thread_count() - 1, 1, DRW_DEFERRED_SHADER_WORKERS_MAX);
+}
 
-  WM_opengl_context_activate(gl_context);
+static void drw_deferred_shader_worker_exec(DRWShaderCompilerWorker *worker)
+{
+  DRWShaderCompiler *comp = worker->comp;
+
+  WM_opengl_context_activate(worker->gl_context);
 
   while (true) {
     BLI_spin_lock(&comp->list_lock);
 
-    if (*stop != 0) {
+    if (*comp->stop != 0) {
       /* We don't want user to be able to cancel the compilation
        * but wm can kill the task if we are closing blender. */
       BLI_spin_unlock(&comp->list_lock);
@@ -112,40 +129,73 @@ static void drw_deferred_shader_compilation_exec(void *custom_data,
 
     /* Pop tail because it will be less likely to lock the main thread
      * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()). */
-    comp->mat_compiling = BLI_poptail(&comp->queue);
-    if (comp->mat_compiling == NULL) {
+    worker->mat_compiling = BLI_poptail(&comp->queue);
+    if (worker->mat_compiling == NULL) {
       /* No more Shader to compile. */
       BLI_spin_unlock(&comp->list_lock);
       break;
     }
 
-    comp->shaders_done++;
-    int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
-
-    BLI_mutex_lock(&comp->compilation_lock);
+    BLI_mutex_lock(&worker->compilation_lock);
     BLI_spin_unlock(&comp->list_lock);
 
     /* Do the compilation. */
-    GPU_material_compile(comp->mat_compiling->mat);
-
-    *progress = (float)comp->shaders_done / (float)total;
-    *do_update = true;
+    GPU_material_compile(worker->mat_compiling->mat);
 
     GPU_flush();
-    BLI_mutex_unlock(&comp->compilation_lock);
+    BLI_mutex_unlock(&worker->compilation_lock);
 
     BLI_spin_lock(&comp->list_lock);
-    if (GPU_material_status(comp->mat_compiling->mat) == GPU_MAT_QUEUED) {
-      BLI_addtail(&comp->queue_conclude, comp->mat_compiling);
+    comp->shaders_done++;
+    int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
+    *comp->progress = (float)comp->shaders_done / (float)total;
+    *comp->do_update = true;
+
+    if (GPU_material_status(worker->mat_compiling->mat) == GPU_MAT_QUEUED) {
+      BLI_addtail(&comp->queue_conclude, worker->mat_compiling);
     }
     else {
-      drw_deferred_shader_free(comp->mat_compiling);
+      drw_deferred_shader_free(worker->mat_compiling);
     }
-    comp->mat_compiling = NULL;
+    worker->mat_compiling = NULL;
     BLI_spin_unlock(&comp->list_lock);
   }
 
-  WM_opengl_context_release(gl_context);
+  WM_opengl_context_release(worker->gl_context);
+}
+
+static void *drw_deferred_shader_worker_thread(void *worker_v)
+{
+  drw_deferred_shader_worker_exec((DRWShaderCompilerWorker *)worker_v);
+  return NULL;
+}
+
+static void drw_deferred_shader_compilation_exec(void *custom_data,
+                                                 short *stop,
+                                                 short *do_update,
+                                                 float *progress)
+{
+  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
+
+  comp->stop = stop;
+  comp->do_update = do_update;
+  comp->progress = progress;
+
+  /* The job thread is the first worker, others get their own thread. */
+  ListBase threads;
+  const int threads_len = comp->workers_len - 1;
+  if (threads_len > 0) {
+    BLI_threadpool_init(&threads, drw_deferred_shader_worker_thread, threads_len);
+    for (int i = 1; i < comp->workers_len; i++) {
+      BLI_threadpool_insert(&threads, &comp->workers[i]);
+    }
+  }
+
+  drw_deferred_shader_worker_exec(&comp->workers[0]);
+
+  if (threads_len > 0) {
+    BLI_threadpool_end(&threads);
+  }
 }
 
 static void drw_deferred_shader_compilation_free(void *custom_data)
@@ -166,11 +216,14 @@ static void drw_deferred_shader_compilation_free(void *custom_data)
   }
 
   BLI_spin_end(&comp->list_lock);
-  BLI_mutex_end(&comp->compilation_lock);
 
-  if (comp->own_context) {
-    /* Only destroy if the job owns the context. */
-    WM_opengl_context_dispose(comp->gl_context);
+  for (int i = 0; i < DRW_DEFERRED_SHADER_WORKERS_MAX; i++) {
+    DRWShaderCompilerWorker *worker = &comp->workers[i];
+    BLI_mutex_end(&worker->compilation_lock);
+    if (comp->own_context && worker->gl_context) {
+      /* Only destroy if the job owns the context. */
+      WM_opengl_context_dispose(worker->gl_context);
+    }
   }
 
   MEM_freeN(comp);
@@ -209,15 +262,21 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 
   DRWShaderCompiler *comp = MEM_callocN(sizeof(DRWShaderCompiler), "DRWShaderCompiler");
   BLI_spin_init(&comp->list_lock);
-  BLI_mutex_init(&comp->compilation_lock);
+  for (int i = 0; i < DRW_DEFERRED_SHADER_WORKERS_MAX; i++) {
+    comp->workers[i].comp = comp;
+    BLI_mutex_init(&comp->workers[i].compilation_lock);
+  }
 
   if (old_comp) {
     BLI_spin_lock(&old_comp->list_lock);
     BLI_movelisttolist(&comp->queue, &old_comp->queue);
     BLI_spin_unlock(&old_comp->list_lock);
-    /* Do not recreate context, just pass ownership. */
-    if (old_comp->gl_context) {
-      comp->gl_context = old_comp->gl_context;
+    /* Do not recreate contexts, just pass ownership. */
+    if (old_comp->workers_len != 0) {
+      for (int i = 0; i < old_comp->workers_len; i++) {
+        comp->workers[i].gl_context = old_comp->workers[i].gl_context;
+      }
+      comp->workers_len = old_comp->workers_len;
       old_comp->own_context = false;
       comp->own_context = true;
     }
@@ -225,9 +284,12 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 
   BLI_addtail(&comp->queue, dsh);
 
-  /* Create only one context. */
-  if (comp->gl_context == NULL) {
-    comp->gl_context = WM_opengl_context_create();
+  /* Create the contexts only once. */
+  if (comp->workers_len == 0) {
+    comp->workers_len = drw_deferred_shader_workers_len();
+    for (int i = 0; i < comp->workers_len; i++) {
+      comp->workers[i].gl_context = WM_opengl_context_create();
+    }
     WM_opengl_context_activate(DST.gl_context);
     comp->own_context = true;
   }
@@ -263,9 +325,12 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
         }
 
         /* Wait for compilation to finish */
-        if ((comp->mat_compiling != NULL) && (comp->mat_compiling->mat == mat)) {
-          BLI_mutex_lock(&comp->compilation_lock);
-          BLI_mutex_unlock(&comp->compilation_lock);
+        for (int i = 0; i < comp->workers_len; i++) {
+          DRWShaderCompilerWorker *worker = &comp->workers[i];
+          if ((worker->mat_compiling != NULL) && (worker->mat_compiling->mat == mat)) {
+            BLI_mutex_lock(&worker->compilation_lock);
+            BLI_mutex_unlock(&worker->compilation_lock);
+          }
         }
 
         BLI_spin_unlock(&comp->list_lock);
@@ -0,0 +1,310 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software  Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2020 Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup editor/io
+ *
+ * Native STL import: the file is read at once and its triangles are turned into a mesh
+ * directly, corners at the same position are merged into a single vertex.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+#include "DNA_space_types.h"
+
+#include "BKE_context.h"
+#include "BKE_customdata.h"
+#include "BKE_global.h"
+#include "BKE_mesh.h"
+#include "BKE_report.h"
+
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
+#include "BLI_math_vector.h"
+#include "BLI_path_util.h"
+#include "BLI_sort.h"
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "DEG_depsgraph.h"
+
+#include "RNA_access.h"
+#include "RNA_define.h"
+
+#include "ED_object.h"
+
+#include "WM_api.h"
+#include "WM_types.h"
+
+#include "io_stl.h"
+
+/* 80 bytes of header followed by the number of triangles. */
+#define STL_BINARY_HEADER_SIZE 84
+/* Normal, three corners and the attribute byte count. */
+#define STL_BINARY_TRIANGLE_SIZE 50
+
+static uint stl_binary_tottri(const char *mem)
+{
+  uint tottri;
+  memcpy(&tottri, mem + 80, sizeof(tottri));
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint32(&tottri);
+  }
+  return tottri;
+}
+
+static bool stl_is_binary(const char *mem, size_t size)
+{
+  if (size < STL_BINARY_HEADER_SIZE) {
+    return false;
+  }
+  const size_t binary_size = STL_BINARY_HEADER_SIZE +
+                             (size_t)stl_binary_tottri(mem) * STL_BINARY_TRIANGLE_SIZE;
+  if (size == binary_size) {
+    return true;
+  }
+  /* Some binary files start with "solid" as well, others have trailing data. */
+  return !STRPREFIX(mem, "solid") && size > binary_size;
+}
+
+static float (*stl_read_binary(const char *mem, int *r_tottri))[3]
+{
+  const int tottri = (int)stl_binary_tottri(mem);
+  *r_tottri = tottri;
+  if (tottri == 0) {
+    return NULL;
+  }
+
+  float(*corners)[3] = MEM_malloc_arrayN((size_t)tottri * 3, sizeof(float[3]), __func__);
+
+  for (int i = 0; i < tottri; i++) {
+    const char *tri = mem + STL_BINARY_HEADER_SIZE + (size_t)i * STL_BINARY_TRIANGLE_SIZE;
+    /* Skip the normal, it is calculated from the corners. */
+    memcpy(corners[i * 3], tri + sizeof(float[3]), sizeof(float[3][3]));
+  }
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_float_array((float *)corners, tottri * 9);
+  }
+
+  return corners;
+}
+
+static float (*stl_read_ascii(char *mem, int *r_tottri))[3]
+{
+  /* Count the corners first so they are read into a single allocation. */
+  int totcorner = 0;
+  for (const char *str = strstr(mem, "vertex"); str; str = strstr(str + 6, "vertex")) {
+    totcorner++;
+  }
+
+  const int tottri = totcorner / 3;
+  *r_tottri = tottri;
+  if (tottri == 0) {
+    return NULL;
+  }
+
+  float(*corners)[3] = MEM_malloc_arrayN((size_t)tottri * 3, sizeof(float[3]), __func__);
+
+  int corner = 0;
+  for (char *str = strstr(mem, "vertex"); str && corner < tottri * 3;
+       str = strstr(str, "vertex")) {
+    str += 6;
+    for (int j = 0; j < 3; j++) {
+      corners[corner][j] = strtof(str, &str);
+    }
+    corner++;
+  }
+
+  return corners;
+}
+
+static int stl_corner_cmp(const void *a, const void *b, void *ctx)
+{
+  const float(*corners)[3] = ctx;
+  const float *co_a = corners[*(const int *)a];
+  const float *co_b = corners[*(const int *)b];
+  for (int j = 0; j < 3; j++) {
+    if (co_a[j] < co_b[j]) {
+      return -1;
+    }
+    if (co_a[j] > co_b[j]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Merge the corners at the same position by sorting them,
+ * triangles using a vertex more than once are skipped.
+ */
+static Mesh *stl_mesh_from_corners(const float (*corners)[3], int tottri, float scale)
+{
+  const int totcorner = tottri * 3;
+  int *order = MEM_malloc_arrayN(totcorner, sizeof(int), __func__);
+  int *corner_verts = MEM_malloc_arrayN(totcorner, sizeof(int), __func__);
+
+  for (int i = 0; i < totcorner; i++) {
+    order[i] = i;
+  }
+  BLI_qsort_r(order, totcorner, sizeof(int), stl_corner_cmp, (void *)corners);
+
+  int totvert = 0;
+  for (int i = 0; i < totcorner; i++) {
+    if (i == 0 || !equals_v3v3(corners[order[i]], corners[order[i - 1]])) {
+      totvert++;
+    }
+    corner_verts[order[i]] = totvert - 1;
+  }
+
+  int totpoly = 0;
+  for (int i = 0; i < tottri; i++) {
+    const int *tri = &corner_verts[i * 3];
+    if (!ELEM(tri[0], tri[1], tri[2]) && tri[1] != tri[2]) {
+      totpoly++;
+    }
+  }
+
+  Mesh *mesh = NULL;
+  if (totpoly != 0) {
+    mesh = BKE_mesh_new_nomain(totvert, 0, 0, totpoly * 3, totpoly);
+
+    for (int i = 0; i < totcorner; i++) {
+      mul_v3_v3fl(mesh->mvert[corner_verts[i]].co, corners[i], scale);
+    }
+
+    MPoly *mp = mesh->mpoly;
+    MLoop *ml = mesh->mloop;
+    for (int i = 0; i < tottri; i++) {
+      const int *tri = &corner_verts[i * 3];
+      if (ELEM(tri[0], tri[1], tri[2]) || tri[1] == tri[2]) {
+        continue;
+      }
+      mp->loopstart = (int)(ml - mesh->mloop);
+      mp->totloop = 3;
+      for (int j = 0; j < 3; j++, ml++) {
+        ml->v = tri[j];
+      }
+      mp++;
+    }
+
+    BKE_mesh_calc_edges(mesh, false, false);
+    BKE_mesh_calc_normals(mesh);
+  }
+
+  MEM_freeN(order);
+  MEM_freeN(corner_verts);
+  return mesh;
+}
+
+static int wm_stl_import_exec(bContext *C, wmOperator *op)
+{
+  if (!RNA_struct_property_is_set(op->ptr, "filepath")) {
+    BKE_report(op->reports, RPT_ERROR, "No filename given");
+    return OPERATOR_CANCELLED;
+  }
+
+  char filepath[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filepath);
+  const float scale = RNA_float_get(op->ptr, "global_scale");
+
+  /* One byte of padding to terminate ASCII files. */
+  size_t size;
+  char *mem = BLI_file_read_binary_as_mem(filepath, 1, &size);
+  if (mem == NULL) {
+    BKE_reportf(op->reports, RPT_ERROR, "Cannot open file '%s'", filepath);
+    return OPERATOR_CANCELLED;
+  }
+  mem[size] = '\0';
+
+  int tottri;
+  float(*corners)[3] = stl_is_binary(mem, size) ? stl_read_binary(mem, &tottri) :
+                                                   stl_read_ascii(mem, &tottri);
+  MEM_freeN(mem);
+
+  Mesh *mesh = NULL;
+  if (corners) {
+    mesh = stl_mesh_from_corners(corners, tottri, scale);
+    MEM_freeN(corners);
+  }
+
+  if (mesh == NULL) {
+    BKE_reportf(op->reports, RPT_ERROR, "No triangles found in '%s'", filepath);
+    return OPERATOR_CANCELLED;
+  }
+
+  /* Switch out of edit mode to avoid being stuck in it (T54326). */
+  Object *obedit = CTX_data_edit_object(C);
+  if (obedit) {
+    ED_object_mode_toggle(C, OB_MODE_EDIT);
+  }
+
+  char name[MAX_ID_NAME - 2];
+  BLI_strncpy(name, BLI_path_basename(filepath), sizeof(name));
+  BLI_path_extension_replace(name, sizeof(name), "");
+
+  const float zero[3] = {0.0f, 0.0f, 0.0f};
+  Object *ob = ED_object_add_type(C, OB_MESH, name, zero, zero, false, 0);
+  BKE_mesh_nomain_to_mesh(mesh, ob->data, ob, &CD_MASK_MESH, true);
+
+  DEG_id_tag_update(ob->data, ID_RECALC_GEOMETRY);
+  WM_event_add_notifier(C, NC_GEOM | ND_DATA, ob->data);
+
+  return OPERATOR_FINISHED;
+}
+
+void WM_OT_stl_import(wmOperatorType *ot)
+{
+  ot->name = "Import STL";
+  ot->description = "Load a STL file as a new mesh object";
+  ot->idname = "WM_OT_stl_import";
+
+  ot->invoke = WM_operator_filesel;
+  ot->exec = wm_stl_import_exec;
+  ot->poll = WM_operator_winactive;
+
+  ot->flag = OPTYPE_REGISTER | OPTYPE_UNDO;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER | FILE_TYPE_OBJECT_IO,
+                                 FILE_BLENDER,
+                                 FILE_OPENFILE,
+                                 WM_FILESEL_FILEPATH | WM_FILESEL_SHOW_PROPS,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_ALPHA);
+
+  PropertyRNA *prop = RNA_def_string(ot->srna, "filter_glob", "*.stl", 0, "", "");
+  RNA_def_property_flag(prop, PROP_HIDDEN);
+
+  RNA_def_float(ot->srna,
+                "global_scale",
+                1.0f,
+                1e-6f,
+                1e6f,
+                "Scale",
+                "Value by which to enlarge or shrink the imported mesh",
+                0.001f,
+                1000.0f);
+}
@@ -489,7 +489,7 @@ Object *ED_object_add_type(bContext *C,
    * use DEG_id_tag_update here perhaps.
    */
   DEG_id_type_tag(bmain, ID_OB);
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_objects_added(bmain);
   if (ob->data != NULL) {
     DEG_id_tag_update_ex(bmain, (ID *)ob->data, ID_RECALC_EDITORS);
   }
@@ -2676,7 +2676,7 @@ static int duplicate_exec(bContext *C, wmOperator *op)
 
   ED_outliner_select_sync_from_object_tag(C);
 
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_objects_added(bmain);
   DEG_id_tag_update(&scene->id, ID_RECALC_COPY_ON_WRITE | ID_RECALC_SELECT);
 
   WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
@@ -2766,7 +2766,7 @@ static int add_named_exec(bContext *C, wmOperator *op)
   copy_object_set_idnew(C);
 
   /* TODO(sergey): Only update relations for the current scene. */
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_objects_added(bmain);
 
   DEG_id_tag_update(&scene->id, ID_RECALC_SELECT);
   WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
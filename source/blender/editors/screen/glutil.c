@@ -537,6 +537,54 @@ void bglPolygonOffset(float viewdist, float dist)
 
 /* **** Color management helper functions for GLSL display/transform ***** */
 
+static int draw_imbuf_method_from_size(ImBuf *ibuf, size_t pixels_len)
+{
+  if (U.image_draw_method == IMAGE_DRAW_METHOD_AUTO) {
+    /* Use faster GLSL when CPU to GPU transfer is unlikely to be a bottleneck,
+     * otherwise do color management on CPU side. */
+    const size_t threshold = 2048 * 2048 * 4 * sizeof(float);
+    const size_t data_size = (ibuf->rect_float) ? sizeof(float) : sizeof(uchar);
+    const size_t size = pixels_len * ibuf->channels * data_size;
+
+    return (size > threshold) ? IMAGE_DRAW_METHOD_2DTEXTURE : IMAGE_DRAW_METHOD_GLSL;
+  }
+  else {
+    return U.image_draw_method;
+  }
+}
+
+/**
+ * Only the pixels inside the clipping rectangle are sent to the GPU, so a large image which is
+ * zoomed in can still use GLSL, instead of converting the whole image to display space on the
+ * CPU every time the view transform changes.
+ */
+static int draw_imbuf_method_clipping(ImBuf *ibuf,
+                                      float x,
+                                      float y,
+                                      float clip_min_x,
+                                      float clip_min_y,
+                                      float clip_max_x,
+                                      float clip_max_y,
+                                      float zoom_x,
+                                      float zoom_y)
+{
+  const bool use_clipping = ((clip_min_x < clip_max_x) && (clip_min_y < clip_max_y));
+  size_t pixels_len = (size_t)ibuf->x * (size_t)ibuf->y;
+
+  if (use_clipping && zoom_x > 0.0f && zoom_y > 0.0f) {
+    const float visible_x = (min_ff(clip_max_x, x + ibuf->x * zoom_x) - max_ff(clip_min_x, x)) /
+                            zoom_x;
+    const float visible_y = (min_ff(clip_max_y, y + ibuf->y * zoom_y) - max_ff(clip_min_y, y)) /
+                            zoom_y;
+    /* Rounded up, partially visible pixels are sent too. */
+    const size_t visible_len = (size_t)(ceilf(max_ff(visible_x, 0.0f)) + 1.0f) *
+                               (size_t)(ceilf(max_ff(visible_y, 0.0f)) + 1.0f);
+    pixels_len = min_zz(pixels_len, visible_len);
+  }
+
+  return draw_imbuf_method_from_size(ibuf, pixels_len);
+}
+
 /* Draw given image buffer on a screen using GLSL for display transform */
 void ED_draw_imbuf_clipping(ImBuf *ibuf,
                             float x,
@@ -563,7 +611,15 @@ void ED_draw_imbuf_clipping(ImBuf *ibuf,
   force_fallback |= ibuf->channels == 1;
 
   /* If user decided not to use GLSL, fallback to glaDrawPixelsAuto */
-  force_fallback |= (ED_draw_imbuf_method(ibuf) != IMAGE_DRAW_METHOD_GLSL);
+  force_fallback |= (draw_imbuf_method_clipping(ibuf,
+                                                x,
+                                                y,
+                                                clip_min_x,
+                                                clip_min_y,
+                                                clip_max_x,
+                                                clip_max_y,
+                                                zoom_x,
+                                                zoom_y) != IMAGE_DRAW_METHOD_GLSL);
 
   /* Try to draw buffer using GLSL display transform */
   if (force_fallback == false) {
@@ -742,18 +798,7 @@ void ED_draw_imbuf_ctx(
 
 int ED_draw_imbuf_method(ImBuf *ibuf)
 {
-  if (U.image_draw_method == IMAGE_DRAW_METHOD_AUTO) {
-    /* Use faster GLSL when CPU to GPU transfer is unlikely to be a bottleneck,
-     * otherwise do color management on CPU side. */
-    const size_t threshold = 2048 * 2048 * 4 * sizeof(float);
-    const size_t data_size = (ibuf->rect_float) ? sizeof(float) : sizeof(uchar);
-    const size_t size = ibuf->x * ibuf->y * ibuf->channels * data_size;
-
-    return (size > threshold) ? IMAGE_DRAW_METHOD_2DTEXTURE : IMAGE_DRAW_METHOD_GLSL;
-  }
-  else {
-    return U.image_draw_method;
-  }
+  return draw_imbuf_method_from_size(ibuf, (size_t)ibuf->x * (size_t)ibuf->y);
 }
 
 /* don't move to GPU_immediate_util.h because this uses user-prefs
@@ -3804,54 +3804,87 @@ static void proj_paint_state_viewport_init(ProjPaintState *ps, const char symmet
   add_v3_v3(ps->viewPos, ps->obmat_imat[3]);
 }
 
-static void proj_paint_state_screen_coords_init(ProjPaintState *ps, const int diameter)
-{
-  const MVert *mv;
-  float *projScreenCo;
-  float projMargin;
-  int a;
+/* Screen space bounds of the vertices projected by a thread. */
+typedef struct ProjPaintScreenBounds {
+  float min[2], max[2];
+} ProjPaintScreenBounds;
 
-  INIT_MINMAX2(ps->screenMin, ps->screenMax);
+/* Vertex arrays of big meshes are projected and culled over threads. */
+#define PROJ_VERT_PARALLEL_MIN 10000
 
-  ps->screenCoords = MEM_mallocN(sizeof(float) * ps->totvert_eval * 4, "ProjectPaint ScreenVerts");
-  projScreenCo = *ps->screenCoords;
+static void proj_paint_state_screen_coords_cb(void *__restrict userdata,
+                                              const int a,
+                                              const TaskParallelTLS *__restrict tls)
+{
+  const ProjPaintState *ps = userdata;
+  ProjPaintScreenBounds *bounds = tls->userdata_chunk;
+  const MVert *mv = &ps->mvert_eval[a];
+  float *projScreenCo = ps->screenCoords[a];
 
   if (ps->is_ortho) {
-    for (a = 0, mv = ps->mvert_eval; a < ps->totvert_eval; a++, mv++, projScreenCo += 4) {
-      mul_v3_m4v3(projScreenCo, ps->projectMat, mv->co);
+    mul_v3_m4v3(projScreenCo, ps->projectMat, mv->co);
 
-      /* screen space, not clamped */
-      projScreenCo[0] = (float)(ps->winx * 0.5f) + (ps->winx * 0.5f) * projScreenCo[0];
-      projScreenCo[1] = (float)(ps->winy * 0.5f) + (ps->winy * 0.5f) * projScreenCo[1];
-      minmax_v2v2_v2(ps->screenMin, ps->screenMax, projScreenCo);
-    }
+    /* screen space, not clamped */
+    projScreenCo[0] = (float)(ps->winx * 0.5f) + (ps->winx * 0.5f) * projScreenCo[0];
+    projScreenCo[1] = (float)(ps->winy * 0.5f) + (ps->winy * 0.5f) * projScreenCo[1];
+    minmax_v2v2_v2(bounds->min, bounds->max, projScreenCo);
   }
   else {
-    for (a = 0, mv = ps->mvert_eval; a < ps->totvert_eval; a++, mv++, projScreenCo += 4) {
-      copy_v3_v3(projScreenCo, mv->co);
-      projScreenCo[3] = 1.0f;
-
-      mul_m4_v4(ps->projectMat, projScreenCo);
-
-      if (projScreenCo[3] > ps->clip_start) {
-        /* screen space, not clamped */
-        projScreenCo[0] = (float)(ps->winx * 0.5f) +
-                          (ps->winx * 0.5f) * projScreenCo[0] / projScreenCo[3];
-        projScreenCo[1] = (float)(ps->winy * 0.5f) +
-                          (ps->winy * 0.5f) * projScreenCo[1] / projScreenCo[3];
-        /* Use the depth for bucket point occlusion */
-        projScreenCo[2] = projScreenCo[2] / projScreenCo[3];
-        minmax_v2v2_v2(ps->screenMin, ps->screenMax, projScreenCo);
-      }
-      else {
-        /* TODO - deal with cases where 1 side of a face goes behind the view ?
-         *
-         * After some research this is actually very tricky, only option is to
-         * clip the derived mesh before painting, which is a Pain */
-        projScreenCo[0] = FLT_MAX;
-      }
+    copy_v3_v3(projScreenCo, mv->co);
+    projScreenCo[3] = 1.0f;
+
+    mul_m4_v4(ps->projectMat, projScreenCo);
+
+    if (projScreenCo[3] > ps->clip_start) {
+      /* screen space, not clamped */
+      projScreenCo[0] = (float)(ps->winx * 0.5f) +
+                        (ps->winx * 0.5f) * projScreenCo[0] / projScreenCo[3];
+      projScreenCo[1] = (float)(ps->winy * 0.5f) +
+                        (ps->winy * 0.5f) * projScreenCo[1] / projScreenCo[3];
+      /* Use the depth for bucket point occlusion */
+      projScreenCo[2] = projScreenCo[2] / projScreenCo[3];
+      minmax_v2v2_v2(bounds->min, bounds->max, projScreenCo);
     }
+    else {
+      /* TODO - deal with cases where 1 side of a face goes behind the view ?
+       *
+       * After some research this is actually very tricky, only option is to
+       * clip the derived mesh before painting, which is a Pain */
+      projScreenCo[0] = FLT_MAX;
+    }
+  }
+}
+
+static void proj_paint_state_screen_coords_finalize(void *__restrict userdata,
+                                                    void *__restrict userdata_chunk)
+{
+  ProjPaintState *ps = userdata;
+  const ProjPaintScreenBounds *bounds = userdata_chunk;
+
+  for (int i = 0; i < 2; i++) {
+    ps->screenMin[i] = min_ff(ps->screenMin[i], bounds->min[i]);
+    ps->screenMax[i] = max_ff(ps->screenMax[i], bounds->max[i]);
   }
+}
+
+static void proj_paint_state_screen_coords_init(ProjPaintState *ps, const int diameter)
+{
+  ProjPaintScreenBounds bounds;
+  float projMargin;
+
+  INIT_MINMAX2(ps->screenMin, ps->screenMax);
+  INIT_MINMAX2(bounds.min, bounds.max);
+
+  ps->screenCoords = MEM_mallocN(sizeof(float) * ps->totvert_eval * 4, "ProjectPaint ScreenVerts");
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (ps->totvert_eval >= PROJ_VERT_PARALLEL_MIN);
+  settings.userdata_chunk = &bounds;
+  settings.userdata_chunk_size = sizeof(bounds);
+  settings.func_finalize = proj_paint_state_screen_coords_finalize;
+  BLI_task_parallel_range(
+      0, ps->totvert_eval, ps, proj_paint_state_screen_coords_cb, &settings);
 
   /* If this border is not added we get artifacts for faces that
    * have a parallel edge and at the bounds of the 2D projected verts eg
@@ -3969,40 +4002,48 @@ static void proj_paint_state_thread_init(ProjPaintState *ps, const bool reset_th
   }
 }
 
+static void proj_paint_state_vert_flags_cb(void *__restrict userdata,
+                                           const int a,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ProjPaintState *ps = userdata;
+  const MVert *mv = &ps->mvert_eval[a];
+  float viewDirPersp[3];
+  float no[3];
+
+  normal_short_to_float_v3(no, mv->no);
+  if (UNLIKELY(ps->is_flip_object)) {
+    negate_v3(no);
+  }
+
+  if (ps->is_ortho) {
+    if (dot_v3v3(ps->viewDir, no) <= ps->normal_angle__cos) {
+      /* 1 vert of this face is towards us */
+      ps->vertFlags[a] |= PROJ_VERT_CULL;
+    }
+  }
+  else {
+    sub_v3_v3v3(viewDirPersp, ps->viewPos, mv->co);
+    normalize_v3(viewDirPersp);
+    if (UNLIKELY(ps->is_flip_object)) {
+      negate_v3(viewDirPersp);
+    }
+    if (dot_v3v3(viewDirPersp, no) <= ps->normal_angle__cos) {
+      /* 1 vert of this face is towards us */
+      ps->vertFlags[a] |= PROJ_VERT_CULL;
+    }
+  }
+}
+
 static void proj_paint_state_vert_flags_init(ProjPaintState *ps)
 {
   if (ps->do_backfacecull && ps->do_mask_normal) {
-    float viewDirPersp[3];
-    const MVert *mv;
-    float no[3];
-    int a;
-
     ps->vertFlags = MEM_callocN(sizeof(char) * ps->totvert_eval, "paint-vertFlags");
 
-    for (a = 0, mv = ps->mvert_eval; a < ps->totvert_eval; a++, mv++) {
-      normal_short_to_float_v3(no, mv->no);
-      if (UNLIKELY(ps->is_flip_object)) {
-        negate_v3(no);
-      }
-
-      if (ps->is_ortho) {
-        if (dot_v3v3(ps->viewDir, no) <= ps->normal_angle__cos) {
-          /* 1 vert of this face is towards us */
-          ps->vertFlags[a] |= PROJ_VERT_CULL;
-        }
-      }
-      else {
-        sub_v3_v3v3(viewDirPersp, ps->viewPos, mv->co);
-        normalize_v3(viewDirPersp);
-        if (UNLIKELY(ps->is_flip_object)) {
-          negate_v3(viewDirPersp);
-        }
-        if (dot_v3v3(viewDirPersp, no) <= ps->normal_angle__cos) {
-          /* 1 vert of this face is towards us */
-          ps->vertFlags[a] |= PROJ_VERT_CULL;
-        }
-      }
-    }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (ps->totvert_eval >= PROJ_VERT_PARALLEL_MIN);
+    BLI_task_parallel_range(0, ps->totvert_eval, ps, proj_paint_state_vert_flags_cb, &settings);
   }
   else {
     ps->vertFlags = NULL;
@@ -23,6 +23,7 @@
 #include "BLI_blenlib.h"
 #include "BLI_math.h"
 #include "BLI_bitmap.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -630,13 +631,13 @@ static void gradientVert_update(WPGradient_userData *grad_data, int index)
   }
 }
 
-static void gradientVertUpdate__mapFunc(void *userData,
-                                        int index,
-                                        const float UNUSED(co[3]),
-                                        const float UNUSED(no_f[3]),
-                                        const short UNUSED(no_s[3]))
+/* Only the cached screen coordinates are used after the first pass, so the original vertices
+ * are updated directly and in parallel (each one only changes its own deform weights). */
+static void gradientVertUpdate_cb(void *__restrict userdata,
+                                  const int index,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  WPGradient_userData *grad_data = userData;
+  WPGradient_userData *grad_data = userdata;
   WPGradient_vertStore *vs = &grad_data->vert_cache->elem[index];
 
   if (vs->sco[0] == FLT_MAX) {
@@ -801,17 +802,22 @@ static int paint_weight_gradient_exec(bContext *C, wmOperator *op)
     data.weightpaint = BKE_brush_weight_get(scene, brush);
   }
 
-  ED_view3d_init_mats_rv3d(ob, ar->regiondata);
+  if (data.is_init) {
+    ED_view3d_init_mats_rv3d(ob, ar->regiondata);
 
-  Scene *scene_eval = DEG_get_evaluated_scene(depsgraph);
-  Object *ob_eval = DEG_get_evaluated_object(depsgraph, ob);
+    Scene *scene_eval = DEG_get_evaluated_scene(depsgraph);
+    Object *ob_eval = DEG_get_evaluated_object(depsgraph, ob);
 
-  CustomData_MeshMasks cddata_masks = scene->customdata_mask;
-  cddata_masks.vmask |= CD_MASK_ORIGINDEX;
-  cddata_masks.emask |= CD_MASK_ORIGINDEX;
-  cddata_masks.pmask |= CD_MASK_ORIGINDEX;
-  Mesh *me_eval = mesh_get_eval_final(depsgraph, scene_eval, ob_eval, &cddata_masks);
-  if (data.is_init) {
+    CustomData_MeshMasks cddata_masks = scene->customdata_mask;
+    cddata_masks.vmask |= CD_MASK_ORIGINDEX;
+    cddata_masks.emask |= CD_MASK_ORIGINDEX;
+    cddata_masks.pmask |= CD_MASK_ORIGINDEX;
+    Mesh *me_eval = mesh_get_eval_final(depsgraph, scene_eval, ob_eval, &cddata_masks);
+
+    /* Vertices which are not mapped by the evaluated mesh are skipped by the updates. */
+    for (int i = 0; i < me->totvert; i++) {
+      copy_v2_fl(vert_cache->elem[i].sco, FLT_MAX);
+    }
     data.vert_visit = BLI_BITMAP_NEW(me->totvert, __func__);
 
     BKE_mesh_foreach_mapped_vert(me_eval, gradientVertInit__mapFunc, &data, MESH_FOREACH_NOP);
@@ -820,7 +826,10 @@ static int paint_weight_gradient_exec(bContext *C, wmOperator *op)
     data.vert_visit = NULL;
   }
   else {
-    BKE_mesh_foreach_mapped_vert(me_eval, gradientVertUpdate__mapFunc, &data, MESH_FOREACH_NOP);
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (me->totvert >= 10000);
+    BLI_task_parallel_range(0, me->totvert, &data, gradientVertUpdate_cb, &settings);
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
@@ -1837,16 +1837,16 @@ static float brush_strength(const Sculpt *sd,
   }
 }
 
-/* Return a multiplier for brush strength on a particular vertex. */
-float tex_strength(SculptSession *ss,
-                   const Brush *br,
-                   const float brush_point[3],
-                   const float len,
-                   const short vno[3],
-                   const float fno[3],
-                   const float mask,
-                   const int vertex_index,
-                   const int thread_id)
+/* Same as #tex_strength with the falloff of the brush curve already evaluated. */
+static float tex_strength_with_falloff(SculptSession *ss,
+                                       const Brush *br,
+                                       const float brush_point[3],
+                                       const float falloff,
+                                       const short vno[3],
+                                       const float fno[3],
+                                       const float mask,
+                                       const int vertex_index,
+                                       const int thread_id)
 {
   StrokeCache *cache = ss->cache;
   const Scene *scene = cache->vc->scene;
@@ -1910,7 +1910,7 @@ float tex_strength(SculptSession *ss,
   }
 
   /* Falloff curve */
-  avg *= BKE_brush_curve_strength(br, len, cache->radius);
+  avg *= falloff;
   avg *= frontface(br, cache->view_normal, vno, fno);
 
   /* Paint mask */
@@ -1922,6 +1922,22 @@ float tex_strength(SculptSession *ss,
   return avg;
 }
 
+/* Return a multiplier for brush strength on a particular vertex. */
+float tex_strength(SculptSession *ss,
+                   const Brush *br,
+                   const float brush_point[3],
+                   const float len,
+                   const short vno[3],
+                   const float fno[3],
+                   const float mask,
+                   const int vertex_index,
+                   const int thread_id)
+{
+  const float falloff = BKE_brush_curve_strength(br, len, ss->cache->radius);
+  return tex_strength_with_falloff(
+      ss, br, brush_point, falloff, vno, fno, mask, vertex_index, thread_id);
+}
+
 /* Test AABB against sphere */
 bool sculpt_search_sphere_cb(PBVHNode *node, void *data_v)
 {
@@ -2862,19 +2878,34 @@ static void do_draw_brush_task_cb_ex(void *__restrict userdata,
   SculptBrushTestFn sculpt_brush_test_sq_fn = sculpt_brush_test_init_with_falloff_shape(
       ss, &test, data->brush->falloff_shape);
 
+  /* Test all vertices of the node first, so the falloff is evaluated for the whole node at
+   * once with #BKE_brush_curve_strength_array. */
+  int totvert;
+  BKE_pbvh_node_num_verts(ss->pbvh, data->nodes[n], &totvert, NULL);
+  float *dist = MEM_mallocN(sizeof(*dist) * 2 * totvert, __func__);
+  float *falloff = dist + totvert;
+
   BKE_pbvh_vertex_iter_begin(ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE)
   {
-    if (sculpt_brush_test_sq_fn(&test, vd.co)) {
+    dist[vd.i] = sculpt_brush_test_sq_fn(&test, vd.co) ? sqrtf(test.dist) : FLT_MAX;
+  }
+  BKE_pbvh_vertex_iter_end;
+
+  BKE_brush_curve_strength_array(brush, dist, falloff, totvert, ss->cache->radius);
+
+  BKE_pbvh_vertex_iter_begin(ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE)
+  {
+    if (dist[vd.i] != FLT_MAX) {
       /* offset vertex */
-      const float fade = tex_strength(ss,
-                                      brush,
-                                      vd.co,
-                                      sqrtf(test.dist),
-                                      vd.no,
-                                      vd.fno,
-                                      vd.mask ? *vd.mask : 0.0f,
-                                      vd.index,
-                                      tls->thread_id);
+      const float fade = tex_strength_with_falloff(ss,
+                                                   brush,
+                                                   vd.co,
+                                                   falloff[vd.i],
+                                                   vd.no,
+                                                   vd.fno,
+                                                   vd.mask ? *vd.mask : 0.0f,
+                                                   vd.index,
+                                                   tls->thread_id);
 
       mul_v3_v3fl(proxy[vd.i], offset, fade);
 
@@ -2884,6 +2915,8 @@ static void do_draw_brush_task_cb_ex(void *__restrict userdata,
     }
   }
   BKE_pbvh_vertex_iter_end;
+
+  MEM_freeN(dist);
 }
 
 static void do_draw_brush(Sculpt *sd, Object *ob, PBVHNode **nodes, int totnode)
@@ -151,6 +151,10 @@ typedef struct SculptUndoNode {
   float pivot_pos[3];
   float pivot_rot[4];
 
+  /* Arrays compressed in the background once the step is pushed,
+   * NULL while they're used (not compressed), see: #sculpt_undo_node_compress. */
+  struct SculptUndoNodeCompressed *compressed;
+
   size_t undo_size;
 } SculptUndoNode;
 
@@ -26,6 +26,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
 #include "BLI_string.h"
@@ -66,13 +68,19 @@
 #include "bmesh.h"
 #include "sculpt_intern.h"
 
+#include "zlib.h"
+
 typedef struct UndoSculpt {
   ListBase nodes;
 
   size_t undo_size;
+
+  /* Compresses the nodes in the background, see: #sculpt_undo_compress_begin. */
+  TaskPool *compress_pool;
 } UndoSculpt;
 
 static UndoSculpt *sculpt_undo_get_nodes(void);
+static void sculpt_undo_node_compressed_free(SculptUndoNode *unode);
 
 static void update_cb(PBVHNode *node, void *rebuild)
 {
@@ -692,6 +700,9 @@ static void sculpt_undo_free_list(ListBase *lb)
     if (unode->mask) {
       MEM_freeN(unode->mask);
     }
+    if (unode->compressed) {
+      sculpt_undo_node_compressed_free(unode);
+    }
 
     if (unode->bm_entry) {
       BM_log_entry_drop(unode->bm_entry);
@@ -747,7 +758,12 @@ SculptUndoNode *sculpt_undo_get_node(PBVHNode *node)
     return NULL;
   }
 
-  return BLI_findptr(&usculpt->nodes, node, offsetof(SculptUndoNode, node));
+  SculptUndoNode *unode = BLI_findptr(&usculpt->nodes, node, offsetof(SculptUndoNode, node));
+  /* The arrays of a pushed step may be touched by the compression thread. */
+  if (unode && unode->compressed) {
+    return NULL;
+  }
+  return unode;
 }
 
 static void sculpt_undo_alloc_and_store_hidden(PBVH *pbvh, SculptUndoNode *unode)
@@ -1140,6 +1156,219 @@ void sculpt_undo_push_end(void)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * Once a step is pushed its arrays are only needed again to undo or redo it,
+ * so they're compressed on a background thread and uncompressed before restoring them.
+ *
+ * Before compressing, every 32 bit word is XOR'ed with the same component of the previous
+ * vertex: vertices next to each other in a node are close, so the sign, exponent and high
+ * mantissa bits of their values cancel out. The bytes are then grouped by their position in
+ * the word, so the (mostly zero) high bytes end up next to each other.
+ * \{ */
+
+#define SCULPT_UNDO_ARRAYS_NUM 5
+
+/* Number of 32 bit words per vertex (or grid) of the arrays of #sculpt_undo_node_arrays. */
+static const int sculpt_undo_arrays_stride[SCULPT_UNDO_ARRAYS_NUM] = {3, 3, 1, 1, 1};
+
+typedef struct SculptUndoNodeCompressed {
+  /* NULL when compressing didn't make the arrays smaller, they're kept as is then. */
+  void *data;
+  size_t data_len;
+  /* Size in bytes of each array of #sculpt_undo_node_arrays. */
+  size_t arrays_len[SCULPT_UNDO_ARRAYS_NUM];
+} SculptUndoNodeCompressed;
+
+static void sculpt_undo_node_arrays(SculptUndoNode *unode, void **r_arrays[SCULPT_UNDO_ARRAYS_NUM])
+{
+  r_arrays[0] = (void **)&unode->co;
+  r_arrays[1] = (void **)&unode->orig_co;
+  r_arrays[2] = (void **)&unode->mask;
+  r_arrays[3] = (void **)&unode->index;
+  r_arrays[4] = (void **)&unode->grids;
+}
+
+static bool sculpt_undo_node_has_arrays(SculptUndoNode *unode)
+{
+  void **arrays[SCULPT_UNDO_ARRAYS_NUM];
+  sculpt_undo_node_arrays(unode, arrays);
+  for (int i = 0; i < SCULPT_UNDO_ARRAYS_NUM; i++) {
+    if (*arrays[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Runs in a thread, only accesses \a unode and \a data_size (atomically). */
+static void sculpt_undo_node_compress(SculptUndoNode *unode, size_t *data_size)
+{
+  SculptUndoNodeCompressed *compressed = unode->compressed;
+  void **arrays[SCULPT_UNDO_ARRAYS_NUM];
+  size_t words_len = 0;
+
+  sculpt_undo_node_arrays(unode, arrays);
+  for (int i = 0; i < SCULPT_UNDO_ARRAYS_NUM; i++) {
+    compressed->arrays_len[i] = *arrays[i] ? MEM_allocN_len(*arrays[i]) : 0;
+    words_len += compressed->arrays_len[i] / sizeof(uint);
+  }
+
+  const size_t raw_len = words_len * sizeof(uint);
+  uint *words = MEM_mallocN(raw_len, __func__);
+  uint *w = words;
+  for (int i = 0; i < SCULPT_UNDO_ARRAYS_NUM; i++) {
+    const uint *src = *arrays[i];
+    const size_t len = compressed->arrays_len[i] / sizeof(uint);
+    const size_t stride = (size_t)sculpt_undo_arrays_stride[i];
+    for (size_t j = 0; j < len; j++) {
+      w[j] = (j < stride) ? src[j] : (src[j] ^ src[j - stride]);
+    }
+    w += len;
+  }
+
+  uchar *bytes = MEM_mallocN(raw_len, __func__);
+  for (size_t j = 0; j < words_len; j++) {
+    for (int b = 0; b < (int)sizeof(uint); b++) {
+      bytes[b * words_len + j] = ((const uchar *)&words[j])[b];
+    }
+  }
+  MEM_freeN(words);
+
+  uLongf data_len = compressBound(raw_len);
+  void *data = MEM_mallocN(data_len, __func__);
+  const bool ok = (compress2(data, &data_len, bytes, raw_len, Z_BEST_SPEED) == Z_OK) &&
+                  (data_len < raw_len);
+  MEM_freeN(bytes);
+
+  if (!ok) {
+    MEM_freeN(data);
+    return;
+  }
+
+  compressed->data = MEM_reallocN(data, data_len);
+  compressed->data_len = data_len;
+  for (int i = 0; i < SCULPT_UNDO_ARRAYS_NUM; i++) {
+    MEM_SAFE_FREE(*arrays[i]);
+  }
+
+  atomic_sub_and_fetch_z(data_size, raw_len - data_len);
+}
+
+static void sculpt_undo_node_uncompress(SculptUndoNode *unode, size_t *data_size)
+{
+  SculptUndoNodeCompressed *compressed = unode->compressed;
+
+  if (compressed->data) {
+    void **arrays[SCULPT_UNDO_ARRAYS_NUM];
+    size_t words_len = 0;
+
+    sculpt_undo_node_arrays(unode, arrays);
+    for (int i = 0; i < SCULPT_UNDO_ARRAYS_NUM; i++) {
+      words_len += compressed->arrays_len[i] / sizeof(uint);
+    }
+
+    const size_t raw_len = words_len * sizeof(uint);
+    uchar *bytes = MEM_mallocN(raw_len, __func__);
+    uLongf bytes_len = raw_len;
+    const int result = uncompress(bytes, &bytes_len, compressed->data, compressed->data_len);
+    BLI_assert(result == Z_OK && bytes_len == raw_len);
+    UNUSED_VARS_NDEBUG(result);
+
+    uint *words = MEM_mallocN(raw_len, __func__);
+    for (size_t j = 0; j < words_len; j++) {
+      for (int b = 0; b < (int)sizeof(uint); b++) {
+        ((uchar *)&words[j])[b] = bytes[b * words_len + j];
+      }
+    }
+    MEM_freeN(bytes);
+
+    const uint *w = words;
+    for (int i = 0; i < SCULPT_UNDO_ARRAYS_NUM; i++) {
+      const size_t len = compressed->arrays_len[i] / sizeof(uint);
+      const size_t stride = (size_t)sculpt_undo_arrays_stride[i];
+      if (len == 0) {
+        continue;
+      }
+      uint *dst = MEM_mapallocN(compressed->arrays_len[i], __func__);
+      for (size_t j = 0; j < len; j++) {
+        dst[j] = (j < stride) ? w[j] : (w[j] ^ dst[j - stride]);
+      }
+      *arrays[i] = dst;
+      w += len;
+    }
+    MEM_freeN(words);
+
+    atomic_add_and_fetch_z(data_size, raw_len - compressed->data_len);
+  }
+
+  sculpt_undo_node_compressed_free(unode);
+}
+
+static void sculpt_undo_node_compressed_free(SculptUndoNode *unode)
+{
+  if (unode->compressed->data) {
+    MEM_freeN(unode->compressed->data);
+  }
+  MEM_freeN(unode->compressed);
+  unode->compressed = NULL;
+}
+
+static void sculpt_undo_compress_task_cb(TaskPool *__restrict pool,
+                                         void *taskdata,
+                                         int UNUSED(threadid))
+{
+  sculpt_undo_node_compress(taskdata, BLI_task_pool_userdata(pool));
+}
+
+/**
+ * Compress the arrays of the nodes in the background,
+ * \a data_size is reduced by the memory saved as it goes.
+ */
+static void sculpt_undo_compress_begin(UndoSculpt *usculpt, size_t *data_size)
+{
+  BLI_assert(usculpt->compress_pool == NULL);
+
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    if (unode->compressed || !sculpt_undo_node_has_arrays(unode)) {
+      continue;
+    }
+    if (usculpt->compress_pool == NULL) {
+      TaskScheduler *scheduler = BLI_task_scheduler_get();
+      usculpt->compress_pool = BLI_task_pool_create_background(scheduler, data_size);
+    }
+    /* Set before the task runs, so the main thread knows not to use the arrays anymore. */
+    unode->compressed = MEM_callocN(sizeof(*unode->compressed), __func__);
+    BLI_task_pool_push(
+        usculpt->compress_pool, sculpt_undo_compress_task_cb, unode, false, TASK_PRIORITY_LOW);
+  }
+}
+
+/* Wait for the compression started by #sculpt_undo_compress_begin to be done. */
+static void sculpt_undo_compress_wait(UndoSculpt *usculpt)
+{
+  if (usculpt->compress_pool) {
+    BLI_task_pool_work_and_wait(usculpt->compress_pool);
+    BLI_task_pool_free(usculpt->compress_pool);
+    usculpt->compress_pool = NULL;
+  }
+}
+
+/* Make the arrays of all nodes available again. */
+static void sculpt_undo_compress_end(UndoSculpt *usculpt, size_t *data_size)
+{
+  sculpt_undo_compress_wait(usculpt);
+
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    if (unode->compressed) {
+      sculpt_undo_node_uncompress(unode, data_size);
+    }
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Implements ED Undo System
  * \{ */
@@ -1166,6 +1395,9 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
   SculptUndoStep *us = (SculptUndoStep *)us_p;
   us->step.data_size = us->data.undo_size;
 
+  /* The nodes aren't used anymore until this step is undone. */
+  sculpt_undo_compress_begin(&us->data, &us->step.data_size);
+
   SculptUndoNode *unode = us->data.nodes.last;
   if (unode && unode->type == SCULPT_UNDO_DYNTOPO_END) {
     us->step.use_memfile_step = true;
@@ -1184,7 +1416,9 @@ static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == true);
+  sculpt_undo_compress_end(&us->data, &us->step.data_size);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_compress_begin(&us->data, &us->step.data_size);
   us->step.is_applied = false;
 }
 
@@ -1193,7 +1427,9 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == false);
+  sculpt_undo_compress_end(&us->data, &us->step.data_size);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
+  sculpt_undo_compress_begin(&us->data, &us->step.data_size);
   us->step.is_applied = true;
 }
 
@@ -1282,6 +1518,7 @@ static void sculpt_undosys_step_decode(
 static void sculpt_undosys_step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+  sculpt_undo_compress_wait(&us->data);
   sculpt_undo_free_list(&us->data.nodes);
 }
 
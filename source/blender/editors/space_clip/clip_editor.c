@@ -1141,15 +1141,16 @@ static bool prefetch_check_early_out(const bContext *C)
   return false;
 }
 
-void clip_start_prefetch_job(const bContext *C)
+static void prefetch_job_start(const bContext *C,
+                               MovieClip *clip,
+                               int start_frame,
+                               int current_frame,
+                               int end_frame,
+                               short render_size,
+                               short render_flag)
 {
   wmJob *wm_job;
   PrefetchJob *pj;
-  SpaceClip *sc = CTX_wm_space_clip(C);
-
-  if (prefetch_check_early_out(C)) {
-    return;
-  }
 
   wm_job = WM_jobs_get(CTX_wm_manager(C),
                        CTX_wm_window(C),
@@ -1160,12 +1161,12 @@ void clip_start_prefetch_job(const bContext *C)
 
   /* create new job */
   pj = MEM_callocN(sizeof(PrefetchJob), "prefetch job");
-  pj->clip = ED_space_clip_get_clip(sc);
-  pj->start_frame = prefetch_get_start_frame(C);
-  pj->current_frame = sc->user.framenr;
-  pj->end_frame = prefetch_get_final_frame(C);
-  pj->render_size = sc->user.render_size;
-  pj->render_flag = sc->user.render_flag;
+  pj->clip = clip;
+  pj->start_frame = start_frame;
+  pj->current_frame = current_frame;
+  pj->end_frame = end_frame;
+  pj->render_size = render_size;
+  pj->render_flag = render_flag;
 
   WM_jobs_customdata_set(wm_job, pj, prefetch_freejob);
   WM_jobs_timer(wm_job, 0.2, NC_MOVIECLIP | ND_DISPLAY, 0);
@@ -1176,3 +1177,47 @@ void clip_start_prefetch_job(const bContext *C)
   /* and finally start the job */
   WM_jobs_start(CTX_wm_manager(C), wm_job);
 }
+
+void clip_start_prefetch_job(const bContext *C)
+{
+  SpaceClip *sc = CTX_wm_space_clip(C);
+
+  if (prefetch_check_early_out(C)) {
+    return;
+  }
+
+  prefetch_job_start(C,
+                     ED_space_clip_get_clip(sc),
+                     prefetch_get_start_frame(C),
+                     sc->user.framenr,
+                     prefetch_get_final_frame(C),
+                     sc->user.render_size,
+                     sc->user.render_flag);
+}
+
+/**
+ * Read ahead the frames markers are about to be tracked on, while the previous ones are tracked.
+ * Frames are read at full resolution, which is what the tracker uses.
+ *
+ * \param current_frame, end_frame: Range of scene frames in tracking direction.
+ */
+void clip_start_prefetch_tracking_job(const bContext *C,
+                                      MovieClip *clip,
+                                      int current_frame,
+                                      int end_frame)
+{
+  /* Frames are read from the current one towards the end of the range, in the queue going
+   * backwards is done by starting at the end of the range. */
+  prefetch_job_start(C,
+                     clip,
+                     min_ii(current_frame, end_frame),
+                     current_frame,
+                     max_ii(current_frame, end_frame),
+                     MCLIP_PROXY_RENDER_SIZE_FULL,
+                     0);
+}
+
+void clip_stop_prefetch_job(wmWindowManager *wm)
+{
+  WM_jobs_stop(wm, NULL, prefetch_startjob);
+}
@@ -33,6 +33,7 @@ struct ScrArea;
 struct SpaceClip;
 struct bContext;
 struct wmOperatorType;
+struct wmWindowManager;
 
 /* channel heights */
 #define CHANNEL_FIRST (-UI_TIME_SCRUB_MARGIN_Y - CHANNEL_HEIGHT_HALF - CHANNEL_SKIP)
@@ -68,6 +69,11 @@ void clip_draw_cache_and_notes(const bContext *C, SpaceClip *sc, ARegion *ar);
 
 /* clip_editor.c */
 void clip_start_prefetch_job(const struct bContext *C);
+void clip_start_prefetch_tracking_job(const struct bContext *C,
+                                      struct MovieClip *clip,
+                                      int current_frame,
+                                      int end_frame);
+void clip_stop_prefetch_job(struct wmWindowManager *wm);
 
 /* clip_graph_draw.c */
 void clip_draw_graph(struct SpaceClip *sc, struct ARegion *ar, struct Scene *scene);
@@ -279,6 +279,9 @@ static void track_markers_endjob(void *tmv)
     // ED_update_for_newframe(tmj->main, tmj->scene);
   }
 
+  /* Tracking could have stopped before reaching the end of the prefetched range. */
+  clip_stop_prefetch_job(tmj->wm);
+
   BKE_autotrack_context_sync(tmj->context);
   BKE_autotrack_context_finish(tmj->context);
 
@@ -353,6 +356,13 @@ static int track_markers(bContext *C, wmOperator *op, bool use_job)
     WM_jobs_start(CTX_wm_manager(C), wm_job);
     WM_cursor_wait(0);
 
+    /* Read the frames to be tracked while the previous ones are being tracked, so tracking does
+     * not have to wait for the footage to be read from disk. */
+    clip_start_prefetch_tracking_job(C,
+                                     clip,
+                                     BKE_movieclip_remap_clip_to_scene_frame(clip, tmj->sfra),
+                                     BKE_movieclip_remap_clip_to_scene_frame(clip, tmj->efra));
+
     /* Add modal handler for ESC. */
     WM_event_add_modal_handler(C, op);
 
@@ -1265,7 +1265,11 @@ static TreeElement *outliner_show_active_get_element(bContext *C,
     if (obact->mode & OB_MODE_POSE) {
       bPoseChannel *pchan = CTX_data_active_pose_bone(C);
       if (pchan) {
-        te = outliner_find_posechannel(&te_obact->subtree, pchan);
+        /* Channels are not built while the pose is collapsed, show the object then. */
+        TreeElement *te_pchan = outliner_find_posechannel(&te_obact->subtree, pchan);
+        if (te_pchan) {
+          te = te_pchan;
+        }
       }
     }
     else if (obact->mode & OB_MODE_EDIT) {
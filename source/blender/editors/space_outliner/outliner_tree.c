@@ -352,7 +352,14 @@ static void outliner_add_object_contents(SpaceOutliner *soops,
     tenla->name = IFACE_("Pose");
 
     /* channels undefined in editmode, but we want the 'tenla' pose icon itself */
-    if ((arm->edbo == NULL) && (ob->mode & OB_MODE_POSE)) {
+    if ((arm->edbo == NULL) && (ob->mode & OB_MODE_POSE) &&
+        !TSELEM_OPEN(TREESTORE(tenla), soops)) {
+      /* Armatures can have many bones, only build the channels when they are visible. */
+      if (ob->pose->chanbase.first) {
+        tenla->flag |= TE_LAZY_CLOSED;
+      }
+    }
+    else if ((arm->edbo == NULL) && (ob->mode & OB_MODE_POSE)) {
       TreeElement *ten;
       int a = 0, const_index = 1000; /* ensure unique id for bone constraints */
 
@@ -507,10 +514,16 @@ static void outliner_add_object_contents(SpaceOutliner *soops,
     int a;
 
     tenla->name = IFACE_("Vertex Groups");
-    for (defgroup = ob->defbase.first, a = 0; defgroup; defgroup = defgroup->next, a++) {
-      ten = outliner_add_element(soops, &tenla->subtree, ob, tenla, TSE_DEFGROUP, a);
-      ten->name = defgroup->name;
-      ten->directdata = defgroup;
+    if (TSELEM_OPEN(TREESTORE(tenla), soops)) {
+      for (defgroup = ob->defbase.first, a = 0; defgroup; defgroup = defgroup->next, a++) {
+        ten = outliner_add_element(soops, &tenla->subtree, ob, tenla, TSE_DEFGROUP, a);
+        ten->name = defgroup->name;
+        ten->directdata = defgroup;
+      }
+    }
+    else {
+      /* Built when the list is visible, like pose channels. */
+      tenla->flag |= TE_LAZY_CLOSED;
     }
   }
 
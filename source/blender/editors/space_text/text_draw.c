@@ -1651,9 +1651,12 @@ void draw_text_main(SpaceText *st, ARegion *ar)
   /* draw cursor, margin, selection and highlight */
   draw_text_decoration(st, ar);
 
-  /* draw the text */
+  /* draw the text, the colors of the syntax highlighting are stored per glyph
+   * so all visible lines are drawn at once. */
   UI_FontThemeColor(tdc.font_id, TH_TEXT);
 
+  BLF_batch_draw_begin();
+
   for (i = 0; y > clip_min_y && i < viewlines && tmp; i++, tmp = tmp->next) {
     if (tdc.syntax_highlight && !tmp->format) {
       tft->format_line(st, tmp, false);
@@ -1696,6 +1699,8 @@ void draw_text_main(SpaceText *st, ARegion *ar)
     wrap_skip = 0;
   }
 
+  BLF_batch_draw_end();
+
   if (st->flags & ST_SHOW_MARGIN) {
     margin_column_x = x + st->runtime.cwidth_px * (st->margin_column - st->left);
     if (margin_column_x >= x) {
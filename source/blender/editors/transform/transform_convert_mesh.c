@@ -32,6 +32,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_linklist_stack.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_crazyspace.h"
@@ -637,6 +638,128 @@ static void VertsToTransData(TransInfo *t,
   }
 }
 
+/* Meshes with at least this many transformed vertices are converted over threads. */
+#define TRANS_EDIT_VERTS_PARALLEL_MIN 10000
+
+struct TransEditVertsData {
+  TransInfo *t;
+  TransDataContainer *tc;
+  BMEditMesh *em;
+  TransData *tob;
+  TransDataExtension *tx;
+  /* TransData index of each vertex, -1 for vertices which are not transformed. */
+  const int *td_index;
+  float mtx[3][3], smtx[3][3];
+  float (*quats)[4];
+  float (*defmats)[3][3];
+  const float *dists;
+  const int *dists_index;
+  struct TransIslandData *island_info;
+  const int *island_vert_map;
+  int cd_vert_bweight_offset;
+  int prop_mode;
+  bool is_snap_rotate;
+};
+
+static void createTransEditVerts_cb(void *__restrict userdata,
+                                    const int a,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct TransEditVertsData *data = userdata;
+  if (data->td_index[a] == -1) {
+    return;
+  }
+
+  TransInfo *t = data->t;
+  TransDataContainer *tc = data->tc;
+  BMEditMesh *em = data->em;
+  BMVert *eve = BM_vert_at_index(em->bm, a);
+  TransData *tob = &data->tob[data->td_index[a]];
+  TransDataExtension *tx = data->tx ? &data->tx[data->td_index[a]] : NULL;
+  float(*mtx)[3] = data->mtx, (*smtx)[3] = data->smtx;
+  float(*quats)[4] = data->quats;
+  float(*defmats)[3][3] = data->defmats;
+  const float *dists = data->dists;
+  const int *dists_index = data->dists_index;
+  struct TransIslandData *island_info = data->island_info;
+  const int *island_vert_map = data->island_vert_map;
+  const int prop_mode = data->prop_mode;
+  const bool is_snap_rotate = data->is_snap_rotate;
+
+  struct TransIslandData *v_island = NULL;
+  float *bweight = (data->cd_vert_bweight_offset != -1) ?
+                       BM_ELEM_CD_GET_VOID_P(eve, data->cd_vert_bweight_offset) :
+                       NULL;
+
+  if (island_info) {
+    const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
+    v_island = (island_vert_map[connected_index] != -1) ?
+                   &island_info[island_vert_map[connected_index]] :
+                   NULL;
+  }
+
+  /* Do not use the island center in case we are using islands
+   * only to get axis for snap/rotate to normal... */
+  VertsToTransData(t, tob, tx, em, eve, bweight, v_island, is_snap_rotate);
+
+  /* selected */
+  if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+    tob->flag |= TD_SELECTED;
+  }
+
+  if (prop_mode) {
+    if (prop_mode & T_PROP_CONNECTED) {
+      tob->dist = dists[a];
+    }
+    else {
+      tob->flag |= TD_NOTCONNECTED;
+      tob->dist = FLT_MAX;
+    }
+  }
+
+  /* CrazySpace */
+  const bool use_quats = quats && BM_elem_flag_test(eve, BM_ELEM_TAG);
+  if (use_quats || defmats) {
+    float mat[3][3], qmat[3][3], imat[3][3];
+
+    /* Use both or either quat and defmat correction. */
+    if (use_quats) {
+      quat_to_mat3(qmat, quats[BM_elem_index_get(eve)]);
+
+      if (defmats) {
+        mul_m3_series(mat, defmats[a], qmat, mtx);
+      }
+      else {
+        mul_m3_m3m3(mat, mtx, qmat);
+      }
+    }
+    else {
+      mul_m3_m3m3(mat, mtx, defmats[a]);
+    }
+
+    invert_m3_m3(imat, mat);
+
+    copy_m3_m3(tob->smtx, imat);
+    copy_m3_m3(tob->mtx, mat);
+  }
+  else {
+    copy_m3_m3(tob->smtx, smtx);
+    copy_m3_m3(tob->mtx, mtx);
+  }
+
+  if (tc->mirror.use_mirror_any) {
+    if (tc->mirror.axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_X;
+    }
+    if (tc->mirror.axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Y;
+    }
+    if (tc->mirror.axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Z;
+    }
+  }
+}
+
 void createTransEditVerts(TransInfo *t)
 {
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
@@ -672,6 +795,7 @@ void createTransEditVerts(TransInfo *t)
     /* Original index of our connected vertex when connected distances are calculated.
      * Optional, allocate if needed. */
     int *dists_index = NULL;
+    int *td_index = NULL;
 
     BLI_bitmap *mirror_bitmap = NULL;
 
@@ -801,93 +925,47 @@ void createTransEditVerts(TransInfo *t)
       }
     }
 
+    /* Index of the TransData of each vertex, so they can be filled in parallel. */
+    td_index = MEM_mallocN(bm->totvert * sizeof(*td_index), __func__);
+    int td_len = 0;
     BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, a) {
-      if (BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
-        continue;
-      }
-      if (mirror_bitmap && BLI_BITMAP_TEST(mirror_bitmap, a)) {
-        continue;
+      if (BM_elem_flag_test(eve, BM_ELEM_HIDDEN) ||
+          (mirror_bitmap && BLI_BITMAP_TEST(mirror_bitmap, a)) ||
+          !(prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT))) {
+        td_index[a] = -1;
       }
-      if (prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-        struct TransIslandData *v_island = NULL;
-        float *bweight = (cd_vert_bweight_offset != -1) ?
-                             BM_ELEM_CD_GET_VOID_P(eve, cd_vert_bweight_offset) :
-                             NULL;
-
-        if (island_info) {
-          const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
-          v_island = (island_vert_map[connected_index] != -1) ?
-                         &island_info[island_vert_map[connected_index]] :
-                         NULL;
-        }
-
-        /* Do not use the island center in case we are using islands
-         * only to get axis for snap/rotate to normal... */
-        VertsToTransData(t, tob, tx, em, eve, bweight, v_island, is_snap_rotate);
-        if (tx) {
-          tx++;
-        }
-
-        /* selected */
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          tob->flag |= TD_SELECTED;
-        }
-
-        if (prop_mode) {
-          if (prop_mode & T_PROP_CONNECTED) {
-            tob->dist = dists[a];
-          }
-          else {
-            tob->flag |= TD_NOTCONNECTED;
-            tob->dist = FLT_MAX;
-          }
-        }
-
-        /* CrazySpace */
-        const bool use_quats = quats && BM_elem_flag_test(eve, BM_ELEM_TAG);
-        if (use_quats || defmats) {
-          float mat[3][3], qmat[3][3], imat[3][3];
-
-          /* Use both or either quat and defmat correction. */
-          if (use_quats) {
-            quat_to_mat3(qmat, quats[BM_elem_index_get(eve)]);
-
-            if (defmats) {
-              mul_m3_series(mat, defmats[a], qmat, mtx);
-            }
-            else {
-              mul_m3_m3m3(mat, mtx, qmat);
-            }
-          }
-          else {
-            mul_m3_m3m3(mat, mtx, defmats[a]);
-          }
-
-          invert_m3_m3(imat, mat);
-
-          copy_m3_m3(tob->smtx, imat);
-          copy_m3_m3(tob->mtx, mat);
-        }
-        else {
-          copy_m3_m3(tob->smtx, smtx);
-          copy_m3_m3(tob->mtx, mtx);
-        }
-
-        if (tc->mirror.use_mirror_any) {
-          if (tc->mirror.axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_X;
-          }
-          if (tc->mirror.axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Y;
-          }
-          if (tc->mirror.axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Z;
-          }
-        }
-
-        tob++;
+      else {
+        td_index[a] = td_len++;
       }
     }
+    BLI_assert(td_len == data_len);
+
+    BM_mesh_elem_table_ensure(bm, BM_VERT);
+
+    struct TransEditVertsData data = {
+        .t = t,
+        .tc = tc,
+        .em = em,
+        .tob = tob,
+        .tx = tx,
+        .td_index = td_index,
+        .quats = quats,
+        .defmats = defmats,
+        .dists = dists,
+        .dists_index = dists_index,
+        .island_info = island_info,
+        .island_vert_map = island_vert_map,
+        .cd_vert_bweight_offset = cd_vert_bweight_offset,
+        .prop_mode = prop_mode,
+        .is_snap_rotate = is_snap_rotate,
+    };
+    copy_m3_m3(data.mtx, mtx);
+    copy_m3_m3(data.smtx, smtx);
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (data_len >= TRANS_EDIT_VERTS_PARALLEL_MIN);
+    BLI_task_parallel_range(0, bm->totvert, &data, createTransEditVerts_cb, &settings);
 
     if (island_info) {
       MEM_freeN(island_info);
@@ -911,6 +989,9 @@ void createTransEditVerts(TransInfo *t)
     if (mirror_bitmap) {
       MEM_freeN(mirror_bitmap);
     }
+    if (td_index) {
+      MEM_freeN(td_index);
+    }
   }
 }
 
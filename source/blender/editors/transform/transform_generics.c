@@ -917,6 +917,8 @@ static void recalcData_objects(TransInfo *t)
       FOREACH_TRANS_DATA_CONTAINER (t, tc) {
         DEG_id_tag_update(tc->obedit->data, 0); /* sets recalc flags */
         BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
+        /* Only coordinates change, the draw cache can keep topology buffers. */
+        em->is_deform_only_update = true;
         EDBM_mesh_normals_update(em);
         BKE_editmesh_looptri_calc(em);
       }
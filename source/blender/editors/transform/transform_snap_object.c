@@ -698,28 +698,37 @@ static bool raycastEditMesh(SnapObjectContext *sctx,
 
   BVHCache **em_bvh_cache = &((Mesh *)ob->data)->runtime.bvh_cache;
 
-  if (sctx->callbacks.edit_mesh.test_face_fn == NULL) {
-    /* The tree is owned by the Mesh and may have been freed since we last used! */
-    if (treedata->tree && !bvhcache_has_tree(*em_bvh_cache, treedata->tree)) {
-      free_bvhtree_from_editmesh(treedata);
-    }
+  /* The tree is owned by the Mesh and may have been freed since we last used! */
+  if (treedata->tree && treedata->cached && !bvhcache_has_tree(*em_bvh_cache, treedata->tree)) {
+    free_bvhtree_from_editmesh(treedata);
   }
 
   if (treedata->tree == NULL) {
     /* Get original version of the edit_mesh. */
     BMEditMesh *em_orig = BKE_editmesh_from_object(DEG_get_original_object(ob));
+    BLI_bitmap *elem_mask = NULL;
+    int looptri_num_active = -1;
 
     if (sctx->callbacks.edit_mesh.test_face_fn) {
       BMesh *bm = em_orig->bm;
       BLI_assert(poly_to_tri_count(bm->totface, bm->totloop) == em_orig->tottri);
 
-      BLI_bitmap *elem_mask = BLI_BITMAP_NEW(em_orig->tottri, __func__);
-      int looptri_num_active = BM_iter_mesh_bitmap_from_filter_tessface(
+      elem_mask = BLI_BITMAP_NEW(em_orig->tottri, __func__);
+      looptri_num_active = BM_iter_mesh_bitmap_from_filter_tessface(
           bm,
           elem_mask,
           sctx->callbacks.edit_mesh.test_face_fn,
           sctx->callbacks.edit_mesh.user_data);
 
+      if (looptri_num_active == em_orig->tottri) {
+        /* Nothing is filtered out (objects without selection in multi-object edit mode),
+         * the tree cached on the mesh can be used, it is kept between snapping sessions. */
+        MEM_freeN(elem_mask);
+        elem_mask = NULL;
+      }
+    }
+
+    if (elem_mask) {
       bvhtree_from_editmesh_looptri_ex(
           treedata, em_orig, elem_mask, looptri_num_active, 0.0f, 4, 6, 0, NULL);
 
@@ -2416,11 +2425,10 @@ static short snapEditMesh(SnapObjectContext *sctx,
     }
     treedata_vert = sod->bvh_trees[0];
 
-    if (sctx->callbacks.edit_mesh.test_vert_fn == NULL) {
-      /* The tree is owned by the Mesh and may have been freed since we last used! */
-      if (treedata_vert->tree && !bvhcache_has_tree(*em_bvh_cache, treedata_vert->tree)) {
-        free_bvhtree_from_editmesh(treedata_vert);
-      }
+    /* The tree is owned by the Mesh and may have been freed since we last used! */
+    if (treedata_vert->tree && treedata_vert->cached &&
+        !bvhcache_has_tree(*em_bvh_cache, treedata_vert->tree)) {
+      free_bvhtree_from_editmesh(treedata_vert);
     }
 
     if (treedata_vert->tree == NULL) {
@@ -2435,6 +2443,14 @@ static short snapEditMesh(SnapObjectContext *sctx,
             (bool (*)(BMElem *, void *))sctx->callbacks.edit_mesh.test_vert_fn,
             sctx->callbacks.edit_mesh.user_data);
 
+        if (verts_num_active == em->bm->totvert) {
+          /* Nothing is filtered out, use the tree cached on the mesh. */
+          MEM_freeN(verts_mask);
+          verts_mask = NULL;
+        }
+      }
+
+      if (verts_mask) {
         bvhtree_from_editmesh_verts_ex(
             treedata_vert, em, verts_mask, verts_num_active, 0.0f, 2, 6, 0, NULL);
         MEM_freeN(verts_mask);
@@ -2451,11 +2467,10 @@ static short snapEditMesh(SnapObjectContext *sctx,
     }
     treedata_edge = sod->bvh_trees[1];
 
-    if (sctx->callbacks.edit_mesh.test_edge_fn == NULL) {
-      /* The tree is owned by the Mesh and may have been freed since we last used! */
-      if (treedata_edge->tree && !bvhcache_has_tree(*em_bvh_cache, treedata_edge->tree)) {
-        free_bvhtree_from_editmesh(treedata_edge);
-      }
+    /* The tree is owned by the Mesh and may have been freed since we last used! */
+    if (treedata_edge->tree && treedata_edge->cached &&
+        !bvhcache_has_tree(*em_bvh_cache, treedata_edge->tree)) {
+      free_bvhtree_from_editmesh(treedata_edge);
     }
 
     if (treedata_edge->tree == NULL) {
@@ -2470,6 +2485,14 @@ static short snapEditMesh(SnapObjectContext *sctx,
             (bool (*)(BMElem *, void *))sctx->callbacks.edit_mesh.test_edge_fn,
             sctx->callbacks.edit_mesh.user_data);
 
+        if (edges_num_active == em->bm->totedge) {
+          /* Nothing is filtered out, use the tree cached on the mesh. */
+          MEM_freeN(edges_mask);
+          edges_mask = NULL;
+        }
+      }
+
+      if (edges_mask) {
         bvhtree_from_editmesh_edges_ex(
             treedata_edge, em, edges_mask, edges_num_active, 0.0f, 2, 6, 0, NULL);
         MEM_freeN(edges_mask);
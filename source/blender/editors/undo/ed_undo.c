@@ -97,6 +97,9 @@ void ED_undo_push(bContext *C, const char *str)
 
   if (U.undomemory != 0) {
     const size_t memory_limit = (size_t)U.undomemory * 1024 * 1024;
+    if (U.uiflag & USER_GLOBALUNDO_DISK) {
+      BKE_undosys_stack_spill_steps(wm->undo_stack, memory_limit);
+    }
     BKE_undosys_stack_limit_steps_and_memory(wm->undo_stack, 0, memory_limit);
   }
 
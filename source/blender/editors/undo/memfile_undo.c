@@ -22,9 +22,12 @@
 
 #include "BLI_utildefines.h"
 #include "BLI_sys_types.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
 
 #include "DNA_object_enums.h"
 
+#include "BKE_appdir.h"
 #include "BKE_blender_undo.h"
 #include "BKE_context.h"
 #include "BKE_undo_system.h"
@@ -91,10 +94,25 @@ static bool memfile_undosys_step_encode(struct bContext *UNUSED(C),
 static void memfile_undosys_step_decode(
     struct bContext *C, struct Main *bmain, UndoStep *us_p, int UNUSED(dir), bool UNUSED(is_final))
 {
+  /* The current state matches the last memfile step read or written, unless edit-mode data
+   * still needs to be flushed or other undo systems changed the data since,
+   * which can only be undone by reading that step again. */
+  UndoStack *ustack = ED_undo_stack_get();
+  MemFileUndoStep *us_current = (MemFileUndoStep *)ustack->step_active_memfile;
+  if (bmain->is_memfile_undo_flush_needed ||
+      (us_p == ustack->step_active_memfile && us_p != ustack->step_active)) {
+    us_current = NULL;
+  }
+
   ED_editors_exit(bmain, false);
 
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
-  BKE_memfile_undo_decode(us->data, C);
+  /* This step becomes the reference for writing the next one, its buffers are needed. */
+  if (us->data->memfile.spill_data != NULL) {
+    us_p->data_size += us->data->memfile.spill_size;
+    BLO_memfile_unspill(&us->data->memfile);
+  }
+  BKE_memfile_undo_decode(us->data, us_current ? us_current->data : NULL, C);
 
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
     if (BKE_UNDOSYS_TYPE_IS_MEMFILE_SKIP(us_iter->type)) {
@@ -132,6 +150,25 @@ static void memfile_undosys_step_free(UndoStep *us_p)
   BKE_memfile_undo_free(us->data);
 }
 
+static void memfile_undosys_step_spill(UndoStep *us_p)
+{
+  MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  /* The last step is the reference for writing the next one. */
+  UndoStep *us_next_p = BKE_undosys_step_same_type_next(us_p);
+  if (us_next_p == NULL) {
+    return;
+  }
+  MemFileUndoStep *us_next = (MemFileUndoStep *)us_next_p;
+
+  char filename[64], filepath[FILE_MAX];
+  BLI_snprintf(filename, sizeof(filename), "undo_%p.spill", (void *)us);
+  BLI_join_dirfile(filepath, sizeof(filepath), BKE_tempdir_session(), filename);
+
+  const size_t spill_size = BLO_memfile_spill(
+      &us->data->memfile, &us_next->data->memfile, filepath);
+  us_p->data_size -= MIN2(spill_size, us_p->data_size);
+}
+
 /* Export for ED_undo_sys. */
 void ED_memfile_undosys_type(UndoType *ut)
 {
@@ -140,6 +177,7 @@ void ED_memfile_undosys_type(UndoType *ut)
   ut->step_encode = memfile_undosys_step_encode;
   ut->step_decode = memfile_undosys_step_decode;
   ut->step_free = memfile_undosys_step_free;
+  ut->step_spill = memfile_undosys_step_spill;
 
   ut->use_context = true;
 
@@ -29,6 +29,7 @@
 #include "BLI_convexhull_2d.h"
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
+#include "BLI_task.h"
 
 #include "uvedit_parametrizer.h"
 
@@ -4546,47 +4547,77 @@ void param_construct_end(ParamHandle *handle, ParamBool fill, ParamBool impl)
   phandle->state = PHANDLE_STATE_CONSTRUCTED;
 }
 
-void param_lscm_begin(ParamHandle *handle, ParamBool live, ParamBool abf)
+/* Charts don't share any data once constructed, each one has its own solver,
+ * so they are solved in parallel. Their sizes differ a lot, hence the dynamic scheduling. */
+static void p_charts_parallel_range(PHandle *phandle, TaskParallelRangeFunc func, void *userdata)
 {
-  PHandle *phandle = (PHandle *)handle;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (phandle->ncharts > 1);
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, phandle->ncharts, userdata, func, &settings);
+}
+
+typedef struct PChartsLSCMData {
+  PHandle *phandle;
+  PBool live, abf;
+} PChartsLSCMData;
+
+static void p_charts_lscm_begin_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PChartsLSCMData *data = userdata;
+  PChart *chart = data->phandle->charts[i];
   PFace *f;
-  int i;
 
-  param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
-  phandle->state = PHANDLE_STATE_LSCM;
+  for (f = chart->faces; f; f = f->nextlink) {
+    p_face_backup_uvs(f);
+  }
+  p_chart_lscm_begin(chart, data->live, data->abf);
+}
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    for (f = phandle->charts[i]->faces; f; f = f->nextlink) {
-      p_face_backup_uvs(f);
+static void p_charts_lscm_solve_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PChartsLSCMData *data = userdata;
+  PChart *chart = data->phandle->charts[i];
+  PBool result;
+
+  if (chart->u.lscm.context) {
+    result = p_chart_lscm_solve(data->phandle, chart);
+
+    if (result && !(chart->flag & PCHART_HAS_PINS)) {
+      p_chart_rotate_minimum_area(chart);
+    }
+
+    if (!result || (chart->u.lscm.pin1)) {
+      p_chart_lscm_end(chart);
     }
-    p_chart_lscm_begin(phandle->charts[i], (PBool)live, (PBool)abf);
   }
 }
 
-void param_lscm_solve(ParamHandle *handle)
+void param_lscm_begin(ParamHandle *handle, ParamBool live, ParamBool abf)
 {
   PHandle *phandle = (PHandle *)handle;
-  PChart *chart;
-  int i;
-  PBool result;
 
-  param_assert(phandle->state == PHANDLE_STATE_LSCM);
+  param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
+  phandle->state = PHANDLE_STATE_LSCM;
 
-  for (i = 0; i < phandle->ncharts; i++) {
-    chart = phandle->charts[i];
+  PChartsLSCMData data = {phandle, (PBool)live, (PBool)abf};
+  p_charts_parallel_range(phandle, p_charts_lscm_begin_cb, &data);
+}
 
-    if (chart->u.lscm.context) {
-      result = p_chart_lscm_solve(phandle, chart);
+void param_lscm_solve(ParamHandle *handle)
+{
+  PHandle *phandle = (PHandle *)handle;
 
-      if (result && !(chart->flag & PCHART_HAS_PINS)) {
-        p_chart_rotate_minimum_area(chart);
-      }
+  param_assert(phandle->state == PHANDLE_STATE_LSCM);
 
-      if (!result || (chart->u.lscm.pin1)) {
-        p_chart_lscm_end(chart);
-      }
-    }
-  }
+  PChartsLSCMData data = {phandle, P_FALSE, P_FALSE};
+  p_charts_parallel_range(phandle, p_charts_lscm_solve_cb, &data);
 }
 
 void param_lscm_end(ParamHandle *handle)
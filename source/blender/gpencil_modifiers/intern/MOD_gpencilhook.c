@@ -202,7 +202,7 @@ static void deformStroke(GpencilModifierData *md,
   const int def_nr = defgroup_name_index(ob, mmd->vgname);
 
   bPoseChannel *pchan = BKE_pose_channel_find_name(mmd->object->pose, mmd->subtarget);
-  float dmat[4][4];
+  float dmat[4][4], imat[4][4];
   struct GPHookData_cb tData;
 
   if (!is_stroke_affected_by_modifier(ob,
@@ -247,8 +247,9 @@ static void deformStroke(GpencilModifierData *md,
     /* just object target */
     copy_m4_m4(dmat, mmd->object->obmat);
   }
-  invert_m4_m4(ob->imat, ob->obmat);
-  mul_m4_series(tData.mat, ob->imat, dmat, mmd->parentinv);
+  /* Strokes can be deformed in parallel, don't write to the object. */
+  invert_m4_m4(imat, ob->obmat);
+  mul_m4_series(tData.mat, imat, dmat, mmd->parentinv);
 
   /* loop points and apply deform */
   for (int i = 0; i < gps->totpoints; i++) {
@@ -110,11 +110,13 @@ void gpu_pbvh_init()
   if (g_vbo_id.format.attr_len == 0) {
     g_vbo_id.pos = GPU_vertformat_attr_add(
         &g_vbo_id.format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+    /* Compact format, sculpt nodes are uploaded again after each stroke step:
+     * packed normals and 16 bit masks keep the stride at 28 bytes instead of 36. */
     g_vbo_id.nor = GPU_vertformat_attr_add(
-        &g_vbo_id.format, "nor", GPU_COMP_I16, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+        &g_vbo_id.format, "nor", GPU_COMP_I10, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
     /* TODO: Do not allocate these `.msk` and `.col` when they are not used. */
     g_vbo_id.msk = GPU_vertformat_attr_add(
-        &g_vbo_id.format, "msk", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
+        &g_vbo_id.format, "msk", GPU_COMP_U16, 1, GPU_FETCH_INT_TO_FLOAT_UNIT);
     g_vbo_id.col = GPU_vertformat_attr_add(
         &g_vbo_id.format, "ac", GPU_COMP_U16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
   }
@@ -225,11 +227,11 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
           const int vidx = vert_indices[i];
           const MVert *v = &mvert[vidx];
           copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), v->co);
-          copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), v->no);
+          *(GPUPackedNormal *)GPU_vertbuf_raw_step(&nor_step) = GPU_normal_convert_i10_s3(v->no);
 
           if (show_mask) {
             float mask = vmask[vidx];
-            *(float *)GPU_vertbuf_raw_step(&msk_step) = mask;
+            *(ushort *)GPU_vertbuf_raw_step(&msk_step) = unit_float_to_ushort_clamp(mask);
             empty_mask = empty_mask && (mask == 0.0f);
           }
         }
@@ -254,7 +256,7 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
       else {
         /* calculate normal for each polygon only once */
         uint mpoly_prev = UINT_MAX;
-        short no[3] = {0, 0, 0};
+        GPUPackedNormal no = {0, 0, 0};
 
         for (uint i = 0; i < buffers->face_indices_len; i++) {
           const MLoopTri *lt = &buffers->looptri[buffers->face_indices[i]];
@@ -273,22 +275,24 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
             const MPoly *mp = &buffers->mpoly[lt->poly];
             float fno[3];
             BKE_mesh_calc_poly_normal(mp, &buffers->mloop[mp->loopstart], mvert, fno);
-            normal_float_to_short_v3(no, fno);
+            no = GPU_normal_convert_i10_v3(fno);
             mpoly_prev = lt->poly;
           }
 
           float fmask = 0.0f;
+          ushort umask = 0;
           if (show_mask) {
             fmask = (vmask[vtri[0]] + vmask[vtri[1]] + vmask[vtri[2]]) / 3.0f;
+            umask = unit_float_to_ushort_clamp(fmask);
           }
 
           for (uint j = 0; j < 3; j++) {
             const MVert *v = &mvert[vtri[j]];
 
             copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), v->co);
-            copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), no);
+            *(GPUPackedNormal *)GPU_vertbuf_raw_step(&nor_step) = no;
             if (show_mask) {
-              *(float *)GPU_vertbuf_raw_step(&msk_step) = fmask;
+              *(ushort *)GPU_vertbuf_raw_step(&msk_step) = umask;
               empty_mask = empty_mask && (fmask == 0.0f);
             }
 
@@ -653,13 +657,13 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
             GPU_vertbuf_attr_set(
                 buffers->vert_buf, g_vbo_id.pos, vbo_index, CCG_elem_co(key, elem));
 
-            short no_short[3];
-            normal_float_to_short_v3(no_short, CCG_elem_no(key, elem));
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index, no_short);
+            GPUPackedNormal no = GPU_normal_convert_i10_v3(CCG_elem_no(key, elem));
+            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index, &no);
 
             if (has_mask && show_mask) {
               float fmask = *CCG_elem_mask(key, elem);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index, &fmask);
+              ushort umask = unit_float_to_ushort_clamp(fmask);
+              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index, &umask);
               empty_mask = empty_mask && (fmask == 0.0f);
             }
 
@@ -690,28 +694,28 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
             };
 
             float fno[3];
-            short no_short[3];
             /* Note: Clockwise indices ordering, that's why we invert order here. */
             normal_quad_v3(fno, co[3], co[2], co[1], co[0]);
-            normal_float_to_short_v3(no_short, fno);
+            GPUPackedNormal no = GPU_normal_convert_i10_v3(fno);
 
             GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.pos, vbo_index + 0, co[0]);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 0, no_short);
+            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 0, &no);
             GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.pos, vbo_index + 1, co[1]);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 1, no_short);
+            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 1, &no);
             GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.pos, vbo_index + 2, co[2]);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 2, no_short);
+            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 2, &no);
             GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.pos, vbo_index + 3, co[3]);
-            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 3, no_short);
+            GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.nor, vbo_index + 3, &no);
 
             if (has_mask && show_mask) {
               float fmask = (*CCG_elem_mask(key, elems[0]) + *CCG_elem_mask(key, elems[1]) +
                              *CCG_elem_mask(key, elems[2]) + *CCG_elem_mask(key, elems[3])) *
                             0.25f;
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 0, &fmask);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 1, &fmask);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 2, &fmask);
-              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 3, &fmask);
+              ushort umask = unit_float_to_ushort_clamp(fmask);
+              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 0, &umask);
+              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 1, &umask);
+              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 2, &umask);
+              GPU_vertbuf_attr_set(buffers->vert_buf, g_vbo_id.msk, vbo_index + 3, &umask);
               empty_mask = empty_mask && (fmask == 0.0f);
             }
 
@@ -780,13 +784,13 @@ static void gpu_bmesh_vert_to_buffer_copy(BMVert *v,
   /* Set coord, normal, and mask */
   GPU_vertbuf_attr_set(vert_buf, g_vbo_id.pos, v_index, v->co);
 
-  short no_short[3];
-  normal_float_to_short_v3(no_short, fno ? fno : v->no);
-  GPU_vertbuf_attr_set(vert_buf, g_vbo_id.nor, v_index, no_short);
+  GPUPackedNormal no = GPU_normal_convert_i10_v3(fno ? fno : v->no);
+  GPU_vertbuf_attr_set(vert_buf, g_vbo_id.nor, v_index, &no);
 
   if (show_mask) {
     float effective_mask = fmask ? *fmask : BM_ELEM_CD_GET_FLOAT(v, cd_vert_mask_offset);
-    GPU_vertbuf_attr_set(vert_buf, g_vbo_id.msk, v_index, &effective_mask);
+    ushort umask = unit_float_to_ushort_clamp(effective_mask);
+    GPU_vertbuf_attr_set(vert_buf, g_vbo_id.msk, v_index, &umask);
     *empty_mask = *empty_mask && (effective_mask == 0.0f);
   }
 
@@ -31,6 +31,7 @@
 #include "DNA_node_types.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_hash.h"
 #include "BLI_hash_mm2a.h"
 #include "BLI_link_utils.h"
 #include "BLI_utildefines.h"
@@ -40,9 +41,13 @@
 
 #include "PIL_time.h"
 
+#include "BKE_appdir.h"
+#include "BKE_global.h"
+
 #include "GPU_extensions.h"
 #include "GPU_glew.h"
 #include "GPU_material.h"
+#include "GPU_platform.h"
 #include "GPU_shader.h"
 #include "GPU_uniformbuffer.h"
 #include "GPU_vertex_format.h"
@@ -130,6 +135,199 @@ static GPUPass *gpu_pass_cache_resolve_collision(GPUPass *pass,
   return NULL;
 }
 
+/* -------------------- GPUPass Disk Cache ------------------ */
+/**
+ * Program binaries of compiled passes are stored in the user data-files, so next sessions
+ * can skip compiling the same GLSL code again. Files are named after the hash of the full
+ * shader source, the whole cache is cleared when the GPU or driver version changes since
+ * binaries are only valid for the driver that created them.
+ */
+
+#define PASS_DISK_CACHE_SUBDIR "shader_cache"
+#define PASS_DISK_CACHE_DRIVER_FILE "driver.txt"
+#define PASS_DISK_CACHE_VERSION 1
+
+typedef struct GPUPassDiskCacheHeader {
+  char magic[4];
+  int version;
+  uint32_t driver_hash;
+  /* Sanity check against hash collisions. */
+  uint32_t source_len;
+  uint binary_format;
+  int binary_len;
+} GPUPassDiskCacheHeader;
+
+static struct {
+  bool use;
+  uint32_t driver_hash;
+  char dirpath[FILE_MAX];
+} pass_disk_cache = {false};
+
+static void gpu_pass_disk_cache_init(void)
+{
+  pass_disk_cache.use = false;
+
+  /* Debugging shaders needs them to be compiled from source. */
+  if (!GLEW_ARB_get_program_binary || (G.debug & G_DEBUG_GPU_SHADERS)) {
+    return;
+  }
+  int binary_formats_len = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats_len);
+  if (binary_formats_len == 0) {
+    return;
+  }
+
+  const char *dirpath = BKE_appdir_folder_id_create(BLENDER_USER_DATAFILES,
+                                                    PASS_DISK_CACHE_SUBDIR);
+  if (dirpath == NULL) {
+    return;
+  }
+  BLI_strncpy(pass_disk_cache.dirpath, dirpath, sizeof(pass_disk_cache.dirpath));
+
+  /* Invalidate binaries of another GPU or driver version. */
+  const char *gpu_name = GPU_platform_gpu_name();
+  char driver_filepath[FILE_MAX];
+  BLI_join_dirfile(driver_filepath,
+                   sizeof(driver_filepath),
+                   pass_disk_cache.dirpath,
+                   PASS_DISK_CACHE_DRIVER_FILE);
+
+  size_t driver_name_len = 0;
+  char *driver_name = BLI_file_read_text_as_mem(driver_filepath, 1, &driver_name_len);
+  if (driver_name) {
+    driver_name[driver_name_len] = '\0';
+  }
+  if (driver_name == NULL || !STREQ(driver_name, gpu_name)) {
+    BLI_delete(pass_disk_cache.dirpath, true, true);
+    BLI_dir_create_recursive(pass_disk_cache.dirpath);
+
+    FILE *fp = BLI_fopen(driver_filepath, "wb");
+    if (fp == NULL) {
+      MEM_SAFE_FREE(driver_name);
+      return;
+    }
+    fputs(gpu_name, fp);
+    fclose(fp);
+  }
+  MEM_SAFE_FREE(driver_name);
+
+  pass_disk_cache.driver_hash = BLI_hash_string(gpu_name);
+  pass_disk_cache.use = true;
+}
+
+static uint32_t gpu_pass_source_len(const GPUPass *pass)
+{
+  uint32_t len = strlen(pass->vertexcode) + strlen(pass->fragmentcode);
+  if (pass->geometrycode) {
+    len += strlen(pass->geometrycode);
+  }
+  if (pass->defines) {
+    len += strlen(pass->defines);
+  }
+  return len;
+}
+
+static uint32_t gpu_pass_source_hash(const GPUPass *pass, const uint32_t seed)
+{
+  const char *sources[4] = {
+      pass->vertexcode, pass->geometrycode, pass->fragmentcode, pass->defines};
+
+  BLI_HashMurmur2A hm2a;
+  BLI_hash_mm2a_init(&hm2a, seed);
+  for (int i = 0; i < ARRAY_SIZE(sources); i++) {
+    /* Include the terminator, so moving code across stages changes the hash. */
+    const char *source = sources[i] ? sources[i] : "";
+    BLI_hash_mm2a_add(&hm2a, (const uchar *)source, strlen(source) + 1);
+  }
+  return BLI_hash_mm2a_end(&hm2a);
+}
+
+/* Return false when the disk cache is not used. */
+static bool gpu_pass_disk_cache_filepath(const GPUPass *pass, char r_filepath[FILE_MAX])
+{
+  if (!pass_disk_cache.use) {
+    return false;
+  }
+  /* The pass hash only covers the generated fragment code, use the whole source instead. */
+  char filename[32];
+  BLI_snprintf(filename,
+               sizeof(filename),
+               "%08x%08x.bin",
+               gpu_pass_source_hash(pass, 0),
+               gpu_pass_source_hash(pass, pass_disk_cache.driver_hash));
+  BLI_join_dirfile(r_filepath, FILE_MAX, pass_disk_cache.dirpath, filename);
+  return true;
+}
+
+/* Read the binary into #GPUPass.binary, return true on success. */
+static bool gpu_pass_disk_cache_read(GPUPass *pass, const char *filepath)
+{
+  FILE *fp = BLI_fopen(filepath, "rb");
+  if (fp == NULL) {
+    return false;
+  }
+
+  GPUPassDiskCacheHeader header;
+  bool is_valid = (fread(&header, sizeof(header), 1, fp) == 1) &&
+                  (memcmp(header.magic, "GPUB", 4) == 0) &&
+                  (header.version == PASS_DISK_CACHE_VERSION) &&
+                  (header.driver_hash == pass_disk_cache.driver_hash) &&
+                  (header.source_len == gpu_pass_source_len(pass)) && (header.binary_len > 0);
+
+  if (is_valid) {
+    char *content = MEM_mallocN(header.binary_len, __func__);
+    if (fread(content, header.binary_len, 1, fp) == 1) {
+      pass->binary.content = content;
+      pass->binary.format = header.binary_format;
+      pass->binary.len = header.binary_len;
+    }
+    else {
+      MEM_freeN(content);
+      is_valid = false;
+    }
+  }
+  fclose(fp);
+
+  if (!is_valid) {
+    BLI_delete(filepath, false, false);
+  }
+  return is_valid;
+}
+
+static void gpu_pass_disk_cache_write(const GPUPass *pass,
+                                      const char *filepath,
+                                      const char *binary,
+                                      const uint binary_format,
+                                      const int binary_len)
+{
+  if (binary_len <= 0) {
+    return;
+  }
+
+  GPUPassDiskCacheHeader header = {
+      .magic = {'G', 'P', 'U', 'B'},
+      .version = PASS_DISK_CACHE_VERSION,
+      .driver_hash = pass_disk_cache.driver_hash,
+      .source_len = gpu_pass_source_len(pass),
+      .binary_format = binary_format,
+      .binary_len = binary_len,
+  };
+
+  /* Write to a temporary file first, so readers never see partially written binaries. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.tmp", filepath);
+
+  FILE *fp = BLI_fopen(filepath_tmp, "wb");
+  if (fp == NULL) {
+    return;
+  }
+  const bool ok = (fwrite(&header, sizeof(header), 1, fp) == 1) &&
+                  (fwrite(binary, binary_len, 1, fp) == 1);
+  if ((fclose(fp) != 0) || !ok || (BLI_rename(filepath_tmp, filepath) != 0)) {
+    BLI_delete(filepath_tmp, false, false);
+  }
+}
+
 /* -------------------- GPU Codegen ------------------ */
 
 /* type definitions and constants */
@@ -380,6 +578,7 @@ static GPUFunction *gpu_lookup_function(const char *name)
 void gpu_codegen_init(void)
 {
   GPU_code_generate_glsl_lib();
+  gpu_pass_disk_cache_init();
 }
 
 void gpu_codegen_exit(void)
@@ -2177,37 +2376,113 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
   return (total_samplers_len <= GPU_max_textures());
 }
 
+/* Compile the shader from source, storing its binary in the disk cache when valid. */
+static GPUShader *gpu_pass_shader_compile(GPUPass *pass,
+                                          const char *shname,
+                                          const char *cache_filepath,
+                                          bool *r_success)
+{
+  GPUShader *shader = GPU_shader_create(
+      pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
+
+  /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
+   * We need to make sure to count active samplers to avoid undefined behavior. */
+  if (!gpu_pass_shader_validate(pass, shader)) {
+    *r_success = false;
+    if (shader != NULL) {
+      fprintf(stderr, "GPUShader: error: too many samplers in shader.\n");
+      GPU_shader_free(shader);
+    }
+    return NULL;
+  }
+
+  if (!BLI_thread_is_main() && GPU_context_local_shaders_workaround()) {
+    pass->binary.content = GPU_shader_get_binary(
+        shader, &pass->binary.format, &pass->binary.len);
+    GPU_shader_free(shader);
+    shader = NULL;
+    if (cache_filepath) {
+      gpu_pass_disk_cache_write(
+          pass, cache_filepath, pass->binary.content, pass->binary.format, pass->binary.len);
+    }
+  }
+  else if (cache_filepath) {
+    uint binary_format;
+    int binary_len;
+    char *binary = GPU_shader_get_binary(shader, &binary_format, &binary_len);
+    gpu_pass_disk_cache_write(pass, cache_filepath, binary, binary_format, binary_len);
+    MEM_freeN(binary);
+  }
+
+  return shader;
+}
+
+/* Passes are shared by materials which may be compiled from several threads at once,
+ * only one of them compiles the pass. Return false when the pass doesn't need compiling. */
+static bool gpu_pass_compile_begin(GPUPass *pass, bool *r_is_compiled)
+{
+  BLI_spin_lock(&pass_cache_spin);
+  const bool begin = !pass->compiled && !pass->compiling;
+  if (begin) {
+    pass->compiling = true;
+  }
+  *r_is_compiled = pass->compiled;
+  BLI_spin_unlock(&pass_cache_spin);
+  return begin;
+}
+
+static void gpu_pass_compile_end(GPUPass *pass, GPUShader *shader)
+{
+  BLI_spin_lock(&pass_cache_spin);
+  pass->shader = shader;
+  pass->compiled = true;
+  pass->compiling = false;
+  BLI_spin_unlock(&pass_cache_spin);
+}
+
 bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
   bool success = true;
-  if (!pass->compiled) {
-    GPUShader *shader = GPU_shader_create(
-        pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
-
-    /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
-     * We need to make sure to count active samplers to avoid undefined behavior. */
-    if (!gpu_pass_shader_validate(pass, shader)) {
-      success = false;
-      if (shader != NULL) {
-        fprintf(stderr, "GPUShader: error: too many samplers in shader.\n");
-        GPU_shader_free(shader);
-        shader = NULL;
-      }
-    }
-    else if (!BLI_thread_is_main() && GPU_context_local_shaders_workaround()) {
-      pass->binary.content = GPU_shader_get_binary(
-          shader, &pass->binary.format, &pass->binary.len);
-      GPU_shader_free(shader);
-      shader = NULL;
+  bool is_compiled;
+  char cache_filepath_buf[FILE_MAX];
+
+  if (gpu_pass_compile_begin(pass, &is_compiled)) {
+    const char *cache_filepath = gpu_pass_disk_cache_filepath(pass, cache_filepath_buf) ?
+                                     cache_filepath_buf :
+                                     NULL;
+    GPUShader *shader = NULL;
+
+    /* Binaries are only written for validated shaders, no need to validate them again. */
+    if (cache_filepath && gpu_pass_disk_cache_read(pass, cache_filepath)) {
+      if (!BLI_thread_is_main() && GPU_context_local_shaders_workaround()) {
+        /* Loaded from the main thread, like binaries of compiled shaders. */
+        gpu_pass_compile_end(pass, NULL);
+        return success;
+      }
+      shader = GPU_shader_load_from_binary(
+          pass->binary.content, pass->binary.format, pass->binary.len, shname);
+      MEM_SAFE_FREE(pass->binary.content);
+      if (shader == NULL) {
+        /* Rejected by the driver, replace it with a freshly compiled binary. */
+        BLI_delete(cache_filepath, false, false);
+      }
     }
 
-    pass->shader = shader;
-    pass->compiled = true;
+    if (shader == NULL) {
+      shader = gpu_pass_shader_compile(pass, shname, cache_filepath, &success);
+    }
+
+    gpu_pass_compile_end(pass, shader);
   }
-  else if (pass->binary.content && BLI_thread_is_main()) {
+  else if (is_compiled && pass->binary.content && BLI_thread_is_main()) {
     pass->shader = GPU_shader_load_from_binary(
         pass->binary.content, pass->binary.format, pass->binary.len, shname);
     MEM_SAFE_FREE(pass->binary.content);
+    if (pass->shader == NULL && gpu_pass_disk_cache_filepath(pass, cache_filepath_buf)) {
+      /* Binary from the disk cache was rejected by the driver. */
+      BLI_delete(cache_filepath_buf, false, false);
+      pass->shader = gpu_pass_shader_compile(pass, shname, NULL, &success);
+    }
   }
 
   return success;
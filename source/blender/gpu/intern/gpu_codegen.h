@@ -171,6 +171,7 @@ struct GPUPass {
     int len;
   } binary;
   bool compiled; /* Did we already tried to compile the attached GPUShader. */
+  bool compiling; /* Being compiled by another thread, see #GPU_pass_compile. */
 };
 
 typedef struct GPUPass GPUPass;
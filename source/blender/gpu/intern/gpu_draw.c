@@ -34,6 +34,7 @@
 #include "BLI_boxpack_2d.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -258,6 +259,126 @@ static int compare_packtile(const void *a, const void *b)
   return tile_a->pack_score < tile_b->pack_score;
 }
 
+typedef struct TileUpload {
+  ImBuf *ibuf;
+  /* Pixels to upload: points into ibuf or one of the buffers below. */
+  void *pixels;
+  void *pixels_converted;
+  ImBuf *scale_ibuf;
+  bool is_float;
+} TileUpload;
+
+typedef struct TileArrayPrepareData {
+  Image *ima;
+  ImageTile **tiles;
+  /* Index of the tile of uploads[0]. */
+  int tile_first;
+  TileUpload *uploads;
+  bool use_srgb;
+} TileArrayPrepareData;
+
+/* Convert the tile to the texture storage and scale it to its size in the array. */
+static void gpu_texture_tile_array_prepare_cb(void *__restrict userdata,
+                                              const int i,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TileArrayPrepareData *data = userdata;
+  Image *ima = data->ima;
+  ImageTile *tile = data->tiles[data->tile_first + i];
+  TileUpload *upload = &data->uploads[i];
+  const int *tilesize = tile->runtime.tilearray_size;
+
+  if (tilesize[0] == 0 || tilesize[1] == 0) {
+    return;
+  }
+
+  ImageUser iuser;
+  BKE_imageuser_default(&iuser);
+  iuser.tile = tile->tile_number;
+  ImBuf *ibuf = upload->ibuf = BKE_image_acquire_ibuf(ima, &iuser, NULL);
+
+  if (ibuf == NULL) {
+    return;
+  }
+
+  const bool needs_scale = (ibuf->x != tilesize[0] || ibuf->y != tilesize[1]);
+
+  if (ibuf->rect_float) {
+    float *rect_float = ibuf->rect_float;
+
+    const bool store_premultiplied = ima->alpha_mode != IMA_ALPHA_STRAIGHT;
+    if (ibuf->channels != 4 || !store_premultiplied) {
+      rect_float = upload->pixels_converted = MEM_mallocN(
+          sizeof(float) * 4 * ibuf->x * ibuf->y, __func__);
+      IMB_colormanagement_imbuf_to_float_texture(
+          rect_float, 0, 0, ibuf->x, ibuf->y, ibuf, store_premultiplied);
+    }
+
+    upload->pixels = rect_float;
+    if (needs_scale) {
+      upload->scale_ibuf = IMB_allocFromBuffer(NULL, rect_float, ibuf->x, ibuf->y, 4);
+      IMB_scaleImBuf(upload->scale_ibuf, tilesize[0], tilesize[1]);
+      upload->pixels = upload->scale_ibuf->rect_float;
+    }
+    upload->is_float = true;
+  }
+  else {
+    unsigned int *rect = ibuf->rect;
+
+    if (!IMB_colormanagement_space_is_data(ibuf->rect_colorspace)) {
+      rect = upload->pixels_converted = MEM_mallocN(sizeof(uchar) * 4 * ibuf->x * ibuf->y,
+                                                    __func__);
+      IMB_colormanagement_imbuf_to_byte_texture((uchar *)rect,
+                                                0,
+                                                0,
+                                                ibuf->x,
+                                                ibuf->y,
+                                                ibuf,
+                                                data->use_srgb,
+                                                ima->alpha_mode == IMA_ALPHA_PREMUL);
+    }
+
+    upload->pixels = rect;
+    if (needs_scale) {
+      upload->scale_ibuf = IMB_allocFromBuffer(rect, NULL, ibuf->x, ibuf->y, 4);
+      IMB_scaleImBuf(upload->scale_ibuf, tilesize[0], tilesize[1]);
+      upload->pixels = upload->scale_ibuf->rect;
+    }
+    upload->is_float = false;
+  }
+}
+
+/* Return how many times the tiles resolution needs to be halved to fit half of the free video
+ * memory. Zero when the free memory can't be queried. */
+static int gpu_texture_tile_array_scale_shift_get(ListBase *boxes, const bool is_float)
+{
+  if (!GPU_mem_stats_supported()) {
+    return 0;
+  }
+
+  int totalmem_kb, freemem_kb;
+  GPU_mem_stats_get(&totalmem_kb, &freemem_kb);
+  if (freemem_kb <= 0) {
+    return 0;
+  }
+
+  /* RGBA16F or RGBA8 texels, plus a third for the mipmaps. */
+  const uint64_t texel_size = is_float ? 8 : 4;
+  uint64_t array_size = 0;
+  LISTBASE_FOREACH (PackTile *, packtile, boxes) {
+    array_size += (uint64_t)packtile->boxpack.w * (uint64_t)packtile->boxpack.h * texel_size;
+  }
+  array_size += array_size / 3;
+
+  const uint64_t budget = (uint64_t)freemem_kb * 1024 / 2;
+  int shift = 0;
+  /* Halving the resolution divides the size by four, scale tiles down 64 times at most. */
+  while ((array_size >> (2 * shift)) > budget && shift < 6) {
+    shift++;
+  }
+  return shift;
+}
+
 static uint gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
 {
   int arraywidth = 0, arrayheight = 0;
@@ -296,6 +417,20 @@ static uint gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
 
   BLI_assert(arraywidth > 0 && arrayheight > 0);
 
+  /* Large UDIM sets can easily exceed the video memory, drop the highest resolution levels
+   * of all tiles until the array fits in the budget. */
+  const int scale_shift = gpu_texture_tile_array_scale_shift_get(&boxes,
+                                                                 main_ibuf->rect_float != NULL);
+  if (scale_shift > 0) {
+    arraywidth = arrayheight = 0;
+    LISTBASE_FOREACH (PackTile *, packtile, &boxes) {
+      packtile->boxpack.w = max_ii(packtile->boxpack.w >> scale_shift, 1);
+      packtile->boxpack.h = max_ii(packtile->boxpack.h >> scale_shift, 1);
+      arraywidth = max_ii(arraywidth, packtile->boxpack.w);
+      arrayheight = max_ii(arrayheight, packtile->boxpack.h);
+    }
+  }
+
   BLI_listbase_sort(&boxes, compare_packtile);
   int arraylayers = 0;
   /* Keep adding layers until all tiles are packed. */
@@ -350,102 +485,65 @@ static uint gpu_texture_create_tile_array(Image *ima, ImBuf *main_ibuf)
                data_type,
                NULL);
 
-  LISTBASE_FOREACH (ImageTile *, tile, &ima->tiles) {
-    int tilelayer = tile->runtime.tilearray_layer;
-    int *tileoffset = tile->runtime.tilearray_offset;
-    int *tilesize = tile->runtime.tilearray_size;
-
-    if (tilesize[0] == 0 || tilesize[1] == 0) {
-      continue;
+  /* Tiles are converted and scaled by worker threads, a few at a time to bound the memory
+   * used by the converted pixels, while uploading stays on the thread owning the context. */
+  const int tiles_len = BLI_listbase_count(&ima->tiles);
+  const int batch_len = min_ii(tiles_len, BLI_system_thread_count());
+  TileArrayPrepareData data = {
+      .ima = ima,
+      .tiles = MEM_mallocN(sizeof(*data.tiles) * tiles_len, __func__),
+      .uploads = MEM_callocN(sizeof(*data.uploads) * batch_len, __func__),
+      .use_srgb = (internal_format == GL_SRGB8_ALPHA8),
+  };
+  {
+    int i = 0;
+    LISTBASE_FOREACH (ImageTile *, tile, &ima->tiles) {
+      data.tiles[i++] = tile;
     }
+  }
 
-    ImageUser iuser;
-    BKE_imageuser_default(&iuser);
-    iuser.tile = tile->tile_number;
-    ImBuf *ibuf = BKE_image_acquire_ibuf(ima, &iuser, NULL);
-
-    if (ibuf) {
-      bool needs_scale = (ibuf->x != tilesize[0] || ibuf->y != tilesize[1]);
-
-      ImBuf *scale_ibuf = NULL;
-      if (ibuf->rect_float) {
-        float *rect_float = ibuf->rect_float;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
 
-        const bool store_premultiplied = ima->alpha_mode != IMA_ALPHA_STRAIGHT;
-        if (ibuf->channels != 4 || !store_premultiplied) {
-          rect_float = MEM_mallocN(sizeof(float) * 4 * ibuf->x * ibuf->y, __func__);
-          IMB_colormanagement_imbuf_to_float_texture(
-              rect_float, 0, 0, ibuf->x, ibuf->y, ibuf, store_premultiplied);
-        }
+  for (data.tile_first = 0; data.tile_first < tiles_len; data.tile_first += batch_len) {
+    const int len = min_ii(batch_len, tiles_len - data.tile_first);
+    BLI_task_parallel_range(0, len, &data, gpu_texture_tile_array_prepare_cb, &settings);
 
-        float *pixeldata = rect_float;
-        if (needs_scale) {
-          scale_ibuf = IMB_allocFromBuffer(NULL, rect_float, ibuf->x, ibuf->y, 4);
-          IMB_scaleImBuf(scale_ibuf, tilesize[0], tilesize[1]);
-          pixeldata = scale_ibuf->rect_float;
-        }
+    for (int i = 0; i < len; i++) {
+      TileUpload *upload = &data.uploads[i];
+      ImageTile *tile = data.tiles[data.tile_first + i];
 
+      if (upload->pixels) {
+        const int *tileoffset = tile->runtime.tilearray_offset;
+        const int *tilesize = tile->runtime.tilearray_size;
         glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
                         0,
                         tileoffset[0],
                         tileoffset[1],
-                        tilelayer,
+                        tile->runtime.tilearray_layer,
                         tilesize[0],
                         tilesize[1],
                         1,
                         GL_RGBA,
-                        GL_FLOAT,
-                        pixeldata);
-
-        if (rect_float != ibuf->rect_float) {
-          MEM_freeN(rect_float);
-        }
+                        upload->is_float ? GL_FLOAT : GL_UNSIGNED_BYTE,
+                        upload->pixels);
       }
-      else {
-        unsigned int *rect = ibuf->rect;
-
-        if (!IMB_colormanagement_space_is_data(ibuf->rect_colorspace)) {
-          rect = MEM_mallocN(sizeof(uchar) * 4 * ibuf->x * ibuf->y, __func__);
-          IMB_colormanagement_imbuf_to_byte_texture((uchar *)rect,
-                                                    0,
-                                                    0,
-                                                    ibuf->x,
-                                                    ibuf->y,
-                                                    ibuf,
-                                                    internal_format == GL_SRGB8_ALPHA8,
-                                                    ima->alpha_mode == IMA_ALPHA_PREMUL);
-        }
 
-        unsigned int *pixeldata = rect;
-        if (needs_scale) {
-          scale_ibuf = IMB_allocFromBuffer(rect, NULL, ibuf->x, ibuf->y, 4);
-          IMB_scaleImBuf(scale_ibuf, tilesize[0], tilesize[1]);
-          pixeldata = scale_ibuf->rect;
-        }
-        glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
-                        0,
-                        tileoffset[0],
-                        tileoffset[1],
-                        tilelayer,
-                        tilesize[0],
-                        tilesize[1],
-                        1,
-                        GL_RGBA,
-                        GL_UNSIGNED_BYTE,
-                        pixeldata);
-
-        if (rect != ibuf->rect) {
-          MEM_freeN(rect);
-        }
+      MEM_SAFE_FREE(upload->pixels_converted);
+      if (upload->scale_ibuf != NULL) {
+        IMB_freeImBuf(upload->scale_ibuf);
       }
-      if (scale_ibuf != NULL) {
-        IMB_freeImBuf(scale_ibuf);
+      if (upload->ibuf != NULL) {
+        BKE_image_release_ibuf(ima, upload->ibuf, NULL);
       }
+      memset(upload, 0, sizeof(*upload));
     }
-
-    BKE_image_release_ibuf(ima, ibuf, NULL);
   }
 
+  MEM_freeN(data.tiles);
+  MEM_freeN(data.uploads);
+
   glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, gpu_get_mipmap_filter(1));
 
   if (GPU_get_mipmap()) {
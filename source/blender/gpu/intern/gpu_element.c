@@ -86,7 +86,9 @@ void GPU_indexbuf_init_ex(GPUIndexBufBuilder *builder,
   builder->max_index_len = index_len;
   builder->index_len = 0;  // start empty
   builder->prim_type = prim_type;
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_DRAW_CACHE);
   builder->data = MEM_callocN(builder->max_index_len * sizeof(uint), "GPUIndexBuf data");
+  MEM_category_end(category_prev);
 }
 
 void GPU_indexbuf_init(GPUIndexBufBuilder *builder,
@@ -41,6 +41,9 @@
 extern void GPU_matrix_bind(const GPUShaderInterface *);
 extern bool GPU_matrix_dirty_get(void);
 
+/* Number of parts of the persistent ring buffer, each one fenced separately. */
+#define IMM_RING_SECTIONS 4
+
 typedef struct {
   /* TODO: organize this struct by frequency of change (run-time) */
 
@@ -66,6 +69,11 @@ typedef struct {
   GLuint vbo_id;
   GLuint vao_id;
 
+  /* Persistently mapped storage of vbo_id, see #imm_ring_create. */
+  GLubyte *ring_data;
+  uint ring_section;
+  GLsync ring_fences[IMM_RING_SECTIONS];
+
   GLuint bound_program;
   const GPUShaderInterface *shader_interface;
   GPUAttrBinding attr_binding;
@@ -77,8 +85,78 @@ typedef struct {
 static uint imm_buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
 
 static bool initialized = false;
+static bool use_persistent_ring = false;
 static Immediate imm;
 
+/* Instead of orphaning and mapping the buffer for every draw call, map it once with persistent
+ * and coherent access and write vertices one after the other, wrapping around at the end.
+ * The GPU is fenced whenever writing leaves a section, so a section is only overwritten once
+ * the draw calls reading it are done. */
+static void imm_ring_create(void)
+{
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  imm.vbo_id = GPU_buf_alloc();
+  glBindBuffer(GL_ARRAY_BUFFER, imm.vbo_id);
+  glBufferStorage(GL_ARRAY_BUFFER, imm_buffer_size, NULL, flags);
+  imm.ring_data = glMapBufferRange(GL_ARRAY_BUFFER, 0, imm_buffer_size, flags);
+  imm.ring_section = 0;
+  imm.buffer_offset = 0;
+
+#if TRUST_NO_ONE
+  assert(imm.ring_data != NULL);
+#endif
+}
+
+static void imm_ring_free(void)
+{
+  for (int i = 0; i < IMM_RING_SECTIONS; i++) {
+    if (imm.ring_fences[i]) {
+      glDeleteSync(imm.ring_fences[i]);
+      imm.ring_fences[i] = NULL;
+    }
+  }
+  /* Storage is immutable, resizing means starting over with another buffer. */
+  glBindBuffer(GL_ARRAY_BUFFER, imm.vbo_id);
+  glUnmapBuffer(GL_ARRAY_BUFFER);
+  GPU_buf_free(imm.vbo_id);
+  imm.ring_data = NULL;
+}
+
+static void imm_ring_section_enter(uint section)
+{
+  /* Fence the draw calls reading the section being left. */
+  imm.ring_fences[imm.ring_section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  imm.ring_section = section;
+
+  GLsync fence = imm.ring_fences[section];
+  if (fence) {
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {
+      /* Wait for the previous lap to be consumed. */
+    }
+    glDeleteSync(fence);
+    imm.ring_fences[section] = NULL;
+  }
+}
+
+/* Make the sections of [offset, offset + bytes) safe to write, wrapped is true when starting
+ * again from the beginning of the buffer. */
+static void imm_ring_acquire(uint offset, uint bytes, bool wrapped)
+{
+  const uint section_size = imm_buffer_size / IMM_RING_SECTIONS;
+  const uint offset_last = (bytes > 0) ? offset + bytes - 1 : offset;
+  const uint section_last = MIN2(offset_last / section_size, IMM_RING_SECTIONS - 1);
+
+  if (wrapped) {
+    do {
+      imm_ring_section_enter((imm.ring_section + 1) % IMM_RING_SECTIONS);
+    } while (imm.ring_section != 0);
+  }
+  while (imm.ring_section != section_last) {
+    imm_ring_section_enter(imm.ring_section + 1);
+  }
+}
+
 void immInit(void)
 {
 #if TRUST_NO_ONE
@@ -86,9 +164,16 @@ void immInit(void)
 #endif
   memset(&imm, 0, sizeof(Immediate));
 
-  imm.vbo_id = GPU_buf_alloc();
-  glBindBuffer(GL_ARRAY_BUFFER, imm.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, imm_buffer_size, NULL, GL_DYNAMIC_DRAW);
+  use_persistent_ring = GLEW_ARB_buffer_storage;
+
+  if (use_persistent_ring) {
+    imm_ring_create();
+  }
+  else {
+    imm.vbo_id = GPU_buf_alloc();
+    glBindBuffer(GL_ARRAY_BUFFER, imm.vbo_id);
+    glBufferData(GL_ARRAY_BUFFER, imm_buffer_size, NULL, GL_DYNAMIC_DRAW);
+  }
 
   imm.prim_type = GPU_PRIM_NONE;
   imm.strict_vertex_len = true;
@@ -122,7 +207,12 @@ void immDeactivate(void)
 
 void immDestroy(void)
 {
-  GPU_buf_free(imm.vbo_id);
+  if (use_persistent_ring) {
+    imm_ring_free();
+  }
+  else {
+    GPU_buf_free(imm.vbo_id);
+  }
   initialized = false;
 }
 
@@ -234,7 +324,22 @@ void immBegin(GPUPrimType prim_type, uint vertex_len)
   /* Might waste a little space, but it's safe. */
   const uint pre_padding = padding(imm.buffer_offset, imm.vertex_format.stride);
 
-  if (!recreate_buffer && ((bytes_needed + pre_padding) <= available_bytes)) {
+  if (use_persistent_ring) {
+    bool wrapped = false;
+    if (recreate_buffer) {
+      imm_ring_free();
+      imm_ring_create();
+    }
+    else if ((bytes_needed + pre_padding) <= available_bytes) {
+      imm.buffer_offset += pre_padding;
+    }
+    else {
+      imm.buffer_offset = 0;
+      wrapped = true;
+    }
+    imm_ring_acquire(imm.buffer_offset, bytes_needed, wrapped);
+  }
+  else if (!recreate_buffer && ((bytes_needed + pre_padding) <= available_bytes)) {
     imm.buffer_offset += pre_padding;
   }
   else {
@@ -247,11 +352,17 @@ void immBegin(GPUPrimType prim_type, uint vertex_len)
 
   /*  printf("mapping %u to %u\n", imm.buffer_offset, imm.buffer_offset + bytes_needed - 1); */
 
-  imm.buffer_data = glMapBufferRange(GL_ARRAY_BUFFER,
-                                     imm.buffer_offset,
-                                     bytes_needed,
-                                     GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
-                                         (imm.strict_vertex_len ? 0 : GL_MAP_FLUSH_EXPLICIT_BIT));
+  if (use_persistent_ring) {
+    imm.buffer_data = imm.ring_data + imm.buffer_offset;
+  }
+  else {
+    imm.buffer_data = glMapBufferRange(
+        GL_ARRAY_BUFFER,
+        imm.buffer_offset,
+        bytes_needed,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+            (imm.strict_vertex_len ? 0 : GL_MAP_FLUSH_EXPLICIT_BIT));
+  }
 
 #if TRUST_NO_ONE
   assert(imm.buffer_data != NULL);
@@ -381,7 +492,9 @@ void immEnd(void)
       /* unused buffer bytes are available to the next immBegin */
     }
     /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
-    glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    if (!use_persistent_ring) {
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    }
   }
 
   if (imm.batch) {
@@ -394,7 +507,9 @@ void immEnd(void)
     imm.batch = NULL; /* don't free, batch belongs to caller */
   }
   else {
-    glUnmapBuffer(GL_ARRAY_BUFFER);
+    if (!use_persistent_ring) {
+      glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
 
     if (imm.vertex_len > 0) {
       immDrawSetup();
@@ -50,6 +50,9 @@
 /* Z-depth of cleared depth buffer */
 #define DEPTH_MAX 0xffffffff
 
+/* Number of depth reads in flight before waiting for the oldest one. */
+#define READ_BUFFERS_LEN 8
+
 /* ----------------------------------------------------------------------------
  * SubRectStride
  */
@@ -249,6 +252,13 @@ typedef struct GPUPickState {
     /* Set after first draw */
     bool is_init;
     uint prev_id;
+
+    /* Pixel pack buffers the depth is read into after drawing each id, so reading doesn't stall
+     * drawing the next ones. Used as a queue, see #gpu_select_pick_read_begin. */
+    GLuint read_buffers[READ_BUFFERS_LEN];
+    uint read_ids[READ_BUFFERS_LEN];
+    uint read_first;
+    uint read_len;
   } gl;
 
   /* src: data stored in 'cache' and 'gl',
@@ -358,6 +368,16 @@ void gpu_select_pick_begin(uint (*buffer)[4], uint bufsize, const rcti *input, c
     }
 #endif
 
+    glGenBuffers(READ_BUFFERS_LEN, ps->gl.read_buffers);
+    for (uint i = 0; i < READ_BUFFERS_LEN; i++) {
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, ps->gl.read_buffers[i]);
+      glBufferData(
+          GL_PIXEL_PACK_BUFFER, (GLsizeiptr)(sizeof(depth_t) * rect_len), NULL, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    ps->gl.read_first = 0;
+    ps->gl.read_len = 0;
+
     ps->gl.is_init = false;
     ps->gl.prev_id = 0;
   }
@@ -475,6 +495,83 @@ static void gpu_select_load_id_pass_nearest(const DepthBufCache *rect_prev,
   }
 }
 
+/* Compare the depth of the id pass read in 'rect_depth_test' with the previous ones. */
+static void gpu_select_pick_depth_eval(uint id)
+{
+  GPUPickState *ps = &g_pick_state;
+  const uint rect_len = ps->src.rect_len;
+
+  /* perform initial check since most cases the array remains unchanged  */
+  bool do_pass = false;
+  if (g_pick_state.mode == GPU_SELECT_PICK_ALL) {
+    if (depth_buf_rect_depth_any(ps->gl.rect_depth_test, rect_len)) {
+      ps->gl.rect_depth_test->id = id;
+      gpu_select_load_id_pass_all(ps->gl.rect_depth_test);
+      do_pass = true;
+    }
+  }
+  else {
+    if (depth_buf_rect_depth_any_filled(ps->gl.rect_depth, ps->gl.rect_depth_test, rect_len)) {
+      ps->gl.rect_depth_test->id = id;
+      gpu_select_load_id_pass_nearest(ps->gl.rect_depth, ps->gl.rect_depth_test);
+      do_pass = true;
+    }
+  }
+
+  if (do_pass) {
+    /* Store depth in cache */
+    if (ps->use_cache) {
+      BLI_addtail(&ps->cache.bufs, ps->gl.rect_depth);
+      ps->gl.rect_depth = depth_buf_malloc(ps->src.rect_len);
+    }
+
+    SWAP(DepthBufCache *, ps->gl.rect_depth, ps->gl.rect_depth_test);
+  }
+}
+
+/* Wait for the oldest depth read and evaluate it. */
+static void gpu_select_pick_read_end(void)
+{
+  GPUPickState *ps = &g_pick_state;
+  BLI_assert(ps->gl.read_len > 0);
+  const uint slot = ps->gl.read_first;
+  const size_t size = sizeof(depth_t) * ps->src.rect_len;
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, ps->gl.read_buffers[slot]);
+  const void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT);
+  memcpy(ps->gl.rect_depth_test->buf, data, size);
+  glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  ps->gl.read_first = (slot + 1) % READ_BUFFERS_LEN;
+  ps->gl.read_len--;
+
+  gpu_select_pick_depth_eval(ps->gl.read_ids[slot]);
+}
+
+/* Read the depth drawn for this id, passes are evaluated in order once the data arrives. */
+static void gpu_select_pick_read_begin(uint id)
+{
+  GPUPickState *ps = &g_pick_state;
+
+  if (ps->gl.read_len == READ_BUFFERS_LEN) {
+    gpu_select_pick_read_end();
+  }
+  const uint slot = (ps->gl.read_first + ps->gl.read_len) % READ_BUFFERS_LEN;
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, ps->gl.read_buffers[slot]);
+  glReadPixels(UNPACK4(ps->gl.clip_readpixels), GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  ps->gl.read_ids[slot] = id;
+  ps->gl.read_len++;
+
+  if (g_pick_state.mode == GPU_SELECT_PICK_ALL) {
+    /* We want new depths every time, clearing a buffer nothing was drawn in changes nothing. */
+    glClear(GL_DEPTH_BUFFER_BIT);
+  }
+}
+
 bool gpu_select_pick_load_id(uint id, bool end)
 {
   GPUPickState *ps = &g_pick_state;
@@ -486,41 +583,11 @@ bool gpu_select_pick_load_id(uint id, bool end)
       return true;
     }
 
-    const uint rect_len = ps->src.rect_len;
-    glReadPixels(UNPACK4(ps->gl.clip_readpixels),
-                 GL_DEPTH_COMPONENT,
-                 GL_UNSIGNED_INT,
-                 ps->gl.rect_depth_test->buf);
-    /* perform initial check since most cases the array remains unchanged  */
-
-    bool do_pass = false;
-    if (g_pick_state.mode == GPU_SELECT_PICK_ALL) {
-      if (depth_buf_rect_depth_any(ps->gl.rect_depth_test, rect_len)) {
-        ps->gl.rect_depth_test->id = ps->gl.prev_id;
-        gpu_select_load_id_pass_all(ps->gl.rect_depth_test);
-        do_pass = true;
-      }
-    }
-    else {
-      if (depth_buf_rect_depth_any_filled(ps->gl.rect_depth, ps->gl.rect_depth_test, rect_len)) {
-        ps->gl.rect_depth_test->id = ps->gl.prev_id;
-        gpu_select_load_id_pass_nearest(ps->gl.rect_depth, ps->gl.rect_depth_test);
-        do_pass = true;
-      }
-    }
-
-    if (do_pass) {
-      /* Store depth in cache */
-      if (ps->use_cache) {
-        BLI_addtail(&ps->cache.bufs, ps->gl.rect_depth);
-        ps->gl.rect_depth = depth_buf_malloc(ps->src.rect_len);
-      }
-
-      SWAP(DepthBufCache *, ps->gl.rect_depth, ps->gl.rect_depth_test);
+    gpu_select_pick_read_begin(ps->gl.prev_id);
 
-      if (g_pick_state.mode == GPU_SELECT_PICK_ALL) {
-        /* we want new depths every time */
-        glClear(GL_DEPTH_BUFFER_BIT);
+    if (end) {
+      while (ps->gl.read_len > 0) {
+        gpu_select_pick_read_end();
       }
     }
   }
@@ -544,6 +611,7 @@ uint gpu_select_pick_end(void)
       /* force finishing last pass */
       gpu_select_pick_load_id(ps->gl.prev_id, true);
     }
+    glDeleteBuffers(READ_BUFFERS_LEN, ps->gl.read_buffers);
     gpuPopAttr();
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
   }
@@ -132,7 +132,9 @@ void GPU_vertbuf_data_alloc(GPUVertBuf *verts, uint v_len)
 #endif
   verts->dirty = true;
   verts->vertex_len = verts->vertex_alloc = v_len;
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_DRAW_CACHE);
   verts->data = MEM_mallocN(sizeof(GLubyte) * GPU_vertbuf_size_get(verts), "GPUVertBuf data");
+  MEM_category_end(category_prev);
 }
 
 /* resize buffer keeping existing data */
@@ -149,7 +151,9 @@ void GPU_vertbuf_data_resize(GPUVertBuf *verts, uint v_len)
 #endif
   verts->dirty = true;
   verts->vertex_len = verts->vertex_alloc = v_len;
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_DRAW_CACHE);
   verts->data = MEM_reallocN(verts->data, sizeof(GLubyte) * GPU_vertbuf_size_get(verts));
+  MEM_category_end(category_prev);
 }
 
 /* Set vertex count but does not change allocation.
@@ -380,7 +380,10 @@ void *imb_alloc_pixels(
   }
 
   size_t size = (size_t)x * (size_t)y * (size_t)channels * typesize;
-  return MEM_mapallocN(size, name);
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_IMAGE);
+  void *pixels = MEM_mapallocN(size, name);
+  MEM_category_end(category_prev);
+  return pixels;
 }
 
 bool imb_addrectfloatImBuf(ImBuf *ibuf)
@@ -446,6 +449,7 @@ struct ImBuf *IMB_allocFromBuffer(const unsigned int *rect,
   ibuf = IMB_allocImBuf(w, h, 32, 0);
 
   ibuf->channels = channels;
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_IMAGE);
   if (rectf) {
     ibuf->rect_float = MEM_dupallocN(rectf);
     ibuf->flags |= IB_rectfloat;
@@ -456,6 +460,7 @@ struct ImBuf *IMB_allocFromBuffer(const unsigned int *rect,
     ibuf->flags |= IB_rect;
     ibuf->mall |= IB_rect;
   }
+  MEM_category_end(category_prev);
 
   return ibuf;
 }
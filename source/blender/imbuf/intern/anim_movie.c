@@ -61,6 +61,7 @@
 #include "BLI_utildefines.h"
 #include "BLI_string.h"
 #include "BLI_path_util.h"
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -559,6 +560,12 @@ static int startffmpeg(struct anim *anim)
 
   pCodecCtx->workaround_bugs = 1;
 
+  /* Decoders supporting it decode several frames or slices of a frame at once. Frame threading
+   * delays the output by a frame per thread, which is drained after EOF like the other
+   * buffered frames. */
+  pCodecCtx->thread_count = BLI_system_thread_count();
+  pCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
     avformat_close_input(&pFormatCtx);
     return -1;
@@ -992,6 +999,30 @@ static void ffmpeg_decode_video_frame_scan(struct anim *anim, int64_t pts_to_sea
   }
 }
 
+/* Keyframe index of the container (MP4, MOV, MKV cues...), FFmpeg reads it when opening the
+ * file so it's available without building a timecode index. Timestamps are in the time base of
+ * the stream. */
+static bool ffmpeg_has_keyframe_index(AVStream *v_st)
+{
+  return v_st->nb_index_entries > 0;
+}
+
+/* True when decoding forward from the current position reaches pts_to_search without passing a
+ * keyframe, seeking would land on the same or an earlier keyframe. */
+static bool ffmpeg_can_scan_to(struct anim *anim, AVStream *v_st, int64_t pts_to_search)
+{
+  if (!ffmpeg_has_keyframe_index(v_st) || anim->next_pts < 0 ||
+      anim->next_pts >= pts_to_search) {
+    return false;
+  }
+
+  int index = av_index_search_timestamp(v_st, pts_to_search, AVSEEK_FLAG_BACKWARD);
+  if (index < 0) {
+    return false;
+  }
+  return v_st->index_entries[index].timestamp <= anim->next_pts;
+}
+
 static int match_format(const char *name, AVFormatContext *pFormatCtx)
 {
   const char *p;
@@ -1109,6 +1140,14 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
 
     ffmpeg_decode_video_frame_scan(anim, pts_to_search);
   }
+  else if (!tc_index && ffmpeg_can_scan_to(anim, v_st, pts_to_search)) {
+    av_log(anim->pFormatCtx,
+           AV_LOG_DEBUG,
+           "FETCH: within the current GOP "
+           "(container index tells us)\n");
+
+    ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+  }
   else if (position != anim->curposition + 1) {
     long long pos;
     int ret;
@@ -1133,6 +1172,16 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position, IMB_Timecode_Typ
         ret = av_seek_frame(anim->pFormatCtx, anim->videoStream, dts, AVSEEK_FLAG_BACKWARD);
       }
     }
+    else if (ffmpeg_has_keyframe_index(v_st)) {
+      /* Land on the keyframe before the frame, no need for the preseek margin. */
+      av_log(anim->pFormatCtx,
+             AV_LOG_DEBUG,
+             "CONTAINER INDEX seek pts = %lld\n",
+             (long long int)pts_to_search);
+
+      pos = pts_to_search;
+      ret = av_seek_frame(anim->pFormatCtx, anim->videoStream, pos, AVSEEK_FLAG_BACKWARD);
+    }
     else {
       pos = (long long)(position - anim->preseek) * AV_TIME_BASE / frame_rate;
 
@@ -46,6 +46,7 @@
 #include "BLI_math.h"
 #include "BLI_math_color.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_rect.h"
 
@@ -2176,6 +2177,85 @@ void IMB_colormanagement_colorspace_to_scene_linear(float *buffer,
   }
 }
 
+typedef struct ImbufToTextureData {
+  void *out_buffer;
+  int offset_x, offset_y;
+  int width, height;
+  const struct ImBuf *ibuf;
+  OCIO_ConstProcessorRcPtr *processor;
+  bool use_premultiply, use_unpremultiply;
+} ImbufToTextureData;
+
+/* Number of pixels converted to scene linear with a single call to OCIO. */
+#define TEXTURE_PROCESSOR_BATCH_LEN 256
+
+/* Rows are independent, only use threads when the image is large enough to be worth it. */
+static void imbuf_to_texture_parallel(ImbufToTextureData *data, TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)data->width * (size_t)data->height) > 256 * 256;
+  settings.min_iter_per_thread = 8;
+  BLI_task_parallel_range(0, data->height, data, func, &settings);
+}
+
+static void imbuf_to_byte_texture_row(void *__restrict userdata,
+                                      const int y,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ImbufToTextureData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
+  const size_t in_offset = (size_t)(data->offset_y + y) * ibuf->x + data->offset_x;
+  const size_t out_offset = (size_t)y * width;
+  const unsigned char *in = (unsigned char *)ibuf->rect + in_offset * 4;
+  unsigned char *out = (unsigned char *)data->out_buffer + out_offset * 4;
+
+  if (data->processor) {
+    /* Convert to scene linear, to sRGB and premultiply. Pixels are converted in batches to avoid
+     * the overhead of applying the processor to every pixel. */
+    float pixels[TEXTURE_PROCESSOR_BATCH_LEN][4];
+    for (int x_start = 0; x_start < width; x_start += TEXTURE_PROCESSOR_BATCH_LEN) {
+      const int batch_len = min_ii(TEXTURE_PROCESSOR_BATCH_LEN, width - x_start);
+      for (int i = 0; i < batch_len; i++, in += 4) {
+        rgba_uchar_to_float(pixels[i], in);
+      }
+
+      OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(&pixels[0][0],
+                                                                  batch_len,
+                                                                  1,
+                                                                  4,
+                                                                  sizeof(float),
+                                                                  4 * sizeof(float),
+                                                                  4 * sizeof(float) * batch_len);
+      OCIO_processorApply(data->processor, img);
+      OCIO_PackedImageDescRelease(img);
+
+      for (int i = 0; i < batch_len; i++, out += 4) {
+        float *pixel = pixels[i];
+        linearrgb_to_srgb_v3_v3(pixel, pixel);
+        if (data->use_premultiply) {
+          mul_v3_fl(pixel, pixel[3]);
+        }
+        rgba_float_to_uchar(out, pixel);
+      }
+    }
+  }
+  else if (data->use_premultiply) {
+    /* Premultiply only. */
+    for (int x = 0; x < width; x++, in += 4, out += 4) {
+      out[0] = (in[0] * in[3]) >> 8;
+      out[1] = (in[1] * in[3]) >> 8;
+      out[2] = (in[2] * in[3]) >> 8;
+      out[3] = in[3];
+    }
+  }
+  else {
+    /* Copy only. */
+    memcpy(out, in, sizeof(unsigned char) * 4 * width);
+  }
+}
+
 void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
                                                const int offset_x,
                                                const int offset_y,
@@ -2196,46 +2276,59 @@ void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
     processor = colorspace_to_scene_linear_processor(ibuf->rect_colorspace);
   }
 
-  /* TODO(brecht): make this multi-threaded, or at least process in batches. */
-  const unsigned char *in_buffer = (unsigned char *)ibuf->rect;
-  const bool use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied;
-
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
-    const unsigned char *in = in_buffer + in_offset * 4;
-    unsigned char *out = out_buffer + out_offset * 4;
+  ImbufToTextureData data = {
+      .out_buffer = out_buffer,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .height = height,
+      .ibuf = ibuf,
+      .processor = processor,
+      .use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied,
+  };
+  imbuf_to_texture_parallel(&data, imbuf_to_byte_texture_row);
+}
 
-    if (processor) {
-      /* Convert to scene linear, to sRGB and premultiply. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        float pixel[4];
-        rgba_uchar_to_float(pixel, in);
-        OCIO_processorApplyRGB(processor, pixel);
-        linearrgb_to_srgb_v3_v3(pixel, pixel);
-        if (use_premultiply) {
-          mul_v3_fl(pixel, pixel[3]);
-        }
-        rgba_float_to_uchar(out, pixel);
-      }
+static void imbuf_to_float_texture_row(void *__restrict userdata,
+                                       const int y,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ImbufToTextureData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
+  const int in_channels = ibuf->channels;
+  const size_t in_offset = (size_t)(data->offset_y + y) * ibuf->x + data->offset_x;
+  const size_t out_offset = (size_t)y * width;
+  const float *in = ibuf->rect_float + in_offset * in_channels;
+  float *out = (float *)data->out_buffer + out_offset * 4;
+
+  if (in_channels == 1) {
+    /* Copy single channel. */
+    for (int x = 0; x < width; x++, in += 1, out += 4) {
+      out[0] = in[0];
+      out[1] = in[0];
+      out[2] = in[0];
+      out[3] = in[0];
+    }
+  }
+  else if (in_channels == 3) {
+    /* Copy RGB. */
+    for (int x = 0; x < width; x++, in += 3, out += 4) {
+      out[0] = in[0];
+      out[1] = in[1];
+      out[2] = in[2];
+      out[3] = 1.0f;
     }
-    else if (use_premultiply) {
-      /* Premultiply only. */
+  }
+  else if (in_channels == 4) {
+    /* Copy or convert RGBA. */
+    if (data->use_unpremultiply) {
       for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = (in[0] * in[3]) >> 8;
-        out[1] = (in[1] * in[3]) >> 8;
-        out[2] = (in[2] * in[3]) >> 8;
-        out[3] = in[3];
+        premul_to_straight_v4_v4(out, in);
       }
     }
     else {
-      /* Copy only. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = in[0];
-        out[1] = in[1];
-        out[2] = in[2];
-        out[3] = in[3];
-      }
+      memcpy(out, in, sizeof(float) * 4 * width);
     }
   }
 }
@@ -2250,46 +2343,16 @@ void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
 {
   /* Float texture are stored in scene linear color space, with premultiplied
    * alpha depending on the image alpha mode. */
-  const float *in_buffer = ibuf->rect_float;
-  const int in_channels = ibuf->channels;
-  const bool use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied;
-
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
-    const float *in = in_buffer + in_offset * 4;
-    float *out = out_buffer + out_offset * 4;
-
-    if (in_channels == 1) {
-      /* Copy single channel. */
-      for (int x = 0; x < width; x++, in += 1, out += 4) {
-        out[0] = in[0];
-        out[1] = in[0];
-        out[2] = in[0];
-        out[3] = in[0];
-      }
-    }
-    else if (in_channels == 3) {
-      /* Copy RGB. */
-      for (int x = 0; x < width; x++, in += 3, out += 4) {
-        out[0] = in[0];
-        out[1] = in[1];
-        out[2] = in[2];
-        out[3] = 1.0f;
-      }
-    }
-    else if (in_channels == 4) {
-      /* Copy or convert RGBA. */
-      if (use_unpremultiply) {
-        for (int x = 0; x < width; x++, in += 4, out += 4) {
-          premul_to_straight_v4_v4(out, in);
-        }
-      }
-      else {
-        memcpy(out, in, sizeof(float) * 4 * width);
-      }
-    }
-  }
+  ImbufToTextureData data = {
+      .out_buffer = out_buffer,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .height = height,
+      .ibuf = ibuf,
+      .use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied,
+  };
+  imbuf_to_texture_parallel(&data, imbuf_to_float_texture_row);
 }
 
 /* Conversion between color picking role. Typically we would expect such a
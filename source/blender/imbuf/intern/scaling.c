@@ -25,6 +25,7 @@
 #include "BLI_utildefines.h"
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
+#include "BLI_task.h"
 #include "MEM_guardedalloc.h"
 
 #include "imbuf.h"
@@ -370,14 +371,84 @@ MINLINE void premul_ushort_to_straight_uchar(unsigned char *result, const unsign
   }
 }
 
+typedef struct OneHalfData {
+  const ImBuf *ibuf1;
+  ImBuf *ibuf2;
+  bool do_rect, do_float;
+} OneHalfData;
+
+static void imb_onehalf_row(void *__restrict userdata,
+                            const int y,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const OneHalfData *data = userdata;
+  const ImBuf *ibuf1 = data->ibuf1;
+  ImBuf *ibuf2 = data->ibuf2;
+  /* Two rows of the source image for one row of the result. */
+  const size_t ofs1 = (size_t)ibuf1->x * 8 * y;
+  const size_t ofs2 = (size_t)ibuf2->x * 4 * y;
+  int x;
+
+  if (data->do_rect) {
+    const unsigned char *cp1, *cp2;
+    unsigned char *dest;
+
+    cp1 = (unsigned char *)ibuf1->rect + ofs1;
+    cp2 = cp1 + (ibuf1->x << 2);
+    dest = (unsigned char *)ibuf2->rect + ofs2;
+
+    for (x = ibuf2->x; x > 0; x--) {
+      unsigned short p1i[8], p2i[8], desti[4];
+
+      straight_uchar_to_premul_ushort(p1i, cp1);
+      straight_uchar_to_premul_ushort(p2i, cp2);
+      straight_uchar_to_premul_ushort(p1i + 4, cp1 + 4);
+      straight_uchar_to_premul_ushort(p2i + 4, cp2 + 4);
+
+      desti[0] = ((unsigned int)p1i[0] + p2i[0] + p1i[4] + p2i[4]) >> 2;
+      desti[1] = ((unsigned int)p1i[1] + p2i[1] + p1i[5] + p2i[5]) >> 2;
+      desti[2] = ((unsigned int)p1i[2] + p2i[2] + p1i[6] + p2i[6]) >> 2;
+      desti[3] = ((unsigned int)p1i[3] + p2i[3] + p1i[7] + p2i[7]) >> 2;
+
+      premul_ushort_to_straight_uchar(dest, desti);
+
+      cp1 += 8;
+      cp2 += 8;
+      dest += 4;
+    }
+  }
+
+  if (data->do_float) {
+    const float *p1f, *p2f;
+    float *destf;
+
+    p1f = ibuf1->rect_float + ofs1;
+    p2f = p1f + (ibuf1->x << 2);
+    destf = ibuf2->rect_float + ofs2;
+
+    for (x = ibuf2->x; x > 0; x--) {
+      destf[0] = 0.25f * (p1f[0] + p2f[0] + p1f[4] + p2f[4]);
+      destf[1] = 0.25f * (p1f[1] + p2f[1] + p1f[5] + p2f[5]);
+      destf[2] = 0.25f * (p1f[2] + p2f[2] + p1f[6] + p2f[6]);
+      destf[3] = 0.25f * (p1f[3] + p2f[3] + p1f[7] + p2f[7]);
+      p1f += 8;
+      p2f += 8;
+      destf += 4;
+    }
+  }
+}
+
 /* result in ibuf2, scaling should be done correctly */
 void imb_onehalf_no_alloc(struct ImBuf *ibuf2, struct ImBuf *ibuf1)
 {
-  int x, y;
-  const short do_rect = (ibuf1->rect != NULL);
-  const short do_float = (ibuf1->rect_float != NULL) && (ibuf2->rect_float != NULL);
-
-  if (do_rect && (ibuf2->rect == NULL)) {
+  OneHalfData data = {
+      .ibuf1 = ibuf1,
+      .ibuf2 = ibuf2,
+      .do_rect = (ibuf1->rect != NULL),
+      .do_float = (ibuf1->rect_float != NULL) && (ibuf2->rect_float != NULL),
+  };
+
+  if (data.do_rect && (ibuf2->rect == NULL)) {
     imb_addrectImBuf(ibuf2);
   }
 
@@ -390,62 +461,12 @@ void imb_onehalf_no_alloc(struct ImBuf *ibuf2, struct ImBuf *ibuf1)
     return;
   }
 
-  if (do_rect) {
-    unsigned char *cp1, *cp2, *dest;
-
-    cp1 = (unsigned char *)ibuf1->rect;
-    dest = (unsigned char *)ibuf2->rect;
-
-    for (y = ibuf2->y; y > 0; y--) {
-      cp2 = cp1 + (ibuf1->x << 2);
-      for (x = ibuf2->x; x > 0; x--) {
-        unsigned short p1i[8], p2i[8], desti[4];
-
-        straight_uchar_to_premul_ushort(p1i, cp1);
-        straight_uchar_to_premul_ushort(p2i, cp2);
-        straight_uchar_to_premul_ushort(p1i + 4, cp1 + 4);
-        straight_uchar_to_premul_ushort(p2i + 4, cp2 + 4);
-
-        desti[0] = ((unsigned int)p1i[0] + p2i[0] + p1i[4] + p2i[4]) >> 2;
-        desti[1] = ((unsigned int)p1i[1] + p2i[1] + p1i[5] + p2i[5]) >> 2;
-        desti[2] = ((unsigned int)p1i[2] + p2i[2] + p1i[6] + p2i[6]) >> 2;
-        desti[3] = ((unsigned int)p1i[3] + p2i[3] + p1i[7] + p2i[7]) >> 2;
-
-        premul_ushort_to_straight_uchar(dest, desti);
-
-        cp1 += 8;
-        cp2 += 8;
-        dest += 4;
-      }
-      cp1 = cp2;
-      if (ibuf1->x & 1) {
-        cp1 += 4;
-      }
-    }
-  }
-
-  if (do_float) {
-    float *p1f, *p2f, *destf;
-
-    p1f = ibuf1->rect_float;
-    destf = ibuf2->rect_float;
-    for (y = ibuf2->y; y > 0; y--) {
-      p2f = p1f + (ibuf1->x << 2);
-      for (x = ibuf2->x; x > 0; x--) {
-        destf[0] = 0.25f * (p1f[0] + p2f[0] + p1f[4] + p2f[4]);
-        destf[1] = 0.25f * (p1f[1] + p2f[1] + p1f[5] + p2f[5]);
-        destf[2] = 0.25f * (p1f[2] + p2f[2] + p1f[6] + p2f[6]);
-        destf[3] = 0.25f * (p1f[3] + p2f[3] + p1f[7] + p2f[7]);
-        p1f += 8;
-        p2f += 8;
-        destf += 4;
-      }
-      p1f = p2f;
-      if (ibuf1->x & 1) {
-        p1f += 4;
-      }
-    }
-  }
+  /* Rows are independent, mip-map levels of large images are computed in parallel. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)ibuf2->x * (size_t)ibuf2->y) > 128 * 128;
+  settings.min_iter_per_thread = 8;
+  BLI_task_parallel_range(0, ibuf2->y, &data, imb_onehalf_row, &settings);
 }
 
 ImBuf *IMB_onehalf(struct ImBuf *ibuf1)
@@ -906,309 +927,441 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
+/* Scaling is done line by line (rows when scaling along X, columns when scaling along Y),
+ * every line is independent from the others so they are scaled in parallel. */
+typedef struct ScaleLinesData {
+  const ImBuf *ibuf;
+  /* Size of the scaled dimension. */
+  int newlen;
+  float add;
+  uchar *newrect;
+  float *newrectf;
+} ScaleLinesData;
+
+static void scale_lines_parallel(ScaleLinesData *data,
+                                 const int lines_len,
+                                 TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Threading overhead is not worth it for small images (icons, thumbnails). */
+  settings.use_threading = ((size_t)data->ibuf->x * (size_t)data->ibuf->y) > 128 * 128;
+  settings.min_iter_per_thread = 8;
+  BLI_task_parallel_range(0, lines_len, data, func, &settings);
+}
+
+static void scaledownx_line(void *__restrict userdata,
+                            const int y,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleLinesData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int newx = data->newlen;
+  const float add = data->add;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+  const size_t row_size = (size_t)ibuf->x * 4;
+
+  const uchar *rect_row = do_rect ? (uchar *)ibuf->rect + row_size * y : NULL;
+  const float *rectf_row = do_float ? ibuf->rect_float + row_size * y : NULL;
+  const uchar *rect = rect_row;
+  const float *rectf = rectf_row;
+  uchar *newrect = do_rect ? data->newrect + (size_t)newx * 4 * y : NULL;
+  float *newrectf = do_float ? data->newrectf + (size_t)newx * 4 * y : NULL;
+
+  float sample = 0.0f;
+  float val[4] = {0.0f}, nval[4] = {0.0f}, valf[4] = {0.0f}, nvalf[4] = {0.0f};
+
+  for (int x = newx; x > 0; x--) {
+    if (do_rect) {
+      nval[0] = -val[0] * sample;
+      nval[1] = -val[1] * sample;
+      nval[2] = -val[2] * sample;
+      nval[3] = -val[3] * sample;
+    }
+    if (do_float) {
+      nvalf[0] = -valf[0] * sample;
+      nvalf[1] = -valf[1] * sample;
+      nvalf[2] = -valf[2] * sample;
+      nvalf[3] = -valf[3] * sample;
+    }
+
+    sample += add;
+
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
+
+      if (do_rect) {
+        nval[0] += rect[0];
+        nval[1] += rect[1];
+        nval[2] += rect[2];
+        nval[3] += rect[3];
+        rect += 4;
+      }
+      if (do_float) {
+        nvalf[0] += rectf[0];
+        nvalf[1] += rectf[1];
+        nvalf[2] += rectf[2];
+        nvalf[3] += rectf[3];
+        rectf += 4;
+      }
+    }
+
+    if (do_rect) {
+      val[0] = rect[0];
+      val[1] = rect[1];
+      val[2] = rect[2];
+      val[3] = rect[3];
+      rect += 4;
+
+      newrect[0] = ((nval[0] + sample * val[0]) / add + 0.5f);
+      newrect[1] = ((nval[1] + sample * val[1]) / add + 0.5f);
+      newrect[2] = ((nval[2] + sample * val[2]) / add + 0.5f);
+      newrect[3] = ((nval[3] + sample * val[3]) / add + 0.5f);
+
+      newrect += 4;
+    }
+    if (do_float) {
+
+      valf[0] = rectf[0];
+      valf[1] = rectf[1];
+      valf[2] = rectf[2];
+      valf[3] = rectf[3];
+      rectf += 4;
+
+      newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+      newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+      newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+      newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+
+      newrectf += 4;
+    }
+
+    sample -= 1.0f;
+  }
+
+  /* see bug [#26502] */
+  BLI_assert(!do_rect || (size_t)(rect - rect_row) == row_size);
+  BLI_assert(!do_float || (size_t)(rectf - rectf_row) == row_size);
+  UNUSED_VARS_NDEBUG(rect_row, rectf_row, row_size);
+}
+
 static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
 {
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
-
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  ScaleLinesData data = {ibuf, newx, (ibuf->x - 0.01) / newx, NULL, NULL};
 
   if (!do_rect && !do_float) {
     return (ibuf);
   }
 
   if (do_rect) {
-    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(uchar) * 4, "scaledownx");
-    if (_newrect == NULL) {
+    data.newrect = MEM_mallocN(newx * ibuf->y * sizeof(uchar) * 4, "scaledownx");
+    if (data.newrect == NULL) {
       return (ibuf);
     }
   }
   if (do_float) {
-    _newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaledownxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+    data.newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaledownxf");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
       }
       return (ibuf);
     }
   }
 
-  add = (ibuf->x - 0.01) / newx;
+  scale_lines_parallel(&data, ibuf->y, scaledownx_line);
 
   if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
+    imb_freerectImBuf(ibuf);
+    ibuf->mall |= IB_rect;
+    ibuf->rect = (unsigned int *)data.newrect;
   }
   if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
+    imb_freerectfloatImBuf(ibuf);
+    ibuf->mall |= IB_rectfloat;
+    ibuf->rect_float = data.newrectf;
   }
 
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (x = newx; x > 0; x--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
+  ibuf->x = newx;
+  return (ibuf);
+}
 
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
-        }
-      }
+static void scaledowny_line(void *__restrict userdata,
+                            const int x,
+                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleLinesData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int newy = data->newlen;
+  const float add = data->add;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+  const int skipx = 4 * ibuf->x;
+
+  const uchar *rect_col = do_rect ? (uchar *)ibuf->rect + 4 * x : NULL;
+  const float *rectf_col = do_float ? ibuf->rect_float + 4 * x : NULL;
+  const uchar *rect = rect_col;
+  const float *rectf = rectf_col;
+  uchar *newrect = do_rect ? data->newrect + 4 * x : NULL;
+  float *newrectf = do_float ? data->newrectf + 4 * x : NULL;
+
+  float sample = 0.0f;
+  float val[4] = {0.0f}, nval[4] = {0.0f}, valf[4] = {0.0f}, nvalf[4] = {0.0f};
+
+  for (int y = newy; y > 0; y--) {
+    if (do_rect) {
+      nval[0] = -val[0] * sample;
+      nval[1] = -val[1] * sample;
+      nval[2] = -val[2] * sample;
+      nval[3] = -val[3] * sample;
+    }
+    if (do_float) {
+      nvalf[0] = -valf[0] * sample;
+      nvalf[1] = -valf[1] * sample;
+      nvalf[2] = -valf[2] * sample;
+      nvalf[3] = -valf[3] * sample;
+    }
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
+    sample += add;
 
-        newrect[0] = ((nval[0] + sample * val[0]) / add + 0.5f);
-        newrect[1] = ((nval[1] + sample * val[1]) / add + 0.5f);
-        newrect[2] = ((nval[2] + sample * val[2]) / add + 0.5f);
-        newrect[3] = ((nval[3] + sample * val[3]) / add + 0.5f);
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
 
-        newrect += 4;
+      if (do_rect) {
+        nval[0] += rect[0];
+        nval[1] += rect[1];
+        nval[2] += rect[2];
+        nval[3] += rect[3];
+        rect += skipx;
       }
       if (do_float) {
+        nvalf[0] += rectf[0];
+        nvalf[1] += rectf[1];
+        nvalf[2] += rectf[2];
+        nvalf[3] += rectf[3];
+        rectf += skipx;
+      }
+    }
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
+    if (do_rect) {
+      val[0] = rect[0];
+      val[1] = rect[1];
+      val[2] = rect[2];
+      val[3] = rect[3];
+      rect += skipx;
+
+      newrect[0] = ((nval[0] + sample * val[0]) / add + 0.5f);
+      newrect[1] = ((nval[1] + sample * val[1]) / add + 0.5f);
+      newrect[2] = ((nval[2] + sample * val[2]) / add + 0.5f);
+      newrect[3] = ((nval[3] + sample * val[3]) / add + 0.5f);
+
+      newrect += skipx;
+    }
+    if (do_float) {
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+      valf[0] = rectf[0];
+      valf[1] = rectf[1];
+      valf[2] = rectf[2];
+      valf[3] = rectf[3];
+      rectf += skipx;
 
-        newrectf += 4;
-      }
+      newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+      newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+      newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+      newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
 
-      sample -= 1.0f;
+      newrectf += skipx;
     }
-  }
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug [#26502] */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug [#26502] */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = _newrectf;
+    sample -= 1.0f;
   }
-  (void)rect_size; /* UNUSED in release builds */
 
-  ibuf->x = newx;
-  return (ibuf);
+  /* see bug [#26502] */
+  BLI_assert(!do_rect || (rect - rect_col) == (ptrdiff_t)skipx * ibuf->y);
+  BLI_assert(!do_float || (rectf - rectf_col) == (ptrdiff_t)skipx * ibuf->y);
+  UNUSED_VARS_NDEBUG(rect_col, rectf_col);
 }
 
 static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
 {
   const int do_rect = (ibuf->rect != NULL);
   const int do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = ibuf->x * ibuf->y * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
-
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+  ScaleLinesData data = {ibuf, newy, (ibuf->y - 0.01) / newy, NULL, NULL};
 
   if (!do_rect && !do_float) {
     return (ibuf);
   }
 
   if (do_rect) {
-    _newrect = MEM_mallocN(newy * ibuf->x * sizeof(uchar) * 4, "scaledowny");
-    if (_newrect == NULL) {
+    data.newrect = MEM_mallocN(newy * ibuf->x * sizeof(uchar) * 4, "scaledowny");
+    if (data.newrect == NULL) {
       return (ibuf);
     }
   }
   if (do_float) {
-    _newrectf = MEM_mallocN(newy * ibuf->x * sizeof(float) * 4, "scaledownyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+    data.newrectf = MEM_mallocN(newy * ibuf->x * sizeof(float) * 4, "scaledownyf");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
       }
       return (ibuf);
     }
   }
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
+  scale_lines_parallel(&data, ibuf->x, scaledowny_line);
 
-  for (x = skipx - 4; x >= 0; x -= 4) {
-    if (do_rect) {
-      rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
-    }
-    if (do_float) {
-      rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
-    }
+  if (do_rect) {
+    imb_freerectImBuf(ibuf);
+    ibuf->mall |= IB_rect;
+    ibuf->rect = (unsigned int *)data.newrect;
+  }
+  if (do_float) {
+    imb_freerectfloatImBuf(ibuf);
+    ibuf->mall |= IB_rectfloat;
+    ibuf->rect_float = data.newrectf;
+  }
 
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
+  ibuf->y = newy;
+  return (ibuf);
+}
 
-    for (y = newy; y > 0; y--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
+static void scaleupx_line(void *__restrict userdata,
+                          const int y,
+                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleLinesData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int newx = data->newlen;
+  const float add = data->add;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+  const size_t row_size = (size_t)ibuf->x * 4;
+
+  const uchar *rect = do_rect ? (uchar *)ibuf->rect + row_size * y : NULL;
+  const float *rectf = do_float ? ibuf->rect_float + row_size * y : NULL;
+  uchar *newrect = do_rect ? data->newrect + (size_t)newx * 4 * y : NULL;
+  float *newrectf = do_float ? data->newrectf + (size_t)newx * 4 * y : NULL;
+
+  float sample = 0;
+  float val_a = 0, nval_a = 0, diff_a = 0;
+  float val_b = 0, nval_b = 0, diff_b = 0;
+  float val_g = 0, nval_g = 0, diff_g = 0;
+  float val_r = 0, nval_r = 0, diff_r = 0;
+  float val_af = 0, nval_af = 0, diff_af = 0;
+  float val_bf = 0, nval_bf = 0, diff_bf = 0;
+  float val_gf = 0, nval_gf = 0, diff_gf = 0;
+  float val_rf = 0, nval_rf = 0, diff_rf = 0;
 
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
-        }
-      }
+  if (do_rect) {
+    val_a = rect[0];
+    nval_a = rect[4];
+    diff_a = nval_a - val_a;
+    val_a += 0.5f;
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
+    val_b = rect[1];
+    nval_b = rect[5];
+    diff_b = nval_b - val_b;
+    val_b += 0.5f;
+
+    val_g = rect[2];
+    nval_g = rect[6];
+    diff_g = nval_g - val_g;
+    val_g += 0.5f;
 
-        newrect[0] = ((nval[0] + sample * val[0]) / add + 0.5f);
-        newrect[1] = ((nval[1] + sample * val[1]) / add + 0.5f);
-        newrect[2] = ((nval[2] + sample * val[2]) / add + 0.5f);
-        newrect[3] = ((nval[3] + sample * val[3]) / add + 0.5f);
+    val_r = rect[3];
+    nval_r = rect[7];
+    diff_r = nval_r - val_r;
+    val_r += 0.5f;
 
-        newrect += skipx;
+    rect += 8;
+  }
+  if (do_float) {
+    val_af = rectf[0];
+    nval_af = rectf[4];
+    diff_af = nval_af - val_af;
+
+    val_bf = rectf[1];
+    nval_bf = rectf[5];
+    diff_bf = nval_bf - val_bf;
+
+    val_gf = rectf[2];
+    nval_gf = rectf[6];
+    diff_gf = nval_gf - val_gf;
+
+    val_rf = rectf[3];
+    nval_rf = rectf[7];
+    diff_rf = nval_rf - val_rf;
+
+    rectf += 8;
+  }
+  for (int x = newx; x > 0; x--) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
+
+      if (do_rect) {
+        val_a = nval_a;
+        nval_a = rect[0];
+        diff_a = nval_a - val_a;
+        val_a += 0.5f;
+
+        val_b = nval_b;
+        nval_b = rect[1];
+        diff_b = nval_b - val_b;
+        val_b += 0.5f;
+
+        val_g = nval_g;
+        nval_g = rect[2];
+        diff_g = nval_g - val_g;
+        val_g += 0.5f;
+
+        val_r = nval_r;
+        nval_r = rect[3];
+        diff_r = nval_r - val_r;
+        val_r += 0.5f;
+        rect += 4;
       }
       if (do_float) {
+        val_af = nval_af;
+        nval_af = rectf[0];
+        diff_af = nval_af - val_af;
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
+        val_bf = nval_bf;
+        nval_bf = rectf[1];
+        diff_bf = nval_bf - val_bf;
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+        val_gf = nval_gf;
+        nval_gf = rectf[2];
+        diff_gf = nval_gf - val_gf;
 
-        newrectf += skipx;
+        val_rf = nval_rf;
+        nval_rf = rectf[3];
+        diff_rf = nval_rf - val_rf;
+        rectf += 4;
       }
-
-      sample -= 1.0f;
     }
+    if (do_rect) {
+      newrect[0] = val_a + sample * diff_a;
+      newrect[1] = val_b + sample * diff_b;
+      newrect[2] = val_g + sample * diff_g;
+      newrect[3] = val_r + sample * diff_r;
+      newrect += 4;
+    }
+    if (do_float) {
+      newrectf[0] = val_af + sample * diff_af;
+      newrectf[1] = val_bf + sample * diff_bf;
+      newrectf[2] = val_gf + sample * diff_gf;
+      newrectf[3] = val_rf + sample * diff_rf;
+      newrectf += 4;
+    }
+    sample += add;
   }
-
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug [#26502] */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug [#26502] */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
-  }
-  (void)rect_size; /* UNUSED in release builds */
-
-  ibuf->y = newy;
-  return (ibuf);
 }
 
 static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
-  float sample, add;
-  float val_a, nval_a, diff_a;
-  float val_b, nval_b, diff_b;
-  float val_g, nval_g, diff_g;
-  float val_r, nval_r, diff_r;
-  float val_af, nval_af, diff_af;
-  float val_bf, nval_bf, diff_bf;
-  float val_gf, nval_gf, diff_gf;
-  float val_rf, nval_rf, diff_rf;
-  int x, y;
-  bool do_rect = false, do_float = false;
-
-  val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-  val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-  val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-  val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
   if (ibuf == NULL) {
     return (NULL);
   }
@@ -1216,175 +1369,176 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
     return (ibuf);
   }
 
+  ScaleLinesData data = {ibuf, newx, (ibuf->x - 1.001) / (newx - 1.0), NULL, NULL};
+
   if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(int), "scaleupx");
-    if (_newrect == NULL) {
+    data.newrect = MEM_mallocN(newx * ibuf->y * sizeof(int), "scaleupx");
+    if (data.newrect == NULL) {
       return (ibuf);
     }
   }
   if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaleupxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+    data.newrectf = MEM_mallocN(newx * ibuf->y * sizeof(float) * 4, "scaleupxf");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
       }
       return (ibuf);
     }
   }
 
-  add = (ibuf->x - 1.001) / (newx - 1.0);
+  scale_lines_parallel(&data, ibuf->y, scaleupx_line);
 
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
+  if (data.newrect) {
+    imb_freerectImBuf(ibuf);
+    ibuf->mall |= IB_rect;
+    ibuf->rect = (unsigned int *)data.newrect;
+  }
+  if (data.newrectf) {
+    imb_freerectfloatImBuf(ibuf);
+    ibuf->mall |= IB_rectfloat;
+    ibuf->rect_float = data.newrectf;
+  }
 
-  for (y = ibuf->y; y > 0; y--) {
+  ibuf->x = newx;
+  return (ibuf);
+}
 
-    sample = 0;
+static void scaleupy_line(void *__restrict userdata,
+                          const int x,
+                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleLinesData *data = userdata;
+  const ImBuf *ibuf = data->ibuf;
+  const int newy = data->newlen;
+  const float add = data->add;
+  const bool do_rect = (data->newrect != NULL);
+  const bool do_float = (data->newrectf != NULL);
+  const int skipx = 4 * ibuf->x;
+
+  const uchar *rect = do_rect ? (uchar *)ibuf->rect + 4 * x : NULL;
+  const float *rectf = do_float ? ibuf->rect_float + 4 * x : NULL;
+  uchar *newrect = do_rect ? data->newrect + 4 * x : NULL;
+  float *newrectf = do_float ? data->newrectf + 4 * x : NULL;
+
+  float sample = 0;
+  float val_a = 0, nval_a = 0, diff_a = 0;
+  float val_b = 0, nval_b = 0, diff_b = 0;
+  float val_g = 0, nval_g = 0, diff_g = 0;
+  float val_r = 0, nval_r = 0, diff_r = 0;
+  float val_af = 0, nval_af = 0, diff_af = 0;
+  float val_bf = 0, nval_bf = 0, diff_bf = 0;
+  float val_gf = 0, nval_gf = 0, diff_gf = 0;
+  float val_rf = 0, nval_rf = 0, diff_rf = 0;
 
-    if (do_rect) {
-      val_a = rect[0];
-      nval_a = rect[4];
-      diff_a = nval_a - val_a;
-      val_a += 0.5f;
-
-      val_b = rect[1];
-      nval_b = rect[5];
-      diff_b = nval_b - val_b;
-      val_b += 0.5f;
-
-      val_g = rect[2];
-      nval_g = rect[6];
-      diff_g = nval_g - val_g;
-      val_g += 0.5f;
-
-      val_r = rect[3];
-      nval_r = rect[7];
-      diff_r = nval_r - val_r;
-      val_r += 0.5f;
-
-      rect += 8;
-    }
-    if (do_float) {
-      val_af = rectf[0];
-      nval_af = rectf[4];
-      diff_af = nval_af - val_af;
+  if (do_rect) {
+    val_a = rect[0];
+    nval_a = rect[skipx];
+    diff_a = nval_a - val_a;
+    val_a += 0.5f;
 
-      val_bf = rectf[1];
-      nval_bf = rectf[5];
-      diff_bf = nval_bf - val_bf;
+    val_b = rect[1];
+    nval_b = rect[skipx + 1];
+    diff_b = nval_b - val_b;
+    val_b += 0.5f;
 
-      val_gf = rectf[2];
-      nval_gf = rectf[6];
-      diff_gf = nval_gf - val_gf;
+    val_g = rect[2];
+    nval_g = rect[skipx + 2];
+    diff_g = nval_g - val_g;
+    val_g += 0.5f;
 
-      val_rf = rectf[3];
-      nval_rf = rectf[7];
-      diff_rf = nval_rf - val_rf;
+    val_r = rect[3];
+    nval_r = rect[skipx + 3];
+    diff_r = nval_r - val_r;
+    val_r += 0.5f;
+
+    rect += 2 * skipx;
+  }
+  if (do_float) {
+    val_af = rectf[0];
+    nval_af = rectf[skipx];
+    diff_af = nval_af - val_af;
+
+    val_bf = rectf[1];
+    nval_bf = rectf[skipx + 1];
+    diff_bf = nval_bf - val_bf;
+
+    val_gf = rectf[2];
+    nval_gf = rectf[skipx + 2];
+    diff_gf = nval_gf - val_gf;
+
+    val_rf = rectf[3];
+    nval_rf = rectf[skipx + 3];
+    diff_rf = nval_rf - val_rf;
+
+    rectf += 2 * skipx;
+  }
+
+  for (int y = newy; y > 0; y--) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
 
-      rectf += 8;
-    }
-    for (x = newx; x > 0; x--) {
-      if (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          val_a = nval_a;
-          nval_a = rect[0];
-          diff_a = nval_a - val_a;
-          val_a += 0.5f;
-
-          val_b = nval_b;
-          nval_b = rect[1];
-          diff_b = nval_b - val_b;
-          val_b += 0.5f;
-
-          val_g = nval_g;
-          nval_g = rect[2];
-          diff_g = nval_g - val_g;
-          val_g += 0.5f;
-
-          val_r = nval_r;
-          nval_r = rect[3];
-          diff_r = nval_r - val_r;
-          val_r += 0.5f;
-          rect += 4;
-        }
-        if (do_float) {
-          val_af = nval_af;
-          nval_af = rectf[0];
-          diff_af = nval_af - val_af;
-
-          val_bf = nval_bf;
-          nval_bf = rectf[1];
-          diff_bf = nval_bf - val_bf;
-
-          val_gf = nval_gf;
-          nval_gf = rectf[2];
-          diff_gf = nval_gf - val_gf;
-
-          val_rf = nval_rf;
-          nval_rf = rectf[3];
-          diff_rf = nval_rf - val_rf;
-          rectf += 4;
-        }
-      }
       if (do_rect) {
-        newrect[0] = val_a + sample * diff_a;
-        newrect[1] = val_b + sample * diff_b;
-        newrect[2] = val_g + sample * diff_g;
-        newrect[3] = val_r + sample * diff_r;
-        newrect += 4;
+        val_a = nval_a;
+        nval_a = rect[0];
+        diff_a = nval_a - val_a;
+        val_a += 0.5f;
+
+        val_b = nval_b;
+        nval_b = rect[1];
+        diff_b = nval_b - val_b;
+        val_b += 0.5f;
+
+        val_g = nval_g;
+        nval_g = rect[2];
+        diff_g = nval_g - val_g;
+        val_g += 0.5f;
+
+        val_r = nval_r;
+        nval_r = rect[3];
+        diff_r = nval_r - val_r;
+        val_r += 0.5f;
+        rect += skipx;
       }
       if (do_float) {
-        newrectf[0] = val_af + sample * diff_af;
-        newrectf[1] = val_bf + sample * diff_bf;
-        newrectf[2] = val_gf + sample * diff_gf;
-        newrectf[3] = val_rf + sample * diff_rf;
-        newrectf += 4;
+        val_af = nval_af;
+        nval_af = rectf[0];
+        diff_af = nval_af - val_af;
+
+        val_bf = nval_bf;
+        nval_bf = rectf[1];
+        diff_bf = nval_bf - val_bf;
+
+        val_gf = nval_gf;
+        nval_gf = rectf[2];
+        diff_gf = nval_gf - val_gf;
+
+        val_rf = nval_rf;
+        nval_rf = rectf[3];
+        diff_rf = nval_rf - val_rf;
+        rectf += skipx;
       }
-      sample += add;
     }
+    if (do_rect) {
+      newrect[0] = val_a + sample * diff_a;
+      newrect[1] = val_b + sample * diff_b;
+      newrect[2] = val_g + sample * diff_g;
+      newrect[3] = val_r + sample * diff_r;
+      newrect += skipx;
+    }
+    if (do_float) {
+      newrectf[0] = val_af + sample * diff_af;
+      newrectf[1] = val_bf + sample * diff_bf;
+      newrectf[2] = val_gf + sample * diff_gf;
+      newrectf[3] = val_rf + sample * diff_rf;
+      newrectf += skipx;
+    }
+    sample += add;
   }
-
-  if (do_rect) {
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
-  }
-  if (do_float) {
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
-  }
-
-  ibuf->x = newx;
-  return (ibuf);
 }
 
 static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
-  float sample, add;
-  float val_a, nval_a, diff_a;
-  float val_b, nval_b, diff_b;
-  float val_g, nval_g, diff_g;
-  float val_r, nval_r, diff_r;
-  float val_af, nval_af, diff_af;
-  float val_bf, nval_bf, diff_bf;
-  float val_gf, nval_gf, diff_gf;
-  float val_rf, nval_rf, diff_rf;
-  int x, y, skipx;
-  bool do_rect = false, do_float = false;
-
-  val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-  val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-  val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-  val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
   if (ibuf == NULL) {
     return (NULL);
   }
@@ -1392,156 +1546,35 @@ static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
     return (ibuf);
   }
 
+  ScaleLinesData data = {ibuf, newy, (ibuf->y - 1.001) / (newy - 1.0), NULL, NULL};
+
   if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(ibuf->x * newy * sizeof(int), "scaleupy");
-    if (_newrect == NULL) {
+    data.newrect = MEM_mallocN(ibuf->x * newy * sizeof(int), "scaleupy");
+    if (data.newrect == NULL) {
       return (ibuf);
     }
   }
   if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(ibuf->x * newy * sizeof(float) * 4, "scaleupyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
+    data.newrectf = MEM_mallocN(ibuf->x * newy * sizeof(float) * 4, "scaleupyf");
+    if (data.newrectf == NULL) {
+      if (data.newrect) {
+        MEM_freeN(data.newrect);
       }
       return (ibuf);
     }
   }
 
-  add = (ibuf->y - 1.001) / (newy - 1.0);
-  skipx = 4 * ibuf->x;
-
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
-  for (x = ibuf->x; x > 0; x--) {
-
-    sample = 0;
-    if (do_rect) {
-      rect = ((uchar *)ibuf->rect) + 4 * (x - 1);
-      newrect = _newrect + 4 * (x - 1);
-
-      val_a = rect[0];
-      nval_a = rect[skipx];
-      diff_a = nval_a - val_a;
-      val_a += 0.5f;
-
-      val_b = rect[1];
-      nval_b = rect[skipx + 1];
-      diff_b = nval_b - val_b;
-      val_b += 0.5f;
-
-      val_g = rect[2];
-      nval_g = rect[skipx + 2];
-      diff_g = nval_g - val_g;
-      val_g += 0.5f;
-
-      val_r = rect[3];
-      nval_r = rect[skipx + 3];
-      diff_r = nval_r - val_r;
-      val_r += 0.5f;
-
-      rect += 2 * skipx;
-    }
-    if (do_float) {
-      rectf = ibuf->rect_float + 4 * (x - 1);
-      newrectf = _newrectf + 4 * (x - 1);
-
-      val_af = rectf[0];
-      nval_af = rectf[skipx];
-      diff_af = nval_af - val_af;
-
-      val_bf = rectf[1];
-      nval_bf = rectf[skipx + 1];
-      diff_bf = nval_bf - val_bf;
-
-      val_gf = rectf[2];
-      nval_gf = rectf[skipx + 2];
-      diff_gf = nval_gf - val_gf;
+  scale_lines_parallel(&data, ibuf->x, scaleupy_line);
 
-      val_rf = rectf[3];
-      nval_rf = rectf[skipx + 3];
-      diff_rf = nval_rf - val_rf;
-
-      rectf += 2 * skipx;
-    }
-
-    for (y = newy; y > 0; y--) {
-      if (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          val_a = nval_a;
-          nval_a = rect[0];
-          diff_a = nval_a - val_a;
-          val_a += 0.5f;
-
-          val_b = nval_b;
-          nval_b = rect[1];
-          diff_b = nval_b - val_b;
-          val_b += 0.5f;
-
-          val_g = nval_g;
-          nval_g = rect[2];
-          diff_g = nval_g - val_g;
-          val_g += 0.5f;
-
-          val_r = nval_r;
-          nval_r = rect[3];
-          diff_r = nval_r - val_r;
-          val_r += 0.5f;
-          rect += skipx;
-        }
-        if (do_float) {
-          val_af = nval_af;
-          nval_af = rectf[0];
-          diff_af = nval_af - val_af;
-
-          val_bf = nval_bf;
-          nval_bf = rectf[1];
-          diff_bf = nval_bf - val_bf;
-
-          val_gf = nval_gf;
-          nval_gf = rectf[2];
-          diff_gf = nval_gf - val_gf;
-
-          val_rf = nval_rf;
-          nval_rf = rectf[3];
-          diff_rf = nval_rf - val_rf;
-          rectf += skipx;
-        }
-      }
-      if (do_rect) {
-        newrect[0] = val_a + sample * diff_a;
-        newrect[1] = val_b + sample * diff_b;
-        newrect[2] = val_g + sample * diff_g;
-        newrect[3] = val_r + sample * diff_r;
-        newrect += skipx;
-      }
-      if (do_float) {
-        newrectf[0] = val_af + sample * diff_af;
-        newrectf[1] = val_bf + sample * diff_bf;
-        newrectf[2] = val_gf + sample * diff_gf;
-        newrectf[3] = val_rf + sample * diff_rf;
-        newrectf += skipx;
-      }
-      sample += add;
-    }
-  }
-
-  if (do_rect) {
+  if (data.newrect) {
     imb_freerectImBuf(ibuf);
     ibuf->mall |= IB_rect;
-    ibuf->rect = (unsigned int *)_newrect;
+    ibuf->rect = (unsigned int *)data.newrect;
   }
-  if (do_float) {
+  if (data.newrectf) {
     imb_freerectfloatImBuf(ibuf);
     ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+    ibuf->rect_float = data.newrectf;
   }
 
   ibuf->y = newy;
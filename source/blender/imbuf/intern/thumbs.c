@@ -44,6 +44,7 @@
 #include "IMB_imbuf.h"
 #include "IMB_thumbs.h"
 #include "IMB_metadata.h"
+#include "IMB_filetype.h"
 
 #include <ctype.h>
 #include <string.h>
@@ -406,6 +407,35 @@ void IMB_thumb_makedirs(void)
 }
 
 /* create thumbnail for file and returns new imbuf for thumbnail */
+/**
+ * Load an image to create a thumbnail of \a tsize from, formats supporting it are decoded at a
+ * reduced resolution.
+ * \param r_width, r_height: Size of the full resolution image.
+ */
+static ImBuf *thumb_load_image(const char *file_path,
+                               const int tsize,
+                               size_t *r_width,
+                               size_t *r_height)
+{
+  ImBuf *img = NULL;
+
+  if (IMB_ispic_type(file_path) == IMB_FTYPE_JPG) {
+    char colorspace[IM_MAX_SPACE] = "\0";
+    img = imb_thumbnail_jpeg(
+        file_path, IB_rect | IB_metadata, (size_t)tsize, colorspace, r_width, r_height);
+  }
+
+  if (img == NULL) {
+    img = IMB_loadiffname(file_path, IB_rect | IB_metadata, NULL);
+    if (img) {
+      *r_width = (size_t)img->x;
+      *r_height = (size_t)img->y;
+    }
+  }
+
+  return img;
+}
+
 static ImBuf *thumb_create_ex(const char *file_path,
                               const char *uri,
                               const char *thumb,
@@ -427,6 +457,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
   short tsize = 128;
   short ex, ey;
   float scaledx, scaledy;
+  size_t img_width = 0, img_height = 0;
   BLI_stat_t info;
 
   switch (size) {
@@ -471,7 +502,7 @@ static ImBuf *thumb_create_ex(const char *file_path,
         if (img == NULL) {
           switch (source) {
             case THB_SOURCE_IMAGE:
-              img = IMB_loadiffname(file_path, IB_rect | IB_metadata, NULL);
+              img = thumb_load_image(file_path, tsize, &img_width, &img_height);
               break;
             case THB_SOURCE_BLEND:
               img = IMB_thumb_load_blend(file_path, blen_group, blen_id);
@@ -488,8 +519,12 @@ static ImBuf *thumb_create_ex(const char *file_path,
           if (BLI_stat(file_path, &info) != -1) {
             BLI_snprintf(mtime, sizeof(mtime), "%ld", (long int)info.st_mtime);
           }
-          BLI_snprintf(cwidth, sizeof(cwidth), "%d", img->x);
-          BLI_snprintf(cheight, sizeof(cheight), "%d", img->y);
+          if (img_width == 0) {
+            img_width = (size_t)img->x;
+            img_height = (size_t)img->y;
+          }
+          BLI_snprintf(cwidth, sizeof(cwidth), "%d", (int)img_width);
+          BLI_snprintf(cheight, sizeof(cheight), "%d", (int)img_height);
         }
       }
       else if (THB_SOURCE_MOVIE == source) {
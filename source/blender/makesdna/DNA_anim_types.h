@@ -591,7 +591,12 @@ typedef struct FCurve {
   /* value cache + settings */
   /** Value stored from last time curve was evaluated (not threadsafe, debug display only!). */
   float curval;
-  char _pad2[4];
+  /**
+   * Index of the keyframe starting the segment used by the last evaluation (runtime only),
+   * tried first by the next evaluation since playback tends to stay within the same segment.
+   * Only a hint, checked before use (not threadsafe, may be written from multiple threads).
+   */
+  int eval_segment_hint;
   /** User-editable settings for this curve. */
   short flag;
   /** Value-extending mode for this curve (does not cover). */
@@ -222,6 +222,9 @@ enum {
   CD_FLAG_EXTERNAL = (1 << 3),
   /* Indicates external data is read into memory */
   CD_FLAG_IN_MEMORY = (1 << 4),
+  /* Indicates the layer data is shared with other layers (always with CD_FLAG_NOFREE),
+   * it is freed by the last layer using it. Runtime only, cleared on file read. */
+  CD_FLAG_SHARED = (1 << 5),
 };
 
 /* Limits */
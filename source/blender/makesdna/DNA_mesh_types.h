@@ -83,6 +83,10 @@ typedef struct Mesh_Runtime {
    * Since modifier stack evaluation is threaded on object level we need some synchronization. */
   struct Mesh *mesh_eval;
   void *eval_mutex;
+  /** Protect the lazy computation of vertex normals and looptris, which may be requested
+   * from multiple threads at once (see #BKE_mesh_ensure_normals). */
+  void *normals_mutex;
+  void *looptris_mutex;
 
   struct EditMeshData *edit_data;
   void *batch_cache;
@@ -105,6 +109,14 @@ typedef struct Mesh_Runtime {
   /** Non-manifold boundary data for Shrinkwrap Target Project. */
   struct ShrinkwrapBoundaryData *shrinkwrap_data;
 
+  /**
+   * Object space transforms of instances of this mesh, drawn and rendered in addition
+   * to the mesh its self. Set by modifiers which output instances instead of copying
+   * the geometry (see #MOD_ARR_INSTANCES), only for the final evaluated mesh.
+   */
+  float (*instance_mats)[4][4];
+  int instance_mats_len;
+
   /** Set by modifier stack if only deformed from original. */
   char deformed_only;
   /**
@@ -112,7 +124,13 @@ typedef struct Mesh_Runtime {
    * In the future we may leave the mesh-data empty
    * since its not needed if we can use edit-mesh data. */
   char is_original;
-  char _pad[6];
+  /**
+   * The batch cache was taken over from the previous evaluated mesh which only differs in
+   * vertex positions, only position dependent buffers need to be updated.
+   * Cleared when tagging the batch cache (see #BKE_object_batch_cache_dirty_tag).
+   */
+  char is_batch_cache_deform_reused;
+  char _pad[1];
 } Mesh_Runtime;
 
 typedef struct Mesh {
@@ -291,6 +291,7 @@ typedef struct ArrayModifierData {
   int offset_type;
   /* general flags:
    * MOD_ARR_MERGE -> merge vertices in adjacent duplicates
+   * MOD_ARR_INSTANCES -> instance the duplicates when they can't differ from the first one
    */
   int flags;
   /* the number of duplicates to generate for MOD_ARR_FIXEDCOUNT */
@@ -316,6 +317,8 @@ enum {
 enum {
   MOD_ARR_MERGE = (1 << 0),
   MOD_ARR_MERGEFINAL = (1 << 1),
+  /* Output instances of the geometry instead of copies, see #Mesh_Runtime.instance_mats. */
+  MOD_ARR_INSTANCES = (1 << 2),
 };
 
 typedef struct MirrorModifierData {
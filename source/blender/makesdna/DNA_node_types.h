@@ -508,6 +508,7 @@ typedef struct bNodeTree {
 
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
+#define NTREE_COM_GLSL (1 << 6) /* use glsl */
 
 /* ntree->update */
 typedef enum eNodeTreeUpdate {
@@ -752,7 +752,8 @@ typedef struct RenderData {
 
   /* render engine */
   char engine[32];
-  char _pad2[4];
+  /** Save buffers when the full frame render result would use more memory (in MB), 0 if off. */
+  int save_buffers_memory_limit;
 
   /* Cycles baking */
   struct BakeData bake;
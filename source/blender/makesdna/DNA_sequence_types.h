@@ -682,6 +682,9 @@ enum {
   SEQ_CACHE_VIEW_FINAL_OUT = (1 << 9),
 
   SEQ_CACHE_PREFETCH_ENABLE = (1 << 10),
+
+  /* Keep the final images of the preview compressed in memory. */
+  SEQ_CACHE_COMPRESS_FINAL_OUT = (1 << 11),
 };
 
 #ifdef __cplusplus
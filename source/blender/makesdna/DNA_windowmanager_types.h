@@ -180,6 +180,9 @@ typedef struct wmWindowManager {
 
   struct wmMsgBus *message_bus;
 
+  /** Notifiers of #queue, to skip adding duplicates without walking the queue (runtime only). */
+  struct GSet *notifier_queue_set;
+
 } wmWindowManager;
 
 /* wmWindowManager.initialized */
@@ -4517,6 +4517,16 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        if (out.stride == size) {
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
@@ -4532,8 +4542,29 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* could also be faster with non-matching types,
-       * for now we just do slower loop .. */
+      /* non-matching raw types, convert the items directly
+       * instead of going through the RNA getters and setters */
+      {
+        RawArray item = out;
+        int a, j, index = 0;
+
+        for (a = 0; a < out.len; a++) {
+          for (j = 0; j < arraylen; j++, index++) {
+            double value;
+            if (set) {
+              RAW_GET(double, value, in, index);
+              RAW_SET(double, item, j, value);
+            }
+            else {
+              RAW_GET(double, value, item, j);
+              RAW_SET(double, in, index, value);
+            }
+          }
+          item.array = (char *)item.array + out.stride;
+        }
+
+        return 1;
+      }
     }
   }
 
@@ -790,6 +790,11 @@ void RNA_struct_free(BlenderRNA *brna, StructRNA *srna)
   }
 #  endif
 
+  if (srna->cont.prophash) {
+    BLI_ghash_free(srna->cont.prophash, NULL, NULL);
+    srna->cont.prophash = NULL;
+  }
+
   for (prop = srna->cont.properties.first; prop; prop = nextprop) {
     nextprop = prop->next;
 
@@ -922,6 +927,11 @@ StructRNA *RNA_def_struct_ptr(BlenderRNA *brna, const char *identifier, StructRN
      * use MEM_dupallocN, data structs may not be alloced but builtin */
     memcpy(srna, srnafrom, sizeof(StructRNA));
     srna->cont.prophash = NULL;
+#ifdef RNA_RUNTIME
+    /* Registered types (operators, property groups...) get their properties at runtime,
+     * hash them like the builtin types so looking them up doesn't search the list. */
+    srna->cont.prophash = BLI_ghash_str_new("RNA_def_struct_ptr gh");
+#endif
     BLI_listbase_clear(&srna->cont.properties);
     BLI_listbase_clear(&srna->functions);
     srna->py_type = NULL;
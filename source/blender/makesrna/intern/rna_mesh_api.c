@@ -44,6 +44,10 @@
 #  include "BKE_mesh_runtime.h"
 #  include "ED_mesh.h"
 
+#  ifdef WITH_PYTHON
+#    include "BPY_extern.h"
+#  endif
+
 static const char *rna_Mesh_unit_test_compare(struct Mesh *mesh, struct Mesh *mesh2)
 {
   const char *ret = BKE_mesh_cmp(mesh, mesh2, FLT_EPSILON * 60);
@@ -63,6 +67,20 @@ static void rna_Mesh_create_normals_split(Mesh *mesh)
   }
 }
 
+/* The calculations below don't run any Python code, allow other Python threads in the meantime. */
+static void rna_Mesh_calc_normals_split(Mesh *mesh)
+{
+#  ifdef WITH_PYTHON
+  BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
+  BKE_mesh_calc_normals_split(mesh);
+
+#  ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#  endif
+}
+
 static void rna_Mesh_free_normals_split(Mesh *mesh)
 {
   CustomData_free_layers(&mesh->ldata, CD_NORMAL, mesh->totloop);
@@ -82,12 +100,20 @@ static void rna_Mesh_calc_tangents(Mesh *mesh, ReportList *reports, const char *
     CustomData_set_layer_flag(&mesh->ldata, CD_MLOOPTANGENT, CD_FLAG_TEMPORARY);
   }
 
+#  ifdef WITH_PYTHON
+  BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
   /* Compute loop normals if needed. */
   if (!CustomData_has_layer(&mesh->ldata, CD_NORMAL)) {
     BKE_mesh_calc_normals_split(mesh);
   }
 
   BKE_mesh_calc_loop_tangent_single(mesh, uvmap, r_looptangents, reports);
+
+#  ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#  endif
 }
 
 static void rna_Mesh_free_tangents(Mesh *mesh)
@@ -97,7 +123,15 @@ static void rna_Mesh_free_tangents(Mesh *mesh)
 
 static void rna_Mesh_calc_looptri(Mesh *mesh)
 {
+#  ifdef WITH_PYTHON
+  BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
   BKE_mesh_runtime_looptri_ensure(mesh);
+
+#  ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#  endif
 }
 
 static void rna_Mesh_calc_smooth_groups(
@@ -237,7 +271,7 @@ void RNA_api_mesh(StructRNA *srna)
   func = RNA_def_function(srna, "create_normals_split", "rna_Mesh_create_normals_split");
   RNA_def_function_ui_description(func, "Empty split vertex normals");
 
-  func = RNA_def_function(srna, "calc_normals_split", "BKE_mesh_calc_normals_split");
+  func = RNA_def_function(srna, "calc_normals_split", "rna_Mesh_calc_normals_split");
   RNA_def_function_ui_description(func,
                                   "Calculate split vertex normals, which preserve sharp edges");
 
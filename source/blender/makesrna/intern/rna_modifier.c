@@ -2726,6 +2726,15 @@ static void rna_def_modifier_array(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Merge Vertices", "Merge vertices in first and last duplicates");
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_property(srna, "use_instances", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", MOD_ARR_INSTANCES);
+  RNA_def_property_ui_text(prop,
+                           "Instances",
+                           "Draw and render the duplicates as instances of the first one instead "
+                           "of copying the geometry, used when the array is the last modifier "
+                           "and there is no merging, caps or UV offset");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   prop = RNA_def_property(srna, "merge_threshold", PROP_FLOAT, PROP_DISTANCE);
   RNA_def_property_float_sdna(prop, NULL, "merge_dist");
   RNA_def_property_range(prop, 0, FLT_MAX);
@@ -815,6 +815,14 @@ static void rna_def_render_engine(BlenderRNA *brna)
   prop = RNA_def_property(srna, "use_highlight_tiles", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "flag", RE_ENGINE_HIGHLIGHT_TILES);
 
+  prop = RNA_def_property(srna, "use_save_buffers", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", RE_ENGINE_SAVE_BUFFERS);
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(prop,
+                           "Save Buffers",
+                           "Tiles are saved to files in the temp directory during rendering, "
+                           "as requested or because of the memory limit");
+
   func = RNA_def_function(srna, "register_pass", "RE_engine_register_pass");
   RNA_def_function_ui_description(
       func, "Register a render pass that will be part of the render with the current settings");
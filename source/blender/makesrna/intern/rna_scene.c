@@ -86,8 +86,7 @@ const EnumPropertyItem rna_enum_exr_codec_items[] = {
     {R_IMF_EXR_CODEC_B44, "B44", 0, "B44 (lossy)", ""},
     {R_IMF_EXR_CODEC_B44A, "B44A", 0, "B44A (lossy)", ""},
     {R_IMF_EXR_CODEC_DWAA, "DWAA", 0, "DWAA (lossy)", ""},
-    /* NOTE: Commented out for until new OpenEXR is released, see T50673. */
-    /* {R_IMF_EXR_CODEC_DWAB, "DWAB", 0, "DWAB (lossy)", ""}, */
+    {R_IMF_EXR_CODEC_DWAB, "DWAB", 0, "DWAB (lossy)", ""},
     {0, NULL, 0, NULL, NULL},
 };
 #endif
@@ -1422,18 +1421,18 @@ static const EnumPropertyItem *rna_ImageFormatSettings_exr_codec_itemf(bContext
   ImageFormatData *imf = (ImageFormatData *)ptr->data;
 
   EnumPropertyItem *item = NULL;
-  int i = 1, totitem = 0;
+  int totitem = 0;
 
   if (imf->depth == 16) {
     return rna_enum_exr_codec_items; /* All compression types are defined for halfs */
   }
 
-  for (i = 0; i < R_IMF_EXR_CODEC_MAX; i++) {
-    if ((i == R_IMF_EXR_CODEC_B44 || i == R_IMF_EXR_CODEC_B44A)) {
+  for (const EnumPropertyItem *codec = rna_enum_exr_codec_items; codec->identifier; codec++) {
+    if (ELEM(codec->value, R_IMF_EXR_CODEC_B44, R_IMF_EXR_CODEC_B44A)) {
       continue; /* B44 and B44A are not defined for 32 bit floats */
     }
 
-    RNA_enum_item_add(&item, &totitem, &rna_enum_exr_codec_items[i]);
+    RNA_enum_item_add(&item, &totitem, codec);
   }
 
   RNA_enum_item_end(&item, &totitem);
@@ -5856,6 +5855,17 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
       "(saves memory, required for Full Sample)");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
 
+  prop = RNA_def_property(srna, "save_buffers_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "save_buffers_memory_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 65536, 1024, -1);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Save Buffers Memory Limit",
+                           "Save buffers automatically when the full frame render result would "
+                           "use more than this amount of memory in megabytes (0 to disable)");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
   prop = RNA_def_property(srna, "use_full_sample", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "scemode", R_FULL_SAMPLE);
   RNA_def_property_ui_text(prop,
@@ -4721,6 +4721,13 @@ static void rna_def_userdef_edit(BlenderRNA *brna)
       "Global undo works by keeping a full copy of the file itself in memory, "
       "so takes extra memory");
 
+  prop = RNA_def_property(srna, "use_global_undo_disk", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "uiflag", USER_GLOBALUNDO_DISK);
+  RNA_def_property_ui_text(prop,
+                           "Global Undo on Disk",
+                           "Move the oldest global undo steps to a temporary file "
+                           "when the undo memory limit is reached, instead of removing them");
+
   /* auto keyframing */
   prop = RNA_def_property(srna, "use_auto_keying", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "autokey_mode", AUTOKEY_ON);
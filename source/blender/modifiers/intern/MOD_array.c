@@ -349,6 +349,44 @@ static void mesh_merge_transform(Mesh *result,
   }
 }
 
+/**
+ * Instances are only used when there are no enabled modifiers after the array,
+ * these would otherwise only be applied to the first copy.
+ */
+static bool array_is_last_modifier(ArrayModifierData *amd, const ModifierEvalContext *ctx)
+{
+  Scene *scene = DEG_get_evaluated_scene(ctx->depsgraph);
+  const int required_mode = (ctx->flag & MOD_APPLY_RENDER) ? eModifierMode_Render :
+                                                              eModifierMode_Realtime;
+
+  for (ModifierData *md = amd->modifier.next; md; md = md->next) {
+    if (modifier_isEnabled(scene, md, required_mode)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Keep the mesh as the first copy, the others are drawn and rendered as instances of it. */
+static Mesh *arrayModifier_doInstances(Mesh *mesh, float offset[4][4], const int count)
+{
+  float(*instance_mats)[4][4] = MEM_malloc_arrayN(
+      (size_t)count - 1, sizeof(*instance_mats), __func__);
+  float current_offset[4][4];
+
+  unit_m4(current_offset);
+  for (int c = 1; c < count; c++) {
+    mul_m4_m4m4(current_offset, current_offset, offset);
+    copy_m4_m4(instance_mats[c - 1], current_offset);
+  }
+
+  MEM_SAFE_FREE(mesh->runtime.instance_mats);
+  mesh->runtime.instance_mats = instance_mats;
+  mesh->runtime.instance_mats_len = count - 1;
+
+  return mesh;
+}
+
 static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
                                    const ModifierEvalContext *ctx,
                                    Mesh *mesh)
@@ -374,6 +412,12 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
   const bool use_merge = (amd->flags & MOD_ARR_MERGE) != 0;
   const bool use_recalc_normals = (mesh->runtime.cd_dirty_vert & CD_MASK_NORMAL) || use_merge;
   const bool use_offset_ob = ((amd->offset_type & MOD_ARR_OFF_OBJ) && amd->offset_ob != NULL);
+  /* Instances can't differ from the first copy, and the object can't instance anything else. */
+  const bool use_instances = (amd->flags & MOD_ARR_INSTANCES) &&
+                             (ctx->flag & MOD_APPLY_INSTANCES) && !use_merge &&
+                             is_zero_v2(amd->uv_offset) &&
+                             (ctx->object->transflag & OB_DUPLI) == 0 &&
+                             array_is_last_modifier(amd, ctx);
 
   int start_cap_nverts = 0, start_cap_nedges = 0, start_cap_npolys = 0, start_cap_nloops = 0;
   int end_cap_nverts = 0, end_cap_nedges = 0, end_cap_npolys = 0, end_cap_nloops = 0;
@@ -493,6 +537,12 @@ static Mesh *arrayModifier_doArray(ArrayModifierData *amd,
     count = 1;
   }
 
+  if (use_instances && (count > 1) && (start_cap_mesh == NULL) && (end_cap_mesh == NULL)) {
+    MEM_SAFE_FREE(vgroup_start_cap_remap);
+    MEM_SAFE_FREE(vgroup_end_cap_remap);
+    return arrayModifier_doInstances(mesh, offset, count);
+  }
+
   /* The number of verts, edges, loops, polys, before eventually merging doubles */
   result_nverts = chunk_nverts * count + start_cap_nverts + end_cap_nverts;
   result_nedges = chunk_nedges * count + start_cap_nedges + end_cap_nedges;
@@ -126,6 +126,7 @@ static Mesh *applyModifier(ModifierData *md, const ModifierEvalContext *ctx, Mes
                                 .add_key_index = false,
                                 .use_shapekey = false,
                                 .active_shapekey = 0,
+                                .skip_shapekey_layers = true,
                                 /* XXX We probably can use CD_MASK_BAREMESH_ORIGDINDEX here instead
                                  * (also for other modifiers cases)? */
                                 .cd_mask_extra = {.vmask = CD_MASK_ORIGINDEX,
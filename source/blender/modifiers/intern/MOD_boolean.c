@@ -192,6 +192,7 @@ static Mesh *applyModifier(ModifierData *md, const ModifierEvalContext *ctx, Mes
                          mesh_other,
                          &((struct BMeshFromMeshParams){
                              .calc_face_normal = true,
+                             .skip_shapekey_layers = true,
                          }));
 
       if (UNLIKELY(is_flip)) {
@@ -207,6 +208,7 @@ static Mesh *applyModifier(ModifierData *md, const ModifierEvalContext *ctx, Mes
                          mesh,
                          &((struct BMeshFromMeshParams){
                              .calc_face_normal = true,
+                             .skip_shapekey_layers = true,
                          }));
 
       /* main bmesh intersection setup */
@@ -60,6 +60,7 @@ static Mesh *doEdgeSplit(Mesh *mesh, EdgeSplitModifierData *emd)
                                 .add_key_index = false,
                                 .use_shapekey = false,
                                 .active_shapekey = 0,
+                                .skip_shapekey_layers = true,
                                 .cd_mask_extra = {.vmask = CD_MASK_ORIGINDEX,
                                                   .emask = CD_MASK_ORIGINDEX,
                                                   .pmask = CD_MASK_ORIGINDEX},
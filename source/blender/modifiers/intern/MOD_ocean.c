@@ -143,9 +143,9 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
    * automatically when cached=true */
   tomd->oceancache = NULL;
 
+  /* Not simulated here, the modifier simulates the ocean before using it. */
   tomd->ocean = BKE_ocean_add();
   BKE_ocean_init_from_modifier(tomd->ocean, tomd);
-  simulate_ocean_modifier(tomd);
 #else  /* WITH_OCEANSIM */
   /* unused */
   (void)md;
@@ -21,6 +21,8 @@
  * \ingroup modifiers
  */
 
+#include <string.h>
+
 #include "BLI_utildefines.h"
 
 #include "BLI_math.h"
@@ -85,6 +87,17 @@ static void freeData(ModifierData *md)
   }
 }
 
+/* The mesh copied in the previous evaluation can be kept when its topology did not change,
+ * so its cached BVH tree is refitted to the new positions instead of being built again. */
+static bool surface_mesh_topology_equals(const Mesh *me_a, const Mesh *me_b)
+{
+  return (me_a->totvert == me_b->totvert && me_a->totedge == me_b->totedge &&
+          me_a->totpoly == me_b->totpoly && me_a->totloop == me_b->totloop &&
+          memcmp(me_a->medge, me_b->medge, sizeof(*me_a->medge) * (size_t)me_a->totedge) == 0 &&
+          memcmp(me_a->mpoly, me_b->mpoly, sizeof(*me_a->mpoly) * (size_t)me_a->totpoly) == 0 &&
+          memcmp(me_a->mloop, me_b->mloop, sizeof(*me_a->mloop) * (size_t)me_a->totloop) == 0);
+}
+
 static bool dependsOnTime(ModifierData *UNUSED(md))
 {
   return true;
@@ -105,12 +118,15 @@ static void deformVerts(ModifierData *md,
     MEM_SAFE_FREE(surmd->bvhtree);
   }
 
-  if (surmd->mesh) {
+  if (surmd->mesh && !(mesh && surface_mesh_topology_equals(surmd->mesh, mesh))) {
     BKE_id_free(NULL, surmd->mesh);
     surmd->mesh = NULL;
   }
 
-  if (mesh) {
+  if (surmd->mesh) {
+    /* Re-used, only the positions are updated below. */
+  }
+  else if (mesh) {
     /* Not possible to use get_mesh() in this case as we'll modify its vertices
      * and get_mesh() would return 'mesh' directly. */
     BKE_id_copy_ex(NULL, (ID *)mesh, (ID **)&surmd->mesh, LIB_ID_COPY_LOCALIZE);
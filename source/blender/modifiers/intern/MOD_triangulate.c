@@ -60,6 +60,7 @@ static Mesh *triangulate_mesh(Mesh *mesh,
                             &((struct BMeshCreateParams){0}),
                             &((struct BMeshFromMeshParams){
                                 .calc_face_normal = true,
+                                .skip_shapekey_layers = true,
                                 .cd_mask_extra = cddata_masks,
                             }));
 
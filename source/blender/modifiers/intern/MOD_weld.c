@@ -368,6 +368,16 @@ static void weld_assert_poly_len(const WeldPoly *wp, const WeldLoop *wloop)
 /** \name Weld Vert API
  * \{ */
 
+/* Root of the group of \a v, halving the path to it on the way. */
+static uint weld_vert_dest_find(uint *vert_dest_map, uint v)
+{
+  while (vert_dest_map[v] != v) {
+    vert_dest_map[v] = vert_dest_map[vert_dest_map[v]];
+    v = vert_dest_map[v];
+  }
+  return v;
+}
+
 static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
                                           const BVHTreeOverlap *overlap,
                                           const uint overlap_len,
@@ -381,6 +391,9 @@ static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
     *v_dest_iter = OUT_OF_CONTEXT;
   }
 
+  /* Join the groups of each overlapping pair (union-find), the vertex with the lowest index
+   * is the root of a group. The result doesn't depend on the order of the pairs,
+   * which isn't fixed when the overlap is calculated on multiple threads. */
   uint vert_kill_len = 0;
   const BVHTreeOverlap *overlap_iter = &overlap[0];
   for (uint i = 0; i < overlap_len; i++, overlap_iter++) {
@@ -389,46 +402,31 @@ static void weld_vert_ctx_alloc_and_setup(const uint mvert_len,
 
     BLI_assert(indexA < indexB);
 
-    uint va_dst = r_vert_dest_map[indexA];
-    uint vb_dst = r_vert_dest_map[indexB];
-    if (va_dst == OUT_OF_CONTEXT) {
-      if (vb_dst == OUT_OF_CONTEXT) {
-        vb_dst = indexA;
-        r_vert_dest_map[indexB] = vb_dst;
-      }
-      r_vert_dest_map[indexA] = vb_dst;
-      vert_kill_len++;
+    if (r_vert_dest_map[indexA] == OUT_OF_CONTEXT) {
+      r_vert_dest_map[indexA] = indexA;
     }
-    else if (vb_dst == OUT_OF_CONTEXT) {
-      r_vert_dest_map[indexB] = va_dst;
-      vert_kill_len++;
+    if (r_vert_dest_map[indexB] == OUT_OF_CONTEXT) {
+      r_vert_dest_map[indexB] = indexB;
     }
-    else if (va_dst != vb_dst) {
-      uint v_new, v_old;
+
+    const uint va_dst = weld_vert_dest_find(r_vert_dest_map, indexA);
+    const uint vb_dst = weld_vert_dest_find(r_vert_dest_map, indexB);
+    if (va_dst != vb_dst) {
       if (va_dst < vb_dst) {
-        v_new = va_dst;
-        v_old = vb_dst;
+        r_vert_dest_map[vb_dst] = va_dst;
       }
       else {
-        v_new = vb_dst;
-        v_old = va_dst;
+        r_vert_dest_map[va_dst] = vb_dst;
       }
-      BLI_assert(r_vert_dest_map[v_old] == v_old);
-      BLI_assert(r_vert_dest_map[v_new] == v_new);
       vert_kill_len++;
+    }
+  }
 
-      const BVHTreeOverlap *overlap_iter_b = &overlap[0];
-      for (uint j = i + 1; j--; overlap_iter_b++) {
-        indexA = overlap_iter_b->indexA;
-        indexB = overlap_iter_b->indexB;
-        va_dst = r_vert_dest_map[indexA];
-        vb_dst = r_vert_dest_map[indexB];
-        if (ELEM(v_old, vb_dst, va_dst)) {
-          r_vert_dest_map[indexA] = v_new;
-          r_vert_dest_map[indexB] = v_new;
-        }
-      }
-      BLI_assert(r_vert_dest_map[v_old] == v_new);
+  /* Point every vertex directly to the root of its group. */
+  v_dest_iter = &r_vert_dest_map[0];
+  for (uint i = 0; i < mvert_len; i++, v_dest_iter++) {
+    if (*v_dest_iter != OUT_OF_CONTEXT) {
+      *v_dest_iter = weld_vert_dest_find(r_vert_dest_map, i);
     }
   }
 
@@ -1668,7 +1666,8 @@ static Mesh *weldModifier_doWeld(WeldModifierData *wmd, const ModifierEvalContex
                                                    bvhtree_weld_overlap_cb,
                                                    &data,
                                                    wmd->max_interactions,
-                                                   BVH_OVERLAP_RETURN_PAIRS);
+                                                   BVH_OVERLAP_USE_THREADING |
+                                                       BVH_OVERLAP_RETURN_PAIRS);
 
   free_bvhtree_from_mesh(&treedata);
 
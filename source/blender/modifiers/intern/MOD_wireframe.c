@@ -70,6 +70,7 @@ static Mesh *WireframeModifier_do(WireframeModifierData *wmd, Object *ob, Mesh *
                                 .add_key_index = false,
                                 .use_shapekey = false,
                                 .active_shapekey = 0,
+                                .skip_shapekey_layers = true,
                                 .cd_mask_extra = {.vmask = CD_MASK_ORIGINDEX,
                                                   .emask = CD_MASK_ORIGINDEX,
                                                   .pmask = CD_MASK_ORIGINDEX},
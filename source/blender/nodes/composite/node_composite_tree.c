@@ -303,6 +303,11 @@ void ntreeCompositTagRender(Scene *curscene)
 {
   Scene *sce;
 
+#ifdef WITH_COMPOSITOR
+  /* The buffers calculated from the previous render result can't be used anymore. */
+  COM_clearCaches();
+#endif
+
   /* XXX Think using G_MAIN here is valid, since you want to update current file's scene nodes,
    * not the ones in temp main generated for rendering?
    * This is still rather weak though,
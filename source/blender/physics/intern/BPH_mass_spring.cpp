@@ -33,6 +33,7 @@ extern "C" {
 
 #include "BLI_math.h"
 #include "BLI_linklist.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_cloth.h"
@@ -502,6 +503,43 @@ static void hair_get_boundbox(ClothModifierData *clmd, float gmin[3], float gmax
   }
 }
 
+#ifdef CLOTH_FORCE_GRAVITY
+typedef struct ClothCalcVertForceData {
+  ClothModifierData *clmd;
+  Implicit_Data *data;
+  const float *gravity;
+  float time;
+} ClothCalcVertForceData;
+
+/* Only writes the forces and diagonal jacobian blocks of the vertex itself. */
+static void cloth_calc_vert_force_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ClothCalcVertForceData *data = (ClothCalcVertForceData *)userdata;
+  ClothModifierData *clmd = data->clmd;
+  ClothVertex *vert = &clmd->clothObject->verts[i];
+
+  BPH_mass_spring_force_gravity(data->data, i, vert->mass, data->gravity);
+
+  /* Vertex goal springs */
+  if ((!(vert->flags & CLOTH_VERT_FLAG_PINNED)) && (vert->goal > FLT_EPSILON)) {
+    float goal_x[3], goal_v[3];
+    float k;
+
+    /* divide by time_scale to prevent goal vertices' delta locations from being multiplied */
+    interp_v3_v3v3(goal_x, vert->xold, vert->xconst, data->time / clmd->sim_parms->time_scale);
+    sub_v3_v3v3(goal_v, vert->xconst, vert->xold); /* distance covered over dt==1 */
+
+    k = vert->goal * clmd->sim_parms->goalspring /
+        (clmd->sim_parms->avg_spring_len + FLT_EPSILON);
+
+    BPH_mass_spring_force_spring_goal(
+        data->data, i, goal_x, goal_v, k, clmd->sim_parms->goalfrict * 0.01f);
+  }
+}
+#endif
+
 static void cloth_calc_force(
     Scene *scene, ClothModifierData *clmd, float UNUSED(frame), ListBase *effectors, float time)
 {
@@ -525,26 +563,16 @@ static void cloth_calc_force(
                 0.001f * clmd->sim_parms->effector_weights->global_gravity);
   }
 
-  vert = cloth->verts;
-  for (i = 0; i < cloth->mvert_num; i++, vert++) {
-    BPH_mass_spring_force_gravity(data, i, vert->mass, gravity);
-
-    /* Vertex goal springs */
-    if ((!(vert->flags & CLOTH_VERT_FLAG_PINNED)) && (vert->goal > FLT_EPSILON)) {
-      float goal_x[3], goal_v[3];
-      float k;
+  ClothCalcVertForceData vert_force_data;
+  vert_force_data.clmd = clmd;
+  vert_force_data.data = data;
+  vert_force_data.gravity = gravity;
+  vert_force_data.time = time;
 
-      /* divide by time_scale to prevent goal vertices' delta locations from being multiplied */
-      interp_v3_v3v3(goal_x, vert->xold, vert->xconst, time / clmd->sim_parms->time_scale);
-      sub_v3_v3v3(goal_v, vert->xconst, vert->xold); /* distance covered over dt==1 */
-
-      k = vert->goal * clmd->sim_parms->goalspring /
-          (clmd->sim_parms->avg_spring_len + FLT_EPSILON);
-
-      BPH_mass_spring_force_spring_goal(
-          data, i, goal_x, goal_v, k, clmd->sim_parms->goalfrict * 0.01f);
-    }
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (mvert_num > 10000);
+  BLI_task_parallel_range(0, mvert_num, &vert_force_data, cloth_calc_vert_force_cb, &settings);
 #endif
 
   /* cloth_calc_volume_force(clmd); */
@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -50,6 +51,9 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Minimum number of vertices to multiply the rows of big matrices in parallel. */
+#  define CLOTH_PARALLEL_LIMIT 1024
+
 //#define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -607,31 +611,124 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
+/* For every vertex, the off-diagonal blocks of a big matrix in its row or column, in the order
+ * of the matrix. Lets the rows of a product be computed independently, giving the same result
+ * as the sequential multiplication. */
+typedef struct BFMatrixVertBlocks {
+  unsigned int *offsets; /* start of the blocks of each vertex, vcount + 1 items */
+  unsigned int *blocks;
+} BFMatrixVertBlocks;
+
+/* Only the first num_blocks off-diagonal blocks are used, the others are zero. */
+static void bfmatrix_vert_blocks_init(BFMatrixVertBlocks *vert_blocks,
+                                      fmatrix3x3 *matrix,
+                                      unsigned int num_blocks)
+{
+  unsigned int vcount = matrix[0].vcount;
+  unsigned int *offsets = MEM_callocN(sizeof(*offsets) * (vcount + 1), __func__);
+  unsigned int *blocks = MEM_mallocN(sizeof(*blocks) * max_ii(2 * num_blocks, 1), __func__);
+  unsigned int *cursor = MEM_mallocN(sizeof(*cursor) * vcount, __func__);
+  unsigned int i;
+
+  for (i = vcount; i < vcount + num_blocks; i++) {
+    offsets[matrix[i].r + 1]++;
+    if (matrix[i].c != matrix[i].r) {
+      offsets[matrix[i].c + 1]++;
+    }
+  }
+  for (i = 0; i < vcount; i++) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  memcpy(cursor, offsets, sizeof(*cursor) * vcount);
+  for (i = vcount; i < vcount + num_blocks; i++) {
+    blocks[cursor[matrix[i].r]++] = i;
+    if (matrix[i].c != matrix[i].r) {
+      blocks[cursor[matrix[i].c]++] = i;
+    }
+  }
+  MEM_freeN(cursor);
+
+  vert_blocks->offsets = offsets;
+  vert_blocks->blocks = blocks;
+}
+
+static void bfmatrix_vert_blocks_free(BFMatrixVertBlocks *vert_blocks)
+{
+  MEM_SAFE_FREE(vert_blocks->offsets);
+  MEM_SAFE_FREE(vert_blocks->blocks);
+}
+
+typedef struct MulBFMatrixLFVectorData {
+  float (*to)[3];
+  fmatrix3x3 *from;
+  lfVector *fLongVector;
+  const BFMatrixVertBlocks *vert_blocks;
+} MulBFMatrixLFVectorData;
+
+static void mul_bfmatrix_lfvector_cb(void *__restrict userdata,
+                                     const int i,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MulBFMatrixLFVectorData *data = (MulBFMatrixLFVectorData *)userdata;
+  fmatrix3x3 *from = data->from;
+  lfVector *fLongVector = data->fLongVector;
+  const BFMatrixVertBlocks *vert_blocks = data->vert_blocks;
+  float lower[3] = {0.0f, 0.0f, 0.0f};
+  float upper[3] = {0.0f, 0.0f, 0.0f};
+
+  muladd_fmatrix_fvector(upper, from[i].m, fLongVector[i]);
+
+  for (unsigned int j = vert_blocks->offsets[i]; j < vert_blocks->offsets[i + 1]; j++) {
+    fmatrix3x3 *block = &from[vert_blocks->blocks[j]];
+    /* Same as the sequential multiplication, the lower triangle uses transposed submatrices. */
+    if (block->c == (unsigned int)i) {
+      muladd_fmatrixT_fvector(lower, block->m, fLongVector[block->r]);
+    }
+    if (block->r == (unsigned int)i) {
+      muladd_fmatrix_fvector(upper, block->m, fLongVector[block->c]);
+    }
+  }
+
+  add_v3_v3v3(data->to[i], lower, upper);
+}
+
 /* SPARSE SYMMETRIC multiply big matrix with long vector*/
 /* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+/* vert_blocks: when not NULL, the rows are multiplied in parallel. */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     fmatrix3x3 *from,
+                                     lfVector *fLongVector,
+                                     const BFMatrixVertBlocks *vert_blocks)
 {
   unsigned int vcount = from[0].vcount;
+
+  if (vert_blocks != NULL) {
+    MulBFMatrixLFVectorData data = {
+        .to = to,
+        .from = from,
+        .fLongVector = fLongVector,
+        .vert_blocks = vert_blocks,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 256;
+    BLI_task_parallel_range(0, (int)vcount, &data, mul_bfmatrix_lfvector_cb, &settings);
+    return;
+  }
+
   lfVector *temp = create_lfvector(vcount);
 
   zero_lfvector(to, vcount);
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (unsigned int i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed submatrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
-    }
-#  pragma omp section
-    {
-      for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
-    }
+  for (unsigned int i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
+    /* This is the lower triangle of the sparse matrix,
+     * therefore multiplication occurs with transposed submatrices. */
+    muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
+  }
+  for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
+    muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
   }
   add_lfvector_lfvector(to, to, temp, from[0].vcount);
 
@@ -791,7 +888,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
   // r = B - Mul(tmp, A, X);    // just use B if X known to be zero
   cp_lfvector(r, lB, numverts);
-  mul_bfmatrix_lfvector(tmp, lA, ldV);
+  mul_bfmatrix_lfvector(tmp, lA, ldV, NULL);
   sub_lfvector_lfvector(r, r, tmp, numverts);
 
   filter(r, S);
@@ -803,7 +900,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
   while (s > starget && conjgrad_loopcount < conjgrad_looplimit) {
     // Mul(q, A, d); // q = A*d;
-    mul_bfmatrix_lfvector(q, lA, d);
+    mul_bfmatrix_lfvector(q, lA, d, NULL);
 
     filter(q, S);
 
@@ -843,6 +940,7 @@ static int cg_filtered(lfVector *ldV,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
+                       const BFMatrixVertBlocks *vert_blocks,
                        ImplicitSolverResult *result)
 {
   // Solves for unknown X in equation AX=B
@@ -867,7 +965,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, ldV, vert_blocks);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -890,7 +988,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector(q, lA, c, vert_blocks);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -971,7 +1069,7 @@ static int cg_filtered_pre(lfVector *dv,
   filter(dv, S);
   add_lfvector_lfvector(dv, dv, z, numverts);
 
-  mul_bfmatrix_lfvector(r, lA, dv);
+  mul_bfmatrix_lfvector(r, lA, dv, NULL);
   sub_lfvector_lfvector(r, lB, r, numverts);
   filter(r, S);
 
@@ -989,7 +1087,7 @@ static int cg_filtered_pre(lfVector *dv,
   while ((deltaNew > delta0) && (iterations < conjgrad_looplimit)) {
     iterations++;
 
-    mul_bfmatrix_lfvector(s, lA, p);
+    mul_bfmatrix_lfvector(s, lA, p, NULL);
     filter(s, S);
 
     alpha = deltaNew / dot_lfvector(p, s, numverts);
@@ -1055,12 +1153,12 @@ static int cg_filtered_pre(lfVector *dv,
   add_lfvector_lfvector(dv, dv, z, numverts);
 
   // b_hat = S(b-A(I-S)z)
-  mul_bfmatrix_lfvector(r, lA, z);
-  mul_bfmatrix_lfvector(bhat, bigI, r);
+  mul_bfmatrix_lfvector(r, lA, z, NULL);
+  mul_bfmatrix_lfvector(bhat, bigI, r, NULL);
   sub_lfvector_lfvector(bhat, lB, bhat, numverts);
 
   // r = S(b-Ax)
-  mul_bfmatrix_lfvector(r, lA, dv);
+  mul_bfmatrix_lfvector(r, lA, dv, NULL);
   sub_lfvector_lfvector(r, lB, r, numverts);
   filter(r, S);
 
@@ -1079,7 +1177,7 @@ static int cg_filtered_pre(lfVector *dv,
   filter(dv, S);
   add_lfvector_lfvector(dv, dv, z, numverts);
 
-  mul_bfmatrix_lfvector(r, lA, dv);
+  mul_bfmatrix_lfvector(r, lA, dv, NULL);
   sub_lfvector_lfvector(r, lB, r, numverts);
   filter(r, S);
 
@@ -1100,7 +1198,7 @@ static int cg_filtered_pre(lfVector *dv,
   while ((deltaNew > delta0 * tol * tol) && (iterations < conjgrad_looplimit)) {
     iterations++;
 
-    mul_bfmatrix_lfvector(s, lA, p);
+    mul_bfmatrix_lfvector(s, lA, p, NULL);
     filter(s, S);
 
     alpha = deltaNew / dot_lfvector(p, s, numverts);
@@ -1142,6 +1240,7 @@ static int cg_filtered_pre(lfVector *dv,
 bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSolverResult *result)
 {
   unsigned int numverts = data->dFdV[0].vcount;
+  BFMatrixVertBlocks vert_blocks_data, *vert_blocks = NULL;
 
   lfVector *dFdXmV = create_lfvector(numverts);
   zero_lfvector(data->dV, numverts);
@@ -1150,7 +1249,13 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* All big matrices share the blocks of the springs added since the forces were cleared. */
+  if (numverts > CLOTH_PARALLEL_LIMIT) {
+    bfmatrix_vert_blocks_init(&vert_blocks_data, data->A, (unsigned int)data->num_blocks);
+    vert_blocks = &vert_blocks_data;
+  }
+
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V, vert_blocks);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1159,7 +1264,7 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, data->B, data->z, data->S, vert_blocks, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -1172,6 +1277,9 @@ bool BPH_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
   add_lfvector_lfvector(data->Vnew, data->V, data->dV, numverts);
 
   del_lfvector(dFdXmV);
+  if (vert_blocks != NULL) {
+    bfmatrix_vert_blocks_free(vert_blocks);
+  }
 
   return result->status == BPH_SOLVER_SUCCESS;
 }
@@ -27,10 +27,16 @@
 #include "BLI_utildefines.h"
 #include "BLI_string.h"
 
+#include "DNA_ID.h"
+
 #include "BKE_appdir.h"
 #include "BKE_global.h" /* XXX, G_MAIN only */
 #include "BKE_blender_version.h"
 #include "BKE_bpath.h"
+#include "BKE_library.h"
+#include "BKE_main.h"
+
+#include "MEM_guardedalloc.h"
 
 #include "RNA_types.h"
 #include "RNA_access.h"
@@ -289,6 +295,63 @@ static PyObject *bpy_escape_identifier(PyObject *UNUSED(self), PyObject *value)
   return value_escape;
 }
 
+static void bpy_memory_usage_dict_set(PyObject *dict, PyObject *key, size_t value)
+{
+  PyObject *item = PyLong_FromSize_t(value);
+  PyDict_SetItem(dict, key, item);
+  Py_DECREF(item);
+}
+
+PyDoc_STRVAR(bpy_memory_usage_doc,
+             ".. function:: memory_usage()\n"
+             "\n"
+             "   Returns the memory in use, in bytes.\n"
+             "\n"
+             "   - ``total``: All the memory in use.\n"
+             "   - ``peak``: The peak of the memory in use.\n"
+             "   - ``categories``: The memory in use per category name "
+             "(mesh data, undo, draw cache, images, evaluated copies...).\n"
+             "   - ``ids``: The memory used by each data-block of the loaded .blend file, "
+             "with its large data (geometry, image buffers...).\n"
+             "\n"
+             "   :return: dictionary with the ``total``, ``peak``, ``categories`` and ``ids`` "
+             "keys.\n"
+             "   :rtype: dict\n");
+static PyObject *bpy_memory_usage(PyObject *UNUSED(self))
+{
+  PyObject *ret = PyDict_New();
+  PyObject *item;
+
+  item = PyUnicode_FromString("total");
+  bpy_memory_usage_dict_set(ret, item, MEM_get_memory_in_use());
+  Py_DECREF(item);
+  item = PyUnicode_FromString("peak");
+  bpy_memory_usage_dict_set(ret, item, MEM_get_peak_memory());
+  Py_DECREF(item);
+
+  PyObject *categories = PyDict_New();
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    item = PyUnicode_FromString(MEM_category_name((eMEMCategory)i));
+    bpy_memory_usage_dict_set(categories, item, MEM_get_memory_in_use_category((eMEMCategory)i));
+    Py_DECREF(item);
+  }
+  PyDict_SetItemString(ret, "categories", categories);
+  Py_DECREF(categories);
+
+  PyObject *ids = PyDict_New();
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (G_MAIN, id) {
+    item = pyrna_id_CreatePyObject(id);
+    bpy_memory_usage_dict_set(ids, item, BKE_id_memory_usage(id));
+    Py_DECREF(item);
+  }
+  FOREACH_MAIN_ID_END;
+  PyDict_SetItemString(ret, "ids", ids);
+  Py_DECREF(ids);
+
+  return ret;
+}
+
 static PyMethodDef meth_bpy_script_paths = {
     "script_paths",
     (PyCFunction)bpy_script_paths,
@@ -325,6 +388,12 @@ static PyMethodDef meth_bpy_escape_identifier = {
     METH_O,
     bpy_escape_identifier_doc,
 };
+static PyMethodDef meth_bpy_memory_usage = {
+    "memory_usage",
+    (PyCFunction)bpy_memory_usage,
+    METH_NOARGS,
+    bpy_memory_usage_doc,
+};
 
 static PyObject *bpy_import_test(const char *modname)
 {
@@ -427,6 +496,9 @@ void BPy_init_modules(void)
   PyModule_AddObject(mod,
                      meth_bpy_escape_identifier.ml_name,
                      (PyObject *)PyCFunction_New(&meth_bpy_escape_identifier, NULL));
+  PyModule_AddObject(mod,
+                     meth_bpy_memory_usage.ml_name,
+                     (PyObject *)PyCFunction_New(&meth_bpy_memory_usage, NULL));
 
   /* register funcs (bpy_rna.c) */
   PyModule_AddObject(mod,
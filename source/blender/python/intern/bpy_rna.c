@@ -5240,6 +5240,48 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * The raw type of the items of a buffer which doesn't match the attribute,
+ * so RNA can convert them instead of going through a Python object for every item.
+ * Only conversions between integer or between floating point types are supported.
+ */
+static RawPropertyType foreach_buffer_raw_type(const Py_buffer *buf, RawPropertyType raw_type)
+{
+  char f = buf->format ? *buf->format : 'B'; /* B is assumed when not set */
+  const bool is_float = ELEM(raw_type, PROP_RAW_FLOAT, PROP_RAW_DOUBLE);
+  RawPropertyType buf_type = PROP_RAW_UNSET;
+
+  switch (f) {
+    case 'b':
+    case 'B':
+      buf_type = PROP_RAW_CHAR;
+      break;
+    case 'h':
+    case 'H':
+      buf_type = PROP_RAW_SHORT;
+      break;
+    case 'i':
+    case 'I':
+      buf_type = PROP_RAW_INT;
+      break;
+    case '?':
+      buf_type = PROP_RAW_BOOLEAN;
+      break;
+    case 'f':
+      buf_type = PROP_RAW_FLOAT;
+      break;
+    case 'd':
+      buf_type = PROP_RAW_DOUBLE;
+      break;
+  }
+
+  if (buf_type == PROP_RAW_UNSET || buf->itemsize != RNA_raw_type_sizeof(buf_type) ||
+      ELEM(buf_type, PROP_RAW_FLOAT, PROP_RAW_DOUBLE) != is_float) {
+    return PROP_RAW_UNSET;
+  }
+  return buf_type;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5277,6 +5319,14 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_set(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        const RawPropertyType buf_type = foreach_buffer_raw_type(&buf, raw_type);
+        if (buf_type != PROP_RAW_UNSET && buf.len == (Py_ssize_t)tot * buf.itemsize) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_set(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_type, tot);
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -5333,6 +5383,14 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_get(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        const RawPropertyType buf_type = foreach_buffer_raw_type(&buf, raw_type);
+        if (buf_type != PROP_RAW_UNSET && buf.len == (Py_ssize_t)tot * buf.itemsize) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_get(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_type, tot);
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -67,6 +67,7 @@ struct bNodeTree;
 #define RE_ENGINE_RENDERING 16
 #define RE_ENGINE_HIGHLIGHT_TILES 32
 #define RE_ENGINE_USED_FOR_VIEWPORT 64
+#define RE_ENGINE_SAVE_BUFFERS 128
 
 extern ListBase R_engines;
 
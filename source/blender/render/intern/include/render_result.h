@@ -86,6 +86,7 @@ void render_result_single_layer_end(struct Render *re);
 /* EXR Tile File Render */
 
 void render_result_save_empty_result_tiles(struct Render *re);
+size_t render_result_estimate_memory(struct Render *re, struct RenderEngine *engine);
 void render_result_exr_file_begin(struct Render *re, struct RenderEngine *engine);
 void render_result_exr_file_end(struct Render *re, struct RenderEngine *engine);
 
@@ -66,6 +66,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -308,70 +309,137 @@ static void barycentric_differentials_from_position(const float co[3],
   }
 }
 
+/* Number of pixels whose rays are cast together, limits the memory used for the rays. */
+#define BAKE_RAYS_CHUNK_SIZE (1 << 14)
+
+typedef struct BakeRays {
+  int len;
+  /* Ray of each pixel, in world space. */
+  float (*co)[3];
+  float (*dir)[3];
+  /* Ray transformed to the space of a highpoly object. */
+  float (*co_high)[3];
+  float (*dir_high)[3];
+  BVHTreeRayHit *hits_high;
+  /* Nearest hit among all highpoly objects, in the space of the object hit. */
+  BVHTreeRayHit *hits;
+  int *hit_mesh;
+  float *hit_distance;
+  /* Pixel and low poly triangle each ray starts from. */
+  size_t *pixel_id;
+  TriTessFace **triangle_low;
+} BakeRays;
+
+static void bake_rays_init(BakeRays *rays)
+{
+  const size_t size = BAKE_RAYS_CHUNK_SIZE;
+  rays->len = 0;
+  rays->co = MEM_mallocN(sizeof(*rays->co) * size, __func__);
+  rays->dir = MEM_mallocN(sizeof(*rays->dir) * size, __func__);
+  rays->co_high = MEM_mallocN(sizeof(*rays->co_high) * size, __func__);
+  rays->dir_high = MEM_mallocN(sizeof(*rays->dir_high) * size, __func__);
+  rays->hits_high = MEM_mallocN(sizeof(*rays->hits_high) * size, __func__);
+  rays->hits = MEM_mallocN(sizeof(*rays->hits) * size, __func__);
+  rays->hit_mesh = MEM_mallocN(sizeof(*rays->hit_mesh) * size, __func__);
+  rays->hit_distance = MEM_mallocN(sizeof(*rays->hit_distance) * size, __func__);
+  rays->pixel_id = MEM_mallocN(sizeof(*rays->pixel_id) * size, __func__);
+  rays->triangle_low = MEM_mallocN(sizeof(*rays->triangle_low) * size, __func__);
+}
+
+static void bake_rays_free(BakeRays *rays)
+{
+  MEM_freeN(rays->co);
+  MEM_freeN(rays->dir);
+  MEM_freeN(rays->co_high);
+  MEM_freeN(rays->dir_high);
+  MEM_freeN(rays->hits_high);
+  MEM_freeN(rays->hits);
+  MEM_freeN(rays->hit_mesh);
+  MEM_freeN(rays->hit_distance);
+  MEM_freeN(rays->pixel_id);
+  MEM_freeN(rays->triangle_low);
+}
+
 /**
- * This function populates pixel_array and returns TRUE if things are correct
+ * Cast all the rays against every highpoly object, keeping the hit nearest to the ray start.
  */
-static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
-                              TriTessFace *triangle_low,
-                              TriTessFace *triangles[],
-                              BakePixel *pixel_array_low,
-                              BakePixel *pixel_array,
-                              const float mat_low[4][4],
-                              BakeHighPolyData *highpoly,
-                              const float co[3],
-                              const float dir[3],
-                              const int pixel_id,
-                              const int tot_highpoly)
+static void cast_rays_highpoly(BVHTreeFromMesh *treeData,
+                               BakeHighPolyData *highpoly,
+                               const int tot_highpoly,
+                               BakeRays *rays)
 {
-  int i;
-  int hit_mesh = -1;
-  float hit_distance = FLT_MAX;
+  int i, j;
 
-  BVHTreeRayHit *hits;
-  hits = MEM_mallocN(sizeof(BVHTreeRayHit) * tot_highpoly, "Bake Highpoly to Lowpoly: BVH Rays");
+  for (j = 0; j < rays->len; j++) {
+    rays->hit_mesh[j] = -1;
+    rays->hit_distance[j] = FLT_MAX;
+  }
 
   for (i = 0; i < tot_highpoly; i++) {
-    float co_high[3], dir_high[3];
-
-    hits[i].index = -1;
-    /* TODO: we should use FLT_MAX here, but sweepsphere code isn't prepared for that */
-    hits[i].dist = BVH_RAYCAST_DIST_MAX;
+    if (treeData[i].tree == NULL) {
+      continue;
+    }
 
-    /* transform the ray from the world space to the highpoly space */
-    mul_v3_m4v3(co_high, highpoly[i].imat, co);
+    for (j = 0; j < rays->len; j++) {
+      /* transform the ray from the world space to the highpoly space */
+      mul_v3_m4v3(rays->co_high[j], highpoly[i].imat, rays->co[j]);
 
-    /* rotates */
-    mul_v3_mat3_m4v3(dir_high, highpoly[i].imat, dir);
-    normalize_v3(dir_high);
+      /* rotates */
+      mul_v3_mat3_m4v3(rays->dir_high[j], highpoly[i].imat, rays->dir[j]);
+      normalize_v3(rays->dir_high[j]);
 
-    /* cast ray */
-    if (treeData[i].tree) {
-      BLI_bvhtree_ray_cast(treeData[i].tree,
-                           co_high,
-                           dir_high,
-                           0.0f,
-                           &hits[i],
-                           treeData[i].raycast_callback,
-                           &treeData[i]);
+      rays->hits_high[j].index = -1;
+      /* TODO: we should use FLT_MAX here, but sweepsphere code isn't prepared for that */
+      rays->hits_high[j].dist = BVH_RAYCAST_DIST_MAX;
     }
 
-    if (hits[i].index != -1) {
-      float distance;
-      float hit_world[3];
-
-      /* distance comparison in world space */
-      mul_v3_m4v3(hit_world, highpoly[i].obmat, hits[i].co);
-      distance = len_squared_v3v3(hit_world, co);
-
-      if (distance < hit_distance) {
-        hit_mesh = i;
-        hit_distance = distance;
+    /* cast rays */
+    BLI_bvhtree_ray_cast_batch(treeData[i].tree,
+                               rays->co_high,
+                               rays->dir_high,
+                               rays->len,
+                               0.0f,
+                               rays->hits_high,
+                               treeData[i].raycast_callback,
+                               &treeData[i],
+                               BVH_RAYCAST_DEFAULT);
+
+    for (j = 0; j < rays->len; j++) {
+      if (rays->hits_high[j].index != -1) {
+        float distance;
+        float hit_world[3];
+
+        /* distance comparison in world space */
+        mul_v3_m4v3(hit_world, highpoly[i].obmat, rays->hits_high[j].co);
+        distance = len_squared_v3v3(hit_world, rays->co[j]);
+
+        if (distance < rays->hit_distance[j]) {
+          rays->hit_mesh[j] = i;
+          rays->hit_distance[j] = distance;
+          rays->hits[j] = rays->hits_high[j];
+        }
       }
     }
   }
+}
 
+/**
+ * This function populates pixel_array from the nearest hit of the pixel's ray (see
+ * #cast_rays_highpoly) and returns TRUE if there was a hit.
+ */
+static bool bake_pixel_from_highpoly_hit(TriTessFace *triangle_low,
+                                         TriTessFace *triangles[],
+                                         BakePixel *pixel_array_low,
+                                         BakePixel *pixel_array,
+                                         const float mat_low[4][4],
+                                         BakeHighPolyData *highpoly,
+                                         const float dir[3],
+                                         const size_t pixel_id,
+                                         const int hit_mesh,
+                                         const BVHTreeRayHit *hit)
+{
   if (hit_mesh != -1) {
-    int primitive_id_high = hits[hit_mesh].index;
+    int primitive_id_high = hit->index;
     TriTessFace *triangle_high = &triangles[hit_mesh][primitive_id_high];
     BakePixel *pixel_low = &pixel_array_low[pixel_id];
     BakePixel *pixel_high = &pixel_array[pixel_id];
@@ -407,7 +475,7 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
     madd_v3_v3fl(dyco, tmp, -dot_v3v3(dyco, triangle_high->normal));
 
     /* compute barycentric differentials from position differentials */
-    barycentric_differentials_from_position(hits[hit_mesh].co,
+    barycentric_differentials_from_position(hit->co,
                                             triangle_high->mverts[0]->co,
                                             triangle_high->mverts[1]->co,
                                             triangle_high->mverts[2]->co,
@@ -431,7 +499,6 @@ static bool cast_ray_highpoly(BVHTreeFromMesh *treeData,
     pixel_array[pixel_id].object_id = -1;
   }
 
-  MEM_freeN(hits);
   return hit_mesh != -1;
 }
 
@@ -512,6 +579,130 @@ static TriTessFace *mesh_calc_tri_tessface(Mesh *me, bool tangent, Mesh *me_eval
   return triangles;
 }
 
+typedef struct BakeHighpolyPopulateData {
+  BakePixel *pixel_array_from;
+  BakePixel *pixel_array_to;
+  size_t num_pixels;
+  BakeHighPolyData *highpoly;
+  int tot_highpoly;
+  BVHTreeFromMesh *treeData;
+  TriTessFace **tris_high;
+  TriTessFace *tris_low;
+  TriTessFace *tris_cage;
+  bool is_custom_cage;
+  bool is_cage;
+  float cage_extrusion;
+  float (*mat_low)[4];
+  float (*imat_low)[4];
+  float (*mat_cage)[4];
+} BakeHighpolyPopulateData;
+
+static void bake_highpoly_populate_cb(void *__restrict userdata,
+                                      const int chunk,
+                                      const TaskParallelTLS *__restrict tls)
+{
+  const BakeHighpolyPopulateData *data = userdata;
+  BakeRays *rays = tls->userdata_chunk;
+  BakePixel *pixel_array_from = data->pixel_array_from;
+  BakePixel *pixel_array_to = data->pixel_array_to;
+  const size_t pixel_start = (size_t)chunk * BAKE_RAYS_CHUNK_SIZE;
+  const size_t pixel_end = min_zz(pixel_start + BAKE_RAYS_CHUNK_SIZE, data->num_pixels);
+
+  if (rays->co == NULL) {
+    bake_rays_init(rays);
+  }
+
+  /* Gather the rays of consecutive pixels, coherent enough to be cast together. */
+  rays->len = 0;
+  for (size_t i = pixel_start; i < pixel_end; i++) {
+    float *co = rays->co[rays->len];
+    float *dir = rays->dir[rays->len];
+    TriTessFace *tri_low;
+
+    const int primitive_id = pixel_array_from[i].primitive_id;
+
+    if (primitive_id == -1) {
+      pixel_array_to[i].primitive_id = -1;
+      continue;
+    }
+
+    const float u = pixel_array_from[i].uv[0];
+    const float v = pixel_array_from[i].uv[1];
+
+    /* calculate from low poly mesh cage */
+    if (data->is_custom_cage) {
+      calc_point_from_barycentric_cage(data->tris_low,
+                                       data->tris_cage,
+                                       data->mat_low,
+                                       data->mat_cage,
+                                       primitive_id,
+                                       u,
+                                       v,
+                                       co,
+                                       dir);
+      tri_low = &data->tris_cage[primitive_id];
+    }
+    else if (data->is_cage) {
+      calc_point_from_barycentric_extrusion(data->tris_cage,
+                                            data->mat_low,
+                                            data->imat_low,
+                                            primitive_id,
+                                            u,
+                                            v,
+                                            data->cage_extrusion,
+                                            co,
+                                            dir,
+                                            true);
+      tri_low = &data->tris_cage[primitive_id];
+    }
+    else {
+      calc_point_from_barycentric_extrusion(data->tris_low,
+                                            data->mat_low,
+                                            data->imat_low,
+                                            primitive_id,
+                                            u,
+                                            v,
+                                            data->cage_extrusion,
+                                            co,
+                                            dir,
+                                            false);
+      tri_low = &data->tris_low[primitive_id];
+    }
+
+    rays->pixel_id[rays->len] = i;
+    rays->triangle_low[rays->len] = tri_low;
+    rays->len++;
+  }
+
+  /* cast rays */
+  cast_rays_highpoly(data->treeData, data->highpoly, data->tot_highpoly, rays);
+
+  for (int j = 0; j < rays->len; j++) {
+    if (!bake_pixel_from_highpoly_hit(rays->triangle_low[j],
+                                      data->tris_high,
+                                      pixel_array_from,
+                                      pixel_array_to,
+                                      data->mat_low,
+                                      data->highpoly,
+                                      rays->dir[j],
+                                      rays->pixel_id[j],
+                                      rays->hit_mesh[j],
+                                      &rays->hits[j])) {
+      /* if it fails mask out the original pixel array */
+      pixel_array_from[rays->pixel_id[j]].primitive_id = -1;
+    }
+  }
+}
+
+static void bake_highpoly_populate_finalize(void *__restrict UNUSED(userdata),
+                                            void *__restrict userdata_chunk)
+{
+  BakeRays *rays = userdata_chunk;
+  if (rays->co != NULL) {
+    bake_rays_free(rays);
+  }
+}
+
 bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
                                           BakePixel pixel_array_from[],
                                           BakePixel pixel_array_to[],
@@ -525,8 +716,6 @@ bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
                                           struct Mesh *me_cage)
 {
   size_t i;
-  int primitive_id;
-  float u, v;
   float imat_low[4][4];
   bool is_cage = me_cage != NULL;
   bool result = true;
@@ -580,54 +769,34 @@ bool RE_bake_pixels_populate_from_objects(struct Mesh *me_low,
     }
   }
 
-  for (i = 0; i < num_pixels; i++) {
-    float co[3];
-    float dir[3];
-    TriTessFace *tri_low;
-
-    primitive_id = pixel_array_from[i].primitive_id;
-
-    if (primitive_id == -1) {
-      pixel_array_to[i].primitive_id = -1;
-      continue;
-    }
+  BakeHighpolyPopulateData data = {
+      .pixel_array_from = pixel_array_from,
+      .pixel_array_to = pixel_array_to,
+      .num_pixels = num_pixels,
+      .highpoly = highpoly,
+      .tot_highpoly = tot_highpoly,
+      .treeData = treeData,
+      .tris_high = tris_high,
+      .tris_low = tris_low,
+      .tris_cage = tris_cage,
+      .is_custom_cage = is_custom_cage,
+      .is_cage = is_cage,
+      .cage_extrusion = cage_extrusion,
+      .mat_low = mat_low,
+      .imat_low = imat_low,
+      .mat_cage = mat_cage,
+  };
+  BakeRays rays_tls = {0};
 
-    u = pixel_array_from[i].uv[0];
-    v = pixel_array_from[i].uv[1];
+  /* Chunks of consecutive pixels are populated in parallel. */
+  const int chunks_len = (int)((num_pixels + BAKE_RAYS_CHUNK_SIZE - 1) / BAKE_RAYS_CHUNK_SIZE);
 
-    /* calculate from low poly mesh cage */
-    if (is_custom_cage) {
-      calc_point_from_barycentric_cage(
-          tris_low, tris_cage, mat_low, mat_cage, primitive_id, u, v, co, dir);
-      tri_low = &tris_cage[primitive_id];
-    }
-    else if (is_cage) {
-      calc_point_from_barycentric_extrusion(
-          tris_cage, mat_low, imat_low, primitive_id, u, v, cage_extrusion, co, dir, true);
-      tri_low = &tris_cage[primitive_id];
-    }
-    else {
-      calc_point_from_barycentric_extrusion(
-          tris_low, mat_low, imat_low, primitive_id, u, v, cage_extrusion, co, dir, false);
-      tri_low = &tris_low[primitive_id];
-    }
-
-    /* cast ray */
-    if (!cast_ray_highpoly(treeData,
-                           tri_low,
-                           tris_high,
-                           pixel_array_from,
-                           pixel_array_to,
-                           mat_low,
-                           highpoly,
-                           co,
-                           dir,
-                           i,
-                           tot_highpoly)) {
-      /* if it fails mask out the original pixel array */
-      pixel_array_from[i].primitive_id = -1;
-    }
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = &rays_tls;
+  settings.userdata_chunk_size = sizeof(rays_tls);
+  settings.func_finalize = bake_highpoly_populate_finalize;
+  BLI_task_parallel_range(0, chunks_len, &data, bake_highpoly_populate_cb, &settings);
 
   /* garbage collection */
 cleanup:
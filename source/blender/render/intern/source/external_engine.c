@@ -31,7 +31,9 @@
 
 #include "BLI_utildefines.h"
 #include "BLI_ghash.h"
+#include "BLI_fileops.h"
 #include "BLI_listbase.h"
+#include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
 
@@ -162,6 +164,9 @@ void RE_engine_free(RenderEngine *engine)
     BLI_threaded_malloc_end();
   }
 
+  /* Graph kept with persistent data. */
+  DEG_graph_free(engine->depsgraph);
+
   BLI_mutex_end(&engine->update_render_passes_mutex);
 
   MEM_freeN(engine);
@@ -504,11 +509,38 @@ RenderData *RE_engine_get_render_data(Render *re)
 }
 
 /* Depsgraph */
+
+/* With persistent data the dependency graph is kept between renders, so the next render only
+ * evaluates what changed, and the engine can find out what to sync from the recalc flags. */
+static bool engine_keep_depsgraph(RenderEngine *engine)
+{
+  const Render *re = engine->re;
+  return (re->r.mode & R_PERSISTENT_DATA) && !(re->r.scemode & R_BUTS_PREVIEW);
+}
+
+static void engine_depsgraph_free(RenderEngine *engine)
+{
+  DEG_graph_free(engine->depsgraph);
+
+  engine->depsgraph = NULL;
+}
+
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
   Main *bmain = engine->re->main;
   Scene *scene = engine->re->scene;
 
+  /* Graph kept from the previous render can only be reused for the same view layer. */
+  if (engine->depsgraph != NULL && (DEG_get_input_scene(engine->depsgraph) != scene ||
+                                    DEG_get_input_view_layer(engine->depsgraph) != view_layer)) {
+    engine_depsgraph_free(engine);
+  }
+
+  if (engine->depsgraph != NULL) {
+    BKE_scene_graph_update_for_newframe_ex(engine->depsgraph, bmain, false);
+    return;
+  }
+
   engine->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
   DEG_debug_name_set(engine->depsgraph, "RENDER");
 
@@ -520,15 +552,24 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
     DEG_ids_clear_recalc(bmain, depsgraph);
   }
   else {
-    BKE_scene_graph_update_for_newframe(engine->depsgraph, bmain);
+    BKE_scene_graph_update_for_newframe_ex(
+        engine->depsgraph, bmain, !engine_keep_depsgraph(engine));
   }
 }
 
-static void engine_depsgraph_free(RenderEngine *engine)
+static void engine_depsgraph_exit(RenderEngine *engine)
 {
-  DEG_graph_free(engine->depsgraph);
+  if (engine->depsgraph == NULL) {
+    return;
+  }
 
-  engine->depsgraph = NULL;
+  if (engine_keep_depsgraph(engine)) {
+    /* Changes were handled by this render, the next one only needs the ones made after it. */
+    DEG_ids_clear_recalc(engine->re->main, engine->depsgraph);
+  }
+  else {
+    engine_depsgraph_free(engine);
+  }
 }
 
 void RE_engine_frame_set(RenderEngine *engine, int frame, float subframe)
@@ -610,6 +651,8 @@ bool RE_bake_engine(Render *re,
   engine->tile_y = re->r.tiley;
 
   if (type->bake) {
+    /* Baking uses the given graph, not the one kept from a previous render. */
+    engine_depsgraph_free(engine);
     engine->depsgraph = depsgraph;
 
     /* update is only called so we create the engine.session */
@@ -655,6 +698,35 @@ bool RE_bake_engine(Render *re,
 
 /* Render */
 
+/* Whether to write tiles to files in the temp directory instead of keeping the full frame render
+ * result in memory, when requested or when the render result would exceed the memory limit. */
+static bool engine_use_save_buffers(Render *re, RenderEngine *engine)
+{
+  if (!(engine->type->flag & RE_USE_SAVE_BUFFERS)) {
+    return false;
+  }
+  if (re->r.scemode & R_EXR_TILE_FILE) {
+    return true;
+  }
+
+#ifdef WITH_OPENEXR
+  if (re->r.save_buffers_memory_limit > 0 && !(re->r.scemode & R_BUTS_PREVIEW)) {
+    const size_t limit = (size_t)re->r.save_buffers_memory_limit * 1024 * 1024;
+    const size_t mem = render_result_estimate_memory(re, engine);
+    if (mem > limit) {
+      char str[FILE_MAX];
+      render_result_exr_file_path(re->scene, "", 0, str);
+      if (BLI_file_is_writable(str)) {
+        printf("Render result needs %d MB, saving buffers to disk\n", (int)(mem >> 20));
+        return true;
+      }
+    }
+  }
+#endif
+
+  return false;
+}
+
 int RE_engine_render(Render *re, int do_all)
 {
   RenderEngineType *type = RE_engines_find(re->r.engine);
@@ -686,6 +758,17 @@ int RE_engine_render(Render *re, int do_all)
     render_update_anim_renderdata(re, &re->scene->r, &re->scene->view_layers);
   }
 
+  /* Create the engine before the render result, it is needed to know its passes. */
+  engine = re->engine;
+
+  if (!engine) {
+    engine = RE_engine_create(type);
+    re->engine = engine;
+  }
+
+  /* Done before locking the render result, calls into the engine. */
+  const bool use_save_buffers = engine_use_save_buffers(re, engine);
+
   /* create render result */
   BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_WRITE);
   if (re->result == NULL || !(re->r.scemode & R_BUTS_PREVIEW)) {
@@ -695,7 +778,7 @@ int RE_engine_render(Render *re, int do_all)
       render_result_free(re->result);
     }
 
-    if ((type->flag & RE_USE_SAVE_BUFFERS) && (re->r.scemode & R_EXR_TILE_FILE)) {
+    if (use_save_buffers) {
       savebuffers = RR_USE_EXR;
     }
     re->result = render_result_new(re, &re->disprect, 0, savebuffers, RR_ALL_LAYERS, RR_ALL_VIEWS);
@@ -721,13 +804,6 @@ int RE_engine_render(Render *re, int do_all)
   re->i.totface = re->i.totvert = re->i.totstrand = re->i.totlamp = re->i.tothalo = 0;
 
   /* render */
-  engine = re->engine;
-
-  if (!engine) {
-    engine = RE_engine_create(type);
-    re->engine = engine;
-  }
-
   engine->flag |= RE_ENGINE_RENDERING;
 
   /* TODO: actually link to a parent which shouldn't happen */
@@ -739,6 +815,12 @@ int RE_engine_render(Render *re, int do_all)
   if (re->r.scemode & R_BUTS_PREVIEW) {
     engine->flag |= RE_ENGINE_PREVIEW;
   }
+  if (re->result->do_exr_tile) {
+    engine->flag |= RE_ENGINE_SAVE_BUFFERS;
+  }
+  else {
+    engine->flag &= ~RE_ENGINE_SAVE_BUFFERS;
+  }
   engine->camera_override = re->camera_override;
 
   engine->resolution_x = re->winx;
@@ -787,7 +869,7 @@ int RE_engine_render(Render *re, int do_all)
         DRW_render_gpencil(engine, engine->depsgraph);
       }
 
-      engine_depsgraph_free(engine);
+      engine_depsgraph_exit(engine);
 
       if (RE_engine_test_break(engine)) {
         break;
@@ -882,6 +964,10 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
   if (DRW_render_check_grease_pencil(engine->depsgraph)) {
     return;
   }
+  /* Graph is needed for the next render. */
+  if (engine_keep_depsgraph(engine)) {
+    return;
+  }
   DEG_graph_free(engine->depsgraph);
   engine->depsgraph = NULL;
 }
@@ -1217,6 +1217,37 @@ static void render_result_get_pass_templates(RenderEngine *engine,
   }
 }
 
+/* Estimate the memory used by the passes of a full frame render result in memory, including the
+ * passes requested by the engine. Calls into the engine, so not to be used with the render
+ * result mutex locked. */
+size_t render_result_estimate_memory(Render *re, RenderEngine *engine)
+{
+  const size_t num_pixels = (size_t)BLI_rcti_size_x(&re->disprect) *
+                            BLI_rcti_size_y(&re->disprect);
+  const int num_views = MAX2(BKE_scene_multiview_num_views_get(&re->r), 1);
+  size_t num_channels = 0;
+
+  FOREACH_VIEW_LAYER_TO_RENDER_BEGIN (re, view_layer) {
+    ListBase templates;
+    BLI_listbase_clear(&templates);
+    RE_engine_update_render_passes(
+        engine, re->scene, view_layer, templates_register_pass_cb, &templates);
+
+    /* A render layer always has a Combined pass. */
+    if (BLI_listbase_is_empty(&templates)) {
+      num_channels += 4;
+    }
+    for (RenderPass *pass = templates.first; pass; pass = pass->next) {
+      num_channels += pass->channels;
+    }
+
+    BLI_freelistN(&templates);
+  }
+  FOREACH_VIEW_LAYER_TO_RENDER_END;
+
+  return num_pixels * num_views * num_channels * sizeof(float);
+}
+
 /* begin write of exr tile file */
 void render_result_exr_file_begin(Render *re, RenderEngine *engine)
 {
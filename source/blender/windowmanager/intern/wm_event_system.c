@@ -42,6 +42,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_dynstr.h"
+#include "BLI_ghash.h"
 #include "BLI_utildefines.h"
 #include "BLI_math.h"
 #include "BLI_timer.h"
@@ -190,66 +191,73 @@ void wm_event_init_from_window(wmWindow *win, wmEvent *event)
 /** \name Notifiers & Listeners
  * \{ */
 
-static bool wm_test_duplicate_notifier(wmWindowManager *wm, unsigned int type, void *reference)
+/* Notifiers with the same type and reference are only added once, during playback and
+ * interactive updates the same notifiers are sent many times before being handled. */
+static unsigned int note_hash_for_queue_fn(const void *ptr)
 {
-  wmNotifier *note;
-
-  for (note = wm->queue.first; note; note = note->next) {
-    if ((note->category | note->data | note->subtype | note->action) == type &&
-        note->reference == reference) {
-      return 1;
-    }
-  }
+  const wmNotifier *note = ptr;
+  return (BLI_ghashutil_ptrhash(note->reference) ^
+          (note->category | note->data | note->subtype | note->action));
+}
 
-  return 0;
+static bool note_cmp_for_queue_fn(const void *a, const void *b)
+{
+  const wmNotifier *note_a = a;
+  const wmNotifier *note_b = b;
+  return !(((note_a->category | note_a->data | note_a->subtype | note_a->action) ==
+            (note_b->category | note_b->data | note_b->subtype | note_b->action)) &&
+           (note_a->reference == note_b->reference));
 }
 
-/* XXX: in future, which notifiers to send to other windows? */
-void WM_event_add_notifier(const bContext *C, unsigned int type, void *reference)
+static void wm_event_add_notifier_intern(wmWindowManager *wm,
+                                         wmWindow *win,
+                                         unsigned int type,
+                                         void *reference)
 {
-  wmWindowManager *wm = CTX_wm_manager(C);
+  wmNotifier note_test = {NULL};
   wmNotifier *note;
+  void **note_p;
+
+  note_test.category = type & NOTE_CATEGORY;
+  note_test.data = type & NOTE_DATA;
+  note_test.subtype = type & NOTE_SUBTYPE;
+  note_test.action = type & NOTE_ACTION;
+  note_test.reference = reference;
+
+  if (wm->notifier_queue_set == NULL) {
+    wm->notifier_queue_set = BLI_gset_new_ex(
+        note_hash_for_queue_fn, note_cmp_for_queue_fn, __func__, 1024);
+  }
 
-  if (wm_test_duplicate_notifier(wm, type, reference)) {
+  if (BLI_gset_ensure_p_ex(wm->notifier_queue_set, &note_test, &note_p)) {
     return;
   }
 
-  note = MEM_callocN(sizeof(wmNotifier), "notifier");
+  note = MEM_mallocN(sizeof(wmNotifier), "notifier");
+  *note = note_test;
+  *note_p = note;
 
   note->wm = wm;
-  BLI_addtail(&note->wm->queue, note);
-
-  note->window = CTX_wm_window(C);
-
-  note->category = type & NOTE_CATEGORY;
-  note->data = type & NOTE_DATA;
-  note->subtype = type & NOTE_SUBTYPE;
-  note->action = type & NOTE_ACTION;
+  note->window = win;
+  BLI_addtail(&wm->queue, note);
+}
 
-  note->reference = reference;
+/* XXX: in future, which notifiers to send to other windows? */
+void WM_event_add_notifier(const bContext *C, unsigned int type, void *reference)
+{
+  wm_event_add_notifier_intern(CTX_wm_manager(C), CTX_wm_window(C), type, reference);
 }
 
 void WM_main_add_notifier(unsigned int type, void *reference)
 {
   Main *bmain = G_MAIN;
   wmWindowManager *wm = bmain->wm.first;
-  wmNotifier *note;
 
-  if (!wm || wm_test_duplicate_notifier(wm, type, reference)) {
+  if (!wm) {
     return;
   }
 
-  note = MEM_callocN(sizeof(wmNotifier), "notifier");
-
-  note->wm = wm;
-  BLI_addtail(&note->wm->queue, note);
-
-  note->category = type & NOTE_CATEGORY;
-  note->data = type & NOTE_DATA;
-  note->subtype = type & NOTE_SUBTYPE;
-  note->action = type & NOTE_ACTION;
-
-  note->reference = reference;
+  wm_event_add_notifier_intern(wm, NULL, type, reference);
 }
 
 /**
@@ -267,6 +275,10 @@ void WM_main_remove_notifier_reference(const void *reference)
       note_next = note->next;
 
       if (note->reference == reference) {
+        const bool removed = BLI_gset_remove(wm->notifier_queue_set, note, NULL);
+        BLI_assert(removed);
+        UNUSED_VARS_NDEBUG(removed);
+
         /* don't remove because this causes problems for #wm_event_do_notifiers
          * which may be looping on the data (deleting screens) */
         wm_notifier_clear(note);
@@ -493,6 +505,9 @@ void wm_event_do_notifiers(bContext *C)
 
   /* the notifiers are sent without context, to keep it clean */
   while ((note = BLI_pophead(&wm->queue))) {
+    /* Cleared notifiers were removed already, they don't match any other notifier. */
+    BLI_gset_remove(wm->notifier_queue_set, note, NULL);
+
     for (win = wm->windows.first; win; win = win->next) {
       Scene *scene = WM_window_get_active_scene(win);
       bScreen *screen = WM_window_get_active_screen(win);
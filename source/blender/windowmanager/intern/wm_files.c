@@ -117,6 +117,8 @@
 /* only to report a missing engine */
 #include "RE_engine.h"
 
+#include "COM_compositor.h"
+
 #ifdef WITH_PYTHON
 #  include "BPY_extern.h"
 #endif
@@ -550,6 +552,11 @@ static void wm_file_read_post(bContext *C,
   if (use_data) {
     WM_operatortype_last_properties_clear_all();
 
+#ifdef WITH_COMPOSITOR
+    /* Cached compositor buffers are calculated from the data of the previous file. */
+    COM_clearCaches();
+#endif
+
     /* After load post, so for example the driver namespace can be filled
      * before evaluating the depsgraph. */
     wm_event_do_depsgraph(C, true);
@@ -1491,9 +1498,34 @@ void WM_autosave_init(wmWindowManager *wm)
   }
 }
 
+/* Compressing and writing the file to disk is done in a job, so it doesn't block the UI. */
+static void wm_autosave_write_job_startjob(void *customdata,
+                                           short *UNUSED(stop),
+                                           short *UNUSED(do_update),
+                                           float *UNUSED(progress))
+{
+  /* Error reporting into console */
+  BLO_write_file_snapshot_save(customdata, NULL);
+}
+
+static void wm_autosave_write_job_free(void *customdata)
+{
+  BLO_write_file_snapshot_free(customdata);
+}
+
+static void wm_autosave_write_job_start(wmWindowManager *wm, BlendFileWriteSnapshot *snapshot)
+{
+  wmJob *wm_job = WM_jobs_get(wm, wm->winactive, wm, "Auto-Saving...", 0, WM_JOB_TYPE_AUTOSAVE);
+  WM_jobs_customdata_set(wm_job, snapshot, wm_autosave_write_job_free);
+  WM_jobs_timer(wm_job, 0.1, 0, 0);
+  WM_jobs_callbacks(wm_job, wm_autosave_write_job_startjob, NULL, NULL, NULL);
+  WM_jobs_start(wm, wm_job);
+}
+
 void wm_autosave_timer(const bContext *C, wmWindowManager *wm, wmTimer *UNUSED(wt))
 {
   char filepath[FILE_MAX];
+  BlendFileWriteSnapshot *snapshot = NULL;
 
   WM_event_remove_timer(wm, NULL, wm->autosavetimer);
 
@@ -1513,13 +1545,23 @@ void wm_autosave_timer(const bContext *C, wmWindowManager *wm, wmTimer *UNUSED(w
     }
   }
 
+  /* the previous auto-save is still being written, try again in 10 seconds */
+  if (WM_jobs_test(wm, wm, WM_JOB_TYPE_AUTOSAVE)) {
+    wm->autosavetimer = WM_event_add_timer(wm, NULL, TIMERAUTOSAVE, 10.0);
+    if (G.debug) {
+      printf("Skipping auto-save, previous auto-save running, retrying in ten seconds...\n");
+    }
+    return;
+  }
+
   wm_autosave_location(filepath);
 
   if (U.uiflag & USER_GLOBALUNDO) {
     /* fast save of last undobuffer, now with UI */
     struct MemFile *memfile = ED_undosys_stack_memfile_get_active(wm->undo_stack);
     if (memfile) {
-      BLO_memfile_write_file(memfile, filepath);
+      /* Copied, the undo step may be freed while writing. */
+      snapshot = BLO_write_file_snapshot_from_memfile(memfile, filepath, 0);
     }
   }
   else {
@@ -1530,8 +1572,13 @@ void wm_autosave_timer(const bContext *C, wmWindowManager *wm, wmTimer *UNUSED(w
     ED_editors_flush_edits(bmain);
 
     /* Error reporting into console */
-    BLO_write_file(bmain, filepath, fileflags, NULL, NULL);
+    snapshot = BLO_write_file_snapshot(bmain, filepath, fileflags, NULL, NULL);
+  }
+
+  if (snapshot) {
+    wm_autosave_write_job_start(wm, snapshot);
   }
+
   /* do timer after file write, just in case file write takes a long time */
   wm->autosavetimer = WM_event_add_timer(wm, NULL, TIMERAUTOSAVE, U.savetime * 60.0);
 }
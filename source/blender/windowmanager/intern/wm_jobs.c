@@ -31,6 +31,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.h"
@@ -380,7 +381,11 @@ static void *do_job_thread(void *job_v)
   wmJob *wm_job = job_v;
 
   BLI_thread_put_thread_on_fast_node();
+
+  TraceZone zone;
+  BLI_trace_zone_begin(&zone, wm_job->name, "job");
   wm_job->startjob(wm_job->run_customdata, &wm_job->stop, &wm_job->do_update, &wm_job->progress);
+  BLI_trace_zone_end(&zone);
   wm_job->ready = true;
 
   return NULL;
@@ -623,6 +628,24 @@ void wm_jobs_timer_ended(wmWindowManager *wm, wmTimer *wt)
   }
 }
 
+/**
+ * A job of the timer finished running, it can be ended without waiting for the timer step.
+ * This way chained and canceled jobs don't keep the interface waiting for up to a timer step.
+ */
+bool wm_jobs_timer_is_ready(wmWindowManager *wm, wmTimer *wt)
+{
+  wmJob *wm_job;
+
+  for (wm_job = wm->jobs.first; wm_job; wm_job = wm_job->next) {
+    if (wm_job->wt == wt) {
+      if (wm_job->running && wm_job->ready) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 /* hardcoded to event TIMERJOBS */
 void wm_jobs_timer(const bContext *C, wmWindowManager *wm, wmTimer *wt)
 {
@@ -78,6 +78,8 @@
 
 #include "BLF_api.h"
 
+#include "DRW_engine.h"
+
 #include "GPU_immediate.h"
 #include "GPU_immediate_util.h"
 #include "GPU_matrix.h"
@@ -3229,6 +3231,16 @@ static int redraw_timer_exec(bContext *C, wmOperator *op)
    */
   struct Depsgraph *depsgraph = CTX_data_depsgraph_pointer(C);
 
+  /* Record the draw timings of every redraw (levels of GPU passes, shading groups), for offline
+   * analysis. */
+  char filepath[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filepath);
+  const bool do_record = (filepath[0] != '\0');
+  if (do_record && !DRW_stats_record_begin(filepath)) {
+    BKE_reportf(op->reports, RPT_ERROR, "Cannot open file \"%s\" for writing", filepath);
+    return OPERATOR_CANCELLED;
+  }
+
   WM_cursor_wait(1);
 
   time_start = PIL_check_seconds_timer();
@@ -3249,6 +3261,10 @@ static int redraw_timer_exec(bContext *C, wmOperator *op)
 
   time_delta = (PIL_check_seconds_timer() - time_start) * 1000;
 
+  if (do_record) {
+    DRW_stats_record_end();
+  }
+
   RNA_enum_description(redraw_timer_type_items, type, &infostr);
 
   WM_cursor_wait(0);
@@ -3286,6 +3302,14 @@ static void WM_OT_redraw_timer(wmOperatorType *ot)
                 "Seconds to run the test for (override iterations)",
                 0.0,
                 60.0);
+  PropertyRNA *prop = RNA_def_string_file_path(
+      ot->srna,
+      "filepath",
+      NULL,
+      FILE_MAX,
+      "File Path",
+      "Record the viewport draw timings of every iteration to this CSV file");
+  RNA_def_property_flag(prop, PROP_SKIP_SAVE);
 }
 
 /** \} */
@@ -1583,7 +1583,8 @@ static int wm_window_timer(const bContext *C)
     win = wt->win;
 
     if (wt->sleep == 0) {
-      if (time > wt->ntime) {
+      if ((time > wt->ntime) ||
+          (wt->event_type == TIMERJOBS && wm_jobs_timer_is_ready(wm, wt))) {
         wt->delta = time - wt->ltime;
         wt->duration += wt->delta;
         wt->ltime = time;
@@ -70,6 +70,7 @@ void wm_tweakevent_test(bContext *C, const wmEvent *event, int action);
 /* wm_jobs.c */
 void wm_jobs_timer(const bContext *C, wmWindowManager *wm, wmTimer *wt);
 void wm_jobs_timer_ended(wmWindowManager *wm, wmTimer *wt);
+bool wm_jobs_timer_is_ready(wmWindowManager *wm, wmTimer *wt);
 
 /* wm_files.c */
 void wm_autosave_timer(const bContext *C, wmWindowManager *wm, wmTimer *wt);
@@ -34,6 +34,7 @@
 
 #  include "BLI_args.h"
 #  include "BLI_threads.h"
+#  include "BLI_trace.h"
 #  include "BLI_utildefines.h"
 #  include "BLI_listbase.h"
 #  include "BLI_string.h"
@@ -598,6 +599,8 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-no-threads");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-time");
   BLI_argsPrintArgDoc(ba, "--debug-depsgraph-pretty");
+  BLI_argsPrintArgDoc(ba, "--debug-depsgraph-trace");
+  BLI_argsPrintArgDoc(ba, "--debug-trace");
   BLI_argsPrintArgDoc(ba, "--debug-gpu");
   BLI_argsPrintArgDoc(ba, "--debug-gpumem");
   BLI_argsPrintArgDoc(ba, "--debug-gpu-shaders");
@@ -979,6 +982,29 @@ static int arg_handle_debug_mode_generic_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_debug_trace_set_doc[] =
+    "<filename>\n"
+    "\tWrite the time spent in traced zones (file loading and saving, jobs, drawing...) and the\n"
+    "\tevaluation of all operations of dependency graphs to a file, with per-thread timings,\n"
+    "\tas Chrome trace events which can be opened by chrome://tracing or Perfetto.";
+static const char arg_handle_debug_trace_set_doc_depsgraph[] =
+    "<filename>\n"
+    "\tSame as '--debug-trace'.";
+static int arg_handle_debug_trace_set(int argc, const char **argv, void *data)
+{
+  const char *arg_id = data;
+  if (argc > 1) {
+    if (!BLI_trace_begin(argv[1])) {
+      printf("\nError: could not open '%s %s'.\n", arg_id, argv[1]);
+    }
+    return 1;
+  }
+  else {
+    printf("\nError: '%s' no args given.\n", arg_id);
+    return 0;
+  }
+}
+
 static const char arg_handle_debug_mode_io_doc[] =
     "\n\t"
     "Enable debug messages for I/O (collada, ...).";
@@ -2166,6 +2192,14 @@ void main_args_setup(bContext *C, bArgs *ba)
               "--debug-depsgraph-pretty",
               CB_EX(arg_handle_debug_mode_generic_set, depsgraph_pretty),
               (void *)G_DEBUG_DEPSGRAPH_PRETTY);
+  BLI_argsAdd(ba,
+              1,
+              NULL,
+              "--debug-depsgraph-trace",
+              CB_EX(arg_handle_debug_trace_set, depsgraph),
+              (void *)"--debug-depsgraph-trace");
+  BLI_argsAdd(
+      ba, 1, NULL, "--debug-trace", CB(arg_handle_debug_trace_set), (void *)"--debug-trace");
   BLI_argsAdd(ba,
               1,
               NULL,
@@ -0,0 +1,114 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "atomic_ops.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+#include "BLI_concurrent_ghash.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+}
+
+TEST(concurrent_ghash, InsertLookupRemove)
+{
+  ConcurrentGHash *cgh = BLI_concurrent_ghash_new(
+      BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(BLI_concurrent_ghash_add(cgh, POINTER_FROM_INT(i), POINTER_FROM_INT(i + 1)));
+  }
+  EXPECT_FALSE(BLI_concurrent_ghash_add(cgh, POINTER_FROM_INT(10), POINTER_FROM_INT(0)));
+  EXPECT_EQ(BLI_concurrent_ghash_len(cgh), 1000);
+
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(POINTER_AS_INT(BLI_concurrent_ghash_lookup(cgh, POINTER_FROM_INT(i))), i + 1);
+  }
+  EXPECT_FALSE(BLI_concurrent_ghash_haskey(cgh, POINTER_FROM_INT(1000)));
+
+  EXPECT_FALSE(
+      BLI_concurrent_ghash_reinsert(cgh, POINTER_FROM_INT(10), POINTER_FROM_INT(-1), NULL, NULL));
+  EXPECT_EQ(POINTER_AS_INT(BLI_concurrent_ghash_lookup(cgh, POINTER_FROM_INT(10))), -1);
+
+  for (int i = 0; i < 1000; i += 2) {
+    EXPECT_TRUE(BLI_concurrent_ghash_remove(cgh, POINTER_FROM_INT(i), NULL, NULL));
+  }
+  EXPECT_FALSE(BLI_concurrent_ghash_remove(cgh, POINTER_FROM_INT(0), NULL, NULL));
+  EXPECT_EQ(BLI_concurrent_ghash_len(cgh), 500);
+
+  BLI_concurrent_ghash_clear(cgh, NULL, NULL);
+  EXPECT_EQ(BLI_concurrent_ghash_len(cgh), 0);
+
+  BLI_concurrent_ghash_free(cgh, NULL, NULL);
+}
+
+namespace {
+
+/* Every task inserts all keys of its chunk, chunks overlap so most keys are inserted by multiple
+ * tasks at the same time. */
+const int num_keys = 100000;
+const int num_tasks = 256;
+const int keys_per_task = num_keys / num_tasks * 4;
+
+struct ConcurrentData {
+  ConcurrentGHash *cgh;
+  int num_created;
+};
+
+void *concurrent_create(const void *key, void *userdata)
+{
+  ConcurrentData *data = (ConcurrentData *)userdata;
+  atomic_add_and_fetch_int32(&data->num_created, 1);
+  return POINTER_FROM_INT(POINTER_AS_INT(key) * 2);
+}
+
+void concurrent_ensure(TaskPool *__restrict pool, void *taskdata, int /*threadid*/)
+{
+  ConcurrentData *data = (ConcurrentData *)BLI_task_pool_userdata(pool);
+  const int task_index = POINTER_AS_INT(taskdata);
+  for (int i = 0; i < keys_per_task; i++) {
+    const int key = (task_index * (num_keys / num_tasks) + i) % num_keys;
+    void *val = BLI_concurrent_ghash_ensure(
+        data->cgh, POINTER_FROM_INT(key), concurrent_create, data, NULL);
+    EXPECT_EQ(POINTER_AS_INT(val), key * 2);
+  }
+}
+
+void concurrent_count(void *key, void *val, void *userdata)
+{
+  EXPECT_EQ(POINTER_AS_INT(val), POINTER_AS_INT(key) * 2);
+  (*(int *)userdata)++;
+}
+
+}  // namespace
+
+TEST(concurrent_ghash, EnsureConcurrent)
+{
+  ConcurrentData data;
+  data.cgh = BLI_concurrent_ghash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+  data.num_created = 0;
+
+  TaskScheduler *scheduler = BLI_task_scheduler_create(16);
+  TaskPool *pool = BLI_task_pool_create_suspended(scheduler, &data);
+  for (int i = 0; i < num_tasks; i++) {
+    BLI_task_pool_push(pool, concurrent_ensure, POINTER_FROM_INT(i), false, TASK_PRIORITY_HIGH);
+  }
+  BLI_threaded_malloc_begin();
+  BLI_task_pool_work_and_wait(pool);
+  BLI_threaded_malloc_end();
+
+  /* Each value was created exactly once, even though keys were ensured by multiple tasks. */
+  EXPECT_EQ(data.num_created, num_keys);
+  EXPECT_EQ(BLI_concurrent_ghash_len(data.cgh), num_keys);
+
+  int num_visited = 0;
+  BLI_concurrent_ghash_foreach(data.cgh, concurrent_count, &num_visited);
+  EXPECT_EQ(num_visited, num_keys);
+
+  BLI_task_pool_free(pool);
+  BLI_task_scheduler_free(scheduler);
+  BLI_concurrent_ghash_free(data.cgh, NULL, NULL);
+}
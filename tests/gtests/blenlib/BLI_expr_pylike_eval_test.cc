@@ -102,6 +102,8 @@ TEST_PARSE_FAIL(BadArgCount2, "sqrt(1,2)")
 TEST_PARSE_FAIL(BadArgCount3, "pi()")
 TEST_PARSE_FAIL(BadArgCount4, "max()")
 TEST_PARSE_FAIL(BadArgCount5, "min()")
+TEST_PARSE_FAIL(BadArgCount6, "log(1,2,3)")
+TEST_PARSE_FAIL(BadArgCount7, "round(1.5,1)")
 
 TEST_PARSE_FAIL(Truncated1, "(1+2")
 TEST_PARSE_FAIL(Truncated2, "1 if 2")
@@ -113,6 +115,10 @@ TEST_PARSE_FAIL(Truncated7, "1 and")
 TEST_PARSE_FAIL(Truncated8, "1 or")
 TEST_PARSE_FAIL(Truncated9, "sqrt(1")
 TEST_PARSE_FAIL(Truncated10, "fmod(1,")
+TEST_PARSE_FAIL(Truncated11, "2 **")
+TEST_PARSE_FAIL(Truncated12, "2 //")
+TEST_PARSE_FAIL(Truncated13, "2 %")
+TEST_PARSE_FAIL(BadPow, "2 * * 2")
 
 /* Constant expression with working constant folding */
 #define TEST_CONST(name, str, value) \
@@ -145,6 +151,8 @@ TEST_CONST(TenE, "1.e+1", 10.0)
 TEST_CONST(Half, ".5", 0.5)
 
 TEST_CONST(Pi, "pi", M_PI)
+TEST_CONST(Tau, "tau", M_PI * 2.0)
+TEST_CONST(E, "e", M_E)
 TEST_CONST(True, "True", TRUE_VAL)
 TEST_CONST(False, "False", FALSE_VAL)
 
@@ -157,6 +165,37 @@ TEST_EVAL(FMod, "fmod(x, 2)", 3.5, 1.5)
 TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
+TEST_CONST(Log1, "log(e)", 1.0)
+TEST_CONST(Log2, "log(8, 2)", 3.0)
+TEST_EVAL(Log2, "log(x, 2)", 8.0, 3.0)
+TEST_CONST(Log10, "log10(100)", 2.0)
+TEST_CONST(Log2Func, "log2(8)", 3.0)
+
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_CONST(CopySign, "copysign(2, -1)", -2.0)
+TEST_CONST(Tanh, "tanh(0)", 0.0)
+TEST_CONST(Float, "float(2)", 2.0)
+TEST_CONST(Bool1, "bool(2)", TRUE_VAL)
+TEST_CONST(Bool2, "bool(0)", FALSE_VAL)
+TEST_EVAL(Bool, "bool(x)", -0.5, TRUE_VAL)
+
+TEST_CONST(Expm1, "expm1(0)", 0.0)
+TEST_CONST(Log1p, "log1p(0)", 0.0)
+TEST_CONST(Erf, "erf(0)", 0.0)
+TEST_CONST(Erfc, "erfc(0)", 1.0)
+TEST_CONST(Gamma, "gamma(5)", 24.0)
+TEST_EVAL(Gamma, "gamma(x)", 4.0, 6.0)
+TEST_CONST(LGamma, "lgamma(1)", 0.0)
+
+TEST_CONST(Round1, "round(1.4)", 1.0)
+TEST_CONST(Round2, "round(1.6)", 2.0)
+TEST_CONST(Round3, "round(0.5)", 0.0)
+TEST_CONST(Round4, "round(1.5)", 2.0)
+TEST_CONST(Round5, "round(2.5)", 2.0)
+TEST_CONST(Round6, "round(-2.5)", -2.0)
+TEST_CONST(Round7, "round(-1.5)", -2.0)
+TEST_EVAL(Round1, "round(x)", 3.5, 4.0)
+
 TEST_RESULT(Min1, "min(3,1,2)", 1.0)
 TEST_RESULT(Max1, "max(3,1,2)", 3.0)
 TEST_RESULT(Min2, "min(1,2,3)", 1.0)
@@ -181,6 +220,27 @@ TEST_EVAL(BinaryMul, "x*3", 2, 6.0)
 TEST_CONST(BinaryDiv, "3/2", 1.5)
 TEST_EVAL(BinaryDiv, "3/x", 2, 1.5)
 
+TEST_CONST(BinaryPow, "2**3", 8.0)
+TEST_EVAL(BinaryPow, "x ** 2", 3, 9.0)
+
+TEST_CONST(Pow1, "-2 ** 2", -4.0)
+TEST_CONST(Pow2, "2 ** -1", 0.5)
+TEST_CONST(Pow3, "2 ** 3 ** 2", 512.0)
+TEST_CONST(Pow4, "(2 ** 3) ** 2", 64.0)
+TEST_CONST(Pow5, "2 * 3 ** 2", 18.0)
+
+TEST_CONST(BinaryMod1, "7 % 3", 1.0)
+TEST_CONST(BinaryMod2, "-7 % 3", 2.0)
+TEST_CONST(BinaryMod3, "7 % -3", -2.0)
+TEST_CONST(BinaryMod4, "5.5 % 2", 1.5)
+TEST_EVAL(BinaryMod, "x % 3", -1, 2.0)
+
+TEST_CONST(FloorDiv1, "7 // 2", 3.0)
+TEST_CONST(FloorDiv2, "-7 // 2", -4.0)
+TEST_CONST(FloorDiv3, "7 // -2", -4.0)
+TEST_CONST(FloorDiv4, "1 // 0.1", 9.0)
+TEST_EVAL(FloorDiv, "x // 2", -1, -1.0)
+
 TEST_CONST(Arith1, "1 + -2 * 3", -5.0)
 TEST_CONST(Arith2, "(1 + -2) * 3", -3.0)
 TEST_CONST(Arith3, "-1 + 2 * 3", 5.0)
@@ -306,6 +366,11 @@ TEST_ERROR(DivZero2, "1 / 0", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(DivZero3, "1 / x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(DivZero4, "1 / x", 1.0, EXPR_PYLIKE_SUCCESS)
 
+TEST_ERROR(ModZero1, "1 % x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
+TEST_ERROR(ModZero2, "1 % x", 2.0, EXPR_PYLIKE_SUCCESS)
+TEST_ERROR(FloorDivZero1, "1 // x", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
+TEST_ERROR(FloorDivZero2, "1 // x", 2.0, EXPR_PYLIKE_SUCCESS)
+
 TEST_ERROR(SqrtDomain1, "sqrt(-1)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(SqrtDomain2, "sqrt(x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(SqrtDomain3, "sqrt(x)", 0.0, EXPR_PYLIKE_SUCCESS)
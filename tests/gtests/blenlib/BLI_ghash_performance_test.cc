@@ -10,6 +10,7 @@
 extern "C" {
 #include "BLI_utildefines.h"
 #include "BLI_ghash.h"
+#include "BLI_ohash.h"
 #include "BLI_rand.h"
 #include "BLI_string.h"
 #include "PIL_time_utildefines.h"
@@ -554,3 +555,151 @@ TEST(ghash, MultiRandIntMurmur2a200000)
 
   multi_small_ghash_tests(ghash, "MultiSmall RandIntGHash - Murmur2a - 200000", 200000);
 }
+
+/* OHash: same integer cases as above with the open addressing hash, to compare with GHash. */
+
+static void int_ohash_tests(OHash *ohash, const char *id, const unsigned int nbr)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  {
+    unsigned int i = nbr;
+
+    TIMEIT_START(int_insert);
+
+#ifdef GHASH_RESERVE
+    BLI_ohash_reserve(ohash, nbr);
+#endif
+
+    while (i--) {
+      BLI_ohash_insert(ohash, POINTER_FROM_UINT(i), POINTER_FROM_UINT(i));
+    }
+
+    TIMEIT_END(int_insert);
+  }
+
+  {
+    unsigned int i = nbr;
+
+    TIMEIT_START(int_lookup);
+
+    while (i--) {
+      void *v = BLI_ohash_lookup(ohash, POINTER_FROM_UINT(i));
+      EXPECT_EQ(POINTER_AS_UINT(v), i);
+    }
+
+    TIMEIT_END(int_lookup);
+  }
+
+  {
+    unsigned int i = nbr;
+
+    TIMEIT_START(int_pop);
+
+    while (i--) {
+      void *v = BLI_ohash_popkey(ohash, POINTER_FROM_UINT(i), NULL);
+      EXPECT_EQ(POINTER_AS_UINT(v), i);
+    }
+
+    TIMEIT_END(int_pop);
+  }
+  EXPECT_EQ(BLI_ohash_len(ohash), 0);
+
+  BLI_ohash_free(ohash, NULL, NULL);
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(ohash, IntOHash12000)
+{
+  OHash *ohash = BLI_ohash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+
+  int_ohash_tests(ohash, "IntOHash - GHash - 12000", 12000);
+}
+
+#ifdef GHASH_RUN_BIG
+TEST(ohash, IntOHash100000000)
+{
+  OHash *ohash = BLI_ohash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+
+  int_ohash_tests(ohash, "IntOHash - GHash - 100000000", 100000000);
+}
+#endif
+
+TEST(ohash, IntOHashNoHash12000)
+{
+  OHash *ohash = BLI_ohash_new(ghashutil_tests_nohash_p, ghashutil_tests_cmp_p, __func__);
+
+  int_ohash_tests(ohash, "IntOHash - No Hash - 12000", 12000);
+}
+
+static void randint_ohash_tests(OHash *ohash, const char *id, const unsigned int nbr)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  unsigned int *data = (unsigned int *)MEM_mallocN(sizeof(*data) * (size_t)nbr, __func__);
+  unsigned int *dt;
+  unsigned int i;
+
+  {
+    RNG *rng = BLI_rng_new(0);
+    for (i = nbr, dt = data; i--; dt++) {
+      *dt = BLI_rng_get_uint(rng);
+    }
+    BLI_rng_free(rng);
+  }
+
+  {
+    TIMEIT_START(int_insert);
+
+#ifdef GHASH_RESERVE
+    BLI_ohash_reserve(ohash, nbr);
+#endif
+
+    /* Random numbers may contain duplicates, which #BLI_ohash_insert asserts against. */
+    for (i = nbr, dt = data; i--; dt++) {
+      BLI_ohash_reinsert(ohash, POINTER_FROM_UINT(*dt), POINTER_FROM_UINT(*dt), NULL, NULL);
+    }
+
+    TIMEIT_END(int_insert);
+  }
+
+  {
+    TIMEIT_START(int_lookup);
+
+    for (i = nbr, dt = data; i--; dt++) {
+      void *v = BLI_ohash_lookup(ohash, POINTER_FROM_UINT(*dt));
+      EXPECT_EQ(POINTER_AS_UINT(v), *dt);
+    }
+
+    TIMEIT_END(int_lookup);
+  }
+
+  BLI_ohash_free(ohash, NULL, NULL);
+  MEM_freeN(data);
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(ohash, IntRandOHash12000)
+{
+  OHash *ohash = BLI_ohash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+
+  randint_ohash_tests(ohash, "RandIntOHash - GHash - 12000", 12000);
+}
+
+#ifdef GHASH_RUN_BIG
+TEST(ohash, IntRandOHash50000000)
+{
+  OHash *ohash = BLI_ohash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+
+  randint_ohash_tests(ohash, "RandIntOHash - GHash - 50000000", 50000000);
+}
+#endif
+
+TEST(ohash, IntRandOHashMurmur2a12000)
+{
+  OHash *ohash = BLI_ohash_new(BLI_ghashutil_inthash_p_murmur, BLI_ghashutil_intcmp, __func__);
+
+  randint_ohash_tests(ohash, "RandIntOHash - Murmur - 12000", 12000);
+}
@@ -0,0 +1,216 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_kdopbvh.h"
+#include "BLI_math_geom.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+#include "BLI_task.h"
+
+#include "PIL_time.h"
+}
+
+#include "stubs/bf_intern_eigen_stubs.h"
+
+#define NUM_RUN_AVERAGED 5
+
+/* Small triangles scattered in a unit cube, similar to a dense mesh. */
+static float (*random_triangles_new(const int num_tris))[3][3]
+{
+  float(*tris)[3][3] = (float(*)[3][3])MEM_mallocN(sizeof(*tris) * (size_t)num_tris, __func__);
+  const float size = 2.0f / cbrtf((float)num_tris);
+  RNG *rng = BLI_rng_new(0);
+  for (int i = 0; i < num_tris; i++) {
+    float center[3];
+    BLI_rng_get_float_unit_v3(rng, center);
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 3; k++) {
+        tris[i][j][k] = center[k] + BLI_rng_get_float(rng) * size;
+      }
+    }
+  }
+  BLI_rng_free(rng);
+  return tris;
+}
+
+static BVHTree *bvhtree_from_triangles(const float (*tris)[3][3],
+                                       const int num_tris,
+                                       const char tree_type,
+                                       const char axis,
+                                       double *r_time)
+{
+  const double init_time = PIL_check_seconds_timer();
+  BVHTree *tree = BLI_bvhtree_new(num_tris, 0.0f, tree_type, axis);
+  for (int i = 0; i < num_tris; i++) {
+    BLI_bvhtree_insert(tree, i, &tris[i][0][0], 3);
+  }
+  BLI_bvhtree_balance(tree);
+  *r_time += PIL_check_seconds_timer() - init_time;
+  return tree;
+}
+
+static bool bvhtree_overlap_count_cb(void *UNUSED(userdata),
+                                     int index_a,
+                                     int index_b,
+                                     int UNUSED(thread))
+{
+  return index_a < index_b;
+}
+
+static void bvhtree_perf_test_do(const char *id,
+                                 const int num_tris,
+                                 const char tree_type,
+                                 const char axis)
+{
+  float(*tris)[3][3] = random_triangles_new(num_tris);
+  double build_time = 0.0, overlap_time = 0.0;
+  uint overlap_len = 0;
+
+  for (int i = 0; i < NUM_RUN_AVERAGED; i++) {
+    BVHTree *tree = bvhtree_from_triangles(tris, num_tris, tree_type, axis, &build_time);
+
+    const double init_time = PIL_check_seconds_timer();
+    BVHTreeOverlap *overlap = BLI_bvhtree_overlap(
+        tree, tree, &overlap_len, bvhtree_overlap_count_cb, NULL);
+    overlap_time += PIL_check_seconds_timer() - init_time;
+
+    MEM_SAFE_FREE(overlap);
+    BLI_bvhtree_free(tree);
+  }
+
+  RECORD_PERFORMANCE_TIME("build", build_time / NUM_RUN_AVERAGED);
+  RECORD_PERFORMANCE_TIME("self_overlap", overlap_time / NUM_RUN_AVERAGED);
+
+  printf("\t%s: build %fs, self overlap %fs (%u pairs) on average over %d runs\n",
+         id,
+         build_time / NUM_RUN_AVERAGED,
+         overlap_time / NUM_RUN_AVERAGED,
+         overlap_len,
+         NUM_RUN_AVERAGED);
+
+  MEM_freeN(tris);
+}
+
+TEST(kdopbvh, Perf100K_Tree2_AABB)
+{
+  bvhtree_perf_test_do("100K triangles, binary tree, 6-DOP", 100000, 2, 6);
+}
+
+TEST(kdopbvh, Perf1M_Tree2_AABB)
+{
+  bvhtree_perf_test_do("1M triangles, binary tree, 6-DOP", 1000000, 2, 6);
+}
+
+TEST(kdopbvh, Perf1M_Tree4_AABB)
+{
+  bvhtree_perf_test_do("1M triangles, quad tree, 6-DOP", 1000000, 4, 6);
+}
+
+TEST(kdopbvh, Perf1M_Tree4_26DOP)
+{
+  bvhtree_perf_test_do("1M triangles, quad tree, 26-DOP", 1000000, 4, 26);
+}
+
+static void bvhtree_raycast_tri_cb(void *userdata,
+                                   int index,
+                                   const BVHTreeRay *ray,
+                                   BVHTreeRayHit *hit)
+{
+  const float(*tris)[3][3] = (const float(*)[3][3])userdata;
+  float dist;
+  if (isect_ray_tri_v3(
+          ray->origin, ray->direction, tris[index][0], tris[index][1], tris[index][2], &dist, NULL) &&
+      dist < hit->dist) {
+    hit->index = index;
+    hit->dist = dist;
+  }
+}
+
+/* Rays on a grid below the triangles, cast upwards, like rays for neighboring pixels. */
+static void bvhtree_raycast_perf_test_do(const char *id,
+                                         const int num_tris,
+                                         const int grid_size,
+                                         const char tree_type)
+{
+  float(*tris)[3][3] = random_triangles_new(num_tris);
+  double build_time = 0.0, single_time = 0.0, batch_time = 0.0;
+  BVHTree *tree = bvhtree_from_triangles(tris, num_tris, tree_type, 6, &build_time);
+
+  const int rays_len = grid_size * grid_size;
+  float(*co)[3] = (float(*)[3])MEM_mallocN(sizeof(*co) * (size_t)rays_len, __func__);
+  float(*dir)[3] = (float(*)[3])MEM_mallocN(sizeof(*dir) * (size_t)rays_len, __func__);
+  BVHTreeRayHit *hits = (BVHTreeRayHit *)MEM_mallocN(sizeof(*hits) * (size_t)rays_len, __func__);
+  for (int y = 0; y < grid_size; y++) {
+    for (int x = 0; x < grid_size; x++) {
+      const int i = y * grid_size + x;
+      co[i][0] = ((float)x / (float)grid_size) * 2.0f - 1.0f;
+      co[i][1] = ((float)y / (float)grid_size) * 2.0f - 1.0f;
+      co[i][2] = -2.0f;
+      const float dir_init[3] = {0.1f * co[i][0], 0.1f * co[i][1], 1.0f};
+      normalize_v3_v3(dir[i], dir_init);
+    }
+  }
+
+  int single_hits_len = 0, batch_hits_len = 0;
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    double init_time = PIL_check_seconds_timer();
+    for (int i = 0; i < rays_len; i++) {
+      BVHTreeRayHit hit;
+      hit.index = -1;
+      hit.dist = BVH_RAYCAST_DIST_MAX;
+      if (BLI_bvhtree_ray_cast(tree, co[i], dir[i], 0.0f, &hit, bvhtree_raycast_tri_cb, tris) !=
+          -1) {
+        single_hits_len += (run == 0);
+      }
+    }
+    single_time += PIL_check_seconds_timer() - init_time;
+
+    for (int i = 0; i < rays_len; i++) {
+      hits[i].index = -1;
+      hits[i].dist = BVH_RAYCAST_DIST_MAX;
+    }
+    init_time = PIL_check_seconds_timer();
+    BLI_bvhtree_ray_cast_batch(
+        tree, co, dir, rays_len, 0.0f, hits, bvhtree_raycast_tri_cb, tris, BVH_RAYCAST_DEFAULT);
+    batch_time += PIL_check_seconds_timer() - init_time;
+    if (run == 0) {
+      for (int i = 0; i < rays_len; i++) {
+        batch_hits_len += (hits[i].index != -1);
+      }
+    }
+  }
+  EXPECT_EQ(single_hits_len, batch_hits_len);
+
+  RECORD_PERFORMANCE_TIME("ray_cast", single_time / NUM_RUN_AVERAGED);
+  RECORD_PERFORMANCE_TIME("ray_cast_batch", batch_time / NUM_RUN_AVERAGED);
+
+  printf("\t%s: %d rays one by one %fs, in a batch %fs (%d hits) on average over %d runs\n",
+         id,
+         rays_len,
+         single_time / NUM_RUN_AVERAGED,
+         batch_time / NUM_RUN_AVERAGED,
+         batch_hits_len,
+         NUM_RUN_AVERAGED);
+
+  BLI_bvhtree_free(tree);
+  MEM_freeN(co);
+  MEM_freeN(dir);
+  MEM_freeN(hits);
+  MEM_freeN(tris);
+}
+
+TEST(kdopbvh, PerfRayCast1M_Tree2)
+{
+  bvhtree_raycast_perf_test_do("1M triangles, binary tree", 1000000, 1000, 2);
+}
+
+TEST(kdopbvh, PerfRayCast1M_Tree4)
+{
+  bvhtree_raycast_perf_test_do("1M triangles, quad tree", 1000000, 1000, 4);
+}
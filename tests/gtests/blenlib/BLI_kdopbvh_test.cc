@@ -10,6 +10,7 @@ extern "C" {
 #include "BLI_compiler_attrs.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_rand.h"
+#include "BLI_math_base.h"
 #include "BLI_math_vector.h"
 }
 
@@ -136,3 +137,182 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+/* -------------------------------------------------------------------- */
+/* Overlap */
+
+static bool overlap_count_cb(void *userdata, int index_a, int index_b, int UNUSED(thread))
+{
+  const float(*bounds)[2][3] = (const float(*)[2][3])userdata;
+  for (int axis = 0; axis < 3; axis++) {
+    EXPECT_LE(bounds[index_a][0][axis], bounds[index_b][1][axis]);
+    EXPECT_LE(bounds[index_b][0][axis], bounds[index_a][1][axis]);
+  }
+  return index_a < index_b;
+}
+
+/**
+ * Compare the overlapping pairs of a tree with itself with a brute force test of all pairs,
+ * the branches of the tree must contain all their leafs for no pair to be missed.
+ */
+static void overlap_self_test(int boxes_len, char tree_type, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(boxes_len, 0.0, tree_type, 6);
+  const float epsilon = BLI_bvhtree_get_epsilon(tree);
+
+  float(*bounds)[2][3] = (float(*)[2][3])MEM_mallocN(sizeof(*bounds) * boxes_len, __func__);
+
+  for (int i = 0; i < boxes_len; i++) {
+    float co[2][3];
+    rng_v3_round(co[0], 6, rng, 1000, 1.0f);
+    mul_v3_fl(co[1], 0.05f);
+    add_v3_v3(co[1], co[0]);
+    BLI_bvhtree_insert(tree, i, co[0], 2);
+
+    for (int axis = 0; axis < 3; axis++) {
+      bounds[i][0][axis] = min_ff(co[0][axis], co[1][axis]) - epsilon;
+      bounds[i][1][axis] = max_ff(co[0][axis], co[1][axis]) + epsilon;
+    }
+  }
+  BLI_bvhtree_balance(tree);
+
+  uint overlap_len = 0;
+  BVHTreeOverlap *overlap = BLI_bvhtree_overlap(
+      tree, tree, &overlap_len, overlap_count_cb, bounds);
+
+  uint overlap_len_expect = 0;
+  for (int i = 0; i < boxes_len; i++) {
+    for (int j = i + 1; j < boxes_len; j++) {
+      bool isect = true;
+      for (int axis = 0; axis < 3; axis++) {
+        if (bounds[i][0][axis] > bounds[j][1][axis] || bounds[j][0][axis] > bounds[i][1][axis]) {
+          isect = false;
+        }
+      }
+      overlap_len_expect += isect;
+    }
+  }
+  EXPECT_EQ(overlap_len, overlap_len_expect);
+
+  MEM_SAFE_FREE(overlap);
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(bounds);
+}
+
+TEST(kdopbvh, OverlapSelf_Tree2)
+{
+  overlap_self_test(1000, 2, 1);
+}
+TEST(kdopbvh, OverlapSelf_Tree4)
+{
+  overlap_self_test(1000, 4, 2);
+}
+TEST(kdopbvh, OverlapSelf_Tree8)
+{
+  overlap_self_test(1000, 8, 3);
+}
+
+/* -------------------------------------------------------------------- */
+/* Ray Cast Packets */
+
+#define RAYCAST_POINT_RADIUS 0.05f
+
+/* Intersect the ray with a sphere around the point. */
+static void raycast_sphere_cb(void *userdata, int index, const BVHTreeRay *ray, BVHTreeRayHit *hit)
+{
+  const float(*points)[3] = (const float(*)[3])userdata;
+  float co[3], closest[3];
+
+  sub_v3_v3v3(co, points[index], ray->origin);
+  const float dist = dot_v3v3(co, ray->direction);
+  madd_v3_v3v3fl(closest, ray->origin, ray->direction, dist);
+
+  if (dist >= 0.0f && dist < hit->dist &&
+      len_squared_v3v3(closest, points[index]) < SQUARE(RAYCAST_POINT_RADIUS)) {
+    hit->index = index;
+    hit->dist = dist;
+    copy_v3_v3(hit->co, closest);
+  }
+}
+
+/**
+ * Compare the hits of rays cast in a batch with the hits of the same rays cast one by one.
+ */
+static void raycast_batch_test(
+    int points_len, int rays_len, bool use_callback, float radius, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, RAYCAST_POINT_RADIUS, 4, 6);
+
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(*points) * points_len, __func__);
+  for (int i = 0; i < points_len; i++) {
+    rng_v3_round(points[i], 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  float(*ray_co)[3] = (float(*)[3])MEM_mallocN(sizeof(*ray_co) * rays_len, __func__);
+  float(*ray_dir)[3] = (float(*)[3])MEM_mallocN(sizeof(*ray_dir) * rays_len, __func__);
+  BVHTreeRayHit *hits = (BVHTreeRayHit *)MEM_mallocN(sizeof(*hits) * rays_len, __func__);
+  for (int i = 0; i < rays_len; i++) {
+    rng_v3_round(ray_co[i], 3, rng, 1000, 2.0f);
+    if (i % 2) {
+      BLI_rng_get_float_unit_v3(rng, ray_dir[i]);
+    }
+    else {
+      /* Aim half of the rays at a point, so they hit something even with few points. */
+      sub_v3_v3v3(ray_dir[i], points[BLI_rng_get_uint(rng) % (uint)points_len], ray_co[i]);
+      normalize_v3(ray_dir[i]);
+    }
+    hits[i].index = -1;
+    hits[i].dist = BVH_RAYCAST_DIST_MAX;
+  }
+
+  BVHTree_RayCastCallback callback = use_callback ? raycast_sphere_cb : NULL;
+  BLI_bvhtree_ray_cast_batch(
+      tree, ray_co, ray_dir, rays_len, radius, hits, callback, points, BVH_RAYCAST_DEFAULT);
+
+  int hits_len = 0;
+  for (int i = 0; i < rays_len; i++) {
+    BVHTreeRayHit hit;
+    hit.index = -1;
+    hit.dist = BVH_RAYCAST_DIST_MAX;
+    BLI_bvhtree_ray_cast(tree, ray_co[i], ray_dir[i], radius, &hit, callback, points);
+
+    EXPECT_EQ(hits[i].index, hit.index);
+    if (hit.index != -1) {
+      EXPECT_EQ(hits[i].dist, hit.dist);
+      EXPECT_EQ_ARRAY(hits[i].co, hit.co, 3);
+      hits_len++;
+    }
+  }
+  /* Ensure the test isn't trivially passing. */
+  EXPECT_GT(hits_len, 0);
+  EXPECT_LT(hits_len, rays_len);
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+  MEM_freeN(ray_co);
+  MEM_freeN(ray_dir);
+  MEM_freeN(hits);
+}
+
+TEST(kdopbvh, RayCastBatch_Bounds)
+{
+  raycast_batch_test(1000, 2001, false, 0.0f, 1);
+}
+TEST(kdopbvh, RayCastBatch_Callback)
+{
+  raycast_batch_test(1000, 2001, true, 0.0f, 2);
+}
+TEST(kdopbvh, RayCastBatch_Radius)
+{
+  raycast_batch_test(1000, 2001, true, 0.01f, 3);
+}
+TEST(kdopbvh, RayCastBatch_Single)
+{
+  raycast_batch_test(1, 3, false, 0.0f, 4);
+}
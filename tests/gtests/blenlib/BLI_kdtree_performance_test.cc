@@ -0,0 +1,110 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+
+#include "PIL_time.h"
+}
+
+#define NUM_RUN_AVERAGED 5
+
+/* Points in a unit cube, every one of them has a few others close to it,
+ * similar to a mesh with overlapping geometry which is merged by distance. */
+static float (*clustered_points_new(const int points_len, const int cluster_size))[3]
+{
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(*points) * (size_t)points_len, __func__);
+  RNG *rng = BLI_rng_new(0);
+  float center[3] = {0.0f, 0.0f, 0.0f};
+  for (int i = 0; i < points_len; i++) {
+    if (i % cluster_size == 0) {
+      for (int j = 0; j < 3; j++) {
+        center[j] = BLI_rng_get_float(rng);
+      }
+    }
+    for (int j = 0; j < 3; j++) {
+      points[i][j] = center[j] + (BLI_rng_get_float(rng) - 0.5f) * 1e-4f;
+    }
+  }
+  BLI_rng_free(rng);
+  return points;
+}
+
+static void kdtree_calc_duplicates_perf_test_do(const char *id,
+                                                const int points_len,
+                                                const int cluster_size,
+                                                const bool use_index_order)
+{
+  float(*points)[3] = clustered_points_new(points_len, cluster_size);
+  KDTree_3d *tree = BLI_kdtree_3d_new((uint)points_len);
+  for (int i = 0; i < points_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, points[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  int *duplicates_single = (int *)MEM_mallocN(sizeof(int) * (size_t)points_len, __func__);
+  int *duplicates_threaded = (int *)MEM_mallocN(sizeof(int) * (size_t)points_len, __func__);
+  const float range = 1e-3f;
+  double single_time = 0.0, threaded_time = 0.0;
+  int found_single = 0, found_threaded = 0;
+
+  for (int run = 0; run < NUM_RUN_AVERAGED; run++) {
+    copy_vn_i(duplicates_single, points_len, -1);
+    double init_time = PIL_check_seconds_timer();
+    found_single = BLI_kdtree_3d_calc_duplicates_fast_ex(
+        tree, range, use_index_order, false, duplicates_single);
+    single_time += PIL_check_seconds_timer() - init_time;
+
+    copy_vn_i(duplicates_threaded, points_len, -1);
+    init_time = PIL_check_seconds_timer();
+    found_threaded = BLI_kdtree_3d_calc_duplicates_fast_ex(
+        tree, range, use_index_order, true, duplicates_threaded);
+    threaded_time += PIL_check_seconds_timer() - init_time;
+  }
+
+  EXPECT_EQ(found_single, found_threaded);
+  EXPECT_EQ(
+      memcmp(duplicates_single, duplicates_threaded, sizeof(int) * (size_t)points_len), 0);
+
+  RECORD_PERFORMANCE_TIME("single_threaded", single_time / NUM_RUN_AVERAGED);
+  RECORD_PERFORMANCE_TIME("multi_threaded", threaded_time / NUM_RUN_AVERAGED);
+
+  printf("\t%s: single threaded %fs, multi-threaded %fs (%d duplicates) on average over %d runs\n",
+         id,
+         single_time / NUM_RUN_AVERAGED,
+         threaded_time / NUM_RUN_AVERAGED,
+         found_threaded,
+         NUM_RUN_AVERAGED);
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(duplicates_single);
+  MEM_freeN(duplicates_threaded);
+  MEM_freeN(points);
+}
+
+TEST(kdtree, PerfCalcDuplicates100K)
+{
+  kdtree_calc_duplicates_perf_test_do("100K points, pairs", 100000, 2, false);
+}
+
+TEST(kdtree, PerfCalcDuplicates1M)
+{
+  kdtree_calc_duplicates_perf_test_do("1M points, pairs", 1000000, 2, false);
+}
+
+TEST(kdtree, PerfCalcDuplicates1M_Clusters)
+{
+  kdtree_calc_duplicates_perf_test_do("1M points, clusters of 8", 1000000, 8, false);
+}
+
+TEST(kdtree, PerfCalcDuplicates1M_IndexOrder)
+{
+  kdtree_calc_duplicates_perf_test_do("1M points, pairs, index order", 1000000, 2, true);
+}
@@ -0,0 +1,178 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.h"
+}
+
+#define SEARCH_RANGE 0.05f
+
+static float (*random_points_new(const int points_len, const int random_seed))[3]
+{
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(*points) * points_len, __func__);
+  RNG *rng = BLI_rng_new(random_seed);
+  for (int i = 0; i < points_len; i++) {
+    for (int j = 0; j < 3; j++) {
+      points[i][j] = BLI_rng_get_float(rng);
+    }
+  }
+  BLI_rng_free(rng);
+  return points;
+}
+
+static KDTree_3d *kdtree_from_points(const float (*points)[3], const int points_len)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(points_len);
+  for (int i = 0; i < points_len; i++) {
+    BLI_kdtree_3d_insert(tree, i, points[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+  return tree;
+}
+
+/**
+ * Compare the nearest point with a brute force search,
+ * large trees are balanced using multiple threads.
+ */
+static void find_nearest_test(const int points_len, const int random_seed)
+{
+  float(*points)[3] = random_points_new(points_len, random_seed);
+  float(*search)[3] = random_points_new(100, random_seed + 1);
+  KDTree_3d *tree = kdtree_from_points(points, points_len);
+
+  for (int i = 0; i < 100; i++) {
+    int index_expect = -1;
+    float dist_sq_expect = FLT_MAX;
+    for (int j = 0; j < points_len; j++) {
+      const float dist_sq = len_squared_v3v3(search[i], points[j]);
+      if (dist_sq < dist_sq_expect) {
+        dist_sq_expect = dist_sq;
+        index_expect = j;
+      }
+    }
+
+    KDTreeNearest_3d nearest;
+    EXPECT_EQ(BLI_kdtree_3d_find_nearest(tree, search[i], &nearest), index_expect);
+    EXPECT_EQ(nearest.index, index_expect);
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(points);
+  MEM_freeN(search);
+}
+
+TEST(kdtree, FindNearest_Small)
+{
+  find_nearest_test(1000, 1);
+}
+
+TEST(kdtree, FindNearest_Threaded)
+{
+  find_nearest_test(100000, 2);
+}
+
+struct RangeSearchBatchData {
+  const KDTree_3d *tree;
+  const float (*search)[3];
+  int *found_len;
+};
+
+static void range_search_batch_cb(void *user_data,
+                                  uint co_index,
+                                  const KDTreeNearest_3d *nearest,
+                                  int nearest_len)
+{
+  RangeSearchBatchData *data = (RangeSearchBatchData *)user_data;
+  KDTreeNearest_3d *nearest_expect;
+  const int nearest_len_expect = BLI_kdtree_3d_range_search(
+      data->tree, data->search[co_index], &nearest_expect, SEARCH_RANGE);
+
+  EXPECT_EQ(nearest_len, nearest_len_expect);
+  for (int i = 0; i < min_ii(nearest_len, nearest_len_expect); i++) {
+    EXPECT_EQ(nearest[i].dist, nearest_expect[i].dist);
+    if (i > 0) {
+      EXPECT_LE(nearest[i - 1].dist, nearest[i].dist);
+    }
+  }
+  data->found_len[co_index] = nearest_len;
+
+  MEM_SAFE_FREE(nearest_expect);
+}
+
+TEST(kdtree, RangeSearchBatch)
+{
+  const int points_len = 20000, search_len = 5000;
+  float(*points)[3] = random_points_new(points_len, 3);
+  float(*search)[3] = random_points_new(search_len, 4);
+  KDTree_3d *tree = kdtree_from_points(points, points_len);
+
+  RangeSearchBatchData data;
+  data.tree = tree;
+  data.search = search;
+  data.found_len = (int *)MEM_callocN(sizeof(int) * search_len, __func__);
+
+  BLI_kdtree_3d_range_search_batch(
+      tree, search, search_len, SEARCH_RANGE, range_search_batch_cb, &data);
+
+  int found_total = 0;
+  for (int i = 0; i < search_len; i++) {
+    found_total += data.found_len[i];
+  }
+  /* Ensure the test isn't trivially passing. */
+  EXPECT_GT(found_total, search_len);
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(data.found_len);
+  MEM_freeN(points);
+  MEM_freeN(search);
+}
+
+/**
+ * Large trees search for duplicates on multiple threads,
+ * this must give the same result as the single threaded search.
+ */
+static void calc_duplicates_fast_test(const bool use_index_order)
+{
+  const int points_len = 50000;
+  float(*points)[3] = random_points_new(points_len, 5);
+  KDTree_3d *tree = kdtree_from_points(points, points_len);
+
+  int *duplicates_expect = (int *)MEM_mallocN(sizeof(int) * points_len, __func__);
+  int *duplicates = (int *)MEM_mallocN(sizeof(int) * points_len, __func__);
+  copy_vn_i(duplicates_expect, points_len, -1);
+  copy_vn_i(duplicates, points_len, -1);
+
+  const float range = 0.01f;
+  const int found_expect = BLI_kdtree_3d_calc_duplicates_fast_ex(
+      tree, range, use_index_order, false, duplicates_expect);
+  const int found = BLI_kdtree_3d_calc_duplicates_fast_ex(
+      tree, range, use_index_order, true, duplicates);
+
+  /* Ensure the test isn't trivially passing. */
+  EXPECT_GT(found_expect, 0);
+  EXPECT_EQ(found, found_expect);
+  for (int i = 0; i < points_len; i++) {
+    EXPECT_EQ(duplicates[i], duplicates_expect[i]);
+  }
+
+  BLI_kdtree_3d_free(tree);
+  MEM_freeN(duplicates_expect);
+  MEM_freeN(duplicates);
+  MEM_freeN(points);
+}
+
+TEST(kdtree, CalcDuplicatesFast_Threaded)
+{
+  calc_duplicates_fast_test(false);
+}
+
+TEST(kdtree, CalcDuplicatesFast_Threaded_IndexOrder)
+{
+  calc_duplicates_fast_test(true);
+}
@@ -19,3 +19,43 @@ TEST(math_geom, DistToLineSegment2DSimple)
   float distance = dist_to_line_segment_v2(p, a, b);
   EXPECT_NEAR(sqrtf(2.0f), distance, 1e-6);
 }
+
+TEST(math_geom, IsectRayTriWatertightX4)
+{
+  const float ray_origin[3] = {0.1f, 0.2f, 5.0f};
+  const float ray_direction[3] = {0.05f, -0.1f, -1.0f};
+  struct IsectRayPrecalc isect_precalc;
+  isect_ray_tri_watertight_v3_precalc(&isect_precalc, ray_direction);
+
+  /* Hit, hit from the back, miss and degenerate triangles, in all lanes. */
+  const float tris[4][3][3] = {
+      {{-1.0f, -1.0f, 0.0f}, {1.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+      {{-1.0f, -1.0f, 1.0f}, {0.0f, 1.0f, 1.0f}, {1.0f, -1.0f, 1.0f}},
+      {{2.0f, 2.0f, 0.0f}, {3.0f, 2.0f, 0.0f}, {2.0f, 3.0f, 0.0f}},
+      {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {2.0f, 2.0f, 0.0f}},
+  };
+
+  for (int offset = 0; offset < 4; offset++) {
+    const float *v0[4], *v1[4], *v2[4];
+    for (int i = 0; i < 4; i++) {
+      v0[i] = tris[(i + offset) % 4][0];
+      v1[i] = tris[(i + offset) % 4][1];
+      v2[i] = tris[(i + offset) % 4][2];
+    }
+
+    float lambda[4];
+    const int hits = isect_ray_tri_watertight_v3_x4(
+        ray_origin, &isect_precalc, v0, v1, v2, lambda);
+
+    for (int i = 0; i < 4; i++) {
+      float lambda_expect;
+      const bool hit = isect_ray_tri_watertight_v3(
+          ray_origin, &isect_precalc, v0[i], v1[i], v2[i], &lambda_expect, NULL);
+      EXPECT_EQ(hit, (hits & (1 << i)) != 0);
+      if (hit) {
+        EXPECT_EQ(lambda_expect, lambda[i]);
+      }
+    }
+    EXPECT_EQ(hits & (1 << ((4 - offset) % 4)), 1 << ((4 - offset) % 4));
+  }
+}
@@ -0,0 +1,78 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_math.h"
+#include "BLI_rand.h"
+
+/* Odd size, so both the SIMD and the scalar code paths of array functions are used. */
+#define ARRAY_LEN 23
+
+static void fill_random_v3_array(float (*arr)[3], const int nbr, const unsigned int seed)
+{
+  RNG *rng = BLI_rng_new(seed);
+  for (int i = 0; i < nbr; i++) {
+    for (int j = 0; j < 3; j++) {
+      arr[i][j] = BLI_rng_get_float(rng) * 20.0f - 10.0f;
+    }
+  }
+  BLI_rng_free(rng);
+}
+
+static void test_matrix_init(float mat[4][4])
+{
+  const float loc[3] = {1.0f, -2.0f, 3.5f};
+  const float rot[3] = {0.3f, -1.2f, 2.0f};
+  const float size[3] = {2.0f, 0.5f, -1.5f};
+  loc_eul_size_to_mat4(mat, loc, rot, size);
+}
+
+TEST(math_matrix, MulM4V3Array)
+{
+  float mat[4][4];
+  float arr[ARRAY_LEN][3], arr_orig[ARRAY_LEN][3];
+  test_matrix_init(mat);
+  fill_random_v3_array(arr_orig, ARRAY_LEN, 0);
+  memcpy(arr, arr_orig, sizeof(arr));
+
+  mul_m4_v3_array(mat, arr, ARRAY_LEN);
+
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    float r_expect[3];
+    mul_v3_m4v3(r_expect, mat, arr_orig[i]);
+    EXPECT_V3_NEAR(arr[i], r_expect, 1e-5f);
+  }
+}
+
+TEST(math_matrix, MulV3M4V3Array)
+{
+  float mat[4][4];
+  float arr[ARRAY_LEN][3], r_arr[ARRAY_LEN][3];
+  test_matrix_init(mat);
+  fill_random_v3_array(arr, ARRAY_LEN, 1);
+
+  mul_v3_m4v3_array(r_arr, mat, arr, ARRAY_LEN);
+
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    float r_expect[3];
+    mul_v3_m4v3(r_expect, mat, arr[i]);
+    EXPECT_V3_NEAR(r_arr[i], r_expect, 1e-5f);
+  }
+}
+
+TEST(math_matrix, MulMat3M4V3Array)
+{
+  float mat[4][4];
+  float arr[ARRAY_LEN][3], arr_orig[ARRAY_LEN][3];
+  test_matrix_init(mat);
+  fill_random_v3_array(arr_orig, ARRAY_LEN, 2);
+  memcpy(arr, arr_orig, sizeof(arr));
+
+  mul_mat3_m4_v3_array(mat, arr, ARRAY_LEN);
+
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    float r_expect[3];
+    mul_v3_mat3_m4v3(r_expect, mat, arr_orig[i]);
+    EXPECT_V3_NEAR(arr[i], r_expect, 1e-5f);
+  }
+}
@@ -0,0 +1,56 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_math.h"
+#include "BLI_rand.h"
+
+/* Odd size, so both the SIMD and the scalar code paths of array functions are used. */
+#define ARRAY_LEN 23
+
+static void fill_random_v3_array(float (*arr)[3], const int nbr, const unsigned int seed)
+{
+  RNG *rng = BLI_rng_new(seed);
+  for (int i = 0; i < nbr; i++) {
+    for (int j = 0; j < 3; j++) {
+      arr[i][j] = BLI_rng_get_float(rng) * 20.0f - 10.0f;
+    }
+  }
+  BLI_rng_free(rng);
+}
+
+TEST(math_vector, NormalizeArray)
+{
+  float arr[ARRAY_LEN][3], arr_expect[ARRAY_LEN][3];
+  fill_random_v3_array(arr, ARRAY_LEN, 0);
+  /* Vectors too small to normalize become zero. */
+  zero_v3(arr[1]);
+  copy_v3_fl(arr[6], 1e-20f);
+
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    normalize_v3_v3(arr_expect[i], arr[i]);
+  }
+  normalize_v3_array(arr, ARRAY_LEN);
+
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    EXPECT_V3_NEAR(arr[i], arr_expect[i], 1e-6f);
+  }
+  const float zero[3] = {0.0f, 0.0f, 0.0f};
+  EXPECT_V3_NEAR(arr[1], zero, 0.0f);
+  EXPECT_V3_NEAR(arr[6], zero, 0.0f);
+}
+
+TEST(math_vector, CrossArray)
+{
+  float a[ARRAY_LEN][3], b[ARRAY_LEN][3], r[ARRAY_LEN][3];
+  fill_random_v3_array(a, ARRAY_LEN, 1);
+  fill_random_v3_array(b, ARRAY_LEN, 2);
+
+  cross_v3_v3v3_array(r, a, b, ARRAY_LEN);
+
+  for (int i = 0; i < ARRAY_LEN; i++) {
+    float r_expect[3];
+    cross_v3_v3v3(r_expect, a[i], b[i]);
+    EXPECT_V3_NEAR(r[i], r_expect, 1e-5f);
+  }
+}
@@ -0,0 +1,176 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+#include "BLI_ohash.h"
+#include "BLI_string.h"
+}
+
+#define TESTCASE_SIZE 10000
+
+/* Distinct keys spread over the whole integer range, including zero (a NULL key). */
+static unsigned int test_key(const unsigned int i)
+{
+  return i * 2654435761u;
+}
+
+TEST(ohash, InsertLookup)
+{
+  OHash *ohash = BLI_ohash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+
+  for (unsigned int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_ohash_insert(ohash, POINTER_FROM_UINT(test_key(i)), POINTER_FROM_UINT(i));
+  }
+
+  EXPECT_EQ(BLI_ohash_len(ohash), TESTCASE_SIZE);
+
+  for (unsigned int i = 0; i < TESTCASE_SIZE; i++) {
+    void **v_p = BLI_ohash_lookup_p(ohash, POINTER_FROM_UINT(test_key(i)));
+    EXPECT_NE(v_p, nullptr);
+    EXPECT_EQ(POINTER_AS_UINT(*v_p), i);
+  }
+  EXPECT_FALSE(BLI_ohash_haskey(ohash, POINTER_FROM_UINT(test_key(TESTCASE_SIZE))));
+  EXPECT_EQ(BLI_ohash_lookup_default(
+                ohash, POINTER_FROM_UINT(test_key(TESTCASE_SIZE)), POINTER_FROM_INT(-1)),
+            POINTER_FROM_INT(-1));
+
+  BLI_ohash_free(ohash, NULL, NULL);
+}
+
+/* Remove every other key, the remaining ones must still be reachable. */
+TEST(ohash, InsertRemove)
+{
+  OHash *ohash = BLI_ohash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+
+  for (unsigned int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_ohash_insert(ohash, POINTER_FROM_UINT(test_key(i)), POINTER_FROM_UINT(i));
+  }
+
+  for (unsigned int i = 0; i < TESTCASE_SIZE; i += 2) {
+    void *v = BLI_ohash_popkey(ohash, POINTER_FROM_UINT(test_key(i)), NULL);
+    EXPECT_EQ(POINTER_AS_UINT(v), i);
+  }
+  EXPECT_EQ(BLI_ohash_len(ohash), TESTCASE_SIZE / 2);
+
+  for (unsigned int i = 0; i < TESTCASE_SIZE; i++) {
+    EXPECT_EQ(BLI_ohash_haskey(ohash, POINTER_FROM_UINT(test_key(i))), (i % 2) != 0);
+  }
+
+  for (unsigned int i = 1; i < TESTCASE_SIZE; i += 2) {
+    EXPECT_TRUE(BLI_ohash_remove(ohash, POINTER_FROM_UINT(test_key(i)), NULL, NULL));
+  }
+  EXPECT_FALSE(BLI_ohash_remove(ohash, POINTER_FROM_UINT(test_key(1)), NULL, NULL));
+  EXPECT_EQ(BLI_ohash_len(ohash), 0);
+
+  BLI_ohash_free(ohash, NULL, NULL);
+}
+
+/* A constant hash puts all keys in one probe sequence, stressing the backward shift on removal. */
+static unsigned int ohash_tests_constant_hash_p(const void *UNUSED(p))
+{
+  return 7;
+}
+
+TEST(ohash, RemoveCollisions)
+{
+  OHash *ohash = BLI_ohash_new(ohash_tests_constant_hash_p, BLI_ghashutil_intcmp, __func__);
+  const unsigned int nbr = 100;
+
+  for (unsigned int i = 0; i < nbr; i++) {
+    BLI_ohash_insert(ohash, POINTER_FROM_UINT(i), POINTER_FROM_UINT(i));
+  }
+  for (unsigned int i = 0; i < nbr; i += 3) {
+    EXPECT_TRUE(BLI_ohash_remove(ohash, POINTER_FROM_UINT(i), NULL, NULL));
+  }
+  for (unsigned int i = 0; i < nbr; i++) {
+    EXPECT_EQ(BLI_ohash_haskey(ohash, POINTER_FROM_UINT(i)), (i % 3) != 0);
+  }
+
+  BLI_ohash_free(ohash, NULL, NULL);
+}
+
+TEST(ohash, EnsureReinsert)
+{
+  OHash *ohash = BLI_ohash_new(BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__);
+  void **v_p;
+
+  for (unsigned int i = 0; i < TESTCASE_SIZE; i++) {
+    const bool haskey = BLI_ohash_ensure_p(ohash, POINTER_FROM_UINT(i % 100), &v_p);
+    EXPECT_EQ(haskey, i >= 100);
+    if (!haskey) {
+      *v_p = POINTER_FROM_UINT(0);
+    }
+    *v_p = POINTER_FROM_UINT(POINTER_AS_UINT(*v_p) + 1);
+  }
+  EXPECT_EQ(BLI_ohash_len(ohash), 100);
+  EXPECT_EQ(POINTER_AS_UINT(BLI_ohash_lookup(ohash, POINTER_FROM_UINT(42))), TESTCASE_SIZE / 100);
+
+  EXPECT_FALSE(BLI_ohash_reinsert(ohash, POINTER_FROM_UINT(42), POINTER_FROM_UINT(1), NULL, NULL));
+  EXPECT_TRUE(
+      BLI_ohash_reinsert(ohash, POINTER_FROM_UINT(1000), POINTER_FROM_UINT(2), NULL, NULL));
+  EXPECT_EQ(POINTER_AS_UINT(BLI_ohash_lookup(ohash, POINTER_FROM_UINT(42))), 1);
+  EXPECT_EQ(BLI_ohash_len(ohash), 101);
+
+  BLI_ohash_free(ohash, NULL, NULL);
+}
+
+TEST(ohash, Iterator)
+{
+  OHash *ohash = BLI_ohash_new_ex(
+      BLI_ghashutil_inthash_p, BLI_ghashutil_intcmp, __func__, TESTCASE_SIZE);
+  OHashIterator ohi;
+  unsigned int sum_expected = 0, sum = 0, len = 0;
+
+  for (unsigned int i = 0; i < TESTCASE_SIZE; i++) {
+    BLI_ohash_insert(ohash, POINTER_FROM_UINT(i), POINTER_FROM_UINT(i * 2));
+    sum_expected += i;
+  }
+
+  OHASH_ITER (ohi, ohash) {
+    const unsigned int key = POINTER_AS_UINT(BLI_ohashIterator_getKey(&ohi));
+    EXPECT_EQ(POINTER_AS_UINT(BLI_ohashIterator_getValue(&ohi)), key * 2);
+    sum += key;
+    len++;
+  }
+  EXPECT_EQ(len, TESTCASE_SIZE);
+  EXPECT_EQ(sum, sum_expected);
+
+  BLI_ohash_clear(ohash, NULL, NULL);
+  EXPECT_EQ(BLI_ohash_len(ohash), 0);
+  BLI_ohashIterator_init(&ohi, ohash);
+  EXPECT_TRUE(BLI_ohashIterator_done(&ohi));
+
+  BLI_ohash_free(ohash, NULL, NULL);
+}
+
+TEST(oset, StringKeys)
+{
+  OSet *oset = BLI_oset_new(BLI_ghashutil_strhash_p, BLI_ghashutil_strcmp, __func__);
+  const char *words[] = {"zero", "one", "two", "three", "four"};
+  const unsigned int words_len = ARRAY_SIZE(words);
+
+  for (unsigned int i = 0; i < words_len; i++) {
+    EXPECT_TRUE(BLI_oset_add(oset, BLI_strdup(words[i])));
+  }
+  EXPECT_FALSE(BLI_oset_add(oset, (void *)"two"));
+  EXPECT_EQ(BLI_oset_len(oset), words_len);
+  EXPECT_TRUE(BLI_oset_haskey(oset, "three"));
+  EXPECT_FALSE(BLI_oset_haskey(oset, "five"));
+
+  EXPECT_TRUE(BLI_oset_remove(oset, "three", MEM_freeN));
+  EXPECT_FALSE(BLI_oset_haskey(oset, "three"));
+
+  OSetIterator osi;
+  unsigned int len = 0;
+  OSET_ITER (osi, oset) {
+    EXPECT_STRNE((const char *)BLI_osetIterator_getKey(&osi), "three");
+    len++;
+  }
+  EXPECT_EQ(len, words_len - 1);
+
+  BLI_oset_free(oset, MEM_freeN);
+}
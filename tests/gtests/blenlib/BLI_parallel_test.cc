@@ -0,0 +1,136 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "atomic_ops.h"
+
+#include "BLI_parallel.h"
+#include "BLI_vector.h"
+
+using BLI::IndexRange;
+using IntVector = BLI::Vector<int>;
+
+TEST(parallel, ForEmptyRange)
+{
+  BLI_threadapi_init();
+
+  int calls = 0;
+  BLI::parallel_for(IndexRange(), 1, [&](IndexRange UNUSED(range)) { calls++; });
+  EXPECT_EQ(calls, 0);
+
+  BLI_threadapi_exit();
+}
+
+TEST(parallel, ForCoversRangeOnce)
+{
+  BLI_threadapi_init();
+
+  IntVector values(10000, 0);
+  BLI::parallel_for(IndexRange(5, 9990), 16, [&](IndexRange range) {
+    EXPECT_GE(range.size(), 1);
+    for (uint i : range) {
+      atomic_add_and_fetch_int32(&values[i], 1);
+    }
+  });
+
+  for (uint i = 0; i < values.size(); i++) {
+    EXPECT_EQ(values[i], (i >= 5 && i < 9995) ? 1 : 0);
+  }
+
+  BLI_threadapi_exit();
+}
+
+TEST(parallel, ForSmallRangeNotSplit)
+{
+  BLI_threadapi_init();
+
+  int calls = 0;
+  BLI::parallel_for(IndexRange(100), 1000, [&](IndexRange range) {
+    EXPECT_EQ(range, IndexRange(100));
+    calls++;
+  });
+  EXPECT_EQ(calls, 1);
+
+  BLI_threadapi_exit();
+}
+
+TEST(parallel, ReduceSum)
+{
+  BLI_threadapi_init();
+
+  IntVector values;
+  for (int i = 0; i < 100000; i++) {
+    values.append(i % 7);
+  }
+
+  int expected_sum = 0;
+  for (int value : values) {
+    expected_sum += value;
+  }
+
+  const int sum = BLI::parallel_reduce(
+      IndexRange(values.size()),
+      64,
+      0,
+      [&](IndexRange range, int partial_sum) {
+        for (uint i : range) {
+          partial_sum += values[i];
+        }
+        return partial_sum;
+      },
+      [](int a, int b) { return a + b; });
+  EXPECT_EQ(sum, expected_sum);
+
+  BLI_threadapi_exit();
+}
+
+TEST(parallel, ReduceEmptyRange)
+{
+  BLI_threadapi_init();
+
+  const int result = BLI::parallel_reduce(
+      IndexRange(),
+      1,
+      42,
+      [](IndexRange UNUSED(range), int value) { return value + 1; },
+      [](int a, int b) { return a + b; });
+  EXPECT_EQ(result, 42);
+
+  BLI_threadapi_exit();
+}
+
+TEST(parallel, ReduceMinMax)
+{
+  BLI_threadapi_init();
+
+  IntVector values;
+  for (int i = 0; i < 50000; i++) {
+    values.append((i * 7919) % 50021 - 25000);
+  }
+
+  int expected_min = values[0], expected_max = values[0];
+  for (int value : values) {
+    expected_min = std::min(expected_min, value);
+    expected_max = std::max(expected_max, value);
+  }
+
+  using MinMax = std::pair<int, int>;
+  const MinMax result = BLI::parallel_reduce(
+      IndexRange(values.size()),
+      128,
+      MinMax(INT_MAX, INT_MIN),
+      [&](IndexRange range, MinMax minmax) {
+        for (uint i : range) {
+          minmax.first = std::min(minmax.first, values[i]);
+          minmax.second = std::max(minmax.second, values[i]);
+        }
+        return minmax;
+      },
+      [](const MinMax &a, const MinMax &b) {
+        return MinMax(std::min(a.first, b.first), std::max(a.second, b.second));
+      });
+  EXPECT_EQ(result.first, expected_min);
+  EXPECT_EQ(result.second, expected_max);
+
+  BLI_threadapi_exit();
+}
@@ -65,6 +65,8 @@ static void task_parallel_range_test_do(const char *id,
     averaged_timing += PIL_check_seconds_timer() - init_time;
   }
 
+  RECORD_PERFORMANCE_TIME("non_pooled", averaged_timing / NUM_RUN_AVERAGED);
+
   printf("\t%s: non-pooled done in %fs on average over %d runs\n",
          id,
          averaged_timing / NUM_RUN_AVERAGED,
@@ -83,6 +85,8 @@ static void task_parallel_range_test_do(const char *id,
     averaged_timing += PIL_check_seconds_timer() - init_time;
   }
 
+  RECORD_PERFORMANCE_TIME("pooled", averaged_timing / NUM_RUN_AVERAGED);
+
   printf("\t%s: pooled done in %fs on average over %d runs\n",
          id,
          averaged_timing / NUM_RUN_AVERAGED,
@@ -217,6 +221,8 @@ static void task_listbase_test_do(ListBase *list,
     *num_items_tmp = num_items;
   }
 
+  RECORD_PERFORMANCE_TIME(id, averaged_timing / NUM_RUN_AVERAGED);
+
   printf("\t%s: done in %fs on average over %d runs\n",
          id,
          averaged_timing / NUM_RUN_AVERAGED,
@@ -11,6 +11,7 @@ extern "C" {
 #include "BLI_utildefines.h"
 
 #include "BLI_listbase.h"
+#include "BLI_memarena.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
 };
@@ -137,6 +138,112 @@ TEST(task, RangeIterPool)
   BLI_threadapi_exit();
 }
 
+/* *** Parallel iterations over range of integer values, using scratch memory. *** */
+
+static void task_range_scratch_iter_func(void *userdata,
+                                         int index,
+                                         const TaskParallelTLS *__restrict tls)
+{
+  int *data = (int *)userdata;
+  MemArena *arena = BLI_task_parallel_tls_arena(tls);
+  EXPECT_TRUE(arena != NULL);
+  EXPECT_EQ(arena, BLI_task_parallel_tls_arena(tls));
+
+  const int num_values = 1 + index % 64;
+  int *values = (int *)BLI_memarena_alloc(arena, sizeof(*values) * num_values);
+  for (int i = 0; i < num_values; i++) {
+    values[i] = index;
+  }
+  int sum = 0;
+  for (int i = 0; i < num_values; i++) {
+    sum += values[i];
+  }
+  data[index] = sum / num_values;
+}
+
+TEST(task, RangeIterScratchArena)
+{
+  int data[NUM_ITEMS] = {0};
+
+  BLI_threadapi_init();
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  /* Run twice, so that arenas cached by the threads get re-used. */
+  for (int run = 0; run < 2; run++) {
+    memset(data, 0, sizeof(data));
+    BLI_task_parallel_range(0, NUM_ITEMS, data, task_range_scratch_iter_func, &settings);
+    for (int i = 0; i < NUM_ITEMS; i++) {
+      EXPECT_EQ(data[i], i);
+    }
+  }
+
+  /* Non-threaded code path. */
+  settings.use_threading = false;
+  memset(data, 0, sizeof(data));
+  BLI_task_parallel_range(0, NUM_ITEMS, data, task_range_scratch_iter_func, &settings);
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    EXPECT_EQ(data[i], i);
+  }
+
+  BLI_threadapi_exit();
+}
+
+/* *** Parallel iterations over range of integer values, from within pool tasks. *** */
+
+#define NUM_NESTED_TASKS 8
+
+static void task_range_nested_iter_func(void *userdata,
+                                        int index,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  int *data = (int *)userdata;
+  atomic_add_and_fetch_int32(&data[index], index);
+}
+
+static void task_range_nested_pool_func(TaskPool *__restrict pool,
+                                        void *taskdata,
+                                        int UNUSED(threadid))
+{
+  int(*data)[NUM_ITEMS] = (int(*)[NUM_ITEMS])BLI_task_pool_userdata(pool);
+  const int task_index = POINTER_AS_INT(taskdata);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+
+  BLI_task_parallel_range(0, NUM_ITEMS, data[task_index], task_range_nested_iter_func, &settings);
+}
+
+TEST(task, RangeIterNested)
+{
+  static int data[NUM_NESTED_TASKS][NUM_ITEMS];
+  memset(data, 0, sizeof(data));
+
+  BLI_threadapi_init();
+
+  /* Use a background pool, so that even in single-threaded case the outer tasks are executed by
+   * a worker thread, and the ranges are really nested inside worker's tasks. */
+  TaskPool *pool = BLI_task_pool_create_background(BLI_task_scheduler_get(), data);
+  for (int j = 0; j < NUM_NESTED_TASKS; j++) {
+    BLI_task_pool_push(
+        pool, task_range_nested_pool_func, POINTER_FROM_INT(j), false, TASK_PRIORITY_HIGH);
+  }
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+
+  /* Those checks should ensure us all items of all ranges were processed once, and only once. */
+  for (int j = 0; j < NUM_NESTED_TASKS; j++) {
+    for (int i = 0; i < NUM_ITEMS; i++) {
+      EXPECT_EQ(data[j][i], i);
+    }
+  }
+
+  BLI_threadapi_exit();
+}
+
 /* *** Parallel iterations over mempool items. *** */
 
 static void task_mempool_iter_func(void *userdata, MempoolIterData *item)
@@ -206,6 +313,61 @@ TEST(task, MempoolIter)
   BLI_threadapi_exit();
 }
 
+static void task_mempool_iter_index_func(void *userdata, MempoolIterData *item, const int index)
+{
+  int *data = (int *)item;
+  int *count = (int *)userdata;
+
+  /* Items hold their index in single threaded iteration order. */
+  EXPECT_EQ(*data, index);
+
+  *data = -1;
+  atomic_sub_and_fetch_uint32((uint32_t *)count, 1);
+}
+
+TEST(task, MempoolIterIndex)
+{
+  int *data[NUM_ITEMS];
+  BLI_threadapi_init();
+  BLI_mempool *mempool = BLI_mempool_create(
+      sizeof(*data[0]), NUM_ITEMS, 32, BLI_MEMPOOL_ALLOW_ITER);
+
+  int i;
+  for (i = 0; i < NUM_ITEMS; i++) {
+    data[i] = (int *)BLI_mempool_alloc(mempool);
+  }
+
+  /* Leave whole chunks empty or nearly empty, and others full, so balancing is needed. */
+  for (i = 0; i < NUM_ITEMS; i++) {
+    if ((i / 32) % 3 != 0 || (i % 32) == 0) {
+      continue;
+    }
+    BLI_mempool_free(mempool, data[i]);
+    data[i] = NULL;
+  }
+
+  int num_items = 0;
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(mempool, &iter);
+  for (int *item = (int *)BLI_mempool_iterstep(&iter); item != NULL;
+       item = (int *)BLI_mempool_iterstep(&iter)) {
+    *item = num_items++;
+  }
+  EXPECT_EQ(num_items, BLI_mempool_len(mempool));
+
+  BLI_task_parallel_mempool_index(mempool, &num_items, task_mempool_iter_index_func, true);
+
+  EXPECT_EQ(num_items, 0);
+  for (i = 0; i < NUM_ITEMS; i++) {
+    if (data[i] != NULL) {
+      EXPECT_EQ(*data[i], -1);
+    }
+  }
+
+  BLI_mempool_destroy(mempool);
+  BLI_threadapi_exit();
+}
+
 /* *** Parallel iterations over double-linked list items. *** */
 
 static void task_listbase_iter_func(void *userdata,
@@ -253,3 +415,85 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** Task pool profiling. *** */
+
+static void task_pool_profile_func(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
+{
+  int *count = (int *)BLI_task_pool_userdata(pool);
+  atomic_add_and_fetch_uint32((uint32_t *)count, POINTER_AS_INT(taskdata));
+}
+
+TEST(task, PoolProfile)
+{
+  int count = 0;
+  BLI_threadapi_init();
+  TaskScheduler *scheduler = BLI_task_scheduler_create(4);
+  TaskPool *pool = BLI_task_pool_create_suspended(scheduler, &count);
+  BLI_task_pool_profile_enable(pool, "test");
+
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    BLI_task_pool_push(pool, task_pool_profile_func, POINTER_FROM_INT(1), false, TASK_PRIORITY_HIGH);
+  }
+  BLI_task_pool_work_and_wait(pool);
+  EXPECT_EQ(count, NUM_ITEMS);
+
+  const char *filepath = "BLI_task_test_profile.json";
+  EXPECT_TRUE(BLI_task_pool_profile_write_chrome_trace(pool, filepath));
+
+  /* Every task is exported as one complete event. */
+  FILE *file = fopen(filepath, "r");
+  ASSERT_NE(file, nullptr);
+  int num_events = 0;
+  char line[512];
+  while (fgets(line, sizeof(line), file)) {
+    if (strstr(line, "\"ph\":\"X\"")) {
+      num_events++;
+    }
+  }
+  fclose(file);
+  remove(filepath);
+  EXPECT_EQ(num_events, NUM_ITEMS);
+
+  BLI_task_pool_free(pool);
+  BLI_task_scheduler_free(scheduler);
+  BLI_threadapi_exit();
+}
+
+static void task_pool_profile_event_func(void *userdata,
+                                         void *taskdata,
+                                         int thread_id,
+                                         double push_time,
+                                         double start_time,
+                                         double end_time)
+{
+  int *sum = (int *)userdata;
+  *sum += POINTER_AS_INT(taskdata);
+  EXPECT_GE(thread_id, 0);
+  EXPECT_LE(push_time, start_time);
+  EXPECT_LE(start_time, end_time);
+}
+
+TEST(task, PoolProfileForeachEvent)
+{
+  int count = 0;
+  BLI_threadapi_init();
+  TaskScheduler *scheduler = BLI_task_scheduler_create(4);
+  TaskPool *pool = BLI_task_pool_create_suspended(scheduler, &count);
+  BLI_task_pool_profile_enable(pool, "test");
+
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    BLI_task_pool_push(pool, task_pool_profile_func, POINTER_FROM_INT(1), false, TASK_PRIORITY_HIGH);
+  }
+  BLI_task_pool_work_and_wait(pool);
+  EXPECT_EQ(count, NUM_ITEMS);
+
+  /* Every task is visited once, with the data it was pushed with. */
+  int sum = 0;
+  BLI_task_pool_profile_foreach_event(pool, task_pool_profile_event_func, &sum);
+  EXPECT_EQ(sum, NUM_ITEMS);
+
+  BLI_task_pool_free(pool);
+  BLI_task_scheduler_free(scheduler);
+  BLI_threadapi_exit();
+}
@@ -0,0 +1,72 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <fstream>
+#include <stdio.h>
+#include <sstream>
+#include <string>
+
+extern "C" {
+#include "BLI_threads.h"
+#include "BLI_trace.h"
+#include "BLI_utildefines.h"
+}
+
+static std::string trace_test_filepath()
+{
+  return testing::internal::TempDir() + "BLI_trace_test.json";
+}
+
+static std::string trace_test_read(const std::string &filepath)
+{
+  std::ifstream file(filepath.c_str());
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+TEST(trace, Disabled)
+{
+  EXPECT_FALSE(BLI_trace_is_enabled());
+
+  TraceZone zone;
+  BLI_trace_zone_begin(&zone, "Zone", "test");
+  EXPECT_EQ(zone.start_time, 0.0);
+  BLI_trace_zone_end(&zone);
+}
+
+TEST(trace, Zones)
+{
+  BLI_threadapi_init();
+  const std::string filepath = trace_test_filepath();
+  EXPECT_TRUE(BLI_trace_begin(filepath.c_str()));
+  EXPECT_TRUE(BLI_trace_is_enabled());
+  EXPECT_EQ(BLI_trace_thread_id(), 0);
+
+  TraceZone zone;
+  BLI_trace_zone_begin(&zone, "Zone \"quoted\"", "test");
+  EXPECT_NE(zone.start_time, 0.0);
+  BLI_trace_zone_end(&zone);
+
+  BLI_trace_process_name_set(1, "Other");
+  BLI_trace_slice(1, 3, "Slice", "test", "detail", 1.0, 2.0, 0.5);
+  BLI_trace_end();
+  EXPECT_FALSE(BLI_trace_is_enabled());
+  BLI_threadapi_exit();
+
+  const std::string trace = trace_test_read(filepath);
+  remove(filepath.c_str());
+
+  EXPECT_EQ(trace.compare(0, 2, "[\n"), 0);
+  EXPECT_EQ(trace.compare(trace.size() - 2, 2, "]\n"), 0);
+  EXPECT_NE(trace.find("\"name\":\"Zone \\\"quoted\\\"\",\"cat\":\"test\",\"ph\":\"X\",\"pid\":0,"
+                       "\"tid\":0,"),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"Slice\",\"cat\":\"test\",\"ph\":\"X\",\"pid\":1,\"tid\":3,"),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"args\":{\"detail\":\"detail\",\"wait_us\":500000.000}"),
+            std::string::npos);
+  EXPECT_NE(trace.find("\"pid\":0,\"args\":{\"name\":\"Blender\"}"), std::string::npos);
+  EXPECT_NE(trace.find("\"pid\":1,\"args\":{\"name\":\"Other\"}"), std::string::npos);
+}
@@ -0,0 +1,72 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "blendfile_loading_base_test.h"
+
+#include <string>
+
+extern "C" {
+#include "BLI_fileops.h"
+#include "BLI_listbase.h"
+#include "BLI_path_util.h"
+
+#include "BKE_appdir.h"
+#include "BKE_main.h"
+#include "BKE_text.h"
+
+#include "BLO_readfile.h"
+#include "BLO_writefile.h"
+
+#include "PIL_time_utildefines.h"
+}
+
+class BlendfileLoadingPerformanceTest : public BlendfileLoadingBaseTest {
+};
+
+/* Every line of a text is written as two blocks (the line and its string),
+ * this gives a synthetic file of 1M blocks over 1000 data-blocks. */
+#define TEXTS_NUM 1000
+#define TEXT_LINES_NUM 500
+
+TEST_F(BlendfileLoadingPerformanceTest, TextBlocks1M)
+{
+  Main *bmain = BKE_main_new();
+  std::string str;
+  for (int i = 0; i < TEXT_LINES_NUM; i++) {
+    str += "line " + std::to_string(i) + "\n";
+  }
+  for (int i = 0; i < TEXTS_NUM; i++) {
+    Text *text = BKE_text_add(bmain, "Text");
+    BKE_text_write(text, str.c_str());
+  }
+
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(
+      filepath, sizeof(filepath), BKE_tempdir_session(), "blendfile_load_performance.blend");
+  TIMEIT_START(write_file);
+  ASSERT_TRUE(BLO_write_file(bmain, filepath, 0, NULL, NULL));
+  RECORD_PERFORMANCE_TIME("write_file", TIMEIT_VALUE(write_file));
+  TIMEIT_END(write_file);
+  BKE_main_free(bmain);
+
+  TIMEIT_START(read_file);
+  bfile = BLO_read_from_file(filepath, BLO_READ_SKIP_NONE, NULL);
+  RECORD_PERFORMANCE_TIME("read_file", TIMEIT_VALUE(read_file));
+  TIMEIT_END(read_file);
+
+  ASSERT_NE(bfile, nullptr);
+  EXPECT_EQ(BLI_listbase_count(&bfile->main->texts), TEXTS_NUM);
+  BLI_delete(filepath, false, false);
+}
@@ -17,6 +17,27 @@
  */
 #include "blendfile_loading_base_test.h"
 
+extern "C" {
+#include "BLI_fileops.h"
+#include "BLI_listbase.h"
+#include "BLI_path_util.h"
+
+#include "DNA_camera_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_appdir.h"
+#include "BKE_camera.h"
+#include "BKE_library.h"
+#include "BKE_main.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLO_readfile.h"
+#include "BLO_undofile.h"
+#include "BLO_writefile.h"
+}
+
 class BlendfileLoadingTest : public BlendfileLoadingBaseTest {
 };
 
@@ -29,3 +50,146 @@ TEST_F(BlendfileLoadingTest, CanaryTest)
   depsgraph_create(DAG_EVAL_RENDER);
   EXPECT_NE(nullptr, this->depsgraph);
 }
+
+TEST_F(BlendfileLoadingTest, PartialLoad)
+{
+  Main *bmain = BKE_main_new();
+  Object *ob_mesh = BKE_object_add_only_object(bmain, OB_MESH, "MeshObject");
+  ob_mesh->data = BKE_mesh_add(bmain, "Mesh");
+  Object *ob_camera = BKE_object_add_only_object(bmain, OB_CAMERA, "CameraObject");
+  ob_camera->data = BKE_camera_add(bmain, "Camera");
+  /* Objects that aren't in a collection have no users, they wouldn't be written. */
+  id_fake_user_set(&ob_mesh->id);
+  id_fake_user_set(&ob_camera->id);
+
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), BKE_tempdir_session(), "partial_load.blend");
+  ASSERT_TRUE(BLO_write_file(bmain, filepath, 0, NULL, NULL));
+  BKE_main_free(bmain);
+
+  /* Meshes are skipped, pointers to them are cleared. */
+  bfile = BLO_read_from_file_partial(
+      filepath, BLO_READ_SKIP_NONE, FILTER_ID_OB | FILTER_ID_CA, false, NULL);
+  ASSERT_NE(bfile, nullptr);
+  EXPECT_EQ(BLI_listbase_count(&bfile->main->objects), 2);
+  EXPECT_EQ(BLI_listbase_count(&bfile->main->cameras), 1);
+  EXPECT_TRUE(BLI_listbase_is_empty(&bfile->main->meshes));
+  ob_mesh = (Object *)BKE_libblock_find_name(bfile->main, ID_OB, "MeshObject");
+  ob_camera = (Object *)BKE_libblock_find_name(bfile->main, ID_OB, "CameraObject");
+  ASSERT_NE(ob_mesh, nullptr);
+  ASSERT_NE(ob_camera, nullptr);
+  EXPECT_EQ(ob_mesh->data, nullptr);
+  EXPECT_EQ(ob_camera->data, bfile->main->cameras.first);
+  blendfile_free();
+
+  /* Meshes are replaced by placeholders. */
+  bfile = BLO_read_from_file_partial(
+      filepath, BLO_READ_SKIP_NONE, FILTER_ID_OB | FILTER_ID_CA, true, NULL);
+  ASSERT_NE(bfile, nullptr);
+  ASSERT_EQ(BLI_listbase_count(&bfile->main->meshes), 1);
+  Mesh *mesh = (Mesh *)bfile->main->meshes.first;
+  EXPECT_TRUE(mesh->id.tag & LIB_TAG_MISSING);
+  EXPECT_EQ(mesh->totvert, 0);
+  ob_mesh = (Object *)BKE_libblock_find_name(bfile->main, ID_OB, "MeshObject");
+  ASSERT_NE(ob_mesh, nullptr);
+  EXPECT_EQ(ob_mesh->data, mesh);
+
+  BLI_delete(filepath, false, false);
+}
+
+TEST_F(BlendfileLoadingTest, UndoReuseUnchangedIDs)
+{
+  Main *bmain = BKE_main_new();
+  Object *ob_mesh = BKE_object_add_only_object(bmain, OB_MESH, "MeshObject");
+  Mesh *mesh = BKE_mesh_add(bmain, "Mesh");
+  ob_mesh->data = mesh;
+  Object *ob_camera = BKE_object_add_only_object(bmain, OB_CAMERA, "CameraObject");
+  Camera *camera = (Camera *)BKE_camera_add(bmain, "Camera");
+  ob_camera->data = camera;
+  id_fake_user_set(&ob_mesh->id);
+  id_fake_user_set(&ob_camera->id);
+  const float lens = camera->lens;
+
+  MemFile memfile_a = {{NULL}};
+  MemFile memfile_b = {{NULL}};
+  ASSERT_TRUE(BLO_write_file_mem(bmain, NULL, &memfile_a, 0));
+  camera->lens = lens * 2.0f;
+  ASSERT_TRUE(BLO_write_file_mem(bmain, &memfile_a, &memfile_b, 0));
+
+  /* Undo from the second state to the first one. */
+  bfile = BLO_read_from_memfile(bmain, "", &memfile_a, &memfile_b, BLO_READ_SKIP_NONE, NULL);
+  ASSERT_NE(bfile, nullptr);
+  EXPECT_TRUE(bfile->is_undo_partial);
+
+  /* The mesh and its object didn't change, they're moved from the old Main. */
+  EXPECT_EQ(BKE_libblock_find_name(bfile->main, ID_OB, "MeshObject"), &ob_mesh->id);
+  EXPECT_EQ(BKE_libblock_find_name(bfile->main, ID_ME, "Mesh"), &mesh->id);
+  EXPECT_TRUE(mesh->id.tag & LIB_TAG_UNDO_OLD_ID_REUSED);
+  EXPECT_EQ(ob_mesh->data, mesh);
+  EXPECT_EQ(BLI_findindex(&bmain->objects, ob_mesh), -1);
+
+  /* The camera changed, its object uses it so both are read again. */
+  Camera *camera_undo = (Camera *)BKE_libblock_find_name(bfile->main, ID_CA, "Camera");
+  Object *ob_camera_undo = (Object *)BKE_libblock_find_name(bfile->main, ID_OB, "CameraObject");
+  ASSERT_NE(camera_undo, nullptr);
+  ASSERT_NE(ob_camera_undo, nullptr);
+  EXPECT_NE(camera_undo, camera);
+  EXPECT_NE(ob_camera_undo, ob_camera);
+  EXPECT_EQ(camera_undo->lens, lens);
+  EXPECT_EQ(ob_camera_undo->data, camera_undo);
+  EXPECT_FALSE(camera_undo->id.tag & LIB_TAG_UNDO_OLD_ID_REUSED);
+
+  BKE_main_free(bmain);
+  BLO_memfile_free(&memfile_b);
+  BLO_memfile_free(&memfile_a);
+}
+
+TEST_F(BlendfileLoadingTest, MemfileSpill)
+{
+  Main *bmain = BKE_main_new();
+  Object *ob_camera = BKE_object_add_only_object(bmain, OB_CAMERA, "CameraObject");
+  Camera *camera = (Camera *)BKE_camera_add(bmain, "Camera");
+  ob_camera->data = camera;
+  id_fake_user_set(&ob_camera->id);
+  const float lens = camera->lens;
+
+  MemFile memfile_a = {{NULL}};
+  MemFile memfile_b = {{NULL}};
+  ASSERT_TRUE(BLO_write_file_mem(bmain, NULL, &memfile_a, 0));
+  camera->lens = lens * 2.0f;
+  ASSERT_TRUE(BLO_write_file_mem(bmain, &memfile_a, &memfile_b, 0));
+
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), BKE_tempdir_session(), "memfile.spill");
+  const size_t spill_size = BLO_memfile_spill(&memfile_a, &memfile_b, filepath);
+#ifndef WIN32
+  /* Only the camera changed, the buffers still used by the second state stay in memory. */
+  EXPECT_GT(spill_size, 0);
+  EXPECT_LT(spill_size, memfile_a.size);
+  EXPECT_FALSE(BLI_exists(filepath));
+#else
+  EXPECT_EQ(spill_size, 0);
+#endif
+
+  /* Spilled data can still be read. */
+  bfile = BLO_read_from_memfile(bmain, "", &memfile_a, NULL, BLO_READ_SKIP_NONE, NULL);
+  ASSERT_NE(bfile, nullptr);
+  Camera *camera_undo = (Camera *)BKE_libblock_find_name(bfile->main, ID_CA, "Camera");
+  ASSERT_NE(camera_undo, nullptr);
+  EXPECT_EQ(camera_undo->lens, lens);
+  blendfile_free();
+
+  BLO_memfile_unspill(&memfile_a);
+  EXPECT_EQ(memfile_a.spill_data, nullptr);
+
+  /* Merging moves the shared buffers to the second memory file. */
+  BLO_memfile_merge(&memfile_a, &memfile_b);
+  bfile = BLO_read_from_memfile(bmain, "", &memfile_b, NULL, BLO_READ_SKIP_NONE, NULL);
+  ASSERT_NE(bfile, nullptr);
+  camera_undo = (Camera *)BKE_libblock_find_name(bfile->main, ID_CA, "Camera");
+  ASSERT_NE(camera_undo, nullptr);
+  EXPECT_EQ(camera_undo->lens, lens * 2.0f);
+
+  BKE_main_free(bmain);
+  BLO_memfile_free(&memfile_b);
+}
@@ -0,0 +1,69 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "testing/testing.h"
+
+#include <string.h>
+
+extern "C" {
+#include "BLI_utildefines.h"
+
+#include "BLI_listbase.h"
+
+#include "BLO_undofile.h"
+}
+
+static void memfile_write(MemFile *memfile, MemFile *reference, const char **chunks, int chunks_len)
+{
+  MemFileWriteData mem_data;
+  memfile_write_init(&mem_data, memfile, reference);
+  for (int i = 0; i < chunks_len; i++) {
+    memfile_chunk_add(&mem_data, chunks[i], (uint)strlen(chunks[i]));
+  }
+  memfile_write_finalize(&mem_data);
+}
+
+TEST(memfile, ShareMovedChunks)
+{
+  const char *chunks_a[] = {"first", "second", "third"};
+  const char *chunks_b[] = {"new", "third", "first", "second", "second"};
+
+  MemFile memfile_a = {{NULL}};
+  MemFile memfile_b = {{NULL}};
+  memfile_write(&memfile_a, NULL, chunks_a, ARRAY_SIZE(chunks_a));
+  memfile_write(&memfile_b, &memfile_a, chunks_b, ARRAY_SIZE(chunks_b));
+
+  EXPECT_EQ(memfile_a.size, strlen("firstsecondthird"));
+  /* Only the new chunk is stored again, even though the others moved. */
+  EXPECT_EQ(memfile_b.size, strlen("new"));
+  ASSERT_EQ(BLI_listbase_count(&memfile_b.chunks), ARRAY_SIZE(chunks_b));
+
+  const MemFileChunk *chunk_a = (const MemFileChunk *)memfile_a.chunks.first;
+  const MemFileChunk *chunk_b = (const MemFileChunk *)BLI_findlink(&memfile_b.chunks, 2);
+  EXPECT_TRUE(chunk_b->is_identical);
+  EXPECT_EQ(chunk_b->buf, chunk_a->buf);
+
+  /* Freeing the first step keeps the buffers used by the second one. */
+  BLO_memfile_merge(&memfile_a, &memfile_b);
+  int i = 0;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile_b.chunks) {
+    EXPECT_EQ(chunk->size, strlen(chunks_b[i]));
+    EXPECT_EQ(memcmp(chunk->buf, chunks_b[i], chunk->size), 0);
+    i++;
+  }
+  EXPECT_EQ(memfile_b.size, strlen("newthirdfirstsecond"));
+
+  BLO_memfile_free(&memfile_b);
+}
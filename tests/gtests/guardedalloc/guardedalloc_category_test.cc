@@ -0,0 +1,69 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include "BLI_utildefines.h"
+}
+
+#include "MEM_guardedalloc.h"
+
+namespace {
+
+void DoBasicCategoryChecks()
+{
+  const size_t image_prev = MEM_get_memory_in_use_category(MEM_CATEGORY_IMAGE);
+  const size_t undo_prev = MEM_get_memory_in_use_category(MEM_CATEGORY_UNDO);
+
+  const eMEMCategory category_prev = MEM_category_begin(MEM_CATEGORY_IMAGE);
+  EXPECT_EQ(category_prev, MEM_CATEGORY_OTHER);
+  void *foo = MEM_mallocN(1000, "test");
+  void *bar = MEM_mallocN_aligned(64, 16, "test");
+  void *baz = MEM_callocN(8, "test");
+
+  /* The outer category is kept. */
+  EXPECT_EQ(MEM_category_begin(MEM_CATEGORY_UNDO), MEM_CATEGORY_IMAGE);
+  void *qux = MEM_mallocN(100, "test");
+  MEM_category_end(MEM_CATEGORY_IMAGE);
+  MEM_category_end(category_prev);
+
+  void *other = MEM_mallocN(10000, "test");
+
+  EXPECT_EQ(MEM_allocN_len(foo), 1000);
+  EXPECT_EQ(MEM_allocN_len(bar), 64);
+  EXPECT_EQ(MEM_allocN_len(baz), 8);
+  EXPECT_EQ(MEM_get_memory_in_use_category(MEM_CATEGORY_IMAGE), image_prev + 1000 + 64 + 8 + 100);
+  EXPECT_EQ(MEM_get_memory_in_use_category(MEM_CATEGORY_UNDO), undo_prev);
+
+  /* Reallocation happens in the category of the thread. */
+  foo = MEM_reallocN(foo, 2000);
+  EXPECT_EQ(MEM_allocN_len(foo), 2000);
+  EXPECT_EQ(MEM_get_memory_in_use_category(MEM_CATEGORY_IMAGE), image_prev + 64 + 8 + 100);
+
+  MEM_freeN(bar);
+  MEM_freeN(baz);
+  MEM_freeN(qux);
+  EXPECT_EQ(MEM_get_memory_in_use_category(MEM_CATEGORY_IMAGE), image_prev);
+
+  size_t total = 0;
+  for (int i = 0; i < MEM_CATEGORY_NUM; i++) {
+    total += MEM_get_memory_in_use_category((eMEMCategory)i);
+  }
+  EXPECT_EQ(total, MEM_get_memory_in_use());
+
+  MEM_freeN(foo);
+  MEM_freeN(other);
+}
+
+}  // namespace
+
+TEST(guardedalloc, LockfreeCategory)
+{
+  DoBasicCategoryChecks();
+}
+
+TEST(guardedalloc, GuardedCategory)
+{
+  MEM_use_guarded_allocator();
+  DoBasicCategoryChecks();
+}
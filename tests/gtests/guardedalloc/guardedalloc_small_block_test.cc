@@ -0,0 +1,83 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+namespace {
+
+/* Allocate and free blocks of all small sizes, checking that memory keeps its content and that
+ * re-used blocks are properly handled by the different allocation functions. */
+void DoSmallBlockChecks()
+{
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+  std::vector<unsigned char *> blocks;
+
+  for (int round = 0; round < 3; round++) {
+    for (size_t len = 0; len <= 300; len++) {
+      unsigned char *block = (unsigned char *)MEM_mallocN(len, __func__);
+      EXPECT_GE(MEM_allocN_len(block), len);
+      memset(block, (int)(len & 0xff), len);
+      blocks.push_back(block);
+    }
+    for (size_t len = 0; len <= 300; len++) {
+      unsigned char *block = blocks[len];
+      for (size_t i = 0; i < len; i++) {
+        EXPECT_EQ(block[i], (unsigned char)(len & 0xff));
+      }
+      MEM_freeN(block);
+    }
+    blocks.clear();
+
+    /* Re-used blocks must be cleared by calloc. */
+    for (size_t len = 1; len <= 300; len += 7) {
+      unsigned char *block = (unsigned char *)MEM_callocN(len, __func__);
+      for (size_t i = 0; i < len; i++) {
+        EXPECT_EQ(block[i], 0);
+      }
+      block = (unsigned char *)MEM_recallocN(block, len * 2);
+      for (size_t i = 0; i < len * 2; i++) {
+        EXPECT_EQ(block[i], 0);
+      }
+      memset(block, 1, len * 2);
+      MEM_freeN(block);
+    }
+  }
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+}
+
+}  // namespace
+
+TEST(guardedalloc, LockfreeSmallBlocks)
+{
+  DoSmallBlockChecks();
+}
+
+TEST(guardedalloc, LockfreeSmallBlocksThreads)
+{
+  /* Blocks allocated in one thread and freed in another one. */
+  std::vector<void *> blocks;
+  for (int i = 0; i < 1000; i++) {
+    blocks.push_back(MEM_mallocN((size_t)(i % 200), __func__));
+  }
+
+  std::thread thread([&]() {
+    for (void *block : blocks) {
+      MEM_freeN(block);
+    }
+    DoSmallBlockChecks();
+  });
+  thread.join();
+
+  DoSmallBlockChecks();
+}
+
+TEST(guardedalloc, GuardedSmallBlocks)
+{
+  MEM_use_guarded_allocator();
+  DoSmallBlockChecks();
+}
@@ -1,6 +1,7 @@
 #ifndef __BLENDER_TESTING_H__
 #define __BLENDER_TESTING_H__
 
+#include <string>
 #include <vector>
 
 #include "glog/logging.h"
@@ -128,4 +129,19 @@ inline void EXPECT_EQ_ARRAY_ND(const T *expected, const T *actual, const size_t
   }
 }
 
+// Record the time taken by a step of a performance test as a property of the test, timings are
+// then written to machine readable reports, e.g. with `--gtest_output=xml:timings.xml`.
+// Characters which are not valid in a property name are replaced by underscores.
+inline void RECORD_PERFORMANCE_TIME(const char *step, const double seconds)
+{
+  std::string name(step);
+  for (size_t i = 0; i < name.size(); ++i) {
+    const char c = name[i];
+    if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))) {
+      name[i] = '_';
+    }
+  }
+  ::testing::Test::RecordProperty(name + "_seconds", std::to_string(seconds));
+}
+
 #endif  // __BLENDER_TESTING_H__